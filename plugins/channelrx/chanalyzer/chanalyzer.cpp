@@ -216,6 +216,7 @@ void ChannelAnalyzer::applySettings(const ChannelAnalyzerSettings& settings, boo
             << " m_pllBandwidth: " << settings.m_pllBandwidth
             << " m_pllDampingFactor: " << settings.m_pllDampingFactor
             << " m_pllLoopGain: " << settings.m_pllLoopGain
+            << " m_scopeThread: " << settings.m_scopeThread
             << " m_inputType: " << (int) settings.m_inputType
             << " m_useReverseAPI:" << settings.m_useReverseAPI
             << " m_reverseAPIAddress:" << settings.m_reverseAPIAddress
@@ -285,6 +286,11 @@ void ChannelAnalyzer::applySettings(const ChannelAnalyzerSettings& settings, boo
     if ((settings.m_title != m_settings.m_title) || force) {
         reverseAPIKeys.append("title");
     }
+    if ((settings.m_scopeThread != m_settings.m_scopeThread) || force)
+    {
+        m_scopeVis.setProcessingThread(settings.m_scopeThread);
+        reverseAPIKeys.append("scopeThread");
+    }
 
     if (m_settings.m_streamIndex != settings.m_streamIndex)
     {
@@ -424,6 +430,9 @@ void ChannelAnalyzer::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("inputType")) {
         settings.m_inputType = (ChannelAnalyzerSettings::InputType) response.getChannelAnalyzerSettings()->getInputType();
     }
+    if (channelSettingsKeys.contains("scopeThread")) {
+        settings.m_scopeThread = response.getChannelAnalyzerSettings()->getScopeThread() != 0;
+    }
     if (channelSettingsKeys.contains("rgbColor")) {
         settings.m_rgbColor = response.getChannelAnalyzerSettings()->getRgbColor();
     }
@@ -484,6 +493,7 @@ void ChannelAnalyzer::webapiFormatChannelSettings(
     response.getChannelAnalyzerSettings()->setPllDampingFactor(settings.m_pllDampingFactor);
     response.getChannelAnalyzerSettings()->setPllLoopGain(settings.m_pllLoopGain);
     response.getChannelAnalyzerSettings()->setInputType((int) settings.m_inputType);
+    response.getChannelAnalyzerSettings()->setScopeThread(settings.m_scopeThread ? 1 : 0);
     response.getChannelAnalyzerSettings()->setRgbColor(settings.m_rgbColor);
 
     if (response.getChannelAnalyzerSettings()->getTitle()) {
@@ -683,6 +693,9 @@ void ChannelAnalyzer::webapiFormatChannelSettings(
     if (channelSettingsKeys.contains("inputType")) {
         swgChannelAnalyzerSettings->setInputType((int) settings.m_inputType);
     }
+    if (channelSettingsKeys.contains("scopeThread")) {
+        swgChannelAnalyzerSettings->setScopeThread(settings.m_scopeThread ? 1 : 0);
+    }
     if (channelSettingsKeys.contains("rgbColor")) {
         swgChannelAnalyzerSettings->setRgbColor(settings.m_rgbColor);
     }
@@ -88,6 +88,7 @@ void ChannelAnalyzerGUI::displaySettings()
         ui->BWLabel->setText("BP");
     }
     ui->ssb->setChecked(m_settings.m_ssb);
+    ui->scopeThread->setChecked(m_settings.m_scopeThread);
     ui->BW->setValue(m_settings.m_bandwidth/100);
     ui->lowCut->setValue(m_settings.m_lowCutoff/100);
     ui->deltaFrequency->setValue(m_settings.m_inputFrequencyOffset);
@@ -453,6 +454,12 @@ void ChannelAnalyzerGUI::on_ssb_toggled(bool checked)
     applySettings();
 }
 
+void ChannelAnalyzerGUI::on_scopeThread_toggled(bool checked)
+{
+    m_settings.m_scopeThread = checked;
+    applySettings();
+}
+
 void ChannelAnalyzerGUI::onWidgetRolled(QWidget* widget, bool rollDown)
 {
     (void) widget;
@@ -738,6 +745,7 @@ void ChannelAnalyzerGUI::makeUIConnections()
     QObject::connect(ui->BW, &QSlider::valueChanged, this, &ChannelAnalyzerGUI::on_BW_valueChanged);
     QObject::connect(ui->lowCut, &QSlider::valueChanged, this, &ChannelAnalyzerGUI::on_lowCut_valueChanged);
     QObject::connect(ui->ssb, &QCheckBox::toggled, this, &ChannelAnalyzerGUI::on_ssb_toggled);
+    QObject::connect(ui->scopeThread, &QCheckBox::toggled, this, &ChannelAnalyzerGUI::on_scopeThread_toggled);
 }
 
 void ChannelAnalyzerGUI::updateAbsoluteCenterFrequency()
@@ -119,6 +119,7 @@ private slots:
 	void on_lowCut_valueChanged(int value);
 	void on_log2Decim_currentIndexChanged(int index);
 	void on_ssb_toggled(bool checked);
+	void on_scopeThread_toggled(bool checked);
 	void onWidgetRolled(QWidget* widget, bool rollDown);
     void onMenuDialogCalled(const QPoint& p);
     void handleInputMessages();
@@ -61,6 +61,7 @@ void ChannelAnalyzerSettings::resetToDefaults()
     m_reverseAPIChannelIndex = 0;
     m_workspaceIndex = 0;
     m_hidden = false;
+    m_scopeThread = false;
 }
 
 QByteArray ChannelAnalyzerSettings::serialize() const
@@ -110,6 +111,7 @@ QByteArray ChannelAnalyzerSettings::serialize() const
     s.writeS32(29, m_workspaceIndex);
     s.writeBlob(30, m_geometryBytes);
     s.writeBool(31, m_hidden);
+    s.writeBool(32, m_scopeThread);
 
     return s.final();
 }
@@ -187,6 +189,7 @@ bool ChannelAnalyzerSettings::deserialize(const QByteArray& data)
         d.readS32(29, &m_workspaceIndex, 0);
         d.readBlob(30, &m_geometryBytes);
         d.readBool(31, &m_hidden, false);
+        d.readBool(32, &m_scopeThread, false);
 
         return true;
     }
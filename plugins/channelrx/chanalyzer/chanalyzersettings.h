@@ -63,6 +63,7 @@ struct ChannelAnalyzerSettings
     int m_workspaceIndex;
     QByteArray m_geometryBytes;
     bool m_hidden;
+    bool m_scopeThread; //!< Run scope processing in its own thread instead of the channel DSP thread
 
     ChannelAnalyzerSettings();
     void resetToDefaults();
@@ -36,6 +36,7 @@
 #include "SWGChannelReport.h"
 #include "SWGADSBDemodReport.h"
 #include "SWGTargetAzimuthElevation.h"
+#include "SWGADSBDemodAircraftState.h"
 
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
@@ -47,6 +48,7 @@
 
 #include "adsbdemod.h"
 #include "adsbdemodworker.h"
+#include "adsbdemoddecoder.h"
 
 MESSAGE_CLASS_DEFINITION(ADSBDemod::MsgConfigureADSBDemod, Message)
 
@@ -71,6 +73,24 @@ ADSBDemod::ADSBDemod(DeviceAPI *devieAPI) :
     m_worker = new ADSBDemodWorker();
     m_basebandSink->setMessageQueueToWorker(m_worker->getInputMessageQueue());
 
+    m_decoderThread = new QThread(this);
+    m_decoder = new ADSBDemodDecoder();
+    m_decoder->moveToThread(m_decoderThread);
+    QObject::connect(
+        m_decoderThread,
+        &QThread::started,
+        m_decoder,
+        &ADSBDemodDecoder::startWork
+    );
+    QObject::connect( // Direct, as decoder's event loop is no longer running
+        m_decoderThread,
+        &QThread::finished,
+        m_decoder,
+        &ADSBDemodDecoder::stopWork,
+        Qt::DirectConnection
+    );
+    m_basebandSink->setMessageQueueToDecoder(m_decoder->getInputMessageQueue());
+
     applySettings(m_settings, true);
 
     m_deviceAPI->addChannelSink(this);
@@ -89,6 +109,12 @@ ADSBDemod::ADSBDemod(DeviceAPI *devieAPI) :
         this,
         &ADSBDemod::handleIndexInDeviceSetChanged
     );
+    QObject::connect(
+        &MainCore::instance()->getSettings(),
+        &MainSettings::preferenceChanged,
+        this,
+        &ADSBDemod::handlePreferenceChanged
+    );
 }
 
 ADSBDemod::~ADSBDemod()
@@ -106,8 +132,10 @@ ADSBDemod::~ADSBDemod()
     m_deviceAPI->removeChannelSinkAPI(this);
     m_deviceAPI->removeChannelSink(this);
     delete m_worker;
+    delete m_decoder;
     delete m_basebandSink;
     delete m_thread;
+    delete m_decoderThread;
 }
 
 void ADSBDemod::setDeviceAPI(DeviceAPI *deviceAPI)
@@ -130,7 +158,7 @@ uint32_t ADSBDemod::getNumberOfDeviceStreams() const
 void ADSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
 {
     (void) firstOfBurst;
-    m_basebandSink->feed(begin, end);
+    m_basebandSink->feed(begin, end, m_timestamp);
 }
 
 void ADSBDemod::start()
@@ -149,6 +177,12 @@ void ADSBDemod::start()
 
     ADSBDemodWorker::MsgConfigureADSBDemodWorker *msg = ADSBDemodWorker::MsgConfigureADSBDemodWorker::create(m_settings, true);
     m_worker->getInputMessageQueue()->push(msg);
+
+    m_decoder->reset();
+    ADSBDemodDecoder::MsgConfigureADSBDemodDecoder *decoderMsg = ADSBDemodDecoder::MsgConfigureADSBDemodDecoder::create(m_settings, true);
+    m_decoder->getInputMessageQueue()->push(decoderMsg);
+    sendStationPosition();
+    m_decoderThread->start();
 }
 
 void ADSBDemod::stop()
@@ -158,6 +192,8 @@ void ADSBDemod::stop()
     m_worker->stopWork();
     m_thread->exit();
     m_thread->wait();
+    m_decoderThread->exit();
+    m_decoderThread->wait();
 }
 
 bool ADSBDemod::handleMessage(const Message& cmd)
@@ -317,6 +353,9 @@ void ADSBDemod::applySettings(const ADSBDemodSettings& settings, bool force)
     ADSBDemodWorker::MsgConfigureADSBDemodWorker *workerMsg = ADSBDemodWorker::MsgConfigureADSBDemodWorker::create(settings, force);
     m_worker->getInputMessageQueue()->push(workerMsg);
 
+    ADSBDemodDecoder::MsgConfigureADSBDemodDecoder *decoderMsg = ADSBDemodDecoder::MsgConfigureADSBDemodDecoder::create(settings, force);
+    m_decoder->getInputMessageQueue()->push(decoderMsg);
+
     if (settings.m_useReverseAPI)
     {
         bool fullUpdate = ((m_settings.m_useReverseAPI != settings.m_useReverseAPI) && settings.m_useReverseAPI) ||
@@ -636,6 +675,49 @@ void ADSBDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& respons
         response.getAdsbDemodReport()->setTargetElevation(m_targetElevation);
         response.getAdsbDemodReport()->setTargetRange(m_targetRange);
     }
+
+    QList<ADSBAircraftState> aircraftStates;
+    m_decoder->getAircraftStates(aircraftStates);
+    QList<SWGSDRangel::SWGADSBDemodAircraftState *> *swgAircraftStates = response.getAdsbDemodReport()->getAircraft();
+
+    for (const auto& aircraft : aircraftStates)
+    {
+        SWGSDRangel::SWGADSBDemodAircraftState *swgAircraft = new SWGSDRangel::SWGADSBDemodAircraftState();
+        swgAircraft->setIcao(new QString(QString("%1").arg(aircraft.m_icao, 6, 16, QLatin1Char('0'))));
+        swgAircraft->setCallsign(new QString(aircraft.getCallsign()));
+        swgAircraft->setEmitterCategory(new QString(aircraft.getEmitterCategory()));
+        swgAircraft->setOnSurface(aircraft.m_onSurface ? 1 : 0);
+
+        if (aircraft.m_positionValid)
+        {
+            swgAircraft->setLatitude(aircraft.m_latitude);
+            swgAircraft->setLongitude(aircraft.m_longitude);
+            swgAircraft->setPositionDateTime(new QString(QDateTime::fromMSecsSinceEpoch(aircraft.m_positionTime).toString(Qt::ISODateWithMs)));
+        }
+        if (aircraft.m_altitudeValid) {
+            swgAircraft->setAltitude(aircraft.m_altitude);
+        }
+        if (aircraft.m_speedValid)
+        {
+            swgAircraft->setSpeed(aircraft.m_speed);
+            swgAircraft->setSpeedType(aircraft.m_speedType);
+        }
+        if (aircraft.m_headingValid) {
+            swgAircraft->setHeading(aircraft.m_heading);
+        }
+        if (aircraft.m_verticalRateValid) {
+            swgAircraft->setVerticalRate(aircraft.m_verticalRate);
+        }
+        if (aircraft.m_squawkValid)
+        {
+            swgAircraft->setSquawk(aircraft.m_squawk);
+            swgAircraft->setEmergencyStatus(new QString(aircraft.getEmergencyStatus()));
+        }
+
+        swgAircraft->setFrameCount(aircraft.m_frameCount);
+        swgAircraft->setLastSeenDateTime(new QString(QDateTime::fromMSecsSinceEpoch(aircraft.m_lastSeen).toString(Qt::ISODateWithMs)));
+        swgAircraftStates->append(swgAircraft);
+    }
 }
 
 void ADSBDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const ADSBDemodSettings& settings, bool force)
@@ -820,3 +902,26 @@ void ADSBDemod::handleIndexInDeviceSetChanged(int index)
         .arg(index);
     m_basebandSink->setFifoLabel(fifoLabel);
 }
+
+void ADSBDemod::getAircraftStates(QList<ADSBAircraftState>& aircraft)
+{
+    m_decoder->getAircraftStates(aircraft);
+}
+
+void ADSBDemod::sendStationPosition()
+{
+    ADSBDemodDecoder::MsgConfigureStation *msg = ADSBDemodDecoder::MsgConfigureStation::create(
+        MainCore::instance()->getSettings().getLatitude(),
+        MainCore::instance()->getSettings().getLongitude()
+    );
+    m_decoder->getInputMessageQueue()->push(msg);
+}
+
+void ADSBDemod::handlePreferenceChanged(int elementType)
+{
+    Preferences::ElementType pref = (Preferences::ElementType)elementType;
+
+    if ((pref == Preferences::Latitude) || (pref == Preferences::Longitude)) {
+        sendStationPosition();
+    }
+}
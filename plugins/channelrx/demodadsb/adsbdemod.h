@@ -23,6 +23,7 @@
 #include <vector>
 
 #include <QNetworkRequest>
+#include <QList>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -36,6 +37,8 @@ class QNetworkReply;
 class QThread;
 class DeviceAPI;
 class ADSBDemodWorker;
+class ADSBDemodDecoder;
+struct ADSBAircraftState;
 
 class ADSBDemod : public BasebandSampleSink, public ChannelAPI {
 public:
@@ -70,6 +73,7 @@ public:
 
     using BasebandSampleSink::feed;
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool po);
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { m_timestamp = timestamp; }
     virtual void start();
     virtual void stop();
     virtual void pushMessage(Message *msg) { m_inputMessageQueue.push(msg); }
@@ -129,6 +133,7 @@ public:
 
     void setTarget(const QString& name, float targetAzimuth, float targetElevation, float targetRange);
     void clearTarget() { m_targetAzElValid = false; }
+    void getAircraftStates(QList<ADSBAircraftState>& aircraft); //!< Last snapshot of aircraft decoded by the decoder
 
     uint32_t getNumberOfDeviceStreams() const;
 
@@ -139,7 +144,10 @@ private:
     DeviceAPI* m_deviceAPI;
     QThread *m_thread;
     ADSBDemodWorker *m_worker;
+    QThread *m_decoderThread;
+    ADSBDemodDecoder *m_decoder; //!< Aircraft state engine, independent of GUI
     ADSBDemodBaseband* m_basebandSink;
+    SampleTimestamp m_timestamp; //!< Timestamp of next block fed
     ADSBDemodSettings m_settings;
     int m_basebandSampleRate; //!< stored from device message used when starting baseband sink
 
@@ -155,11 +163,13 @@ private:
 	virtual bool handleMessage(const Message& cmd); //!< Processing of a message. Returns true if message has actually been processed
     void applySettings(const ADSBDemodSettings& settings, bool force = false);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
+    void sendStationPosition();
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const ADSBDemodSettings& settings, bool force);
 
 private slots:
     void networkManagerFinished(QNetworkReply *reply);
     void handleIndexInDeviceSetChanged(int index);
+    void handlePreferenceChanged(int elementType);
 };
 
 #endif // INCLUDE_ADSBDEMOD_H
@@ -66,9 +66,9 @@ void ADSBDemodBaseband::stopWork()
     m_sink.stopWorker();
 }
 
-void ADSBDemodBaseband::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+void ADSBDemodBaseband::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, const SampleTimestamp& timestamp)
 {
-    m_sampleFifo.write(begin, end);
+    m_sampleFifo.write(begin, end, timestamp);
 }
 
 void ADSBDemodBaseband::handleData()
@@ -82,15 +82,21 @@ void ADSBDemodBaseband::handleData()
         SampleVector::iterator part2begin;
         SampleVector::iterator part2end;
 
-        std::size_t count = m_sampleFifo.readBegin(m_sampleFifo.fill(), &part1begin, &part1end, &part2begin, &part2end);
+        unsigned int fill = m_sampleFifo.fill();
+        SampleTimestamp timestamp = m_sampleFifo.getReadTimestamp(fill); // read up to next discontinuity
+        std::size_t count = m_sampleFifo.readBegin(fill, &part1begin, &part1end, &part2begin, &part2end);
 
         // first part of FIFO data
-        if (part1begin != part1end) {
+        if (part1begin != part1end)
+        {
+            m_channelizer->setTimestamp(timestamp);
             m_channelizer->feed(part1begin, part1end);
         }
 
         // second part of FIFO data (used when block wraps around)
-        if(part2begin != part2end) {
+        if(part2begin != part2end)
+        {
+            m_channelizer->setTimestamp(timestamp.isValid() ? timestamp.advanced(part1end - part1begin) : timestamp);
             m_channelizer->feed(part2begin, part2end);
         }
 
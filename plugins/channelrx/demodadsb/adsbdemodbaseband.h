@@ -62,12 +62,13 @@ public:
     void reset();
     void startWork();
     void stopWork();
-    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, const SampleTimestamp& timestamp);
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     int getChannelSampleRate() const;
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) { m_sink.getMagSqLevels(avg, peak, nbSamples); }
     void setMessageQueueToGUI(MessageQueue *messageQueue) { m_sink.setMessageQueueToGUI(messageQueue); }
     void setMessageQueueToWorker(MessageQueue *messageQueue) { m_sink.setMessageQueueToWorker(messageQueue); }
+    void setMessageQueueToDecoder(MessageQueue *messageQueue) { m_sink.setMessageQueueToDecoder(messageQueue); }
     void setBasebandSampleRate(int sampleRate);
     void setFifoLabel(const QString& label) { m_sampleFifo.setLabel(label); }
 
@@ -0,0 +1,739 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Jon Beniston, M7RCE                                        //
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include <QDebug>
+#include <QMutexLocker>
+
+#include "adsbdemoddecoder.h"
+#include "adsbdemodreport.h"
+#include "adsb.h"
+
+MESSAGE_CLASS_DEFINITION(ADSBDemodDecoder::MsgConfigureADSBDemodDecoder, Message)
+MESSAGE_CLASS_DEFINITION(ADSBDemodDecoder::MsgConfigureStation, Message)
+
+ADSBAircraftState::ADSBAircraftState(unsigned icao) :
+    m_icao(icao),
+    m_emitterCategory(0),
+    m_emergency(0),
+    m_speedType(GS),
+    m_positionValid(false),
+    m_altitudeValid(false),
+    m_altitudeGNSS(false),
+    m_onSurface(false),
+    m_speedValid(false),
+    m_headingValid(false),
+    m_verticalRateValid(false),
+    m_squawkValid(false),
+    m_squawkIdent(false),
+    m_latitude(0.0),
+    m_longitude(0.0),
+    m_altitude(0),
+    m_verticalRate(0),
+    m_speed(0.0f),
+    m_heading(0.0f),
+    m_squawk(0),
+    m_positionTime(0),
+    m_headingTime(0),
+    m_lastSeen(0),
+    m_frameCount(0),
+    m_correlation(0.0f),
+    m_minCorrelation(INFINITY),
+    m_maxCorrelation(-INFINITY),
+    m_correlationOnes(0.0f)
+{
+    m_callsign[0] = '\0';
+    for (int i = 0; i < 2; i++)
+    {
+        m_cprValid[i] = false;
+        m_cprLat[i] = 0.0f;
+        m_cprLong[i] = 0.0f;
+        m_cprTime[i] = 0;
+    }
+}
+
+QString ADSBAircraftState::getEmitterCategory() const
+{
+    const char *categorySetA[] = {
+        "None", "Light", "Small", "Large", "High vortex", "Heavy", "High performance", "Rotorcraft"
+    };
+    const char *categorySetB[] = {
+        "None", "Glider/sailplane", "Lighter-than-air", "Parachutist", "Ultralight", "Reserved", "UAV", "Space vehicle"
+    };
+    const char *categorySetC[] = {
+        "None", "Emergency vehicle", "Service vehicle", "Ground obstruction", "Cluster obstacle", "Line obstacle", "Reserved", "Reserved"
+    };
+    int tc = m_emitterCategory >> 3;
+    int ec = m_emitterCategory & 0x7;
+
+    if (tc == 4) {
+        return QString(categorySetA[ec]);
+    } else if (tc == 3) {
+        return QString(categorySetB[ec]);
+    } else if (tc == 2) {
+        return QString(categorySetC[ec]);
+    } else if (tc == 1) {
+        return QStringLiteral("Reserved");
+    } else {
+        return QString();
+    }
+}
+
+QString ADSBAircraftState::getEmergencyStatus() const
+{
+    const char *emergencyStatus[] = {
+        "No emergency", "General emergency", "Lifeguard/Medical", "Minimum fuel",
+        "No communications", "Unlawful interference", "Downed aircraft", "Reserved"
+    };
+    return QString(emergencyStatus[m_emergency & 0x7]);
+}
+
+ADSBDemodDecoder::ADSBDemodDecoder() :
+    m_running(false),
+    m_reportTimer(nullptr),
+    m_stateChanged(false),
+    m_stationLatitude(0.0),
+    m_stationLongitude(0.0),
+    m_stationValid(false)
+{
+}
+
+ADSBDemodDecoder::~ADSBDemodDecoder()
+{
+    m_inputMessageQueue.clear();
+}
+
+void ADSBDemodDecoder::reset()
+{
+    m_inputMessageQueue.clear();
+    m_aircraft.clear();
+    QMutexLocker mutexLocker(&m_snapshotMutex);
+    m_snapshot.clear();
+}
+
+// Called in decoder thread when it is started
+void ADSBDemodDecoder::startWork()
+{
+    if (m_running) {
+        return;
+    }
+
+    if (!m_reportTimer)
+    {
+        m_reportTimer = new QTimer(this);
+        connect(m_reportTimer, &QTimer::timeout, this, &ADSBDemodDecoder::report);
+    }
+
+    connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
+    m_reportTimer->start(m_reportPeriodMs);
+    m_running = true;
+    handleInputMessages();
+}
+
+// Called in decoder thread when it is finishing
+void ADSBDemodDecoder::stopWork()
+{
+    if (!m_running) {
+        return;
+    }
+
+    disconnect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
+    m_reportTimer->stop();
+    m_running = false;
+}
+
+void ADSBDemodDecoder::getAircraftStates(QList<ADSBAircraftState>& aircraft)
+{
+    QMutexLocker mutexLocker(&m_snapshotMutex);
+    aircraft = m_snapshot;
+}
+
+void ADSBDemodDecoder::setStation(double latitude, double longitude)
+{
+    m_stationLatitude = latitude;
+    m_stationLongitude = longitude;
+    m_stationValid = true;
+}
+
+void ADSBDemodDecoder::handleInputMessages()
+{
+    Message* message;
+
+    while ((message = m_inputMessageQueue.pop()) != nullptr)
+    {
+        if (handleMessage(*message)) {
+            delete message;
+        }
+    }
+}
+
+bool ADSBDemodDecoder::handleMessage(const Message& message)
+{
+    if (MsgConfigureADSBDemodDecoder::match(message))
+    {
+        MsgConfigureADSBDemodDecoder& cfg = (MsgConfigureADSBDemodDecoder&) message;
+        applySettings(cfg.getSettings(), cfg.getForce());
+        return true;
+    }
+    else if (MsgConfigureStation::match(message))
+    {
+        MsgConfigureStation& cfg = (MsgConfigureStation&) message;
+        setStation(cfg.getLatitude(), cfg.getLongitude());
+        return true;
+    }
+    else if (ADSBDemodReport::MsgReportADSB::match(message))
+    {
+        ADSBDemodReport::MsgReportADSB& report = (ADSBDemodReport::MsgReportADSB&) message;
+        handleADSB(report.getData(), report.getDateTime(), report.getPreambleCorrelation(), report.getCorrelationOnes());
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void ADSBDemodDecoder::applySettings(const ADSBDemodSettings& settings, bool force)
+{
+    qDebug() << "ADSBDemodDecoder::applySettings:"
+            << " m_removeTimeout: " << settings.m_removeTimeout
+            << " force: " << force;
+
+    if ((settings.m_removeTimeout != m_settings.m_removeTimeout) || force) {
+        m_stateChanged = true; // Evict with new timeout on next report
+    }
+
+    m_settings = settings;
+}
+
+// Evict stale aircraft and publish a snapshot of the state table.
+// Called from a timer, so the snapshot is updated at a bounded rate, regardless of traffic
+void ADSBDemodDecoder::report()
+{
+    qint64 nowMSecs = QDateTime::currentMSecsSinceEpoch();
+    qint64 timeoutMSecs = m_settings.m_removeTimeout * 1000LL;
+    QHash<unsigned, ADSBAircraftState>::iterator it = m_aircraft.begin();
+
+    while (it != m_aircraft.end())
+    {
+        if (nowMSecs - it.value().m_lastSeen >= timeoutMSecs)
+        {
+            it = m_aircraft.erase(it);
+            m_stateChanged = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (m_stateChanged)
+    {
+        QList<ADSBAircraftState> snapshot;
+        snapshot.reserve(m_aircraft.size());
+
+        for (const auto& aircraft : m_aircraft) {
+            snapshot.append(aircraft);
+        }
+
+        QMutexLocker mutexLocker(&m_snapshotMutex);
+        m_snapshot.swap(snapshot);
+        m_stateChanged = false;
+    }
+}
+
+void ADSBDemodDecoder::handleADSB(const QByteArray& data, const QDateTime& dateTime, float correlation, float correlationOnes)
+{
+    int df = (data[0] >> 3) & ADS_B_DF_MASK; // Downlink format
+    int ca = data[0] & 0x7; // Capability
+
+    // Only ADS-B, non-transponder ADS-B or TIS-B rebroadcast of ADS-B (ADS-R) carry state we decode
+    if (!((df == 17) || ((df == 18) && ((ca == 0) || (ca == 1) || (ca == 6))))) {
+        return;
+    }
+
+    unsigned icao = ((data[1] & 0xff) << 16) | ((data[2] & 0xff) << 8) | (data[3] & 0xff); // ICAO aircraft address
+    int tc = (data[4] >> 3) & 0x1f; // Type code
+    qint64 msecs = dateTime.toMSecsSinceEpoch();
+
+    QHash<unsigned, ADSBAircraftState>::iterator it = m_aircraft.find(icao);
+
+    if (it == m_aircraft.end()) {
+        it = m_aircraft.insert(icao, ADSBAircraftState(icao));
+    }
+
+    ADSBAircraftState& aircraft = it.value();
+    aircraft.m_lastSeen = msecs;
+    aircraft.m_frameCount++;
+    aircraft.m_correlation = correlation;
+    aircraft.m_minCorrelation = std::min(aircraft.m_minCorrelation, correlation);
+    aircraft.m_maxCorrelation = std::max(aircraft.m_maxCorrelation, correlation);
+    aircraft.m_correlationOnes = correlationOnes;
+    m_stateChanged = true;
+
+    if ((tc >= 1) && (tc <= 4))
+    {
+        // Aircraft identification
+        aircraft.m_emitterCategory = (tc << 3) | (data[4] & 0x7);
+        decodeCallsign(data, aircraft.m_callsign);
+    }
+    else if (((tc >= 5) && (tc <= 18)) || ((tc >= 20) && (tc <= 22)))
+    {
+        bool wasOnSurface = aircraft.m_onSurface;
+        aircraft.m_onSurface = (tc >= 5) && (tc <= 8);
+
+        if (wasOnSurface != aircraft.m_onSurface)
+        {
+            // Can't mix CPR values used on surface and those that are airbourne
+            aircraft.m_cprValid[0] = false;
+            aircraft.m_cprValid[1] = false;
+        }
+
+        if (aircraft.m_onSurface)
+        {
+            // Surface position - negative so it is clipped to terrain
+            aircraft.m_altitudeValid = true;
+            aircraft.m_altitude = -200;
+
+            int movement = ((data[4] & 0x7) << 4) | ((data[5] >> 4) & 0xf);
+
+            if (movement == 0)
+            {
+                aircraft.m_speedValid = false;
+            }
+            else if (movement == 1)
+            {
+                aircraft.m_speedValid = true;
+                aircraft.m_speed = 0.0f;
+            }
+            else if (movement <= 123)
+            {
+                float base, step; // In knts
+                int adjust;
+
+                if (movement <= 8) {
+                    base = 0.125f; step = 0.125f; adjust = 2;
+                } else if (movement <= 12) {
+                    base = 1.0f; step = 0.25f; adjust = 9;
+                } else if (movement <= 38) {
+                    base = 2.0f; step = 0.5f; adjust = 13;
+                } else if (movement <= 93) {
+                    base = 15.0f; step = 1.0f; adjust = 39;
+                } else if (movement <= 108) {
+                    base = 70.0f; step = 2.0f; adjust = 94;
+                } else {
+                    base = 100.0f; step = 5.0f; adjust = 109;
+                }
+
+                aircraft.m_speed = base + (movement - adjust) * step;
+                aircraft.m_speedType = ADSBAircraftState::GS;
+                aircraft.m_speedValid = true;
+            }
+            else if (movement == 124)
+            {
+                aircraft.m_speed = 175.0f; // Actually greater than this
+                aircraft.m_speedType = ADSBAircraftState::GS;
+                aircraft.m_speedValid = true;
+            }
+
+            int groundTrackStatus = (data[5] >> 3) & 1;
+            int groundTrackValue = ((data[5] & 0x7) << 4) | ((data[6] >> 4) & 0xf);
+
+            if (groundTrackStatus)
+            {
+                aircraft.m_heading = groundTrackValue * 360.0/128.0;
+                aircraft.m_headingValid = true;
+            }
+        }
+        else
+        {
+            // Airbourne position (9-18 baro, 20-22 GNSS)
+            int alt = ((data[5] & 0xff) << 4) | ((data[6] >> 4) & 0xf);
+            aircraft.m_altitude = decodeAltitude(alt);
+            aircraft.m_altitudeValid = alt != 0;
+            aircraft.m_altitudeGNSS = (tc >= 20) && (tc <= 22);
+        }
+
+        updateCPR(aircraft, data, msecs);
+    }
+    else if (tc == 19)
+    {
+        // Airbourne velocity
+        int st = data[4] & 0x7;   // Subtype
+
+        if ((st == 1) || (st == 2))
+        {
+            // Ground speed
+            int s_ew = (data[5] >> 2) & 1;
+            int v_ew = ((data[5] & 0x3) << 8) | (data[6] & 0xff);
+            int s_ns = (data[7] >> 7) & 1;
+            int v_ns = ((data[7] & 0x7f) << 3) | ((data[8] >> 5) & 0x7);
+            int v_we = s_ew ? -(v_ew - 1) : (v_ew - 1);
+            int v_sn = s_ns ? -(v_ns - 1) : (v_ns - 1);
+            float h = std::atan2(v_we, v_sn) * 360.0/(2.0*M_PI);
+
+            if (h < 0.0f) {
+                h += 360.0f;
+            }
+
+            aircraft.m_heading = h;
+            aircraft.m_headingValid = true;
+            aircraft.m_headingTime = msecs;
+            aircraft.m_speed = std::round(std::sqrt(v_we*v_we + v_sn*v_sn));
+            aircraft.m_speedType = ADSBAircraftState::GS;
+            aircraft.m_speedValid = true;
+        }
+        else
+        {
+            // Airspeed
+            int s_hdg = (data[5] >> 2) & 1;
+            int hdg = ((data[5] & 0x3) << 8) | (data[6] & 0xff);
+
+            if (s_hdg)
+            {
+                aircraft.m_heading = hdg/1024.0f*360.0f;
+                aircraft.m_headingValid = true;
+                aircraft.m_headingTime = msecs;
+            }
+
+            int as_t = (data[7] >> 7) & 1;
+            int as = ((data[7] & 0x7f) << 3) | ((data[8] >> 5) & 0x7);
+            aircraft.m_speed = as;
+            aircraft.m_speedType = as_t ? ADSBAircraftState::IAS : ADSBAircraftState::TAS;
+            aircraft.m_speedValid = true;
+        }
+
+        int s_vr = (data[8] >> 3) & 1;
+        int vr = ((data[8] & 0x7) << 6) | ((data[9] >> 2) & 0x3f);
+        aircraft.m_verticalRate = (vr-1)*64*(s_vr?-1:1);
+        aircraft.m_verticalRateValid = true;
+    }
+    else if (tc == 28)
+    {
+        // Aircraft status
+        int st = data[4] & 0x7;
+
+        if (st == 1)
+        {
+            int modeA = ((data[5] << 8) & 0x1f00) | (data[6] & 0xff);
+            int a, b, c, d;
+            c = ((modeA >> 12) & 1) | ((modeA >> (10-1)) & 0x2) | ((modeA >> (8-2)) & 0x4);
+            a = ((modeA >> 11) & 1) | ((modeA >> (9-1)) & 0x2) | ((modeA >> (7-2)) & 0x4);
+            b = ((modeA >> 5) & 1) | ((modeA >> (3-1)) & 0x2) | ((modeA << (1)) & 0x4);
+            d = ((modeA >> 4) & 1) | ((modeA >> (2-1)) & 0x2) | ((modeA << (2)) & 0x4);
+            aircraft.m_emergency = (data[5] >> 5) & 0x7;
+            aircraft.m_squawk = a*1000 + b*100 + c*10 + d;
+            aircraft.m_squawkValid = true;
+            aircraft.m_squawkIdent = (modeA & 0x40) != 0;
+        }
+    }
+}
+
+void ADSBDemodDecoder::updateCPR(ADSBAircraftState& aircraft, const QByteArray& data, qint64 msecs)
+{
+    int f = (data[6] >> 2) & 1; // CPR odd/even frame
+    int lat_cpr = ((data[6] & 3) << 15) | ((data[7] & 0xff) << 7) | ((data[8] >> 1) & 0x7f);
+    int lon_cpr = ((data[8] & 1) << 16) | ((data[9] & 0xff) << 8) | (data[10] & 0xff);
+
+    aircraft.m_cprValid[f] = true;
+    aircraft.m_cprLat[f] = lat_cpr/131072.0f;
+    aircraft.m_cprLong[f] = lon_cpr/131072.0f;
+    aircraft.m_cprTime[f] = msecs;
+
+    double latitude, longitude;
+
+    // Global decode needs both odd and even frames less than 10s apart (C.2.6.7), otherwise position may be out by ~10deg
+    // This is reduced to 8.5s, as problems have been seen where times are just 9s apart. This may be because
+    // timestamps aren't accurate, as they are generated when packets are decoded on buffered data.
+    if (aircraft.m_cprValid[0] && aircraft.m_cprValid[1]
+        && (std::abs(aircraft.m_cprTime[0] - aircraft.m_cprTime[1]) <= 8500)
+        && !aircraft.m_onSurface)
+    {
+        CPRResult result = decodeGlobalCPR(aircraft.m_cprLat, aircraft.m_cprLong, aircraft.m_cprTime[0] >= aircraft.m_cprTime[1], f, latitude, longitude);
+
+        if (result == CPRValid)
+        {
+            aircraft.m_latitude = latitude;
+            aircraft.m_longitude = longitude;
+            aircraft.m_positionTime = msecs;
+            aircraft.m_positionValid = true;
+        }
+        else if (result == CPRInvalidLatitude)
+        {
+            aircraft.m_cprValid[0] = false;
+            aircraft.m_cprValid[1] = false;
+        }
+    }
+    else
+    {
+        // Local decode, relative to last known aircraft position if recent, otherwise to receiver
+        double refLatitude, refLongitude;
+
+        if (aircraft.m_positionValid && (msecs - aircraft.m_positionTime < 10*60*1000))
+        {
+            refLatitude = aircraft.m_latitude;
+            refLongitude = aircraft.m_longitude;
+        }
+        else if (m_stationValid)
+        {
+            refLatitude = m_stationLatitude;
+            refLongitude = m_stationLongitude;
+        }
+        else
+        {
+            return;
+        }
+
+        decodeLocalCPR(aircraft.m_cprLat[f], aircraft.m_cprLong[f], f, aircraft.m_onSurface, refLatitude, refLongitude, latitude, longitude);
+
+        if (inLocalRange(refLatitude, refLongitude, latitude, longitude, aircraft.m_onSurface))
+        {
+            aircraft.m_latitude = latitude;
+            aircraft.m_longitude = longitude;
+            aircraft.m_positionTime = msecs;
+            aircraft.m_positionValid = true;
+        }
+    }
+}
+
+// Longitude zone (returns value in range [1,59]
+int ADSBDemodDecoder::cprNL(double lat)
+{
+    if (lat == 0.0)
+    {
+        return 59;
+    }
+    else if ((lat == 87.0) || (lat == -87.0))
+    {
+        return 2;
+    }
+    else if ((lat > 87.0) || (lat < -87.0))
+    {
+        return 1;
+    }
+    else
+    {
+        double nz = 15.0;
+        double n = 1 - std::cos(M_PI / (2.0 * nz));
+        double d = std::cos(std::fabs(lat) * M_PI/180.0);
+        return std::floor((M_PI * 2.0) / std::acos(1.0 - (n/(d*d))));
+    }
+}
+
+int ADSBDemodDecoder::cprN(double lat, int odd)
+{
+    int nl = cprNL(lat) - odd;
+    if (nl > 1) {
+        return nl;
+    } else {
+        return 1;
+    }
+}
+
+// Can't use std::fmod, as that works differently for negative numbers (See C.2.6.2)
+double ADSBDemodDecoder::modulus(double x, double y)
+{
+    return x - y * std::floor(x/y);
+}
+
+int ADSBDemodDecoder::grayToBinary(int gray, int bits)
+{
+    int binary = 0;
+    for (int i = bits - 1; i >= 0; i--) {
+        binary = binary | ((((1 << (i+1)) & binary) >> 1) ^ ((1 << i) & gray));
+    }
+    return binary;
+}
+
+// Decode 12-bit altitude field from airbourne position message to feet
+int ADSBDemodDecoder::decodeAltitude(int alt)
+{
+    int q = (alt & 0x10) != 0;
+    int n = ((alt >> 1) & 0x7f0) | (alt & 0xf);  // Remove Q-bit
+
+    if (q == 1)
+    {
+        return n * 25 - 1000;
+    }
+    else
+    {
+        // https://en.wikipedia.org/wiki/Gillham_code
+        int c1 = (n >> 10) & 1;
+        int a1 = (n >> 9) & 1;
+        int c2 = (n >> 8) & 1;
+        int a2 = (n >> 7) & 1;
+        int c4 = (n >> 6) & 1;
+        int a4 = (n >> 5) & 1;
+        int b1 = (n >> 4) & 1;
+        int b2 = (n >> 3) & 1;
+        int d2 = (n >> 2) & 1;
+        int b4 = (n >> 1) & 1;
+        int d4 = n & 1;
+
+        int n500 = grayToBinary((d2 << 7) | (d4 << 6) | (a1 << 5) | (a2 << 4) | (a4 << 3) | (b1 << 2) | (b2 << 1) | b4, 4);
+        int n100 = grayToBinary((c1 << 2) | (c2 << 1) | c4, 3) - 1;
+
+        if (n100 == 6) {
+            n100 = 4;
+        }
+        if (n500 %2 != 0) {
+            n100 = 4 - n100;
+        }
+
+        return -1200 + n500*500 + n100*100;
+    }
+}
+
+// Extract 8 6-bit characters from 6 8-bit bytes, MSB first, removing trailing spaces
+void ADSBDemodDecoder::decodeCallsign(const QByteArray& data, char callsign[9])
+{
+    const char idMap[] = "#ABCDEFGHIJKLMNOPQRSTUVWXYZ##### ############-##0123456789######";
+    unsigned char c[8];
+
+    c[0] = (data[5] >> 2) & 0x3f; // 6
+    c[1] = ((data[5] & 0x3) << 4) | ((data[6] & 0xf0) >> 4);  // 2+4
+    c[2] = ((data[6] & 0xf) << 2) | ((data[7] & 0xc0) >> 6);  // 4+2
+    c[3] = (data[7] & 0x3f); // 6
+    c[4] = (data[8] >> 2) & 0x3f;
+    c[5] = ((data[8] & 0x3) << 4) | ((data[9] & 0xf0) >> 4);
+    c[6] = ((data[9] & 0xf) << 2) | ((data[10] & 0xc0) >> 6);
+    c[7] = (data[10] & 0x3f);
+
+    int start = 0;
+    int end = 8;
+
+    while ((start < end) && (idMap[c[start]] == ' ')) {
+        start++;
+    }
+    while ((end > start) && (idMap[c[end-1]] == ' ')) {
+        end--;
+    }
+    for (int i = start; i < end; i++) {
+        callsign[i-start] = idMap[c[i]];
+    }
+    callsign[end-start] = '\0';
+}
+
+// Global decode using odd and even frames (C.2.6)
+// See also: https://mode-s.org/decode/adsb/airborne-position.html
+ADSBDemodDecoder::CPRResult ADSBDemodDecoder::decodeGlobalCPR(
+    const float cprLat[2],
+    const float cprLong[2],
+    bool evenIsLatest,
+    int f,
+    double& latitude,
+    double& longitude)
+{
+    const double dLatEven = 360.0/60.0;
+    const double dLatOdd = 360.0/59.0;
+    double latEven, latOdd;
+    int ni, m;
+
+    // Calculate latitude
+    int j = std::floor(59.0f*cprLat[0] - 60.0f*cprLat[1] + 0.5);
+    latEven = dLatEven * (modulus(j, 60) + cprLat[0]);
+    // Southern hemisphere is in range 270-360, so adjust to -90-0
+    if (latEven >= 270.0) {
+        latEven -= 360.0;
+    }
+    latOdd = dLatOdd * (modulus(j, 59) + cprLat[1]);
+    if (latOdd >= 270.0) {
+        latOdd -= 360.0;
+    }
+    latitude = evenIsLatest ? latEven : latOdd;
+
+    if ((latitude > 90.0) || (latitude < -90.0)) {
+        return CPRInvalidLatitude;
+    }
+
+    // Check if both frames in same latitude zone
+    int latEvenNL = cprNL(latEven);
+    int latOddNL = cprNL(latOdd);
+
+    if (latEvenNL != latOddNL) {
+        return CPRZoneMismatch;
+    }
+
+    // Calculate longitude
+    if (!f)
+    {
+        ni = cprN(latEven, 0);
+        m = std::floor(cprLong[0] * (latEvenNL - 1) - cprLong[1] * latEvenNL + 0.5f);
+        longitude = (360.0f/ni) * (modulus(m, ni) + cprLong[0]);
+    }
+    else
+    {
+        ni = cprN(latOdd, 1);
+        m = std::floor(cprLong[0] * (latOddNL - 1) - cprLong[1] * latOddNL + 0.5f);
+        longitude = (360.0f/ni) * (modulus(m, ni) + cprLong[1]);
+    }
+    if (longitude > 180.0) {
+        longitude -= 360.0;
+    }
+
+    return CPRValid;
+}
+
+// Local decode using a single frame and a reference position (C.2.6.5)
+// Only valid if airbourne within 180nm/333km (C.2.6.4) or 45nm for surface
+void ADSBDemodDecoder::decodeLocalCPR(
+    float cprLat,
+    float cprLong,
+    int f,
+    bool onSurface,
+    double refLatitude,
+    double refLongitude,
+    double& latitude,
+    double& longitude)
+{
+    const double maxDeg = onSurface ? 90.0 : 360.0;
+    double dLat = f ? maxDeg/59.0 : maxDeg/60.0;
+
+    int j = std::floor(refLatitude/dLat) + std::floor(modulus(refLatitude, dLat)/dLat - cprLat + 0.5);
+    latitude = dLat * (j + cprLat);
+
+    double dLong;
+    int latNL = cprNL(latitude) - f;
+
+    if (latNL > 0) {
+        dLong = maxDeg / latNL;
+    } else {
+        dLong = maxDeg;
+    }
+
+    int m = std::floor(refLongitude/dLong) + std::floor(modulus(refLongitude, dLong)/dLong - cprLong + 0.5);
+    longitude = dLong * (m + cprLong);
+}
+
+// Check a locally decoded position is within the range where local decoding is unambiguous.
+// Don't use the full 333km, as there may be some error in reference position
+bool ADSBDemodDecoder::inLocalRange(double refLatitude, double refLongitude, double latitude, double longitude, bool onSurface)
+{
+    const double earthRadius = 6371000.0;
+    double lat1 = refLatitude * M_PI / 180.0;
+    double lat2 = latitude * M_PI / 180.0;
+    double dLat = lat2 - lat1;
+    double dLong = (longitude - refLongitude) * M_PI / 180.0;
+    double a = std::sin(dLat/2.0) * std::sin(dLat/2.0) + std::cos(lat1) * std::cos(lat2) * std::sin(dLong/2.0) * std::sin(dLong/2.0);
+    double distance = 2.0 * earthRadius * std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
+
+    return distance < (onSurface ? 80000.0 : 320000.0);
+}
@@ -0,0 +1,201 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Jon Beniston, M7RCE                                        //
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_ADSBDEMODDECODER_H
+#define INCLUDE_ADSBDEMODDECODER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QByteArray>
+#include <QDateTime>
+
+#include "util/message.h"
+#include "util/messagequeue.h"
+
+#include "adsbdemodsettings.h"
+
+// Decoded state of a single aircraft, kept small as there may be hundreds of these
+struct ADSBAircraftState
+{
+    enum SpeedType {GS, TAS, IAS};
+
+    unsigned m_icao;
+    char m_callsign[9];         //!< Null terminated, trailing spaces removed
+    quint8 m_emitterCategory;   //!< (Type code << 3) | emitter category, 0 if unknown
+    quint8 m_emergency;         //!< Emergency state from TC 28
+    quint8 m_speedType;         //!< SpeedType
+    bool m_positionValid;
+    bool m_altitudeValid;
+    bool m_altitudeGNSS;
+    bool m_onSurface;
+    bool m_speedValid;
+    bool m_headingValid;
+    bool m_verticalRateValid;
+    bool m_squawkValid;
+    bool m_squawkIdent;
+    bool m_cprValid[2];
+    double m_latitude;
+    double m_longitude;
+    int m_altitude;             //!< Feet
+    int m_verticalRate;         //!< Feet per minute
+    float m_speed;              //!< Knots
+    float m_heading;            //!< Degrees
+    int m_squawk;
+    float m_cprLat[2];
+    float m_cprLong[2];
+    qint64 m_cprTime[2];        //!< Milliseconds since epoch
+    qint64 m_positionTime;      //!< Milliseconds since epoch
+    qint64 m_headingTime;       //!< Milliseconds since epoch of last airborne velocity heading
+    qint64 m_lastSeen;          //!< Milliseconds since epoch
+    quint32 m_frameCount;
+    float m_correlation;        //!< Preamble correlation of last frame
+    float m_minCorrelation;
+    float m_maxCorrelation;
+    float m_correlationOnes;    //!< Correlation of ones of last frame (RSSI)
+
+    ADSBAircraftState(unsigned icao = 0);
+    QString getCallsign() const { return QString(m_callsign); }
+    QString getEmitterCategory() const;
+    QString getEmergencyStatus() const;
+};
+
+// Mode-S / ADS-B decoder and aircraft state engine. Runs in its own thread,
+// independently of any GUI, so decoded aircraft can be reported via the Web API.
+class ADSBDemodDecoder : public QObject
+{
+    Q_OBJECT
+public:
+    class MsgConfigureADSBDemodDecoder : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        const ADSBDemodSettings& getSettings() const { return m_settings; }
+        bool getForce() const { return m_force; }
+
+        static MsgConfigureADSBDemodDecoder* create(const ADSBDemodSettings& settings, bool force)
+        {
+            return new MsgConfigureADSBDemodDecoder(settings, force);
+        }
+
+    private:
+        ADSBDemodSettings m_settings;
+        bool m_force;
+
+        MsgConfigureADSBDemodDecoder(const ADSBDemodSettings& settings, bool force) :
+            Message(),
+            m_settings(settings),
+            m_force(force)
+        { }
+    };
+
+    class MsgConfigureStation : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        double getLatitude() const { return m_latitude; }
+        double getLongitude() const { return m_longitude; }
+
+        static MsgConfigureStation* create(double latitude, double longitude)
+        {
+            return new MsgConfigureStation(latitude, longitude);
+        }
+
+    private:
+        double m_latitude;
+        double m_longitude;
+
+        MsgConfigureStation(double latitude, double longitude) :
+            Message(),
+            m_latitude(latitude),
+            m_longitude(longitude)
+        { }
+    };
+
+    enum CPRResult {
+        CPRValid,
+        CPRInvalidLatitude,     //!< Frames can't be combined - they should be discarded
+        CPRZoneMismatch         //!< Frames are in different longitude zones - wait for another frame
+    };
+
+    ADSBDemodDecoder();
+    ~ADSBDemodDecoder();
+    void reset();
+    bool isRunning() const { return m_running; }
+    MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
+    void getAircraftStates(QList<ADSBAircraftState>& aircraft); //!< Thread-safe copy of last snapshot
+    void setStation(double latitude, double longitude);
+    //!< Decode a frame. In decoder thread or directly when the decoder is not started (e.g. reading a log)
+    void handleADSB(const QByteArray& data, const QDateTime& dateTime, float correlation, float correlationOnes);
+
+    // Decoding routines shared with the GUI
+    static int cprNL(double lat);
+    static int cprN(double lat, int odd);
+    static double modulus(double x, double y);
+    static int grayToBinary(int gray, int bits);
+    static int decodeAltitude(int alt);
+    static void decodeCallsign(const QByteArray& data, char callsign[9]);
+    static CPRResult decodeGlobalCPR(
+        const float cprLat[2],
+        const float cprLong[2],
+        bool evenIsLatest,
+        int f,
+        double& latitude,
+        double& longitude);
+    static void decodeLocalCPR(
+        float cprLat,
+        float cprLong,
+        int f,
+        bool onSurface,
+        double refLatitude,
+        double refLongitude,
+        double& latitude,
+        double& longitude);
+    static bool inLocalRange(double refLatitude, double refLongitude, double latitude, double longitude, bool onSurface);
+
+    static const int m_reportPeriodMs = 1000; //!< Maximum rate at which the aircraft snapshot is updated
+
+public slots:
+    void startWork();
+    void stopWork();
+    void report(); //!< Evict stale aircraft and publish snapshot. Called by timer or directly when the decoder is not started
+
+private:
+    MessageQueue m_inputMessageQueue;
+    ADSBDemodSettings m_settings;
+    bool m_running;
+    QTimer *m_reportTimer;
+    QHash<unsigned, ADSBAircraftState> m_aircraft;  //!< Per-ICAO state, only accessed in decoder thread
+    QList<ADSBAircraftState> m_snapshot;            //!< Copy of state for other threads
+    QMutex m_snapshotMutex;
+    bool m_stateChanged;
+    double m_stationLatitude;
+    double m_stationLongitude;
+    bool m_stationValid;
+
+    bool handleMessage(const Message& cmd);
+    void applySettings(const ADSBDemodSettings& settings, bool force = false);
+    void updateCPR(ADSBAircraftState& aircraft, const QByteArray& data, qint64 msecs);
+
+private slots:
+    void handleInputMessages();
+};
+
+#endif // INCLUDE_ADSBDEMODDECODER_H
@@ -55,6 +55,7 @@
 #include "mainwindow.h"
 
 #include "adsbdemodreport.h"
+#include "adsbdemoddecoder.h"
 #include "adsbdemod.h"
 #include "adsbdemodgui.h"
 #include "adsbdemodfeeddialog.h"
@@ -106,46 +107,6 @@ bool ADSBDemodGUI::deserialize(const QByteArray& data)
     }
 }
 
-// Longitude zone (returns value in range [1,59]
-static int cprNL(double lat)
-{
-    if (lat == 0.0)
-    {
-        return 59;
-    }
-    else if ((lat == 87.0) || (lat == -87.0))
-    {
-        return 2;
-    }
-    else if ((lat > 87.0) || (lat < -87.0))
-    {
-        return 1;
-    }
-    else
-    {
-        double nz = 15.0;
-        double n = 1 - std::cos(M_PI / (2.0 * nz));
-        double d = std::cos(std::fabs(lat) * M_PI/180.0);
-        return std::floor((M_PI * 2.0) / std::acos(1.0 - (n/(d*d))));
-    }
-}
-
-static int cprN(double lat, int odd)
-{
-    int nl = cprNL(lat) - odd;
-    if (nl > 1) {
-        return nl;
-    } else {
-        return 1;
-    }
-}
-
-// Can't use std::fmod, as that works differently for negative numbers (See C.2.6.2)
-static Real modulus(double x, double y)
-{
-    return x - y * std::floor(x/y);
-}
-
 QString Aircraft::getImage() const
 {
     if (m_emitterCategory.length() > 0)
@@ -701,29 +662,6 @@ void ADSBDemodGUI::updatePosition(Aircraft *aircraft)
     }
 }
 
-// Called when we have lat & long from local decode and we need to check if it is in a valid range (<180nm/333km)
-// or 1/4 of that for surface positions
-bool ADSBDemodGUI::updateLocalPosition(Aircraft *aircraft, double latitude, double longitude, bool surfacePosition)
-{
-    // Calculate range to aircraft from station
-    m_azEl.setTarget(latitude, longitude, Units::feetToMetres(aircraft->m_altitude));
-    m_azEl.calculate();
-
-    // Don't use the full 333km, as there may be some error in station position
-    if (m_azEl.getDistance() < (surfacePosition ? 80000 : 320000))
-    {
-        aircraft->m_latitude = latitude;
-        aircraft->m_longitude = longitude;
-        updatePosition(aircraft);
-        return true;
-    }
-    else
-    {
-        //qDebug() << "Local position out of range - calculated distance: " << m_azEl.getDistance();
-        return false;
-    }
-}
-
 void ADSBDemodGUI::sendToMap(Aircraft *aircraft, QList<SWGSDRangel::SWGMapAnimation *> *animations)
 {
     // Send to Map feature
@@ -742,51 +680,87 @@ void ADSBDemodGUI::sendToMap(Aircraft *aircraft, QList<SWGSDRangel::SWGMapAnimat
 
         float altitudeM = Units::feetToMetres(altitudeFt);
 
-        for (const auto& pipe : mapPipes)
+        // Items are sent to the Map feature in batches by tick()
+        m_mapItems.append(MapItemData());
+        MapItemData& mapItem = m_mapItems.last();
+        mapItem.m_name = aircraft->m_icaoHex;
+        mapItem.m_latitude = aircraft->m_latitude;
+        mapItem.m_longitude = aircraft->m_longitude;
+        mapItem.m_altitude = altitudeM;
+        mapItem.m_positionDateTime = aircraft->m_positionDateTime;
+        mapItem.m_fixedPosition = false;
+        mapItem.setImage(QString("qrc:///map/%1").arg(aircraft->getImage()));
+        mapItem.m_imageRotation = aircraft->m_heading;
+        mapItem.m_text = aircraft->getText(true);
+
+        if (!aircraft->m_aircraft3DModel.isEmpty()) {
+            mapItem.setModel(aircraft->m_aircraft3DModel);
+        } else {
+            mapItem.setModel(aircraft->m_aircraftCat3DModel);
+        }
+
+        mapItem.m_label = aircraft->m_callsign;
+
+        if (aircraft->m_headingValid)
         {
-            MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
-            SWGSDRangel::SWGMapItem *swgMapItem = new SWGSDRangel::SWGMapItem();
-            swgMapItem->setName(new QString(aircraft->m_icaoHex));
-            swgMapItem->setLatitude(aircraft->m_latitude);
-            swgMapItem->setLongitude(aircraft->m_longitude);
-            swgMapItem->setAltitude(altitudeM);
-            swgMapItem->setPositionDateTime(new QString(aircraft->m_positionDateTime.toString(Qt::ISODateWithMs)));
-            swgMapItem->setFixedPosition(false);
-            swgMapItem->setImage(new QString(QString("qrc:///map/%1").arg(aircraft->getImage())));
-            swgMapItem->setImageRotation(aircraft->m_heading);
-            swgMapItem->setText(new QString(aircraft->getText(true)));
-
-            if (!aircraft->m_aircraft3DModel.isEmpty()) {
-                swgMapItem->setModel(new QString(aircraft->m_aircraft3DModel));
-            } else {
-                swgMapItem->setModel(new QString(aircraft->m_aircraftCat3DModel));
-            }
+            mapItem.m_orientation = 1;
+            mapItem.m_heading = aircraft->m_heading;
+            mapItem.m_pitch = aircraft->m_pitch;
+            mapItem.m_roll = aircraft->m_roll;
+            mapItem.m_orientationDateTime = aircraft->m_positionDateTime;
+        }
+        else
+        {
+            // Orient aircraft based on velocity calculated from position
+            mapItem.m_orientation = 0;
+        }
 
-            swgMapItem->setLabel(new QString(aircraft->m_callsign));
+        mapItem.m_modelAltitudeOffset = aircraft->m_modelAltitudeOffset;
+        mapItem.m_labelAltitudeOffset = aircraft->m_labelAltitudeOffset;
+        mapItem.m_altitudeReference = 3; // CLIP_TO_GROUND so aircraft don't go under runway
 
-            if (aircraft->m_headingValid)
-            {
-                swgMapItem->setOrientation(1);
-                swgMapItem->setHeading(aircraft->m_heading);
-                swgMapItem->setPitch(aircraft->m_pitch);
-                swgMapItem->setRoll(aircraft->m_roll);
-                swgMapItem->setOrientationDateTime(new QString(aircraft->m_positionDateTime.toString(Qt::ISODateWithMs)));
-            }
-            else
+        if (animations)
+        {
+            for (auto swgAnimation : *animations)
             {
-                // Orient aircraft based on velocity calculated from position
-                swgMapItem->setOrientation(0);
+                MapItemData::Animation animation;
+                animation.m_name = *swgAnimation->getName();
+                animation.m_startDateTime = *swgAnimation->getStartDateTime();
+                animation.m_reverse = swgAnimation->getReverse();
+                animation.m_loop = swgAnimation->getLoop();
+                animation.m_stop = swgAnimation->getStop();
+                animation.m_startOffset = swgAnimation->getStartOffset();
+                animation.m_duration = swgAnimation->getDuration();
+                animation.m_multiplier = swgAnimation->getMultiplier();
+                mapItem.m_animations.append(animation);
             }
+        }
+    }
 
-            swgMapItem->setModelAltitudeOffset(aircraft->m_modelAltitudeOffset);
-            swgMapItem->setLabelAltitudeOffset(aircraft->m_labelAltitudeOffset);
-            swgMapItem->setAltitudeReference(3); // CLIP_TO_GROUND so aircraft don't go under runway
-            swgMapItem->setAnimations(animations);  // Does this need to be duplicated?
+    if (animations)
+    {
+        qDeleteAll(*animations);
+        delete animations;
+    }
+}
 
-            MainCore::MsgMapItem *msg = MainCore::MsgMapItem::create(m_adsbDemod, swgMapItem);
-            messageQueue->push(msg);
-        }
+// Send items accumulated since last tick to the Map feature, in a single message per Map
+void ADSBDemodGUI::sendMapItems()
+{
+    if (m_mapItems.isEmpty()) {
+        return;
     }
+
+    QList<ObjectPipe*> mapPipes;
+    MainCore::instance()->getMessagePipes().getMessagePipes(m_adsbDemod, "mapitems", mapPipes);
+
+    for (const auto& pipe : mapPipes)
+    {
+        MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
+        messageQueue->push(MainCore::MsgMapItems::create(m_adsbDemod, m_mapItems));
+    }
+
+    m_mapItems.clear();
 }
 
 QString ADSBDemodGUI::getAirlineIconPath(const QString &operatorICAO)
@@ -1049,127 +1023,59 @@ Aircraft *ADSBDemodGUI::getAircraft(int icao, bool &newAircraft)
     return aircraft;
 }
 
-void ADSBDemodGUI::handleADSB(
-    const QByteArray data,
-    const QDateTime dateTime,
-    float correlation,
-    float correlationOnes,
-    bool updateModel)
-{
-    const char idMap[] = "#ABCDEFGHIJKLMNOPQRSTUVWXYZ##### ############-##0123456789######";
-    const QString categorySetA[] = {
-        QStringLiteral("None"),
-        QStringLiteral("Light"),
-        QStringLiteral("Small"),
-        QStringLiteral("Large"),
-        QStringLiteral("High vortex"),
-        QStringLiteral("Heavy"),
-        QStringLiteral("High performance"),
-        QStringLiteral("Rotorcraft")
-    };
-    const QString categorySetB[] = {
-        QStringLiteral("None"),
-        QStringLiteral("Glider/sailplane"),
-        QStringLiteral("Lighter-than-air"),
-        QStringLiteral("Parachutist"),
-        QStringLiteral("Ultralight"),
-        QStringLiteral("Reserved"),
-        QStringLiteral("UAV"),
-        QStringLiteral("Space vehicle")
-    };
-    const QString categorySetC[] = {
-        QStringLiteral("None"),
-        QStringLiteral("Emergency vehicle"),
-        QStringLiteral("Service vehicle"),
-        QStringLiteral("Ground obstruction"),
-        QStringLiteral("Cluster obstacle"),
-        QStringLiteral("Line obstacle"),
-        QStringLiteral("Reserved"),
-        QStringLiteral("Reserved")
-    };
-    const QString emergencyStatus[] = {
-        QStringLiteral("No emergency"),
-        QStringLiteral("General emergency"),
-        QStringLiteral("Lifeguard/Medical"),
-        QStringLiteral("Minimum fuel"),
-        QStringLiteral("No communications"),
-        QStringLiteral("Unlawful interference"),
-        QStringLiteral("Downed aircraft"),
-        QStringLiteral("Reserved")
-    };
+// Update table and map from the aircraft state decoded by ADSBDemodDecoder
+void ADSBDemodGUI::updateAircraftState(const ADSBAircraftState& state, bool updateModel)
+{
+    Aircraft *aircraft = m_aircraft.value(state.m_icao, nullptr);
+
+    if (aircraft && (aircraft->m_decoderFrameCount == state.m_frameCount)) {
+        return; // No new frame since previous snapshot
+    }
 
     bool newAircraft = false;
     bool updatedCallsign = false;
     bool resetAnimation = false;
 
-    int df = (data[0] >> 3) & ADS_B_DF_MASK; // Downlink format
-    int ca = data[0] & 0x7; // Capability
-    unsigned icao = ((data[1] & 0xff) << 16) | ((data[2] & 0xff) << 8) | (data[3] & 0xff); // ICAO aircraft address
-    int tc = (data[4] >> 3) & 0x1f; // Type code
+    aircraft = getAircraft(state.m_icao, newAircraft);
 
-    Aircraft *aircraft = getAircraft(icao, newAircraft);
+    // Decoder restarts counting when reset
+    quint32 nbFrames = state.m_frameCount >= aircraft->m_decoderFrameCount ? state.m_frameCount - aircraft->m_decoderFrameCount : state.m_frameCount;
+    aircraft->m_decoderFrameCount = state.m_frameCount;
 
+    QDateTime dateTime = QDateTime::fromMSecsSinceEpoch(state.m_lastSeen);
     aircraft->m_time = dateTime;
     QTime time = dateTime.time();
     aircraft->m_timeItem->setText(QString("%1:%2:%3").arg(time.hour(), 2, 10, QLatin1Char('0')).arg(time.minute(), 2, 10, QLatin1Char('0')).arg(time.second(), 2, 10, QLatin1Char('0')));
-    aircraft->m_adsbFrameCount++;
+    aircraft->m_adsbFrameCount += nbFrames;
     aircraft->m_adsbFrameCountItem->setData(Qt::DisplayRole, aircraft->m_adsbFrameCount);
 
-    if (correlation < aircraft->m_minCorrelation)
-        aircraft->m_minCorrelation = correlation;
-    if (correlation > aircraft->m_maxCorrelation)
-        aircraft->m_maxCorrelation = correlation;
-    m_correlationAvg(correlation);
-    aircraft->m_correlationAvg(correlation);
+    aircraft->m_minCorrelation = std::min(aircraft->m_minCorrelation, state.m_minCorrelation);
+    aircraft->m_maxCorrelation = std::max(aircraft->m_maxCorrelation, state.m_maxCorrelation);
+    m_correlationAvg(state.m_correlation);
+    aircraft->m_correlationAvg(state.m_correlation);
     aircraft->m_correlation = aircraft->m_correlationAvg.instantAverage();
     aircraft->m_correlationItem->setText(QString("%1/%2/%3")
         .arg(CalcDb::dbPower(aircraft->m_minCorrelation), 3, 'f', 1)
         .arg(CalcDb::dbPower(aircraft->m_correlation), 3, 'f', 1)
         .arg(CalcDb::dbPower(aircraft->m_maxCorrelation), 3, 'f', 1));
-    m_correlationOnesAvg(correlationOnes);
+    m_correlationOnesAvg(state.m_correlationOnes);
     aircraft->m_rssiItem->setText(QString("%1")
         .arg(CalcDb::dbPower(m_correlationOnesAvg.instantAverage()), 3, 'f', 1));
 
-    // ADS-B, non-transponder ADS-B or TIS-B rebroadcast of ADS-B (ADS-R)
-    if ((df == 17) || ((df == 18) && ((ca == 0) || (ca == 1) || (ca == 6))))
+    if (state.m_emitterCategory != 0)
     {
-        if ((tc >= 1) && ((tc <= 4)))
+        // Aircraft identification
+        QString prevEmitterCategory = aircraft->m_emitterCategory;
+        aircraft->m_emitterCategory = state.getEmitterCategory();
+        aircraft->m_emitterCategoryItem->setText(aircraft->m_emitterCategory);
+
+        // Flight/callsign
+        QString callsign = state.getCallsign();
+        updatedCallsign = aircraft->m_callsign != callsign;
+
+        if (updatedCallsign)
         {
-            // Aircraft identification
-            int ec = data[4] & 0x7;   // Emitter category
-
-            QString prevEmitterCategory = aircraft->m_emitterCategory;
-            if (tc == 4) {
-                aircraft->m_emitterCategory = categorySetA[ec];
-            } else if (tc == 3) {
-                aircraft->m_emitterCategory = categorySetB[ec];
-            } else if (tc == 2) {
-                aircraft->m_emitterCategory = categorySetC[ec];
-            } else {
-                aircraft->m_emitterCategory = QStringLiteral("Reserved");
-            }
-            aircraft->m_emitterCategoryItem->setText(aircraft->m_emitterCategory);
-
-            // Flight/callsign - Extract 8 6-bit characters from 6 8-bit bytes, MSB first
-            unsigned char c[8];
-            char callsign[9];
-            c[0] = (data[5] >> 2) & 0x3f; // 6
-            c[1] = ((data[5] & 0x3) << 4) | ((data[6] & 0xf0) >> 4);  // 2+4
-            c[2] = ((data[6] & 0xf) << 2) | ((data[7] & 0xc0) >> 6);  // 4+2
-            c[3] = (data[7] & 0x3f); // 6
-            c[4] = (data[8] >> 2) & 0x3f;
-            c[5] = ((data[8] & 0x3) << 4) | ((data[9] & 0xf0) >> 4);
-            c[6] = ((data[9] & 0xf) << 2) | ((data[10] & 0xc0) >> 6);
-            c[7] = (data[10] & 0x3f);
-            // Map to ASCII
-            for (int i = 0; i < 8; i++)
-                callsign[i] = idMap[c[i]];
-            callsign[8] = '\0';
-            QString callsignTrimmed = QString(callsign).trimmed();
-
-            updatedCallsign = aircraft->m_callsign != callsignTrimmed;
-
-            aircraft->m_callsign = callsignTrimmed;
+            aircraft->m_callsign = callsign;
             aircraft->m_callsignItem->setText(aircraft->m_callsign);
 
             // Attempt to map callsign to flight number
@@ -1202,439 +1108,134 @@ void ADSBDemodGUI::handleADSB(
             {
                 aircraft->m_flight = "";
             }
+        }
 
-            // Select 3D model based on category, if we don't already have one based on ICAO
-            if (   aircraft->m_aircraft3DModel.isEmpty()
-                && (   aircraft->m_aircraftCat3DModel.isEmpty()
-                    || (prevEmitterCategory != aircraft->m_emitterCategory)
-                   )
+        // Select 3D model based on category, if we don't already have one based on ICAO
+        if (   aircraft->m_aircraft3DModel.isEmpty()
+            && (   aircraft->m_aircraftCat3DModel.isEmpty()
+                || (prevEmitterCategory != aircraft->m_emitterCategory)
                )
-            {
-                get3DModelBasedOnCategory(aircraft);
-                // As we're changing the model, we need to reset animations to
-                // ensure gear/flaps are in correct position on new model
-                resetAnimation = true;
-            }
-        }
-        else if (((tc >= 5) && (tc <= 18)) || ((tc >= 20) && (tc <= 22)))
+           )
         {
-            bool wasOnSurface = aircraft->m_onSurface;
-            aircraft->m_onSurface = (tc >= 5) && (tc <= 8);
-
-            if (wasOnSurface != aircraft->m_onSurface)
-            {
-                // Can't mix CPR values used on surface and those that are airbourne
-                aircraft->m_cprValid[0] = false;
-                aircraft->m_cprValid[1] = false;
-            }
-
-            if (aircraft->m_onSurface)
-            {
-                // Surface position
-
-                // There are a few airports that are below 0 MSL
-                // https://en.wikipedia.org/wiki/List_of_lowest_airports
-                // So we set altitude to a negative value here, which should
-                // then get clipped to actual terrain elevation in 3D map
-                aircraft->m_altitudeValid = true;
-                aircraft->m_altitude = -200;
-                aircraft->m_altitudeItem->setData(Qt::DisplayRole, "Surface");
-
-                int movement = ((data[4] & 0x7) << 4) | ((data[5] >> 4) & 0xf);
-                if (movement == 0)
-                {
-                    // No information available
-                    aircraft->m_speedValid = false;
-                    aircraft->m_speedItem->setData(Qt::DisplayRole, "");
-                }
-                else if (movement == 1)
-                {
-                    // Aircraft stopped
-                    aircraft->m_speedValid = true;
-                    aircraft->m_speedItem->setData(Qt::DisplayRole, 0);
-                    aircraft->m_speed = 0.0;
-                }
-                else if ((movement >= 2) && (movement <= 123))
-                {
-                    float base, step; // In knts
-                    int adjust;
-                    if ((movement >= 2) && (movement <= 8))
-                    {
-                        base = 0.125f;
-                        step = 0.125f;
-                        adjust = 2;
-                    }
-                    else if ((movement >= 9) && (movement <= 12))
-                    {
-                        base = 1.0f;
-                        step = 0.25f;
-                        adjust = 9;
-                    }
-                    else if ((movement >= 13) && (movement <= 38))
-                    {
-                        base = 2.0f;
-                        step = 0.5f;
-                        adjust = 13;
-                    }
-                    else if ((movement >= 39) && (movement <= 93))
-                    {
-                        base = 15.0f;
-                        step = 1.0f;
-                        adjust = 39;
-                    }
-                    else if ((movement >= 94) && (movement <= 108))
-                    {
-                        base = 70.0f;
-                        step = 2.0f;
-                        adjust = 94;
-                    }
-                    else
-                    {
-                        base = 100.0f;
-                        step = 5.0f;
-                        adjust = 109;
-                    }
-                    aircraft->m_speed = base + (movement - adjust) * step;
-                    aircraft->m_speedType = Aircraft::GS;
-                    aircraft->m_speedValid = true;
-                    aircraft->m_speedItem->setData(Qt::DisplayRole, m_settings.m_siUnits ? Units::knotsToIntegerKPH(aircraft->m_speed) : (int)std::round(aircraft->m_speed));
-                }
-                else if (movement == 124)
-                {
-                    aircraft->m_speedValid = true;
-                    aircraft->m_speedItem->setData(Qt::DisplayRole, m_settings.m_siUnits ? 324 : 175); // Actually greater than this
-                }
-
-                int groundTrackStatus = (data[5] >> 3) & 1;
-                int groundTrackValue = ((data[5] & 0x7) << 4) | ((data[6] >> 4) & 0xf);
-                if (groundTrackStatus)
-                {
-                    aircraft->m_heading = groundTrackValue * 360.0/128.0;
-                    aircraft->m_headingValid = true;
-                    aircraft->m_headingItem->setData(Qt::DisplayRole, std::round(aircraft->m_heading));
-                }
-            }
-            else if (((tc >= 9) && (tc <= 18)) || ((tc >= 20) && (tc <= 22)))
-            {
-                // Airbourne position (9-18 baro, 20-22 GNSS)
-                int alt = ((data[5] & 0xff) << 4) | ((data[6] >> 4) & 0xf); // Altitude
-                int q = (alt & 0x10) != 0;
-                int n = ((alt >> 1) & 0x7f0) | (alt & 0xf);  // Remove Q-bit
-                int alt_ft;
-                if (q == 1)
-                {
-                    alt_ft = n * ((alt & 0x10) ? 25 : 100) - 1000;
-                }
-                else
-                {
-                    // https://en.wikipedia.org/wiki/Gillham_code
-                    int c1 = (n >> 10) & 1;
-                    int a1 = (n >> 9) & 1;
-                    int c2 = (n >> 8) & 1;
-                    int a2 = (n >> 7) & 1;
-                    int c4 = (n >> 6) & 1;
-                    int a4 = (n >> 5) & 1;
-                    int b1 = (n >> 4) & 1;
-                    int b2 = (n >> 3) & 1;
-                    int d2 = (n >> 2) & 1;
-                    int b4 = (n >> 1) & 1;
-                    int d4 = n & 1;
-
-                    int n500 = grayToBinary((d2 << 7) | (d4 << 6) | (a1 << 5) | (a2 << 4) | (a4 << 3) | (b1 << 2) | (b2 << 1) | b4, 4);
-                    int n100 = grayToBinary((c1 << 2) | (c2 << 1) | c4, 3) - 1;
-
-                    if (n100 == 6) {
-                        n100 = 4;
-                    }
-                    if (n500 %2 != 0) {
-                        n100 = 4 - n100;
-                    }
+            get3DModelBasedOnCategory(aircraft);
+            // As we're changing the model, we need to reset animations to
+            // ensure gear/flaps are in correct position on new model
+            resetAnimation = true;
+        }
+    }
 
-                    alt_ft = -1200 + n500*500 + n100*100;
-                }
+    bool wasOnSurface = aircraft->m_onSurface;
+    aircraft->m_onSurface = state.m_onSurface;
 
-                aircraft->m_altitude = alt_ft;
-                aircraft->m_altitudeValid = alt != 0;
-                aircraft->m_altitudeGNSS = ((tc >= 20) && (tc <= 22));
-                // setData rather than setText so it sorts numerically
-                aircraft->m_altitudeItem->setData(Qt::DisplayRole, m_settings.m_siUnits ? Units::feetToIntegerMetres(aircraft->m_altitude) : aircraft->m_altitude);
+    if (state.m_altitudeValid)
+    {
+        aircraft->m_altitude = state.m_altitude;
+        aircraft->m_altitudeValid = true;
+        aircraft->m_altitudeGNSS = state.m_altitudeGNSS;
 
-                // Assume runway elevation is at first reported airboune altitude
-                if (wasOnSurface)
-                {
-                    aircraft->m_runwayAltitude = aircraft->m_altitude;
-                    aircraft->m_runwayAltitudeValid = true;
-                }
-            }
+        if (aircraft->m_onSurface)
+        {
+            // There are a few airports that are below 0 MSL
+            // https://en.wikipedia.org/wiki/List_of_lowest_airports
+            // So the decoder sets altitude to a negative value, which should
+            // then get clipped to actual terrain elevation in 3D map
+            aircraft->m_altitudeItem->setData(Qt::DisplayRole, "Surface");
+        }
+        else
+        {
+            // setData rather than setText so it sorts numerically
+            aircraft->m_altitudeItem->setData(Qt::DisplayRole, m_settings.m_siUnits ? Units::feetToIntegerMetres(aircraft->m_altitude) : aircraft->m_altitude);
 
-            int f = (data[6] >> 2) & 1; // CPR odd/even frame - should alternate every 0.2s
-            int lat_cpr = ((data[6] & 3) << 15) | ((data[7] & 0xff) << 7) | ((data[8] >> 1) & 0x7f);
-            int lon_cpr = ((data[8] & 1) << 16) | ((data[9] & 0xff) << 8) | (data[10] & 0xff);
-
-            aircraft->m_cprValid[f] = true;
-            aircraft->m_cprLat[f] = lat_cpr/131072.0f;
-            aircraft->m_cprLong[f] = lon_cpr/131072.0f;
-            aircraft->m_cprTime[f] = dateTime;
-
-            // CPR decoding
-            // Refer to Technical Provisions  for Mode S Services and Extended Squitter - Appendix C2.6
-            // See also: https://mode-s.org/decode/adsb/airborne-position.html
-            // For global decoding, we need both odd and even frames
-            // We also need to check that both frames aren't greater than 10s apart in time (C.2.6.7), otherwise position may be out by ~10deg
-            // I've reduced this to 8.5s, as problems have been seen where times are just 9s apart. This may be because
-            // our timestamps aren't accurate, as the times are generated when packets are decoded on buffered data.
-            // We could compare global + local methods to see if the positions are sensible
-            if (aircraft->m_cprValid[0] && aircraft->m_cprValid[1]
-               && (std::abs(aircraft->m_cprTime[0].toMSecsSinceEpoch() - aircraft->m_cprTime[1].toMSecsSinceEpoch()) <= 8500)
-               && !aircraft->m_onSurface)
+            // Assume runway elevation is at first reported airbourne altitude
+            if (wasOnSurface)
             {
-                // Global decode using odd and even frames (C.2.6)
-
-                // Calculate latitude
-                const double dLatEven = 360.0/60.0;
-                const double dLatOdd = 360.0/59.0;
-                double latEven, latOdd;
-                double latitude, longitude;
-                int ni, m;
-
-                int j = std::floor(59.0f*aircraft->m_cprLat[0] - 60.0f*aircraft->m_cprLat[1] + 0.5);
-                latEven = dLatEven * (modulus(j, 60) + aircraft->m_cprLat[0]);
-                // Southern hemisphere is in range 270-360, so adjust to -90-0
-                if (latEven >= 270.0f)
-                    latEven -= 360.0f;
-                latOdd = dLatOdd * (modulus(j, 59) + aircraft->m_cprLat[1]);
-                if (latOdd >= 270.0f)
-                    latOdd -= 360.0f;
-                if (aircraft->m_cprTime[0] >= aircraft->m_cprTime[1])
-                    latitude = latEven;
-                else
-                    latitude = latOdd;
-                if ((latitude <= 90.0) && (latitude >= -90.0))
-                {
-                    // Check if both frames in same latitude zone
-                    int latEvenNL = cprNL(latEven);
-                    int latOddNL = cprNL(latOdd);
-                    if (latEvenNL == latOddNL)
-                    {
-                        // Calculate longitude
-                        if (!f)
-                        {
-                            ni = cprN(latEven, 0);
-                            m = std::floor(aircraft->m_cprLong[0] * (latEvenNL - 1) - aircraft->m_cprLong[1] * latEvenNL + 0.5f);
-                            longitude = (360.0f/ni) * (modulus(m, ni) + aircraft->m_cprLong[0]);
-                        }
-                        else
-                        {
-                            ni = cprN(latOdd, 1);
-                            m = std::floor(aircraft->m_cprLong[0] * (latOddNL - 1) - aircraft->m_cprLong[1] * latOddNL + 0.5f);
-                            longitude = (360.0f/ni) * (modulus(m, ni) + aircraft->m_cprLong[1]);
-                        }
-                        if (longitude > 180.0f)
-                            longitude -= 360.0f;
-                        aircraft->m_latitude = latitude;
-                        aircraft->m_latitudeItem->setData(Qt::DisplayRole, aircraft->m_latitude);
-                        aircraft->m_longitude = longitude;
-                        aircraft->m_longitudeItem->setData(Qt::DisplayRole, aircraft->m_longitude);
-                        aircraft->m_positionDateTime = dateTime;
-                        QGeoCoordinate coord(aircraft->m_latitude, aircraft->m_longitude, aircraft->m_altitude);
-                        aircraft->m_coordinates.push_back(QVariant::fromValue(coord));
-                        updatePosition(aircraft);
-                    }
-                }
-                else
-                {
-                    qDebug() << "ADSBDemodGUI::handleADSB: Invalid latitude " << latitude << " for " << QString("%1").arg(aircraft->m_icaoHex)
-                        << " m_cprLat[0] " << aircraft->m_cprLat[0]
-                        << " m_cprLat[1] " << aircraft->m_cprLat[1];
-                    aircraft->m_cprValid[0] = false;
-                    aircraft->m_cprValid[1] = false;
-                }
-            }
-            else
-            {
-                // Local decode using a single aircraft position + location of receiver
-                // Only valid if airbourne within 180nm/333km (C.2.6.4) or 45nm for surface
-
-                // Caclulate latitude
-                const double maxDeg = aircraft->m_onSurface ? 90.0 : 360.0;
-                const double dLatEven = maxDeg/60.0;
-                const double dLatOdd = maxDeg/59.0;
-                double dLat = f ? dLatOdd : dLatEven;
-                double latitude, longitude;
-
-                int j = std::floor(m_azEl.getLocationSpherical().m_latitude/dLat) + std::floor(modulus(m_azEl.getLocationSpherical().m_latitude, dLat)/dLat - aircraft->m_cprLat[f] + 0.5);
-                latitude = dLat * (j + aircraft->m_cprLat[f]);
-
-                // Caclulate longitude
-                double dLong;
-                int latNL = cprNL(latitude);
-                if (f == 0)
-                {
-                    if (latNL > 0)
-                        dLong = maxDeg / latNL;
-                    else
-                        dLong = maxDeg;
-                }
-                else
-                {
-                    if ((latNL - 1) > 0)
-                        dLong = maxDeg / (latNL - 1);
-                    else
-                        dLong = maxDeg;
-                }
-                int m = std::floor(m_azEl.getLocationSpherical().m_longitude/dLong) + std::floor(modulus(m_azEl.getLocationSpherical().m_longitude, dLong)/dLong - aircraft->m_cprLong[f] + 0.5);
-                longitude =  dLong * (m + aircraft->m_cprLong[f]);
-
-                if (updateLocalPosition(aircraft, latitude, longitude, aircraft->m_onSurface))
-                {
-                    aircraft->m_latitude = latitude;
-                    aircraft->m_latitudeItem->setData(Qt::DisplayRole, aircraft->m_latitude);
-                    aircraft->m_longitude = longitude;
-                    aircraft->m_longitudeItem->setData(Qt::DisplayRole, aircraft->m_longitude);
-                    aircraft->m_positionDateTime = dateTime;
-                    QGeoCoordinate coord(aircraft->m_latitude, aircraft->m_longitude, aircraft->m_altitude);
-                    aircraft->m_coordinates.push_back(QVariant::fromValue(coord));
-                }
+                aircraft->m_runwayAltitude = aircraft->m_altitude;
+                aircraft->m_runwayAltitudeValid = true;
             }
         }
-        else if (tc == 19)
-        {
-            // Airbourne velocity
-            int st = data[4] & 0x7;   // Subtype
-            if ((st == 1) || (st == 2))
-            {
-                // Ground speed
-                int s_ew = (data[5] >> 2) & 1; // East-west velocity sign
-                int v_ew = ((data[5] & 0x3) << 8) | (data[6] & 0xff); // East-west velocity
-                int s_ns = (data[7] >> 7) & 1; // North-south velocity sign
-                int v_ns = ((data[7] & 0x7f) << 3) | ((data[8] >> 5) & 0x7); // North-south velocity
-
-                int v_we;
-                int v_sn;
-                float v;
-                float h;
-
-                if (s_ew) {
-                    v_we = -1 * (v_ew - 1);
-                } else {
-                    v_we = v_ew - 1;
-                }
-                if (s_ns) {
-                    v_sn = -1 * (v_ns - 1);
-                } else {
-                    v_sn = v_ns - 1;
-                }
-                v = std::round(std::sqrt(v_we*v_we + v_sn*v_sn));
-                h = std::atan2(v_we, v_sn) * 360.0/(2.0*M_PI);
-                if (h < 0.0) {
-                    h += 360.0;
-                }
+    }
 
-                aircraft->m_heading = h;
-                aircraft->m_headingValid = true;
-                aircraft->m_headingDateTime = dateTime;
-                aircraft->m_speed = v;
-                aircraft->m_speedType = Aircraft::GS;
-                aircraft->m_speedValid = true;
-                aircraft->m_headingItem->setData(Qt::DisplayRole, std::round(aircraft->m_heading));
-                aircraft->m_speedItem->setData(Qt::DisplayRole, m_settings.m_siUnits ? Units::knotsToIntegerKPH(aircraft->m_speed) : aircraft->m_speed);
-                aircraft->m_orientationDateTime = dateTime;
-            }
-            else
-            {
-                // Airspeed
-                int s_hdg = (data[5] >> 2) & 1; // Heading status
-                int hdg =  ((data[5] & 0x3) << 8) | (data[6] & 0xff); // Heading
-                if (s_hdg)
-                {
-                    aircraft->m_heading = hdg/1024.0f*360.0f;
-                    aircraft->m_headingValid = true;
-                    aircraft->m_headingDateTime = dateTime;
-                    aircraft->m_headingItem->setData(Qt::DisplayRole, std::round(aircraft->m_heading));
-                    aircraft->m_orientationDateTime = dateTime;
-                }
+    if (state.m_speedValid)
+    {
+        aircraft->m_speed = std::round(state.m_speed);
+        aircraft->m_speedType = (Aircraft::SpeedType) state.m_speedType;
+        aircraft->m_speedValid = true;
+        aircraft->m_speedItem->setData(Qt::DisplayRole, m_settings.m_siUnits ? Units::knotsToIntegerKPH(aircraft->m_speed) : aircraft->m_speed);
+    }
 
-                int as_t = (data[7] >> 7) & 1; // Airspeed type
-                int as = ((data[7] & 0x7f) << 3) | ((data[8] >> 5) & 0x7); // Airspeed
+    if (state.m_headingValid)
+    {
+        aircraft->m_heading = state.m_heading;
+        aircraft->m_headingValid = true;
+        aircraft->m_headingItem->setData(Qt::DisplayRole, std::round(aircraft->m_heading));
 
-                aircraft->m_speed = as;
-                aircraft->m_speedType = as_t ? Aircraft::IAS : Aircraft::TAS;
-                aircraft->m_speedValid = true;
-                aircraft->m_speedItem->setData(Qt::DisplayRole, m_settings.m_siUnits ? Units::knotsToIntegerKPH(aircraft->m_speed) : aircraft->m_speed);
-            }
-            int s_vr = (data[8] >> 3) & 1; // Vertical rate sign
-            int vr = ((data[8] & 0x7) << 6) | ((data[9] >> 2) & 0x3f); // Vertical rate
-            aircraft->m_verticalRate = (vr-1)*64*(s_vr?-1:1);
-            aircraft->m_verticalRateValid = true;
-            if (m_settings.m_siUnits)
-                aircraft->m_verticalRateItem->setData(Qt::DisplayRole, Units::feetPerMinToIntegerMetresPerSecond(aircraft->m_verticalRate));
-            else
-                aircraft->m_verticalRateItem->setData(Qt::DisplayRole, aircraft->m_verticalRate);
-        }
-        else if (tc == 28)
-        {
-            // Aircraft status
-            int st = data[4] & 0x7;   // Subtype
-            if (st == 1)
-            {
-                int es = (data[5] >> 5) & 0x7; // Emergency state
-                int modeA =  ((data[5] << 8) & 0x1f00) | (data[6] & 0xff); // Mode-A code (squawk)
-                aircraft->m_status = emergencyStatus[es];
-                aircraft->m_statusItem->setText(aircraft->m_status);
-                int a, b, c, d;
-                c = ((modeA >> 12) & 1) | ((modeA >> (10-1)) & 0x2) | ((modeA >> (8-2)) & 0x4);
-                a = ((modeA >> 11) & 1) | ((modeA >> (9-1)) & 0x2) | ((modeA >> (7-2)) & 0x4);
-                b = ((modeA >> 5) & 1) | ((modeA >> (3-1)) & 0x2) | ((modeA << (1)) & 0x4);
-                d = ((modeA >> 4) & 1) | ((modeA >> (2-1)) & 0x2) | ((modeA << (2)) & 0x4);
-                aircraft->m_squawk = a*1000 + b*100 + c*10 + d;
-                if (modeA & 0x40)
-                    aircraft->m_squawkItem->setText(QString("%1 IDENT").arg(aircraft->m_squawk, 4, 10, QLatin1Char('0')));
-                else
-                    aircraft->m_squawkItem->setText(QString("%1").arg(aircraft->m_squawk, 4, 10, QLatin1Char('0')));
-            }
-            else if (st == 2)
-            {
-                // TCAS/ACAS RA Broadcast
-            }
-        }
-        else if (tc == 29)
-        {
-            // Target state and status
-        }
-        else if (tc == 31)
+        QDateTime headingDateTime = QDateTime::fromMSecsSinceEpoch(state.m_headingTime);
+
+        if ((state.m_headingTime != 0) && (headingDateTime != aircraft->m_headingDateTime))
         {
-            // Aircraft operation status
+            aircraft->m_headingDateTime = headingDateTime;
+            aircraft->m_orientationDateTime = headingDateTime;
         }
+    }
 
-        // Update aircraft in map
-        if (aircraft->m_positionValid)
-        {
-            // Check to see if we need to start any animations
-            QList<SWGSDRangel::SWGMapAnimation *> *animations = animate(dateTime, aircraft);
+    if (state.m_verticalRateValid)
+    {
+        aircraft->m_verticalRate = state.m_verticalRate;
+        aircraft->m_verticalRateValid = true;
+        if (m_settings.m_siUnits)
+            aircraft->m_verticalRateItem->setData(Qt::DisplayRole, Units::feetPerMinToIntegerMetresPerSecond(aircraft->m_verticalRate));
+        else
+            aircraft->m_verticalRateItem->setData(Qt::DisplayRole, aircraft->m_verticalRate);
+    }
 
-            // Update map displayed in channel
-            if (updateModel) {
-                m_aircraftModel.aircraftUpdated(aircraft);
-            }
+    if (state.m_squawkValid)
+    {
+        aircraft->m_status = state.getEmergencyStatus();
+        aircraft->m_statusItem->setText(aircraft->m_status);
+        aircraft->m_squawk = state.m_squawk;
+        if (state.m_squawkIdent)
+            aircraft->m_squawkItem->setText(QString("%1 IDENT").arg(aircraft->m_squawk, 4, 10, QLatin1Char('0')));
+        else
+            aircraft->m_squawkItem->setText(QString("%1").arg(aircraft->m_squawk, 4, 10, QLatin1Char('0')));
+    }
 
-            // Send to Map feature
-            sendToMap(aircraft, animations);
+    QDateTime positionDateTime = QDateTime::fromMSecsSinceEpoch(state.m_positionTime);
 
-            if (resetAnimation)
-            {
-                // Wait until after model has changed before reseting
-                // otherwise animation might play on old model
-                aircraft->m_gearDown = false;
-                aircraft->m_flaps = 0.0;
-                aircraft->m_engineStarted = false;
-                aircraft->m_rotorStarted = false;
-            }
-        }
+    if (state.m_positionValid && (positionDateTime != aircraft->m_positionDateTime))
+    {
+        aircraft->m_latitude = state.m_latitude;
+        aircraft->m_latitudeItem->setData(Qt::DisplayRole, aircraft->m_latitude);
+        aircraft->m_longitude = state.m_longitude;
+        aircraft->m_longitudeItem->setData(Qt::DisplayRole, aircraft->m_longitude);
+        aircraft->m_positionDateTime = positionDateTime;
+        QGeoCoordinate coord(aircraft->m_latitude, aircraft->m_longitude, aircraft->m_altitude);
+        aircraft->m_coordinates.push_back(QVariant::fromValue(coord));
+        updatePosition(aircraft);
     }
-    else if (df == 18)
+
+    // Update aircraft in map
+    if (aircraft->m_positionValid)
     {
-        // TIS-B
-        qDebug() << "TIS B message cf=" << ca << " icao: " << icao;
+        // Check to see if we need to start any animations
+        QList<SWGSDRangel::SWGMapAnimation *> *animations = animate(dateTime, aircraft);
+
+        // Update map displayed in channel
+        if (updateModel) {
+            m_aircraftModel.aircraftUpdated(aircraft);
+        }
+
+        // Send to Map feature
+        sendToMap(aircraft, animations);
+
+        if (resetAnimation)
+        {
+            // Wait until after model has changed before reseting
+            // otherwise animation might play on old model
+            aircraft->m_gearDown = false;
+            aircraft->m_flaps = 0.0;
+            aircraft->m_engineStarted = false;
+            aircraft->m_rotorStarted = false;
+        }
     }
 
     // Check to see if we need to emit a notification about this aircraft
@@ -2166,17 +1767,6 @@ bool ADSBDemodGUI::handleMessage(const Message& message)
         updateAbsoluteCenterFrequency();
         return true;
     }
-    else if (ADSBDemodReport::MsgReportADSB::match(message))
-    {
-        ADSBDemodReport::MsgReportADSB& report = (ADSBDemodReport::MsgReportADSB&) message;
-        handleADSB(
-            report.getData(),
-            report.getDateTime(),
-            report.getPreambleCorrelation(),
-            report.getCorrelationOnes(),
-            true);
-        return true;
-    }
     else if (ADSBDemodReport::MsgReportDemodStats::match(message))
     {
         ADSBDemodReport::MsgReportDemodStats& report = (ADSBDemodReport::MsgReportDemodStats&) message;
@@ -4097,6 +3687,17 @@ void ADSBDemodGUI::tick()
 
     m_tickCount++;
 
+    // Decoder publishes its aircraft snapshot at most once a second
+    if (m_tickCount % 20 == 0)
+    {
+        QList<ADSBAircraftState> aircraftStates;
+        m_adsbDemod->getAircraftStates(aircraftStates);
+
+        for (const auto& state : aircraftStates) {
+            updateAircraftState(state, true);
+        }
+    }
+
     // Tick is called 20x a second - lets check this every 10 seconds
     if (m_tickCount % (20*10) == 0)
     {
@@ -4125,19 +3726,9 @@ void ADSBDemodGUI::tick()
                 ui->adsbData->removeRow(aircraft->m_icaoItem->row());
                 // Remove aircraft from hash
                 i = m_aircraft.erase(i);
-                // Remove from map feature
-                QList<ObjectPipe*> mapPipes;
-                MainCore::instance()->getMessagePipes().getMessagePipes(this, "mapitems", mapPipes);
-
-                for (const auto& pipe : mapPipes)
-                {
-                    MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
-                    SWGSDRangel::SWGMapItem *swgMapItem = new SWGSDRangel::SWGMapItem();
-                    swgMapItem->setName(new QString(QString("%1").arg(aircraft->m_icao, 0, 16)));
-                    swgMapItem->setImage(new QString(""));
-                    MainCore::MsgMapItem *msg = MainCore::MsgMapItem::create(m_adsbDemod, swgMapItem);
-                    messageQueue->push(msg);
-                }
+                // Remove from map feature (empty image)
+                m_mapItems.append(MapItemData());
+                m_mapItems.last().m_name = QString("%1").arg(aircraft->m_icao, 0, 16);
 
                 // And finally free its memory
                 delete aircraft;
@@ -4148,6 +3739,8 @@ void ADSBDemodGUI::tick()
             }
         }
     }
+
+    sendMapItems();
 }
 
 void ADSBDemodGUI::resizeTable()
@@ -4332,7 +3925,7 @@ void ADSBDemodGUI::on_logFilename_clicked()
     }
 }
 
-// Read .csv log and process as received frames
+// Read .csv log and decode frames as if received
 void ADSBDemodGUI::on_logOpen_clicked()
 {
     QFileDialog fileDialog(nullptr, "Select .csv log file to read", "", "*.csv");
@@ -4361,6 +3954,9 @@ void ADSBDemodGUI::on_logOpen_clicked()
                     int count = 0;
                     bool cancelled = false;
                     QStringList cols;
+                    // Decoded here as the channel decoder may not be running
+                    ADSBDemodDecoder decoder;
+                    decoder.setStation(m_azEl.getLocationSpherical().m_latitude, m_azEl.getLocationSpherical().m_longitude);
                     while (!cancelled && CSV::readRow(in, &cols))
                     {
                         if (cols.size() > maxCol)
@@ -4368,7 +3964,7 @@ void ADSBDemodGUI::on_logOpen_clicked()
                             QDateTime dateTime = QDateTime::currentDateTime(); // So they aren't removed immediately as too old
                             QByteArray bytes = QByteArray::fromHex(cols[dataCol].toLatin1());
                             float correlation = cols[correlationCol].toFloat();
-                            handleADSB(bytes, dateTime, correlation, correlation, false);
+                            decoder.handleADSB(bytes, dateTime, correlation, correlation);
                             if ((count > 0) && (count % 100000 == 0))
                             {
                                 dialog.setText(QString("Reading ADS-B data\n%1").arg(count));
@@ -4380,6 +3976,12 @@ void ADSBDemodGUI::on_logOpen_clicked()
                             count++;
                         }
                     }
+                    decoder.report();
+                    QList<ADSBAircraftState> aircraftStates;
+                    decoder.getAircraftStates(aircraftStates);
+                    for (const auto& state : aircraftStates) {
+                        updateAircraftState(state, false);
+                    }
                     m_aircraftModel.allAircraftUpdated();
                     dialog.close();
                 }
@@ -4441,15 +4043,6 @@ void ADSBDemodGUI::downloadNavAidsFinished()
     }
 }
 
-int ADSBDemodGUI::grayToBinary(int gray, int bits) const
-{
-    int binary = 0;
-    for (int i = bits - 1; i >= 0; i--) {
-        binary = binary | ((((1 << (i+1)) & binary) >> 1) ^ ((1 << i) & gray));
-    }
-    return binary;
-}
-
 void ADSBDemodGUI::redrawMap()
 {
     // An awful workaround for https://bugreports.qt.io/browse/QTBUG-100333
@@ -4595,8 +4188,6 @@ void ADSBDemodGUI::handleImportReply(QNetworkReply* reply)
                                 aircraft->m_longitudeItem->setData(Qt::DisplayRole, aircraft->m_longitude);
                                 aircraft->m_latitudeItem->setData(Qt::DisplayRole, aircraft->m_latitude);
                                 updatePosition(aircraft);
-                                aircraft->m_cprValid[0] = false;
-                                aircraft->m_cprValid[1] = false;
                             }
                             if (!state[7].isNull())
                             {
@@ -54,6 +54,7 @@ class PluginAPI;
 class DeviceUISet;
 class BasebandSampleSink;
 class ADSBDemod;
+struct ADSBAircraftState;
 class WebAPIAdapterInterface;
 class HttpDownloadManager;
 class ADSBDemodGUI;
@@ -119,13 +120,8 @@ struct Aircraft {
     bool m_headingValid;
     bool m_verticalRateValid;
 
-    // State for calculating position using two CPR frames
-    bool m_cprValid[2];
-    Real m_cprLat[2];
-    Real m_cprLong[2];
-    QDateTime m_cprTime[2];
-
     int m_adsbFrameCount;       // Number of ADS-B frames for this aircraft
+    quint32 m_decoderFrameCount; // Frame count in last decoder state applied
     float m_minCorrelation;
     float m_maxCorrelation;
     float m_correlation;
@@ -218,6 +214,7 @@ struct Aircraft {
         m_headingValid(false),
         m_verticalRateValid(false),
         m_adsbFrameCount(0),
+        m_decoderFrameCount(0),
         m_minCorrelation(INFINITY),
         m_maxCorrelation(-INFINITY),
         m_correlation(0.0f),
@@ -238,10 +235,6 @@ struct Aircraft {
         m_roll(0.0),
         m_notified(false)
     {
-        for (int i = 0; i < 2; i++)
-        {
-            m_cprValid[i] = false;
-        }
         // These are deleted by QTableWidget
         m_icaoItem = new QTableWidgetItem();
         m_callsignItem = new QTableWidgetItem();
@@ -820,6 +813,7 @@ private:
     MessageQueue m_inputMessageQueue;
 
     QHash<int, Aircraft *> m_aircraft;  // Hashed on ICAO
+    QVector<MapItemData> m_mapItems;    // Pending for Map feature
     QHash<int, AircraftInformation *> *m_aircraftInfo;
     QHash<int, AirportInformation *> *m_airportInfo; // Hashed on id
     AircraftModel m_aircraftModel;
@@ -878,15 +872,10 @@ private:
     void updateAbsoluteCenterFrequency();
 
     void updatePosition(Aircraft *aircraft);
-    bool updateLocalPosition(Aircraft *aircraft, double latitude, double longitude, bool surfacePosition);
     void sendToMap(Aircraft *aircraft, QList<SWGSDRangel::SWGMapAnimation *> *animations);
+    void sendMapItems();
     Aircraft *getAircraft(int icao, bool &newAircraft);
-    void handleADSB(
-        const QByteArray data,
-        const QDateTime dateTime,
-        float correlation,
-        float correlationOnes,
-        bool updateModel);
+    void updateAircraftState(const ADSBAircraftState& state, bool updateModel);
     QList<SWGSDRangel::SWGMapAnimation *> *animate(QDateTime dateTime, Aircraft *aircraft);
     SWGSDRangel::SWGMapAnimation *gearAnimation(QDateTime startDateTime, bool up);
     SWGSDRangel::SWGMapAnimation *flapsAnimation(QDateTime startDateTime, float currentFlaps, float flaps);
@@ -929,7 +918,6 @@ private:
     void updatePhotoText(Aircraft *aircraft);
     void updatePhotoFlightInformation(Aircraft *aircraft);
     void findOnChannelMap(Aircraft *aircraft);
-    int grayToBinary(int gray, int bits) const;
     void redrawMap();
     void applyImportSettings();
 
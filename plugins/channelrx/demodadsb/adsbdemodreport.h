@@ -36,7 +36,8 @@ public:
 
     public:
         QByteArray getData() const { return m_data; }
-        QDateTime getDateTime() const { return m_dateTime; }
+        QDateTime getDateTime() const { return QDateTime::fromMSecsSinceEpoch(m_dateTimeNs / 1000000); }
+        qint64 getDateTimeNs() const { return m_dateTimeNs; }
         float getPreambleCorrelation() const { return m_preambleCorrelation; }
         float getCorrelationOnes() const { return m_correlationOnes; }
 
@@ -44,15 +45,15 @@ public:
             QByteArray data,
             float preambleCorrelation,
             float correlationOnes,
-            QDateTime dateTime
+            qint64 dateTimeNs
         )
         {
-            return new MsgReportADSB(data, preambleCorrelation, correlationOnes, dateTime);
+            return new MsgReportADSB(data, preambleCorrelation, correlationOnes, dateTimeNs);
         }
 
     private:
         QByteArray m_data;
-        QDateTime m_dateTime;
+        qint64 m_dateTimeNs;    //!< Receive time of the first preamble sample in ns since epoch
         float m_preambleCorrelation;
         float m_correlationOnes;
 
@@ -60,11 +61,11 @@ public:
             QByteArray data,
             float preambleCorrelation,
             float correlationOnes,
-            QDateTime dateTime
+            qint64 dateTimeNs
         ) :
             Message(),
             m_data(data),
-            m_dateTime(dateTime),
+            m_dateTimeNs(dateTimeNs),
             m_preambleCorrelation(preambleCorrelation),
             m_correlationOnes(correlationOnes)
         {
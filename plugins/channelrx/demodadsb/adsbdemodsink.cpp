@@ -35,6 +35,7 @@ ADSBDemodSink::ADSBDemodSink() :
     m_channelSampleRate(6000000),
     m_channelFrequencyOffset(0),
     m_feedTime(0.0),
+    m_samplesSinceTimestamp(0),
     m_sampleBuffer{nullptr, nullptr, nullptr},
     m_worker(this),
     m_writeBuffer(0),
@@ -43,7 +44,9 @@ ADSBDemodSink::ADSBDemodSink() :
     m_magsqSum(0.0f),
     m_magsqPeak(0.0f),
     m_magsqCount(0),
-    m_messageQueueToGUI(nullptr)
+    m_messageQueueToGUI(nullptr),
+    m_messageQueueToWorker(nullptr),
+    m_messageQueueToDecoder(nullptr)
 {
     applySettings(m_settings, true);
     applyChannelSettings(m_channelSampleRate, m_channelFrequencyOffset, true);
@@ -92,32 +95,22 @@ void ADSBDemodSink::feed(const SampleVector::const_iterator& begin, const Sample
             processOneSample(complexMagSq(c));
         }
     }
-    else if (m_interpolatorDistance < 1.0f) // interpolate
+    else // interpolate or decimate the whole block
     {
-        for (SampleVector::const_iterator it = begin; it != end; ++it)
+        unsigned int nbIn = end - begin;
+        m_resamplerIn.resize(nbIn);
+
+        for (unsigned int i = 0; i < nbIn; i++)
         {
-            Complex c(it->real(), it->imag());
-            Complex ci;
-            c *= m_nco.nextIQ();
-            while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(complexMagSq(ci));
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
+            Complex c(begin[i].real(), begin[i].imag());
+            m_resamplerIn[i] = c * m_nco.nextIQ();
         }
-    }
-    else // decimate
-    {
-        for (SampleVector::const_iterator it = begin; it != end; ++it)
-        {
-            Complex c(it->real(), it->imag());
-            Complex ci;
-            c *= m_nco.nextIQ();
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(complexMagSq(ci));
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
+
+        m_resamplerOut.clear();
+        m_interpolator.resample(m_interpolatorDistance, &m_interpolatorDistanceRemain, m_resamplerIn.data(), nbIn, m_resamplerOut);
+
+        for (auto& ci : m_resamplerOut) {
+            processOneSample(complexMagSq(ci));
         }
     }
 
@@ -126,6 +119,12 @@ void ADSBDemodSink::feed(const SampleVector::const_iterator& begin, const Sample
     m_feedTime += sec.count();
 }
 
+void ADSBDemodSink::setTimestamp(const SampleTimestamp& timestamp)
+{
+    m_timestamp = timestamp;
+    m_samplesSinceTimestamp = 0;
+}
+
 void ADSBDemodSink::processOneSample(Real magsq)
 {
     m_magsqSum += magsq;
@@ -136,9 +135,15 @@ void ADSBDemodSink::processOneSample(Real magsq)
     m_writeIdx++;
     if (!m_bufferDateTimeValid[m_writeBuffer])
     {
-        m_bufferFirstSampleDateTime[m_writeBuffer] = QDateTime::currentDateTime();
+        // m_samplesSinceTimestamp is the index in the block of the sample just written
+        if (m_timestamp.isValid()) {
+            m_bufferFirstSampleNs[m_writeBuffer] = m_timestamp.getTimeNs(m_samplesSinceTimestamp, ADS_B_BITS_PER_SECOND * m_settings.m_samplesPerBit);
+        } else {
+            m_bufferFirstSampleNs[m_writeBuffer] = QDateTime::currentMSecsSinceEpoch() * 1000000LL;
+        }
         m_bufferDateTimeValid[m_writeBuffer] = true;
     }
+    m_samplesSinceTimestamp++;
     if (m_writeIdx >= m_bufferSize)
     {
         m_bufferRead[m_writeBuffer].release();
@@ -248,8 +253,8 @@ void ADSBDemodSink::applyChannelSettings(int channelSampleRate, int channelFrequ
     if ((channelSampleRate != m_channelSampleRate) || force)
     {
         m_interpolator.create(m_settings.m_interpolatorPhaseSteps, channelSampleRate, m_settings.m_rfBandwidth / 2.2,  m_settings.m_interpolatorTapsPerPhase);
-        m_interpolatorDistanceRemain = 0;
         m_interpolatorDistance = (Real) channelSampleRate / (Real) (ADS_B_BITS_PER_SECOND * m_settings.m_samplesPerBit);
+        m_interpolatorDistanceRemain = m_interpolatorDistance;
     }
 
     m_channelSampleRate = channelSampleRate;
@@ -274,8 +279,8 @@ void ADSBDemodSink::applySettings(const ADSBDemodSettings& settings, bool force)
         || force)
     {
         m_interpolator.create(m_settings.m_interpolatorPhaseSteps, m_channelSampleRate, settings.m_rfBandwidth / 2.2,  m_settings.m_interpolatorTapsPerPhase);
-        m_interpolatorDistanceRemain = 0;
         m_interpolatorDistance =  (Real) m_channelSampleRate / (Real) (ADS_B_BITS_PER_SECOND * settings.m_samplesPerBit);
+        m_interpolatorDistanceRemain = m_interpolatorDistance;
     }
 
     if ((settings.m_samplesPerBit != m_settings.m_samplesPerBit) || force)
@@ -24,7 +24,7 @@
 
 #include "dsp/channelsamplesink.h"
 #include "dsp/nco.h"
-#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
 #include "util/movingaverage.h"
 
 #include "adsbdemodsettings.h"
@@ -37,6 +37,7 @@ public:
     ~ADSBDemodSink();
 
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    virtual void setTimestamp(const SampleTimestamp& timestamp);
 
     void getMagSqLevels(double& avg, double& peak, int& nbSamples)
     {
@@ -60,6 +61,7 @@ public:
     void applySettings(const ADSBDemodSettings& settings, bool force = false);
     void setMessageQueueToGUI(MessageQueue *messageQueue) { m_messageQueueToGUI = messageQueue; }
     void setMessageQueueToWorker(MessageQueue *messageQueue) { m_messageQueueToWorker = messageQueue; }
+    void setMessageQueueToDecoder(MessageQueue *messageQueue) { m_messageQueueToDecoder = messageQueue; }
     void startWorker();
     void stopWorker();
 
@@ -81,12 +83,16 @@ private:
     ADSBDemodSettings m_settings;
 
     NCO m_nco;
-    Interpolator m_interpolator;
+    PolyphaseResampler m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
+    std::vector<Complex> m_resamplerIn;
+    std::vector<Complex> m_resamplerOut;
 
     boost::chrono::steady_clock::time_point m_startPoint;
     double m_feedTime;                  //!< Time spent in feed()
+    SampleTimestamp m_timestamp;        //!< Timestamp of first sample of the block being fed
+    qint64 m_samplesSinceTimestamp;     //!< Samples processed since m_timestamp at ADS-B sample rate
 
     // Triple buffering for sharing sample data between two threads
     // Top area of each buffer is not used by writer, as it's used by the reader
@@ -97,7 +103,7 @@ private:
     Real *m_sampleBuffer[3];            //!< Each buffer is m_bufferSize samples
     QSemaphore m_bufferWrite[3];        //!< Sempahore to control write access to the buffers
     QSemaphore m_bufferRead[3];         //!< Sempahore to control read access from the buffers
-    QDateTime m_bufferFirstSampleDateTime[3];  //!< Time for first sample in the buffer
+    qint64 m_bufferFirstSampleNs[3];    //!< Time for first sample in the buffer in ns since epoch
     bool m_bufferDateTimeValid[3];
     ADSBDemodSinkWorker m_worker;       //!< Worker thread that does the actual demodulation
     int m_writeBuffer;                  //!< Which of the 3 buffers we're writing in to
@@ -115,6 +121,7 @@ private:
 
     MessageQueue *m_messageQueueToGUI;
     MessageQueue *m_messageQueueToWorker;
+    MessageQueue *m_messageQueueToDecoder;
 
     void init(int samplesPerBit);
     Real inline complexMagSq(Complex& ci)
@@ -125,6 +132,7 @@ private:
     void processOneSample(Real magsq);
     MessageQueue *getMessageQueueToGUI() { return m_messageQueueToGUI; }
     MessageQueue *getMessageQueueToWorker() { return m_messageQueueToWorker; }
+    MessageQueue *getMessageQueueToDecoder() { return m_messageQueueToDecoder; }
 };
 
 #endif // INCLUDE_ADSBDEMODSINK_H
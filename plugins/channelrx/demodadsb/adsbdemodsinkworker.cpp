@@ -198,25 +198,25 @@ void ADSBDemodSinkWorker::run()
                     // Don't try to re-demodulate the same frame
                     // We could possibly allow a partial overlap here
                     readIdx += (ADS_B_ES_BITS+ADS_B_PREAMBLE_BITS)*ADS_B_CHIPS_PER_BIT*samplesPerChip - 1;
-                    // Pass to GUI
-                    if (m_sink->getMessageQueueToGUI())
+                    // Pass to worker to feed to other servers
+                    if (m_sink->getMessageQueueToWorker())
                     {
                         ADSBDemodReport::MsgReportADSB *msg = ADSBDemodReport::MsgReportADSB::create(
                             QByteArray((char*)data, sizeof(data)),
                             preambleCorrelation * m_correlationScale,
                             preambleCorrelationOnes / samplesPerChip,
-                            rxDateTime(firstIdx, readBuffer));
-                        m_sink->getMessageQueueToGUI()->push(msg);
+                            rxTimeNs(firstIdx, readBuffer));
+                        m_sink->getMessageQueueToWorker()->push(msg);
                     }
-                    // Pass to worker to feed to other servers
-                    if (m_sink->getMessageQueueToWorker())
+                    // Pass to decoder to update aircraft state, that the GUI displays from snapshots
+                    if (m_sink->getMessageQueueToDecoder())
                     {
                         ADSBDemodReport::MsgReportADSB *msg = ADSBDemodReport::MsgReportADSB::create(
                             QByteArray((char*)data, sizeof(data)),
                             preambleCorrelation * m_correlationScale,
                             preambleCorrelationOnes / samplesPerChip,
-                            rxDateTime(firstIdx, readBuffer));
-                        m_sink->getMessageQueueToWorker()->push(msg);
+                            rxTimeNs(firstIdx, readBuffer));
+                        m_sink->getMessageQueueToDecoder()->push(msg);
                     }
                 }
                 else
@@ -250,7 +250,7 @@ void ADSBDemodSinkWorker::run()
                                 QByteArray((char*)data, sizeof(data)),
                                 preambleCorrelation * m_correlationScale,
                                 preambleCorrelationOnes / samplesPerChip,
-                                rxDateTime(firstIdx, readBuffer));
+                                rxTimeNs(firstIdx, readBuffer));
                             m_sink->getMessageQueueToWorker()->push(msg);
                         }
                     }
@@ -349,9 +349,10 @@ void ADSBDemodSinkWorker::handleInputMessages()
     }
 }
 
-QDateTime ADSBDemodSinkWorker::rxDateTime(int firstIdx, int readBuffer) const
+// Receive time in ns since epoch of sample firstIdx of the buffer. The first sample written to a buffer is at m_samplesPerFrame - 1.
+qint64 ADSBDemodSinkWorker::rxTimeNs(int firstIdx, int readBuffer) const
 {
-    const qint64 samplesPerSecondMSec = ADS_B_BITS_PER_SECOND * m_settings.m_samplesPerBit / 1000;
-    const qint64 offsetMSec = (firstIdx - m_sink->m_samplesPerFrame - 1) / samplesPerSecondMSec;
-    return m_sink->m_bufferFirstSampleDateTime[readBuffer].addMSecs(offsetMSec);
+    const qint64 samplesPerSecond = ADS_B_BITS_PER_SECOND * m_settings.m_samplesPerBit;
+    const qint64 offsetNs = ((firstIdx - (m_sink->m_samplesPerFrame - 1)) * 1000000000LL) / samplesPerSecond;
+    return m_sink->m_bufferFirstSampleNs[readBuffer] + offsetNs;
 }
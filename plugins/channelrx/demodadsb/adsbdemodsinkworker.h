@@ -77,7 +77,7 @@ private:
     Real m_correlationScale;
     crcadsb m_crc;                      //!< Have as member to avoid recomputing LUT
 
-    QDateTime rxDateTime(int firstIdx, int readBuffer) const;
+    qint64 rxTimeNs(int firstIdx, int readBuffer) const;
 
 };
 
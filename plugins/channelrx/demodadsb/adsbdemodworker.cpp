@@ -157,7 +157,7 @@ bool ADSBDemodWorker::handleMessage(const Message& message)
     else if (ADSBDemodReport::MsgReportADSB::match(message))
     {
         ADSBDemodReport::MsgReportADSB& report = (ADSBDemodReport::MsgReportADSB&) message;
-        handleADSB(report.getData(), report.getDateTime(), report.getPreambleCorrelation());
+        handleADSB(report.getData(), report.getDateTimeNs(), report.getPreambleCorrelation());
         return true;
     }
     else
@@ -213,24 +213,13 @@ void ADSBDemodWorker::applySettings(const ADSBDemodSettings& settings, bool forc
         || (settings.m_logFilename != m_settings.m_logFilename)
         || force)
     {
-        if (m_logFile.isOpen())
-        {
-            m_logStream.flush();
-            m_logFile.close();
-        }
+        m_logWriter.close();
+
         if (settings.m_logEnabled && !settings.m_logFilename.isEmpty())
         {
-            m_logFile.setFileName(settings.m_logFilename);
-            if (m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+            if (m_logWriter.open(settings.m_logFilename, QStringList{"Date", "Time", "Data", "Correlation"}))
             {
                 qDebug() << "ADSBDemodWorker::applySettings - Logging to: " << settings.m_logFilename;
-                bool newFile = m_logFile.size() == 0;
-                m_logStream.setDevice(&m_logFile);
-                if (newFile)
-                {
-                    // Write header
-                    m_logStream << "Date,Time,Data,Correlation\n";
-                }
             }
             else
             {
@@ -291,10 +280,10 @@ char *ADSBDemodWorker::escape(char *p, char c)
 // Forward ADS-B data in Beast binary format to specified server
 // See: https://wiki.jetvision.de/wiki/Mode-S_Beast:Data_Output_Formats
 // Log to .csv file
-void ADSBDemodWorker::handleADSB(QByteArray data, const QDateTime dateTime, float correlation)
+void ADSBDemodWorker::handleADSB(QByteArray data, qint64 dateTimeNs, float correlation)
 {
-    if (m_logFile.isOpen()) {
-        m_logStream << dateTime.date().toString() << "," << dateTime.time().toString() << "," << data.toHex() << "," << correlation << "\n";
+    if (m_logWriter.isOpen()) {
+        m_logWriter.write(QDateTime::fromMSecsSinceEpoch(dateTimeNs / 1000000), {QString(data.toHex()), QString::number(correlation)});
     }
 
     if (m_settings.m_feedEnabled && (m_settings.m_exportClientEnabled || m_settings.m_exportServerEnabled))
@@ -309,7 +298,7 @@ void ADSBDemodWorker::handleADSB(QByteArray data, const QDateTime dateTime, floa
             unsigned char signalStrength;
 
             // Timestamp seems to be 12MHz ticks since device started
-            timestamp = (dateTime.toMSecsSinceEpoch() - m_startTime) * 12000;
+            timestamp = ((dateTimeNs - m_startTime * 1000000LL) * 12) / 1000;
 
             if (correlation > 255) {
                signalStrength = 255;
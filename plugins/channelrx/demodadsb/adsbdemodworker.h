@@ -23,11 +23,10 @@
 #include <QTimer>
 #include <QTcpServer>
 #include <QTcpSocket>
-#include <QFile>
-#include <QTextStream>
 
 #include "util/message.h"
 #include "util/messagequeue.h"
+#include "util/logwriter.h"
 
 #include "adsbdemodsettings.h"
 
@@ -95,8 +94,7 @@ private:
     QMutex m_mutex;
     QTimer m_heartbeatTimer;
     QTcpSocket m_socket;
-    QFile m_logFile;
-    QTextStream m_logStream;
+    LogWriter m_logWriter;
     qint64 m_startTime;
     ADSBBeastServer m_beastServer;
 
@@ -104,7 +102,7 @@ private:
     void applySettings(const ADSBDemodSettings& settings, bool force = false);
     void send(const char *data, int length);
     char *escape(char *p, char c);
-    void handleADSB(QByteArray data, const QDateTime dateTime, float correlation);
+    void handleADSB(QByteArray data, qint64 dateTimeNs, float correlation);
 
 private slots:
     void handleInputMessages();
@@ -118,7 +118,7 @@ uint32_t AISDemod::getNumberOfDeviceStreams() const
 void AISDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
 {
     (void) firstOfBurst;
-    m_basebandSink->feed(begin, end);
+    m_basebandSink->feed(begin, end, m_timestamp);
 }
 
 void AISDemod::start()
@@ -172,8 +172,14 @@ bool AISDemod::handleMessage(const Message& cmd)
     }
     else if (MsgMessage::match(cmd))
     {
-        // Forward to GUI
         MsgMessage& report = (MsgMessage&)cmd;
+
+        // Drop messages already received on another sub-channel
+        if (isDuplicate(report)) {
+            return true;
+        }
+
+        // Forward to GUI
         if (getMessageQueueToGUI())
         {
             MsgMessage *msg = new MsgMessage(report);
@@ -209,20 +215,20 @@ bool AISDemod::handleMessage(const Message& cmd)
         }
 
         // Write to log file
-        if (m_logFile.isOpen())
+        if (m_logWriter.isOpen())
         {
             AISMessage *ais;
 
             // Decode the message
             ais = AISMessage::decode(report.getMessage());
 
-            m_logStream << report.getDateTime().date().toString() << ","
-                << report.getDateTime().time().toString() << ","
-                << report.getMessage().toHex() << ","
-                << QString("%1").arg(ais->m_mmsi, 9, 10, QChar('0')) << ","
-                << ais->getType() << ","
-                << "\"" << ais->toString() << "\"" << ","
-                << "\"" << ais->toNMEA() << "\"" << "\n";
+            m_logWriter.write(report.getDateTime(), {
+                QString(report.getMessage().toHex()),
+                QString("%1").arg(ais->m_mmsi, 9, 10, QChar('0')),
+                ais->getType(),
+                ais->toString(),
+                ais->toNMEA()
+            });
 
             delete ais;
         }
@@ -242,6 +248,54 @@ bool AISDemod::handleMessage(const Message& cmd)
     }
 }
 
+bool AISDemod::isDuplicate(const MsgMessage& message)
+{
+    if (m_settings.getNbSubChannels() <= 1) {
+        return false;
+    }
+
+    qint64 msecs = message.getDateTime().toMSecsSinceEpoch();
+
+    // Expire messages out of the window from the oldest. An entry of the queue is stale if the same
+    // payload was received again later in which case the message is kept.
+    while (!m_recentMessagesExpiry.isEmpty() && (msecs - m_recentMessagesExpiry.head().first > m_dedupWindowMs))
+    {
+        QPair<qint64, QByteArray> expired = m_recentMessagesExpiry.dequeue();
+        auto it = m_recentMessages.find(expired.second);
+
+        if ((it != m_recentMessages.end()) && (it->m_msecs == expired.first)) {
+            m_recentMessages.erase(it);
+        }
+    }
+
+    auto it = m_recentMessages.find(message.getMessage());
+
+    if ((it != m_recentMessages.end()) && (it->m_subChannel != message.getSubChannel()))
+    {
+        int subChannel = message.getSubChannel();
+
+        while (m_duplicateCounts.size() <= subChannel) {
+            m_duplicateCounts.append(0);
+        }
+
+        m_duplicateCounts[subChannel]++;
+        return true;
+    }
+
+    m_recentMessages.insert(message.getMessage(), RecentMessage{message.getSubChannel(), msecs});
+    m_recentMessagesExpiry.enqueue(qMakePair(msecs, message.getMessage()));
+    return false;
+}
+
+void AISDemod::getSubChannelStats(QList<AISDemodBaseband::SubChannelStats>& stats)
+{
+    m_basebandSink->getSubChannelStats(stats);
+
+    for (int i = 0; (i < stats.size()) && (i < m_duplicateCounts.size()); i++) {
+        stats[i].m_duplicates = m_duplicateCounts[i];
+    }
+}
+
 ScopeVis *AISDemod::getScopeSink()
 {
     return m_basebandSink->getScopeSink();
@@ -321,6 +375,14 @@ void AISDemod::applySettings(const AISDemodSettings& settings, bool force)
         reverseAPIKeys.append("streamIndex");
     }
 
+    if ((settings.m_subChannelOffsets != m_settings.m_subChannelOffsets) || force)
+    {
+        m_recentMessages.clear();
+        m_recentMessagesExpiry.clear();
+        m_duplicateCounts.clear();
+        reverseAPIKeys.append("subChannels");
+    }
+
     AISDemodBaseband::MsgConfigureAISDemodBaseband *msg = AISDemodBaseband::MsgConfigureAISDemodBaseband::create(settings, force);
     m_basebandSink->getInputMessageQueue()->push(msg);
 
@@ -338,24 +400,13 @@ void AISDemod::applySettings(const AISDemodSettings& settings, bool force)
         || (settings.m_logFilename != m_settings.m_logFilename)
         || force)
     {
-        if (m_logFile.isOpen())
-        {
-            m_logStream.flush();
-            m_logFile.close();
-        }
+        m_logWriter.close();
+
         if (settings.m_logEnabled && !settings.m_logFilename.isEmpty())
         {
-            m_logFile.setFileName(settings.m_logFilename);
-            if (m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+            if (m_logWriter.open(settings.m_logFilename, QStringList{"Date", "Time", "Data", "MMSI", "Type", "Message", "NMEA"}))
             {
                 qDebug() << "AISDemod::applySettings - Logging to: " << settings.m_logFilename;
-                bool newFile = m_logFile.size() == 0;
-                m_logStream.setDevice(&m_logFile);
-                if (newFile)
-                {
-                    // Write header
-                    m_logStream << "Date,Time,Data,MMSI,Type,Message,NMEA\n";
-                }
             }
             else
             {
@@ -453,6 +504,17 @@ int AISDemod::webapiSettingsPutPatch(
     return 200;
 }
 
+int AISDemod::webapiReportGet(
+        SWGSDRangel::SWGChannelReport& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setAisDemodReport(new SWGSDRangel::SWGAISDemodReport());
+    response.getAisDemodReport()->init();
+    webapiFormatChannelReport(response);
+    return 200;
+}
+
 void AISDemod::webapiUpdateChannelSettings(
         AISDemodSettings& settings,
         const QStringList& channelSettingsKeys,
@@ -473,6 +535,17 @@ void AISDemod::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("correlationThreshold")) {
         settings.m_correlationThreshold = response.getAisDemodSettings()->getCorrelationThreshold();
     }
+    if (channelSettingsKeys.contains("subChannels"))
+    {
+        settings.m_subChannelOffsets.clear();
+
+        for (auto subChannel : *response.getAisDemodSettings()->getSubChannels())
+        {
+            if (settings.m_subChannelOffsets.size() < AISDemodSettings::AISDEMOD_MAX_SUBCHANNELS) {
+                settings.m_subChannelOffsets.append(subChannel->getOffset());
+            }
+        }
+    }
     if (channelSettingsKeys.contains("udpEnabled")) {
         settings.m_udpEnabled = response.getAisDemodSettings()->getUdpEnabled();
     }
@@ -533,6 +606,19 @@ void AISDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& resp
     response.getAisDemodSettings()->setRfBandwidth(settings.m_rfBandwidth);
     response.getAisDemodSettings()->setFmDeviation(settings.m_fmDeviation);
     response.getAisDemodSettings()->setCorrelationThreshold(settings.m_correlationThreshold);
+
+    if (response.getAisDemodSettings()->getSubChannels())
+    {
+        qDeleteAll(*response.getAisDemodSettings()->getSubChannels());
+        response.getAisDemodSettings()->getSubChannels()->clear();
+    }
+    else
+    {
+        response.getAisDemodSettings()->setSubChannels(new QList<SWGSDRangel::SWGAISDemodSubChannel *>());
+    }
+
+    webapiFormatSubChannels(response.getAisDemodSettings()->getSubChannels(), settings);
+
     response.getAisDemodSettings()->setUdpEnabled(settings.m_udpEnabled);
     response.getAisDemodSettings()->setUdpAddress(new QString(settings.m_udpAddress));
     response.getAisDemodSettings()->setUdpPort(settings.m_udpPort);
@@ -603,6 +689,42 @@ void AISDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& resp
     }
 }
 
+void AISDemod::webapiFormatSubChannels(QList<SWGSDRangel::SWGAISDemodSubChannel *> *swgSubChannels, const AISDemodSettings& settings)
+{
+    for (auto offset : settings.m_subChannelOffsets)
+    {
+        SWGSDRangel::SWGAISDemodSubChannel *swgSubChannel = new SWGSDRangel::SWGAISDemodSubChannel();
+        swgSubChannel->setOffset(offset);
+        swgSubChannels->append(swgSubChannel);
+    }
+}
+
+void AISDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response)
+{
+    double magsqAvg, magsqPeak;
+    int nbMagsqSamples;
+    getMagSqLevels(magsqAvg, magsqPeak, nbMagsqSamples);
+
+    response.getAisDemodReport()->setChannelPowerDb(CalcDb::dbPower(magsqAvg));
+    response.getAisDemodReport()->setChannelSampleRate(m_basebandSink->getChannelSampleRate());
+
+    QList<AISDemodBaseband::SubChannelStats> stats;
+    getSubChannelStats(stats);
+    QList<SWGSDRangel::SWGAISDemodSubChannelReport *> *swgSubChannels = response.getAisDemodReport()->getSubChannels();
+
+    for (const auto& subChannelStats : stats)
+    {
+        SWGSDRangel::SWGAISDemodSubChannelReport *swgSubChannel = new SWGSDRangel::SWGAISDemodSubChannelReport();
+        swgSubChannel->setOffset(subChannelStats.m_offset);
+        swgSubChannel->setOutOfBand(subChannelStats.m_outOfBand ? 1 : 0);
+        swgSubChannel->setPreambles(subChannelStats.m_preambles);
+        swgSubChannel->setCrcErrors(subChannelStats.m_crcErrors);
+        swgSubChannel->setMessages(subChannelStats.m_messages);
+        swgSubChannel->setDuplicates(subChannelStats.m_duplicates);
+        swgSubChannels->append(swgSubChannel);
+    }
+}
+
 void AISDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const AISDemodSettings& settings, bool force)
 {
     SWGSDRangel::SWGChannelSettings *swgChannelSettings = new SWGSDRangel::SWGChannelSettings();
@@ -659,6 +781,11 @@ void AISDemod::webapiFormatChannelSettings(
     if (channelSettingsKeys.contains("correlationThreshold") || force) {
         swgAISDemodSettings->setCorrelationThreshold(settings.m_correlationThreshold);
     }
+    if (channelSettingsKeys.contains("subChannels") || force)
+    {
+        swgAISDemodSettings->setSubChannels(new QList<SWGSDRangel::SWGAISDemodSubChannel *>());
+        webapiFormatSubChannels(swgAISDemodSettings->getSubChannels(), settings);
+    }
     if (channelSettingsKeys.contains("udpEnabled") || force) {
         swgAISDemodSettings->setUdpEnabled(settings.m_udpEnabled);
     }
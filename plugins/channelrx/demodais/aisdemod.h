@@ -25,12 +25,14 @@
 #include <QUdpSocket>
 #include <QThread>
 #include <QDateTime>
-#include <QFile>
-#include <QTextStream>
+#include <QHash>
+#include <QQueue>
+#include <QPair>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
 #include "util/message.h"
+#include "util/logwriter.h"
 
 #include "aisdemodbaseband.h"
 #include "aisdemodsettings.h"
@@ -41,6 +43,10 @@ class QThread;
 class DeviceAPI;
 class ScopeVis;
 
+namespace SWGSDRangel {
+    class SWGAISDemodSubChannel;
+}
+
 class AISDemod : public BasebandSampleSink, public ChannelAPI {
 public:
     class MsgConfigureAISDemod : public Message {
@@ -72,20 +78,28 @@ public:
     public:
         QByteArray getMessage() const { return m_message; }
         QDateTime getDateTime() const { return m_dateTime; }
+        int getSubChannel() const { return m_subChannel; }
 
-        static MsgMessage* create(QByteArray message)
+        static MsgMessage* create(QByteArray message, int subChannel = 0)
         {
-            return new MsgMessage(message, QDateTime::currentDateTime());
+            return new MsgMessage(message, QDateTime::currentDateTime(), subChannel);
+        }
+
+        static MsgMessage* create(QByteArray message, QDateTime dateTime, int subChannel)
+        {
+            return new MsgMessage(message, dateTime, subChannel);
         }
 
     private:
         QByteArray m_message;
         QDateTime m_dateTime;
+        int m_subChannel;
 
-        MsgMessage(QByteArray message, QDateTime dateTime) :
+        MsgMessage(QByteArray message, QDateTime dateTime, int subChannel) :
             Message(),
             m_message(message),
-            m_dateTime(dateTime)
+            m_dateTime(dateTime),
+            m_subChannel(subChannel)
         {
         }
     };
@@ -98,6 +112,7 @@ public:
 
     using BasebandSampleSink::feed;
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool po);
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { m_timestamp = timestamp; }
     virtual void start();
     virtual void stop();
     virtual void pushMessage(Message *msg) { m_inputMessageQueue.push(msg); }
@@ -137,6 +152,10 @@ public:
             SWGSDRangel::SWGChannelSettings& response,
             QString& errorMessage);
 
+    virtual int webapiReportGet(
+            SWGSDRangel::SWGChannelReport& response,
+            QString& errorMessage);
+
     static void webapiFormatChannelSettings(
             SWGSDRangel::SWGChannelSettings& response,
             const AISDemodSettings& settings);
@@ -152,6 +171,8 @@ public:
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) {
         m_basebandSink->getMagSqLevels(avg, peak, nbSamples);
     }
+
+    void getSubChannelStats(QList<AISDemodBaseband::SubChannelStats>& stats);
 /*    void setMessageQueueToGUI(MessageQueue* queue) override {
         ChannelAPI::setMessageQueueToGUI(queue);
         m_basebandSink->setMessageQueueToGUI(queue);
@@ -166,19 +187,32 @@ private:
     DeviceAPI *m_deviceAPI;
     QThread m_thread;
     AISDemodBaseband* m_basebandSink;
+    SampleTimestamp m_timestamp; //!< Timestamp of next block fed
     AISDemodSettings m_settings;
     int m_basebandSampleRate; //!< stored from device message used when starting baseband sink
     qint64 m_centerFrequency;
     QUdpSocket m_udpSocket;
-    QFile m_logFile;
-    QTextStream m_logStream;
+    LogWriter m_logWriter;
 
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
 
+    struct RecentMessage
+    {
+        int m_subChannel;
+        qint64 m_msecs;
+    };
+    QHash<QByteArray, RecentMessage> m_recentMessages; //!< Messages received within de-duplication window
+    QQueue<QPair<qint64, QByteArray>> m_recentMessagesExpiry; //!< Time and payload of recent messages in order of reception
+    QList<int> m_duplicateCounts;                      //!< Number of duplicates per sub-channel
+    static const qint64 m_dedupWindowMs = 10000;       //!< Time window to consider same message on another sub-channel a duplicate
+
     virtual bool handleMessage(const Message& cmd);
+    bool isDuplicate(const MsgMessage& message);
     void applySettings(const AISDemodSettings& settings, bool force = false);
     void sendSampleRateToDemodAnalyzer();
+    void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
+    static void webapiFormatSubChannels(QList<SWGSDRangel::SWGAISDemodSubChannel *> *swgSubChannels, const AISDemodSettings& settings);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const AISDemodSettings& settings, bool force);
     void webapiFormatChannelSettings(
         QList<QString>& channelSettingsKeys,
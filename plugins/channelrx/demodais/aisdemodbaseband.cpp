@@ -18,6 +18,9 @@
 
 #include <QDebug>
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
 #include "dsp/downchannelizer.h"
@@ -27,15 +30,19 @@
 MESSAGE_CLASS_DEFINITION(AISDemodBaseband::MsgConfigureAISDemodBaseband, Message)
 
 AISDemodBaseband::AISDemodBaseband(AISDemod *aisDemod) :
-    m_sink(aisDemod),
+    m_subChannelsSink(m_sinks),
+    m_aisDemod(aisDemod),
+    m_channel(nullptr),
+    m_messageQueueToChannel(nullptr),
     m_running(false),
     m_mutex(QMutex::Recursive)
 {
     qDebug("AISDemodBaseband::AISDemodBaseband");
 
-    m_sink.setScopeSink(&m_scopeSink);
+    m_sinks.append(new AISDemodSink(aisDemod, 0));
+    m_sinks[0]->setScopeSink(&m_scopeSink);
     m_sampleFifo.setSize(SampleSinkFifo::getSizePolicy(48000));
-    m_channelizer = new DownChannelizer(&m_sink);
+    m_channelizer = new DownChannelizer(&m_subChannelsSink);
 }
 
 AISDemodBaseband::~AISDemodBaseband()
@@ -43,6 +50,7 @@ AISDemodBaseband::~AISDemodBaseband()
     m_inputMessageQueue.clear();
 
     delete m_channelizer;
+    qDeleteAll(m_sinks);
 }
 
 void AISDemodBaseband::reset()
@@ -81,12 +89,45 @@ void AISDemodBaseband::stopWork()
 
 void AISDemodBaseband::setChannel(ChannelAPI *channel)
 {
-    m_sink.setChannel(channel);
+    m_channel = channel;
+    m_sinks[0]->setChannel(channel); // only first sub-channel feeds the demod analyzer
+}
+
+void AISDemodBaseband::setMessageQueueToChannel(MessageQueue *messageQueue)
+{
+    m_messageQueueToChannel = messageQueue;
+
+    for (auto sink : m_sinks) {
+        sink->setMessageQueueToChannel(messageQueue);
+    }
+}
+
+void AISDemodBaseband::getMagSqLevels(double& avg, double& peak, int& nbSamples)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    // Report strongest sub-channel
+    m_sinks[0]->getMagSqLevels(avg, peak, nbSamples);
+
+    for (int i = 1; i < m_sinks.size(); i++)
+    {
+        double avg1, peak1;
+        int nbSamples1;
+        m_sinks[i]->getMagSqLevels(avg1, peak1, nbSamples1);
+
+        if (avg1 > avg)
+        {
+            avg = avg1;
+            nbSamples = nbSamples1;
+        }
+
+        peak = std::max(peak, peak1);
+    }
 }
 
-void AISDemodBaseband::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+void AISDemodBaseband::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, const SampleTimestamp& timestamp)
 {
-    m_sampleFifo.write(begin, end);
+    m_sampleFifo.write(begin, end, timestamp);
 }
 
 void AISDemodBaseband::handleData()
@@ -100,15 +141,21 @@ void AISDemodBaseband::handleData()
         SampleVector::iterator part2begin;
         SampleVector::iterator part2end;
 
-        std::size_t count = m_sampleFifo.readBegin(m_sampleFifo.fill(), &part1begin, &part1end, &part2begin, &part2end);
+        unsigned int fill = m_sampleFifo.fill();
+        SampleTimestamp timestamp = m_sampleFifo.getReadTimestamp(fill); // read up to next discontinuity
+        std::size_t count = m_sampleFifo.readBegin(fill, &part1begin, &part1end, &part2begin, &part2end);
 
         // first part of FIFO data
-        if (part1begin != part1end) {
+        if (part1begin != part1end)
+        {
+            m_channelizer->setTimestamp(timestamp);
             m_channelizer->feed(part1begin, part1end);
         }
 
         // second part of FIFO data (used when block wraps around)
-        if(part2begin != part2end) {
+        if(part2begin != part2end)
+        {
+            m_channelizer->setTimestamp(timestamp.isValid() ? timestamp.advanced(part1end - part1begin) : timestamp);
             m_channelizer->feed(part2begin, part2end);
         }
 
@@ -116,6 +163,24 @@ void AISDemodBaseband::handleData()
     }
 }
 
+void AISDemodBaseband::getSubChannelStats(QList<SubChannelStats>& stats)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    stats.clear();
+
+    for (auto sink : m_sinks)
+    {
+        stats.append(SubChannelStats{
+            sink->getSubChannelOffset(),
+            sink->getOutOfBand(),
+            sink->getPreambleCount(),
+            sink->getCRCErrorCount(),
+            sink->getMessageCount(),
+            0 // duplicates are detected by the channel
+        });
+    }
+}
+
 void AISDemodBaseband::handleInputMessages()
 {
     Message* message;
@@ -158,19 +223,75 @@ bool AISDemodBaseband::handleMessage(const Message& cmd)
 
 void AISDemodBaseband::applySettings(const AISDemodSettings& settings, bool force)
 {
-    if ((settings.m_inputFrequencyOffset != m_settings.m_inputFrequencyOffset) || force)
+    bool subChannelsChanged = (settings.m_subChannelOffsets != m_settings.m_subChannelOffsets) || force;
+
+    if (subChannelsChanged) {
+        applySubChannels(settings);
+    }
+
+    if ((settings.m_inputFrequencyOffset != m_settings.m_inputFrequencyOffset)
+        || (settings.m_rfBandwidth != m_settings.m_rfBandwidth)
+        || subChannelsChanged)
     {
-        m_channelizer->setChannelization(AISDemodSettings::AISDEMOD_CHANNEL_SAMPLE_RATE, settings.m_inputFrequencyOffset);
-        m_sink.applyChannelSettings(m_channelizer->getChannelSampleRate(), m_channelizer->getChannelFrequencyOffset());
+        m_channelizer->setChannelization(settings.getMultiChannelSampleRate(), settings.m_inputFrequencyOffset);
+        applyChannelSettings(settings);
     }
 
-    m_sink.applySettings(settings, force);
+    for (auto sink : m_sinks) {
+        sink->applySettings(settings, force);
+    }
 
     m_settings = settings;
 }
 
+void AISDemodBaseband::applySubChannels(const AISDemodSettings& settings)
+{
+    int nbSubChannels = settings.getNbSubChannels();
+
+    while (m_sinks.size() > nbSubChannels) {
+        delete m_sinks.takeLast();
+    }
+
+    while (m_sinks.size() < nbSubChannels)
+    {
+        AISDemodSink *sink = new AISDemodSink(m_aisDemod, m_sinks.size());
+        sink->setMessageQueueToChannel(m_messageQueueToChannel);
+        sink->applySettings(settings, true);
+        m_sinks.append(sink);
+    }
+
+    for (int i = 0; i < nbSubChannels; i++) {
+        m_sinks[i]->setSubChannelOffset(settings.getSubChannelOffset(i));
+    }
+
+    qDebug() << "AISDemodBaseband::applySubChannels: " << nbSubChannels << " sub-channels";
+}
+
+void AISDemodBaseband::applyChannelSettings(const AISDemodSettings& settings)
+{
+    int channelSampleRate = m_channelizer->getChannelSampleRate();
+
+    for (auto sink : m_sinks)
+    {
+        // sub-channel is out of band if the baseband is too narrow to cover it
+        bool outOfBand = std::abs(sink->getSubChannelOffset()) + settings.m_rfBandwidth / 2 > channelSampleRate / 2;
+
+        if (outOfBand != sink->getOutOfBand()) {
+            qDebug() << "AISDemodBaseband::applyChannelSettings: sub-channel " << sink->getSubChannel() << " out of band: " << outOfBand;
+        }
+
+        sink->setOutOfBand(outOfBand);
+        sink->applyChannelSettings(channelSampleRate, m_channelizer->getChannelFrequencyOffset(), true);
+    }
+}
+
+int AISDemodBaseband::getChannelSampleRate() const
+{
+    return m_channelizer->getChannelSampleRate();
+}
+
 void AISDemodBaseband::setBasebandSampleRate(int sampleRate)
 {
     m_channelizer->setBasebandSampleRate(sampleRate);
-    m_sink.applyChannelSettings(m_channelizer->getChannelSampleRate(), m_channelizer->getChannelFrequencyOffset());
+    applyChannelSettings(m_settings);
 }
@@ -23,6 +23,7 @@
 #include <QMutex>
 
 #include "dsp/samplesinkfifo.h"
+#include "dsp/channelsamplesink.h"
 #include "dsp/scopevis.h"
 #include "util/message.h"
 #include "util/messagequeue.h"
@@ -66,23 +67,58 @@ public:
     void reset();
     void startWork();
     void stopWork();
-    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, const SampleTimestamp& timestamp);
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
-    void getMagSqLevels(double& avg, double& peak, int& nbSamples) {
-        m_sink.getMagSqLevels(avg, peak, nbSamples);
-    }
-    void setMessageQueueToChannel(MessageQueue *messageQueue) { m_sink.setMessageQueueToChannel(messageQueue); }
+    void getMagSqLevels(double& avg, double& peak, int& nbSamples);
+    void setMessageQueueToChannel(MessageQueue *messageQueue);
     void setBasebandSampleRate(int sampleRate);
     ScopeVis *getScopeSink() { return &m_scopeSink; }
     void setChannel(ChannelAPI *channel);
-    double getMagSq() const { return m_sink.getMagSq(); }
+    double getMagSq() const { return m_sinks[0]->getMagSq(); }
+    int getChannelSampleRate() const;
+
+    struct SubChannelStats
+    {
+        qint32 m_offset;    //!< Sub-channel offset from channel frequency
+        bool m_outOfBand;   //!< Sub-channel does not fit in baseband
+        int m_preambles;    //!< Number of preamble detections
+        int m_crcErrors;    //!< Number of frames with invalid CRC
+        int m_messages;     //!< Number of frames with valid CRC
+        int m_duplicates;   //!< Number of valid messages already received on another sub-channel
+    };
+
+    void getSubChannelStats(QList<SubChannelStats>& stats);
     bool isRunning() const { return m_running; }
     void setFifoLabel(const QString& label) { m_sampleFifo.setLabel(label); }
 
 private:
+    // Distributes channelized samples to the demodulator of each sub-channel
+    class SubChannelsSink : public ChannelSampleSink {
+    public:
+        SubChannelsSink(QList<AISDemodSink*>& sinks) : m_sinks(sinks) {}
+        virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+        {
+            for (auto sink : m_sinks) {
+                sink->feed(begin, end);
+            }
+        }
+        virtual void setTimestamp(const SampleTimestamp& timestamp)
+        {
+            for (auto sink : m_sinks) {
+                sink->setTimestamp(timestamp);
+            }
+        }
+    private:
+        QList<AISDemodSink*>& m_sinks;
+    };
+
     SampleSinkFifo m_sampleFifo;
     DownChannelizer *m_channelizer;
-    AISDemodSink m_sink;
+    QList<AISDemodSink*> m_sinks;       //!< One demodulator per sub-channel all fed by the same channelizer
+    SubChannelsSink m_subChannelsSink;
+    AISDemod *m_aisDemod;
+    ChannelAPI *m_channel;
+    MessageQueue *m_messageQueueToChannel;
     MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
     AISDemodSettings m_settings;
     ScopeVis m_scopeSink;
@@ -90,8 +126,9 @@ private:
     QMutex m_mutex;
 
     bool handleMessage(const Message& cmd);
-    void calculateOffset(AISDemodSink *sink);
     void applySettings(const AISDemodSettings& settings, bool force = false);
+    void applySubChannels(const AISDemodSettings& settings);
+    void applyChannelSettings(const AISDemodSettings& settings);
 
 private slots:
     void handleInputMessages();
@@ -17,6 +17,7 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <limits>
+#include <cmath>
 #include <ctype.h>
 #include <QDockWidget>
 #include <QMainWindow>
@@ -27,6 +28,8 @@
 #include <QRegExp>
 #include <QClipboard>
 #include <QFileDialog>
+#include <QFile>
+#include <QTextStream>
 #include <QScrollBar>
 
 #include "aisdemodgui.h"
@@ -323,6 +326,36 @@ void AISDemodGUI::on_udpFormat_currentIndexChanged(int value)
     applySettings();
 }
 
+void AISDemodGUI::on_subChannels_editingFinished()
+{
+    QStringList offsets = ui->subChannels->text().split(",");
+    m_settings.m_subChannelOffsets.clear();
+
+    for (const auto& offset : offsets)
+    {
+        bool ok;
+        double kHz = offset.trimmed().toDouble(&ok);
+
+        if (ok && (m_settings.m_subChannelOffsets.size() < AISDEMOD_MAX_SUBCHANNELS)) {
+            m_settings.m_subChannelOffsets.append((qint32) std::round(kHz * 1000.0));
+        }
+    }
+
+    displaySubChannels();
+    applySettings();
+}
+
+void AISDemodGUI::displaySubChannels()
+{
+    QStringList offsets;
+
+    for (auto offset : m_settings.m_subChannelOffsets) {
+        offsets.append(QString::number(offset / 1000.0));
+    }
+
+    ui->subChannels->setText(offsets.join(","));
+}
+
 void AISDemodGUI::on_channel1_currentIndexChanged(int index)
 {
     m_settings.m_scopeCh1 = index;
@@ -621,6 +654,7 @@ void AISDemodGUI::displaySettings()
     ui->udpAddress->setText(m_settings.m_udpAddress);
     ui->udpPort->setText(QString::number(m_settings.m_udpPort));
     ui->udpFormat->setCurrentIndex((int)m_settings.m_udpFormat);
+    displaySubChannels();
 
     ui->channel1->setCurrentIndex(m_settings.m_scopeCh1);
     ui->channel2->setCurrentIndex(m_settings.m_scopeCh2);
@@ -676,6 +710,26 @@ void AISDemodGUI::tick()
         ui->channelPower->setText(QString::number(powDbAvg, 'f', 1));
     }
 
+    if ((m_tickCount % 20 == 0) && (m_settings.getNbSubChannels() > 1))
+    {
+        QList<AISDemodBaseband::SubChannelStats> stats;
+        m_aisDemod->getSubChannelStats(stats);
+        QStringList lines;
+
+        for (const auto& subChannelStats : stats)
+        {
+            lines.append(QString("%1 kHz%2: preambles %3 CRC errors %4 messages %5 duplicates %6")
+                .arg(subChannelStats.m_offset / 1000.0)
+                .arg(subChannelStats.m_outOfBand ? " (out of band)" : "")
+                .arg(subChannelStats.m_preambles)
+                .arg(subChannelStats.m_crcErrors)
+                .arg(subChannelStats.m_messages)
+                .arg(subChannelStats.m_duplicates));
+        }
+
+        ui->subChannels->setToolTip(lines.join("\n"));
+    }
+
     m_tickCount++;
 }
 
@@ -793,6 +847,7 @@ void AISDemodGUI::makeUIConnections()
     QObject::connect(ui->udpAddress, &QLineEdit::editingFinished, this, &AISDemodGUI::on_udpAddress_editingFinished);
     QObject::connect(ui->udpPort, &QLineEdit::editingFinished, this, &AISDemodGUI::on_udpPort_editingFinished);
     QObject::connect(ui->udpFormat, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &AISDemodGUI::on_udpFormat_currentIndexChanged);
+    QObject::connect(ui->subChannels, &QLineEdit::editingFinished, this, &AISDemodGUI::on_subChannels_editingFinished);
     QObject::connect(ui->messages, &QTableWidget::cellDoubleClicked, this, &AISDemodGUI::on_messages_cellDoubleClicked);
     QObject::connect(ui->logEnable, &ButtonSwitch::clicked, this, &AISDemodGUI::on_logEnable_clicked);
     QObject::connect(ui->logFilename, &QToolButton::clicked, this, &AISDemodGUI::on_logFilename_clicked);
@@ -98,6 +98,7 @@ private:
     void blockApplySettings(bool block);
     void applySettings(bool force = false);
     void displaySettings();
+    void displaySubChannels();
     void messageReceived(const QByteArray& message, const QDateTime& dateTime);
     bool handleMessage(const Message& message);
     void makeUIConnections();
@@ -130,6 +131,7 @@ private slots:
     void on_udpAddress_editingFinished();
     void on_udpPort_editingFinished();
     void on_udpFormat_currentIndexChanged(int value);
+    void on_subChannels_editingFinished();
     void on_channel1_currentIndexChanged(int index);
     void on_channel2_currentIndexChanged(int index);
     void on_messages_cellDoubleClicked(int row, int column);
@@ -17,6 +17,9 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QColor>
+#include <QDataStream>
+
+#include <algorithm>
 
 #include "dsp/dspengine.h"
 #include "util/simpleserializer.h"
@@ -45,6 +48,7 @@ void AISDemodSettings::resetToDefaults()
     m_udpFormat = Binary;
     m_scopeCh1 = 5;
     m_scopeCh2 = 6;
+    m_subChannelOffsets.clear();
     m_logFilename = "ais_log.csv";
     m_logEnabled = false;
     m_rgbColor = QColor(102, 0, 0).rgb();
@@ -106,6 +110,11 @@ QByteArray AISDemodSettings::serialize() const
     s.writeBlob(27, m_geometryBytes);
     s.writeBool(28, m_hidden);
 
+    QByteArray subChannelOffsets;
+    QDataStream subChannelStream(&subChannelOffsets, QIODevice::WriteOnly);
+    subChannelStream << m_subChannelOffsets;
+    s.writeBlob(29, subChannelOffsets);
+
     for (int i = 0; i < AISDEMOD_MESSAGE_COLUMNS; i++)
         s.writeS32(100 + i, m_messageColumnIndexes[i]);
     for (int i = 0; i < AISDEMOD_MESSAGE_COLUMNS; i++)
@@ -193,6 +202,15 @@ bool AISDemodSettings::deserialize(const QByteArray& data)
         d.readBlob(27, &m_geometryBytes);
         d.readBool(28, &m_hidden, false);
 
+        d.readBlob(29, &bytetmp);
+        QDataStream subChannelStream(bytetmp);
+        m_subChannelOffsets.clear();
+        subChannelStream >> m_subChannelOffsets;
+
+        while (m_subChannelOffsets.size() > AISDEMOD_MAX_SUBCHANNELS) {
+            m_subChannelOffsets.removeLast();
+        }
+
         for (int i = 0; i < AISDEMOD_MESSAGE_COLUMNS; i++) {
             d.readS32(100 + i, &m_messageColumnIndexes[i], i);
         }
@@ -210,4 +228,16 @@ bool AISDemodSettings::deserialize(const QByteArray& data)
     }
 }
 
+int AISDemodSettings::getMultiChannelSampleRate() const
+{
+    qint32 span = 0;
+
+    for (auto offset : m_subChannelOffsets) {
+        span = std::max(span, std::abs(offset));
+    }
 
+    // room for the RF bandwidth of the outermost sub-channels plus interpolator transition
+    int sampleRate = 2 * (span + (int) m_rfBandwidth);
+
+    return std::max(sampleRate, AISDEMOD_CHANNEL_SAMPLE_RATE);
+}
@@ -21,6 +21,7 @@
 
 #include <QByteArray>
 #include <QString>
+#include <QList>
 
 #include "dsp/dsptypes.h"
 
@@ -46,6 +47,7 @@ struct AISDemodSettings
     } m_udpFormat;
     int m_scopeCh1;
     int m_scopeCh2;
+    QList<qint32> m_subChannelOffsets; //!< Offsets in Hz of sub-channels from the channel frequency. Empty for a single channel at the channel frequency
 
     QString m_logFilename;
     bool m_logEnabled;
@@ -69,6 +71,7 @@ struct AISDemodSettings
     int m_messageColumnSizes[AISDEMOD_MESSAGE_COLUMNS];  //!< Size of the columns in the table
 
     static const int AISDEMOD_CHANNEL_SAMPLE_RATE = 57600; //!< 6x 9600 baud rate (use even multiple so Gausian filter has odd number of taps)
+    static const int AISDEMOD_MAX_SUBCHANNELS = 4;         //!< AIS1, AIS2 and long range channels 75 and 76
 
     AISDemodSettings();
     void resetToDefaults();
@@ -77,6 +80,9 @@ struct AISDemodSettings
     void setScopeGUI(Serializable *scopeGUI) { m_scopeGUI = scopeGUI; }
     QByteArray serialize() const;
     bool deserialize(const QByteArray& data);
+    int getNbSubChannels() const { return m_subChannelOffsets.size() == 0 ? 1 : m_subChannelOffsets.size(); }
+    qint32 getSubChannelOffset(int subChannel) const { return m_subChannelOffsets.size() == 0 ? 0 : m_subChannelOffsets[subChannel]; }
+    int getMultiChannelSampleRate() const; //!< Channel sample rate needed to cover all sub-channels
 };
 
 #endif /* INCLUDE_AISDEMODSETTINGS_H */
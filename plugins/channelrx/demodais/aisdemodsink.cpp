@@ -30,11 +30,19 @@
 #include "aisdemod.h"
 #include "aisdemodsink.h"
 
-AISDemodSink::AISDemodSink(AISDemod *aisDemod) :
+AISDemodSink::AISDemodSink(AISDemod *aisDemod, int subChannel) :
         m_scopeSink(nullptr),
         m_aisDemod(aisDemod),
+        m_channel(nullptr),
         m_channelSampleRate(AISDemodSettings::AISDEMOD_CHANNEL_SAMPLE_RATE),
         m_channelFrequencyOffset(0),
+        m_subChannel(subChannel),
+        m_subChannelOffset(0),
+        m_outOfBand(false),
+        m_preambleCount(0),
+        m_crcErrorCount(0),
+        m_messageCount(0),
+        m_samplesSinceTimestamp(0),
         m_magsqSum(0.0f),
         m_magsqPeak(0.0f),
         m_magsqCount(0),
@@ -79,29 +87,28 @@ void AISDemodSink::sampleToScope(Complex sample)
 
 void AISDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-    Complex ci;
+    if (m_outOfBand) {
+        return;
+    }
+
+    unsigned int nbIn = end - begin;
+    m_resamplerIn.resize(nbIn);
 
-    for (SampleVector::const_iterator it = begin; it != end; ++it)
+    for (unsigned int i = 0; i < nbIn; i++)
     {
-        Complex c(it->real(), it->imag());
-        c *= m_nco.nextIQ();
+        Complex c(begin[i].real(), begin[i].imag());
+        m_resamplerIn[i] = c * m_nco.nextIQ();
+    }
 
-        if (m_interpolatorDistance < 1.0f) // interpolate
-        {
-            while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
-        else // decimate
-        {
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
+    // Interpolates or decimates the whole block
+    m_resamplerOut.clear();
+    m_interpolator.resample(m_interpolatorDistance, &m_interpolatorDistanceRemain, m_resamplerIn.data(), nbIn, m_resamplerOut);
+    m_samplesSinceTimestamp = 0;
+
+    for (auto& ci : m_resamplerOut)
+    {
+        processOneSample(ci);
+        m_samplesSinceTimestamp++;
     }
 }
 
@@ -168,6 +175,8 @@ void AISDemodSink::processOneSample(Complex &ci)
         thresholdMet = fabs(corr) >= m_settings.m_correlationThreshold;
         if (thresholdMet)
         {
+            m_preambleCount++;
+
             // Use mean of preamble as DC offset
             dcOffset = trainingSum/m_correlationLength;
 
@@ -243,11 +252,15 @@ void AISDemodSink::processOneSample(Complex &ci)
                             if (calcCrc == rxCrc)
                             {
                                 scopeCRCValid = true;
+                                m_messageCount++;
                                 QByteArray rxPacket((char *)m_bytes, byteCount - 2); // Don't include CRC
                                 //qDebug() << "RX: " << rxPacket.toHex();
                                 if (getMessageQueueToChannel())
                                 {
-                                    AISDemod::MsgMessage *msg = AISDemod::MsgMessage::create(rxPacket);
+                                    QDateTime dateTime = m_timestamp.isValid()
+                                        ? m_timestamp.getDateTime(m_samplesSinceTimestamp, AISDemodSettings::AISDEMOD_CHANNEL_SAMPLE_RATE)
+                                        : QDateTime::currentDateTime();
+                                    AISDemod::MsgMessage *msg = AISDemod::MsgMessage::create(rxPacket, dateTime, m_subChannel);
                                     getMessageQueueToChannel()->push(msg);
                                 }
 
@@ -258,6 +271,7 @@ void AISDemodSink::processOneSample(Complex &ci)
                             {
                                 //qDebug() << QString("CRC mismatch: %1 %2").arg(calcCrc, 4, 16, QLatin1Char('0')).arg(rxCrc, 4, 16, QLatin1Char('0'));
                                 scopeCRCInvalid = true;
+                                m_crcErrorCount++;
                             }
                             break;
                         }
@@ -383,7 +397,10 @@ void AISDemodSink::processOneSample(Complex &ci)
     if (m_demodBufferFill >= m_demodBuffer.size())
     {
         QList<ObjectPipe*> dataPipes;
-        MainCore::instance()->getDataPipes().getDataPipes(m_channel, "demod", dataPipes);
+
+        if (m_channel) { // only first sub-channel feeds the demod analyzer
+            MainCore::instance()->getDataPipes().getDataPipes(m_channel, "demod", dataPipes);
+        }
 
         if (dataPipes.size() > 0)
         {
@@ -406,13 +423,15 @@ void AISDemodSink::processOneSample(Complex &ci)
 void AISDemodSink::applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force)
 {
     qDebug() << "AISDemodSink::applyChannelSettings:"
+            << " subChannel: " << m_subChannel
+            << " subChannelOffset: " << m_subChannelOffset
             << " channelSampleRate: " << channelSampleRate
             << " channelFrequencyOffset: " << channelFrequencyOffset;
 
     if ((m_channelFrequencyOffset != channelFrequencyOffset) ||
         (m_channelSampleRate != channelSampleRate) || force)
     {
-        m_nco.setFreq(-channelFrequencyOffset, channelSampleRate);
+        m_nco.setFreq(-(channelFrequencyOffset + m_subChannelOffset), channelSampleRate);
     }
 
     if ((m_channelSampleRate != channelSampleRate) || force)
@@ -24,7 +24,7 @@
 #include "dsp/channelsamplesink.h"
 #include "dsp/phasediscri.h"
 #include "dsp/nco.h"
-#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
 #include "dsp/firfilter.h"
 #include "dsp/gaussian.h"
 #include "util/movingaverage.h"
@@ -46,10 +46,11 @@ class ScopeVis;
 
 class AISDemodSink : public ChannelSampleSink {
 public:
-    AISDemodSink(AISDemod *aisDemod);
+    AISDemodSink(AISDemod *aisDemod, int subChannel = 0);
     ~AISDemodSink();
 
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { m_timestamp = timestamp; }
 
     void setScopeSink(ScopeVis* scopeSink) { m_scopeSink = scopeSink; }
     void applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force = false);
@@ -58,6 +59,14 @@ public:
     void setChannel(ChannelAPI *channel) { m_channel = channel; }
 
     double getMagSq() const { return m_magsq; }
+    int getSubChannel() const { return m_subChannel; }
+    void setSubChannelOffset(qint32 offset) { m_subChannelOffset = offset; }
+    qint32 getSubChannelOffset() const { return m_subChannelOffset; }
+    void setOutOfBand(bool outOfBand) { m_outOfBand = outOfBand; }
+    bool getOutOfBand() const { return m_outOfBand; }
+    int getPreambleCount() const { return m_preambleCount; }
+    int getCRCErrorCount() const { return m_crcErrorCount; }
+    int getMessageCount() const { return m_messageCount; }
 
     void getMagSqLevels(double& avg, double& peak, int& nbSamples)
     {
@@ -95,12 +104,22 @@ private:
     ChannelAPI *m_channel;
     int m_channelSampleRate;
     int m_channelFrequencyOffset;
+    int m_subChannel;                   // Index of sub-channel in multi-channel mode (0 for single channel)
+    qint32 m_subChannelOffset;          // Sub-channel frequency offset from channel frequency
+    bool m_outOfBand;                   // Sub-channel does not fit in channel bandwidth
+    int m_preambleCount;                // Number of correlation threshold crossings
+    int m_crcErrorCount;                // Number of frames with invalid CRC
+    int m_messageCount;                 // Number of frames with valid CRC
     int m_samplesPerSymbol;             // Number of samples per symbol
 
     NCO m_nco;
-    Interpolator m_interpolator;
+    PolyphaseResampler m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
+    std::vector<Complex> m_resamplerIn;
+    std::vector<Complex> m_resamplerOut;
+    SampleTimestamp m_timestamp;        // Timestamp of first sample of the block being fed
+    qint64 m_samplesSinceTimestamp;     // Samples processed since m_timestamp at channel sample rate
 
     double m_magsq;
     double m_magsqSum;
@@ -57,6 +57,7 @@ ChirpChatDemod::ChirpChatDemod(DeviceAPI* deviceAPI) :
         m_lastMsgSignalDb(0.0),
         m_lastMsgNoiseDb(0.0),
         m_lastMsgSyncWord(0),
+        m_lastMsgSpreadFactor(0),
         m_lastMsgPacketLength(0),
         m_lastMsgNbParityBits(0),
         m_lastMsgHasCRC(false),
@@ -162,6 +163,13 @@ bool ChirpChatDemod::handleMessage(const Message& cmd)
         m_lastMsgSignalDb = msg.getSingalDb();
         m_lastMsgNoiseDb = msg.getNoiseDb();
         m_lastMsgSyncWord = msg.getSyncWord();
+        m_lastMsgSpreadFactor = msg.getSpreadFactor();
+
+        // In multi SF mode frames come from several spread factors so the decoder is
+        // configured from the parameters the symbols were demodulated with
+        if (msg.getSpreadFactor() != 0) {
+            m_decoder.setNbSymbolBits(msg.getSpreadFactor(), msg.getDEBits());
+        }
 
         if (m_settings.m_codingScheme == ChirpChatDemodSettings::CodingLoRa)
         {
@@ -194,6 +202,7 @@ bool ChirpChatDemod::handleMessage(const Message& cmd)
             {
                 MsgReportDecodeBytes *msgToGUI = MsgReportDecodeBytes::create(m_lastMsgBytes);
                 msgToGUI->setSyncWord(m_lastMsgSyncWord);
+                msgToGUI->setSpreadFactor(m_lastMsgSpreadFactor);
                 msgToGUI->setSignalDb(m_lastMsgSignalDb);
                 msgToGUI->setNoiseDb(m_lastMsgNoiseDb);
                 msgToGUI->setPacketSize(m_lastMsgPacketLength);
@@ -251,7 +260,7 @@ bool ChirpChatDemod::handleMessage(const Message& cmd)
                 }
             }
 
-            if (m_settings.m_autoNbSymbolsMax)
+            if (m_settings.m_autoNbSymbolsMax && (m_lastMsgSpreadFactor == (unsigned int) m_settings.m_spreadFactor))
             {
                 ChirpChatDemodSettings settings = m_settings;
                 settings.m_nbSymbolsMax = m_lastMsgNbSymbols;
@@ -281,6 +290,7 @@ bool ChirpChatDemod::handleMessage(const Message& cmd)
             {
                 MsgReportDecodeString *msgToGUI = MsgReportDecodeString::create(m_lastMsgString);
                 msgToGUI->setSyncWord(m_lastMsgSyncWord);
+                msgToGUI->setSpreadFactor(m_lastMsgSpreadFactor);
                 msgToGUI->setSignalDb(m_lastMsgSignalDb);
                 msgToGUI->setNoiseDb(m_lastMsgNoiseDb);
                 getMessageQueueToGUI()->push(msgToGUI);
@@ -358,6 +368,7 @@ void ChirpChatDemod::applySettings(const ChirpChatDemodSettings& settings, bool
             << " m_nbParityBits: " << settings.m_nbParityBits
             << " m_packetLength: " << settings.m_packetLength
             << " m_autoNbSymbolsMax: " << settings.m_autoNbSymbolsMax
+            << " m_multiSF: " << settings.m_multiSF
             << " m_sendViaUDP: " << settings.m_sendViaUDP
             << " m_udpAddress: " << settings.m_udpAddress
             << " m_udpPort: " << settings.m_udpPort
@@ -449,6 +460,9 @@ void ChirpChatDemod::applySettings(const ChirpChatDemodSettings& settings, bool
     if ((settings.m_autoNbSymbolsMax != m_settings.m_autoNbSymbolsMax) || force) {
         reverseAPIKeys.append("autoNbSymbolsMax");
     }
+    if ((settings.m_multiSF != m_settings.m_multiSF) || force) {
+        reverseAPIKeys.append("multiSF");
+    }
 
     if ((settings.m_udpAddress != m_settings.m_udpAddress) || force)
     {
@@ -579,6 +593,9 @@ void ChirpChatDemod::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("autoNbSymbolsMax")) {
         settings.m_autoNbSymbolsMax = response.getChirpChatDemodSettings()->getAutoNbSymbolsMax() != 0;
     }
+    if (channelSettingsKeys.contains("multiSF")) {
+        settings.m_multiSF = response.getChirpChatDemodSettings()->getMultiSf() != 0;
+    }
     if (channelSettingsKeys.contains("preambleChirps")) {
         settings.m_preambleChirps = response.getChirpChatDemodSettings()->getPreambleChirps();
     }
@@ -663,6 +680,7 @@ void ChirpChatDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings
     response.getChirpChatDemodSettings()->setEomSquelchTenths(settings.m_eomSquelchTenths);
     response.getChirpChatDemodSettings()->setNbSymbolsMax(settings.m_nbSymbolsMax);
     response.getChirpChatDemodSettings()->setAutoNbSymbolsMax(settings.m_autoNbSymbolsMax ? 1 : 0);
+    response.getChirpChatDemodSettings()->setMultiSf(settings.m_multiSF ? 1 : 0);
     response.getChirpChatDemodSettings()->setPreambleChirps(settings.m_preambleChirps);
     response.getChirpChatDemodSettings()->setNbParityBits(settings.m_nbParityBits);
     response.getChirpChatDemodSettings()->setHasCrc(settings.m_hasCRC ? 1 : 0);
@@ -865,6 +883,9 @@ void ChirpChatDemod::webapiFormatChannelSettings(
     if (channelSettingsKeys.contains("autoNbSymbolsMax") || force) {
         swgChirpChatDemodSettings->setAutoNbSymbolsMax(settings.m_nbSymbolsMax ? 1 : 0);
     }
+    if (channelSettingsKeys.contains("multiSF") || force) {
+        swgChirpChatDemodSettings->setMultiSf(settings.m_multiSF ? 1 : 0);
+    }
     if (channelSettingsKeys.contains("preambleChirps") || force) {
         swgChirpChatDemodSettings->setPreambleChirps(settings.m_preambleChirps);
     }
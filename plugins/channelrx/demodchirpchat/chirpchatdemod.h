@@ -70,6 +70,7 @@ public:
     public:
         const QByteArray& getBytes() const { return m_bytes; }
         unsigned int getSyncWord() const { return m_syncWord; }
+        unsigned int getSpreadFactor() const { return m_spreadFactor; }
         float getSingalDb() const { return m_signalDb; }
         float getNoiseDb() const { return m_noiseDb; }
         unsigned int getPacketSize() const { return m_packetSize; }
@@ -89,6 +90,9 @@ public:
         void setSyncWord(unsigned int syncWord) {
             m_syncWord = syncWord;
         }
+        void setSpreadFactor(unsigned int spreadFactor) {
+            m_spreadFactor = spreadFactor;
+        }
         void setSignalDb(float db) {
             m_signalDb = db;
         }
@@ -129,6 +133,7 @@ public:
     private:
         QByteArray m_bytes;
         unsigned int m_syncWord;
+        unsigned int m_spreadFactor;
         float m_signalDb;
         float m_noiseDb;
         unsigned int m_packetSize;
@@ -146,6 +151,7 @@ public:
             Message(),
             m_bytes(bytes),
             m_syncWord(0),
+            m_spreadFactor(0),
             m_signalDb(0.0),
             m_noiseDb(0.0),
             m_packetSize(0),
@@ -167,6 +173,7 @@ public:
     public:
         const QString& getString() const { return m_str; }
         unsigned int getSyncWord() const { return m_syncWord; }
+        unsigned int getSpreadFactor() const { return m_spreadFactor; }
         float getSingalDb() const { return m_signalDb; }
         float getNoiseDb() const { return m_noiseDb; }
 
@@ -177,6 +184,9 @@ public:
         void setSyncWord(unsigned int syncWord) {
             m_syncWord = syncWord;
         }
+        void setSpreadFactor(unsigned int spreadFactor) {
+            m_spreadFactor = spreadFactor;
+        }
         void setSignalDb(float db) {
             m_signalDb = db;
         }
@@ -187,6 +197,7 @@ public:
     private:
         QString m_str;
         unsigned int m_syncWord;
+        unsigned int m_spreadFactor;
         float m_signalDb;
         float m_noiseDb;
 
@@ -194,6 +205,7 @@ public:
             Message(),
             m_str(str),
             m_syncWord(0),
+            m_spreadFactor(0),
             m_signalDb(0.0),
             m_noiseDb(0.0)
         { }
@@ -279,6 +291,7 @@ private:
     float m_lastMsgSignalDb;
     float m_lastMsgNoiseDb;
     int m_lastMsgSyncWord;
+    unsigned int m_lastMsgSpreadFactor;
     int m_lastMsgPacketLength;
     int m_lastMsgNbParityBits;
     bool m_lastMsgHasCRC;
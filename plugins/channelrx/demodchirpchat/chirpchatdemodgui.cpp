@@ -193,6 +193,12 @@ void ChirpChatDemodGUI::on_Spread_valueChanged(int value)
     applySettings();
 }
 
+void ChirpChatDemodGUI::on_multiSF_stateChanged(int state)
+{
+    m_settings.m_multiSF = (state == Qt::Checked);
+    applySettings();
+}
+
 void ChirpChatDemodGUI::on_deBits_valueChanged(int value)
 {
     m_settings.m_deBits = value;
@@ -520,6 +526,7 @@ void ChirpChatDemodGUI::displaySettings()
     }
 
     ui->messageLengthAuto->setChecked(m_settings.m_autoNbSymbolsMax);
+    ui->multiSF->setChecked(m_settings.m_multiSF);
 
     displaySquelch();
     updateIndexLabel();
@@ -610,6 +617,10 @@ void ChirpChatDemodGUI::showLoRaMessage(const Message& message)
     QByteArray bytes = msg.getBytes();
     QString syncWordStr((tr("%1").arg(msg.getSyncWord(), 2, 16, QChar('0'))));
 
+    if (m_settings.m_multiSF) {
+        syncWordStr.append(tr(" SF%1").arg(msg.getSpreadFactor()));
+    }
+
     ui->sText->setText(tr("%1").arg(msg.getSingalDb(), 0, 'f', 1));
     ui->snrText->setText(tr("%1").arg(msg.getSingalDb() - msg.getNoiseDb(), 0, 'f', 1));
     unsigned int packetLength;
@@ -688,6 +699,10 @@ void ChirpChatDemodGUI::showTextMessage(const Message& message)
         .arg(msg.getSingalDb(), 0, 'f', 1)
         .arg(msg.getSingalDb() - msg.getNoiseDb(), 0, 'f', 1);
 
+    if (m_settings.m_multiSF) {
+        status.append(tr(" SF:%1").arg(msg.getSpreadFactor()));
+    }
+
     displayStatus(status);
     displayText(msg.getString());
 }
@@ -798,6 +813,7 @@ void ChirpChatDemodGUI::makeUIConnections()
     QObject::connect(ui->eomSquelch, &QDial::valueChanged, this, &ChirpChatDemodGUI::on_eomSquelch_valueChanged);
     QObject::connect(ui->messageLength, &QDial::valueChanged, this, &ChirpChatDemodGUI::on_messageLength_valueChanged);
     QObject::connect(ui->messageLengthAuto, &QCheckBox::stateChanged, this, &ChirpChatDemodGUI::on_messageLengthAuto_stateChanged);
+    QObject::connect(ui->multiSF, &QCheckBox::stateChanged, this, &ChirpChatDemodGUI::on_multiSF_stateChanged);
     QObject::connect(ui->header, &QCheckBox::stateChanged, this, &ChirpChatDemodGUI::on_header_stateChanged);
     QObject::connect(ui->fecParity, &QDial::valueChanged, this, &ChirpChatDemodGUI::on_fecParity_valueChanged);
     QObject::connect(ui->crc, &QCheckBox::stateChanged, this, &ChirpChatDemodGUI::on_crc_stateChanged);
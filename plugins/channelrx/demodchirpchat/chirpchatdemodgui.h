@@ -72,6 +72,7 @@ private slots:
     void on_eomSquelch_valueChanged(int value);
     void on_messageLength_valueChanged(int value);
 	void on_messageLengthAuto_stateChanged(int state);
+	void on_multiSF_stateChanged(int state);
 	void on_header_stateChanged(int state);
 	void on_fecParity_valueChanged(int value);
 	void on_crc_stateChanged(int state);
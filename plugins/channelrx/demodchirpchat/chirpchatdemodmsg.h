@@ -31,6 +31,8 @@ namespace ChirpChatDemodMsg
         unsigned int getSyncWord() const { return m_syncWord; }
         float getSingalDb() const { return m_signalDb; }
         float getNoiseDb() const { return m_noiseDb; }
+        unsigned int getSpreadFactor() const { return m_spreadFactor; }
+        unsigned int getDEBits() const { return m_deBits; }
 
         void pushBackSymbol(unsigned short symbol) {
             m_symbols.push_back(symbol);
@@ -47,6 +49,10 @@ namespace ChirpChatDemodMsg
         void setNoiseDb(float db) {
             m_noiseDb = db;
         }
+        void setSpreadFactor(unsigned int spreadFactor, unsigned int deBits) {
+            m_spreadFactor = spreadFactor;
+            m_deBits = deBits;
+        }
 
         static MsgDecodeSymbols* create() {
             return new MsgDecodeSymbols();
@@ -60,18 +66,24 @@ namespace ChirpChatDemodMsg
         unsigned int m_syncWord;
         float m_signalDb;
         float m_noiseDb;
+        unsigned int m_spreadFactor; //!< Spread factor the symbols were demodulated with
+        unsigned int m_deBits;       //!< DE bits the symbols were demodulated with
 
         MsgDecodeSymbols() : //!< create an empty message
             Message(),
             m_syncWord(0),
             m_signalDb(0.0),
-            m_noiseDb(0.0)
+            m_noiseDb(0.0),
+            m_spreadFactor(0),
+            m_deBits(0)
         {}
         MsgDecodeSymbols(const std::vector<unsigned short> symbols) : //!< create a message with symbols copy
             Message(),
             m_syncWord(0),
             m_signalDb(0.0),
-            m_noiseDb(0.0)
+            m_noiseDb(0.0),
+            m_spreadFactor(0),
+            m_deBits(0)
         { m_symbols = symbols; }
     };
 }
@@ -54,6 +54,8 @@ const int ChirpChatDemodSettings::bandwidths[] = {
 };
 const int ChirpChatDemodSettings::nbBandwidths = 3*8 + 3;
 const int ChirpChatDemodSettings::oversampling = 2;
+const int ChirpChatDemodSettings::multiSFMin = 7;
+const int ChirpChatDemodSettings::multiSFMax = 12;
 
 ChirpChatDemodSettings::ChirpChatDemodSettings() :
     m_inputFrequencyOffset(0),
@@ -73,6 +75,7 @@ void ChirpChatDemodSettings::resetToDefaults()
     m_fftWindow = FFTWindow::Rectangle;
     m_eomSquelchTenths = 60;
     m_nbSymbolsMax = 255;
+    m_multiSF = false;
     m_preambleChirps = 8;
     m_packetLength = 32;
     m_nbParityBits = 1;
@@ -137,6 +140,7 @@ QByteArray ChirpChatDemodSettings::serialize() const
     s.writeS32(30, m_workspaceIndex);
     s.writeBlob(31, m_geometryBytes);
     s.writeBool(32, m_hidden);
+    s.writeBool(33, m_multiSF);
 
     return s.final();
 }
@@ -221,6 +225,7 @@ bool ChirpChatDemodSettings::deserialize(const QByteArray& data)
         d.readS32(30, &m_workspaceIndex, 0);
         d.readBlob(31, &m_geometryBytes);
         d.readBool(32, &m_hidden, false);
+        d.readBool(33, &m_multiSF, false);
 
         return true;
     }
@@ -246,3 +251,18 @@ bool ChirpChatDemodSettings::hasSyncWord() const
 {
     return m_codingScheme == CodingLoRa;
 }
+
+int ChirpChatDemodSettings::getMultiSFDEBits(int spreadFactor) const
+{
+    if (m_codingScheme == CodingLoRa)
+    {
+        // LoRa low data rate optimization is mandatory when symbol duration is 16 ms or more
+        return ((1<<spreadFactor) * 1000) / bandwidths[m_bandwidthIndex] >= 16 ? 2 : 0;
+    }
+    else
+    {
+        // Keep the same number of bits per symbol as the main spread factor
+        int deBits = m_deBits + spreadFactor - m_spreadFactor;
+        return deBits < 0 ? 0 : deBits >= spreadFactor ? spreadFactor - 1 : deBits;
+    }
+}
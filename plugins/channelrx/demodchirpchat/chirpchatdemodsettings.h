@@ -47,6 +47,7 @@ struct ChirpChatDemodSettings
     int m_eomSquelchTenths;        //!< Squelch factor to trigger end of message (/10)
     unsigned int m_nbSymbolsMax;   //!< Maximum number of symbols in a payload
     bool m_autoNbSymbolsMax;       //!< Set maximum number of symbols in a payload automatically using last messag value
+    bool m_multiSF;                //!< Look for frames on all spread factors from multiSFMin to multiSFMax in parallel
     unsigned int m_preambleChirps; //!< Number of expected preamble chirps
     int m_nbParityBits;            //!< Hamming parity bits (LoRa)
     int m_packetLength;            //!< Payload packet length in bytes or characters (LoRa)
@@ -74,6 +75,8 @@ struct ChirpChatDemodSettings
     static const int bandwidths[];
     static const int nbBandwidths;
     static const int oversampling;
+    static const int multiSFMin;
+    static const int multiSFMax;
 
     ChirpChatDemodSettings();
     void resetToDefaults();
@@ -82,6 +85,7 @@ struct ChirpChatDemodSettings
     void setSpectrumGUI(Serializable *spectrumGUI) { m_spectrumGUI = spectrumGUI; }
     unsigned int getNbSFDFourths() const; //!< Get the number of SFD period fourths (depends on coding scheme)
     bool hasSyncWord() const;             //!< Only LoRa has a syncword (for the moment)
+    int getMultiSFDEBits(int spreadFactor) const; //!< DE bits to use for an additional spread factor in multi SF mode
     QByteArray serialize() const;
     bool deserialize(const QByteArray& data);
 };
@@ -58,6 +58,7 @@ ChirpChatDemodSink::ChirpChatDemodSink() :
 
 ChirpChatDemodSink::~ChirpChatDemodSink()
 {
+    destroySFLanes();
     FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
 
     if (m_fftSequence >= 0)
@@ -142,6 +143,12 @@ void ChirpChatDemodSink::feed(const SampleVector::const_iterator& begin, const S
 		if (m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
             processSample(ci);
+
+            // Other spread factors share the same sample rate hence the same decimated stream
+            for (auto lane : m_sfLanes) {
+                lane->processSample(ci);
+            }
+
 			m_sampleDistanceRemain += m_interpolatorDistance;
 		}
 	}
@@ -366,6 +373,7 @@ void ChirpChatDemodSink::processSample(const Complex& ci)
                 m_magsqMax = 0.0;
                 m_decodeMsg = ChirpChatDemodMsg::MsgDecodeSymbols::create();
                 m_decodeMsg->setSyncWord(m_syncWord);
+                m_decodeMsg->setSpreadFactor(m_settings.m_spreadFactor, m_settings.m_deBits);
                 m_state = ChirpChatStateReadPayload;
             }
         }
@@ -457,6 +465,71 @@ void ChirpChatDemodSink::processSample(const Complex& ci)
     }
 }
 
+void ChirpChatDemodSink::setDecoderMessageQueue(MessageQueue *messageQueue)
+{
+    m_decoderMsgQueue = messageQueue;
+
+    for (auto lane : m_sfLanes) {
+        lane->setDecoderMessageQueue(messageQueue);
+    }
+}
+
+void ChirpChatDemodSink::applySFLanesSettings(const ChirpChatDemodSettings& settings, bool force)
+{
+    if (!settings.m_multiSF)
+    {
+        destroySFLanes();
+        return;
+    }
+
+    // One lane per spread factor other than the one handled by this sink. FFT engines
+    // of each lane are obtained from the FFT factory so same size plans are shared.
+    unsigned int laneIndex = 0;
+
+    for (int sf = ChirpChatDemodSettings::multiSFMin; sf <= ChirpChatDemodSettings::multiSFMax; sf++)
+    {
+        if (sf == settings.m_spreadFactor) {
+            continue;
+        }
+
+        ChirpChatDemodSettings laneSettings = settings;
+        laneSettings.m_spreadFactor = sf;
+        laneSettings.m_deBits = settings.getMultiSFDEBits(sf);
+        laneSettings.m_multiSF = false;
+
+        if (laneIndex < m_sfLanes.size())
+        {
+            m_sfLanes[laneIndex]->applySettings(laneSettings, force);
+        }
+        else
+        {
+            ChirpChatDemodSink *lane = new ChirpChatDemodSink();
+            lane->setDecoderMessageQueue(m_decoderMsgQueue);
+            lane->applySettings(laneSettings, true);
+            m_sfLanes.push_back(lane);
+        }
+
+        laneIndex++;
+    }
+
+    while (m_sfLanes.size() > laneIndex)
+    {
+        delete m_sfLanes.back();
+        m_sfLanes.pop_back();
+    }
+
+    qDebug("ChirpChatDemodSink::applySFLanesSettings: %u additional spread factors", laneIndex);
+}
+
+void ChirpChatDemodSink::destroySFLanes()
+{
+    for (auto lane : m_sfLanes) {
+        delete lane;
+    }
+
+    m_sfLanes.clear();
+}
+
 void ChirpChatDemodSink::reset()
 {
     m_chirp = 0;
@@ -629,6 +702,7 @@ void ChirpChatDemodSink::applySettings(const ChirpChatDemodSettings& settings, b
             << " m_inputFrequencyOffset: " << settings.m_inputFrequencyOffset
             << " m_bandwidthIndex: " << settings.m_bandwidthIndex
             << " m_spreadFactor: " << settings.m_spreadFactor
+            << " m_multiSF: " << settings.m_multiSF
             << " m_rgbColor: " << settings.m_rgbColor
             << " m_title: " << settings.m_title
             << " force: " << force;
@@ -639,5 +713,9 @@ void ChirpChatDemodSink::applySettings(const ChirpChatDemodSettings& settings, b
         initSF(settings.m_spreadFactor, settings.m_deBits, settings.m_fftWindow);
     }
 
+    if (settings.m_multiSF || !m_sfLanes.empty()) {
+        applySFLanesSettings(settings, force);
+    }
+
     m_settings = settings;
 }
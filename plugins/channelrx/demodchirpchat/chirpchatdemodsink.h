@@ -45,7 +45,7 @@ public:
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
 
     bool getDemodActive() const { return m_demodActive; }
-    void setDecoderMessageQueue(MessageQueue *messageQueue) { m_decoderMsgQueue = messageQueue; }
+    void setDecoderMessageQueue(MessageQueue *messageQueue);
 	void setSpectrumSink(BasebandSampleSink* spectrumSink) { m_spectrumSink = spectrumSink; }
     void applyChannelSettings(int channelSampleRate, int bandwidth, int channelFrequencyOffset, bool force = false);
     void applySettings(const ChirpChatDemodSettings& settings, bool force = false);
@@ -116,9 +116,13 @@ private:
     int m_deLength;                        //!< Number of FFT bins collated to represent one symbol
     int m_preambleTolerance;               //!< Number of FFT bins to collate when looking for preamble
 
+    std::vector<ChirpChatDemodSink*> m_sfLanes; //!< Detectors for the other spread factors in multi SF mode
+
     void processSample(const Complex& ci);
     void initSF(unsigned int sf, unsigned int deBits, FFTWindow::Function fftWindow); //!< Init tables, FFTs, depending on spread factor
     void reset();
+    void applySFLanesSettings(const ChirpChatDemodSettings& settings, bool force);
+    void destroySFLanes();
     unsigned int argmax(
         const Complex *fftBins,
         unsigned int fftMult,
@@ -217,6 +217,12 @@ void DATVDemod::applySettings(const DATVDemodSettings& settings, bool force)
     if (settings.m_maxBitflips != m_settings.m_maxBitflips) {
         reverseAPIKeys.append("maxBitflips");
     }
+    if (settings.m_schedulerThreads != m_settings.m_schedulerThreads) {
+        reverseAPIKeys.append("schedulerThreads");
+    }
+    if (settings.m_fecImplementation != m_settings.m_fecImplementation) {
+        reverseAPIKeys.append("fecImplementation");
+    }
     if (settings.m_audioMute != m_settings.m_audioMute) {
         reverseAPIKeys.append("audioMute");
     }
@@ -392,6 +398,18 @@ void DATVDemod::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("maxBitflips")) {
         settings.m_maxBitflips = response.getDatvDemodSettings()->getMaxBitflips();
     }
+    if (channelSettingsKeys.contains("schedulerThreads"))
+    {
+        int schedulerThreads = response.getDatvDemodSettings()->getSchedulerThreads();
+        settings.m_schedulerThreads = schedulerThreads < 1 ? 1 :
+            schedulerThreads > DATVDemodSettings::m_maxSchedulerThreads ? DATVDemodSettings::m_maxSchedulerThreads : schedulerThreads;
+    }
+    if (channelSettingsKeys.contains("fecImplementation"))
+    {
+        int fecImplementation = response.getDatvDemodSettings()->getFecImplementation();
+        settings.m_fecImplementation = fecImplementation < 0 ? 0 :
+            fecImplementation > DATVDemodSettings::m_maxFECImplementation ? DATVDemodSettings::m_maxFECImplementation : fecImplementation;
+    }
     if (channelSettingsKeys.contains("audioMute")) {
         settings.m_audioMute = response.getDatvDemodSettings()->getAudioMute() == 1;
     }
@@ -494,6 +512,8 @@ void DATVDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& res
 
     response.getDatvDemodSettings()->setSoftLdpcMaxTrials(settings.m_softLDPCMaxTrials);
     response.getDatvDemodSettings()->setMaxBitflips(settings.m_maxBitflips);
+    response.getDatvDemodSettings()->setSchedulerThreads(settings.m_schedulerThreads);
+    response.getDatvDemodSettings()->setFecImplementation(settings.m_fecImplementation);
     response.getDatvDemodSettings()->setAudioMute(settings.m_audioMute ? 1 : 0);
 
     if (response.getDatvDemodSettings()->getAudioDeviceName()) {
@@ -655,6 +675,12 @@ void DATVDemod::webapiFormatChannelSettings(
     if (channelSettingsKeys.contains("maxBitflips") || force) {
         swgDATVDemodSettings->setMaxBitflips(settings.m_maxBitflips);
     }
+    if (channelSettingsKeys.contains("schedulerThreads") || force) {
+        swgDATVDemodSettings->setSchedulerThreads(settings.m_schedulerThreads);
+    }
+    if (channelSettingsKeys.contains("fecImplementation") || force) {
+        swgDATVDemodSettings->setFecImplementation(settings.m_fecImplementation);
+    }
     if (channelSettingsKeys.contains("audioMute") || force) {
         swgDATVDemodSettings->setAudioMute(settings.m_audioMute ? 1 : 0);
     }
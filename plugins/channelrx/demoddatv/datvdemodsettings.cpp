@@ -53,6 +53,8 @@ void DATVDemodSettings::resetToDefaults()
     m_softLDPCToolPath = DEFAULT_LDPCTOOLPATH;
     m_softLDPCMaxTrials = 8;
     m_maxBitflips = 0;
+    m_schedulerThreads = 1;
+    m_fecImplementation = 1;
     m_symbolRate = 250000;
     m_notchFilters = 0;
     m_allowDrift = false;
@@ -130,6 +132,8 @@ QByteArray DATVDemodSettings::serialize() const
     s.writeS32(38, m_workspaceIndex);
     s.writeBlob(39, m_geometryBytes);
     s.writeBool(40, m_hidden);
+    s.writeS32(41, m_schedulerThreads);
+    s.writeS32(42, m_fecImplementation);
 
     return s.final();
 }
@@ -228,6 +232,10 @@ bool DATVDemodSettings::deserialize(const QByteArray& data)
         d.readS32(38, &m_workspaceIndex, 0);
         d.readBlob(39, &m_geometryBytes);
         d.readBool(40, &m_hidden, false);
+        d.readS32(41, &tmp, 1);
+        m_schedulerThreads = tmp < 1 ? 1 : tmp > m_maxSchedulerThreads ? m_maxSchedulerThreads : tmp;
+        d.readS32(42, &tmp, 1);
+        m_fecImplementation = tmp < 0 ? 0 : tmp > m_maxFECImplementation ? m_maxFECImplementation : tmp;
 
         validateSystemConfiguration();
 
@@ -257,6 +265,8 @@ void DATVDemodSettings::debug(const QString& msg) const
         << " m_softLDPCMaxTrials: " << m_softLDPCMaxTrials
         << " m_softLDPCToolPath: " << m_softLDPCToolPath
         << " m_maxBitflips: " << m_maxBitflips
+        << " m_schedulerThreads: " << m_schedulerThreads
+        << " m_fecImplementation: " << m_fecImplementation
         << " m_modulation: " << m_modulation
         << " m_standard: " << m_standard
         << " m_notchFilters: " << m_notchFilters
@@ -285,6 +295,8 @@ bool DATVDemodSettings::isDifferent(const DATVDemodSettings& other)
         || (m_softLDPCMaxTrials != other.m_softLDPCMaxTrials)
         || (m_softLDPCToolPath != other.m_softLDPCToolPath)
         || (m_maxBitflips != other.m_maxBitflips)
+        || (m_schedulerThreads != other.m_schedulerThreads)
+        || (m_fecImplementation != other.m_fecImplementation)
         || (m_modulation != other.m_modulation)
         || (m_notchFilters != other.m_notchFilters)
         || (m_symbolRate != other.m_symbolRate)
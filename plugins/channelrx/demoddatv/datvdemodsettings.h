@@ -84,6 +84,8 @@ struct DATVDemodSettings
     QString m_softLDPCToolPath;
     int m_softLDPCMaxTrials;
     int m_maxBitflips;
+    int m_schedulerThreads; //!< Number of threads the leansdr chain runs on. 1 for single thread.
+    int m_fecImplementation; //!< DVB-S Viterbi and RS decoders: 0 reference, 1 SIMD, 2 both with comparison
     bool m_audioMute;
     QString m_audioDeviceName;
     int m_symbolRate;
@@ -113,6 +115,8 @@ struct DATVDemodSettings
     bool m_hidden;
 
     static const int m_softLDPCMaxMaxTrials = 50;
+    static const int m_maxSchedulerThreads = 8;
+    static const int m_maxFECImplementation = 2;
 
     DATVDemodSettings();
     void resetToDefaults();
@@ -184,6 +184,13 @@ void DATVDemodSink::CleanUpDATVFramework()
 
     if (m_objScheduler != nullptr)
     {
+        for (int i = 0; i < m_objScheduler->nrunnables; i++)
+        {
+            leansdr::runnable_common *runnable = m_objScheduler->runnables[i];
+            qDebug("DATVDemodSink::CleanUpDATVFramework: %s: stage %d: %.3f ms in %llu runs",
+                runnable->name, m_objScheduler->stage_of(runnable), runnable->run_time_ns / 1e6, runnable->run_count);
+        }
+
         m_objScheduler->shutdown();
         delete m_objScheduler;
     }
@@ -628,6 +635,7 @@ void DATVDemodSink::InitDATVFramework()
     m_lngExpectedReadIQ  = BUF_BASEBAND;
 
     m_objScheduler = new leansdr::scheduler();
+    m_objScheduler->set_threads(m_settings.m_schedulerThreads);
 
     //***************
     p_rawiq = new leansdr::pipebuf<leansdr::cf32>(m_objScheduler, "rawiq", BUF_BASEBAND);
@@ -794,7 +802,8 @@ void DATVDemodSink::InitDATVFramework()
         }
 
         //To uncomment -> Linking Problem : undefined symbol: _ZN7leansdr21viterbi_dec_interfaceIhhiiE6updateEPiS2_
-        r = new leansdr::viterbi_sync(m_objScheduler, (*p_symbols), (*p_bytes), m_objDemodulator->cstln, m_objCfg.fec);
+        r = new leansdr::viterbi_sync(m_objScheduler, (*p_symbols), (*p_bytes), m_objDemodulator->cstln, m_objCfg.fec,
+            (leansdr::fec_impl) m_settings.m_fecImplementation);
 
         if (m_objCfg.fastlock) {
             r->resync_period = 1;
@@ -825,7 +834,8 @@ void DATVDemodSink::InitDATVFramework()
     p_vbitcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits processed", BUF_PACKETS);
     p_verrcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits corrected", BUF_PACKETS);
     p_rtspackets = new leansdr::pipebuf<leansdr::tspacket>(m_objScheduler, "rand TS packets", BUF_PACKETS);
-    r_rsdec = new leansdr::rs_decoder<leansdr::u8, 0>(m_objScheduler, *p_rspackets, *p_rtspackets, p_vbitcount, p_verrcount);
+    r_rsdec = new leansdr::rs_decoder<leansdr::u8, 0>(m_objScheduler, *p_rspackets, *p_rtspackets, p_vbitcount, p_verrcount,
+        (leansdr::fec_impl) m_settings.m_fecImplementation);
 
     // BER ESTIMATION
 
@@ -959,6 +969,7 @@ void DATVDemodSink::InitDATVS2Framework()
     m_lngExpectedReadIQ  = BUF_BASEBAND;
 
     m_objScheduler = new leansdr::scheduler();
+    m_objScheduler->set_threads(m_settings.m_schedulerThreads);
 
     //***************
     p_rawiq = new leansdr::pipebuf<leansdr::cf32>(m_objScheduler, "rawiq", BUF_BASEBAND);
@@ -1244,6 +1244,15 @@ struct rs_encoder : runnable
 };
 // rs_encoder
 
+// FEC DECODERS IMPLEMENTATION
+
+enum fec_impl
+{
+    FEC_IMPL_REFERENCE, // Generic scalar decoders
+    FEC_IMPL_SIMD,      // Vectorized decoders
+    FEC_IMPL_VERIFY     // Both, reporting differences (results of reference are used)
+};
+
 // RS DECODER
 
 template <typename Tbyte, int BYTE_ERASED>
@@ -1256,18 +1265,26 @@ struct rs_decoder : runnable
         pipebuf<rspacket<Tbyte>> &_in,
         pipebuf<tspacket> &_out,
         pipebuf<int> *_bitcount = nullptr,
-        pipebuf<int> *_errcount = nullptr
+        pipebuf<int> *_errcount = nullptr,
+        fec_impl _impl = FEC_IMPL_SIMD
     ) :
         runnable(sch, "RS decoder"),
+        impl(_impl),
+        npackets(0),
+        nmismatches(0),
         in(_in),
         out(_out)
     {
         bitcount = _bitcount ? new pipewriter<int>(*_bitcount) : nullptr;
         errcount = _errcount ? new pipewriter<int>(*_errcount) : nullptr;
+        rs.fast_syndromes = (impl != FEC_IMPL_REFERENCE);
     }
 
     ~rs_decoder()
     {
+        if (impl == FEC_IMPL_VERIFY) {
+            fprintf(stderr, "rs_decoder: %lu syndrome mismatches in %lu packets\n", nmismatches, npackets);
+        }
         if (bitcount) {
             delete bitcount;
         }
@@ -1301,6 +1318,10 @@ struct rs_decoder : runnable
             u8 synd[16];
             bool corrupted = rs.syndromes(pin, synd);
 
+            if (impl == FEC_IMPL_VERIFY) {
+                corrupted = verify_syndromes(pin, synd, corrupted);
+            }
+
 #if 0
             if ( ! corrupted ) {
                 // Test BM
@@ -1348,9 +1369,33 @@ struct rs_decoder : runnable
     }
 
   private:
+    fec_impl impl;
+    unsigned long npackets, nmismatches;
     pipereader<rspacket<Tbyte>> in;
     pipewriter<tspacket> out;
     pipewriter<int> *bitcount, *errcount;
+
+    // Compare syndromes with the reference evaluation and carry on with the reference
+    bool verify_syndromes(const u8 *pin, u8 *synd, bool corrupted)
+    {
+        u8 ref_synd[16];
+        rs.fast_syndromes = false;
+        bool ref_corrupted = rs.syndromes(pin, ref_synd);
+        rs.fast_syndromes = true;
+        npackets++;
+
+        if ((ref_corrupted != corrupted) || memcmp(ref_synd, synd, sizeof(ref_synd)))
+        {
+            if (nmismatches < 16) {
+                fprintf(stderr, "rs_decoder: syndrome mismatch at packet %lu\n", npackets);
+            }
+
+            nmismatches++;
+            memcpy(synd, ref_synd, sizeof(ref_synd));
+        }
+
+        return ref_corrupted;
+    }
 };
 // rs_decoder
 
@@ -1528,36 +1573,43 @@ struct viterbi_sync : runnable
     typedef bitpath<uint32_t, TUS, 1, 32> path_12;
     typedef trellis<TS, 64, TUS, 2, 4> trellis_12;
     typedef viterbi_dec<TS, 64, TUS, 2, TCS, 4, TBM, TPM, path_12> dvb_dec_12;
+    typedef viterbi_dec_simd<TS, 64, TUS, 2, TCS, 4, TBM, TPM, path_12> dvb_dec_simd_12;
 
     // 2/3: 6 bits of state, 2 bits in, 3 bits out
     typedef bitpath<uint64_t, TUS, 3, 21> path_23;
     typedef trellis<TS, 64, TUS, 4, 8> trellis_23;
     typedef viterbi_dec<TS, 64, TUS, 4, TCS, 8, TBM, TPM, path_23> dvb_dec_23;
+    typedef viterbi_dec_simd<TS, 64, TUS, 4, TCS, 8, TBM, TPM, path_23> dvb_dec_simd_23;
 
     // 4/6: 6 bits of state, 4 bits in, 6 bits out
     typedef bitpath<uint64_t, TUS, 4, 16> path_46;
     typedef trellis<TS, 64, TUS, 16, 64> trellis_46;
     typedef viterbi_dec<TS, 64, TUS, 16, TCS, 64, TBM, TPM, path_46> dvb_dec_46;
+    typedef viterbi_dec_simd<TS, 64, TUS, 16, TCS, 64, TBM, TPM, path_46> dvb_dec_simd_46;
 
     // 3/4: 6 bits of state, 3 bits in, 4 bits out
     typedef bitpath<uint64_t, TUS, 3, 21> path_34;
     typedef trellis<TS, 64, TUS, 8, 16> trellis_34;
     typedef viterbi_dec<TS, 64, TUS, 8, TCS, 16, TBM, TPM, path_34> dvb_dec_34;
+    typedef viterbi_dec_simd<TS, 64, TUS, 8, TCS, 16, TBM, TPM, path_34> dvb_dec_simd_34;
 
     // 4/5: 6 bits of state, 4 bits in, 5 bits out (non-standard)
     typedef bitpath<uint64_t, TUS, 4, 16> path_45;
     typedef trellis<TS, 64, TUS, 16, 32> trellis_45;
     typedef viterbi_dec<TS, 64, TUS, 16, TCS, 32, TBM, TPM, path_45> dvb_dec_45;
+    typedef viterbi_dec_simd<TS, 64, TUS, 16, TCS, 32, TBM, TPM, path_45> dvb_dec_simd_45;
 
     // 5/6: 6 bits of state, 5 bits in, 6 bits out
     typedef bitpath<uint64_t, TUS, 5, 12> path_56;
     typedef trellis<TS, 64, TUS, 32, 64> trellis_56;
     typedef viterbi_dec<TS, 64, TUS, 32, TCS, 64, TBM, TPM, path_56> dvb_dec_56;
+    typedef viterbi_dec_simd<TS, 64, TUS, 32, TCS, 64, TBM, TPM, path_56> dvb_dec_simd_56;
 
     // 7/8: 6 bits of state, 7 bits in, 8 bits out
     typedef bitpath<uint64_t, TUS, 7, 9> path_78;
     typedef trellis<TS, 64, TUS, 128, 256> trellis_78;
     typedef viterbi_dec<TS, 64, TUS, 128, TCS, 256, TBM, TPM, path_78> dvb_dec_78;
+    typedef viterbi_dec_simd<TS, 64, TUS, 128, TCS, 256, TBM, TPM, path_78> dvb_dec_simd_78;
 
   private:
     pipereader<eucl_ss> in;
@@ -1587,7 +1639,8 @@ struct viterbi_sync : runnable
         pipebuf<eucl_ss> &_in,
         pipebuf<unsigned char> &_out,
         cstln_lut<eucl_ss, 256> *_cstln,
-        code_rate cr
+        code_rate cr,
+        fec_impl impl = FEC_IMPL_SIMD
     ) :
         runnable(sch, "viterbi_sync"),
         in(_in),
@@ -1665,54 +1718,19 @@ struct viterbi_sync : runnable
         }
 
         if (cr == FEC12)
-        {
-            trellis_12 *trell = new trellis_12();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_12(trell);
-        }
+            init_decoders<trellis_12, dvb_dec_12, dvb_dec_simd_12>(impl);
         else if (cr == FEC23)
-        {
-            trellis_23 *trell = new trellis_23();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_23(trell);
-        }
+            init_decoders<trellis_23, dvb_dec_23, dvb_dec_simd_23>(impl);
         else if (cr == FEC46)
-        {
-            trellis_46 *trell = new trellis_46();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_46(trell);
-        }
+            init_decoders<trellis_46, dvb_dec_46, dvb_dec_simd_46>(impl);
         else if (cr == FEC34)
-        {
-            trellis_34 *trell = new trellis_34();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_34(trell);
-        }
+            init_decoders<trellis_34, dvb_dec_34, dvb_dec_simd_34>(impl);
         else if (cr == FEC45)
-        {
-            trellis_45 *trell = new trellis_45();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_45(trell);
-        }
+            init_decoders<trellis_45, dvb_dec_45, dvb_dec_simd_45>(impl);
         else if (cr == FEC56)
-        {
-            trellis_56 *trell = new trellis_56();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_56(trell);
-        }
+            init_decoders<trellis_56, dvb_dec_56, dvb_dec_simd_56>(impl);
         else if (cr == FEC78)
-        {
-            trellis_78 *trell = new trellis_78();
-            trell->init_convolutional(fec->polys);
-            for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_78(trell);
-        }
+            init_decoders<trellis_78, dvb_dec_78, dvb_dec_simd_78>(impl);
         else
         {
             fail("CR not supported");
@@ -1721,7 +1739,40 @@ struct viterbi_sync : runnable
 
     ~viterbi_sync()
     {
-        delete syncs;
+        for (int s = 0; s < nsyncs; ++s)
+            delete syncs[s].dec;
+
+        delete[] syncs;
+    }
+
+    template <typename TRELLIS, typename DEC, typename DEC_SIMD>
+    void init_decoders(fec_impl impl)
+    {
+        TRELLIS *trell = new TRELLIS();
+        trell->init_convolutional(fec->polys);
+        typename DEC_SIMD::tables *tabs = nullptr;
+
+        if (impl != FEC_IMPL_REFERENCE)
+        {
+            tabs = new typename DEC_SIMD::tables(trell);
+
+            if (!tabs->valid)
+            {
+                fprintf(stderr, "viterbi_sync: trellis not suitable for SIMD decoder\n");
+                delete tabs;
+                tabs = nullptr;
+            }
+        }
+
+        for (int s = 0; s < nsyncs; ++s)
+        {
+            if (!tabs)
+                syncs[s].dec = new DEC(trell);
+            else if (impl == FEC_IMPL_SIMD)
+                syncs[s].dec = new DEC_SIMD(tabs);
+            else
+                syncs[s].dec = new viterbi_dec_verify<TUS, TCS, TBM, TPM>(new DEC(trell), new DEC_SIMD(tabs));
+        }
     }
 
     TCS *init_map(bool conj, float angle)
@@ -19,6 +19,11 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 #include <math.h>
 #include <stdint.h>
@@ -45,6 +50,12 @@ void fail(const char *s);
 // [pipereader] is a client-side hook reading from a [pipebuf].
 // [runnable] is anything that moves data between [pipebufs].
 // [scheduler] is a global context which invokes [runnables] until fixpoint.
+//
+// The scheduler runs all [runnables] on the calling thread by default. With more than one
+// thread it first measures the time spent in each [runnable] then splits the list of
+// [runnables] into stages of about the same load, one stage per thread. Each step
+// runs all stages concurrently. A [pipebuf] used by [runnables] of different stages is
+// locked while any of them runs.
 
 static const int MAX_PIPES = 64;
 static const int MAX_RUNNABLES = 64;
@@ -65,8 +76,15 @@ struct pipebuf_common
     }
 
     const char *name;
-
-    pipebuf_common(const char *_name) : name(_name) {
+    int index;         // position in scheduler, gives the locking order
+    bool shared;       // used by runnables of different stages
+    std::mutex mutex;  // locked by runnables when shared
+
+    pipebuf_common(const char *_name) :
+        name(_name),
+        index(0),
+        shared(false)
+    {
     }
 
     virtual ~pipebuf_common() {
@@ -76,8 +94,31 @@ struct pipebuf_common
 struct runnable_common
 {
     const char *name;
+    unsigned long long run_time_ns; // time spent in run()
+    unsigned long long run_count;
+    std::vector<pipebuf_common*> pipes; // read or written, known from readers and writers made at construction
+    std::vector<pipebuf_common*> locks; // shared pipes in locking order
+
+    runnable_common(const char *_name) :
+        name(_name),
+        run_time_ns(0),
+        run_count(0)
+    {
+    }
+
+    void attach_pipe(pipebuf_common *p)
+    {
+        if (std::find(pipes.begin(), pipes.end(), p) == pipes.end()) {
+            pipes.push_back(p);
+        }
+    }
 
-    runnable_common(const char *_name) : name(_name) {
+    void timed_run()
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        run();
+        run_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        run_count++;
     }
 
     virtual ~runnable_common() {
@@ -112,14 +153,27 @@ struct scheduler
     window_placement *windows;
     bool verbose, debug, debug2;
 
+    static const int WARMUP_STEPS = 64; // steps timed on one thread before the runnables are split into stages
+
     scheduler() :
         npipes(0),
         nrunnables(0),
         windows(nullptr),
         verbose(false),
         debug(false),
-        debug2(false)
+        debug2(false),
+        constructing(nullptr),
+        nthreads(1),
+        nsteps(0),
+        generation(0),
+        pending(0),
+        stopping(false)
+    {
+    }
+
+    ~scheduler()
     {
+        stop_threads();
     }
 
     void add_pipe(pipebuf_common *p)
@@ -128,6 +182,7 @@ struct scheduler
             fail("MAX_PIPES");
         }
 
+        p->index = npipes;
         pipes[npipes++] = p;
     }
 
@@ -138,12 +193,59 @@ struct scheduler
         }
 
         runnables[nrunnables++] = r;
+        constructing = r; // readers and writers created next belong to it
+    }
+
+    // Called by readers and writers
+    void attach_pipe(pipebuf_common *p)
+    {
+        if (constructing) {
+            constructing->attach_pipe(p);
+        }
+    }
+
+    // Number of threads to run the runnables on. 1 (default) runs everything on the calling thread.
+    void set_threads(int n)
+    {
+        stop_threads();
+        nthreads = n < 1 ? 1 : n;
+        nsteps = 0;
+    }
+
+    int get_threads() const {
+        return nthreads;
+    }
+
+    int get_stages() const {
+        return stages.size() == 0 ? 1 : stages.size();
     }
 
     void step()
     {
-        for (int i = 0; i < nrunnables; ++i) {
-            runnables[i]->run();
+        constructing = nullptr; // graph is complete once it runs
+
+        if (stages.size() == 0)
+        {
+            for (int i = 0; i < nrunnables; ++i) {
+                runnables[i]->timed_run();
+            }
+
+            if ((nthreads > 1) && (++nsteps == WARMUP_STEPS)) {
+                start_threads();
+            }
+        }
+        else
+        {
+            {
+                std::unique_lock<std::mutex> lock(sync_mutex);
+                generation++;
+                pending = stages.size() - 1;
+            }
+
+            sync_cv.notify_all();
+            run_stage(0); // first stage on calling thread
+            std::unique_lock<std::mutex> lock(sync_mutex);
+            done_cv.wait(lock, [this]{ return pending == 0; });
         }
     }
 
@@ -166,6 +268,8 @@ struct scheduler
 
     void shutdown()
     {
+        stop_threads();
+
         for (int i = 0; i < nrunnables; ++i) {
             runnables[i]->shutdown();
         }
@@ -194,6 +298,191 @@ struct scheduler
         fprintf(stderr, "Total buffer memory: %ld KiB\n",
                 (unsigned long)total_bufs / 1024);
     }
+
+    void dump_times()
+    {
+        for (int i = 0; i < nrunnables; ++i)
+        {
+            fprintf(stderr, ".%-24s : stage %d %10.3f ms %8llu runs\n",
+                runnables[i]->name, stage_of(runnables[i]),
+                runnables[i]->run_time_ns / 1e6, runnables[i]->run_count);
+        }
+    }
+
+    int stage_of(runnable_common *r) const
+    {
+        for (unsigned int s = 0; s < stages.size(); s++)
+        {
+            if (std::find(stages[s].begin(), stages[s].end(), r) != stages[s].end()) {
+                return s;
+            }
+        }
+
+        return 0;
+    }
+
+  private:
+    runnable_common *constructing;
+    int nthreads;
+    int nsteps;
+    std::vector<std::vector<runnable_common*> > stages;
+    std::vector<std::thread> workers;
+    std::mutex sync_mutex;
+    std::condition_variable sync_cv;
+    std::condition_variable done_cv;
+    unsigned long long generation;
+    int pending;
+    bool stopping;
+
+    // Split runnables in their order of creation (which follows the data flow) into stages of equal time
+    void start_threads()
+    {
+        unsigned long long total = 0;
+
+        for (int i = 0; i < nrunnables; ++i) {
+            total += runnables[i]->run_time_ns;
+        }
+
+        int nstages = std::min(nthreads, nrunnables);
+
+        if ((nstages < 2) || (total == 0)) {
+            return;
+        }
+
+        stages.assign(1, std::vector<runnable_common*>());
+        unsigned long long acc = 0;
+
+        for (int i = 0; i < nrunnables; ++i)
+        {
+            if ((acc >= (total * stages.size()) / nstages)
+             && ((int) stages.size() < nstages)
+             && (stages.back().size() > 0)) {
+                stages.push_back(std::vector<runnable_common*>());
+            }
+
+            stages.back().push_back(runnables[i]);
+            acc += runnables[i]->run_time_ns;
+        }
+
+        // Pipes used from more than one stage must be locked
+        for (int p = 0; p < npipes; ++p)
+        {
+            int stage = -1;
+            pipes[p]->shared = false;
+
+            for (int i = 0; i < nrunnables; ++i)
+            {
+                const std::vector<pipebuf_common*>& rpipes = runnables[i]->pipes;
+
+                if (std::find(rpipes.begin(), rpipes.end(), pipes[p]) == rpipes.end()) {
+                    continue;
+                }
+
+                int s = stage_of(runnables[i]);
+
+                if ((stage >= 0) && (s != stage)) {
+                    pipes[p]->shared = true;
+                }
+
+                stage = s;
+            }
+        }
+
+        for (int i = 0; i < nrunnables; ++i)
+        {
+            runnables[i]->locks.clear();
+
+            for (pipebuf_common *p : runnables[i]->pipes)
+            {
+                if (p->shared) {
+                    runnables[i]->locks.push_back(p);
+                }
+            }
+
+            std::sort(runnables[i]->locks.begin(), runnables[i]->locks.end(),
+                [](const pipebuf_common *a, const pipebuf_common *b) { return a->index < b->index; });
+        }
+
+        stopping = false;
+        pending = 0;
+
+        for (unsigned int s = 1; s < stages.size(); s++) {
+            workers.push_back(std::thread(&scheduler::worker, this, s));
+        }
+
+        if (verbose)
+        {
+            fprintf(stderr, "scheduler: %d stages\n", (int) stages.size());
+            dump_times();
+        }
+    }
+
+    void stop_threads()
+    {
+        {
+            std::unique_lock<std::mutex> lock(sync_mutex);
+            stopping = true;
+        }
+
+        sync_cv.notify_all();
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        workers.clear();
+        stages.clear();
+        stopping = false;
+
+        for (int p = 0; p < npipes; ++p) {
+            pipes[p]->shared = false;
+        }
+    }
+
+    void run_stage(int s)
+    {
+        for (runnable_common *r : stages[s])
+        {
+            for (pipebuf_common *p : r->locks) {
+                p->mutex.lock();
+            }
+
+            r->timed_run();
+
+            for (auto it = r->locks.rbegin(); it != r->locks.rend(); ++it) {
+                (*it)->mutex.unlock();
+            }
+        }
+    }
+
+    void worker(int s)
+    {
+        unsigned long long done = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(sync_mutex);
+                sync_cv.wait(lock, [this, done]{ return stopping || (generation != done); });
+
+                if (stopping) {
+                    return;
+                }
+
+                done = generation;
+            }
+
+            run_stage(s);
+
+            {
+                std::unique_lock<std::mutex> lock(sync_mutex);
+
+                if (--pending == 0) {
+                    done_cv.notify_all();
+                }
+            }
+        }
+    }
 };
 
 struct runnable : runnable_common
@@ -221,13 +510,16 @@ struct pipebuf : pipebuf_common
     T *wr;
     T *end;
 
+    scheduler *sch;
+
     pipebuf(
-        scheduler *sch,
+        scheduler *_sch,
         const char *name,
         unsigned long size
     ) :
         pipebuf_common(name),
         nrd(0),
+        sch(_sch),
         min_write(1),
         total_written(0),
         total_read(0)
@@ -337,6 +629,8 @@ struct pipewriter
 
     pipewriter(pipebuf<T> &_buf, unsigned long min_write = 1) : buf(_buf)
     {
+        buf.sch->attach_pipe(&buf);
+
         if (min_write > buf.min_write) {
             buf.min_write = min_write;
         }
@@ -401,7 +695,9 @@ struct pipereader
     int id;
 
     pipereader(pipebuf<T> &_buf) : buf(_buf), id(_buf.add_reader())
-    {}
+    {
+        buf.sch->attach_pipe(&buf);
+    }
 
     long readable() {
         return buf.wr - buf.rds[id];
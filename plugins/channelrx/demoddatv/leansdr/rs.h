@@ -19,6 +19,14 @@
 
 #include "leansdr/math.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LEANSDR_RS_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LEANSDR_RS_NEON
+#endif
+
 #define DEBUG_RS 0
 
 namespace leansdr
@@ -115,8 +123,13 @@ struct rs_engine
     // p(X) = X^8 + X^4 + X^3 + X^2 + 1
     gf2x_p<unsigned char, unsigned short, 0x11d, 8, 2> gf;
     u8 G[17]; // { G_16, ..., G_0 }
+    // Syndromes from the remainder modulo G computed with a 16 byte LFSR (vectorized) instead of
+    // 16 evaluations of the whole message. Results are identical. Can be cleared at runtime.
+    bool fast_syndromes;
+    alignas(16) u8 lfsr_lut[256][16]; // f*G_15 .. f*G_0 for each feedback value f
 
-    rs_engine()
+    rs_engine() :
+        fast_syndromes(true)
     {
         // EN 300 421, section 4.4.2, Code Generator Polynomial
         // G(X) = (X-alpha^0)*...*(X-alpha^15)
@@ -138,6 +151,12 @@ struct rs_engine
             fprintf(stderr, " %02x", G[i]);
         fprintf(stderr, "\n");
 #endif
+        for (int f = 0; f < 256; ++f)
+        {
+            for (int j = 0; j < 16; ++j) {
+                lfsr_lut[f][j] = gf.mul(f, G[j + 1]);
+            }
+        }
     }
 
     // RS-encoded messages are interpreted as coefficients in
@@ -148,6 +167,10 @@ struct rs_engine
     // prepending with 51 zeroes.
     bool syndromes(const u8 *poly, u8 *synd)
     {
+        if (fast_syndromes) {
+            return syndromes_lfsr(poly, synd);
+        }
+
         bool corrupted = false;
 
         for (int i = 0; i < 16; ++i)
@@ -162,6 +185,71 @@ struct rs_engine
         return corrupted;
     }
 
+    // As G(alpha^i) = 0 for i in 0..15 the syndromes can be obtained from the
+    // remainder R = P*X^16 mod G computed by running the message through the encoder LFSR:
+    // synd[i] = R(alpha^i) / alpha^(16*i). R is 0 for a message without errors (by far the most common case).
+    bool syndromes_lfsr(const u8 *poly, u8 *synd)
+    {
+        alignas(16) u8 rem[16]; // { R_15, ..., R_0 }
+#if defined(LEANSDR_RS_SSE2)
+        __m128i r = _mm_setzero_si128();
+
+        for (int i = 0; i < 204; ++i)
+        {
+            u8 f = (u8) _mm_cvtsi128_si32(r) ^ poly[i];
+            r = _mm_xor_si128(_mm_srli_si128(r, 1), _mm_loadu_si128((const __m128i*) lfsr_lut[f]));
+        }
+
+        _mm_store_si128((__m128i*) rem, r);
+#elif defined(LEANSDR_RS_NEON)
+        uint8x16_t r = vdupq_n_u8(0);
+        uint8x16_t zero = vdupq_n_u8(0);
+
+        for (int i = 0; i < 204; ++i)
+        {
+            u8 f = vgetq_lane_u8(r, 0) ^ poly[i];
+            r = veorq_u8(vextq_u8(r, zero, 1), vld1q_u8(lfsr_lut[f]));
+        }
+
+        vst1q_u8(rem, r);
+#else
+        memset(rem, 0, sizeof(rem));
+
+        for (int i = 0; i < 204; ++i)
+        {
+            u8 f = rem[0] ^ poly[i];
+
+            for (int j = 0; j < 15; ++j) {
+                rem[j] = rem[j + 1] ^ lfsr_lut[f][j];
+            }
+
+            rem[15] = lfsr_lut[f][15];
+        }
+#endif
+        bool corrupted = false;
+
+        for (int j = 0; j < 16; ++j)
+        {
+            if (rem[j])
+            {
+                corrupted = true;
+                break;
+            }
+        }
+
+        if (!corrupted)
+        {
+            memset(synd, 0, 16);
+            return false;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            synd[i] = gf.div(eval_poly_rev(rem, 16, gf.exp(i)), gf.exp((16 * i) % 255));
+        }
+
+        return true;
+    }
+
     u8 eval_poly_rev(const u8 *poly, int n, u8 x)
     {
         // poly[0]*x^(n-1) + .. + poly[n-1]*x^0 with Hörner method.
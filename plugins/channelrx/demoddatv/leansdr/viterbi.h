@@ -20,6 +20,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LEANSDR_VITERBI_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LEANSDR_VITERBI_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LEANSDR_VITERBI_NEON
+#endif
 
 // This is a generic implementation of Viterbi with explicit
 // representation of the trellis.  There is special support for
@@ -380,6 +392,402 @@ struct viterbi_dec : viterbi_dec_interface<TUS, TCS, TBM, TPM>
     TPM max_tpm;
 };
 
+// Branch tables of a trellis laid out for add-compare-select across states.
+// All states must have the same number of incoming branches (true for convolutional codes).
+// Built once per trellis and shared by all decoders using it.
+
+template <typename TS, int NSTATES, typename TUS, int NUS, int NCS>
+struct viterbi_acs_tables
+{
+    static const int NBRANCHES = NUS; // Incoming branches per state
+    int32_t pred[NBRANCHES][NSTATES]; // Predecessors of each state in coded symbol order
+    TUS us[NBRANCHES][NSTATES];       // Matching uncoded symbols
+    int32_t cs_pred[NCS][NSTATES];    // Predecessor through branch labelled cs or NSTATES if none
+    TUS cs_us[NCS][NSTATES];
+    int32_t cs_valid[NCS][NSTATES];   // -1 if there is a branch labelled cs else 0
+    bool valid;                       // Tables are usable
+
+    viterbi_acs_tables(trellis<TS, NSTATES, TUS, NUS, NCS> *trell) :
+        valid(true)
+    {
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            int k = 0;
+
+            for (int cs = 0; cs < NCS; ++cs)
+            {
+                typename trellis<TS, NSTATES, TUS, NUS, NCS>::state::branch *b =
+                    &trell->states[s].branches[cs];
+
+                if (b->pred == trell->NOSTATE)
+                {
+                    cs_pred[cs][s] = NSTATES;
+                    cs_us[cs][s] = 0;
+                    cs_valid[cs][s] = 0;
+                    continue;
+                }
+
+                cs_pred[cs][s] = b->pred;
+                cs_us[cs][s] = b->us;
+                cs_valid[cs][s] = -1;
+
+                if (k < NBRANCHES)
+                {
+                    pred[k][s] = b->pred;
+                    us[k][s] = b->us;
+                }
+
+                k++;
+            }
+
+            if (k != NBRANCHES)
+            {
+                fprintf(stderr, "viterbi_acs_tables: state %d has %d branches instead of %d\n", s, k, NBRANCHES);
+                valid = false;
+            }
+        }
+    }
+};
+
+// Same decoder as viterbi_dec for single-symbol and full metrics with the
+// add-compare-select of all states vectorized (AVX2, SSE2 or NEON depending
+// on the build). Decisions are bit-exact with viterbi_dec including ties.
+// TPM and TBM must be 32 bit signed integers.
+
+template <typename TS, int NSTATES,
+          typename TUS, int NUS,
+          typename TCS, int NCS,
+          typename TBM, typename TPM,
+          typename TP>
+struct viterbi_dec_simd : viterbi_dec_interface<TUS, TCS, TBM, TPM>
+{
+    typedef viterbi_acs_tables<TS, NSTATES, TUS, NUS, NCS> tables;
+    static_assert(sizeof(TPM) == 4 && sizeof(TBM) == 4, "viterbi_dec_simd needs 32 bit metrics");
+    static_assert(NSTATES % 8 == 0, "viterbi_dec_simd needs a multiple of 8 states");
+
+    tables *tabs;
+    // Path metrics: one extra slot for the missing predecessor index NSTATES
+    TPM costbanks[2][NSTATES + 8];
+    TP pathbanks[2][NSTATES];
+    int cur; // Bank holding the current metrics and paths
+
+    viterbi_dec_simd(tables *_tables) :
+        tabs(_tables),
+        cur(0)
+    {
+        memset(costbanks, 0, sizeof(costbanks));
+
+        // Determine max value that can fit in TPM
+        max_tpm = (TPM)0 - 1;
+
+        if (max_tpm < 0)
+        {
+            // TPM is signed
+            for (max_tpm = 0; max_tpm * 2 + 1 > max_tpm; max_tpm = max_tpm * 2 + 1);
+        }
+    }
+
+    // Update with full metric
+
+    TUS update(TBM costs[NCS], TPM *quality = nullptr)
+    {
+        const TPM *prev = costbanks[cur];
+        alignas(32) TPM best_m[NSTATES];
+        alignas(32) int32_t best_cs[NSTATES];
+
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            best_m[s] = max_tpm;
+            best_cs[s] = 0;
+        }
+
+        for (int cs = 0; cs < NCS; ++cs)
+        {
+            for (int s = 0; s < NSTATES; ++s)
+            {
+                if (!tabs->cs_valid[cs][s]) {
+                    continue;
+                }
+
+                TPM m = prev[tabs->cs_pred[cs][s]] + costs[cs];
+
+                if (m <= best_m[s])
+                { // <= guarantees one match
+                    best_m[s] = m;
+                    best_cs[s] = cs;
+                }
+            }
+        }
+
+        return select(best_m, best_cs, -1, 0, quality);
+    }
+
+    // Update with single-symbol metric.
+    // cost must be negative.
+    // The other symbols are assigned a cost of 0.
+
+    TUS update(TCS cs, TBM cost, TPM *quality = nullptr)
+    {
+        const TPM *prev = costbanks[cur];
+        alignas(32) TPM best_m[NSTATES];
+        alignas(32) int32_t best_k[NSTATES]; // Branch index or -1 for the branch labelled cs
+
+        // For each state the reference scans the branch labelled cs with its cost then all
+        // the branches with no cost keeping the last one of minimum metric. This is the
+        // last branch of minimum metric without cost unless the branch labelled cs is
+        // strictly better.
+        acs(prev, tabs->cs_pred[cs], tabs->cs_valid[cs], cost, best_m, best_k);
+
+        return select(best_m, best_k, cs, 1, quality);
+    }
+
+  private:
+    TPM max_tpm;
+
+    void acs(const TPM *prev, const int32_t *cspred, const int32_t *csvalid, TBM cost, TPM *best_m, int32_t *best_k)
+    {
+#if defined(LEANSDR_VITERBI_AVX2)
+        const __m256i vcost = _mm256_set1_epi32(cost);
+        const __m256i vmax = _mm256_set1_epi32(max_tpm);
+        const __m256i vnone = _mm256_set1_epi32(-1);
+
+        for (int s = 0; s < NSTATES; s += 8)
+        {
+            __m256i m = _mm256_i32gather_epi32((const int*) prev, _mm256_loadu_si256((const __m256i*) &tabs->pred[0][s]), 4);
+            __m256i k = _mm256_setzero_si256();
+
+            for (int b = 1; b < tables::NBRANCHES; ++b)
+            {
+                __m256i v = _mm256_i32gather_epi32((const int*) prev, _mm256_loadu_si256((const __m256i*) &tabs->pred[b][s]), 4);
+                __m256i gt = _mm256_cmpgt_epi32(v, m); // keep current where v > m
+                m = _mm256_blendv_epi8(v, m, gt);
+                k = _mm256_blendv_epi8(_mm256_set1_epi32(b), k, gt);
+            }
+
+            __m256i valid = _mm256_loadu_si256((const __m256i*) &csvalid[s]);
+            __m256i c = _mm256_i32gather_epi32((const int*) prev, _mm256_loadu_si256((const __m256i*) &cspred[s]), 4);
+            c = _mm256_blendv_epi8(vmax, _mm256_add_epi32(c, vcost), valid);
+            __m256i gt = _mm256_cmpgt_epi32(m, c); // branch labelled cs when strictly better
+            m = _mm256_blendv_epi8(m, c, gt);
+            k = _mm256_blendv_epi8(k, vnone, gt);
+            _mm256_store_si256((__m256i*) &best_m[s], m);
+            _mm256_store_si256((__m256i*) &best_k[s], k);
+        }
+#elif defined(LEANSDR_VITERBI_SSE2)
+        const __m128i vcost = _mm_set1_epi32(cost);
+        const __m128i vmax = _mm_set1_epi32(max_tpm);
+        const __m128i vnone = _mm_set1_epi32(-1);
+
+        for (int s = 0; s < NSTATES; s += 4)
+        {
+            const int32_t *p = &tabs->pred[0][s];
+            __m128i m = _mm_set_epi32(prev[p[3]], prev[p[2]], prev[p[1]], prev[p[0]]);
+            __m128i k = _mm_setzero_si128();
+
+            for (int b = 1; b < tables::NBRANCHES; ++b)
+            {
+                p = &tabs->pred[b][s];
+                __m128i v = _mm_set_epi32(prev[p[3]], prev[p[2]], prev[p[1]], prev[p[0]]);
+                __m128i gt = _mm_cmpgt_epi32(v, m); // keep current where v > m
+                m = _mm_or_si128(_mm_and_si128(gt, m), _mm_andnot_si128(gt, v));
+                k = _mm_or_si128(_mm_and_si128(gt, k), _mm_andnot_si128(gt, _mm_set1_epi32(b)));
+            }
+
+            p = &cspred[s];
+            __m128i valid = _mm_loadu_si128((const __m128i*) &csvalid[s]);
+            __m128i c = _mm_add_epi32(_mm_set_epi32(prev[p[3]], prev[p[2]], prev[p[1]], prev[p[0]]), vcost);
+            c = _mm_or_si128(_mm_and_si128(valid, c), _mm_andnot_si128(valid, vmax));
+            __m128i gt = _mm_cmpgt_epi32(m, c); // branch labelled cs when strictly better
+            m = _mm_or_si128(_mm_and_si128(gt, c), _mm_andnot_si128(gt, m));
+            k = _mm_or_si128(_mm_and_si128(gt, vnone), _mm_andnot_si128(gt, k));
+            _mm_store_si128((__m128i*) &best_m[s], m);
+            _mm_store_si128((__m128i*) &best_k[s], k);
+        }
+#elif defined(LEANSDR_VITERBI_NEON)
+        const int32x4_t vcost = vdupq_n_s32(cost);
+        const int32x4_t vmax = vdupq_n_s32(max_tpm);
+        const int32x4_t vnone = vdupq_n_s32(-1);
+
+        for (int s = 0; s < NSTATES; s += 4)
+        {
+            const int32_t *p = &tabs->pred[0][s];
+            int32_t g[4] = { prev[p[0]], prev[p[1]], prev[p[2]], prev[p[3]] };
+            int32x4_t m = vld1q_s32(g);
+            int32x4_t k = vdupq_n_s32(0);
+
+            for (int b = 1; b < tables::NBRANCHES; ++b)
+            {
+                p = &tabs->pred[b][s];
+                g[0] = prev[p[0]]; g[1] = prev[p[1]]; g[2] = prev[p[2]]; g[3] = prev[p[3]];
+                int32x4_t v = vld1q_s32(g);
+                uint32x4_t le = vcleq_s32(v, m);
+                m = vbslq_s32(le, v, m);
+                k = vbslq_s32(le, vdupq_n_s32(b), k);
+            }
+
+            p = &cspred[s];
+            g[0] = prev[p[0]]; g[1] = prev[p[1]]; g[2] = prev[p[2]]; g[3] = prev[p[3]];
+            uint32x4_t valid = vreinterpretq_u32_s32(vld1q_s32(&csvalid[s]));
+            int32x4_t c = vbslq_s32(valid, vaddq_s32(vld1q_s32(g), vcost), vmax);
+            uint32x4_t lt = vcltq_s32(c, m);
+            vst1q_s32(&best_m[s], vbslq_s32(lt, c, m));
+            vst1q_s32(&best_k[s], vbslq_s32(lt, vnone, k));
+        }
+#else
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            TPM m = prev[tabs->pred[0][s]];
+            int32_t k = 0;
+
+            for (int b = 1; b < tables::NBRANCHES; ++b)
+            {
+                TPM v = prev[tabs->pred[b][s]];
+
+                if (v <= m)
+                {
+                    m = v;
+                    k = b;
+                }
+            }
+
+            TPM c = csvalid[s] ? prev[cspred[s]] + cost : max_tpm;
+
+            if (c < m)
+            {
+                m = c;
+                k = -1;
+            }
+
+            best_m[s] = m;
+            best_k[s] = k;
+        }
+#endif
+    }
+
+    // Path update, best state selection and normalization in state order as viterbi_dec.
+    // sel[s] is a branch index in the branch tables (by_branch) or a coded symbol.
+    // A negative sel[s] is the branch labelled cs.
+    TUS select(const TPM *best_m, const int32_t *sel, int cs, int by_branch, TPM *quality)
+    {
+        const TP *prevpath = pathbanks[cur];
+        TPM *newcost = costbanks[cur ^ 1];
+        TP *newpath = pathbanks[cur ^ 1];
+        TPM best_tpm = max_tpm, best2_tpm = max_tpm;
+        TS best_state = 0;
+
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            int32_t pred;
+            TUS us;
+
+            if (by_branch && (sel[s] >= 0))
+            {
+                pred = tabs->pred[sel[s]][s];
+                us = tabs->us[sel[s]][s];
+            }
+            else
+            {
+                int c = sel[s] < 0 ? cs : sel[s];
+                pred = tabs->cs_pred[c][s];
+                us = tabs->cs_us[c][s];
+            }
+
+            newpath[s] = prevpath[pred];
+            newpath[s].append(us);
+            newcost[s] = best_m[s];
+
+            // Select best and second-best states
+            if (best_m[s] < best_tpm)
+            {
+                best_state = s;
+                best2_tpm = best_tpm;
+                best_tpm = best_m[s];
+            }
+            else if (best_m[s] < best2_tpm)
+            {
+                best2_tpm = best_m[s];
+            }
+        }
+
+        cur ^= 1;
+
+        // Prevent overflow of path metrics
+        for (int s = 0; s < NSTATES; ++s) {
+            newcost[s] -= best_tpm;
+        }
+
+        // Return difference between best and second-best as quality metric.
+        if (quality) {
+            *quality = best2_tpm - best_tpm;
+        }
+
+        // Return uncoded symbol of best path
+        return newpath[best_state].read();
+    }
+};
+
+// Runs two decoders on the same metrics and reports when their decisions differ.
+// Used to validate an implementation against the reference on real signals.
+
+template <typename TUS, typename TCS, typename TBM, typename TPM>
+struct viterbi_dec_verify : viterbi_dec_interface<TUS, TCS, TBM, TPM>
+{
+    viterbi_dec_interface<TUS, TCS, TBM, TPM> *ref, *dut;
+    unsigned long nupdates, nmismatches;
+
+    viterbi_dec_verify(viterbi_dec_interface<TUS, TCS, TBM, TPM> *_ref, viterbi_dec_interface<TUS, TCS, TBM, TPM> *_dut) :
+        ref(_ref),
+        dut(_dut),
+        nupdates(0),
+        nmismatches(0)
+    {}
+
+    ~viterbi_dec_verify()
+    {
+        fprintf(stderr, "viterbi_dec_verify: %lu mismatches in %lu updates\n", nmismatches, nupdates);
+        delete ref;
+        delete dut;
+    }
+
+    TUS update(TBM *costs, TPM *quality = nullptr)
+    {
+        TPM qref, qdut;
+        TUS r = ref->update(costs, &qref);
+        TUS d = dut->update(costs, &qdut);
+        return check(r, d, qref, qdut, quality);
+    }
+
+    TUS update(TCS s, TBM cost, TPM *quality = nullptr)
+    {
+        TPM qref, qdut;
+        TUS r = ref->update(s, cost, &qref);
+        TUS d = dut->update(s, cost, &qdut);
+        return check(r, d, qref, qdut, quality);
+    }
+
+  private:
+    TUS check(TUS r, TUS d, TPM qref, TPM qdut, TPM *quality)
+    {
+        nupdates++;
+
+        if ((r != d) || (qref != qdut))
+        {
+            if (nmismatches < 16) {
+                fprintf(stderr, "viterbi_dec_verify: mismatch at update %lu: us %d/%d quality %d/%d\n",
+                    nupdates, (int) r, (int) d, (int) qref, (int) qdut);
+            }
+
+            nmismatches++;
+        }
+
+        if (quality) {
+            *quality = qref;
+        }
+
+        return r;
+    }
+};
+
 // Paths (sequences of uncoded symbols) represented as bitstreams.
 // NBITS is the number of bits per symbol.
 // DEPTH is the number of symbols stored in the path.
@@ -728,6 +728,10 @@ void DSDDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response
         response.getDsdDemodReport()->setAudioSampleRate(m_basebandSink->getAudioSampleRate());
         response.getDsdDemodReport()->setChannelSampleRate(m_basebandSink->getChannelSampleRate());
         response.getDsdDemodReport()->setSquelch(m_basebandSink->getSquelchOpen() ? 1 : 0);
+        VocoderPool::Stats vocoderStats;
+        m_basebandSink->getVocoderStats(vocoderStats);
+        response.getDsdDemodReport()->setVocoderOverruns(vocoderStats.m_nbOverruns);
+        response.getDsdDemodReport()->setVocoderQueueMs(vocoderStats.getAverageQueueMs());
     }
 
     response.getDsdDemodReport()->setChannelPowerDb(CalcDb::dbPower(magsqAvg));
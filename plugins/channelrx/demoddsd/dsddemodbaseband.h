@@ -68,6 +68,7 @@ public:
     double getMagSq() { return m_sink.getMagSq(); }
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) { m_sink.getMagSqLevels(avg, peak, nbSamples); }
     bool getSquelchOpen() const { return m_sink.getSquelchOpen(); }
+    void getVocoderStats(VocoderPool::Stats& stats) const { m_sink.getVocoderStats(stats); }
     void setBasebandSampleRate(int sampleRate);
 	void setScopeXYSink(BasebandSampleSink* scopeSink) { m_sink.setScopeXYSink(scopeSink); }
 	void configureMyPosition(float myLatitude, float myLongitude) { m_sink.configureMyPosition(myLatitude, myLongitude); }
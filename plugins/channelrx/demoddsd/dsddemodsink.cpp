@@ -61,6 +61,8 @@ DSDDemodSink::DSDDemodSink() :
     m_scopeXY(nullptr),
     m_scopeEnabled(true),
     m_dsdDecoder(),
+    m_vocoderStream(DSPEngine::instance()->getVocoderPool()->openStream("DSDDemod")),
+    m_decoderAudioSampleRate(48000),
     m_signalFormat(signalFormatNone)
 {
 	m_audioBuffer.resize(1<<14);
@@ -83,16 +85,12 @@ DSDDemodSink::DSDDemodSink() :
 
 DSDDemodSink::~DSDDemodSink()
 {
+    DSPEngine::instance()->getVocoderPool()->closeStream(m_vocoderStream);
     delete[] m_sampleBuffer;
 }
 
 void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {	Complex ci;
-	int samplesPerSymbol = m_dsdDecoder.getSamplesPerSymbol();
-
-	m_scopeSampleBuffer.clear();
-
-	m_dsdDecoder.enableMbelib(!m_ambeFeature); // disable mbelib if DV serial support is present and activated else enable it
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
@@ -101,7 +99,7 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 
         if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
         {
-            FixReal sample, delayedSample;
+            FixReal sample;
             qint16 sampleDSD;
 
             Real re = ci.real() / SDR_RX_SCALED;
@@ -176,7 +174,7 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
                 sample = 0;
             }
 
-            m_dsdDecoder.pushSample(sampleDSD);
+            m_decoderBlock.push_back(DecoderSample{sampleDSD, sample});
 
             m_demodBuffer[m_demodBufferFill] = sampleDSD;
             ++m_demodBufferFill;
@@ -203,93 +201,128 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
                 m_demodBufferFill = 0;
             }
 
-            if (m_settings.m_enableCosineFiltering) { // show actual input to FSK demod
-            	sample = m_dsdDecoder.getFilteredSample() * m_scaleFromShort;
-            }
+            m_interpolatorDistanceRemain += m_interpolatorDistance;
+        }
+	}
 
-            if (m_sampleBufferIndex < (1<<17)-1) {
-                m_sampleBufferIndex++;
-            } else {
-                m_sampleBufferIndex = 0;
-            }
+    if (!m_decoderBlock.empty())
+    {
+        // Decoding (symbol sync, frames and vocoder) is done on the vocoder pool
+        pushDecoderJob([this, block = std::move(m_decoderBlock)]() { decodeBlock(block); }, true);
+        m_decoderBlock.clear();
+    }
+}
 
-            m_sampleBuffer[m_sampleBufferIndex] = sample;
+void DSDDemodSink::pushDecoderJob(const VocoderPool::Job& job, bool droppable)
+{
+    // Dropped jobs are counted and reported by the pool
+    DSPEngine::instance()->getVocoderPool()->push(m_vocoderStream, job, droppable);
+}
 
-            if (m_sampleBufferIndex < samplesPerSymbol) {
-                delayedSample = m_sampleBuffer[(1<<17) - samplesPerSymbol + m_sampleBufferIndex]; // wrap
-            } else {
-                delayedSample = m_sampleBuffer[m_sampleBufferIndex - samplesPerSymbol];
-            }
+void DSDDemodSink::getVocoderStats(VocoderPool::Stats& stats) const
+{
+    DSPEngine::instance()->getVocoderPool()->getStats(m_vocoderStream, stats);
+}
 
-            if (m_settings.m_syncOrConstellation)
-            {
-                Sample s(sample, m_dsdDecoder.getSymbolSyncSample() * m_scaleFromShort * 0.84);
-                m_scopeSampleBuffer.push_back(s);
-            }
-            else
-            {
-                Sample s(sample, delayedSample); // I=signal, Q=signal delayed by 20 samples (2400 baud: lowest rate)
-                m_scopeSampleBuffer.push_back(s);
-            }
+void DSDDemodSink::decodeBlock(const std::vector<DecoderSample>& block)
+{
+	int samplesPerSymbol = m_dsdDecoder.getSamplesPerSymbol();
+
+	m_scopeSampleBuffer.clear();
+
+	m_dsdDecoder.enableMbelib(!m_ambeFeature); // disable mbelib if DV serial support is present and activated else enable it
+
+    for (const auto& decoderSample : block)
+    {
+        FixReal sample = decoderSample.m_sample;
+        FixReal delayedSample;
+
+        m_dsdDecoder.pushSample(decoderSample.m_dsd);
+
+        if (m_decoderSettings.m_enableCosineFiltering) { // show actual input to FSK demod
+        	sample = m_dsdDecoder.getFilteredSample() * m_scaleFromShort;
+        }
+
+        if (m_sampleBufferIndex < (1<<17)-1) {
+            m_sampleBufferIndex++;
+        } else {
+            m_sampleBufferIndex = 0;
+        }
 
-            // if (DSPEngine::instance()->hasDVSerialSupport())
-            if (m_ambeFeature)
+        m_sampleBuffer[m_sampleBufferIndex] = sample;
+
+        if (m_sampleBufferIndex < samplesPerSymbol) {
+            delayedSample = m_sampleBuffer[(1<<17) - samplesPerSymbol + m_sampleBufferIndex]; // wrap
+        } else {
+            delayedSample = m_sampleBuffer[m_sampleBufferIndex - samplesPerSymbol];
+        }
+
+        if (m_decoderSettings.m_syncOrConstellation)
+        {
+            Sample s(sample, m_dsdDecoder.getSymbolSyncSample() * m_scaleFromShort * 0.84);
+            m_scopeSampleBuffer.push_back(s);
+        }
+        else
+        {
+            Sample s(sample, delayedSample); // I=signal, Q=signal delayed by 20 samples (2400 baud: lowest rate)
+            m_scopeSampleBuffer.push_back(s);
+        }
+
+        // if (DSPEngine::instance()->hasDVSerialSupport())
+        if (m_ambeFeature)
+        {
+            if ((m_decoderSettings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
             {
-                if ((m_settings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
+                if (!m_decoderSettings.m_audioMute)
                 {
-                    if (!m_settings.m_audioMute)
-                    {
-                        DSPPushMbeFrame *msg = new DSPPushMbeFrame(
-                            m_dsdDecoder.getMbeDVFrame1(),
-                            m_dsdDecoder.getMbeRateIndex(),
-                            m_settings.m_volume * 10.0,
-                            m_settings.m_tdmaStereo ? 1 : 3, // left or both channels
-                            m_settings.m_highPassFilter,
-                            m_audioSampleRate/8000, // upsample from native 8k
-                            &m_audioFifo1
-                        );
-                        m_ambeFeature->handleMessage(*msg);
-                        delete msg;
-                    }
-
-                    m_dsdDecoder.resetMbeDV1();
+                    DSPPushMbeFrame *msg = new DSPPushMbeFrame(
+                        m_dsdDecoder.getMbeDVFrame1(),
+                        m_dsdDecoder.getMbeRateIndex(),
+                        m_decoderSettings.m_volume * 10.0,
+                        m_decoderSettings.m_tdmaStereo ? 1 : 3, // left or both channels
+                        m_decoderSettings.m_highPassFilter,
+                        m_decoderAudioSampleRate/8000, // upsample from native 8k
+                        &m_audioFifo1
+                    );
+                    m_ambeFeature->handleMessage(*msg);
+                    delete msg;
                 }
 
-                if ((m_settings.m_slot2On) && m_dsdDecoder.mbeDVReady2())
-                {
-                    if (!m_settings.m_audioMute)
-                    {
-                        DSPPushMbeFrame *msg = new DSPPushMbeFrame(
-                            m_dsdDecoder.getMbeDVFrame2(),
-                            m_dsdDecoder.getMbeRateIndex(),
-                            m_settings.m_volume * 10.0,
-                            m_settings.m_tdmaStereo ? 2 : 3, // right or both channels
-                            m_settings.m_highPassFilter,
-                            m_audioSampleRate/8000, // upsample from native 8k
-                            &m_audioFifo2
-                        );
-                        m_ambeFeature->handleMessage(*msg);
-                        delete msg;
-                    }
+                m_dsdDecoder.resetMbeDV1();
+            }
 
-                    m_dsdDecoder.resetMbeDV2();
+            if ((m_decoderSettings.m_slot2On) && m_dsdDecoder.mbeDVReady2())
+            {
+                if (!m_decoderSettings.m_audioMute)
+                {
+                    DSPPushMbeFrame *msg = new DSPPushMbeFrame(
+                        m_dsdDecoder.getMbeDVFrame2(),
+                        m_dsdDecoder.getMbeRateIndex(),
+                        m_decoderSettings.m_volume * 10.0,
+                        m_decoderSettings.m_tdmaStereo ? 2 : 3, // right or both channels
+                        m_decoderSettings.m_highPassFilter,
+                        m_decoderAudioSampleRate/8000, // upsample from native 8k
+                        &m_audioFifo2
+                    );
+                    m_ambeFeature->handleMessage(*msg);
+                    delete msg;
                 }
-            }
 
-            m_interpolatorDistanceRemain += m_interpolatorDistance;
+                m_dsdDecoder.resetMbeDV2();
+            }
         }
-	}
+    }
 
     if (!m_ambeFeature)
 	{
-	    if (m_settings.m_slot1On)
+	    if (m_decoderSettings.m_slot1On)
 	    {
 	        int nbAudioSamples;
 	        short *dsdAudio = m_dsdDecoder.getAudio1(nbAudioSamples);
 
 	        if (nbAudioSamples > 0)
 	        {
-	            if (!m_settings.m_audioMute) {
+	            if (!m_decoderSettings.m_audioMute) {
 	                m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples);
 	            }
 
@@ -297,14 +330,14 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 	        }
 	    }
 
-        if (m_settings.m_slot2On)
+        if (m_decoderSettings.m_slot2On)
         {
             int nbAudioSamples;
             short *dsdAudio = m_dsdDecoder.getAudio2(nbAudioSamples);
 
             if (nbAudioSamples > 0)
             {
-                if (!m_settings.m_audioMute) {
+                if (!m_decoderSettings.m_audioMute) {
                     m_audioFifo2.write((const quint8*) dsdAudio, nbAudioSamples);
                 }
 
@@ -335,7 +368,10 @@ void DSDDemodSink::applyAudioSampleRate(int sampleRate)
         qDebug("DSDDemodSink::applyAudioSampleRate: audio will sound best with sample rates that are integer multiples of 8 kS/s");
     }
 
-    m_dsdDecoder.setUpsampling(upsampling);
+    pushDecoderJob([this, upsampling, sampleRate]() {
+        m_dsdDecoder.setUpsampling(upsampling);
+        m_decoderAudioSampleRate = sampleRate;
+    }, false);
     m_audioSampleRate = sampleRate;
 
     QList<ObjectPipe*> pipes;
@@ -427,42 +463,50 @@ void DSDDemodSink::applySettings(const DSDDemodSettings& settings, bool force)
         m_squelchLevel = std::pow(10.0, settings.m_squelch / 10.0);
     }
 
-    if ((settings.m_volume != m_settings.m_volume) || force)
+    // Decoder settings are applied by the decoder jobs in sequence with the blocks
+    pushDecoderJob([this, settings, force]() { applyDecoderSettings(settings, force); }, false);
+
+    m_settings = settings;
+}
+
+void DSDDemodSink::applyDecoderSettings(const DSDDemodSettings& settings, bool force)
+{
+    if ((settings.m_volume != m_decoderSettings.m_volume) || force)
     {
         m_dsdDecoder.setAudioGain(settings.m_volume);
     }
 
-    if ((settings.m_baudRate != m_settings.m_baudRate) || force)
+    if ((settings.m_baudRate != m_decoderSettings.m_baudRate) || force)
     {
         m_dsdDecoder.setBaudRate(settings.m_baudRate);
     }
 
-    if ((settings.m_enableCosineFiltering != m_settings.m_enableCosineFiltering) || force)
+    if ((settings.m_enableCosineFiltering != m_decoderSettings.m_enableCosineFiltering) || force)
     {
         m_dsdDecoder.enableCosineFiltering(settings.m_enableCosineFiltering);
     }
 
-    if ((settings.m_tdmaStereo != m_settings.m_tdmaStereo) || force)
+    if ((settings.m_tdmaStereo != m_decoderSettings.m_tdmaStereo) || force)
     {
         m_dsdDecoder.setTDMAStereo(settings.m_tdmaStereo);
     }
 
-    if ((settings.m_pllLock != m_settings.m_pllLock) || force)
+    if ((settings.m_pllLock != m_decoderSettings.m_pllLock) || force)
     {
         m_dsdDecoder.setSymbolPLLLock(settings.m_pllLock);
     }
 
-    if ((settings.m_highPassFilter != m_settings.m_highPassFilter) || force)
+    if ((settings.m_highPassFilter != m_decoderSettings.m_highPassFilter) || force)
     {
         m_dsdDecoder.useHPMbelib(settings.m_highPassFilter);
     }
 
-    m_settings = settings;
+    m_decoderSettings = settings;
 }
 
 void DSDDemodSink::configureMyPosition(float myLatitude, float myLongitude)
 {
-    m_dsdDecoder.setMyPoint(myLatitude, myLongitude);
+    pushDecoderJob([this, myLatitude, myLongitude]() { m_dsdDecoder.setMyPoint(myLatitude, myLongitude); }, false);
 }
 
 const char *DSDDemodSink::updateAndGetStatusText()
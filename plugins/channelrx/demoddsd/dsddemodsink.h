@@ -18,6 +18,8 @@
 #ifndef INCLUDE_DSDDEMODSINK_H
 #define INCLUDE_DSDDEMODSINK_H
 
+#include <vector>
+
 #include <QVector>
 
 #include "dsp/channelsamplesink.h"
@@ -27,6 +29,7 @@
 #include "dsp/firfilter.h"
 #include "dsp/afsquelch.h"
 #include "dsp/afsquelch.h"
+#include "dsp/vocoderpool.h"
 #include "audio/audiofifo.h"
 #include "util/movingaverage.h"
 #include "util/doublebufferfifo.h"
@@ -62,6 +65,7 @@ public:
 
 	double getMagSq() { return m_magsq; }
 	bool getSquelchOpen() const { return m_squelchOpen; }
+    void getVocoderStats(VocoderPool::Stats& stats) const;
 
 	const DSDDecoder& getDecoder() const { return m_dsdDecoder; }
 
@@ -112,6 +116,13 @@ private:
 		RSRunning
 	};
 
+    // Output of the demodulator for one sample. Decoded in blocks by the vocoder pool.
+    struct DecoderSample
+    {
+        qint16 m_dsd;     //!< Input of DSD decoder
+        FixReal m_sample; //!< Demodulated sample for scope
+    };
+
     int m_channelSampleRate;
 	int m_channelFrequencyOffset;
 	DSDDemodSettings m_settings;
@@ -152,12 +163,19 @@ private:
 	bool m_scopeEnabled;
 
 	DSDDecoder m_dsdDecoder;
+    std::vector<DecoderSample> m_decoderBlock;
+    VocoderPool::Stream *m_vocoderStream;
+    DSDDemodSettings m_decoderSettings; //!< Settings as seen by the decoder jobs
+    int m_decoderAudioSampleRate;       //!< Audio sample rate as seen by the decoder jobs
 
 	char m_formatStatusText[82+1]; //!< Fixed signal format dependent status text
     SignalFormat m_signalFormat;   //!< Used to keep formatting during successive calls for the same standard type
     PhaseDiscriminators m_phaseDiscri;
 
     void formatStatusText();
+    void pushDecoderJob(const VocoderPool::Job& job, bool droppable);
+    void decodeBlock(const std::vector<DecoderSample>& block);
+    void applyDecoderSettings(const DSDDemodSettings& settings, bool force);
 };
 
 #endif // INCLUDE_DSDDEMODSINK_H
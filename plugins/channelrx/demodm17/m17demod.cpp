@@ -546,6 +546,10 @@ void M17Demod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response
     response.getM17DemodReport()->setAudioSampleRate(m_basebandSink->getAudioSampleRate());
     response.getM17DemodReport()->setChannelSampleRate(m_basebandSink->getChannelSampleRate());
     response.getM17DemodReport()->setSquelch(m_basebandSink->getSquelchOpen() ? 1 : 0);
+    VocoderPool::Stats vocoderStats;
+    m_basebandSink->getVocoderStats(vocoderStats);
+    response.getM17DemodReport()->setVocoderOverruns(vocoderStats.m_nbOverruns);
+    response.getM17DemodReport()->setVocoderQueueMs(vocoderStats.getAverageQueueMs());
 }
 
 void M17Demod::webapiReverseSendSettings(const QList<QString>& channelSettingsKeys, const M17DemodSettings& settings, bool force)
@@ -110,6 +110,7 @@ public:
     }
 
     void resetPRBS() { m_sink.resetPRBS(); }
+    void getVocoderStats(VocoderPool::Stats& stats) const { m_sink.getVocoderStats(stats); }
 
     uint32_t getLSFCount() const { return m_sink.getLSFCount(); }
     const QString& getSrcCall() const { return m_sink.getSrcCall(); }
@@ -18,11 +18,14 @@
 // #include <boost/crc.hpp>
 // #include <boost/program_options.hpp>
 // #include <boost/optional.hpp>
+#include <algorithm>
+
 #include <codec2/codec2.h>
 
 #include <QDebug>
 
 #include "audio/audiofifo.h"
+#include "dsp/dspengine.h"
 #include "util/ax25.h"
 
 #include "ax25_frame.h"
@@ -35,6 +38,7 @@ M17DemodProcessor::M17DemodProcessor() :
     m_packetFrameCounter(0),
     m_displayLSF(true),
     m_noiseBlanker(true),
+    m_vocoderStream(DSPEngine::instance()->getVocoderPool()->openStream("M17Demod")),
     m_demod(handle_frame),
     m_audioFifo(nullptr),
     m_audioMute(false),
@@ -58,6 +62,7 @@ M17DemodProcessor::M17DemodProcessor() :
 
 M17DemodProcessor::~M17DemodProcessor()
 {
+    DSPEngine::instance()->getVocoderPool()->closeStream(m_vocoderStream);
     codec2_destroy(m_codec2);
 }
 
@@ -467,7 +472,6 @@ bool M17DemodProcessor::decode_bert(modemm17::M17FrameDecoder::bert_buffer_t con
 bool M17DemodProcessor::demodulate_audio(modemm17::M17FrameDecoder::audio_buffer_t const& audio, int viterbi_cost)
 {
     bool result = true;
-    std::array<int16_t, 160> buf; // 8k audio
 
     // First two bytes are the frame counter + EOS indicator.
     if (viterbi_cost < 70 && (audio[0] & 0x80))
@@ -481,33 +485,65 @@ bool M17DemodProcessor::demodulate_audio(modemm17::M17FrameDecoder::audio_buffer
 
     if (m_audioFifo && !m_audioMute)
     {
-        if (m_noiseBlanker && viterbi_cost > 80)
-        {
-            buf.fill(0);
-            processAudio(buf); // first block expanded
-            processAudio(buf); // second block expanded
-        }
-        else
-        {
-            codec2_decode(m_codec2, buf.data(), audio.data() + 2);  // first 8 bytes block input
-            processAudio(buf);
-            codec2_decode(m_codec2, buf.data(), audio.data() + 10); // second 8 bytes block input
-            processAudio(buf);
-        }
+        std::array<uint8_t, 16> payload;
+        std::copy(audio.begin() + 2, audio.end(), payload.begin());
+        bool blank = m_noiseBlanker && viterbi_cost > 80;
+        pushAudioJob([this, payload, blank]() { decodeAudio(payload, blank); }, true);
     }
 
     return result;
 }
 
+void M17DemodProcessor::pushAudioJob(const VocoderPool::Job& job, bool droppable)
+{
+    // Dropped jobs are counted and reported by the pool
+    DSPEngine::instance()->getVocoderPool()->push(m_vocoderStream, job, droppable);
+}
+
+void M17DemodProcessor::getVocoderStats(VocoderPool::Stats& stats) const
+{
+    DSPEngine::instance()->getVocoderPool()->getStats(m_vocoderStream, stats);
+}
+
+void M17DemodProcessor::decodeAudio(const std::array<uint8_t, 16>& payload, bool blank)
+{
+    std::array<int16_t, 160> buf; // 8k audio
+
+    if (blank)
+    {
+        buf.fill(0);
+        processAudio(buf); // first block expanded
+        processAudio(buf); // second block expanded
+    }
+    else
+    {
+        codec2_decode(m_codec2, buf.data(), payload.data());     // first 8 bytes block input
+        processAudio(buf);
+        codec2_decode(m_codec2, buf.data(), payload.data() + 8); // second 8 bytes block input
+        processAudio(buf);
+    }
+}
+
+// Audio parameters are applied by the audio jobs in sequence with the frames
+
 void M17DemodProcessor::setUpsampling(int upsampling)
 {
-    m_upsampling = upsampling < 1 ? 1 : upsampling > 6 ? 6 : upsampling;
+    pushAudioJob([this, upsampling]() {
+        m_upsampling = upsampling < 1 ? 1 : upsampling > 6 ? 6 : upsampling;
+    }, false);
 }
 
 void M17DemodProcessor::setVolume(float volume)
 {
-    m_volume = volume;
-    setVolumeFactors();
+    pushAudioJob([this, volume]() {
+        m_volume = volume;
+        setVolumeFactors();
+    }, false);
+}
+
+void M17DemodProcessor::setHP(bool useHP)
+{
+    pushAudioJob([this, useHP]() { m_upsamplingFilter.useHP(useHP); }, false);
 }
 
 void M17DemodProcessor::processAudio(const std::array<int16_t, 160>& in)
@@ -21,6 +21,7 @@
 #include <QObject>
 
 #include "dsp/dsptypes.h"
+#include "dsp/vocoderpool.h"
 #include "audio/audiocompressor.h"
 #include "M17Demodulator.h"
 #include "m17demodfilters.h"
@@ -55,7 +56,7 @@ public:
     void setAudioMute(bool mute) { m_audioMute = mute; }
     void setUpsampling(int upsampling);
     void setVolume(float volume);
-    void setHP(bool useHP) { m_upsamplingFilter.useHP(useHP); }
+    void setHP(bool useHP);
     void resetInfo();
     void setDCDOff();
     uint32_t getLSFCount() const { return m_lsfCount; }
@@ -105,6 +106,8 @@ public:
         m_prbs.reset();
     }
 
+    void getVocoderStats(VocoderPool::Stats& stats) const;
+
 private:
     std::vector<uint8_t> m_currentPacket;
     size_t m_packetFrameCounter;
@@ -112,6 +115,7 @@ private:
     bool m_displayLSF;
     bool m_noiseBlanker;
     struct CODEC2 *m_codec2;
+    VocoderPool::Stream *m_vocoderStream; //!< Codec2 decoding and audio output run on the vocoder pool
     static M17DemodProcessor *m_this;
     modemm17::M17Demodulator m_demod;
     AudioFifo *m_audioFifo;
@@ -173,6 +177,8 @@ private:
     void decode_type(uint16_t type);
     void append_packet(std::vector<uint8_t>& result, modemm17::M17FrameDecoder::lsf_buffer_t in);
 
+    void pushAudioJob(const VocoderPool::Job& job, bool droppable);
+    void decodeAudio(const std::array<uint8_t, 16>& payload, bool blank);
     void processAudio(const std::array<int16_t, 160>& in);
     void upsample(int upsampling, const int16_t *in, int nbSamplesIn);
     void noUpsample(const int16_t *in, int nbSamplesIn);
@@ -110,6 +110,7 @@ public:
     }
 
     void resetPRBS() { m_m17DemodProcessor.resetPRBS(); }
+    void getVocoderStats(VocoderPool::Stats& stats) const { m_m17DemodProcessor.getVocoderStats(stats); }
 
     uint32_t getLSFCount() const { return m_m17DemodProcessor.getLSFCount(); }
     const QString& getSrcCall() const { return m_m17DemodProcessor.getSrcCall(); }
@@ -202,28 +202,26 @@ bool PacketDemod::handleMessage(const Message& cmd)
         }
 
         // Write to log file
-        if (m_logFile.isOpen())
+        if (m_logWriter.isOpen())
         {
             AX25Packet ax25;
 
             if (ax25.decode(report.getPacket()))
             {
-                m_logStream << report.getDateTime().date().toString() << ","
-                    << report.getDateTime().time().toString() << ","
-                    << report.getPacket().toHex() << ","
-                    << "\"" << ax25.m_from << "\","
-                    << "\"" << ax25.m_to << "\","
-                    << "\"" << ax25.m_via << "\","
-                    << ax25.m_type << ","
-                    << ax25.m_pid << ","
-                    << "\"" << ax25.m_dataASCII << "\","
-                    << "\"" << ax25.m_dataHex << "\"\n";
+                m_logWriter.write(report.getDateTime(), {
+                    QString(report.getPacket().toHex()),
+                    ax25.m_from,
+                    ax25.m_to,
+                    ax25.m_via,
+                    ax25.m_type,
+                    ax25.m_pid,
+                    ax25.m_dataASCII,
+                    ax25.m_dataHex
+                });
             }
             else
             {
-                m_logStream << report.getDateTime().date().toString() << ","
-                    << report.getDateTime().time().toString() << ","
-                    << report.getPacket().toHex() << "\n";
+                m_logWriter.write(report.getDateTime(), {QString(report.getPacket().toHex())});
             }
         }
 
@@ -282,6 +280,9 @@ void PacketDemod::applySettings(const PacketDemodSettings& settings, bool force)
     if ((settings.m_fmDeviation != m_settings.m_fmDeviation) || force) {
         reverseAPIKeys.append("fmDeviation");
     }
+    if ((settings.m_multiSlicer != m_settings.m_multiSlicer) || force) {
+        reverseAPIKeys.append("multiSlicer");
+    }
     if ((settings.m_udpEnabled != m_settings.m_udpEnabled) || force) {
         reverseAPIKeys.append("udpEnabled");
     }
@@ -327,24 +328,13 @@ void PacketDemod::applySettings(const PacketDemodSettings& settings, bool force)
         || (settings.m_logFilename != m_settings.m_logFilename)
         || force)
     {
-        if (m_logFile.isOpen())
-        {
-            m_logStream.flush();
-            m_logFile.close();
-        }
+        m_logWriter.close();
+
         if (settings.m_logEnabled && !settings.m_logFilename.isEmpty())
         {
-            m_logFile.setFileName(settings.m_logFilename);
-            if (m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+            if (m_logWriter.open(settings.m_logFilename, QStringList{"Date", "Time", "Data", "From", "To", "Via", "Type", "PID", "Data ASCII", "Data Hex"}))
             {
                 qDebug() << "PacketDemod::applySettings - Logging to: " << settings.m_logFilename;
-                bool newFile = m_logFile.size() == 0;
-                m_logStream.setDevice(&m_logFile);
-                if (newFile)
-                {
-                    // Write header
-                    m_logStream << "Date,Time,Data,From,To,Via,Type,PID,Data ASCII,Data Hex\n";
-                }
             }
             else
             {
@@ -467,6 +457,9 @@ void PacketDemod::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("fmDeviation")) {
         settings.m_fmDeviation = response.getPacketDemodSettings()->getFmDeviation();
     }
+    if (channelSettingsKeys.contains("multiSlicer")) {
+        settings.m_multiSlicer = response.getPacketDemodSettings()->getMultiSlicer() != 0;
+    }
     if (channelSettingsKeys.contains("rfBandwidth")) {
         settings.m_rfBandwidth = response.getPacketDemodSettings()->getRfBandwidth();
     }
@@ -520,6 +513,7 @@ void PacketDemod::webapiUpdateChannelSettings(
 void PacketDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const PacketDemodSettings& settings)
 {
     response.getPacketDemodSettings()->setFmDeviation(settings.m_fmDeviation);
+    response.getPacketDemodSettings()->setMultiSlicer(settings.m_multiSlicer ? 1 : 0);
     response.getPacketDemodSettings()->setInputFrequencyOffset(settings.m_inputFrequencyOffset);
     response.getPacketDemodSettings()->setMode((int) settings.m_mode);
     response.getPacketDemodSettings()->setRfBandwidth(settings.m_rfBandwidth);
@@ -632,6 +626,9 @@ void PacketDemod::webapiFormatChannelSettings(
     if (channelSettingsKeys.contains("fmDeviation") || force) {
         swgPacketDemodSettings->setFmDeviation(settings.m_fmDeviation);
     }
+    if (channelSettingsKeys.contains("multiSlicer") || force) {
+        swgPacketDemodSettings->setMultiSlicer(settings.m_multiSlicer ? 1 : 0);
+    }
     if (channelSettingsKeys.contains("inputFrequencyOffset") || force) {
         swgPacketDemodSettings->setInputFrequencyOffset(settings.m_inputFrequencyOffset);
     }
@@ -24,12 +24,11 @@
 #include <QNetworkRequest>
 #include <QUdpSocket>
 #include <QThread>
-#include <QFile>
-#include <QTextStream>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
 #include "util/message.h"
+#include "util/logwriter.h"
 
 #include "packetdemodbaseband.h"
 #include "packetdemodsettings.h"
@@ -147,8 +146,7 @@ private:
     int m_basebandSampleRate; //!< stored from device message used when starting baseband sink
     qint64 m_centerFrequency;
     QUdpSocket m_udpSocket;
-    QFile m_logFile;
-    QTextStream m_logStream;
+    LogWriter m_logWriter;
 
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
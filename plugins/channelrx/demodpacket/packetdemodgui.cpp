@@ -25,6 +25,8 @@
 #include <QAction>
 #include <QRegExp>
 #include <QFileDialog>
+#include <QFile>
+#include <QTextStream>
 #include <QScrollBar>
 
 #include "packetdemodgui.h"
@@ -291,6 +293,12 @@ void PacketDemodGUI::on_fmDev_valueChanged(int value)
     applySettings();
 }
 
+void PacketDemodGUI::on_multiSlicer_clicked(bool checked)
+{
+    m_settings.m_multiSlicer = checked;
+    applySettings();
+}
+
 void PacketDemodGUI::on_filterFrom_editingFinished()
 {
     m_settings.m_filterFrom = ui->filterFrom->text();
@@ -548,6 +556,7 @@ void PacketDemodGUI::displaySettings()
 
     ui->fmDevText->setText(QString("%1k").arg(m_settings.m_fmDeviation / 1000.0, 0, 'f', 1));
     ui->fmDev->setValue(m_settings.m_fmDeviation / 100.0);
+    ui->multiSlicer->setChecked(m_settings.m_multiSlicer);
 
     updateIndexLabel();
 
@@ -706,6 +715,7 @@ void PacketDemodGUI::makeUIConnections()
     QObject::connect(ui->mode, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &PacketDemodGUI::on_mode_currentIndexChanged);
     QObject::connect(ui->rfBW, &QSlider::valueChanged, this, &PacketDemodGUI::on_rfBW_valueChanged);
     QObject::connect(ui->fmDev, &QSlider::valueChanged, this, &PacketDemodGUI::on_fmDev_valueChanged);
+    QObject::connect(ui->multiSlicer, &QCheckBox::clicked, this, &PacketDemodGUI::on_multiSlicer_clicked);
     QObject::connect(ui->filterFrom, &QLineEdit::editingFinished, this, &PacketDemodGUI::on_filterFrom_editingFinished);
     QObject::connect(ui->filterTo, &QLineEdit::editingFinished, this, &PacketDemodGUI::on_filterTo_editingFinished);
     QObject::connect(ui->filterPID, &QCheckBox::stateChanged, this, &PacketDemodGUI::on_filterPID_stateChanged);
@@ -113,6 +113,7 @@ private slots:
     void on_mode_currentIndexChanged(int value);
     void on_rfBW_valueChanged(int index);
     void on_fmDev_valueChanged(int value);
+    void on_multiSlicer_clicked(bool checked);
     void on_filterFrom_editingFinished();
     void on_filterTo_editingFinished();
     void on_filterPID_stateChanged(int state);
@@ -36,6 +36,7 @@ void PacketDemodSettings::resetToDefaults()
     m_mode = ModeAFSK1200;
     m_rfBandwidth = 12500.0f;
     m_fmDeviation = 2500.0f;
+    m_multiSlicer = false;
     m_filterFrom = "";
     m_filterTo = "";
     m_filterPID = "";
@@ -100,6 +101,7 @@ QByteArray PacketDemodSettings::serialize() const
     s.writeS32(28, m_workspaceIndex);
     s.writeBlob(29, m_geometryBytes);
     s.writeBool(30, m_hidden);
+    s.writeBool(31, m_multiSlicer);
 
     for (int i = 0; i < PACKETDEMOD_COLUMNS; i++) {
         s.writeS32(100 + i, m_columnIndexes[i]);
@@ -182,6 +184,7 @@ bool PacketDemodSettings::deserialize(const QByteArray& data)
         d.readS32(28, &m_workspaceIndex, 0);
         d.readBlob(29, &m_geometryBytes);
         d.readBool(30, &m_hidden, false);
+        d.readBool(31, &m_multiSlicer, false);
 
         for (int i = 0; i < PACKETDEMOD_COLUMNS; i++) {
             d.readS32(100 + i, &m_columnIndexes[i], i);
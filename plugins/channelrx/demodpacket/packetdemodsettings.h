@@ -37,6 +37,7 @@ struct PacketDemodSettings
     Mode m_mode;
     Real m_rfBandwidth;
     Real m_fmDeviation;
+    bool m_multiSlicer;             //!< Run a bank of slicers with different thresholds and timing
     QString m_filterFrom;
     QString m_filterTo;
     QString m_filterPID;
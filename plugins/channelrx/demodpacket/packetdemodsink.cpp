@@ -29,6 +29,17 @@
 #include "packetdemod.h"
 #include "packetdemodsink.h"
 
+static int gcd(int a, int b)
+{
+    while (b != 0)
+    {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
 PacketDemodSink::PacketDemodSink(PacketDemod *packetDemod) :
         m_packetDemod(packetDemod),
         m_channelSampleRate(PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE),
@@ -37,11 +48,11 @@ PacketDemodSink::PacketDemodSink(PacketDemod *packetDemod) :
         m_magsqPeak(0.0f),
         m_magsqCount(0),
         m_messageQueueToChannel(nullptr),
-        m_f1(nullptr),
-        m_f0(nullptr),
-        m_corrBuf(nullptr),
+        m_f1Idx(0),
+        m_f0Idx(0),
         m_corrIdx(0),
-        m_corrCnt(0)
+        m_corrCnt(0),
+        m_sampleCount(0)
 {
     m_magsq = 0.0;
 
@@ -54,36 +65,25 @@ PacketDemodSink::PacketDemodSink(PacketDemod *packetDemod) :
 
 PacketDemodSink::~PacketDemodSink()
 {
-    delete[] m_f1;
-    delete[] m_f0;
-    delete[] m_corrBuf;
 }
 
 void PacketDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-    Complex ci;
+    unsigned int nbIn = end - begin;
+    m_resamplerIn.resize(nbIn);
 
-    for (SampleVector::const_iterator it = begin; it != end; ++it)
+    for (unsigned int i = 0; i < nbIn; i++)
     {
-        Complex c(it->real(), it->imag());
-        c *= m_nco.nextIQ();
+        Complex c(begin[i].real(), begin[i].imag());
+        m_resamplerIn[i] = c * m_nco.nextIQ();
+    }
 
-        if (m_interpolatorDistance < 1.0f) // interpolate
-        {
-            while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
-        else // decimate
-        {
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
+    // Interpolates or decimates the whole block
+    m_resamplerOut.clear();
+    m_interpolator.resample(m_interpolatorDistance, &m_interpolatorDistanceRemain, m_resamplerIn.data(), nbIn, m_resamplerOut);
+
+    for (auto& ci : m_resamplerOut) {
+        processOneSample(ci);
     }
 }
 
@@ -107,165 +107,239 @@ void PacketDemodSink::processOneSample(Complex &ci)
     }
     m_magsqCount++;
 
-    m_corrBuf[m_corrIdx] = fmDemod;
+    // Update sliding correlation with 1200 + 2200 Hz complex exponentials
+    Complex f1Sample = m_f1[m_f1Idx] * fmDemod;
+    Complex f0Sample = m_f0[m_f0Idx] * fmDemod;
+    m_corrF1 += std::complex<double>(f1Sample) - std::complex<double>(m_corrBufF1[m_corrIdx]);
+    m_corrF0 += std::complex<double>(f0Sample) - std::complex<double>(m_corrBufF0[m_corrIdx]);
+    m_corrBufF1[m_corrIdx] = f1Sample;
+    m_corrBufF0[m_corrIdx] = f0Sample;
+    m_f1Idx = (m_f1Idx + 1) % m_f1.size();
+    m_f0Idx = (m_f0Idx + 1) % m_f0.size();
+
     if (m_corrCnt >= m_correlationLength)
     {
-        // Correlate with 1200 + 2200 baud complex exponentials
-        Complex corrF0 = 0.0f;
-        Complex corrF1 = 0.0f;
-        for (int i = 0; i < m_correlationLength; i++)
-        {
-            int j = m_corrIdx - i;
-            if (j < 0)
-                j += m_correlationLength;
-            corrF0 += m_f0[i] * m_corrBuf[j];
-            corrF1 += m_f1[i] * m_corrBuf[j];
-        }
         m_corrCnt--; // Avoid overflow in increment below
 
         // Low pass filter, to minimize changes above the baud rate
-        Real f0Filt = m_lowpassF0.filter(std::abs(corrF0));
-        Real f1Filt = m_lowpassF1.filter(std::abs(corrF1));
+        Real f0Filt = m_lowpassF0.filter(std::abs(m_corrF0));
+        Real f1Filt = m_lowpassF1.filter(std::abs(m_corrF1));
 
-        // Determine which is the closest match and then quantise to 1 or -1
-        // FIXME: We should try to account for the fact that higher frequencies can have preemphasis
-        float diff = f1Filt - f0Filt;
-        int sample = diff >= 0.0f ? 1 : 0;
+        for (int i = 0; i < m_slicers.size(); i++) {
+            processSlicer(m_slicers[i], f0Filt, f1Filt, i == 0);
+        }
+    }
+    m_corrIdx = (m_corrIdx + 1) % m_correlationLength;
+    m_corrCnt++;
+    m_sampleCount++;
+
+    m_demodBuffer[m_demodBufferFill++] = fmDemod * std::numeric_limits<int16_t>::max();
 
-        // Look for edge
-        if (sample != m_samplePrev)
+    if (m_demodBufferFill >= m_demodBuffer.size())
+    {
+        QList<ObjectPipe*> dataPipes;
+        MainCore::instance()->getDataPipes().getDataPipes(m_channel, "demod", dataPipes);
+
+        if (dataPipes.size() > 0)
         {
-            m_syncCount = PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE/m_settings.getBaudRate()/2;
+            QList<ObjectPipe*>::iterator it = dataPipes.begin();
+
+            for (; it != dataPipes.end(); ++it)
+            {
+                DataFifo *fifo = qobject_cast<DataFifo*>((*it)->m_element);
+
+                if (fifo) {
+                    fifo->write((quint8*) &m_demodBuffer[0], m_demodBuffer.size() * sizeof(qint16), DataFifo::DataTypeI16);
+                }
+            }
         }
-        else
+
+        m_demodBufferFill = 0;
+    }
+}
+
+void PacketDemodSink::processSlicer(Slicer& slicer, Real f0Filt, Real f1Filt, bool debug)
+{
+    // Determine which is the closest match and then quantise to 1 or -1
+    // The threshold is relative to the total energy, so slicers with a non-zero
+    // threshold compensate for the tone imbalance caused by preemphasis
+    Real diff = f1Filt - f0Filt;
+    int sample = diff >= slicer.m_threshold * (f1Filt + f0Filt) ? 1 : 0;
+
+    // Look for edge
+    if (sample != slicer.m_samplePrev)
+    {
+        slicer.m_syncCount = PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE/m_settings.getBaudRate()/2 + slicer.m_timingOffset;
+    }
+    else
+    {
+        slicer.m_syncCount--;
+        if (slicer.m_syncCount <= 0)
         {
-            m_syncCount--;
-            if (m_syncCount <= 0)
+            // HDLC deframing
+
+            // Should be in the middle of the symbol
+            // NRZI decoding
+            int bit;
+            if (sample != slicer.m_symbolPrev)
+                bit = 0;
+            else
+                bit = 1;
+            slicer.m_symbolPrev = sample;
+
+            // Store in shift reg
+            slicer.m_bits |= bit << slicer.m_bitCount;
+            slicer.m_bitCount++;
+
+            if (bit == 1)
             {
-                // HDLC deframing
-
-                // Should be in the middle of the symbol
-                // NRZI decoding
-                int bit;
-                if (sample != m_symbolPrev)
-                    bit = 0;
-                else
-                    bit = 1;
-                m_symbolPrev = sample;
-
-                // Store in shift reg
-                m_bits |= bit << m_bitCount;
-                m_bitCount++;
-
-                if (bit == 1)
+                slicer.m_onesCount++;
+                // Shouldn't ever get 7 1s in a row
+                if ((slicer.m_onesCount == 7) && slicer.m_gotSOP)
                 {
-                    m_onesCount++;
-                    // Shouldn't ever get 7 1s in a row
-                    if ((m_onesCount == 7) && m_gotSOP)
-                    {
-                        m_gotSOP = false;
-                        m_byteCount = 0;
-                    }
+                    slicer.m_gotSOP = false;
+                    slicer.m_byteCount = 0;
                 }
-                else if (bit == 0)
+            }
+            else if (bit == 0)
+            {
+                if (slicer.m_onesCount == 5)
+                {
+                    // Remove bit-stuffing (5 1s followed by a 0)
+                    slicer.m_bitCount--;
+                }
+                else if (slicer.m_onesCount == 6)
                 {
-                    if (m_onesCount == 5)
+                    // Start/end of packet
+                    if ((slicer.m_bitCount == 8) && (slicer.m_bits == 0x7e) && (slicer.m_byteCount > 0))
                     {
-                        // Remove bit-stuffing (5 1s followed by a 0)
-                        m_bitCount--;
+                        // End of packet
+                        // Check CRC is valid
+                        m_crc.init();
+                        m_crc.calculate(slicer.m_bytes, slicer.m_byteCount - 2);
+                        uint16_t calcCrc = m_crc.get();
+                        uint16_t rxCrc = slicer.m_bytes[slicer.m_byteCount-2] | (slicer.m_bytes[slicer.m_byteCount-1] << 8);
+                        if (calcCrc == rxCrc)
+                            packetReceived(slicer.m_bytes, slicer.m_byteCount, rxCrc);
+                        else if (debug)
+                            qDebug() << QString("PacketDemodSink::processOneSample: CRC mismatch: %1 %2")
+                                .arg(calcCrc, 4, 16,  QLatin1Char('0'))
+                                .arg(rxCrc, 4, 16, QLatin1Char('0'));
+                        // Reset state to start receiving next packet
+                        slicer.m_gotSOP = false;
+                        slicer.m_bits = 0;
+                        slicer.m_bitCount = 0;
+                        slicer.m_byteCount = 0;
                     }
-                    else if (m_onesCount == 6)
+                    else
                     {
-                        // Start/end of packet
-                        if ((m_bitCount == 8) && (m_bits == 0x7e) && (m_byteCount > 0))
-                        {
-                            // End of packet
-                            // Check CRC is valid
-                            m_crc.init();
-                            m_crc.calculate(m_bytes, m_byteCount - 2);
-                            uint16_t calcCrc = m_crc.get();
-                            uint16_t rxCrc = m_bytes[m_byteCount-2] | (m_bytes[m_byteCount-1] << 8);
-                            if (calcCrc == rxCrc)
-                            {
-                                QByteArray rxPacket((char *)m_bytes, m_byteCount);
-                                qDebug() << "RX: " << rxPacket.toHex();
-                                if (getMessageQueueToChannel())
-                                {
-                                    MainCore::MsgPacket *msg = MainCore::MsgPacket::create(m_packetDemod, rxPacket, QDateTime::currentDateTime()); // FIXME pointer
-                                    getMessageQueueToChannel()->push(msg);
-                                }
-                            }
-                            else
-                                qDebug() << QString("PacketDemodSink::processOneSample: CRC mismatch: %1 %2")
-                                    .arg(calcCrc, 4, 16,  QLatin1Char('0'))
-                                    .arg(rxCrc, 4, 16, QLatin1Char('0'));
-                            // Reset state to start receiving next packet
-                            m_gotSOP = false;
-                            m_bits = 0;
-                            m_bitCount = 0;
-                            m_byteCount = 0;
-                        }
-                        else
-                        {
-                            // Start of packet
-                            m_gotSOP = true;
-                            m_bits = 0;
-                            m_bitCount = 0;
-                            m_byteCount = 0;
-                        }
+                        // Start of packet
+                        slicer.m_gotSOP = true;
+                        slicer.m_bits = 0;
+                        slicer.m_bitCount = 0;
+                        slicer.m_byteCount = 0;
                     }
-                    m_onesCount = 0;
                 }
+                slicer.m_onesCount = 0;
+            }
 
-                if (m_gotSOP)
+            if (slicer.m_gotSOP)
+            {
+                if (slicer.m_bitCount == 8)
                 {
-                    if (m_bitCount == 8)
+                    if (slicer.m_byteCount >= 512)
                     {
-                        if (m_byteCount >= 512)
-                        {
-                            // Too many bytes
-                            m_gotSOP = false;
-                            m_byteCount = 0;
-                        }
-                        else
-                        {
-                            m_bytes[m_byteCount] = m_bits;
-                            m_byteCount++;
-                        }
-                        m_bits = 0;
-                        m_bitCount = 0;
+                        // Too many bytes
+                        slicer.m_gotSOP = false;
+                        slicer.m_byteCount = 0;
                     }
+                    else
+                    {
+                        slicer.m_bytes[slicer.m_byteCount] = slicer.m_bits;
+                        slicer.m_byteCount++;
+                    }
+                    slicer.m_bits = 0;
+                    slicer.m_bitCount = 0;
                 }
-                m_syncCount = PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE/m_settings.getBaudRate();
             }
+            slicer.m_syncCount = PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE/m_settings.getBaudRate();
         }
-        m_samplePrev = sample;
     }
-    m_corrIdx = (m_corrIdx + 1) % m_correlationLength;
-    m_corrCnt++;
-
-    m_demodBuffer[m_demodBufferFill++] = fmDemod * std::numeric_limits<int16_t>::max();
+    slicer.m_samplePrev = sample;
+}
 
-    if (m_demodBufferFill >= m_demodBuffer.size())
+// Called when any slicer has received a packet with a valid CRC
+void PacketDemodSink::packetReceived(const unsigned char *bytes, int length, uint16_t crc)
+{
+    if (m_slicers.size() > 1)
     {
-        QList<ObjectPipe*> dataPipes;
-        MainCore::instance()->getDataPipes().getDataPipes(m_channel, "demod", dataPipes);
+        // Other slicers will typically decode the same packet within a few symbols
+        const qint64 duplicateWindow = 16 * PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE/m_settings.getBaudRate();
 
-        if (dataPipes.size() > 0)
+        for (int i = m_recentPackets.size() - 1; i >= 0; i--)
         {
-            QList<ObjectPipe*>::iterator it = dataPipes.begin();
+            if (m_sampleCount - m_recentPackets[i].m_sampleCount > duplicateWindow) {
+                m_recentPackets.remove(i);
+            } else if ((m_recentPackets[i].m_crc == crc) && (m_recentPackets[i].m_length == length)) {
+                return;
+            }
+        }
 
-            for (; it != dataPipes.end(); ++it)
-            {
-                DataFifo *fifo = qobject_cast<DataFifo*>((*it)->m_element);
+        m_recentPackets.append(RecentPacket{crc, length, m_sampleCount});
+    }
 
-                if (fifo) {
-                    fifo->write((quint8*) &m_demodBuffer[0], m_demodBuffer.size() * sizeof(qint16), DataFifo::DataTypeI16);
+    QByteArray rxPacket((char *)bytes, length);
+    qDebug() << "RX: " << rxPacket.toHex();
+    if (getMessageQueueToChannel())
+    {
+        MainCore::MsgPacket *msg = MainCore::MsgPacket::create(m_packetDemod, rxPacket, QDateTime::currentDateTime()); // FIXME pointer
+        getMessageQueueToChannel()->push(msg);
+    }
+}
+
+void PacketDemodSink::Slicer::init(Real threshold, int timingOffset)
+{
+    m_threshold = threshold;
+    m_timingOffset = timingOffset;
+    m_samplePrev = 0;
+    m_syncCount = 0;
+    m_symbolPrev = 0;
+    m_bits = 0;
+    m_bitCount = 0;
+    m_onesCount = 0;
+    m_gotSOP = false;
+    m_byteCount = 0;
+}
+
+void PacketDemodSink::createSlicers(bool multiSlicer, int baudRate)
+{
+    m_slicers.resize(0);
+    m_recentPackets.resize(0);
+    Slicer slicer;
+
+    // First slicer is always the nominal one
+    slicer.init(0.0f, 0);
+    m_slicers.append(slicer);
+
+    if (multiSlicer)
+    {
+        // Thresholds to compensate for pre-emphasis / de-emphasis twist between tones
+        // and offsets of 1/8 of a symbol to compensate for timing jitter
+        const Real thresholds[] = {0.0f, -0.15f, 0.15f};
+        int offset = PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE/baudRate/8;
+        const int offsets[] = {0, -offset, offset};
+
+        for (auto threshold : thresholds)
+        {
+            for (auto timingOffset : offsets)
+            {
+                if ((threshold != 0.0f) || (timingOffset != 0))
+                {
+                    slicer.init(threshold, timingOffset);
+                    m_slicers.append(slicer);
                 }
             }
         }
-
-        m_demodBufferFill = 0;
     }
 }
 
@@ -311,35 +385,35 @@ void PacketDemodSink::applySettings(const PacketDemodSettings& settings, bool fo
 
     if (force)
     {
-        delete[] m_f1;
-        delete[] m_f0;
-        delete[] m_corrBuf;
-        m_correlationLength = PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE/settings.getBaudRate();
-        m_f1 = new Complex[m_correlationLength]();
-        m_f0 = new Complex[m_correlationLength]();
-        m_corrBuf = new Complex[m_correlationLength]();
+        int sampleRate = PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE;
+        m_correlationLength = sampleRate/settings.getBaudRate();
+        // Reference oscillators, over a whole number of cycles, so phase is continuous when wrapping
+        int f1Period = sampleRate / gcd(sampleRate, 1200);
+        int f0Period = sampleRate / gcd(sampleRate, 2200);
+        m_f1.resize(f1Period);
+        m_f0.resize(f0Period);
+        for (int i = 0; i < f1Period; i++) {
+            m_f1[i] = Complex(cos(2.0*M_PI*1200.0*i/sampleRate), -sin(2.0*M_PI*1200.0*i/sampleRate));
+        }
+        for (int i = 0; i < f0Period; i++) {
+            m_f0[i] = Complex(cos(2.0*M_PI*2200.0*i/sampleRate), -sin(2.0*M_PI*2200.0*i/sampleRate));
+        }
+        m_f1Idx = 0;
+        m_f0Idx = 0;
+        m_corrBufF1.fill(Complex(0.0f, 0.0f), m_correlationLength);
+        m_corrBufF0.fill(Complex(0.0f, 0.0f), m_correlationLength);
+        m_corrF1 = 0.0;
+        m_corrF0 = 0.0;
         m_corrIdx = 0;
         m_corrCnt = 0;
-        Real f0 = 0.0f;
-        Real f1 = 0.0f;
-        for (int i = 0; i < m_correlationLength; i++)
-        {
-            m_f0[i] = Complex(cos(f0), sin(f0));
-            m_f1[i] = Complex(cos(f1), sin(f1));
-            f0 += 2.0f*(Real)M_PI*2200.0f/PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE;
-            f1 += 2.0f*(Real)M_PI*1200.0f/PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE;
-        }
 
-        m_lowpassF1.create(301, PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE, settings.getBaudRate() * 1.1f);
-        m_lowpassF0.create(301, PacketDemodSettings::PACKETDEMOD_CHANNEL_SAMPLE_RATE, settings.getBaudRate() * 1.1f);
-        m_samplePrev = 0;
-        m_syncCount = 0;
-        m_symbolPrev = 0;
-        m_bits = 0;
-        m_bitCount = 0;
-        m_onesCount = 0;
-        m_gotSOP = false;
-        m_byteCount = 0;
+        m_lowpassF1.create(301, sampleRate, settings.getBaudRate() * 1.1f);
+        m_lowpassF0.create(301, sampleRate, settings.getBaudRate() * 1.1f);
+    }
+
+    if ((settings.m_multiSlicer != m_settings.m_multiSlicer) || force)
+    {
+        createSlicers(settings.m_multiSlicer, settings.getBaudRate());
     }
 
     m_settings = settings;
@@ -24,7 +24,7 @@
 #include "dsp/channelsamplesink.h"
 #include "dsp/phasediscri.h"
 #include "dsp/nco.h"
-#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
 #include "dsp/firfilter.h"
 #include "util/movingaverage.h"
 #include "util/doublebufferfifo.h"
@@ -34,6 +34,7 @@
 #include "packetdemodsettings.h"
 
 #include <vector>
+#include <complex>
 #include <iostream>
 #include <fstream>
 
@@ -91,9 +92,11 @@ private:
     int m_channelFrequencyOffset;
 
     NCO m_nco;
-    Interpolator m_interpolator;
+    PolyphaseResampler m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
+    std::vector<Complex> m_resamplerIn;
+    std::vector<Complex> m_resamplerOut;
 
     double m_magsq;
     double m_magsqSum;
@@ -108,31 +111,59 @@ private:
     Lowpass<Complex> m_lowpass;
     PhaseDiscriminators m_phaseDiscri;
 
+    // Sliding correlator with 1200 + 2200 Hz complex exponentials.
+    // Samples are rotated by a fixed reference oscillator, so the correlation is
+    // a moving sum and can be updated in O(1) per sample
     int m_correlationLength;
-    Complex *m_f1;
-    Complex *m_f0;
-    Complex *m_corrBuf;
+    QVector<Complex> m_f1;      //!< One period of the 1200Hz reference (e^-jwn)
+    QVector<Complex> m_f0;      //!< One period of the 2200Hz reference
+    int m_f1Idx;
+    int m_f0Idx;
+    QVector<Complex> m_corrBufF1; //!< Rotated samples in correlation window
+    QVector<Complex> m_corrBufF0;
+    std::complex<double> m_corrF1;
+    std::complex<double> m_corrF0;
     int m_corrIdx;
     int m_corrCnt;
 
     Lowpass<Real> m_lowpassF1;
     Lowpass<Real> m_lowpassF0;
 
-    int m_samplePrev;
-    int m_syncCount;
-    int m_symbolPrev;
-    unsigned char m_bits;
-    int m_bitCount;
-    int m_onesCount;
-    bool m_gotSOP;
-    unsigned char m_bytes[512]; // Info field can be 256 bytes
-    int m_byteCount;
+    // Bit slicer and HDLC deframer. Several can be run in parallel with
+    // different decision thresholds and timing offsets
+    struct Slicer {
+        Real m_threshold;       //!< Decision threshold relative to sum of mark and space magnitudes
+        int m_timingOffset;     //!< Offset in samples from middle of symbol where bit is sampled
+        int m_samplePrev;
+        int m_syncCount;
+        int m_symbolPrev;
+        unsigned char m_bits;
+        int m_bitCount;
+        int m_onesCount;
+        bool m_gotSOP;
+        unsigned char m_bytes[512]; // Info field can be 256 bytes
+        int m_byteCount;
+
+        void init(Real threshold, int timingOffset);
+    };
+
+    QVector<Slicer> m_slicers;
     crc16x25 m_crc;
+    qint64 m_sampleCount;       //!< Used to time-out duplicate packets
+    struct RecentPacket {
+        uint16_t m_crc;
+        int m_length;
+        qint64 m_sampleCount;
+    };
+    QVector<RecentPacket> m_recentPackets; //!< Packets recently decoded by any slicer
 
     QVector<qint16> m_demodBuffer;
     int m_demodBufferFill;
 
     void processOneSample(Complex &ci);
+    void processSlicer(Slicer& slicer, Real f0Filt, Real f1Filt, bool debug);
+    void packetReceived(const unsigned char *bytes, int length, uint16_t crc);
+    void createSlicers(bool multiSlicer, int baudRate);
     MessageQueue *getMessageQueueToChannel() { return m_messageQueueToChannel; }
 };
 
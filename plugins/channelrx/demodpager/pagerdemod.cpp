@@ -113,7 +113,7 @@ uint32_t PagerDemod::getNumberOfDeviceStreams() const
 void PagerDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
 {
     (void) firstOfBurst;
-    m_basebandSink->feed(begin, end);
+    m_basebandSink->feed(begin, end, m_timestamp);
 }
 
 void PagerDemod::start()
@@ -189,16 +189,16 @@ bool PagerDemod::handleMessage(const Message& cmd)
         }
 
         // Write to log file
-        if (m_logFile.isOpen())
+        if (m_logWriter.isOpen())
         {
-            m_logStream << report.getDateTime().date().toString() << ","
-                << report.getDateTime().time().toString() << ","
-                << QString("%1").arg(report.getAddress(), 7, 10, QChar('0')) << ","
-                << QString::number(report.getFunctionBits()) << ","
-                << "\"" << report.getAlphaMessage() << "\","
-                << report.getNumericMessage() << ","
-                << QString::number(report.getEvenParityErrors()) << ","
-                << QString::number(report.getBCHParityErrors()) << "\n";
+            m_logWriter.write(report.getDateTime(), {
+                QString("%1").arg(report.getAddress(), 7, 10, QChar('0')),
+                QString::number(report.getFunctionBits()),
+                report.getAlphaMessage(),
+                report.getNumericMessage(),
+                QString::number(report.getEvenParityErrors()),
+                QString::number(report.getBCHParityErrors())
+            });
         }
 
         return true;
@@ -312,24 +312,13 @@ void PagerDemod::applySettings(const PagerDemodSettings& settings, bool force)
         || (settings.m_logFilename != m_settings.m_logFilename)
         || force)
     {
-        if (m_logFile.isOpen())
-        {
-            m_logStream.flush();
-            m_logFile.close();
-        }
+        m_logWriter.close();
+
         if (settings.m_logEnabled && !settings.m_logFilename.isEmpty())
         {
-            m_logFile.setFileName(settings.m_logFilename);
-            if (m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+            if (m_logWriter.open(settings.m_logFilename, QStringList{"Date", "Time", "Address", "Function Bits", "Alpha", "Numeric", "Even Parity Errors", "BCH Parity Errors"}))
             {
                 qDebug() << "PagerDemod::applySettings - Logging to: " << settings.m_logFilename;
-                bool newFile = m_logFile.size() == 0;
-                m_logStream.setDevice(&m_logFile);
-                if (newFile)
-                {
-                    // Write header
-                    m_logStream << "Date,Time,Address,Function Bits,Alpha,Numeric,Even Parity Errors,BCH Parity Errors\n";
-                }
             }
             else
             {
@@ -25,12 +25,11 @@
 #include <QUdpSocket>
 #include <QThread>
 #include <QDateTime>
-#include <QFile>
-#include <QTextStream>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
 #include "util/message.h"
+#include "util/logwriter.h"
 
 #include "pagerdemodbaseband.h"
 #include "pagerdemodsettings.h"
@@ -97,6 +96,27 @@ public:
             );
         }
 
+        static MsgPagerMessage* create(
+            int address,
+            int functionBits,
+            const QString& alphaMessage,
+            const QString& numericMessage,
+            int evenParityErrors,
+            int bchParityErrors,
+            QDateTime dateTime
+        )
+        {
+            return new MsgPagerMessage(
+                address,
+                functionBits,
+                alphaMessage,
+                numericMessage,
+                evenParityErrors,
+                bchParityErrors,
+                dateTime
+            );
+        }
+
     private:
         int m_address;
         int m_functionBits;
@@ -127,6 +147,7 @@ public:
 
     using BasebandSampleSink::feed;
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool po);
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { m_timestamp = timestamp; }
     virtual void start();
     virtual void stop();
     virtual void pushMessage(Message *msg) { m_inputMessageQueue.push(msg); }
@@ -199,12 +220,12 @@ private:
     DeviceAPI *m_deviceAPI;
     QThread m_thread;
     PagerDemodBaseband* m_basebandSink;
+    SampleTimestamp m_timestamp; //!< Timestamp of next block fed
     PagerDemodSettings m_settings;
     int m_basebandSampleRate; //!< stored from device message used when starting baseband sink
     qint64 m_centerFrequency;
     QUdpSocket m_udpSocket;
-    QFile m_logFile;
-    QTextStream m_logStream;
+    LogWriter m_logWriter;
 
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
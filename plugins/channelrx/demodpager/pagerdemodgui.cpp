@@ -24,6 +24,8 @@
 #include <QRegExp>
 #include <QClipboard>
 #include <QFileDialog>
+#include <QFile>
+#include <QTextStream>
 #include <QMessageBox>
 #include <QScrollBar>
 
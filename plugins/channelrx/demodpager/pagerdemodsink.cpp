@@ -35,6 +35,7 @@ PagerDemodSink::PagerDemodSink(PagerDemod *pagerDemod) :
         m_pagerDemod(pagerDemod),
         m_channelSampleRate(PagerDemodSettings::m_channelSampleRate),
         m_channelFrequencyOffset(0),
+        m_samplesSinceTimestamp(0),
         m_magsqSum(0.0f),
         m_magsqPeak(0.0f),
         m_magsqCount(0),
@@ -84,29 +85,24 @@ void PagerDemodSink::sampleToScope(Complex sample)
 
 void PagerDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-    Complex ci;
+    unsigned int nbIn = end - begin;
+    m_resamplerIn.resize(nbIn);
 
-    for (SampleVector::const_iterator it = begin; it != end; ++it)
+    for (unsigned int i = 0; i < nbIn; i++)
     {
-        Complex c(it->real(), it->imag());
-        c *= m_nco.nextIQ();
+        Complex c(begin[i].real(), begin[i].imag());
+        m_resamplerIn[i] = c * m_nco.nextIQ();
+    }
 
-        if (m_interpolatorDistance < 1.0f) // interpolate
-        {
-            while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
-        else // decimate
-        {
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
+    // Interpolates or decimates the whole block
+    m_resamplerOut.clear();
+    m_interpolator.resample(m_interpolatorDistance, &m_interpolatorDistanceRemain, m_resamplerIn.data(), nbIn, m_resamplerOut);
+    m_samplesSinceTimestamp = 0;
+
+    for (auto& ci : m_resamplerOut)
+    {
+        processOneSample(ci);
+        m_samplesSinceTimestamp++;
     }
 }
 
@@ -288,7 +284,10 @@ void PagerDemodSink::decodeBatch()
                         std::reverse(m_alphaMessage.begin(), m_alphaMessage.end());
                     }
                     // Send to channel and GUI
-                    PagerDemod::MsgPagerMessage *msg = PagerDemod::MsgPagerMessage::create(m_address, m_functionBits, m_alphaMessage, m_numericMessage, m_parityErrors, m_bchErrors);
+                    QDateTime dateTime = m_timestamp.isValid()
+                        ? m_timestamp.getDateTime(m_samplesSinceTimestamp, PagerDemodSettings::m_channelSampleRate)
+                        : QDateTime::currentDateTime();
+                    PagerDemod::MsgPagerMessage *msg = PagerDemod::MsgPagerMessage::create(m_address, m_functionBits, m_alphaMessage, m_numericMessage, m_parityErrors, m_bchErrors, dateTime);
                     getMessageQueueToChannel()->push(msg);
                 }
                 m_addressValid = false;
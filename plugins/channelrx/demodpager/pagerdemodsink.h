@@ -24,7 +24,7 @@
 #include "dsp/channelsamplesink.h"
 #include "dsp/phasediscri.h"
 #include "dsp/nco.h"
-#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
 #include "dsp/firfilter.h"
 #include "util/movingaverage.h"
 #include "util/messagequeue.h"
@@ -48,6 +48,7 @@ public:
     ~PagerDemodSink();
 
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { m_timestamp = timestamp; }
 
     void setScopeSink(ScopeVis* scopeSink) { m_scopeSink = scopeSink; }
     void applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force = false);
@@ -95,9 +96,13 @@ private:
     int m_samplesPerSymbol;             // Number of samples per symbol
 
     NCO m_nco;
-    Interpolator m_interpolator;
+    PolyphaseResampler m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
+    std::vector<Complex> m_resamplerIn;
+    std::vector<Complex> m_resamplerOut;
+    SampleTimestamp m_timestamp;        // Timestamp of first sample of the block being fed
+    qint64 m_samplesSinceTimestamp;     // Samples processed since m_timestamp at channel sample rate
 
     double m_magsq;
     double m_magsqSum;
@@ -214,42 +214,41 @@ bool RadiosondeDemod::handleMessage(const Message& cmd)
         }
 
         // Write to log file
-        if (m_logFile.isOpen())
+        if (m_logWriter.isOpen())
         {
-
-            m_logStream << report.getDateTime().date().toString() << ","
-                << report.getDateTime().time().toString() << ","
-                << report.getMessage().toHex() << ",";
+            QStringList fields;
+            fields.append(QString(report.getMessage().toHex()));
 
             if (frame->m_statusValid)
             {
-                m_logStream << frame->m_serial << ","
-                            << frame->m_frameNumber << ",";
+                fields.append(frame->m_serial);
+                fields.append(QString::number(frame->m_frameNumber));
             }
             else
             {
-                m_logStream << ",,";
+                fields << "" << "";
             }
             if (frame->m_posValid)
             {
-                m_logStream << frame->m_latitude << ","
-                            << frame->m_longitude << ",";
+                fields.append(QString::number(frame->m_latitude));
+                fields.append(QString::number(frame->m_longitude));
             }
             else
             {
-                m_logStream << ",,";
+                fields << "" << "";
             }
             if (frame->m_measValid)
             {
-                m_logStream << frame->getPressureString(subframe) << ","
-                            << frame->getTemperatureString(subframe) << ","
-                            << frame->getHumidityString(subframe) << ",";
+                fields.append(frame->getPressureString(subframe));
+                fields.append(frame->getTemperatureString(subframe));
+                fields.append(frame->getHumidityString(subframe));
             }
             else
             {
-                m_logStream << ",,,";
+                fields << "" << "" << "";
             }
-            m_logStream << "\n";
+
+            m_logWriter.write(report.getDateTime(), fields);
         }
 
         delete frame;
@@ -362,24 +361,13 @@ void RadiosondeDemod::applySettings(const RadiosondeDemodSettings& settings, boo
         || (settings.m_logFilename != m_settings.m_logFilename)
         || force)
     {
-        if (m_logFile.isOpen())
-        {
-            m_logStream.flush();
-            m_logFile.close();
-        }
+        m_logWriter.close();
+
         if (settings.m_logEnabled && !settings.m_logFilename.isEmpty())
         {
-            m_logFile.setFileName(settings.m_logFilename);
-            if (m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+            if (m_logWriter.open(settings.m_logFilename, QStringList{"Date", "Time", "Data", "Serial", "Frame", "Lat", "Lon", "P (hPa)", "T (C)", "U (%)"}))
             {
                 qDebug() << "RadiosondeDemod::applySettings - Logging to: " << settings.m_logFilename;
-                bool newFile = m_logFile.size() == 0;
-                m_logStream.setDevice(&m_logFile);
-                if (newFile)
-                {
-                    // Write header
-                    m_logStream << "Date,Time,Data,Serial,Frame,Lat,Lon,P (hPa),T (C), U (%)\n";
-                }
             }
             else
             {
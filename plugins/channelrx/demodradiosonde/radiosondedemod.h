@@ -25,13 +25,12 @@
 #include <QUdpSocket>
 #include <QThread>
 #include <QDateTime>
-#include <QFile>
-#include <QTextStream>
 #include <QVector3D>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
 #include "util/message.h"
+#include "util/logwriter.h"
 #include "util/radiosonde.h"
 
 #include "radiosondedemodbaseband.h"
@@ -175,8 +174,7 @@ private:
     int m_basebandSampleRate; //!< stored from device message used when starting baseband sink
     qint64 m_centerFrequency;
     QUdpSocket m_udpSocket;
-    QFile m_logFile;
-    QTextStream m_logStream;
+    LogWriter m_logWriter;
 
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
@@ -23,6 +23,8 @@
 #include <QRegExp>
 #include <QClipboard>
 #include <QFileDialog>
+#include <QFile>
+#include <QTextStream>
 #include <QScrollBar>
 
 #include "radiosondedemodgui.h"
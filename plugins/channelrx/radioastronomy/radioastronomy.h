@@ -101,21 +101,27 @@ public:
         Real *getFFT() const { return m_fft; }
         int getSize() const { return m_size; }
         QDateTime getDateTime() const { return m_dateTime; }
+        qint64 getSamplesIntegrated() const { return m_samplesIntegrated; }
+        qint64 getSamplesReceived() const { return m_samplesReceived; }
 
-        static MsgFFTMeasurement* create(const Real *fft, int size, QDateTime dateTime)
+        static MsgFFTMeasurement* create(const Real *fft, int size, QDateTime dateTime, qint64 samplesIntegrated = 0, qint64 samplesReceived = 0)
         {
-            return new MsgFFTMeasurement(fft, size, dateTime);
+            return new MsgFFTMeasurement(fft, size, dateTime, samplesIntegrated, samplesReceived);
         }
 
     private:
         Real *m_fft;
         int m_size;
         QDateTime m_dateTime;
+        qint64 m_samplesIntegrated; //!< Samples used in the FFTs of the measurement
+        qint64 m_samplesReceived;   //!< Samples received, including those dropped, during the measurement
 
-        MsgFFTMeasurement(const Real *fft, int size, QDateTime dateTime) :
+        MsgFFTMeasurement(const Real *fft, int size, QDateTime dateTime, qint64 samplesIntegrated, qint64 samplesReceived) :
             Message(),
             m_size(size),
-            m_dateTime(dateTime)
+            m_dateTime(dateTime),
+            m_samplesIntegrated(samplesIntegrated),
+            m_samplesReceived(samplesReceived)
         {
             // Take a copy of the data
             m_fft = new Real[size];
@@ -62,6 +62,13 @@ void RadioAstronomyBaseband::startWork()
         &RadioAstronomyBaseband::handleData,
         Qt::QueuedConnection
     );
+    QObject::connect(
+        &m_sampleFifo,
+        &SampleSinkFifo::overflow,
+        this,
+        &RadioAstronomyBaseband::handleOverflow,
+        Qt::DirectConnection
+    );
     connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
     m_running = true;
 }
@@ -76,6 +83,12 @@ void RadioAstronomyBaseband::stopWork()
         this,
         &RadioAstronomyBaseband::handleData
     );
+    QObject::disconnect(
+        &m_sampleFifo,
+        &SampleSinkFifo::overflow,
+        this,
+        &RadioAstronomyBaseband::handleOverflow
+    );
     m_running = false;
 }
 
@@ -116,6 +129,16 @@ void RadioAstronomyBaseband::handleData()
     }
 }
 
+void RadioAstronomyBaseband::handleOverflow(int nbSamples)
+{
+    // Called in the thread writing to the FIFO. Convert to channel sample rate.
+    int basebandSampleRate = m_channelizer->getBasebandSampleRate();
+
+    if (basebandSampleRate > 0) {
+        m_sink.addDroppedSamples(((qint64) nbSamples * m_settings.m_sampleRate) / basebandSampleRate);
+    }
+}
+
 void RadioAstronomyBaseband::handleInputMessages()
 {
     Message* message;
@@ -93,6 +93,7 @@ private:
 private slots:
     void handleInputMessages();
     void handleData(); //!< Handle data when samples have to be processed
+    void handleOverflow(int nbSamples); //!< Account for samples dropped by the FIFO
 };
 
 #endif // INCLUDE_RADIOASTRONOMYBASEBAND_H
@@ -44,6 +44,7 @@
 #include "util/astronomy.h"
 #include "util/interpolation.h"
 #include "util/png.h"
+#include "util/fits.h"
 #include "util/units.h"
 #include "gui/basicchannelsettingsdialog.h"
 #include "gui/devicestreamselectiondialog.h"
@@ -413,7 +414,7 @@ void RadioAstronomyGUI::calcPowerPeakDelta()
 
 void RadioAstronomyGUI::addToPowerSeries(FFTMeasurement *fft, bool skipCalcs)
 {
-    if (   ((m_settings.m_powerYUnits == RadioAstronomySettings::PY_DBFS) || fft->m_temp)                 // Only dBFS valid if no temp was calculated
+    if (   ((m_settings.m_powerYUnits == RadioAstronomySettings::PY_DBFS) || fft->hasTemp())              // Only dBFS valid if no temp was calculated
         && !((m_settings.m_powerYUnits == RadioAstronomySettings::PY_DBM) && (fft->m_tSys == 0.0f))  // dBm value not valid if temp is 0
        )
     {
@@ -716,7 +717,7 @@ void RadioAstronomyGUI::powerMeasurementReceived(FFTMeasurement *fft, bool skipC
     if (fft->m_tSys != 0.0f) {
         powerdBmItem->setData(Qt::DisplayRole, fft->m_totalPowerdBm);
     }
-    if (fft->m_temp) {
+    if (fft->hasTemp()) {
         updatePowerColumns(row, fft);
     }
     if (fft->m_coordsValid)
@@ -1294,6 +1295,7 @@ void RadioAstronomyGUI::clearData()
 
     qDeleteAll(m_fftMeasurements);
     m_fftMeasurements.clear();
+    m_store.clear();
     m_fftSeries->clear();
     m_fftPeakSeries->clear();
     m_fftMarkerSeries->clear();
@@ -1333,6 +1335,10 @@ void RadioAstronomyGUI::clearCalData()
     m_calHot = nullptr;
     m_calCold = nullptr;
     m_calG = nullptr;
+    m_calibration.reset();
+    m_mergedCalibration.reset();
+    m_mergedCalibrationCurrent.reset();
+    m_mergedCalibrationPrevious.reset();
     m_calHotSeries->clear();
     m_calColdSeries->clear();
     ui->calAvgDiff->setText("");
@@ -1372,7 +1378,7 @@ void RadioAstronomyGUI::calcCalAvgDiff()
     {
         Real sum = 0.0f;
         for (int i = 0; i < m_calHot->m_fftSize; i++) {
-            sum += CalcDb::dbPower(m_calHot->m_fftData[i]) - CalcDb::dbPower(m_calCold->m_fftData[i]);
+            sum += CalcDb::dbPower(m_calHot->fftData()[i]) - CalcDb::dbPower(m_calCold->fftData()[i]);
         }
         Real avg = sum / m_calHot->m_fftSize;
         ui->calAvgDiff->setText(QString::number(avg, 'f', 1));
@@ -1389,10 +1395,11 @@ void RadioAstronomyGUI::calcCalibrationScaleFactors()
     {
         delete[] m_calG;
         m_calG = new double[m_calHot->m_fftSize];
+        m_calibration.reset();
         // Calculate scaling factors from FFT mag to temperature
         // FIXME: This assumes cal hot is fixed reference temp - E.g. 50Ohm term
         for (int i = 0; i < m_calHot->m_fftSize; i++) {
-            m_calG[i] = (m_settings.m_tCalHot + m_settings.m_tempRX) / m_calHot->m_fftData[i];
+            m_calG[i] = (m_settings.m_tCalHot + m_settings.m_tempRX) / m_calHot->fftData()[i];
         }
     }
 }
@@ -1426,7 +1433,7 @@ void RadioAstronomyGUI::recalibrate()
         if (fft->m_tSys != 0.0f) {
             ui->powerTable->item(i, POWER_COL_POWER_DBM)->setData(Qt::DisplayRole, fft->m_totalPowerdBm);
         }
-        if (fft->m_temp) {
+        if (fft->hasTemp()) {
             updatePowerColumns(i, fft);
         }
     }
@@ -1445,8 +1452,8 @@ void RadioAstronomyGUI::calcCalTrx()
         double sumC = 0.0;
         for (int i = 0; i < m_calHot->m_fftSize; i++)
         {
-            sumH += m_calHot->m_fftData[i];
-            sumC += m_calCold->m_fftData[i];
+            sumH += m_calHot->fftData()[i];
+            sumC += m_calCold->fftData()[i];
         }
         double y = sumH/sumC;
         // Use y to calculate Trx, which should be the same for both calibration points
@@ -1626,24 +1633,28 @@ void RadioAstronomyGUI::saveFFT(QTextStream& out, const FFTMeasurement* fft)
     out << ",";
     out << fft->m_fftSize;
     out << ",";
+    const Real *fftData = fft->fftData();
     for (int j = 0; j < fft->m_fftSize; j++)
     {
-        out << fft->m_fftData[j];
+        out << fftData[j];
         out << ",";
     }
-    if (fft->m_snr)
+    std::vector<Real> spectrum(fft->m_fftSize);
+    if (fft->hasSNR())
     {
+        fft->getSNR(spectrum.data());
         for (int j = 0; j < fft->m_fftSize; j++)
         {
-            out << fft->m_snr[j];
+            out << spectrum[j];
             out << ",";
         }
     }
-    if (fft->m_temp)
+    if (fft->hasTemp())
     {
+        fft->getTemp(spectrum.data());
         for (int j = 0; j < fft->m_fftSize; j++)
         {
-            out << fft->m_temp[j];
+            out << spectrum[j];
             out << ",";
         }
     }
@@ -1668,11 +1679,8 @@ RadioAstronomyGUI::FFTMeasurement* RadioAstronomyGUI::loadFFT(QHash<QString,int>
 
         fft->m_fftSize = fftSize;
         fft->m_fftData = new Real[fftSize];
-        fft->m_db = new Real[fftSize];
-        for (int i = 0; i < fftSize; i++)
-        {
+        for (int i = 0; i < fftSize; i++) {
             fft->m_fftData[i] = cols[fftDataIdx+i].toFloat();
-            fft->m_db[i] = (Real)CalcDb::dbPower(fft->m_fftData[i]);
         }
         if (cols.size() >= fftDataIdx + 2*fftSize)
         {
@@ -1734,16 +1742,72 @@ RadioAstronomyGUI::FFTMeasurement* RadioAstronomyGUI::loadFFT(QHash<QString,int>
     }
 }
 
+// Write spectra to a FITS file, as an image with one row per measurement
+// Spectra are read one at a time from the measurement store
+void RadioAstronomyGUI::saveFITS(const QString& filename)
+{
+    if (m_fftMeasurements.size() == 0) {
+        return;
+    }
+
+    // Only measurements with the same FFT size as the first can be included in the image
+    const FFTMeasurement *first = m_fftMeasurements[0];
+    int rows = 0;
+    for (const auto fft : m_fftMeasurements)
+    {
+        if (fft->m_fftSize == first->m_fftSize) {
+            rows++;
+        }
+    }
+    if (rows != m_fftMeasurements.size()) {
+        qWarning() << "RadioAstronomyGUI::saveFITS: Skipping" << (m_fftMeasurements.size() - rows) << "measurements with different FFT size";
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        QMessageBox::critical(this, "Radio Astronomy", QString("Failed to open file %1").arg(filename));
+        return;
+    }
+
+    FITSWriter fits(&file);
+    fits.addKeyword("CTYPE1", "FREQ", true);
+    fits.addKeyword("CUNIT1", "Hz", true);
+    fits.addKeyword("CRPIX1", 1.0);
+    fits.addKeyword("CRVAL1", first->m_centerFrequency - first->m_sampleRate / 2.0);
+    fits.addKeyword("CDELT1", first->m_sampleRate / (double)first->m_fftSize);
+    fits.addKeyword("CTYPE2", "TIME", true);
+    fits.addKeyword("DATE-OBS", first->m_dateTime.toUTC().toString(Qt::ISODate), true);
+    fits.addKeyword("ORIGIN", "SDRangel", true);
+    bool ok = fits.writeHeader(first->m_fftSize, rows);
+
+    for (int i = 0; ok && (i < m_fftMeasurements.size()); i++)
+    {
+        if (m_fftMeasurements[i]->m_fftSize == first->m_fftSize) {
+            ok = fits.writeRow(m_fftMeasurements[i]->fftData());
+        }
+    }
+
+    if (!ok || !fits.finish()) {
+        QMessageBox::critical(this, "Radio Astronomy", QString("Failed to write file %1").arg(filename));
+    }
+}
+
 void RadioAstronomyGUI::on_saveSpectrumData_clicked()
 {
     // Get filename to save to
-    QFileDialog fileDialog(nullptr, "Select file to save data to", "", "*.csv");
+    QFileDialog fileDialog(nullptr, "Select file to save data to", "", "*.csv;;*.fits");
     fileDialog.setAcceptMode(QFileDialog::AcceptSave);
     if (fileDialog.exec())
     {
         QStringList fileNames = fileDialog.selectedFiles();
         if (fileNames.size() > 0)
         {
+            if (fileNames[0].endsWith(".fits", Qt::CaseInsensitive) && (ui->spectrumChartSelect->currentIndex() == 0))
+            {
+                saveFITS(fileNames[0]);
+                return;
+            }
             QFile file(fileNames[0]);
             if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
                 QMessageBox::critical(this, "Radio Astronomy", QString("Failed to open file %1").arg(fileNames[0]));
@@ -1880,6 +1944,7 @@ void RadioAstronomyGUI::on_loadSpectrumData_clicked()
                             {
                                 delete *calp;
                                 *calp = cal;
+                                m_calibration.reset();
                                 qDebug() << "RadioAstronomyGUI::on_loadSpectrumData_clicked: Loaded calibration " << calName;
                                 if (calName == "Cold") {
                                     ui->calTsky->setText(QString::number(cal->m_skyTemp, 'f', 1));
@@ -2391,6 +2456,8 @@ void RadioAstronomyGUI::displaySettings()
     ui->integration->setValue(m_settings.m_integration);
     ui->fftSize->setCurrentIndex(fftSizeToIndex(m_settings.m_fftSize));
     ui->fftWindow->setCurrentIndex((int)m_settings.m_fftWindow);
+    ui->pfbTaps->setValue(m_settings.m_pfbTaps);
+    ui->integrationThreads->setValue(m_settings.m_integrationThreads);
     ui->filterFreqs->setText(m_settings.m_filterFreqs);
 
     int idx = ui->starTracker->findText(m_settings.m_starTracker);
@@ -2647,6 +2714,18 @@ void RadioAstronomyGUI::on_fftWindow_currentIndexChanged(int index)
     applySettings();
 }
 
+void RadioAstronomyGUI::on_pfbTaps_valueChanged(int value)
+{
+    m_settings.m_pfbTaps = value;
+    applySettings();
+}
+
+void RadioAstronomyGUI::on_integrationThreads_valueChanged(int value)
+{
+    m_settings.m_integrationThreads = value;
+    applySettings();
+}
+
 void RadioAstronomyGUI::on_filterFreqs_editingFinished()
 {
     m_settings.m_filterFreqs = ui->filterFreqs->text();
@@ -3668,6 +3747,7 @@ void RadioAstronomyGUI::calCompletetReceived(const RadioAstronomy::MsgCalComplet
     {
         delete m_calCold;
         m_calCold = fft;
+        m_calibration.reset();
         ui->startCalCold->setStyleSheet("QToolButton { background: none; }");
     }
     fft->m_fftData = data;
@@ -3752,14 +3832,14 @@ void RadioAstronomyGUI::plotCalMeasurements()
 
             if (hotValid)
             {
-                value = CalcDb::dbPower(m_calHot->m_fftData[i]);
+                value = CalcDb::dbPower(m_calHot->fftData()[i]);
                 m_calHotSeries->append(freq / 1e6, value);
                 minVal = std::min(minVal, value);
                 maxVal = std::max(maxVal, value);
             }
             if (coldValid)
             {
-                value = CalcDb::dbPower(m_calCold->m_fftData[i]);
+                value = CalcDb::dbPower(m_calCold->fftData()[i]);
                 m_calColdSeries->append(freq / 1e6, value);
                 minVal = std::min(minVal, value);
                 maxVal = std::max(maxVal, value);
@@ -4091,10 +4171,10 @@ void RadioAstronomyGUI::plotFFTMeasurement(int index)
             plotLAB(fft->m_l, fft->m_b, m_beamWidth);
         }
 
-        if (   ((m_settings.m_spectrumYScale == RadioAstronomySettings::SY_SNR) && !fft->m_snr)
-            || ((m_settings.m_spectrumYScale == RadioAstronomySettings::SY_DBM) && !fft->m_temp)
-            || ((m_settings.m_spectrumYScale == RadioAstronomySettings::SY_TSYS) && !fft->m_temp)
-            || ((m_settings.m_spectrumYScale == RadioAstronomySettings::SY_TSOURCE) && !fft->m_temp)
+        if (   ((m_settings.m_spectrumYScale == RadioAstronomySettings::SY_SNR) && !fft->hasSNR())
+            || ((m_settings.m_spectrumYScale == RadioAstronomySettings::SY_DBM) && !fft->hasTemp())
+            || ((m_settings.m_spectrumYScale == RadioAstronomySettings::SY_TSYS) && !fft->hasTemp())
+            || ((m_settings.m_spectrumYScale == RadioAstronomySettings::SY_TSOURCE) && !fft->hasTemp())
            )
         {
             m_fftChart->setTitle("No cal data: Run calibration or set units to dBFS.");
@@ -4120,6 +4200,21 @@ void RadioAstronomyGUI::plotFFTMeasurement(int index)
 
             double freq = startFreq;   // Main spectrum seems to use bin midpoint - this uses lowest frequency, so we're tone at centre freq appears in centre of plot
 
+            // Derived spectra are calculated from the raw data when needed
+            const Real *fftData = fft->fftData();
+            const Real *snr = nullptr;
+            const Real *temp = nullptr;
+            if (m_settings.m_spectrumYScale == RadioAstronomySettings::SY_SNR)
+            {
+                m_spectrumBuffer.resize(fft->m_fftSize);
+                fft->getSNR(m_spectrumBuffer.data());
+                snr = m_spectrumBuffer.data();
+            }
+            else if (m_settings.m_spectrumYScale != RadioAstronomySettings::SY_DBFS)
+            {
+                temp = getTemp(fft);
+            }
+
             // Plot power/temp
             for (int i = 0; i < fft->m_fftSize; i++)
             {
@@ -4127,29 +4222,29 @@ void RadioAstronomyGUI::plotFFTMeasurement(int index)
                 switch (m_settings.m_spectrumYScale)
                 {
                 case RadioAstronomySettings::SY_DBFS:
-                    value = fft->m_db[i];
+                    value = CalcDb::dbPower(fftData[i]);
                     break;
                 case RadioAstronomySettings::SY_SNR:
-                    value = fft->m_snr[i];
+                    value = snr[i];
                     break;
                 case RadioAstronomySettings::SY_DBM:
-                    value = Astronomy::noisePowerdBm(fft->m_temp[i], fft->m_sampleRate/(double)fft->m_fftSize);
+                    value = Astronomy::noisePowerdBm(temp[i], fft->m_sampleRate/(double)fft->m_fftSize);
                     break;
                 case RadioAstronomySettings::SY_TSYS:
-                    value = fft->m_temp[i];
+                    value = temp[i];
                     break;
                 case RadioAstronomySettings::SY_TSOURCE:
                     switch (m_settings.m_spectrumBaseline)
                     {
                     case RadioAstronomySettings::SBL_TSYS0:
-                        value = fft->m_temp[i] - fft->m_tSys0;
+                        value = temp[i] - fft->m_tSys0;
                         break;
                     case RadioAstronomySettings::SBL_TMIN:
-                        value = fft->m_temp[i] - fft->m_tempMin;
+                        value = temp[i] - fft->m_tempMin;
                         break;
                     case RadioAstronomySettings::SBL_CAL_COLD:
                         if (m_calCold) {
-                            value = m_calG[i] * (fft->m_fftData[i] - m_calCold->m_fftData[i]);
+                            value = m_calG[i] * (fftData[i] - m_calCold->fftData()[i]);
                         } else {
                             value = 0.0;
                         }
@@ -4479,19 +4574,75 @@ void RadioAstronomyGUI::plotTempGaussian(double startFreq, double freqStep, int
     }
 }
 
-void RadioAstronomyGUI::calcFFTPower(FFTMeasurement* fft)
+void RadioAstronomyGUI::FFTMeasurement::getSNR(Real *snr) const
 {
-    // Convert linear to dB
-    for (int i = 0; i < fft->m_fftSize; i++) {
-        fft->m_db[i] = CalcDb::dbPower(fft->m_fftData[i]);
+    const Real *data = fftData();
+
+    if (m_calibration && ((int) m_calibration->m_cold.size() >= m_fftSize))
+    {
+        // Calculate SNR (relative to cold cal)
+        for (int i = 0; i < m_fftSize; i++) {
+            snr[i] = data[i] / m_calibration->m_cold[i];
+        }
+    }
+    else
+    {
+        const Real *loaded = loadedSNR();
+        std::copy(loaded, loaded + m_fftSize, snr);
+    }
+}
+
+void RadioAstronomyGUI::FFTMeasurement::getTemp(Real *temp) const
+{
+    const Real *data = fftData();
+
+    if (m_calibration && ((int) m_calibration->m_g.size() >= m_fftSize))
+    {
+        // Calculate temperature using scaling from hot cal
+        for (int i = 0; i < m_fftSize; i++) {
+            temp[i] = m_calibration->m_g[i] * data[i];
+        }
+        // Calculate temperature using linear interpolation from hot/cold cal
+        //temp[i] = m_g[i] * (data[i] - m_cold[i]) + m_settings.m_tCalCold;
+        //temp[i] = std::max(temp[i], 0.0f); // Can't have negative temperatures
+    }
+    else
+    {
+        const Real *loaded = loadedTemp();
+        std::copy(loaded, loaded + m_fftSize, temp);
+    }
+}
+
+// Get snapshot of current calibration data, that measurements can share
+QSharedPointer<const RadioAstronomyGUI::FFTCalibration> RadioAstronomyGUI::getCalibration()
+{
+    if (!m_calibration && (m_calCold || m_calG))
+    {
+        FFTCalibration *calibration = new FFTCalibration();
+        if (m_calCold) {
+            calibration->m_cold.assign(m_calCold->fftData(), m_calCold->fftData() + m_calCold->m_fftSize);
+        }
+        if (m_calG && m_calHot) {
+            calibration->m_g.assign(m_calG, m_calG + m_calHot->m_fftSize);
+        }
+        m_calibration.reset(calibration);
     }
+    return m_calibration;
+}
+
+const Real *RadioAstronomyGUI::getTemp(const FFTMeasurement* fft)
+{
+    m_spectrumBuffer.resize(fft->m_fftSize);
+    fft->getTemp(m_spectrumBuffer.data());
+    return m_spectrumBuffer.data();
 }
 
 void RadioAstronomyGUI::calcFFTTotalPower(FFTMeasurement* fft)
 {
+    const Real *fftData = fft->fftData();
     double total = 0.0;
     for (int i = 0; i < fft->m_fftSize; i++) {
-        total += fft->m_fftData[i];
+        total += fftData[i];
     }
     fft->m_totalPower = total;
     fft->m_totalPowerdBFS = CalcDb::dbPower(total);
@@ -4499,26 +4650,33 @@ void RadioAstronomyGUI::calcFFTTotalPower(FFTMeasurement* fft)
 
 void RadioAstronomyGUI::calcFFTTemperatures(FFTMeasurement* fft)
 {
-    if (m_calCold && !fft->m_snr) {
-        fft->m_snr = new Real[fft->m_fftSize];
-    }
-    if (m_calG && !fft->m_temp) {
-        fft->m_temp = new Real[fft->m_fftSize];
-    }
-    for (int i = 0; i < fft->m_fftSize; i++)
+    // SNR and temperature spectra are calculated when needed from the calibration
+    QSharedPointer<const FFTCalibration> calibration = getCalibration();
+
+    if (calibration)
     {
-        if (fft->m_snr && m_calCold)
+        if (fft->m_calibration && (calibration->m_cold.empty() || calibration->m_g.empty()))
         {
-            // Calculate SNR (relative to cold cal)
-            fft->m_snr[i] = fft->m_fftData[i] / m_calCold->m_fftData[i];
+            // Keep previous calibration for anything not in the current calibration
+            // Consecutive measurements typically have the same pair, so share the merge
+            if ((m_mergedCalibrationCurrent != calibration) || (m_mergedCalibrationPrevious != fft->m_calibration))
+            {
+                FFTCalibration *merged = new FFTCalibration(*calibration);
+                if (merged->m_cold.empty()) {
+                    merged->m_cold = fft->m_calibration->m_cold;
+                }
+                if (merged->m_g.empty()) {
+                    merged->m_g = fft->m_calibration->m_g;
+                }
+                m_mergedCalibration.reset(merged);
+                m_mergedCalibrationCurrent = calibration;
+                m_mergedCalibrationPrevious = fft->m_calibration;
+            }
+            fft->m_calibration = m_mergedCalibration;
         }
-        if (m_calG)
+        else
         {
-            // Calculate temperature using scaling from hot cal
-            fft->m_temp[i] = m_calG[i] * fft->m_fftData[i];
-            // Calculate temperature using linear interpolation from hot/cold cal
-            //fft->m_temp[i] = m_calG[i] * (fft->m_fftData[i] - m_calCold->m_fftData[i]) + m_settings.m_tCalCold;
-            //fft->m_temp[i] = std::max(fft->m_temp[i], 0.0f); // Can't have negative temperatures
+            fft->m_calibration = calibration;
         }
     }
     calcFFTMinTemperature(fft);
@@ -4527,8 +4685,9 @@ void RadioAstronomyGUI::calcFFTTemperatures(FFTMeasurement* fft)
 void RadioAstronomyGUI::calcFFTMinTemperature(FFTMeasurement* fft)
 {
     fft->m_tempMin = 0;
-    if (fft->m_temp)
+    if (fft->hasTemp())
     {
+        const Real *temp = getTemp(fft);
         // Select minimum from within band. 95% of that to account for a little bit of inband rolloff
         float tempMin = std::numeric_limits<float>::max();
         double pc = 0.95 * fft->m_rfBandwidth / (double)fft->m_sampleRate;
@@ -4537,7 +4696,7 @@ void RadioAstronomyGUI::calcFFTMinTemperature(FFTMeasurement* fft)
         for (int i = 0; i < count; i++)
         {
             int idx = i + start;
-            tempMin = std::min(tempMin, fft->m_temp[idx]);
+            tempMin = std::min(tempMin, temp[idx]);
         }
         if (tempMin != std::numeric_limits<float>::max()) {
             fft->m_tempMin = tempMin;
@@ -4574,11 +4733,12 @@ double RadioAstronomyGUI::calcFlux(double Ta, const FFTMeasurement *fft) const
 
 void RadioAstronomyGUI::calcFFTTotalTemperature(FFTMeasurement* fft)
 {
-    if (fft->m_temp)
+    if (fft->hasTemp())
     {
+        const Real *temp = getTemp(fft);
         double tempSum = 0.0;
         for (int i = 0; i < fft->m_fftSize; i++) {
-            tempSum += fft->m_temp[i];
+            tempSum += temp[i];
         }
 
         // Convert from temperature to power in Watts and dBm
@@ -4618,6 +4778,16 @@ void RadioAstronomyGUI::updatePowerColumns(int row, FFTMeasurement* fft)
 
 void RadioAstronomyGUI::addFFT(FFTMeasurement *fft, bool skipCalcs)
 {
+    // Move spectra to the store, so they aren't held in memory
+    fft->m_storeRow = m_store.append(fft->m_dateTime.toMSecsSinceEpoch(), fft->m_fftSize, fft->m_fftData, fft->m_snr, fft->m_temp);
+    fft->m_store = &m_store;
+    delete[] fft->m_fftData;
+    delete[] fft->m_snr;
+    delete[] fft->m_temp;
+    fft->m_fftData = nullptr;
+    fft->m_snr = nullptr;
+    fft->m_temp = nullptr;
+
     m_fftMeasurements.append(fft);
 
     powerMeasurementReceived(fft, skipCalcs); // Call before ui->spectrumIndex->setValue, so table row is valid
@@ -4636,6 +4806,13 @@ void RadioAstronomyGUI::addFFT(FFTMeasurement *fft, bool skipCalcs)
 
 void RadioAstronomyGUI::fftMeasurementReceived(const RadioAstronomy::MsgFFTMeasurement& measurement)
 {
+    if (measurement.getSamplesReceived() > 0)
+    {
+        ui->measurementProgress->setToolTip(QString("Measurement status\nLast measurement: %1 samples integrated of %2 received")
+            .arg(measurement.getSamplesIntegrated())
+            .arg(measurement.getSamplesReceived()));
+    }
+
     FFTMeasurement *fft = new FFTMeasurement();
     fft->m_fftData = measurement.getFFT();
     fft->m_fftSize = measurement.getSize();
@@ -4661,12 +4838,10 @@ void RadioAstronomyGUI::fftMeasurementReceived(const RadioAstronomy::MsgFFTMeasu
     for (int i = 0; i < RADIOASTRONOMY_SENSORS; i++) {
         fft->m_sensor[i] = m_sensors[i].lastValue();
     }
-    fft->m_db = new Real[fft->m_fftSize];
     fft->m_sweepIndex = m_sweepIndex++;
     fft->m_tSys0 = calcTSys0();
     fft->m_baseline = m_settings.m_spectrumBaseline;
 
-    calcFFTPower(fft);
     calcFFTTotalPower(fft);
     calcFFTTemperatures(fft);
     calcFFTTotalTemperature(fft);
@@ -6062,6 +6237,8 @@ void RadioAstronomyGUI::makeUIConnections()
     QObject::connect(ui->integration, &ValueDialZ::changed, this, &RadioAstronomyGUI::on_integration_changed);
     QObject::connect(ui->fftSize, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &RadioAstronomyGUI::on_fftSize_currentIndexChanged);
     QObject::connect(ui->fftWindow, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &RadioAstronomyGUI::on_fftWindow_currentIndexChanged);
+    QObject::connect(ui->pfbTaps, QOverload<int>::of(&QSpinBox::valueChanged), this, &RadioAstronomyGUI::on_pfbTaps_valueChanged);
+    QObject::connect(ui->integrationThreads, QOverload<int>::of(&QSpinBox::valueChanged), this, &RadioAstronomyGUI::on_integrationThreads_valueChanged);
     QObject::connect(ui->filterFreqs, &QLineEdit::editingFinished, this, &RadioAstronomyGUI::on_filterFreqs_editingFinished);
     QObject::connect(ui->starTracker, &QComboBox::currentTextChanged, this, &RadioAstronomyGUI::on_starTracker_currentTextChanged);
     QObject::connect(ui->rotator, &QComboBox::currentTextChanged, this, &RadioAstronomyGUI::on_rotator_currentTextChanged);
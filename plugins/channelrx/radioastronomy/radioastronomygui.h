@@ -27,6 +27,7 @@
 #include <QtCharts>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QSharedPointer>
 #include <QDebug>
 
 #include "channel/channelgui.h"
@@ -37,6 +38,7 @@
 
 #include "radioastronomysettings.h"
 #include "radioastronomy.h"
+#include "radioastronomymeasurementstore.h"
 
 class PluginAPI;
 class DeviceUISet;
@@ -54,6 +56,13 @@ using namespace QtCharts;
 class RadioAstronomyGUI : public ChannelGUI {
     Q_OBJECT
 
+    // Calibration data in use when a measurement was made, from which its SNR
+    // and temperature spectra are calculated when needed
+    struct FFTCalibration {
+        std::vector<Real> m_cold;   // Cold cal FFT. Empty if not available
+        std::vector<double> m_g;    // Scale factors from FFT to temperature. Empty if not available
+    };
+
     struct FFTMeasurement {
         QDateTime m_dateTime;
         qint64 m_centerFrequency;
@@ -62,10 +71,12 @@ class RadioAstronomyGUI : public ChannelGUI {
         int m_rfBandwidth;
 
         int m_fftSize;
-        Real* m_fftData;
-        Real* m_db;             // dBFS
-        Real* m_snr;            // SNR (noise is cold cal data)
-        Real* m_temp;           // Temp in Kelvin base on hot/cold cal data
+        Real* m_fftData;        // Held in memory until added to the measurement store
+        Real* m_snr;            // SNR (noise is cold cal data) loaded from file
+        Real* m_temp;           // Temp in Kelvin base on hot/cold cal data, loaded from file
+        const RadioAstronomyMeasurementStore *m_store;
+        int m_storeRow;         // Row in m_store, once added
+        QSharedPointer<const FFTCalibration> m_calibration;
         Real m_totalPower;      // Total power based on sum of fftData (i.e unknown units)
         Real m_totalPowerdBFS;  // m_totalPower in dB
         Real m_totalPowerdBm;   // Total power in dBm
@@ -101,9 +112,10 @@ class RadioAstronomyGUI : public ChannelGUI {
         FFTMeasurement() :
             m_fftSize(0),
             m_fftData(nullptr),
-            m_db(nullptr),
             m_snr(nullptr),
             m_temp(nullptr),
+            m_store(nullptr),
+            m_storeRow(-1),
             m_totalPower(0.0f),
             m_totalPowerdBFS(0.0f),
             m_totalPowerdBm(0.0f),
@@ -126,10 +138,33 @@ class RadioAstronomyGUI : public ChannelGUI {
         ~FFTMeasurement()
         {
             delete[] m_fftData;
-            delete[] m_db;
             delete[] m_snr;
             delete[] m_temp;
         }
+
+        const Real *fftData() const {
+            return m_fftData ? m_fftData : m_store->get(m_storeRow, RadioAstronomyMeasurementStore::RAW);
+        }
+
+        const Real *loadedSNR() const {
+            return m_store ? m_store->get(m_storeRow, RadioAstronomyMeasurementStore::SNR) : m_snr;
+        }
+
+        const Real *loadedTemp() const {
+            return m_store ? m_store->get(m_storeRow, RadioAstronomyMeasurementStore::TEMP) : m_temp;
+        }
+
+        bool hasSNR() const {
+            return (m_calibration && ((int) m_calibration->m_cold.size() >= m_fftSize)) || loadedSNR();
+        }
+
+        bool hasTemp() const {
+            return (m_calibration && ((int) m_calibration->m_g.size() >= m_fftSize)) || loadedTemp();
+        }
+
+        // Calculate SNR and temperature spectra. Only valid if hasSNR()/hasTemp()
+        void getSNR(Real *snr) const;
+        void getTemp(Real *temp) const;
     };
 
     struct LABData {
@@ -285,6 +320,12 @@ private:
     QValueAxis *m_fftYAxis;
     QValueAxis *m_fftDopplerAxis;
     QList<FFTMeasurement*> m_fftMeasurements;
+    RadioAstronomyMeasurementStore m_store;             //!< Spectra of m_fftMeasurements
+    QSharedPointer<const FFTCalibration> m_calibration; //!< Snapshot of current calibration. Null when it needs to be recreated
+    QSharedPointer<const FFTCalibration> m_mergedCalibration;         //!< Current calibration merged with m_mergedCalibrationPrevious
+    QSharedPointer<const FFTCalibration> m_mergedCalibrationCurrent;  //!< Calibration m_mergedCalibration was created from
+    QSharedPointer<const FFTCalibration> m_mergedCalibrationPrevious; //!< Measurement calibration m_mergedCalibration was created from
+    std::vector<Real> m_spectrumBuffer;                 //!< For calculating SNR / temperature spectra
 
     // Markers
     bool m_powerM1Valid;
@@ -346,7 +387,8 @@ private:
     void updateOmegaA();
     void powerMeasurementReceived(FFTMeasurement *fft, bool skipCalcs);
     void calCompletetReceived(const RadioAstronomy::MsgCalComplete& measurement);
-    void calcFFTPower(FFTMeasurement* fft);
+    QSharedPointer<const FFTCalibration> getCalibration();
+    const Real *getTemp(const FFTMeasurement* fft);
     void calcFFTTotalPower(FFTMeasurement* fft);
     void calcFFTTemperatures(FFTMeasurement* fft);
     void calcFFTTotalTemperature(FFTMeasurement* fft);
@@ -372,6 +414,7 @@ private:
     bool hasNeededFFTData(QHash<QString,int> hash);
     void saveFFT(QTextStream& out, const FFTMeasurement* fft);
     FFTMeasurement* loadFFT(QHash<QString,int> hash, QStringList cols);
+    void saveFITS(const QString& filename);
     void clearData();
     void clearCalData();
     bool deleteRow(int row);
@@ -531,6 +574,8 @@ private slots:
     void on_integration_changed(qint64 value);
     void on_fftSize_currentIndexChanged(int index);
     void on_fftWindow_currentIndexChanged(int index);
+    void on_pfbTaps_valueChanged(int value);
+    void on_integrationThreads_valueChanged(int value);
     void on_filterFreqs_editingFinished();
 
     void on_starTracker_currentTextChanged(const QString& text);
@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB                                   //
+// Copyright (C) 2021 Jon Beniston, M7RCE                                        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include <QDir>
+#include <QTemporaryFile>
+#include <QDebug>
+
+#include "radioastronomymeasurementstore.h"
+
+RadioAstronomyMeasurementStore::RadioAstronomyMeasurementStore() :
+    m_bytes(0)
+{
+    for (int i = 0; i < NB_COLUMNS; i++)
+    {
+        m_columns[i].m_file = nullptr;
+        m_columns[i].m_fileSize = 0;
+        m_columns[i].m_chunkUsed = 0;
+        m_columns[i].m_useFile = true;
+    }
+}
+
+RadioAstronomyMeasurementStore::~RadioAstronomyMeasurementStore()
+{
+    clear();
+}
+
+void RadioAstronomyMeasurementStore::clear()
+{
+    for (int i = 0; i < NB_COLUMNS; i++)
+    {
+        ColumnData& columnData = m_columns[i];
+
+        for (const auto& chunk : columnData.m_chunks)
+        {
+            if (chunk.m_mapped) {
+                columnData.m_file->unmap(chunk.m_data);
+            } else {
+                delete[] chunk.m_data;
+            }
+        }
+
+        columnData.m_chunks.clear();
+        delete columnData.m_file; // Removes the file
+        columnData.m_file = nullptr;
+        columnData.m_fileSize = 0;
+        columnData.m_chunkUsed = 0;
+        columnData.m_useFile = true;
+    }
+
+    m_rows.clear();
+    m_bytes = 0;
+}
+
+int RadioAstronomyMeasurementStore::append(qint64 msecs, int size, const Real *raw, const Real *snr, const Real *temp)
+{
+    Row row;
+    row.m_msecs = msecs;
+    row.m_size = size;
+    const Real *data[NB_COLUMNS] = {raw, snr, temp};
+
+    for (int i = 0; i < NB_COLUMNS; i++)
+    {
+        if (data[i])
+        {
+            write((Column) i, data[i], size, row.m_chunk[i], row.m_offset[i]);
+        }
+        else
+        {
+            row.m_chunk[i] = -1;
+            row.m_offset[i] = 0;
+        }
+    }
+
+    m_rows.append(row);
+    return m_rows.size() - 1;
+}
+
+const Real *RadioAstronomyMeasurementStore::get(int row, Column column) const
+{
+    const Row& r = m_rows[row];
+
+    if (r.m_chunk[column] < 0) {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const Real*>(m_columns[column].m_chunks[r.m_chunk[column]].m_data + r.m_offset[column]);
+}
+
+int RadioAstronomyMeasurementStore::findRow(qint64 msecs) const
+{
+    auto it = std::lower_bound(m_rows.begin(), m_rows.end(), msecs, [](const Row& row, qint64 t) {
+        return row.m_msecs < t;
+    });
+
+    return it - m_rows.begin();
+}
+
+void RadioAstronomyMeasurementStore::write(Column column, const Real *data, int size, int& chunk, qint64& offset)
+{
+    ColumnData& columnData = m_columns[column];
+    qint64 bytes = size * (qint64) sizeof(Real);
+
+    // Spectra don't span chunks
+    if (columnData.m_chunks.isEmpty() || (columnData.m_chunks.last().m_size - columnData.m_chunkUsed < bytes)) {
+        addChunk(columnData, std::max(m_chunkSize, bytes));
+    }
+
+    chunk = columnData.m_chunks.size() - 1;
+    offset = columnData.m_chunkUsed;
+    std::memcpy(columnData.m_chunks.last().m_data + offset, data, bytes);
+    columnData.m_chunkUsed += bytes;
+    m_bytes += bytes;
+}
+
+bool RadioAstronomyMeasurementStore::addChunk(ColumnData& columnData, qint64 size)
+{
+    Chunk chunk;
+    chunk.m_size = size;
+    chunk.m_mapped = false;
+    chunk.m_data = nullptr;
+
+    if (columnData.m_useFile && !columnData.m_file)
+    {
+        columnData.m_file = new QTemporaryFile(QDir::tempPath() + "/sdrangel_radioastronomy_XXXXXX.dat");
+
+        if (!columnData.m_file->open())
+        {
+            qWarning() << "RadioAstronomyMeasurementStore::addChunk: Failed to create" << columnData.m_file->fileTemplate() << "- using memory";
+            columnData.m_useFile = false;
+        }
+    }
+
+    if (columnData.m_useFile)
+    {
+        // Extend the file and map the new chunk
+        if (columnData.m_file->resize(columnData.m_fileSize + size)) {
+            chunk.m_data = columnData.m_file->map(columnData.m_fileSize, size);
+        }
+
+        if (chunk.m_data)
+        {
+            chunk.m_mapped = true;
+            columnData.m_fileSize += size;
+        }
+        else
+        {
+            qWarning() << "RadioAstronomyMeasurementStore::addChunk: Failed to map" << columnData.m_file->fileName() << "- using memory";
+            columnData.m_useFile = false;
+        }
+    }
+
+    if (!chunk.m_data) {
+        chunk.m_data = new uchar[size];
+    }
+
+    columnData.m_chunks.append(chunk);
+    columnData.m_chunkUsed = 0;
+    return chunk.m_mapped;
+}
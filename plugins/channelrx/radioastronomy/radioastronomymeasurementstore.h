@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB                                   //
+// Copyright (C) 2021 Jon Beniston, M7RCE                                        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_RADIOASTRONOMYMEASUREMENTSTORE_H
+#define INCLUDE_RADIOASTRONOMYMEASUREMENTSTORE_H
+
+#include <QList>
+#include <QVector>
+
+#include "dsp/dsptypes.h"
+
+class QTemporaryFile;
+
+// Append-only store for spectra of long observations, so they don't need to be held in RAM.
+// Each column (raw FFT power, and optionally SNR and temperature loaded from a file) is kept
+// in its own temporary file, which is extended in chunks. Each chunk is memory mapped once,
+// so pointers returned by get() remain valid until clear().
+// If a file can't be created or mapped, chunks are allocated in memory instead.
+class RadioAstronomyMeasurementStore
+{
+public:
+    enum Column {
+        RAW,        //!< FFT power (linear)
+        SNR,        //!< SNR, only when loaded from a file
+        TEMP,       //!< Temperature in K, only when loaded from a file
+        NB_COLUMNS
+    };
+
+    RadioAstronomyMeasurementStore();
+    ~RadioAstronomyMeasurementStore();
+
+    //! Append a row. Returns row index. Rows should be appended in time order for findRow()
+    int append(qint64 msecs, int size, const Real *raw, const Real *snr = nullptr, const Real *temp = nullptr);
+    void clear();               //!< Remove all rows and release disk space
+
+    int getNbRows() const { return m_rows.size(); }
+    int getSize(int row) const { return m_rows[row].m_size; }
+    qint64 getMSecs(int row) const { return m_rows[row].m_msecs; }
+    const Real *get(int row, Column column) const; //!< nullptr if column isn't present for the row
+    int findRow(qint64 msecs) const;    //!< Index of first row at or after msecs
+    qint64 getBytes() const { return m_bytes; } //!< Bytes used by spectra
+
+private:
+    struct Chunk
+    {
+        uchar *m_data;
+        qint64 m_size;
+        bool m_mapped;
+    };
+
+    struct ColumnData
+    {
+        QTemporaryFile *m_file;
+        QList<Chunk> m_chunks;
+        qint64 m_fileSize;
+        qint64 m_chunkUsed;     //!< Bytes used in last chunk
+        bool m_useFile;
+    };
+
+    struct Row
+    {
+        qint64 m_msecs;
+        int m_size;
+        int m_chunk[NB_COLUMNS];    //!< -1 if column not present
+        qint64 m_offset[NB_COLUMNS];
+    };
+
+    ColumnData m_columns[NB_COLUMNS];
+    QVector<Row> m_rows;
+    qint64 m_bytes;
+
+    static const qint64 m_chunkSize = 16*1024*1024;
+
+    void write(Column column, const Real *data, int size, int& chunk, qint64& offset);
+    bool addChunk(ColumnData& columnData, qint64 size);
+};
+
+#endif // INCLUDE_RADIOASTRONOMYMEASUREMENTSTORE_H
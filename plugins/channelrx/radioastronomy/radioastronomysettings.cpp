@@ -16,6 +16,8 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <QColor>
 
 #include "dsp/dspengine.h"
@@ -46,6 +48,8 @@ void RadioAstronomySettings::resetToDefaults()
     m_integration = 4000;
     m_fftSize = 256;
     m_fftWindow = HAN;
+    m_pfbTaps = 1;
+    m_integrationThreads = 1;
     m_filterFreqs = "";
 
     m_starTracker = "";
@@ -184,6 +188,8 @@ QByteArray RadioAstronomySettings::serialize() const
     s.writeS32(5, m_fftSize);
     s.writeS32(6, (int)m_fftWindow);
     s.writeString(7, m_filterFreqs);
+    s.writeS32(8, m_pfbTaps);
+    s.writeS32(9, m_integrationThreads);
 
     s.writeString(10, m_starTracker);
     s.writeString(11, m_rotator);
@@ -345,6 +351,10 @@ bool RadioAstronomySettings::deserialize(const QByteArray& data)
         d.readS32(5, &m_fftSize, 256);
         d.readS32(6, (int*)&m_fftWindow, (int)HAN);
         d.readString(7, &m_filterFreqs, "");
+        d.readS32(8, &m_pfbTaps, 1);
+        m_pfbTaps = std::max(1, std::min(m_pfbTaps, 16));
+        d.readS32(9, &m_integrationThreads, 1);
+        m_integrationThreads = std::max(1, std::min(m_integrationThreads, 16));
 
         d.readString(10, &m_starTracker, "");
         d.readString(11, &m_rotator, "None");
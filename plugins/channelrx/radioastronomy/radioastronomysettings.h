@@ -60,6 +60,8 @@ struct RadioAstronomySettings
         HAN
     } m_fftWindow;              //!< FFT windowing function
     QString m_filterFreqs;      //!< List of channels (bin indices) to filter in FFT to remove RFI
+    int m_pfbTaps;              //!< Number of polyphase filter bank taps. 1 for a plain windowed FFT
+    int m_integrationThreads;   //!< Number of threads FFTs for an integration are split between
 
     QString m_starTracker;      //!< Name of Star Tracker plugin to link with
     QString m_rotator;          //!< Name of antenna rotator
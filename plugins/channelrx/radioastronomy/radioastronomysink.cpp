@@ -16,9 +16,10 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include <QDebug>
+#include <algorithm>
+#include <limits>
 
-#include "dsp/dspengine.h"
+#include <QDebug>
 
 #include "radioastronomy.h"
 #include "radioastronomysink.h"
@@ -27,12 +28,11 @@ RadioAstronomySink::RadioAstronomySink(RadioAstronomy *aisDemod) :
     m_radioAstronomy(aisDemod),
     m_channelSampleRate(1000000),
     m_channelFrequencyOffset(0),
-    m_fftSequence(-1),
-    m_fft(nullptr),
-    m_fftCounter(0),
     m_fftSum(nullptr),
     m_fftTemp(nullptr),
     m_fftSumCount(0),
+    m_samplesReceived(0),
+    m_samplesDropped(0),
     m_enabled(false),
     m_cal(false),
     m_magsqSum(0.0f),
@@ -98,110 +98,129 @@ void RadioAstronomySink::processOneSample(Complex &ci)
 
     if (m_enabled || m_cal)
     {
-        // Add to FFT input buffer
-        m_fft->in()[m_fftCounter] = Complex(ci.real() / SDR_RX_SCALEF, ci.imag() / SDR_RX_SCALEF);
-        m_fftCounter++;
-        if (m_fftCounter >= m_settings.m_fftSize)
-        {
-            // Calculate FFT
-            m_fftWindow.apply(m_fft->in());
-            m_fft->transform();
-            m_fftCounter = 0;
+        m_samplesReceived++;
 
-            // Calculate power and accumulate
-            for (int i = 0; i < m_settings.m_fftSize; i++)
-            {
-                Complex s = m_fft->out()[i];
-                Real v = s.real() * s.real() + s.imag() * s.imag();
-                Real enbw = 1.0f;
-                /*if (m_settings.m_fftWindow == RadioAstronomySettings::HAN && m_settings.m_fftCorrection == RadioAstronomySettings::POWER) {
-                    enbw = 1.5; // FIXME: Small dependence on fftSize in Matlab
-                }*/
-                m_fftSum[i] += v / (enbw * m_settings.m_fftSize * m_settings.m_fftSize); // Why FFT size here and not Fs?
-            }
+        // Add to spectrometer input and integrate a batch of frames when enough are
+        // available or when they complete the integration
+        int nbFrames = m_spectrometer.write(Complex(ci.real() / SDR_RX_SCALEF, ci.imag() / SDR_RX_SCALEF));
+        // At least one frame so that an integration always completes
+        int remaining = std::max(1, m_settings.m_integration - m_fftSumCount);
+
+        if (nbFrames >= std::min(remaining, m_spectrometer.getMaxBatchFrames()))
+        {
+            nbFrames = std::min(nbFrames, remaining);
+            m_spectrometer.integrate(nbFrames);
+            int previousCount = m_fftSumCount;
+            m_fftSumCount += nbFrames;
 
-            m_fftSumCount++;
             if (m_fftSumCount >= m_settings.m_integration)
             {
-                // Average
-                for (int i = 0; i < m_settings.m_fftSize; i++) {
-                    m_fftSum[i] /= m_fftSumCount;
-                }
-
-                // Put negative frequencies first
-                std::copy(m_fftSum + m_settings.m_fftSize/2, m_fftSum + m_settings.m_fftSize, m_fftTemp);
-                std::copy(m_fftSum, m_fftSum + m_settings.m_fftSize/2, m_fftTemp + m_settings.m_fftSize/2);
-
-                // Filter freqs with RFI
-                if (m_filterBins.size() > 0)
-                {
-                    // Find minimum value to use as replacement
-                    // Should possibly use an average of the n lowest values or something
-                    float minVal = std::numeric_limits<float>::max();
-                    for (int i = 0; i < m_settings.m_fftSize; i++) {
-                         minVal = std::min(minVal, m_fftTemp[i]);
-                    }
-                    for (int i = 0; i < m_filterBins.size(); i++)
-                    {
-                        int bin = m_filterBins[i];
-                        if (bin < m_settings.m_fftSize) {
-                            m_fftTemp[bin] = minVal;
-                        }
-                    }
-                }
-
-                getMessageQueueToChannel()->push(RadioAstronomy::MsgMeasurementProgress::create(100));
-
-                if (m_cal)
-                {
-                    // Indicate calibration complete
-                    if (getMessageQueueToChannel())
-                    {
-                        RadioAstronomy::MsgCalComplete *msg = RadioAstronomy::MsgCalComplete::create(m_fftTemp, m_settings.m_fftSize, QDateTime::currentDateTime(), m_hot);
-                        getMessageQueueToChannel()->push(msg);
-                    }
-
-                    // Cal complete
-                    m_cal = false;
-                }
-                else
-                {
-                    // Send averaged FFT to channel
-                    if (getMessageQueueToChannel())
-                    {
-
-                        RadioAstronomy::MsgFFTMeasurement *msg = RadioAstronomy::MsgFFTMeasurement::create(m_fftTemp, m_settings.m_fftSize, QDateTime::currentDateTime());
-                        getMessageQueueToChannel()->push(msg);
-                    }
-
-                    m_enabled = (m_settings.m_runMode == RadioAstronomySettings::CONTINUOUS);
-                    if (m_enabled) {
-                        getMessageQueueToChannel()->push(RadioAstronomy::MsgMeasurementProgress::create(0));
-                    }
-                }
-
-                m_fftSumCount = 0;
-                std::fill(m_fftSum, m_fftSum + m_settings.m_fftSize, 0.0f);
+                integrationComplete();
             }
             else
             {
                 // Don't send more than ~4 updates per second
                 int fftsPerSecond = m_settings.m_sampleRate / m_settings.m_fftSize;
-                if ((m_fftSumCount % (fftsPerSecond/4)) == 0) {
+                int progressStep = std::max(1, fftsPerSecond/4);
+                if ((m_fftSumCount / progressStep) != (previousCount / progressStep)) {
                     getMessageQueueToChannel()->push(RadioAstronomy::MsgMeasurementProgress::create(100 * m_fftSumCount / m_settings.m_integration));
                 }
             }
+        }
+    }
+}
 
+void RadioAstronomySink::integrationComplete()
+{
+    // Average
+    Real enbw = 1.0f;
+    /*if (m_settings.m_fftWindow == RadioAstronomySettings::HAN && m_settings.m_fftCorrection == RadioAstronomySettings::POWER) {
+        enbw = 1.5; // FIXME: Small dependence on fftSize in Matlab
+    }*/
+    m_spectrometer.getPower(m_fftSum, 1.0f / (enbw * m_settings.m_fftSize * m_settings.m_fftSize * m_fftSumCount)); // Why FFT size here and not Fs?
+
+    // Put negative frequencies first
+    std::copy(m_fftSum + m_settings.m_fftSize/2, m_fftSum + m_settings.m_fftSize, m_fftTemp);
+    std::copy(m_fftSum, m_fftSum + m_settings.m_fftSize/2, m_fftTemp + m_settings.m_fftSize/2);
+
+    // Filter freqs with RFI
+    if (m_filterBins.size() > 0)
+    {
+        // Find minimum value to use as replacement
+        // Should possibly use an average of the n lowest values or something
+        float minVal = std::numeric_limits<float>::max();
+        for (int i = 0; i < m_settings.m_fftSize; i++) {
+             minVal = std::min(minVal, m_fftTemp[i]);
+        }
+        for (int i = 0; i < m_filterBins.size(); i++)
+        {
+            int bin = m_filterBins[i];
+            if (bin < m_settings.m_fftSize) {
+                m_fftTemp[bin] = minVal;
+            }
         }
     }
+
+    // Samples integrated vs received. Received also includes samples dropped before the
+    // channel and samples held over to the next integration (PFB history or partial frame)
+    qint64 samplesIntegrated = (qint64) m_fftSumCount * m_settings.m_fftSize;
+    qint64 samplesDropped = m_samplesDropped.exchange(0);
+    qint64 samplesReceived = m_samplesReceived + samplesDropped;
+
+    if (samplesDropped > 0) {
+        qWarning() << "RadioAstronomySink::integrationComplete:" << samplesDropped << "samples dropped during integration";
+    }
+
+    getMessageQueueToChannel()->push(RadioAstronomy::MsgMeasurementProgress::create(100));
+
+    if (m_cal)
+    {
+        // Indicate calibration complete
+        if (getMessageQueueToChannel())
+        {
+            RadioAstronomy::MsgCalComplete *msg = RadioAstronomy::MsgCalComplete::create(m_fftTemp, m_settings.m_fftSize, QDateTime::currentDateTime(), m_hot);
+            getMessageQueueToChannel()->push(msg);
+        }
+
+        // Cal complete
+        m_cal = false;
+    }
+    else
+    {
+        // Send averaged FFT to channel
+        if (getMessageQueueToChannel())
+        {
+            RadioAstronomy::MsgFFTMeasurement *msg = RadioAstronomy::MsgFFTMeasurement::create(
+                m_fftTemp, m_settings.m_fftSize, QDateTime::currentDateTime(), samplesIntegrated, samplesReceived);
+            getMessageQueueToChannel()->push(msg);
+        }
+
+        m_enabled = (m_settings.m_runMode == RadioAstronomySettings::CONTINUOUS);
+        if (m_enabled) {
+            getMessageQueueToChannel()->push(RadioAstronomy::MsgMeasurementProgress::create(0));
+        }
+    }
+
+    // Continuous measurements carry on from the samples already in the spectrometer
+    // so that no samples are lost between integrations
+    m_fftSumCount = 0;
+    m_samplesReceived = 0;
+    m_spectrometer.clearPower();
+}
+
+void RadioAstronomySink::startIntegration()
+{
+    m_fftSumCount = 0;
+    m_samplesReceived = 0;
+    m_samplesDropped = 0;
+    m_spectrometer.reset();
 }
 
 void RadioAstronomySink::startMeasurements()
 {
     getMessageQueueToChannel()->push(RadioAstronomy::MsgMeasurementProgress::create(0));
     m_enabled = true;
-    m_fftSumCount = 0;
-    std::fill(m_fftSum, m_fftSum + m_settings.m_fftSize, 0.0f);
+    startIntegration();
 }
 
 void RadioAstronomySink::stopMeasurements()
@@ -214,8 +233,7 @@ void RadioAstronomySink::startCal(bool hot)
     getMessageQueueToChannel()->push(RadioAstronomy::MsgMeasurementProgress::create(0));
     m_cal = true;
     m_hot = hot;
-    m_fftSumCount = 0;
-    std::fill(m_fftSum, m_fftSum + m_settings.m_fftSize, 0.0f);
+    startIntegration();
 }
 
 void RadioAstronomySink::applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force)
@@ -248,6 +266,8 @@ void RadioAstronomySink::applySettings(const RadioAstronomySettings& settings, b
             << " m_rfBandwidth: " << settings.m_rfBandwidth
             << " m_fftSize: " << settings.m_fftSize
             << " m_fftWindow: " << settings.m_fftWindow
+            << " m_pfbTaps: " << settings.m_pfbTaps
+            << " m_integrationThreads: " << settings.m_integrationThreads
             << " m_filterFreqs: " << settings.m_filterFreqs
             << " force: " << force;
 
@@ -262,28 +282,34 @@ void RadioAstronomySink::applySettings(const RadioAstronomySettings& settings, b
 
     if ((settings.m_fftSize != m_settings.m_fftSize) || force)
     {
-        FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
-        if (m_fftSequence >= 0) {
-            fftFactory->releaseEngine(m_settings.m_fftSize, false, m_fftSequence);
-        }
-        m_fftSequence = fftFactory->getEngine(settings.m_fftSize, false, &m_fft);
-        m_fftCounter = 0;
         delete[] m_fftSum;
         delete[] m_fftTemp;
         m_fftSum = new Real[settings.m_fftSize]();
         m_fftTemp = new Real[settings.m_fftSize]();
-        m_fftSumCount = 0;
-   }
+    }
 
     if ((settings.m_fftSize != m_settings.m_fftSize)
         || (settings.m_fftWindow != m_settings.m_fftWindow)
+        || (settings.m_pfbTaps != m_settings.m_pfbTaps)
+        || (settings.m_integrationThreads != m_settings.m_integrationThreads)
         || force)
     {
-        if (settings.m_fftWindow == RadioAstronomySettings::HAN) {
-            m_fftWindow.create(FFTWindow::Hanning, settings.m_fftSize);
-        } else {
-            m_fftWindow.create(FFTWindow::Rectangle, settings.m_fftSize);
-        }
+        m_spectrometer.configure(
+            settings.m_fftSize,
+            settings.m_pfbTaps,
+            settings.m_fftWindow == RadioAstronomySettings::HAN ? FFTWindow::Hanning : FFTWindow::Rectangle,
+            settings.m_integrationThreads
+        );
+        m_fftSumCount = 0;
+        m_samplesReceived = 0;
+    }
+
+    // Restart the integration in progress so that its count never exceeds the new number of FFTs to integrate
+    if (settings.m_integration != m_settings.m_integration)
+    {
+        m_fftSumCount = 0;
+        m_samplesReceived = 0;
+        m_spectrometer.clearPower();
     }
 
     if ((settings.m_filterFreqs != m_settings.m_filterFreqs) || force)
@@ -19,16 +19,16 @@
 #ifndef INCLUDE_RADIOASTRONOMYSINK_H
 #define INCLUDE_RADIOASTRONOMYSINK_H
 
+#include <atomic>
+
 #include "dsp/channelsamplesink.h"
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
-#include "dsp/fftfactory.h"
-#include "dsp/fftengine.h"
-#include "dsp/fftwindow.h"
 #include "util/movingaverage.h"
 #include "util/messagequeue.h"
 
 #include "radioastronomysettings.h"
+#include "radioastronomyspectrometer.h"
 
 class ChannelAPI;
 class RadioAstronomy;
@@ -50,6 +50,7 @@ public:
     void clearCal();
 
     double getMagSq() const { return m_magsq; }
+    void addDroppedSamples(qint64 nbSamples) { m_samplesDropped += nbSamples; } //!< Samples lost upstream, at channel sample rate
 
     void getMagSqLevels(double& avg, double& peak, int& nbSamples)
     {
@@ -87,15 +88,14 @@ private:
     int m_channelSampleRate;
     int m_channelFrequencyOffset;
 
-    int m_fftSequence;
-    FFTEngine *m_fft;
-    FFTWindow m_fftWindow;
-    int m_fftCounter;
+    RadioAstronomySpectrometer m_spectrometer;
     QList<int> m_filterBins;
 
     Real *m_fftSum;
     Real *m_fftTemp;
     int m_fftSumCount;
+    qint64 m_samplesReceived;               //!< Samples received since start of integration
+    std::atomic<qint64> m_samplesDropped;   //!< Samples dropped since start of integration
 
     bool m_enabled;
     bool m_cal;
@@ -117,6 +117,8 @@ private:
     MovingAverageUtil<Real, double, 16> m_movingAverage;
 
     void processOneSample(Complex &ci);
+    void integrationComplete();
+    void startIntegration();
     MessageQueue *getMessageQueueToChannel() { return m_messageQueueToChannel; }
 };
 
@@ -0,0 +1,320 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB                                   //
+// Copyright (C) 2021 Jon Beniston, M7RCE                                        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <QDebug>
+
+#include "dsp/dspengine.h"
+#include "dsp/fftfactory.h"
+#include "dsp/fftengine.h"
+
+#include "radioastronomyspectrometer.h"
+
+RadioAstronomySpectrometer::RadioAstronomySpectrometer() :
+    m_fftSize(0),
+    m_taps(1),
+    m_historySize(0),
+    m_maxBatchFrames(1),
+    m_bufferFill(0)
+{
+}
+
+RadioAstronomySpectrometer::~RadioAstronomySpectrometer()
+{
+    release();
+}
+
+void RadioAstronomySpectrometer::release()
+{
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+
+    for (auto partition : m_partitions)
+    {
+        if (partition->m_thread.joinable())
+        {
+            partition->m_stop = true;
+            partition->m_start.release();
+            partition->m_thread.join();
+        }
+
+        fftFactory->releaseEngine(m_fftSize, false, partition->m_fftSequence);
+        delete partition;
+    }
+
+    m_partitions.clear();
+}
+
+void RadioAstronomySpectrometer::configure(int fftSize, int taps, FFTWindow::Function window, int nbThreads)
+{
+    qDebug() << "RadioAstronomySpectrometer::configure:"
+        << " fftSize: " << fftSize
+        << " taps: " << taps
+        << " window: " << window
+        << " nbThreads: " << nbThreads;
+
+    release();
+
+    m_fftSize = fftSize;
+    m_taps = std::max(1, taps);
+    m_historySize = (m_taps - 1) * m_fftSize;
+    nbThreads = std::max(1, nbThreads);
+    // Enough frames per batch to give each thread a reasonable amount of work while
+    // keeping the latency of progress reports and end of integration low
+    m_maxBatchFrames = std::max(nbThreads, std::max(1, 65536 / m_fftSize));
+    m_buffer.resize(m_historySize + m_maxBatchFrames * m_fftSize);
+    m_sum.resize(m_fftSize);
+
+    // Filter coefficients. The window is spread over all taps. For a PFB it is
+    // multiplied by a sinc with its first nulls one FFT size away from the centre,
+    // so each bin has a flat top one bin wide.
+    // Each coefficient is stored twice, so it can be applied to interleaved I/Q floats.
+    int length = m_taps * m_fftSize;
+    std::vector<Real> ones(length, 1.0f);
+    std::vector<Real> coefficients(length);
+    FFTWindow fftWindow;
+    fftWindow.create(window, length);
+    fftWindow.apply(ones, &coefficients);
+    m_coefficients.resize(2 * length);
+
+    for (int i = 0; i < length; i++)
+    {
+        float coefficient = coefficients[i];
+
+        if (m_taps > 1)
+        {
+            double x = M_PI * (i - (length - 1) / 2.0) / m_fftSize;
+            double sinc = x == 0.0 ? 1.0 : std::sin(x) / x;
+            coefficient *= sinc;
+        }
+
+        m_coefficients[2*i] = coefficient;
+        m_coefficients[2*i+1] = coefficient;
+    }
+
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+
+    for (int i = 0; i < nbThreads; i++)
+    {
+        Partition *partition = new Partition();
+        partition->m_fftSequence = fftFactory->getEngine(m_fftSize, false, &partition->m_fft);
+        partition->m_batchSum.resize(m_fftSize);
+        partition->m_firstFrame = 0;
+        partition->m_nbFrames = 0;
+        partition->m_stop = false;
+        m_partitions.append(partition);
+
+        if (i > 0) { // First partition is processed in the caller's thread
+            partition->m_thread = std::thread(&RadioAstronomySpectrometer::run, this, partition);
+        }
+    }
+
+    reset();
+}
+
+void RadioAstronomySpectrometer::reset()
+{
+    m_bufferFill = 0;
+    clearPower();
+}
+
+void RadioAstronomySpectrometer::clearPower()
+{
+    std::fill(m_sum.begin(), m_sum.end(), 0.0);
+
+    for (auto partition : m_partitions) {
+        std::fill(partition->m_batchSum.begin(), partition->m_batchSum.end(), 0.0f);
+    }
+}
+
+void RadioAstronomySpectrometer::integrate(int nbFrames)
+{
+    if (nbFrames <= 0) {
+        return;
+    }
+
+    int nbPartitions = std::min(nbFrames, (int) m_partitions.size());
+    int firstFrame = 0;
+
+    for (int i = 0; i < nbPartitions; i++)
+    {
+        Partition *partition = m_partitions[i];
+        partition->m_firstFrame = firstFrame;
+        partition->m_nbFrames = (nbFrames * (i + 1)) / nbPartitions - firstFrame;
+        firstFrame += partition->m_nbFrames;
+
+        if (i > 0) {
+            partition->m_start.release();
+        }
+    }
+
+    processFrames(m_partitions[0]);
+
+    for (int i = 1; i < nbPartitions; i++) {
+        m_partitions[i]->m_done.acquire();
+    }
+
+    // Add batch sums to the integration
+    for (int i = 0; i < nbPartitions; i++)
+    {
+        float *batchSum = m_partitions[i]->m_batchSum.data();
+
+        for (int j = 0; j < m_fftSize; j++) {
+            m_sum[j] += batchSum[j];
+        }
+
+        std::fill(batchSum, batchSum + m_fftSize, 0.0f);
+    }
+
+    // Keep samples that have not been used and history needed by the next frame
+    int consumed = nbFrames * m_fftSize;
+    std::copy(m_buffer.begin() + consumed, m_buffer.begin() + m_bufferFill, m_buffer.begin());
+    m_bufferFill -= consumed;
+}
+
+void RadioAstronomySpectrometer::getPower(Real *power, Real scale)
+{
+    for (int i = 0; i < m_fftSize; i++) {
+        power[i] = m_sum[i] * scale;
+    }
+}
+
+void RadioAstronomySpectrometer::run(Partition *partition)
+{
+    while (true)
+    {
+        partition->m_start.acquire();
+
+        if (partition->m_stop) {
+            break;
+        }
+
+        processFrames(partition);
+        partition->m_done.release();
+    }
+}
+
+void RadioAstronomySpectrometer::processFrames(Partition *partition)
+{
+    // Complex data is accessed as interleaved floats
+    const float *coefficients = m_coefficients.data();
+    float *in = reinterpret_cast<float*>(partition->m_fft->in());
+    const float *out = reinterpret_cast<const float*>(partition->m_fft->out());
+    float *batchSum = partition->m_batchSum.data();
+    int n = 2 * m_fftSize;
+
+    for (int frame = partition->m_firstFrame; frame < partition->m_firstFrame + partition->m_nbFrames; frame++)
+    {
+        const float *samples = reinterpret_cast<const float*>(&m_buffer[frame * m_fftSize]);
+
+        // Polyphase front end: weight and sum taps blocks
+        multiply(in, samples, coefficients, n);
+
+        for (int tap = 1; tap < m_taps; tap++) {
+            multiplyAccumulate(in, samples + tap * n, coefficients + tap * n, n);
+        }
+
+        partition->m_fft->transform();
+        accumulatePower(batchSum, out, m_fftSize);
+    }
+}
+
+void RadioAstronomySpectrometer::multiply(float *dst, const float *src, const float *coefficients, int n)
+{
+    int i = 0;
+#if defined(__AVX__)
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(coefficients + i)));
+    }
+#elif defined(USE_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(coefficients + i)));
+    }
+#elif defined(USE_NEON)
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmulq_f32(vld1q_f32(src + i), vld1q_f32(coefficients + i)));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] = src[i] * coefficients[i];
+    }
+}
+
+void RadioAstronomySpectrometer::multiplyAccumulate(float *dst, const float *src, const float *coefficients, int n)
+{
+    int i = 0;
+#if defined(__AVX__)
+    for (; i + 8 <= n; i += 8)
+    {
+#if defined(__FMA__)
+        __m256 acc = _mm256_fmadd_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(coefficients + i), _mm256_loadu_ps(dst + i));
+#else
+        __m256 acc = _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(coefficients + i)));
+#endif
+        _mm256_storeu_ps(dst + i, acc);
+    }
+#elif defined(USE_SSE2)
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 acc = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(coefficients + i)));
+        _mm_storeu_ps(dst + i, acc);
+    }
+#elif defined(USE_NEON)
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), vld1q_f32(coefficients + i)));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] += src[i] * coefficients[i];
+    }
+}
+
+void RadioAstronomySpectrometer::accumulatePower(float *sum, const float *fft, int fftSize)
+{
+    int i = 0;
+#if defined(USE_SSE2) || defined(__AVX__)
+    for (; i + 4 <= fftSize; i += 4)
+    {
+        __m128 a = _mm_loadu_ps(fft + 2*i);
+        __m128 b = _mm_loadu_ps(fft + 2*i + 4);
+        __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 mag2 = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+        _mm_storeu_ps(sum + i, _mm_add_ps(_mm_loadu_ps(sum + i), mag2));
+    }
+#elif defined(USE_NEON)
+    for (; i + 4 <= fftSize; i += 4)
+    {
+        float32x4x2_t c = vld2q_f32(fft + 2*i); // De-interleaves I and Q
+        float32x4_t mag2 = vmlaq_f32(vmulq_f32(c.val[0], c.val[0]), c.val[1], c.val[1]);
+        vst1q_f32(sum + i, vaddq_f32(vld1q_f32(sum + i), mag2));
+    }
+#endif
+    for (; i < fftSize; i++) {
+        sum[i] += fft[2*i] * fft[2*i] + fft[2*i+1] * fft[2*i+1];
+    }
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB                                   //
+// Copyright (C) 2021 Jon Beniston, M7RCE                                        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_RADIOASTRONOMYSPECTROMETER_H
+#define INCLUDE_RADIOASTRONOMYSPECTROMETER_H
+
+#include <thread>
+#include <vector>
+
+#include <QList>
+#include <QSemaphore>
+
+#include "dsp/dsptypes.h"
+#include "dsp/fftwindow.h"
+
+class FFTEngine;
+
+// Spectrometer used by RadioAstronomySink to integrate power spectra.
+// With one tap, this is a plain windowed FFT. With more than one tap, a polyphase
+// filter bank (PFB) front end is used: each FFT input is the sum of taps consecutive
+// FFT sized blocks weighted by a windowed sinc, which gives flat topped bins with
+// much lower leakage between them than a windowed FFT.
+// Frames are processed in batches and each batch can be split between several threads,
+// each with its own FFT engine and accumulator.
+class RadioAstronomySpectrometer
+{
+public:
+    RadioAstronomySpectrometer();
+    ~RadioAstronomySpectrometer();
+
+    void configure(int fftSize, int taps, FFTWindow::Function window, int nbThreads);
+    void reset();               //!< Clear input history and accumulated power
+    void clearPower();          //!< Clear accumulated power, keeping input history for the next frame
+    int getFFTSize() const { return m_fftSize; }
+
+    //! Add a sample. Returns the number of complete frames that can be integrated
+    int write(const Complex& c)
+    {
+        m_buffer[m_bufferFill++] = c;
+        return m_bufferFill < m_historySize ? 0 : (m_bufferFill - m_historySize) / m_fftSize;
+    }
+
+    int getMaxBatchFrames() const { return m_maxBatchFrames; }
+    void integrate(int nbFrames); //!< Integrate nbFrames frames from the input buffer
+    void getPower(Real *power, Real scale); //!< Get scaled sum of power for all frames integrated since cleared, FFT order
+
+private:
+    struct Partition
+    {
+        FFTEngine *m_fft;
+        unsigned int m_fftSequence;
+        std::vector<float> m_batchSum;  //!< Power summed over the frames of a batch
+        int m_firstFrame;
+        int m_nbFrames;
+        std::thread m_thread;
+        QSemaphore m_start;
+        QSemaphore m_done;
+        bool m_stop;
+    };
+
+    int m_fftSize;
+    int m_taps;
+    int m_historySize;          //!< (taps - 1) * fftSize samples retained between batches
+    int m_maxBatchFrames;
+    std::vector<Complex> m_buffer;
+    int m_bufferFill;
+    std::vector<float> m_coefficients; //!< taps * fftSize weights, each duplicated for I and Q
+    std::vector<double> m_sum;         //!< Power summed over batches. Double to not lose precision over long integrations
+    QList<Partition*> m_partitions;
+
+    void release();
+    void processFrames(Partition *partition);
+    void run(Partition *partition);
+    static void multiply(float *dst, const float *src, const float *coefficients, int n);           //!< dst = src * coefficients
+    static void multiplyAccumulate(float *dst, const float *src, const float *coefficients, int n); //!< dst += src * coefficients
+    static void accumulatePower(float *sum, const float *fft, int fftSize);                         //!< sum += |fft|^2
+};
+
+#endif // INCLUDE_RADIOASTRONOMYSPECTROMETER_H
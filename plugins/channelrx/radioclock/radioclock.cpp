@@ -120,7 +120,7 @@ uint32_t RadioClock::getNumberOfDeviceStreams() const
 void RadioClock::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
 {
     (void) firstOfBurst;
-    m_basebandSink->feed(begin, end);
+    m_basebandSink->feed(begin, end, m_timestamp);
 }
 
 void RadioClock::start()
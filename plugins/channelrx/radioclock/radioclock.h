@@ -70,20 +70,23 @@ public:
 
         QDateTime getDateTime() const { return m_dateTime; }
         RadioClockSettings::DST getDST() const { return m_dst; }
+        QDateTime getRxDateTime() const { return m_rxDateTime; }
 
-        static MsgDateTime* create(QDateTime dateTime, RadioClockSettings::DST dst = RadioClockSettings::DST::UNKNOWN)
+        static MsgDateTime* create(QDateTime dateTime, RadioClockSettings::DST dst = RadioClockSettings::DST::UNKNOWN, QDateTime rxDateTime = QDateTime())
         {
-            return new MsgDateTime(dateTime, dst);
+            return new MsgDateTime(dateTime, dst, rxDateTime);
         }
 
     private:
         QDateTime m_dateTime;
         RadioClockSettings::DST m_dst;
+        QDateTime m_rxDateTime; //!< Receive time of the second marker from the device sample clock
 
-        MsgDateTime(QDateTime dateTime, RadioClockSettings::DST dst) :
+        MsgDateTime(QDateTime dateTime, RadioClockSettings::DST dst, QDateTime rxDateTime) :
             Message(),
             m_dateTime(dateTime),
-            m_dst(dst)
+            m_dst(dst),
+            m_rxDateTime(rxDateTime)
         {
         }
     };
@@ -117,6 +120,7 @@ public:
 
     using BasebandSampleSink::feed;
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool po);
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { m_timestamp = timestamp; }
     virtual void start();
     virtual void stop();
     virtual void pushMessage(Message *msg) { m_inputMessageQueue.push(msg); }
@@ -185,6 +189,7 @@ private:
     DeviceAPI *m_deviceAPI;
     QThread m_thread;
     RadioClockBaseband* m_basebandSink;
+    SampleTimestamp m_timestamp; //!< Timestamp of next block fed
     RadioClockSettings m_settings;
     int m_basebandSampleRate; //!< stored from device message used when starting baseband sink
     qint64 m_centerFrequency;
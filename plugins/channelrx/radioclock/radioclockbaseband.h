@@ -66,7 +66,7 @@ public:
     void reset();
     void startWork();
     void stopWork();
-    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, const SampleTimestamp& timestamp);
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) {
         m_sink.getMagSqLevels(avg, peak, nbSamples);
@@ -33,6 +33,7 @@ RadioClockSink::RadioClockSink(RadioClock *radioClock) :
         m_radioClock(radioClock),
         m_channelSampleRate(RadioClockSettings::RADIOCLOCK_CHANNEL_SAMPLE_RATE),
         m_channelFrequencyOffset(0),
+        m_samplesSinceTimestamp(0),
         m_magsq(0.0),
         m_magsqSum(0.0),
         m_magsqPeak(0.0),
@@ -100,6 +101,7 @@ void RadioClockSink::sampleToScope(Complex sample)
 void RadioClockSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
     Complex ci;
+    m_samplesSinceTimestamp = 0;
 
     for (SampleVector::const_iterator it = begin; it != end; ++it)
     {
@@ -111,6 +113,7 @@ void RadioClockSink::feed(const SampleVector::const_iterator& begin, const Sampl
             while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
             {
                 processOneSample(ci);
+                m_samplesSinceTimestamp++;
                 m_interpolatorDistanceRemain += m_interpolatorDistance;
             }
         }
@@ -119,12 +122,23 @@ void RadioClockSink::feed(const SampleVector::const_iterator& begin, const Sampl
             if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
             {
                 processOneSample(ci);
+                m_samplesSinceTimestamp++;
                 m_interpolatorDistanceRemain += m_interpolatorDistance;
             }
         }
     }
 }
 
+// Receive time of the last second marker which is m_periodCount samples before the current one
+QDateTime RadioClockSink::secondMarkerDateTime() const
+{
+    if (m_timestamp.isValid()) {
+        return m_timestamp.getDateTime(m_samplesSinceTimestamp - m_periodCount, RadioClockSettings::RADIOCLOCK_CHANNEL_SAMPLE_RATE);
+    } else {
+        return QDateTime::currentDateTime().addMSecs(-m_periodCount * 1000LL / RadioClockSettings::RADIOCLOCK_CHANNEL_SAMPLE_RATE);
+    }
+}
+
 // Extract binary-coded decimal from time code - LSB first
 int RadioClockSink::bcd(int firstBit, int lastBit)
 {
@@ -307,7 +321,7 @@ void RadioClockSink::dcf77()
 
             if (getMessageQueueToChannel())
             {
-                RadioClock::MsgDateTime *msg = RadioClock::MsgDateTime::create(m_dateTime, m_dst);
+                RadioClock::MsgDateTime *msg = RadioClock::MsgDateTime::create(m_dateTime, m_dst, secondMarkerDateTime());
                 getMessageQueueToChannel()->push(msg);
             }
         }
@@ -473,7 +487,7 @@ void RadioClockSink::tdf(Complex &ci)
 
             if (getMessageQueueToChannel())
             {
-                RadioClock::MsgDateTime *msg = RadioClock::MsgDateTime::create(m_dateTime, m_dst);
+                RadioClock::MsgDateTime *msg = RadioClock::MsgDateTime::create(m_dateTime, m_dst, secondMarkerDateTime());
                 getMessageQueueToChannel()->push(msg);
             }
         }
@@ -615,7 +629,7 @@ void RadioClockSink::msf60()
 
             if (getMessageQueueToChannel())
             {
-                RadioClock::MsgDateTime *msg = RadioClock::MsgDateTime::create(m_dateTime, m_dst);
+                RadioClock::MsgDateTime *msg = RadioClock::MsgDateTime::create(m_dateTime, m_dst, secondMarkerDateTime());
                 getMessageQueueToChannel()->push(msg);
             }
         }
@@ -781,7 +795,7 @@ void RadioClockSink::wwvb()
 
             if (getMessageQueueToChannel())
             {
-                RadioClock::MsgDateTime *msg = RadioClock::MsgDateTime::create(m_dateTime, m_dst);
+                RadioClock::MsgDateTime *msg = RadioClock::MsgDateTime::create(m_dateTime, m_dst, secondMarkerDateTime());
                 getMessageQueueToChannel()->push(msg);
             }
         }
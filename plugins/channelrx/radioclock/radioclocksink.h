@@ -50,6 +50,7 @@ public:
     ~RadioClockSink();
 
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { m_timestamp = timestamp; }
 
     void setScopeSink(ScopeVis* scopeSink);
     void applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force = false);
@@ -100,6 +101,8 @@ private:
     Interpolator m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
+    SampleTimestamp m_timestamp;        //!< Timestamp of first sample of the block being fed
+    qint64 m_samplesSinceTimestamp;     //!< Samples processed since m_timestamp at channel sample rate
 
     double m_magsq;
     double m_magsqSum;
@@ -147,6 +150,7 @@ private:
     bool m_gotMarker;       //!< Marker in previous second
 
     void processOneSample(Complex &ci);
+    QDateTime secondMarkerDateTime() const;
     MessageQueue *getMessageQueueToChannel() { return m_messageQueueToChannel; }
     void sampleToScope(Complex sample);
     int bcd(int firstBit, int lastBit);
@@ -34,7 +34,6 @@
 #include "ais.h"
 #include "aisgui.h"
 
-#include "SWGMapItem.h"
 
 // Models to use for ships when type is unknown
 // Use as many as possibly, so it doesn't look too samey, but don't use
@@ -431,41 +430,39 @@ void AISGUI::sendToMap(const QString &name, const QString &label,
     QList<ObjectPipe*> mapPipes;
     MainCore::instance()->getMessagePipes().getMessagePipes(m_ais, "mapitems", mapPipes);
 
-    for (const auto& pipe : mapPipes)
-    {
-        MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
-        SWGSDRangel::SWGMapItem *swgMapItem = new SWGSDRangel::SWGMapItem();
-        swgMapItem->setName(new QString(name));
-        swgMapItem->setLatitude(latitude);
-        swgMapItem->setLongitude(longitude);
-        swgMapItem->setAltitude(0);
-        swgMapItem->setAltitudeReference(1); // CLAMP_TO_GROUND
-
-        if (positionDateTime.isValid()) {
-            swgMapItem->setPositionDateTime(new QString(positionDateTime.toString(Qt::ISODateWithMs)));
-        }
+    if (mapPipes.size() == 0) {
+        return;
+    }
 
-        swgMapItem->setImageRotation(heading);
-        swgMapItem->setText(new QString(text));
+    QVector<MapItemData> mapItems(1);
+    MapItemData& mapItem = mapItems[0];
+    mapItem.m_name = name;
+    mapItem.m_latitude = latitude;
+    mapItem.m_longitude = longitude;
+    mapItem.m_altitude = 0;
+    mapItem.m_altitudeReference = 1; // CLAMP_TO_GROUND
+    mapItem.m_positionDateTime = positionDateTime;
+    mapItem.m_imageRotation = heading;
+    mapItem.m_text = text;
 
-        if (image.isEmpty()) {
-            swgMapItem->setImage(new QString(""));
-        } else {
-            swgMapItem->setImage(new QString(QString("qrc:///ais/map/%1").arg(image)));
-        }
+    if (!image.isEmpty()) {
+        mapItem.setImage(QString("qrc:///ais/map/%1").arg(image));
+    }
+
+    mapItem.setModel(model);
+    mapItem.m_modelAltitudeOffset = modelOffset;
+    mapItem.m_label = label;
+    mapItem.m_labelAltitudeOffset = labelOffset;
+    mapItem.m_fixedPosition = false;
+    mapItem.m_orientation = 1;
+    mapItem.m_heading = heading;
+    mapItem.m_pitch = 0.0;
+    mapItem.m_roll = 0.0;
 
-        swgMapItem->setModel(new QString(model));
-        swgMapItem->setModelAltitudeOffset(modelOffset);
-        swgMapItem->setLabel(new QString(label));
-        swgMapItem->setLabelAltitudeOffset(labelOffset);
-        swgMapItem->setFixedPosition(false);
-        swgMapItem->setOrientation(1);
-        swgMapItem->setHeading(heading);
-        swgMapItem->setPitch(0.0);
-        swgMapItem->setRoll(0.0);
-
-        MainCore::MsgMapItem *msg = MainCore::MsgMapItem::create(m_ais, swgMapItem);
-        messageQueue->push(msg);
+    for (const auto& pipe : mapPipes)
+    {
+        MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
+        messageQueue->push(MainCore::MsgMapItems::create(m_ais, mapItems));
     }
 }
 
@@ -28,7 +28,6 @@
 #include <QtCharts/QDateTimeAxis>
 #include <QtCharts/QValueAxis>
 
-#include "SWGMapItem.h"
 
 #include "feature/featureuiset.h"
 #include "feature/featurewebapiutils.h"
@@ -343,45 +342,41 @@ bool APRSGUI::handleMessage(const Message& message)
                     QList<ObjectPipe*> mapPipes;
                     MainCore::instance()->getMessagePipes().getMessagePipes(m_aprs, "mapitems", mapPipes);
 
-                    for (const auto& pipe : mapPipes)
+                    if (mapPipes.size() > 0)
                     {
-                        MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
-                        SWGSDRangel::SWGMapItem *swgMapItem = new SWGSDRangel::SWGMapItem();
+                        QVector<MapItemData> mapItems(1);
+                        MapItemData& mapItem = mapItems[0];
 
                         if (!aprs->m_objectName.isEmpty()) {
-                            swgMapItem->setName(new QString(aprs->m_objectName));
+                            mapItem.m_name = aprs->m_objectName;
                         } else {
-                            swgMapItem->setName(new QString(aprs->m_from));
+                            mapItem.m_name = aprs->m_from;
                         }
 
-                        swgMapItem->setLatitude(aprs->m_latitude);
-                        swgMapItem->setLongitude(aprs->m_longitude);
-                        swgMapItem->setAltitude(aprs->m_hasAltitude ? Units::feetToMetres(aprs->m_altitudeFt) : 0);
-                        swgMapItem->setAltitudeReference(1); // CLAMP_TO_GROUND
+                        mapItem.m_latitude = aprs->m_latitude;
+                        mapItem.m_longitude = aprs->m_longitude;
+                        mapItem.m_altitude = aprs->m_hasAltitude ? Units::feetToMetres(aprs->m_altitudeFt) : 0;
+                        mapItem.m_altitudeReference = 1; // CLAMP_TO_GROUND
 
-                        if (aprs->m_objectKilled)
+                        if (!aprs->m_objectKilled)
                         {
-                            swgMapItem->setImage(new QString(""));
-                            swgMapItem->setText(new QString(""));
+                            mapItem.setImage(QString("qrc:///%1").arg(aprs->m_symbolImage));
+                            mapItem.m_text = aprs->toText(
+                                true,
+                                false,
+                                '\n',
+                                m_settings.m_altitudeUnits == APRSSettings::METRES,
+                                (int)m_settings.m_speedUnits,
+                                m_settings.m_temperatureUnits == APRSSettings::CELSIUS,
+                                m_settings.m_rainfallUnits == APRSSettings::MILLIMETRE
+                            );
                         }
-                        else
+
+                        for (const auto& pipe : mapPipes)
                         {
-                            swgMapItem->setImage(new QString(QString("qrc:///%1").arg(aprs->m_symbolImage)));
-                            swgMapItem->setText(new QString(
-                                aprs->toText(
-                                    true,
-                                    false,
-                                    '\n',
-                                    m_settings.m_altitudeUnits == APRSSettings::METRES,
-                                    (int)m_settings.m_speedUnits,
-                                    m_settings.m_temperatureUnits == APRSSettings::CELSIUS,
-                                    m_settings.m_rainfallUnits == APRSSettings::MILLIMETRE
-                                )
-                            ));
+                            MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
+                            messageQueue->push(MainCore::MsgMapItems::create(m_aprs, mapItems));
                         }
-
-                        MainCore::MsgMapItem *msg = MainCore::MsgMapItem::create(m_aprs, swgMapItem);
-                        messageQueue->push(msg);
                     }
                 }
             }
@@ -21,7 +21,8 @@
 
 CesiumInterface::CesiumInterface(const MapSettings *settings, QObject *parent) :
     MapWebSocketServer(parent),
-    m_czml(settings)
+    m_czml(settings),
+    m_batching(false)
 {
 }
 
@@ -234,5 +235,34 @@ void CesiumInterface::czml(QJsonObject &obj)
 void CesiumInterface::update(MapItem *mapItem, bool isTarget, bool isSelected)
 {
     QJsonObject obj = m_czml.update(mapItem, isTarget, isSelected);
-    czml(obj);
+    if (m_batching) {
+        m_batch.append(obj);
+    } else {
+        czml(obj);
+    }
+}
+
+void CesiumInterface::beginBatch()
+{
+    m_batching = true;
+}
+
+// Send CZML packets of all updates since beginBatch in a single message
+void CesiumInterface::endBatch()
+{
+    m_batching = false;
+    if (m_batch.size() == 1)
+    {
+        QJsonObject obj = m_batch[0].toObject();
+        czml(obj);
+    }
+    else if (m_batch.size() > 1)
+    {
+        QJsonObject obj {
+            {"command", "czmlBatch"},
+            {"packets", m_batch}
+        };
+        send(obj);
+    }
+    m_batch = QJsonArray();
 }
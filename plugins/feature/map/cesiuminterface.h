@@ -18,9 +18,11 @@
 #ifndef INCLUDE_FEATURE_CESIUMINTERFACE_H_
 #define INCLUDE_FEATURE_CESIUMINTERFACE_H_
 
+#include <QJsonArray>
+
 #include "mapwebsocketserver.h"
 #include "czml.h"
-#include "SWGMapAnimation.h"
+#include "util/mapitemdata.h"
 
 class MapItem;
 
@@ -29,16 +31,16 @@ class CesiumInterface : public MapWebSocketServer
 public:
 
     struct Animation {
-        Animation(SWGSDRangel::SWGMapAnimation *swgAnimation)
+        Animation(const MapItemData::Animation& animation)
         {
-            m_name = *swgAnimation->getName();
-            m_startDateTime = *swgAnimation->getStartDateTime();
-            m_reverse = swgAnimation->getReverse();
-            m_loop =  swgAnimation->getLoop();
-            m_stop =  swgAnimation->getStop();
-            m_startOffset =  swgAnimation->getStartOffset();
-            m_duration =  swgAnimation->getDuration();
-            m_multiplier =  swgAnimation->getMultiplier();
+            m_name = animation.m_name;
+            m_startDateTime = animation.m_startDateTime;
+            m_reverse = animation.m_reverse;
+            m_loop = animation.m_loop;
+            m_stop = animation.m_stop;
+            m_startOffset = animation.m_startOffset;
+            m_duration = animation.m_duration;
+            m_multiplier = animation.m_multiplier;
         }
 
         QString m_name;
@@ -73,10 +75,14 @@ public:
     void initCZML();
     void czml(QJsonObject &obj);
     void update(MapItem *mapItem, bool isTarget, bool isSelected);
+    void beginBatch();  // Following updates are sent together by endBatch
+    void endBatch();
 
 protected:
 
     CZML m_czml;
+    bool m_batching;
+    QJsonArray m_batch;
 };
 
 #endif // INCLUDE_FEATURE_CESIUMINTERFACE_H_
@@ -26,6 +26,7 @@
 #include "SWGFeatureReport.h"
 #include "SWGFeatureActions.h"
 #include "SWGDeviceState.h"
+#include "SWGMapItem.h"
 
 #include "dsp/dspengine.h"
 
@@ -111,9 +112,27 @@ bool Map::handleMessage(const Message& cmd)
     else if (MainCore::MsgMapItem::match(cmd))
     {
         // qDebug() << "Map::handleMessage: MsgMapItem";
+        // Web API form converted once here so the GUI only deals with MapItemData
         MainCore::MsgMapItem& msgMapItem = (MainCore::MsgMapItem&) cmd;
-        MainCore::MsgMapItem *copy = new MainCore::MsgMapItem(msgMapItem);
-        getMessageQueueToGUI()->push(copy);
+        SWGSDRangel::SWGMapItem *swgMapItem = msgMapItem.getSWGMapItem();
+        QVector<MapItemData> mapItems(1);
+        mapItems[0].fromSWGMapItem(swgMapItem);
+        delete swgMapItem;
+
+        if (getMessageQueueToGUI()) {
+            getMessageQueueToGUI()->push(MainCore::MsgMapItems::create(msgMapItem.getPipeSource(), mapItems));
+        }
+
+        return true;
+    }
+    else if (MainCore::MsgMapItems::match(cmd))
+    {
+        MainCore::MsgMapItems& msgMapItems = (MainCore::MsgMapItems&) cmd;
+
+        if (getMessageQueueToGUI()) {
+            getMessageQueueToGUI()->push(MainCore::MsgMapItems::create(msgMapItems.getPipeSource(), msgMapItems.getMapItems()));
+        }
+
         return true;
     }
     else
@@ -93,6 +93,7 @@ Item {
 
             onZoomLevelChanged: {
                 mapZoomLevel = zoomLevel
+                mapModel.viewChanged(visibleRegion.boundingGeoRectangle().bottomLeft.longitude, visibleRegion.boundingGeoRectangle().bottomRight.longitude);
             }
 
             // The map displays MapPolyLines in the wrong place (+360 degrees) if
@@ -118,17 +118,16 @@ bool MapGUI::handleMessage(const Message& message)
         }
         return true;
     }
-    else if (MainCore::MsgMapItem::match(message))
+    else if (MainCore::MsgMapItems::match(message))
     {
-        MainCore::MsgMapItem& msgMapItem = (MainCore::MsgMapItem&) message;
-        SWGSDRangel::SWGMapItem *swgMapItem = msgMapItem.getSWGMapItem();
+        MainCore::MsgMapItems& msgMapItems = (MainCore::MsgMapItems&) message;
 
         // TODO: Could have this in SWGMapItem so plugins can create additional groups
         QString group;
 
         for (int i = 0; i < m_availableChannelOrFeatures.size(); i++)
         {
-            if (m_availableChannelOrFeatures[i].m_source == msgMapItem.getPipeSource())
+            if (m_availableChannelOrFeatures[i].m_source == msgMapItems.getPipeSource())
             {
                  for (int j = 0; j < MapSettings::m_pipeTypes.size(); j++)
                  {
@@ -139,7 +138,10 @@ bool MapGUI::handleMessage(const Message& message)
             }
         }
 
-        update(msgMapItem.getPipeSource(), swgMapItem, group);
+        for (const auto& mapItem : msgMapItems.getMapItems()) {
+            update(msgMapItems.getPipeSource(), mapItem, group);
+        }
+
         return true;
     }
 
@@ -316,27 +318,32 @@ void MapGUI::setWorkspaceIndex(int index)
 // Update a map item or image
 void MapGUI::update(const QObject *source, SWGSDRangel::SWGMapItem *swgMapItem, const QString &group)
 {
-    if (swgMapItem->getType() == 0)
+    MapItemData mapItem;
+    mapItem.fromSWGMapItem(swgMapItem);
+    update(source, mapItem, group);
+}
+
+void MapGUI::update(const QObject *source, const MapItemData& mapItem, const QString &group)
+{
+    if (mapItem.m_type == 0)
     {
-        m_mapModel.update(source, swgMapItem, group);
+        m_mapModel.update(source, mapItem, group);
     }
     else if (m_cesium)
     {
-        QString name = *swgMapItem->getName();
-        QString image = *swgMapItem->getImage();
-        if (!image.isEmpty())
+        if (!mapItem.m_image.isEmpty())
         {
-            m_cesium->updateImage(name,
-                                swgMapItem->getImageTileEast(),
-                                swgMapItem->getImageTileWest(),
-                                swgMapItem->getImageTileNorth(),
-                                swgMapItem->getImageTileSouth(),
-                                swgMapItem->getAltitude(),
-                                image);
+            m_cesium->updateImage(mapItem.m_name,
+                                mapItem.m_imageTileEast,
+                                mapItem.m_imageTileWest,
+                                mapItem.m_imageTileNorth,
+                                mapItem.m_imageTileSouth,
+                                mapItem.m_altitude,
+                                mapItem.m_image);
         }
         else
         {
-            m_cesium->removeImage(name);
+            m_cesium->removeImage(mapItem.m_name);
         }
     }
 }
@@ -189,6 +189,7 @@ private:
     virtual ~MapGUI();
 
     void update(const QObject *source, SWGSDRangel::SWGMapItem *swgMapItem, const QString &group);
+    void update(const QObject *source, const MapItemData& mapItem, const QString &group);
     void blockApplySettings(bool block);
     void applySettings(bool force = false);
     void applyMap2DSettings(bool reloadMap);
@@ -15,6 +15,10 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
 #include <QGeoRectangle>
 
 #include "channel/channelwebapiutils.h"
@@ -26,67 +30,55 @@
 
 #include "SWGTargetAzimuthElevation.h"
 
-MapItem::MapItem(const QObject *sourcePipe, const QString &group, MapSettings::MapItemSettings *itemSettings, SWGSDRangel::SWGMapItem *mapItem) :
-    m_altitude(0.0)
+MapItem::MapItem(const QObject *sourcePipe, const QString &group, MapSettings::MapItemSettings *itemSettings, const MapItemData& mapItem) :
+    m_altitude(0.0),
+    m_row(-1),
+    m_cell(-1),
+    m_inView(true)
 {
     m_sourcePipe = sourcePipe;
     m_group = group;
     m_itemSettings = itemSettings;
-    m_name = *mapItem->getName();
+    m_name = mapItem.m_name;
     update(mapItem);
 }
 
-void MapItem::update(SWGSDRangel::SWGMapItem *mapItem)
+MapItem::~MapItem()
 {
-    if (mapItem->getLabel()) {
-        m_label = *mapItem->getLabel();
-    } else {
-        m_label = "";
-    }
-    m_latitude = mapItem->getLatitude();
-    m_longitude = mapItem->getLongitude();
-    m_altitude = mapItem->getAltitude();
-    if (mapItem->getPositionDateTime()) {
-        m_positionDateTime = QDateTime::fromString(*mapItem->getPositionDateTime(), Qt::ISODateWithMs);
-    } else {
-        m_positionDateTime = QDateTime();
-    }
-    m_useHeadingPitchRoll = mapItem->getOrientation() == 1;
-    m_heading = mapItem->getHeading();
-    m_pitch = mapItem->getPitch();
-    m_roll = mapItem->getRoll();
-    if (mapItem->getOrientationDateTime()) {
-        m_orientationDateTime = QDateTime::fromString(*mapItem->getOrientationDateTime(), Qt::ISODateWithMs);
-    } else {
-        m_orientationDateTime = QDateTime();
-    }
-    m_image = *mapItem->getImage();
-    m_imageRotation = mapItem->getImageRotation();
-    QString *text = mapItem->getText();
-    if (text != nullptr) {
-        m_text = text->replace("\n", "<br>");  // Convert to HTML
-    } else {
-        m_text = "";
-    }
-    if (mapItem->getModel()) {
-        m_model = *mapItem->getModel();
-    } else {
-        m_model = "";
-    }
-    m_labelAltitudeOffset = mapItem->getLabelAltitudeOffset();
-    m_modelAltitudeOffset = mapItem->getModelAltitudeOffset();
-    m_altitudeReference = mapItem->getAltitudeReference();
-    m_fixedPosition = mapItem->getFixedPosition();
-    QList<SWGSDRangel::SWGMapAnimation *> *animations = mapItem->getAnimations();
-    if (animations)
-    {
-        for (auto animation : *animations) {
-            m_animations.append(new CesiumInterface::Animation(animation));
-        }
+    qDeleteAll(m_predictedTrackCoords);
+    qDeleteAll(m_predictedTrackDateTimes);
+    qDeleteAll(m_takenTrackCoords);
+    qDeleteAll(m_takenTrackDateTimes);
+    qDeleteAll(m_animations);
+}
+
+void MapItem::update(const MapItemData& mapItem)
+{
+    m_label = mapItem.m_label;
+    m_latitude = mapItem.m_latitude;
+    m_longitude = mapItem.m_longitude;
+    m_altitude = mapItem.m_altitude;
+    m_positionDateTime = mapItem.m_positionDateTime;
+    m_useHeadingPitchRoll = mapItem.m_orientation == 1;
+    m_heading = mapItem.m_heading;
+    m_pitch = mapItem.m_pitch;
+    m_roll = mapItem.m_roll;
+    m_orientationDateTime = mapItem.m_orientationDateTime;
+    m_image = mapItem.m_image;
+    m_imageRotation = mapItem.m_imageRotation;
+    m_text = mapItem.m_text;
+    m_text.replace("\n", "<br>");  // Convert to HTML
+    m_model = mapItem.m_model;
+    m_labelAltitudeOffset = mapItem.m_labelAltitudeOffset;
+    m_modelAltitudeOffset = mapItem.m_modelAltitudeOffset;
+    m_altitudeReference = mapItem.m_altitudeReference;
+    m_fixedPosition = mapItem.m_fixedPosition;
+    for (const auto& animation : mapItem.m_animations) {
+        m_animations.append(new CesiumInterface::Animation(animation));
     }
     findFrequency();
-    updateTrack(mapItem->getTrack());
-    updatePredictedTrack(mapItem->getPredictedTrack());
+    updateTrack(mapItem.m_hasTrack, mapItem.m_track);
+    updatePredictedTrack(mapItem.m_hasPredictedTrack, mapItem.m_predictedTrack);
 }
 
 QGeoCoordinate MapItem::getCoordinates()
@@ -123,9 +115,9 @@ void MapItem::findFrequency()
     }
 }
 
-void MapItem::updateTrack(QList<SWGSDRangel::SWGMapCoordinate *> *track)
+void MapItem::updateTrack(bool hasTrack, const QVector<MapItemData::Coordinate>& track)
 {
-    if (track != nullptr)
+    if (hasTrack)
     {
         qDeleteAll(m_takenTrackCoords);
         m_takenTrackCoords.clear();
@@ -134,11 +126,10 @@ void MapItem::updateTrack(QList<SWGSDRangel::SWGMapCoordinate *> *track)
         m_takenTrack.clear();
         m_takenTrack1.clear();
         m_takenTrack2.clear();
-        for (int i = 0; i < track->size(); i++)
+        for (const auto& p : track)
         {
-            SWGSDRangel::SWGMapCoordinate* p = track->at(i);
-            QGeoCoordinate *c = new QGeoCoordinate(p->getLatitude(), p->getLongitude(), p->getAltitude());
-            QDateTime *d = new QDateTime(QDateTime::fromString(*p->getDateTime(), Qt::ISODate));
+            QGeoCoordinate *c = new QGeoCoordinate(p.m_latitude, p.m_longitude, p.m_altitude);
+            QDateTime *d = new QDateTime(p.m_dateTime);
             m_takenTrackCoords.push_back(c);
             m_takenTrackDateTimes.push_back(d);
             m_takenTrack.push_back(QVariant::fromValue(*c));
@@ -178,9 +169,9 @@ void MapItem::updateTrack(QList<SWGSDRangel::SWGMapCoordinate *> *track)
     }
 }
 
-void MapItem::updatePredictedTrack(QList<SWGSDRangel::SWGMapCoordinate *> *track)
+void MapItem::updatePredictedTrack(bool hasTrack, const QVector<MapItemData::Coordinate>& track)
 {
-    if (track != nullptr)
+    if (hasTrack)
     {
         qDeleteAll(m_predictedTrackCoords);
         m_predictedTrackCoords.clear();
@@ -189,11 +180,10 @@ void MapItem::updatePredictedTrack(QList<SWGSDRangel::SWGMapCoordinate *> *track
         m_predictedTrack.clear();
         m_predictedTrack1.clear();
         m_predictedTrack2.clear();
-        for (int i = 0; i < track->size(); i++)
+        for (const auto& p : track)
         {
-            SWGSDRangel::SWGMapCoordinate* p = track->at(i);
-            QGeoCoordinate *c = new QGeoCoordinate(p->getLatitude(), p->getLongitude(), p->getAltitude());
-            QDateTime *d = new QDateTime(QDateTime::fromString(*p->getDateTime(), Qt::ISODate));
+            QGeoCoordinate *c = new QGeoCoordinate(p.m_latitude, p.m_longitude, p.m_altitude);
+            QDateTime *d = new QDateTime(p.m_dateTime);
             m_predictedTrackCoords.push_back(c);
             m_predictedTrackDateTimes.push_back(d);
             m_predictedTrack.push_back(QVariant::fromValue(*c));
@@ -201,76 +191,280 @@ void MapItem::updatePredictedTrack(QList<SWGSDRangel::SWGMapCoordinate *> *track
     }
 }
 
+MapSpatialIndex::MapSpatialIndex() :
+    m_cells(m_nbLatCells * m_nbLonCells)
+{
+}
+
+int MapSpatialIndex::getLatCell(double latitude)
+{
+    int cell = (int) std::floor((latitude + 90.0) / m_cellDegrees);
+    return cell < 0 ? 0 : cell >= m_nbLatCells ? m_nbLatCells - 1 : cell;
+}
+
+int MapSpatialIndex::getLonCell(double longitude)
+{
+    int cell = (int) std::floor((longitude + 180.0) / m_cellDegrees);
+    return cell < 0 ? 0 : cell >= m_nbLonCells ? m_nbLonCells - 1 : cell;
+}
+
+void MapSpatialIndex::insert(MapItem *item)
+{
+    item->m_cell = getCell(item->m_latitude, item->m_longitude);
+    m_cells[item->m_cell].insert(item);
+}
+
+void MapSpatialIndex::remove(MapItem *item)
+{
+    if (item->m_cell >= 0)
+    {
+        m_cells[item->m_cell].remove(item);
+        item->m_cell = -1;
+    }
+}
+
+void MapSpatialIndex::move(MapItem *item)
+{
+    int cell = getCell(item->m_latitude, item->m_longitude);
+
+    if (cell != item->m_cell)
+    {
+        remove(item);
+        item->m_cell = cell;
+        m_cells[cell].insert(item);
+    }
+}
+
+void MapSpatialIndex::clear()
+{
+    for (auto& cell : m_cells) {
+        cell.clear();
+    }
+}
+
+void MapSpatialIndex::query(double south, double west, double north, double east, QList<MapItem *>& items) const
+{
+    int latCell0 = getLatCell(south);
+    int latCell1 = getLatCell(north);
+    int lonCell0 = getLonCell(west);
+    int lonCell1 = getLonCell(east);
+    int nbLonCells = lonCell1 - lonCell0 + 1;
+
+    if ((west > east) || (nbLonCells <= 0)) {
+        nbLonCells += m_nbLonCells; // Crosses antimeridian
+    }
+    nbLonCells = std::min(nbLonCells, (int) m_nbLonCells);
+
+    for (int latCell = latCell0; latCell <= latCell1; latCell++)
+    {
+        for (int i = 0; i < nbLonCells; i++)
+        {
+            const QSet<MapItem *>& cell = m_cells[latCell * m_nbLonCells + (lonCell0 + i) % m_nbLonCells];
+
+            for (auto item : cell) {
+                items.append(item);
+            }
+        }
+    }
+}
+
 MapModel::MapModel(MapGUI *gui) :
     m_gui(gui),
+    m_flushing(false),
+    m_viewValid(false),
+    m_viewSouth(-90.0),
+    m_viewNorth(90.0),
+    m_viewWest(-180.0),
+    m_viewEast(180.0),
     m_target(-1)
 {
     connect(this, &MapModel::dataChanged, this, &MapModel::update3DMap);
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(m_flushIntervalMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &MapModel::flush);
 }
 
-Q_INVOKABLE void MapModel::add(MapItem *item)
+void MapModel::scheduleFlush()
+{
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void MapModel::appendRow(MapItem *item, bool selected)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
+    item->m_row = m_items.size();
     m_items.append(item);
-    m_selected.append(false);
+    m_selected.append(selected);
     endInsertRows();
 }
 
-void MapModel::update(const QObject *sourcePipe, SWGSDRangel::SWGMapItem *swgMapItem, const QString &group)
+void MapModel::takeRow(int row)
 {
-    QString name = *swgMapItem->getName();
+    beginRemoveRows(QModelIndex(), row, row);
+    m_items[row]->m_row = -1;
+    m_items.removeAt(row);
+    m_selected.removeAt(row);
+    for (int i = row; i < m_items.size(); i++) {
+        m_items[i]->m_row = i;
+    }
+    if (row == m_target) {
+        m_target = -1;
+    } else if (row < m_target) {
+        m_target--;
+    }
+    endRemoveRows();
+}
+
+Q_INVOKABLE void MapModel::add(MapItem *item)
+{
+    ItemKey key(item->m_sourcePipe, item->m_name);
+
+    if (!m_itemIndex.contains(key))
+    {
+        m_itemIndex.insert(key, item);
+        m_spatialIndex.insert(item);
+        setInView(item, isInView(item->m_latitude, item->m_longitude));
+    }
+
+    appendRow(item, false);
+}
+
+void MapModel::update(const QObject *sourcePipe, const MapItemData& mapItemData, const QString &group)
+{
+    const QString& name = mapItemData.m_name;
     // Add, update or delete and item
     MapItem *item = findMapItem(sourcePipe, name);
     if (item != nullptr)
     {
-        QString image = *swgMapItem->getImage();
-        if (image.isEmpty())
+        if (mapItemData.m_image.isEmpty())
         {
             // Delete the item
             remove(item);
             // Need to call update, for it to be removed in 3D map
             // Item is set to not be available from this point in time
             // It will still be available if time is set in the past
-            item->update(swgMapItem);
+            item->update(mapItemData);
+            m_pendingRemovals.append(item);
+            scheduleFlush();
         }
         else
         {
-            // Update the item
-            item->update(swgMapItem);
-            splitTracks(item);
+            // Update the item - tracks are split and maps updated on next flush
+            item->update(mapItemData);
             update(item);
         }
     }
     else
     {
         // Make sure not a duplicate request to delete
-        QString image = *swgMapItem->getImage();
-        if (!image.isEmpty())
+        if (!mapItemData.m_image.isEmpty())
         {
-            // Add new item
-            item = new MapItem(sourcePipe, group, m_gui->getItemSettings(group), swgMapItem);
-            add(item);
-            // Add to 3D Map (we don't appear to get a dataChanged signal when adding)
-            CesiumInterface *cesium = m_gui->cesium();
-            if (cesium) {
-                cesium->update(item, isTarget(item), isSelected3D(item));
-            }
-            playAnimations(item);
+            // Add new item - inserted into the model with others received in the same interval
+            item = new MapItem(sourcePipe, group, m_gui->getItemSettings(group), mapItemData);
+            m_itemIndex.insert(ItemKey(sourcePipe, name), item);
+            m_spatialIndex.insert(item);
+            setInView(item, isInView(item->m_latitude, item->m_longitude));
+            m_pendingAdds.append(item);
+            // Add to 3D Map (we don't get a dataChanged signal when adding)
+            m_dirty3D.insert(item);
+            scheduleFlush();
         }
     }
 }
 
+// Send all updates received since last flush to the 2D and 3D maps
+void MapModel::flush()
+{
+    m_flushTimer.stop();
+
+    if (!m_pendingAdds.isEmpty())
+    {
+        beginInsertRows(QModelIndex(), m_items.size(), m_items.size() + m_pendingAdds.size() - 1);
+        for (auto item : m_pendingAdds)
+        {
+            item->m_row = m_items.size();
+            m_items.append(item);
+            m_selected.append(false);
+        }
+        endInsertRows();
+        m_pendingAdds.clear();
+    }
+
+    if (!m_dirty3D.isEmpty())
+    {
+        updateMapRect();
+        for (auto item : m_dirty3D) {
+            splitTracks(item);
+        }
+    }
+
+    // 3D map: removals first, in case an item with the same name has been added again
+    CesiumInterface *cesium = m_gui->cesium();
+    if (cesium)
+    {
+        cesium->beginBatch();
+        for (auto item : m_pendingRemovals) {
+            cesium->update(item, false, false);
+        }
+        for (auto item : m_dirty3D) {
+            cesium->update(item, isTarget(item), isSelected3D(item));
+        }
+        cesium->endBatch();
+    }
+    for (auto item : m_dirty3D) {
+        playAnimations(item);
+    }
+    bool targetUpdated = (m_target >= 0) && m_dirty3D.contains(m_items[m_target]);
+    qDeleteAll(m_pendingRemovals);
+    m_pendingRemovals.clear();
+    m_dirty3D.clear();
+
+    // 2D map: a single range covering all the rows that changed
+    int first = INT_MAX;
+    int last = -1;
+    for (auto item : m_dirty2D)
+    {
+        if (item->m_row >= 0)
+        {
+            first = std::min(first, item->m_row);
+            last = std::max(last, item->m_row);
+        }
+    }
+    m_dirty2D.clear();
+
+    if (targetUpdated) {
+        updateTarget();
+    }
+
+    if (last >= 0)
+    {
+        // Already sent to 3D map
+        m_flushing = true;
+        emit dataChanged(index(first), index(last));
+        m_flushing = false;
+    }
+}
+
 // Slot called on dataChanged signal, to update 3D map
 void MapModel::update3DMap(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
 {
     (void) roles;
 
+    if (m_flushing) {
+        return;
+    }
+
     CesiumInterface *cesium = m_gui->cesium();
     if (cesium)
     {
-        for (int row = topLeft.row(); row <= bottomRight.row(); row++)
-        {
+        cesium->beginBatch();
+        for (int row = topLeft.row(); row <= bottomRight.row(); row++) {
             cesium->update(m_items[row], isTarget(m_items[row]), isSelected3D(m_items[row]));
+        }
+        cesium->endBatch();
+        for (int row = topLeft.row(); row <= bottomRight.row(); row++) {
             playAnimations(m_items[row]);
         }
     }
@@ -289,62 +483,75 @@ void MapModel::playAnimations(MapItem *item)
     item->m_animations.clear();
 }
 
+// Item has been updated: 2D and 3D maps are updated on next flush
 void MapModel::update(MapItem *item)
 {
-    int row = m_items.indexOf(item);
-    if (row >= 0)
+    m_spatialIndex.move(item);
+    setInView(item, isInView(item->m_latitude, item->m_longitude));
+    m_dirty3D.insert(item);
+    scheduleFlush();
+}
+
+// Item delegates on the 2D map only need refreshing when visible
+void MapModel::markDirty2D(MapItem *item)
+{
+    if (item->m_inView || ((item->m_row >= 0) && isTrackVisible(item->m_row)))
     {
-        QModelIndex idx = index(row);
-        emit dataChanged(idx, idx);
-        if (row == m_target) {
-            updateTarget();
-        }
+        m_dirty2D.insert(item);
+        scheduleFlush();
     }
 }
 
 void MapModel::remove(MapItem *item)
 {
-    int row = m_items.indexOf(item);
-    if (row >= 0)
-    {
-        beginRemoveRows(QModelIndex(), row, row);
-        m_items.removeAt(row);
-        m_selected.removeAt(row);
-        if (row == m_target) {
-            m_target = -1;
-        } else if (row < m_target) {
-            m_target--;
-        }
-        endRemoveRows();
+    if (item->m_row >= 0) {
+        takeRow(item->m_row);
+    } else {
+        m_pendingAdds.removeOne(item);
     }
+    m_itemIndex.remove(ItemKey(item->m_sourcePipe, item->m_name));
+    m_spatialIndex.remove(item);
+    m_inViewItems.remove(item);
+    m_dirty2D.remove(item);
+    m_dirty3D.remove(item);
 }
 
 void MapModel::allUpdated()
 {
-    for (int i = 0; i < m_items.count(); i++)
-    {
-        // Updates both 2D and 3D Map
-        QModelIndex idx = index(i);
-        emit dataChanged(idx, idx);
+    // Updates both 2D and 3D Map
+    if (m_items.count() > 0) {
+        emit dataChanged(index(0), index(m_items.count() - 1));
     }
 }
 
 void MapModel::removeAll()
 {
+    m_flushTimer.stop();
     if (m_items.count() > 0)
     {
-        beginRemoveRows(QModelIndex(), 0, m_items.count());
+        beginRemoveRows(QModelIndex(), 0, m_items.count() - 1);
+        qDeleteAll(m_items);
         m_items.clear();
         m_selected.clear();
+        m_target = -1;
         endRemoveRows();
     }
+    qDeleteAll(m_pendingAdds);
+    m_pendingAdds.clear();
+    qDeleteAll(m_pendingRemovals);
+    m_pendingRemovals.clear();
+    m_itemIndex.clear();
+    m_spatialIndex.clear();
+    m_inViewItems.clear();
+    m_dirty2D.clear();
+    m_dirty3D.clear();
 }
 
 // After new settings are deserialised, we need to update
 // pointers to item settings for all existing items
 void MapModel::updateItemSettings(QHash<QString, MapSettings::MapItemSettings *> m_itemSettings)
 {
-    for (auto item : m_items) {
+    for (auto item : m_itemIndex) {
         item->m_itemSettings = m_itemSettings[item->m_group];
     }
 }
@@ -404,13 +611,12 @@ Q_INVOKABLE void MapModel::moveToFront(int oldRow)
         bool wasTarget = m_target == oldRow;
         MapItem *item = m_items[oldRow];
         bool wasSelected = m_selected[oldRow];
-        remove(item);
-        add(item);
+        takeRow(oldRow);
+        appendRow(item, wasSelected);
         int newRow = m_items.size() - 1;
         if (wasTarget) {
             m_target = newRow;
         }
-        m_selected[newRow] = wasSelected;
         QModelIndex idx = index(newRow);
         emit dataChanged(idx, idx);
     }
@@ -429,6 +635,9 @@ Q_INVOKABLE void MapModel::moveToBack(int oldRow)
         beginResetModel();
         m_items.move(oldRow, newRow);
         m_selected.move(oldRow, newRow);
+        for (int i = newRow; i <= oldRow; i++) {
+            m_items[i]->m_row = i;
+        }
         if (wasTarget) {
             m_target = newRow;
         } else if (m_target >= 0) {
@@ -442,15 +651,7 @@ Q_INVOKABLE void MapModel::moveToBack(int oldRow)
 
 MapItem *MapModel::findMapItem(const QObject *source, const QString& name)
 {
-    // FIXME: Should consider adding a QHash for this
-    QListIterator<MapItem *> i(m_items);
-    while (i.hasNext())
-    {
-        MapItem *item = i.next();
-        if ((item->m_name == name) && (item->m_sourcePipe == source))
-            return item;
-    }
-    return nullptr;
+    return m_itemIndex.value(ItemKey(source, name), nullptr);
 }
 
 MapItem *MapModel::findMapItem(const QString& name)
@@ -527,11 +728,11 @@ QVariant MapModel::data(const QModelIndex &index, int role) const
     }
     else if (role == MapModel::mapTextVisibleRole)
     {
-        return QVariant::fromValue((m_selected[row] || m_displayNames) && m_items[row]->m_itemSettings->m_enabled && m_items[row]->m_itemSettings->m_display2DLabel);
+        return QVariant::fromValue((m_selected[row] || m_displayNames) && m_items[row]->m_inView && m_items[row]->m_itemSettings->m_enabled && m_items[row]->m_itemSettings->m_display2DLabel);
     }
     else if (role == MapModel::mapImageVisibleRole)
     {
-        return QVariant::fromValue(m_items[row]->m_itemSettings->m_enabled && m_items[row]->m_itemSettings->m_display2DIcon);
+        return QVariant::fromValue(m_items[row]->m_inView && m_items[row]->m_itemSettings->m_enabled && m_items[row]->m_itemSettings->m_display2DIcon);
     }
     else if (role == MapModel::mapImageRole)
     {
@@ -864,10 +1065,7 @@ void MapModel::splitTrack(const QList<QGeoCoordinate *>& coords, const QVariantL
     qDebug() << "Init T: " << l;
     */
 
-    QQuickItem* map = m_gui->getMapItem();
-    QVariant rectVariant;
-    QMetaObject::invokeMethod(map, "mapRect", Q_RETURN_ARG(QVariant, rectVariant));
-    QGeoRectangle rect = qvariant_cast<QGeoRectangle>(rectVariant);
+    const QGeoRectangle& rect = m_mapRect;
     double bottomLeftLongitude = rect.bottomLeft().longitude();
     double bottomRightLongitude = rect.bottomRight().longitude();
 
@@ -973,24 +1171,135 @@ void MapModel::viewChanged(double bottomLeftLongitude, double bottomRightLongitu
     (void) bottomRightLongitude;
     if (!std::isnan(bottomLeftLongitude))
     {
+        updateMapRect();
+        updateView();
         for (int row = 0; row < m_items.size(); row++)
         {
             MapItem *item = m_items[row];
-            if (item->m_takenTrackCoords.size() > 1)
+            if ((item->m_takenTrackCoords.size() > 1) || (item->m_predictedTrackCoords.size() > 1))
             {
-                splitTrack(item->m_takenTrackCoords, item->m_takenTrack, item->m_takenTrack1, item->m_takenTrack2,
-                                item->m_takenStart1, item->m_takenStart2, item->m_takenEnd1, item->m_takenEnd2);
-                QModelIndex idx = index(row);
-                emit dataChanged(idx, idx);
+                splitTracks(item);
+                m_dirty2D.insert(item);
+                scheduleFlush();
             }
-            if (item->m_predictedTrackCoords.size() > 1)
-            {
-                splitTrack(item->m_predictedTrackCoords, item->m_predictedTrack, item->m_predictedTrack1, item->m_predictedTrack2,
-                                item->m_predictedStart1, item->m_predictedStart2, item->m_predictedEnd1, item->m_predictedEnd2);
-                QModelIndex idx = index(row);
-                emit dataChanged(idx, idx);
+        }
+    }
+}
+
+// Get visible region of 2D map
+void MapModel::updateMapRect()
+{
+    QQuickItem* map = m_gui->getMapItem();
+    QVariant rectVariant;
+    QMetaObject::invokeMethod(map, "mapRect", Q_RETURN_ARG(QVariant, rectVariant));
+    m_mapRect = qvariant_cast<QGeoRectangle>(rectVariant);
+}
+
+bool MapModel::isTrackVisible(int row) const
+{
+    return (m_displayAllGroundTracks || (m_displaySelectedGroundTracks && m_selected[row]))
+        && m_items[row]->m_itemSettings->m_enabled && m_items[row]->m_itemSettings->m_display2DTrack;
+}
+
+bool MapModel::isInView(double latitude, double longitude) const
+{
+    if (!m_viewValid) {
+        return true;
+    }
+    if ((latitude < m_viewSouth) || (latitude > m_viewNorth)) {
+        return false;
+    }
+    if (m_viewWest <= m_viewEast) {
+        return (longitude >= m_viewWest) && (longitude <= m_viewEast);
+    } else {
+        return (longitude >= m_viewWest) || (longitude <= m_viewEast); // Crosses antimeridian
+    }
+}
+
+void MapModel::setInView(MapItem *item, bool inView)
+{
+    bool wasInView = item->m_inView;
+    item->m_inView = inView;
+    if (inView) {
+        m_inViewItems.insert(item);
+    } else {
+        m_inViewItems.remove(item);
+    }
+    if (wasInView)
+    {
+        // Refresh to hide it when leaving view
+        m_dirty2D.insert(item);
+        scheduleFlush();
+    }
+    else
+    {
+        markDirty2D(item);
+    }
+}
+
+// Update the items that are in view (culling) from the visible region of the 2D map
+// Items close to the edges are kept in view so their labels don't disappear before their icons
+void MapModel::updateView()
+{
+    if (!m_mapRect.isValid())
+    {
+        m_viewValid = false;
+    }
+    else
+    {
+        double latMargin = m_mapRect.height() / 4.0;
+        double lonMargin = m_mapRect.width() / 4.0;
+        m_viewSouth = std::max(-90.0, m_mapRect.bottomLeft().latitude() - latMargin);
+        m_viewNorth = std::min(90.0, m_mapRect.topRight().latitude() + latMargin);
+        m_viewValid = true;
+
+        if (m_mapRect.width() + 2.0 * lonMargin >= 360.0)
+        {
+            m_viewWest = -180.0;
+            m_viewEast = 180.0;
+        }
+        else
+        {
+            m_viewWest = m_mapRect.bottomLeft().longitude() - lonMargin;
+            m_viewEast = m_mapRect.topRight().longitude() + lonMargin;
+            m_viewWest = m_viewWest < -180.0 ? m_viewWest + 360.0 : m_viewWest;
+            m_viewEast = m_viewEast > 180.0 ? m_viewEast - 360.0 : m_viewEast;
+        }
+    }
+
+    QSet<MapItem *> inView;
+
+    if (m_viewValid)
+    {
+        QList<MapItem *> candidates;
+        m_spatialIndex.query(m_viewSouth, m_viewWest, m_viewNorth, m_viewEast, candidates);
+        for (auto item : candidates)
+        {
+            if (isInView(item->m_latitude, item->m_longitude)) {
+                inView.insert(item);
             }
         }
     }
+    else
+    {
+        for (auto item : m_itemIndex) {
+            inView.insert(item);
+        }
+    }
+
+    // Only items entering or leaving the view need their delegates refreshed
+    QSet<MapItem *> previousInView = m_inViewItems;
+    for (auto item : previousInView)
+    {
+        if (!inView.contains(item)) {
+            setInView(item, false);
+        }
+    }
+    for (auto item : inView)
+    {
+        if (!item->m_inView) {
+            setInView(item, true);
+        }
+    }
 }
 
@@ -20,33 +20,41 @@
 
 #include <QAbstractListModel>
 #include <QGeoCoordinate>
+#include <QGeoRectangle>
 #include <QColor>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QTimer>
 
 #include "util/azel.h"
 #include "mapsettings.h"
 #include "cesiuminterface.h"
 
-#include "SWGMapItem.h"
+#include "util/mapitemdata.h"
 
 class MapModel;
 class MapGUI;
 class CZML;
+class MapSpatialIndex;
 
 // Information required about each item displayed on the map
 class MapItem {
 
 public:
-    MapItem(const QObject *sourcePipe, const QString &group, MapSettings::MapItemSettings *itemSettings, SWGSDRangel::SWGMapItem *mapItem);
-    void update(SWGSDRangel::SWGMapItem *mapItem);
+    MapItem(const QObject *sourcePipe, const QString &group, MapSettings::MapItemSettings *itemSettings, const MapItemData& mapItem);
+    ~MapItem();
+    void update(const MapItemData& mapItem);
     QGeoCoordinate getCoordinates();
 
 private:
     void findFrequency();
-    void updateTrack(QList<SWGSDRangel::SWGMapCoordinate *> *track);
-    void updatePredictedTrack(QList<SWGSDRangel::SWGMapCoordinate *> *track);
+    void updateTrack(bool hasTrack, const QVector<MapItemData::Coordinate>& track);
+    void updatePredictedTrack(bool hasTrack, const QVector<MapItemData::Coordinate>& track);
 
     friend MapModel;
     friend CZML;
+    friend MapSpatialIndex;
     QString m_group;
     MapSettings::MapItemSettings *m_itemSettings;
     const QObject *m_sourcePipe;   // Channel/feature that created the item
@@ -92,6 +100,34 @@ private:
     float m_modelAltitudeOffset;
     bool m_fixedPosition;
     QList<CesiumInterface::Animation *> m_animations;
+
+    // Maintained by MapModel
+    int m_row;                          // Row in model or -1 if not yet inserted
+    int m_cell;                         // Cell in spatial index or -1 if not indexed
+    bool m_inView;                      // Within (or close to) the 2D map viewport
+};
+
+// Uniform grid of latitude/longitude cells, to find the items in the 2D map viewport without scanning all of them
+class MapSpatialIndex {
+
+public:
+    MapSpatialIndex();
+    void insert(MapItem *item);
+    void remove(MapItem *item);
+    void move(MapItem *item);   // After position of item has changed
+    void clear();
+    // Items in cells overlapping the area. west > east when the area crosses the antimeridian
+    void query(double south, double west, double north, double east, QList<MapItem *>& items) const;
+
+private:
+    static const int m_cellDegrees = 5;
+    static const int m_nbLatCells = 180 / m_cellDegrees;
+    static const int m_nbLonCells = 360 / m_cellDegrees;
+    QVector<QSet<MapItem *>> m_cells;
+
+    static int getLatCell(double latitude);
+    static int getLonCell(double longitude);
+    static int getCell(double latitude, double longitude) { return getLatCell(latitude) * m_nbLonCells + getLonCell(longitude); }
 };
 
 // Model used for each item on the map
@@ -126,7 +162,7 @@ public:
     void playAnimations(MapItem *item);
 
     Q_INVOKABLE void add(MapItem *item);
-    void update(const QObject *source, SWGSDRangel::SWGMapItem *swgMapItem, const QString &group="");
+    void update(const QObject *source, const MapItemData& mapItemData, const QString &group="");
     void update(MapItem *item);
     void remove(MapItem *item);
     void allUpdated();
@@ -206,12 +242,32 @@ public:
         m_selected3D = selected;
     }
 
+    static const int m_flushIntervalMs = 50; // Updates received within this interval are sent to the maps together
+
 public slots:
     void update3DMap(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles = QVector<int>());
+    void flush();
 
 private:
+    typedef QPair<const QObject *, QString> ItemKey;
+
     MapGUI *m_gui;
     QList<MapItem *> m_items;
+    QHash<ItemKey, MapItem *> m_itemIndex;   // All items by source and name, including those pending insertion
+    QList<MapItem *> m_pendingAdds;         // New items to insert into the model on next flush
+    QList<MapItem *> m_pendingRemovals;     // Items removed from the model, to remove from the 3D map then delete on next flush
+    QSet<MapItem *> m_dirty2D;              // Items whose 2D map delegates need refreshing on next flush
+    QSet<MapItem *> m_dirty3D;              // Items to send to the 3D map on next flush
+    QTimer m_flushTimer;
+    bool m_flushing;
+    MapSpatialIndex m_spatialIndex;
+    QSet<MapItem *> m_inViewItems;
+    QGeoRectangle m_mapRect;                // Visible region of the 2D map
+    bool m_viewValid;
+    double m_viewSouth;                     // Viewport with margin, used for culling
+    double m_viewNorth;
+    double m_viewWest;
+    double m_viewEast;
     QList<bool> m_selected;
     int m_target;               // Row number of current target, or -1 for none
     bool m_displayNames;
@@ -222,6 +278,16 @@ private:
     double m_bottomRightLongitude;
 
     QString m_selected3D;       // Name of item selected on 3D map - only supports 1 item, unlike 2D map
+
+    void scheduleFlush();
+    void appendRow(MapItem *item, bool selected);
+    void takeRow(int row);
+    void markDirty2D(MapItem *item);
+    bool isTrackVisible(int row) const;
+    bool isInView(double latitude, double longitude) const;
+    void setInView(MapItem *item, bool inView);
+    void updateMapRect();
+    void updateView();
 };
 
 
@@ -89,7 +89,7 @@ void MapWebSocketServer::send(const QJsonObject &obj)
     if (m_client)
     {
         QJsonDocument doc(obj);
-        QByteArray bytes = doc.toJson();
+        QByteArray bytes = doc.toJson(QJsonDocument::Compact);
         qint64 bytesSent = m_client->sendTextMessage(bytes);
         m_client->flush(); // Try to reduce latency
         if (bytesSent != bytes.size()) {
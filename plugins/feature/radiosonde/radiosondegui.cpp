@@ -34,7 +34,6 @@
 #include "radiosonde.h"
 #include "radiosondegui.h"
 
-#include "SWGMapItem.h"
 
 RadiosondeGUI* RadiosondeGUI::create(PluginAPI* pluginAPI, FeatureUISet *featureUISet, Feature *feature)
 {
@@ -369,41 +368,39 @@ void RadiosondeGUI::sendToMap(const QString &name, const QString &label,
     QList<ObjectPipe*> mapPipes;
     MainCore::instance()->getMessagePipes().getMessagePipes(m_radiosonde, "mapitems", mapPipes);
 
-    for (const auto& pipe : mapPipes)
-    {
-        MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
-        SWGSDRangel::SWGMapItem *swgMapItem = new SWGSDRangel::SWGMapItem();
-        swgMapItem->setName(new QString(name));
-        swgMapItem->setLatitude(latitude);
-        swgMapItem->setLongitude(longitude);
-        swgMapItem->setAltitude(altitude);
-        swgMapItem->setAltitudeReference(0); // ABSOLUTE
-
-        if (positionDateTime.isValid()) {
-            swgMapItem->setPositionDateTime(new QString(positionDateTime.toString(Qt::ISODateWithMs)));
-        }
+    if (mapPipes.size() == 0) {
+        return;
+    }
 
-        swgMapItem->setImageRotation(heading);
-        swgMapItem->setText(new QString(text));
+    QVector<MapItemData> mapItems(1);
+    MapItemData& mapItem = mapItems[0];
+    mapItem.m_name = name;
+    mapItem.m_latitude = latitude;
+    mapItem.m_longitude = longitude;
+    mapItem.m_altitude = altitude;
+    mapItem.m_altitudeReference = 0; // ABSOLUTE
+    mapItem.m_positionDateTime = positionDateTime;
+    mapItem.m_imageRotation = heading;
+    mapItem.m_text = text;
+
+    if (!image.isEmpty()) {
+        mapItem.setImage(QString("qrc:///radiosonde/map/%1").arg(image));
+    }
 
-        if (image.isEmpty()) {
-            swgMapItem->setImage(new QString(""));
-        } else {
-            swgMapItem->setImage(new QString(QString("qrc:///radiosonde/map/%1").arg(image)));
-        }
+    mapItem.setModel(model);
+    mapItem.m_modelAltitudeOffset = 0.0f;
+    mapItem.m_label = label;
+    mapItem.m_labelAltitudeOffset = labelOffset;
+    mapItem.m_fixedPosition = false;
+    mapItem.m_orientation = 1;
+    mapItem.m_heading = heading;
+    mapItem.m_pitch = 0.0;
+    mapItem.m_roll = 0.0;
 
-        swgMapItem->setModel(new QString(model));
-        swgMapItem->setModelAltitudeOffset(0.0f);
-        swgMapItem->setLabel(new QString(label));
-        swgMapItem->setLabelAltitudeOffset(labelOffset);
-        swgMapItem->setFixedPosition(false);
-        swgMapItem->setOrientation(1);
-        swgMapItem->setHeading(heading);
-        swgMapItem->setPitch(0.0);
-        swgMapItem->setRoll(0.0);
-
-        MainCore::MsgMapItem *msg = MainCore::MsgMapItem::create(m_radiosonde, swgMapItem);
-        messageQueue->push(msg);
+    for (const auto& pipe : mapPipes)
+    {
+        MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
+        messageQueue->push(MainCore::MsgMapItems::create(m_radiosonde, mapItems));
     }
 }
 
@@ -25,9 +25,9 @@
 #include <QEventLoop>
 #include <QTimer>
 #include <QDateTime>
+#include <QRunnable>
 
 #include "SWGTargetAzimuthElevation.h"
-#include "SWGMapItem.h"
 
 #include "webapi/webapiadapterinterface.h"
 #include "webapi/webapiutils.h"
@@ -50,6 +50,36 @@ MESSAGE_CLASS_DEFINITION(SatelliteTrackerReport::MsgReportAOS, Message)
 MESSAGE_CLASS_DEFINITION(SatelliteTrackerReport::MsgReportLOS, Message)
 MESSAGE_CLASS_DEFINITION(SatelliteTrackerReport::MsgReportTarget, Message)
 
+// Calculates the state of one satellite on the worker thread pool
+class SatelliteStateRunnable : public QRunnable
+{
+public:
+    SatelliteStateRunnable(const QDateTime& dateTime, const SatNogsTLE *tle, const SatelliteTrackerSettings& settings,
+                           int noOfPasses, SatelliteState *satState) :
+        m_dateTime(dateTime),
+        m_tle(tle),
+        m_settings(settings),
+        m_noOfPasses(noOfPasses),
+        m_satState(satState)
+    {}
+
+    void run() override
+    {
+        getSatelliteState(m_dateTime, m_tle->m_tle0, m_tle->m_tle1, m_tle->m_tle2,
+                            m_settings.m_latitude, m_settings.m_longitude, m_settings.m_heightAboveSeaLevel/1000.0,
+                            m_settings.m_predictionPeriod, m_settings.m_minAOSElevation, m_settings.m_minPassElevation,
+                            m_settings.m_passStartTime, m_settings.m_passFinishTime, m_settings.m_utc,
+                            m_noOfPasses, m_settings.m_groundTrackPoints, m_satState);
+    }
+
+private:
+    QDateTime m_dateTime;
+    const SatNogsTLE *m_tle;
+    const SatelliteTrackerSettings& m_settings; //!< Worker settings do not change until the pool is done
+    int m_noOfPasses;
+    SatelliteState *m_satState;
+};
+
 SatelliteTrackerWorker::SatelliteTrackerWorker(SatelliteTracker* satelliteTracker, WebAPIAdapterInterface *webAPIAdapterInterface) :
     m_satelliteTracker(satelliteTracker),
     m_webAPIAdapterInterface(webAPIAdapterInterface),
@@ -234,16 +264,12 @@ void SatelliteTrackerWorker::applySettings(const SatelliteTrackerSettings& setti
 
 void SatelliteTrackerWorker::removeFromMap(QString id)
 {
-    QList<ObjectPipe*> mapMessagePipes;
-    MainCore::instance()->getMessagePipes().getMessagePipes(m_satelliteTracker, "mapitems", mapMessagePipes);
-
-    if (mapMessagePipes.size() > 0) {
-        sendToMap(mapMessagePipes, id, "", "", "", 0.0f, 0.0, 0.0, 0.0, 0.0, nullptr, nullptr, nullptr, nullptr);
-    }
+    sendToMap(id, "", "", "", 0.0f, 0.0, 0.0, 0.0, 0.0, nullptr, nullptr, nullptr, nullptr);
+    sendMapItems();
 }
 
+// Items are sent to the Map feature in batches by sendMapItems
 void SatelliteTrackerWorker::sendToMap(
-    const QList<ObjectPipe*>& mapMessagePipes,
     QString name,
     QString image,
     QString model,
@@ -259,56 +285,59 @@ void SatelliteTrackerWorker::sendToMap(
     QList<QDateTime *> *predictedTrackDateTime
 )
 {
-    for (const auto& pipe : mapMessagePipes)
+    m_mapItems.append(MapItemData());
+    MapItemData& mapItem = m_mapItems.last();
+    mapItem.m_name = name;
+    mapItem.m_latitude = lat;
+    mapItem.m_longitude = lon;
+    mapItem.m_altitude = altitude;
+    mapItem.setImage(image);
+    mapItem.m_imageRotation = rotation;
+    mapItem.m_text = text;
+    mapItem.setModel(model);
+    mapItem.m_fixedPosition = false;
+    mapItem.m_orientation = 0;
+    mapItem.m_label = name;
+    mapItem.m_labelAltitudeOffset = labelOffset;
+    if (track != nullptr)
     {
-        MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
-        SWGSDRangel::SWGMapItem *swgMapItem = new SWGSDRangel::SWGMapItem();
-        swgMapItem->setName(new QString(name));
-        swgMapItem->setLatitude(lat);
-        swgMapItem->setLongitude(lon);
-        swgMapItem->setAltitude(altitude);
-        swgMapItem->setImage(new QString(image));
-        swgMapItem->setImageRotation(rotation);
-        swgMapItem->setText(new QString(text));
-        swgMapItem->setModel(new QString(model));
-        swgMapItem->setFixedPosition(false);
-        swgMapItem->setOrientation(0);
-        swgMapItem->setLabel(new QString(name));
-        swgMapItem->setLabelAltitudeOffset(labelOffset);
-        if (track != nullptr)
+        mapItem.m_hasTrack = true;
+        mapItem.m_track.reserve(track->size());
+        for (int i = 0; i < track->size(); i++)
         {
-            QList<SWGSDRangel::SWGMapCoordinate *> *mapTrack = new QList<SWGSDRangel::SWGMapCoordinate *>();
-            for (int i = 0; i < track->size(); i++)
-            {
-                SWGSDRangel::SWGMapCoordinate* p = new SWGSDRangel::SWGMapCoordinate();
-                QGeoCoordinate *c = track->at(i);
-                p->setLatitude(c->latitude());
-                p->setLongitude(c->longitude());
-                p->setAltitude(c->altitude());
-                p->setDateTime(new QString(trackDateTime->at(i)->toString(Qt::ISODate)));
-                mapTrack->append(p);
-            }
-            swgMapItem->setTrack(mapTrack);
+            QGeoCoordinate *c = track->at(i);
+            mapItem.m_track.append(MapItemData::Coordinate(c->latitude(), c->longitude(), c->altitude(), *trackDateTime->at(i)));
         }
-        if (predictedTrack != nullptr)
+    }
+    if (predictedTrack != nullptr)
+    {
+        mapItem.m_hasPredictedTrack = true;
+        mapItem.m_predictedTrack.reserve(predictedTrack->size());
+        for (int i = 0; i < predictedTrack->size(); i++)
         {
-            QList<SWGSDRangel::SWGMapCoordinate *> *mapTrack = new QList<SWGSDRangel::SWGMapCoordinate *>();
-            for (int i = 0; i < predictedTrack->size(); i++)
-            {
-                SWGSDRangel::SWGMapCoordinate* p = new SWGSDRangel::SWGMapCoordinate();
-                QGeoCoordinate *c = predictedTrack->at(i);
-                p->setLatitude(c->latitude());
-                p->setLongitude(c->longitude());
-                p->setAltitude(c->altitude());
-                p->setDateTime(new QString(predictedTrackDateTime->at(i)->toString(Qt::ISODate)));
-                mapTrack->append(p);
-            }
-            swgMapItem->setPredictedTrack(mapTrack);
+            QGeoCoordinate *c = predictedTrack->at(i);
+            mapItem.m_predictedTrack.append(MapItemData::Coordinate(c->latitude(), c->longitude(), c->altitude(), *predictedTrackDateTime->at(i)));
         }
+    }
+}
+
+// Send all items in a single message per Map
+void SatelliteTrackerWorker::sendMapItems()
+{
+    if (m_mapItems.isEmpty()) {
+        return;
+    }
+
+    QList<ObjectPipe*> mapMessagePipes;
+    MainCore::instance()->getMessagePipes().getMessagePipes(m_satelliteTracker, "mapitems", mapMessagePipes);
 
-        MainCore::MsgMapItem *msg = MainCore::MsgMapItem::create(m_satelliteTracker, swgMapItem);
-        messageQueue->push(msg);
+    for (const auto& pipe : mapMessagePipes)
+    {
+        MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
+        messageQueue->push(MainCore::MsgMapItems::create(m_satelliteTracker, m_mapItems));
     }
+
+    m_mapItems.clear();
 }
 
 void SatelliteTrackerWorker::update()
@@ -322,6 +351,8 @@ void SatelliteTrackerWorker::update()
     else
         qdt = QDateTime::fromString(m_settings.m_dateTime, Qt::ISODateWithMs).toUTC();
 
+    // Calculate position, AOS/LOS and other details for all satellites
+    // Each satellite only uses its own state so the calculations run in parallel
     QHashIterator<QString, SatWorkerState *> itr(m_workerState);
     while (itr.hasNext())
     {
@@ -333,19 +364,29 @@ void SatelliteTrackerWorker::update()
             SatNogsSatellite *sat = m_satellites.value(name);
             if (sat->m_tle != nullptr)
             {
-                // Calculate position, AOS/LOS and other details for satellite
                 int noOfPasses;
                 bool recalcAsPastLOS = (satWorkerState->m_satState.m_passes.size() > 0) && (satWorkerState->m_satState.m_passes[0]->m_los < qdt);
                 if (m_recalculatePasses || recalcAsPastLOS)
                     noOfPasses = (name == m_settings.m_target) ? 99 : 1;
                 else
                     noOfPasses = 0;
-                getSatelliteState(qdt, sat->m_tle->m_tle0, sat->m_tle->m_tle1, sat->m_tle->m_tle2,
-                                    m_settings.m_latitude, m_settings.m_longitude, m_settings.m_heightAboveSeaLevel/1000.0,
-                                    m_settings.m_predictionPeriod, m_settings.m_minAOSElevation, m_settings.m_minPassElevation,
-                                    m_settings.m_passStartTime, m_settings.m_passFinishTime, m_settings.m_utc,
-                                    noOfPasses, m_settings.m_groundTrackPoints, &satWorkerState->m_satState);
+                m_stateThreadPool.start(new SatelliteStateRunnable(qdt, sat->m_tle, m_settings, noOfPasses, &satWorkerState->m_satState));
+            }
+        }
+    }
+    m_stateThreadPool.waitForDone();
 
+    itr.toFront();
+    while (itr.hasNext())
+    {
+        itr.next();
+        SatWorkerState *satWorkerState = itr.value();
+        QString name = satWorkerState->m_name;
+        if (m_satellites.contains(name))
+        {
+            SatNogsSatellite *sat = m_satellites.value(name);
+            if (sat->m_tle != nullptr)
+            {
                 // Update AOS/LOS (only set timers if using real time)
                 if ((m_settings.m_dateTime == "") && (satWorkerState->m_satState.m_passes.size() > 0))
                 {
@@ -495,7 +536,6 @@ void SatelliteTrackerWorker::update()
                         }
 
                         sendToMap(
-                            mapMessagePipes,
                             sat->m_name,
                             image,
                             model,
@@ -522,6 +562,7 @@ void SatelliteTrackerWorker::update()
         }
     }
     m_recalculatePasses = false;
+    sendMapItems();
 }
 
 void SatelliteTrackerWorker::aos(SatWorkerState *satWorkerState)
@@ -22,10 +22,12 @@
 #include <QObject>
 #include <QTimer>
 #include <QAbstractSocket>
+#include <QThreadPool>
 
 #include "util/message.h"
 #include "util/messagequeue.h"
 #include "util/astronomy.h"
+#include "util/mapitemdata.h"
 
 #include "satellitetrackersettings.h"
 #include "satellitetrackersgp4.h"
@@ -118,14 +120,15 @@ private:
     bool m_recalculatePasses;           //!< Recalculate passes as something has changed
     bool m_flipRotation;                //!< Use 180 elevation to avoid 360/0 degree discontinutiy
     bool m_extendedAzRotation;          //!< Use 450+ degree azimuth to avoid 360/0 degree discontinuity
+    QVector<MapItemData> m_mapItems;    //!< Pending for Map feature
+    QThreadPool m_stateThreadPool;      //!< Runs the satellite state calculations in parallel
 
     bool handleMessage(const Message& cmd);
     void applySettings(const SatelliteTrackerSettings& settings, bool force = false);
     MessageQueue *getMessageQueueToGUI() { return m_msgQueueToGUI; }
     void removeFromMap(QString id);
     void sendToMap(
-        const QList<ObjectPipe*>& mapMessagePipes,
-        QString id,
+        QString name,
         QString image,
         QString model,
         QString text,
@@ -139,6 +142,7 @@ private:
         QList<QGeoCoordinate *> *predictedTrack = nullptr,
         QList<QDateTime *> *predictedTrackDateTime = nullptr
     );
+    void sendMapItems();
     void applyDeviceAOSSettings(const QString& name);
     void startStopSinks(bool start);
     void calculateRotation(SatWorkerState *satWorkerState);
@@ -18,6 +18,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
 #include <QMessageBox>
 #include <QLineEdit>
 #include <QRegExp>
@@ -39,9 +40,11 @@
 #include "gui/dmsspinbox.h"
 #include "gui/graphicsviewzoom.h"
 #include "mainwindow.h"
+#include "maincore.h"
 #include "device/deviceuiset.h"
 #include "util/units.h"
 #include "util/astronomy.h"
+#include "util/ephemeris.h"
 #include "util/interpolation.h"
 #include "util/png.h"
 
@@ -968,15 +971,20 @@ QList<QLineSeries*> StarTrackerGUI::createDriftScan(bool galactic)
     }
 
     // Create a list of RA/Dec points of drift scan path
+    // With a fixed Az/El, declination and hour angle are constant, so RA only moves with sidereal time
     AzAlt aa;
     aa.alt = m_settings.m_el;
     aa.az = m_settings.m_az;
+    RADec rd0 = Astronomy::azAltToRaDec(aa, m_settings.m_latitude, m_settings.m_longitude, dt);
+    double lst0 = Astronomy::localSiderealTime(dt, m_settings.m_longitude);
     double prevX;
     // Plot every 30min over a day
     for (int i = 0; i <= 24*2; i++)
     {
         dt = dt.addSecs(30*60);
-        RADec rd = Astronomy::azAltToRaDec(aa, m_settings.m_latitude, m_settings.m_longitude, dt);
+        RADec rd;
+        rd.ra = Astronomy::modulo(rd0.ra + (Astronomy::localSiderealTime(dt, m_settings.m_longitude) - lst0) / (360.0/24.0), 24.0);
+        rd.dec = rd0.dec;
         double x, y;
         mapRaDec(rd.ra, rd.dec, galactic, x, y);
         if (i == 0)
@@ -1431,6 +1439,27 @@ void StarTrackerGUI::removeAllAxes()
 }
 
 // Plot target elevation angle over the day
+// Az/Alt of the target, without refraction, at count times from start every stepSecs seconds
+void StarTrackerGUI::calcTargetAzAlts(const QDateTime& start, int stepSecs, int count, AzAlt *aa)
+{
+    if ((m_settings.m_target == "Sun") || (m_settings.m_target == "Moon"))
+    {
+        Ephemeris::Body body = m_settings.m_target == "Sun" ? Ephemeris::Sun : Ephemeris::Moon;
+        std::vector<RADec> rd(count);
+        MainCore::instance()->getEphemeris().positions(body, m_settings.m_latitude, m_settings.m_longitude, start, stepSecs, count, aa, rd.data());
+    }
+    else
+    {
+        RADec rd;
+        rd.ra = Astronomy::raToDecimal(m_settings.m_ra);
+        rd.dec = Astronomy::decToDecimal(m_settings.m_dec);
+
+        for (int i = 0; i < count; i++) {
+            aa[i] = Ephemeris::raDecToAzAlt(rd, m_settings.m_latitude, m_settings.m_longitude, start.addSecs(i * stepSecs), !m_settings.m_jnow);
+        }
+    }
+}
+
 void StarTrackerGUI::plotElevationLineChart()
 {
     ui->chart->setVisible(true);
@@ -1476,22 +1505,12 @@ void StarTrackerGUI::plotElevationLineChart()
     QDateTime endTime = dt;
     double prevAz;
     int timestep = 10*60;
-    for (int step = 0; step <= 24*60*60/timestep; step++)
+    int nbSteps = 24*60*60/timestep + 1;
+    std::vector<AzAlt> azAlts(nbSteps);
+    calcTargetAzAlts(startTime, timestep, nbSteps, azAlts.data());
+    for (int step = 0; step < nbSteps; step++)
     {
-        AzAlt aa;
-        RADec rd;
-
-        // Calculate elevation of desired object
-        if (m_settings.m_target == "Sun")
-            Astronomy::sunPosition(aa, rd, m_settings.m_latitude, m_settings.m_longitude, dt);
-        else if (m_settings.m_target == "Moon")
-            Astronomy::moonPosition(aa, rd, m_settings.m_latitude, m_settings.m_longitude, dt);
-        else
-        {
-            rd.ra = Astronomy::raToDecimal(m_settings.m_ra);
-            rd.dec = Astronomy::decToDecimal(m_settings.m_dec);
-            aa = Astronomy::raDecToAzAlt(rd, m_settings.m_latitude, m_settings.m_longitude, dt, !m_settings.m_jnow);
-        }
+        AzAlt aa = azAlts[step];
 
         if (aa.alt > maxElevation)
             maxElevation = aa.alt;
@@ -1615,23 +1634,13 @@ void StarTrackerGUI::plotElevationPolarChart()
     int setIdx = -1;
     int idx = 0;
     int timestep = 10*60; // Rise/set times accurate to nearest 10 minutes
+    int nbSteps = 24*60*60/timestep + 1;
+    std::vector<AzAlt> azAlts(nbSteps);
+    calcTargetAzAlts(startTime, timestep, nbSteps, azAlts.data());
     double prevAlt;
-    for (int step = 0; step <= 24*60*60/timestep; step++)
+    for (int step = 0; step < nbSteps; step++)
     {
-        AzAlt aa;
-        RADec rd;
-
-        // Calculate elevation of desired object
-        if (m_settings.m_target == "Sun")
-            Astronomy::sunPosition(aa, rd, m_settings.m_latitude, m_settings.m_longitude, dt);
-        else if (m_settings.m_target == "Moon")
-            Astronomy::moonPosition(aa, rd, m_settings.m_latitude, m_settings.m_longitude, dt);
-        else
-        {
-            rd.ra = Astronomy::raToDecimal(m_settings.m_ra);
-            rd.dec = Astronomy::decToDecimal(m_settings.m_dec);
-            aa = Astronomy::raDecToAzAlt(rd, m_settings.m_latitude, m_settings.m_longitude, dt, !m_settings.m_jnow);
-        }
+        AzAlt aa = azAlts[step];
 
         if (aa.alt > maxElevation)
             maxElevation = aa.alt;
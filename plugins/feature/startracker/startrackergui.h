@@ -40,6 +40,7 @@ class QNetworkAccessManager;
 class QNetworkReply;
 class GraphicsViewZoom;
 class QGraphicsPixmapItem;
+struct AzAlt;
 
 namespace Ui {
     class StarTrackerGUI;
@@ -139,6 +140,7 @@ private:
     void mapRaDec(double ra, double dec, bool galactic, double& x, double& y);
     QList<QLineSeries*> createDriftScan(bool galactic);
     QColor getSeriesColor(int series);
+    void calcTargetAzAlts(const QDateTime& start, int stepSecs, int count, AzAlt *aa);
     void plotElevationLineChart();
     void plotElevationPolarChart();
     void plotSkyTemperatureChart();
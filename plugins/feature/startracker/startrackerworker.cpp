@@ -27,7 +27,6 @@
 #include <QDateTime>
 
 #include "SWGTargetAzimuthElevation.h"
-#include "SWGMapItem.h"
 #include "SWGStarTrackerTarget.h"
 
 #include "webapi/webapiadapterinterface.h"
@@ -407,16 +406,12 @@ void StarTrackerWorker::updateRaDec(RADec rd, QDateTime dt, bool lbTarget)
 
 void StarTrackerWorker::removeFromMap(QString id)
 {
-    QList<ObjectPipe*> mapMessagePipes;
-    MainCore::instance()->getMessagePipes().getMessagePipes(m_starTracker, "mapitems", mapMessagePipes);
-
-    if (mapMessagePipes.size() > 0) {
-        sendToMap(mapMessagePipes, id, "", "", 0.0, 0.0);
-    }
+    sendToMap(id, "", "", 0.0, 0.0);
+    sendMapItems();
 }
 
+// Items are sent to the Map feature in batches by sendMapItems
 void StarTrackerWorker::sendToMap(
-    const QList<ObjectPipe*>& mapMessagePipes,
     QString name,
     QString image,
     QString text,
@@ -425,20 +420,33 @@ void StarTrackerWorker::sendToMap(
     double rotation
 )
 {
+    m_mapItems.append(MapItemData());
+    MapItemData& mapItem = m_mapItems.last();
+    mapItem.m_name = name;
+    mapItem.m_latitude = lat;
+    mapItem.m_longitude = lon;
+    mapItem.setImage(image);
+    mapItem.m_imageRotation = rotation;
+    mapItem.m_text = text;
+}
+
+// Send all items in a single message per Map
+void StarTrackerWorker::sendMapItems()
+{
+    if (m_mapItems.isEmpty()) {
+        return;
+    }
+
+    QList<ObjectPipe*> mapMessagePipes;
+    MainCore::instance()->getMessagePipes().getMessagePipes(m_starTracker, "mapitems", mapMessagePipes);
+
     for (const auto& pipe : mapMessagePipes)
     {
         MessageQueue *messageQueue = qobject_cast<MessageQueue*>(pipe->m_element);
-        SWGSDRangel::SWGMapItem *swgMapItem = new SWGSDRangel::SWGMapItem();
-        swgMapItem->setName(new QString(name));
-        swgMapItem->setLatitude(lat);
-        swgMapItem->setLongitude(lon);
-        swgMapItem->setImage(new QString(image));
-        swgMapItem->setImageRotation(rotation);
-        swgMapItem->setText(new QString(text));
-
-        MainCore::MsgMapItem *msg = MainCore::MsgMapItem::create(m_starTracker, swgMapItem);
-        messageQueue->push(msg);
+        messageQueue->push(MainCore::MsgMapItems::create(m_starTracker, m_mapItems));
     }
+
+    m_mapItems.clear();
 }
 
 QString moonPhase(double sunLongitude, double moonLongitude, double observationLatitude, double &rotation)
@@ -485,6 +493,7 @@ void StarTrackerWorker::update()
     bool lbTarget = false;
 
     QDateTime dt;
+    Ephemeris& ephemeris = MainCore::instance()->getEphemeris();
 
     // Get date and time to calculate position at
     if (m_settings.m_dateTime == "") {
@@ -496,12 +505,12 @@ void StarTrackerWorker::update()
     // Calculate position
     if ((m_settings.m_target == "Sun") || m_settings.m_drawSunOnMap || m_settings.m_drawSunOnSkyTempChart)
     {
-        Astronomy::sunPosition(sunAA, sunRD, m_settings.m_latitude, m_settings.m_longitude, dt);
+        ephemeris.position(Ephemeris::Sun, m_settings.m_latitude, m_settings.m_longitude, dt, sunAA, sunRD);
         getMessageQueueToGUI()->push(StarTrackerReport::MsgReportRADec::create(sunRD.ra, sunRD.dec, "sun"));
     }
     if ((m_settings.m_target == "Moon") || m_settings.m_drawMoonOnMap || m_settings.m_drawMoonOnSkyTempChart)
     {
-        Astronomy::moonPosition(moonAA, moonRD, m_settings.m_latitude, m_settings.m_longitude, dt);
+        ephemeris.position(Ephemeris::Moon, m_settings.m_latitude, m_settings.m_longitude, dt, moonAA, moonRD);
         getMessageQueueToGUI()->push(StarTrackerReport::MsgReportRADec::create(moonRD.ra, moonRD.dec, "moon"));
     }
 
@@ -541,7 +550,7 @@ void StarTrackerWorker::update()
         l = m_settings.m_l;
         b = m_settings.m_b;
         Astronomy::galacticToEquatorial(l, b, rd.ra, rd.dec);
-        aa = Astronomy::raDecToAzAlt(rd, m_settings.m_latitude, m_settings.m_longitude, dt, !m_settings.m_jnow);
+        aa = Ephemeris::raDecToAzAlt(rd, m_settings.m_latitude, m_settings.m_longitude, dt, !m_settings.m_jnow);
         lbTarget = true;
     }
     else
@@ -549,7 +558,7 @@ void StarTrackerWorker::update()
         // Convert RA/Dec to Alt/Az
         rd.ra = Astronomy::raToDecimal(m_settings.m_ra);
         rd.dec = Astronomy::decToDecimal(m_settings.m_dec);
-        aa = Astronomy::raDecToAzAlt(rd, m_settings.m_latitude, m_settings.m_longitude, dt, !m_settings.m_jnow);
+        aa = Ephemeris::raDecToAzAlt(rd, m_settings.m_latitude, m_settings.m_longitude, dt, !m_settings.m_jnow);
         Astronomy::equatorialToGalactic(rd.ra, rd.dec, l, b);
     }
     updateRaDec(rd, dt, lbTarget);
@@ -658,7 +667,7 @@ void StarTrackerWorker::update()
             {
                 sunLongitude = Astronomy::lstAndRAToLongitude(lst, sunRD.ra);
                 sunLatitude = sunRD.dec;
-                sendToMap(mapMessagePipes, "Sun", "qrc:///startracker/startracker/sun-40.png", "Sun", sunLatitude, sunLongitude);
+                sendToMap("Sun", "qrc:///startracker/startracker/sun-40.png", "Sun", sunLatitude, sunLongitude);
             }
             if (m_settings.m_drawMoonOnMap)
             {
@@ -666,7 +675,7 @@ void StarTrackerWorker::update()
                 double moonLatitude = moonRD.dec;
                 double moonRotation;
                 QString phase = moonPhase(sunLongitude, moonLongitude, m_settings.m_latitude, moonRotation);
-                sendToMap(mapMessagePipes, "Moon", QString("qrc:///startracker/startracker/moon-%1-32").arg(phase), "Moon",
+                sendToMap("Moon", QString("qrc:///startracker/startracker/moon-%1-32").arg(phase), "Moon",
                                 moonLatitude, moonLongitude, moonRotation);
             }
             if ((m_settings.m_drawStarOnMap) && (m_settings.m_target != "Sun") && (m_settings.m_target != "Moon"))
@@ -674,8 +683,10 @@ void StarTrackerWorker::update()
                 double starLongitude = Astronomy::lstAndRAToLongitude(lst, rd.ra);
                 double starLatitude = rd.dec;
                 QString text = m_settings.m_target.startsWith("Custom") ? "Star" : m_settings.m_target;
-                sendToMap(mapMessagePipes, "Star", "qrc:///startracker/startracker/pulsar-32.png", text, starLatitude, starLongitude);
+                sendToMap("Star", "qrc:///startracker/startracker/pulsar-32.png", text, starLatitude, starLongitude);
             }
+
+            sendMapItems();
         }
     }
 
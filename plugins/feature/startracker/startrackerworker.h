@@ -26,6 +26,7 @@
 #include "util/message.h"
 #include "util/messagequeue.h"
 #include "util/astronomy.h"
+#include "util/mapitemdata.h"
 
 #include "startrackersettings.h"
 
@@ -87,6 +88,7 @@ private:
     QTcpServer *m_tcpServer;
     QTcpSocket *m_clientConnection;
     float m_solarFlux;
+    QVector<MapItemData> m_mapItems;   //!< Pending for Map feature
 
     bool handleMessage(const Message& cmd);
     void applySettings(const StarTrackerSettings& settings, bool force = false);
@@ -96,14 +98,14 @@ private:
     void writeStellariumTarget(double ra, double dec);
     void removeFromMap(QString id);
     void sendToMap(
-        const QList<ObjectPipe*>& mapMessagePipes,
-        QString id,
+        QString name,
         QString image,
         QString text,
         double lat,
         double lon,
         double rotation = 0.0
     );
+    void sendMapItems();
 
 private slots:
     void started();
@@ -258,6 +258,7 @@ bool FileInput::start()
 
 	m_fileInputWorker = new FileInputWorker(&m_ifstream, &m_sampleFifo, m_masterTimer, &m_inputMessageQueue);
 	m_fileInputWorker->moveToThread(&m_fileInputWorkerThread);
+	m_fileInputWorker->setRecordingStart(m_startingTimeStamp, m_sampleRate);
 	m_fileInputWorker->setSampleRateAndSize(m_settings.m_accelerationFactor * m_sampleRate, m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
 	startWorker();
 
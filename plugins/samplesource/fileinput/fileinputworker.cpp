@@ -40,13 +40,16 @@ FileInputWorker::FileInputWorker(std::ifstream *samplesStream,
 	m_chunksize(0),
 	m_sampleFifo(sampleFifo),
 	m_samplesCount(0),
+	m_startTimestamp(0),
+	m_recordSampleRate(0),
 	m_timer(timer),
 	m_fileInputMessageQueue(fileInputMessageQueue),
     m_samplerate(0),
 	m_samplesize(0),
 	m_samplebytes(0),
     m_throttlems(FILESOURCE_THROTTLE_MS),
-    m_throttleToggle(false)
+    m_throttleToggle(false),
+    m_tickPending(false)
 {
 }
 
@@ -73,7 +76,20 @@ void FileInputWorker::startWork()
     {
         qDebug() << "FileInputThread::startWork: file stream open, starting...";
         m_elapsedTimer.start();
-        connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+
+        if (SampleSinkFifo::getBackpressure()) // read as fast as the FIFO is emptied
+        {
+            if (!m_tickPending && !m_ifstream->eof())
+            {
+                m_tickPending = true;
+                QMetaObject::invokeMethod(this, "tick", Qt::QueuedConnection);
+            }
+        }
+        else
+        {
+            connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+        }
+
 		m_running = true;
     }
     else
@@ -160,9 +176,12 @@ void FileInputWorker::setBuffers(std::size_t chunksize)
 
 void FileInputWorker::tick()
 {
+    m_tickPending = false;
+
 	if (m_running)
 	{
-        qint64 throttlems = m_elapsedTimer.restart();
+        bool unthrottled = SampleSinkFifo::getBackpressure();
+        qint64 throttlems = unthrottled ? m_throttlems : m_elapsedTimer.restart();
 
         if (throttlems != m_throttlems)
         {
@@ -185,17 +204,35 @@ void FileInputWorker::tick()
         {
         	writeToSampleFifo(m_fileBuf, (qint32) m_chunksize);
     		m_samplesCount += m_chunksize / (2 * m_samplebytes);
+
+            if (unthrottled && m_running && !m_tickPending)
+            {
+                m_tickPending = true;
+                QMetaObject::invokeMethod(this, "tick", Qt::QueuedConnection);
+            }
         }
 	}
 }
 
+// In batch processing the wall clock has nothing to do with the recording so samples are timed from the recording start
+SampleTimestamp FileInputWorker::recordingTimestamp() const
+{
+	if (!SampleSinkFifo::getBackpressure() || (m_startTimestamp == 0) || (m_recordSampleRate <= 0)) {
+		return SampleTimestamp();
+	}
+
+	return SampleTimestamp(m_samplesCount, 0, m_startTimestamp * 1000000LL, m_recordSampleRate);
+}
+
 void FileInputWorker::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
 {
+	SampleTimestamp timestamp = recordingTimestamp();
+
 	if (m_samplesize == 16)
 	{
 		if (SDR_RX_SAMP_SZ == 16)
 		{
-			m_sampleFifo->write(buf, nbBytes);
+			m_sampleFifo->write(buf, nbBytes, timestamp);
 		}
 		else if (SDR_RX_SAMP_SZ == 24)
 		{
@@ -209,14 +246,14 @@ void FileInputWorker::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
 				convertBuf[2*is+1] = fileBuf[2*is+1] << 8;
 			}
 
-			m_sampleFifo->write((quint8*) convertBuf, nbSamples*sizeof(Sample));
+			m_sampleFifo->write((quint8*) convertBuf, nbSamples*sizeof(Sample), timestamp);
 		}
 	}
 	else if (m_samplesize == 24)
 	{
 		if (SDR_RX_SAMP_SZ == 24)
 		{
-			m_sampleFifo->write(buf, nbBytes);
+			m_sampleFifo->write(buf, nbBytes, timestamp);
 		}
 		else if (SDR_RX_SAMP_SZ == 16)
 		{
@@ -230,7 +267,7 @@ void FileInputWorker::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
 				convertBuf[2*is+1] = fileBuf[2*is+1] >> 8;
 			}
 
-			m_sampleFifo->write((quint8*) convertBuf, nbSamples*sizeof(Sample));
+			m_sampleFifo->write((quint8*) convertBuf, nbSamples*sizeof(Sample), timestamp);
 		}
 	}
 }
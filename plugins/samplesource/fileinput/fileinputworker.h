@@ -25,6 +25,7 @@
 #include <cstdlib>
 
 #include "dsp/inthalfbandfilter.h"
+#include "dsp/sampletimestamp.h"
 #include "util/message.h"
 
 #define FILESOURCE_THROTTLE_MS 50
@@ -64,6 +65,8 @@ public:
 	bool isRunning() const { return m_running; }
     quint64 getSamplesCount() const { return m_samplesCount; }
     void setSamplesCount(quint64 samplesCount) { m_samplesCount = samplesCount; }
+    //! Recording start in ms since epoch (0 if unknown) and recorded sample rate which is not affected by acceleration
+    void setRecordingStart(qint64 startTimestamp, int sampleRate) { m_startTimestamp = startTimestamp; m_recordSampleRate = sampleRate; }
 
 private:
 	volatile bool m_running;
@@ -75,6 +78,8 @@ private:
     qint64 m_chunksize;
 	SampleSinkFifo* m_sampleFifo;
     quint64 m_samplesCount;
+    qint64 m_startTimestamp;
+    int m_recordSampleRate;
     const QTimer& m_timer;
     MessageQueue *m_fileInputMessageQueue;
 
@@ -84,9 +89,11 @@ private:
     qint64 m_throttlems;
     QElapsedTimer m_elapsedTimer;
     bool m_throttleToggle;
+    bool m_tickPending;    //!< Next read is scheduled when reading unthrottled
 
 	//void decimate1(SampleVector::iterator* it, const qint16* buf, qint32 len);
 	void writeToSampleFifo(const quint8* buf, qint32 nbBytes);
+	SampleTimestamp recordingTimestamp() const;
 
 private slots:
 	void tick();
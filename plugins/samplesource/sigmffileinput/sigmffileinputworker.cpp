@@ -54,6 +54,7 @@ SigMFFileInputWorker::SigMFFileInputWorker(std::ifstream *samplesStream,
 	m_samplebytes(2),
     m_throttlems(FILESOURCE_THROTTLE_MS),
     m_throttleToggle(false),
+    m_tickPending(false),
     m_sigMFConverter(nullptr)
 {
 }
@@ -81,7 +82,20 @@ void SigMFFileInputWorker::startWork()
     {
         qDebug() << "SigMFFileInputWorker::startWork: file stream open, starting...";
         m_elapsedTimer.start();
-        connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+
+        if (SampleSinkFifo::getBackpressure()) // read as fast as the FIFO is emptied
+        {
+            if (!m_tickPending && !m_ifstream->eof())
+            {
+                m_tickPending = true;
+                QMetaObject::invokeMethod(this, "tick", Qt::QueuedConnection);
+            }
+        }
+        else
+        {
+            connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+        }
+
         m_running = true;
     }
     else
@@ -187,9 +201,12 @@ void SigMFFileInputWorker::setBuffers(std::size_t chunksize)
 
 void SigMFFileInputWorker::tick()
 {
+    m_tickPending = false;
+
 	if (m_running)
 	{
-        qint64 throttlems = m_elapsedTimer.restart();
+        bool unthrottled = SampleSinkFifo::getBackpressure();
+        qint64 throttlems = unthrottled ? m_throttlems : m_elapsedTimer.restart();
 
         if (throttlems != m_throttlems)
         {
@@ -233,6 +250,12 @@ void SigMFFileInputWorker::tick()
                 MsgReportTrackChange *message = MsgReportTrackChange::create(m_currentTrackIndex);
                 m_fileInputMessageQueue->push(message);
             }
+
+            if (unthrottled && m_running && !m_tickPending)
+            {
+                m_tickPending = true;
+                QMetaObject::invokeMethod(this, "tick", Qt::QueuedConnection);
+            }
         }
 	}
 }
@@ -425,6 +448,23 @@ void SigMFFileInputWorker::setConverter()
     }
 }
 
+// In batch processing the wall clock has nothing to do with the recording so samples are timed from the
+// core:datetime of their capture
+SampleTimestamp SigMFFileInputWorker::recordingTimestamp() const
+{
+    if (!SampleSinkFifo::getBackpressure() || !m_captures || (m_currentTrackIndex >= m_captures->size())) {
+        return SampleTimestamp();
+    }
+
+    const SigMFFileCapture& capture = m_captures->at(m_currentTrackIndex);
+
+    if ((capture.m_tsms == 0) || (capture.m_sampleRate == 0)) {
+        return SampleTimestamp();
+    }
+
+    return SampleTimestamp(m_samplesCount, capture.m_sampleStart, capture.m_tsms * 1000000LL, capture.m_sampleRate);
+}
+
 void SigMFFileInputWorker::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
 {
     if (!m_sigMFConverter)
@@ -433,23 +473,25 @@ void SigMFFileInputWorker::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
         return;
     }
 
+    SampleTimestamp timestamp = recordingTimestamp();
+
 #if defined(__WINDOWS__) || (BYTE_ORDER == LITTLE_ENDIAN)
     if ((m_metaInfo->m_dataType.m_complex) && (!m_metaInfo->m_dataType.m_bigEndian) && (!m_metaInfo->m_dataType.m_swapIQ))
     {
         if ((m_samplesize == 16) && (SDR_RX_SAMP_SZ == 16))
         {
-            m_sampleFifo->write(buf, nbBytes);
+            m_sampleFifo->write(buf, nbBytes, timestamp);
             return;
         }
         if ((m_samplesize == 24) && (SDR_RX_SAMP_SZ == 24))
         {
-            m_sampleFifo->write(buf, nbBytes);
+            m_sampleFifo->write(buf, nbBytes, timestamp);
             return;
         }
     }
 #endif
     int nbSamples = m_sigMFConverter->convert((FixReal *) m_convertBuf, buf, nbBytes);
-    m_sampleFifo->write(m_convertBuf, nbSamples*sizeof(Sample));
+    m_sampleFifo->write(m_convertBuf, nbSamples*sizeof(Sample), timestamp);
 }
 
 void SigMFFileInputWorker::writeToSampleFifoBAK(const quint8* buf, qint32 nbBytes)
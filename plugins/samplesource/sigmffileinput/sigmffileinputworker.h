@@ -26,6 +26,7 @@
 #include <cstdlib>
 
 #include "dsp/inthalfbandfilter.h"
+#include "dsp/sampletimestamp.h"
 #include "util/message.h"
 
 #define FILESOURCE_THROTTLE_MS 50
@@ -113,6 +114,7 @@ private:
     qint64 m_throttlems;
     QElapsedTimer m_elapsedTimer;
     bool m_throttleToggle;
+    bool m_tickPending;    //!< Next read is scheduled when reading unthrottled
 
     SigMFConverterInterface *m_sigMFConverter;
 
@@ -121,6 +123,7 @@ private:
 	void setSampleRate();
     void setConverter();
 	void writeToSampleFifo(const quint8* buf, qint32 nbBytes);
+	SampleTimestamp recordingTimestamp() const;
 	void writeToSampleFifoBAK(const quint8* buf, qint32 nbBytes);
 
 private slots:
@@ -16,6 +16,9 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QGlobalStatic>
+#include <QElapsedTimer>
+
+#include <thread>
 
 #include "plugin/pluginmanager.h"
 
@@ -246,6 +249,82 @@ bool DeviceEnumerator::isMIMOEnumerated(const QString& deviceHwId, int deviceSeq
     return false;
 }
 
+void DeviceEnumerator::enumerateOriginDevices(PluginManager *pluginManager)
+{
+    // One plugin per hardware type does the actual enumeration (see enumOriginDevices implementations)
+    QList<PluginAPI::SamplingDeviceRegistrations*> allRegistrations;
+    allRegistrations.append(&pluginManager->getSourceDeviceRegistrations());
+    allRegistrations.append(&pluginManager->getSinkDeviceRegistrations());
+    allRegistrations.append(&pluginManager->getMIMODeviceRegistrations());
+    QStringList hwIds;
+    QList<PluginInterface*> plugins;
+
+    for (const auto registrations : allRegistrations)
+    {
+        for (const auto& registration : *registrations)
+        {
+            if (!hwIds.contains(registration.m_deviceHardwareId) && !m_originDevicesHwIds.contains(registration.m_deviceHardwareId))
+            {
+                hwIds.append(registration.m_deviceHardwareId);
+                plugins.append(registration.m_plugin);
+            }
+        }
+    }
+
+    struct Enumeration
+    {
+        QStringList m_listedHwIds;
+        PluginInterface::OriginDevices m_originDevices;
+        qint64 m_elapsedMs;
+    };
+
+    std::vector<Enumeration> enumerations(plugins.size());
+    std::vector<std::thread> threads;
+    QList<int> sequential;
+
+    auto enumerate = [&enumerations, &plugins](int i) {
+        QElapsedTimer timer;
+        timer.start();
+        plugins[i]->enumOriginDevices(enumerations[i].m_listedHwIds, enumerations[i].m_originDevices);
+        enumerations[i].m_elapsedMs = timer.elapsed();
+    };
+
+    for (int i = 0; i < plugins.size(); i++)
+    {
+        enumerations[i].m_listedHwIds = m_originDevicesHwIds;
+
+        // SoapySDR modules wrap the same vendor libraries as the native plugins (e.g. hackrf_init)
+        if (hwIds[i] == "SoapySDR") {
+            sequential.append(i);
+        } else {
+            threads.push_back(std::thread(enumerate, i));
+        }
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i : sequential) {
+        enumerate(i);
+    }
+
+    // Merge in registration order so that the result is the same as with sequential enumeration
+    for (int i = 0; i < plugins.size(); i++)
+    {
+        qDebug("DeviceEnumerator::enumerateOriginDevices: %s: %d devices in %lld ms",
+            qPrintable(hwIds[i]), enumerations[i].m_originDevices.size(), enumerations[i].m_elapsedMs);
+        m_originDevices.append(enumerations[i].m_originDevices);
+
+        for (const auto& hwId : enumerations[i].m_listedHwIds)
+        {
+            if (!m_originDevicesHwIds.contains(hwId)) {
+                m_originDevicesHwIds.append(hwId);
+            }
+        }
+    }
+}
+
 void DeviceEnumerator::enumerateRxDevices(PluginManager *pluginManager)
 {
     m_rxEnumeration.clear();
@@ -34,6 +34,7 @@ public:
 
     static DeviceEnumerator *instance();
 
+    void enumerateOriginDevices(PluginManager *pluginManager); //!< Enumerate origin devices of all hardware types in parallel
     void enumerateRxDevices(PluginManager *pluginManager);
     void enumerateTxDevices(PluginManager *pluginManager);
     void enumerateMIMODevices(PluginManager *pluginManager);
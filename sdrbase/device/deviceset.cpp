@@ -17,9 +17,15 @@
 
 #include <algorithm>
 
+#include <QDateTime>
+
+#include "SWGSuccessResponse.h"
+
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/spectrumvis.h"
+#include "dsp/iqhistory.h"
+#include "device/deviceapi.h"
 #include "plugin/pluginapi.h"
 #include "plugin/plugininterface.h"
 #include "settings/preset.h"
@@ -37,6 +43,7 @@ DeviceSet::DeviceSet(int tabIndex, int deviceType)
     m_deviceSourceEngine = nullptr;
     m_deviceSinkEngine = nullptr;
     m_deviceMIMOEngine = nullptr;
+    m_iqHistory = nullptr;
     m_deviceTabIndex = tabIndex;
 
     if ((deviceType == 0) || (deviceType == 2)) { // Single Rx or MIMO
@@ -48,6 +55,12 @@ DeviceSet::DeviceSet(int tabIndex, int deviceType)
 
 DeviceSet::~DeviceSet()
 {
+    if (m_iqHistory)
+    {
+        m_deviceAPI->removeChannelSink(m_iqHistory);
+        delete m_iqHistory;
+    }
+
     delete m_spectrumVis;
 }
 
@@ -481,6 +494,94 @@ int DeviceSet::webapiSpectrumServerDelete(SWGSDRangel::SWGSuccessResponse& respo
     return m_spectrumVis->webapiSpectrumServerDelete(response, errorMessage);
 }
 
+int DeviceSet::webapiSpectrumWaterfallGet(const SpectrumWaterfall::TileRequest& request, QByteArray& png, QString& errorMessage) const
+{
+    return m_spectrumVis->webapiSpectrumWaterfallGet(request, png, errorMessage);
+}
+
+int DeviceSet::webapiSpectrumWaterfallPost(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage)
+{
+    return m_spectrumVis->webapiSpectrumWaterfallPost(response, errorMessage);
+}
+
+int DeviceSet::webapiSpectrumWaterfallDelete(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage)
+{
+    return m_spectrumVis->webapiSpectrumWaterfallDelete(response, errorMessage);
+}
+
+int DeviceSet::webapiIQHistoryPost(quint64 memoryBytes, SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage)
+{
+    if (!m_deviceSourceEngine)
+    {
+        errorMessage = "IQ history is only available for single Rx device sets";
+        return 400;
+    }
+
+    if (!m_iqHistory)
+    {
+        m_iqHistory = new IQHistory(m_deviceAPI->getHardwareId(), m_deviceAPI->getDeviceUID());
+
+        if (!m_iqHistory->setMemoryBudget(memoryBytes))
+        {
+            delete m_iqHistory;
+            m_iqHistory = nullptr;
+            errorMessage = QString("Cannot allocate %1 MB for IQ history").arg(memoryBytes / (1024*1024));
+            return 500;
+        }
+
+        m_deviceAPI->addChannelSink(m_iqHistory);
+    }
+    else if (m_iqHistory->getMemoryBudget() < memoryBytes)
+    {
+        if (!m_iqHistory->setMemoryBudget(memoryBytes))
+        {
+            errorMessage = QString("Cannot allocate %1 MB for IQ history").arg(memoryBytes / (1024*1024));
+            return 500;
+        }
+    }
+
+    response.setMessage(new QString(QString("IQ history started with %1 MB").arg(m_iqHistory->getMemoryBudget() / (1024*1024))));
+    return 200;
+}
+
+int DeviceSet::webapiIQHistoryDelete(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage)
+{
+    if (!m_iqHistory)
+    {
+        errorMessage = "IQ history is not started";
+        return 404;
+    }
+
+    m_deviceAPI->removeChannelSink(m_iqHistory);
+    delete m_iqHistory; // waits for pending captures
+    m_iqHistory = nullptr;
+    response.setMessage(new QString("IQ history stopped"));
+    return 200;
+}
+
+int DeviceSet::webapiIQHistoryCapturePost(
+    qint64 startTime,
+    qint64 endTime,
+    const QString& fileName,
+    SWGSDRangel::SWGSuccessResponse& response,
+    QString& errorMessage)
+{
+    if (!m_iqHistory)
+    {
+        errorMessage = "IQ history is not started";
+        return 404;
+    }
+
+    QString captureFileName = fileName;
+
+    if (!m_iqHistory->capture(startTime, endTime, captureFileName, errorMessage)) {
+        return 400;
+    }
+
+    response.setMessage(new QString(captureFileName));
+    return 202;
+}
+
 void DeviceSet::addChannelInstance(ChannelAPI *channelAPI)
 {
     MainCore *mainCore = MainCore::instance();
@@ -21,6 +21,7 @@
 #include <QTimer>
 
 #include "export.h"
+#include "dsp/spectrumwaterfall.h"
 
 class DeviceAPI;
 class DSPDeviceSourceEngine;
@@ -30,6 +31,7 @@ class PluginAPI;
 class ChannelAPI;
 class Preset;
 class SpectrumVis;
+class IQHistory;
 
 namespace SWGSDRangel {
     class SWGGLSpectrum;
@@ -45,6 +47,7 @@ public:
     DSPDeviceSinkEngine *m_deviceSinkEngine;
     DSPDeviceMIMOEngine *m_deviceMIMOEngine;
     SpectrumVis *m_spectrumVis;
+    IQHistory *m_iqHistory; //!< Optional ring buffer of device samples for retroactive capture (Rx only)
 
     DeviceSet(int tabIndex, int deviceType);
     ~DeviceSet();
@@ -81,6 +84,17 @@ public:
     int webapiSpectrumServerGet(SWGSDRangel::SWGSpectrumServer& response, QString& errorMessage) const;
     int webapiSpectrumServerPost(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
     int webapiSpectrumServerDelete(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
+    int webapiSpectrumWaterfallGet(const SpectrumWaterfall::TileRequest& request, QByteArray& png, QString& errorMessage) const;
+    int webapiSpectrumWaterfallPost(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
+    int webapiSpectrumWaterfallDelete(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
+    int webapiIQHistoryPost(quint64 memoryBytes, SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
+    int webapiIQHistoryDelete(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
+    int webapiIQHistoryCapturePost(
+            qint64 startTime,
+            qint64 endTime,
+            const QString& fileName,
+            SWGSDRangel::SWGSuccessResponse& response,
+            QString& errorMessage);
 
 private:
     typedef QList<ChannelAPI*> ChannelInstanceRegistrations;
@@ -20,6 +20,7 @@
 #define INCLUDE_SAMPLESINK_H
 
 #include "dsp/dsptypes.h"
+#include "dsp/sampletimestamp.h"
 #include "export.h"
 #include "util/messagequeue.h"
 
@@ -34,6 +35,9 @@ public:
 	virtual void stop() = 0;
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly) = 0;
     virtual void feed(const Complex*, unsigned int) { //!< Special feed directly with complex array
+    }
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { //!< Timestamp of the first sample of the next block fed
+        (void) timestamp;
     }
 	virtual void pushMessage(Message *msg) = 0;
 	virtual QString getSinkName() = 0;
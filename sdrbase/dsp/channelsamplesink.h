@@ -23,6 +23,7 @@
 
 #include "export.h"
 #include "dsptypes.h"
+#include "sampletimestamp.h"
 
 class Message;
 
@@ -32,6 +33,7 @@ public:
 	virtual ~ChannelSampleSink();
 
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end) = 0;
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { (void) timestamp; } //!< Timestamp of the first sample of the next block fed
 };
 
 #endif // SDRBASE_DSP_CHANNELSAMPLESINK_H_
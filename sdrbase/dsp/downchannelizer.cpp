@@ -33,7 +33,10 @@ DownChannelizer::DownChannelizer(ChannelSampleSink* sampleSink) :
     m_channelSampleRate(0),
 	m_channelFrequencyOffset(0),
     m_log2Decim(0),
-    m_filterChainHash(0)
+    m_filterChainHash(0),
+    m_blockProcessing(true),
+    m_inputCount(0),
+    m_outputCount(0)
 {
 }
 
@@ -50,41 +53,113 @@ void DownChannelizer::feed(const SampleVector::const_iterator& begin, const Samp
 		return;
 	}
 
+	// An invalid timestamp is forwarded too so that the sink does not time this block from a previous one
+	m_sampleSink->setTimestamp(m_timestamp.isValid() ? outputTimestamp() : SampleTimestamp());
+	m_timestamp = SampleTimestamp(); // only for this block
+
 	if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
 	{
 		m_sampleSink->feed(begin, end);
+		m_outputCount += end - begin;
+	}
+	else if (m_blockProcessing)
+	{
+		feedBlock(begin, end);
 	}
 	else
 	{
-		for (SampleVector::const_iterator sample = begin; sample != end; ++sample)
-		{
-			Sample s(*sample);
-			FilterStages::iterator stage = m_filterStages.begin();
+		feedOne(begin, end);
+	}
+
+	m_inputCount += end - begin;
+}
+
+// Timestamp of the first output sample of the block about to be fed in input samples.
+// Each stage outputs a sample every second input so the next output is computed about when input
+// (m_outputCount + 1) * decimation - 1 is fed. The half band filters delay the signal by half their
+// length at the input rate of each stage which is subtracted so that the time is the time of the signal.
+SampleTimestamp DownChannelizer::outputTimestamp() const
+{
+	qint64 decimation = 1LL << m_filterStages.size();
+	qint64 index = ((qint64) m_outputCount + 1) * decimation - 1 - (DOWNCHANNELIZER_HB_FILTER_ORDER/2) * (decimation - 1);
+	return m_timestamp.advanced(index - (qint64) m_inputCount);
+}
 
-			for (; stage != m_filterStages.end(); ++stage)
-			{
+void DownChannelizer::feedOne(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+	m_sampleBuffer.clear(); // may hold a previous feedBlock output
+
+	for (SampleVector::const_iterator sample = begin; sample != end; ++sample)
+	{
+		Sample s(*sample);
+		FilterStages::iterator stage = m_filterStages.begin();
+
+		for (; stage != m_filterStages.end(); ++stage)
+		{
 #ifndef SDR_RX_SAMPLE_24BIT
-                s.m_real /= 2; // avoid saturation on 16 bit samples
-                s.m_imag /= 2;
+            s.m_real /= 2; // avoid saturation on 16 bit samples
+            s.m_imag /= 2;
 #endif
-				if (!(*stage)->work(&s)) {
-					break;
-				}
+			if (!(*stage)->work(&s)) {
+				break;
 			}
+		}
 
-			if(stage == m_filterStages.end())
-			{
+		if(stage == m_filterStages.end())
+		{
 #ifdef SDR_RX_SAMPLE_24BIT
-			    s.m_real /= (1<<(m_filterStages.size())); // on 32 bit samples there is enough headroom to just divide the final result
-			    s.m_imag /= (1<<(m_filterStages.size()));
+		    s.m_real /= (1<<(m_filterStages.size())); // on 32 bit samples there is enough headroom to just divide the final result
+		    s.m_imag /= (1<<(m_filterStages.size()));
 #endif
-				m_sampleBuffer.push_back(s);
-			}
+			m_sampleBuffer.push_back(s);
 		}
+	}
 
-		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end());
-		m_sampleBuffer.clear();
+	m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end());
+	m_outputCount += m_sampleBuffer.size();
+	m_sampleBuffer.clear();
+}
+
+// Each stage runs over the whole buffer before the next one. Stages only keep their own state
+// so the output is bit exact with the sample by sample path.
+// The first stage reads the input directly and the following ones work in place in its output.
+void DownChannelizer::feedBlock(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+	unsigned int nb = end - begin;
+
+	if (nb == 0)
+	{
+		m_sampleSink->feed(begin, end); // consumes the timestamp of this block
+		return;
 	}
+
+	// Each stage outputs at most one sample every two inputs, plus one for the phase carried over
+	unsigned int size = nb / 2 + 1;
+
+	if (m_sampleBuffer.size() < size) { // only grows so that steady state has no allocation or initialization
+		m_sampleBuffer.resize(size);
+	}
+
+	FilterStages::iterator stage = m_filterStages.begin();
+	Sample *samples = m_sampleBuffer.data();
+	nb = (*stage)->workBlock(&(*begin), nb, samples);
+
+	for (++stage; (stage != m_filterStages.end()) && (nb > 0); ++stage) {
+		nb = (*stage)->workBlock(samples, nb, samples);
+	}
+
+#ifdef SDR_RX_SAMPLE_24BIT
+	unsigned int log2Decim = m_filterStages.size();
+
+	for (unsigned int i = 0; i < nb; i++)
+	{
+		samples[i].m_real /= (1<<log2Decim); // on 32 bit samples there is enough headroom to just divide the final result
+		samples[i].m_imag /= (1<<log2Decim);
+	}
+#endif
+
+	m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.begin() + nb);
+	m_outputCount += nb;
 }
 
 void DownChannelizer::setChannelization(int requestedSampleRate, qint64 requestedCenterFrequency)
@@ -302,6 +377,8 @@ void DownChannelizer::freeFilterChain()
 	for(FilterStages::iterator it = m_filterStages.begin(); it != m_filterStages.end(); ++it)
 		delete *it;
 	m_filterStages.clear();
+	m_inputCount = 0;
+	m_outputCount = 0;
 }
 
 void DownChannelizer::debugFilterChain()
@@ -36,6 +36,7 @@ public:
 	virtual ~DownChannelizer();
 
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { m_timestamp = timestamp; } //!< Passed to the sink with the output block of the next block fed
 
     void setDecimation(unsigned int log2Decim, unsigned int filterChainHash);         //!< Define channelizer with decimation factor and filter chain definition
     void setChannelization(int requestedSampleRate, qint64 requestedCenterFrequency); //!< Define channelizer with requested sample rate and center frequency (shift in the baseband)
@@ -43,6 +44,8 @@ public:
 	int getBasebandSampleRate() const { return m_basebandSampleRate; }
     int getChannelSampleRate() const { return m_channelSampleRate; }
 	int getChannelFrequencyOffset() const { return m_channelFrequencyOffset; }
+    void setBlockProcessing(bool blockProcessing) { m_blockProcessing = blockProcessing; } //!< Run each stage over the whole buffer (default, used by all channels) or one sample at a time through all stages (reference)
+    bool getBlockProcessing() const { return m_blockProcessing; }
 
 protected:
 	struct FilterStage {
@@ -71,6 +74,42 @@ protected:
 		{
 			return (m_filter->*m_workFunction)(sample);
 		}
+
+        //!< Decimate a block of nb samples from in to out. out may be in. Returns the number of output samples.
+        unsigned int workBlock(const Sample* in, unsigned int nb, Sample* out)
+        {
+            // Mode is resolved once per block so the filter call is direct and can be inlined
+            switch (m_mode)
+            {
+            case ModeLowerHalf:
+                return workBlock(in, nb, out, [this](Sample* s) { return m_filter->workDecimateLowerHalf(s); });
+            case ModeUpperHalf:
+                return workBlock(in, nb, out, [this](Sample* s) { return m_filter->workDecimateUpperHalf(s); });
+            case ModeCenter:
+            default:
+                return workBlock(in, nb, out, [this](Sample* s) { return m_filter->workDecimateCenter(s); });
+            }
+        }
+
+        template<typename Work>
+        unsigned int workBlock(const Sample* in, unsigned int nb, Sample* out, Work work)
+        {
+            Sample *start = out;
+
+            for (unsigned int i = 0; i < nb; i++)
+            {
+                Sample s = in[i];
+#ifndef SDR_RX_SAMPLE_24BIT
+                s.m_real /= 2; // avoid saturation on 16 bit samples
+                s.m_imag /= 2;
+#endif
+                if (work(&s)) {
+                    *out++ = s; // when in place output index never overtakes input index
+                }
+            }
+
+            return out - start;
+        }
 	};
 	typedef std::list<FilterStage*> FilterStages;
 	FilterStages m_filterStages;
@@ -83,8 +122,15 @@ protected:
     int m_channelFrequencyOffset;
     unsigned int m_log2Decim;
     unsigned int m_filterChainHash;
+    bool m_blockProcessing;
 	SampleVector m_sampleBuffer;
+    SampleTimestamp m_timestamp;    //!< Timestamp of the next input block if any
+    quint64 m_inputCount;           //!< Samples fed since filter chain was created
+    quint64 m_outputCount;          //!< Samples output since filter chain was created
 
+	void feedOne(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+	void feedBlock(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    SampleTimestamp outputTimestamp() const;
 	void applyChannelization();
     void applyDecimation();
 	bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
@@ -203,31 +203,32 @@ void DSPDeviceSinkEngine::workSamples(SampleVector& data, unsigned int iBegin, u
     }
     else
     {
+        // Accumulate all sources in floating point then scale by 1/N once. Unlike the former
+        // running n/n+1 average this has no integer division per sample and vectorizes.
         m_sourceSampleBuffer.allocate(nbSamples);
-        SampleVector::iterator sBegin = m_sourceSampleBuffer.m_vector.begin();
-        BasebandSampleSources::const_iterator srcIt = m_basebandSampleSources.begin();
-        BasebandSampleSource *source = *srcIt;
-        source->pull(begin, nbSamples);
-        srcIt++;
-        m_sumIndex = 1;
+        m_sumBuffer.allocate(2*nbSamples);
+        const Sample *s = m_sourceSampleBuffer.m_vector.data();
+        float *acc = m_sumBuffer.m_vector.data();
+        std::fill(acc, acc + 2*nbSamples, 0.0f);
+
+        for (BasebandSampleSources::const_iterator srcIt = m_basebandSampleSources.begin(); srcIt != m_basebandSampleSources.end(); ++srcIt)
+        {
+            (*srcIt)->pull(m_sourceSampleBuffer.m_vector.begin(), nbSamples);
+
+            for (unsigned int i = 0; i < nbSamples; i++)
+            {
+                acc[2*i]   += s[i].m_real;
+                acc[2*i+1] += s[i].m_imag;
+            }
+        }
+
+        const float scale = 1.0f / m_basebandSampleSources.size();
+        Sample *out = &data[iBegin];
 
-        for (; srcIt != m_basebandSampleSources.end(); ++srcIt, m_sumIndex++)
+        for (unsigned int i = 0; i < nbSamples; i++)
         {
-            source = *srcIt;
-            source->pull(sBegin, nbSamples);
-            std::transform(
-                sBegin,
-                sBegin + nbSamples,
-                data.begin() + iBegin,
-                data.begin() + iBegin,
-                [this](Sample& a, const Sample& b) -> Sample {
-                    FixReal den = m_sumIndex + 1; // at each stage scale sum by n/n+1 and input by 1/n+1
-                    FixReal nom = m_sumIndex;     // so that final sum is scaled by N (number of channels)
-					FixReal x = a.real()/den + nom*(b.real()/den);
-					FixReal y = a.imag()/den + nom*(b.imag()/den);
-                    return Sample{x, y};
-                }
-            );
+            out[i].m_real = (FixReal) (acc[2*i] * scale);
+            out[i].m_imag = (FixReal) (acc[2*i+1] * scale);
         }
     }
 
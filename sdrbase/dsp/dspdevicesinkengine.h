@@ -100,10 +100,10 @@ private:
 	BasebandSampleSink *m_spectrumSink;
     IncrementalVector<Sample> m_sourceSampleBuffer;
     IncrementalVector<Sample> m_sourceZeroBuffer;
+    IncrementalVector<float> m_sumBuffer; //!< Interleaved I/Q accumulator when summing several sources
 
 	uint32_t m_sampleRate;
 	quint64 m_centerFrequency;
-    unsigned int m_sumIndex; //!< channel index when summing channels
 
 	void run();
 	void workSampleFifo(); //!< transfer samples from baseband sources to sink if in running state
@@ -21,6 +21,7 @@
 #include <dsp/basebandsamplesink.h>
 #include <dsp/devicesamplesource.h>
 #include <stdio.h>
+#include <cstdlib>
 #include <QDebug>
 #include "dsp/dspcommands.h"
 #include "util/fixed.h"
@@ -35,6 +36,7 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_basebandSampleSinks(),
 	m_sampleRate(0),
 	m_centerFrequency(0),
+	m_sampleIndex(0),
 	m_dcOffsetCorrection(false),
 	m_iqImbalanceCorrection(false),
 	m_iOffset(0),
@@ -320,7 +322,10 @@ void DSPDeviceSourceEngine::work()
 		SampleVector::iterator part2begin;
 		SampleVector::iterator part2end;
 
-		std::size_t count = sampleFifo->readBegin(sampleFifo->fill(), &part1begin, &part1end, &part2begin, &part2end);
+		unsigned int fill = sampleFifo->fill();
+		SampleTimestamp sourceTimestamp = sampleFifo->getReadTimestamp(fill); // read up to next discontinuity of source timestamps
+		std::size_t count = sampleFifo->readBegin(fill, &part1begin, &part1end, &part2begin, &part2end);
+		SampleTimestamp timestamp = updateTimestamp(sampleFifo, sourceTimestamp);
 
 		// first part of FIFO data
 		if (part1begin != part1end)
@@ -334,6 +339,7 @@ void DSPDeviceSourceEngine::work()
 			// feed data to direct sinks
 			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it)
 			{
+				(*it)->setTimestamp(timestamp);
 				(*it)->feed(part1begin, part1end, positiveOnly);
 			}
 
@@ -348,9 +354,12 @@ void DSPDeviceSourceEngine::work()
                 iqCorrections(part2begin, part2end, m_iqImbalanceCorrection);
             }
 
+			SampleTimestamp part2Timestamp = timestamp.isValid() ? timestamp.advanced(part1end - part1begin) : timestamp;
+
 			// feed data to direct sinks
 			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); it++)
 			{
+				(*it)->setTimestamp(part2Timestamp);
 				(*it)->feed(part2begin, part2end, positiveOnly);
 			}
 
@@ -359,7 +368,50 @@ void DSPDeviceSourceEngine::work()
 		// adjust FIFO pointers
 		sampleFifo->readCommit((unsigned int) count);
 		samplesDone += count;
+		m_sampleIndex += count;
+	}
+}
+
+// Samples are timed by their index on the device clock from a wall clock anchor.
+// If the source writes its samples with timestamps (e.g. recording start time or hardware time) the anchor
+// follows the time of the source. Otherwise the wall clock time of the next sample is estimated from the time
+// of the last write in the FIFO, which is late by the transfer and scheduling latency, and the anchor is only
+// reset when the estimate and the device clock differ by more than m_maxTimeErrorNs (samples lost or device
+// clock off nominal) so that latency jitter does not move it. It is also reset on sample rate change.
+SampleTimestamp DSPDeviceSourceEngine::updateTimestamp(SampleSinkFifo *sampleFifo, const SampleTimestamp& sourceTimestamp)
+{
+	if (m_sampleRate == 0) {
+		return SampleTimestamp();
+	}
+
+	SampleTimestamp timestamp(m_sampleIndex, m_anchor.m_anchorIndex, m_anchor.m_anchorNs, m_sampleRate);
+	bool reanchor = !m_anchor.isValid() || (m_anchor.m_sampleRate != m_sampleRate);
+	qint64 anchorNs;
+
+	if (sourceTimestamp.isValid())
+	{
+		anchorNs = sourceTimestamp.getTimeNs();
+		// Half a sample of tolerance for the rounding of both times to ns
+		reanchor = reanchor || (std::abs(anchorNs - timestamp.getTimeNs()) > SampleTimestamp::samplesToNs(1, m_sampleRate) / 2);
+	}
+	else
+	{
+		anchorNs = sampleFifo->getHeadTimeNs(m_sampleRate);
+
+		if (anchorNs == 0) { // no write yet
+			return SampleTimestamp();
+		}
+
+		reanchor = reanchor || (std::abs(anchorNs - timestamp.getTimeNs()) > m_maxTimeErrorNs);
 	}
+
+	if (reanchor)
+	{
+		m_anchor = SampleTimestamp(m_sampleIndex, m_sampleIndex, anchorNs, m_sampleRate);
+		return m_anchor;
+	}
+
+	return timestamp;
 }
 
 // notStarted -> idle -> init -> running -+
@@ -486,6 +538,9 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoRunning()
 
 	// Start everything
 
+	m_sampleIndex = 0;
+	m_anchor = SampleTimestamp();
+
 	if(!m_deviceSampleSource->start())
 	{
 		return gotoError("Could not start sample source");
@@ -23,8 +23,10 @@
 #include <QTimer>
 #include <QMutex>
 #include <QWaitCondition>
+#include <atomic>
 #include "dsp/dsptypes.h"
 #include "dsp/fftwindow.h"
+#include "dsp/sampletimestamp.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "export.h"
@@ -32,6 +34,7 @@
 
 class DeviceSampleSource;
 class BasebandSampleSink;
+class SampleSinkFifo;
 
 class SDRBASE_API DSPDeviceSourceEngine : public QThread {
 	Q_OBJECT
@@ -69,10 +72,13 @@ public:
 	void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection); //!< Configure DSP corrections
 
 	State state() const { return m_state; } //!< Return DSP engine current state
+	quint64 getSampleIndex() const { return m_sampleIndex.load(); } //!< Device samples fed to sinks since acquisition start. Can be called from any thread.
 
 	QString errorMessage(); //!< Return the current error message
 	QString sourceDeviceDescription(); //!< Return the source device description
 
+	static const qint64 m_maxTimeErrorNs = 50000000; //!< Difference between wall clock estimate and device clock that resets the timestamp anchor
+
 private:
 	uint m_uid; //!< unique ID
 
@@ -92,6 +98,8 @@ private:
 
 	uint m_sampleRate;
 	quint64 m_centerFrequency;
+	std::atomic<quint64> m_sampleIndex; //!< Device samples fed to sinks since acquisition start. Written by the engine thread only.
+	SampleTimestamp m_anchor;          //!< Wall clock anchor of sample timestamps
 
 	bool m_dcOffsetCorrection;
 	bool m_iqImbalanceCorrection;
@@ -129,6 +137,7 @@ private:
 	void dcOffset(SampleVector::iterator begin, SampleVector::iterator end);
 	void imbalance(SampleVector::iterator begin, SampleVector::iterator end);
 	void work(); //!< transfer samples from source to sinks if in running state
+	SampleTimestamp updateTimestamp(SampleSinkFifo *sampleFifo, const SampleTimestamp& sourceTimestamp); //!< Timestamp of the next sample read from the device FIFO
 
 	State gotoIdle();     //!< Go to the idle state
 	State gotoInit();     //!< Go to the acquisition init state from idle
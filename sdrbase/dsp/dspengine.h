@@ -25,6 +25,7 @@
 
 #include "audio/audiodevicemanager.h"
 #include "audio/audiooutputdevice.h"
+#include "dsp/vocoderpool.h"
 #include "export.h"
 
 class DSPDeviceSourceEngine;
@@ -70,6 +71,7 @@ public:
     void createFFTFactory(const QString& fftWisdomFileName);
     void preAllocateFFTs();
     FFTFactory *getFFTFactory() { return m_fftFactory; }
+    VocoderPool *getVocoderPool() { return &m_vocoderPool; }
 
 private:
     struct DeviceEngineReference
@@ -94,6 +96,7 @@ private:
 	bool m_dvSerialSupport;
     bool m_mimoSupport;
     FFTFactory *m_fftFactory;
+    VocoderPool m_vocoderPool;
 };
 
 #endif // INCLUDE_DSPENGINE_H
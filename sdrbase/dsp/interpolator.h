@@ -89,16 +89,6 @@ public:
 		return true;
 	}
 
-private:
-	float* m_taps;
-	float* m_alignedTaps;
-	float* m_taps2;
-	float* m_alignedTaps2;
-	std::vector<Complex> m_samples;
-	int m_ptr;
-	int m_phaseSteps;
-	int m_nTaps;
-
 	static void createPolyphaseLowPass(
 	    std::vector<Real>& taps,
 	    int phaseSteps,
@@ -116,6 +106,16 @@ private:
         double cutoffFreqHz,
         double nbTapsPerPhase);
 
+private:
+	float* m_taps;
+	float* m_alignedTaps;
+	float* m_taps2;
+	float* m_alignedTaps2;
+	std::vector<Complex> m_samples;
+	int m_ptr;
+	int m_phaseSteps;
+	int m_nTaps;
+
 	void createTaps(int nTaps, double sampleRate, double cutoff, std::vector<Real>* taps);
 
 	void advanceFilter(const Complex& next)
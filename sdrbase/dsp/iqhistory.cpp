@@ -0,0 +1,442 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include <QThread>
+#include <QDateTime>
+#include <QDebug>
+
+#ifdef Q_OS_LINUX
+#include <sys/mman.h>
+#endif
+
+#include "dsp/dspcommands.h"
+#include "dsp/sigmffilerecord.h"
+#include "maincore.h"
+
+#include "iqhistory.h"
+
+MESSAGE_CLASS_DEFINITION(IQHistory::MsgCapture, Message)
+
+class IQHistory::Writer : public QThread
+{
+public:
+    struct Part
+    {
+        quint64 m_startIndex;
+        quint64 m_endIndex;
+        qint64 m_startUs;
+        quint32 m_sampleRate;
+        quint64 m_centerFrequency;
+    };
+
+    Writer(IQHistory *history, const QString& fileName, const QList<Part>& parts) :
+        m_history(history),
+        m_fileName(fileName),
+        m_parts(parts)
+    {}
+
+protected:
+    void run() override;
+
+private:
+    IQHistory *m_history;
+    QString m_fileName;
+    QList<Part> m_parts;
+
+    static const quint64 m_chunkSize = 1<<20; //!< Samples read from the ring and fed to the file at a time
+};
+
+void IQHistory::Writer::run()
+{
+    SigMFFileRecord record(m_fileName, m_history->m_hardwareId);
+    SampleVector chunk(m_chunkSize);
+    quint64 nbSamples = 0;
+    bool ok = true;
+
+    for (const auto& part : m_parts)
+    {
+        // Each part is a SigMF capture
+        record.handleMessage(DSPSignalNotification(part.m_sampleRate, part.m_centerFrequency));
+        record.setMsShift(part.m_startUs/1000 - QDateTime::currentMSecsSinceEpoch());
+
+        if (!record.startRecording())
+        {
+            ok = false;
+            break;
+        }
+
+        for (quint64 index = part.m_startIndex; index < part.m_endIndex; index += m_chunkSize)
+        {
+            quint64 count = part.m_endIndex - index;
+            count = count > m_chunkSize ? m_chunkSize : count;
+
+            if (!m_history->read(index, count, chunk.data()))
+            {
+                qWarning("IQHistory::Writer::run: %s: samples overwritten or capture aborted. File is truncated.", qPrintable(m_fileName));
+                ok = false;
+                break;
+            }
+
+            record.feed(chunk.begin(), chunk.begin() + count, false);
+            nbSamples += count;
+        }
+
+        record.stopRecording();
+
+        if (!ok) {
+            break;
+        }
+    }
+
+    qDebug("IQHistory::Writer::run: %s: %llu samples written in %d captures%s",
+        qPrintable(m_fileName), nbSamples, record.getNbCaptures(), ok ? "" : " (incomplete)");
+}
+
+IQHistory::IQHistory(const QString& hardwareId, unsigned int deviceUID) :
+    m_hardwareId(hardwareId),
+    m_deviceUID(deviceUID),
+    m_buffer(nullptr),
+    m_capacity(0),
+    m_mappedBytes(0),
+    m_writeIndex(0),
+    m_sampleRate(0),
+    m_centerFrequency(0),
+    m_newSegment(true),
+    m_abort(false)
+{
+    setObjectName("IQHistory");
+}
+
+IQHistory::~IQHistory()
+{
+    m_mutex.lock();
+    m_abort = true;
+    m_mutex.unlock();
+
+    for (auto writer : m_writers)
+    {
+        writer->wait();
+        delete writer;
+    }
+
+    release();
+}
+
+bool IQHistory::setMemoryBudget(quint64 bytes)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    // Writers read from the ring
+    if (m_writers.size() > 0)
+    {
+        m_abort = true;
+        mutexLocker.unlock();
+
+        for (auto writer : m_writers) {
+            writer->wait();
+        }
+
+        mutexLocker.relock();
+        qDeleteAll(m_writers);
+        m_writers.clear();
+        m_abort = false;
+    }
+
+    release();
+    m_writeIndex = 0;
+    m_segments.clear();
+    m_newSegment = true;
+
+    return allocate(bytes / sizeof(Sample));
+}
+
+bool IQHistory::allocate(quint64 capacity)
+{
+    if (capacity == 0) {
+        return false;
+    }
+
+#ifdef Q_OS_LINUX
+    // Map anonymous memory so that the kernel can back the ring with transparent huge pages
+    const quint64 hugePageSize = 2*1024*1024;
+    quint64 bytes = ((capacity * sizeof(Sample) + hugePageSize - 1) / hugePageSize) * hugePageSize;
+    void *memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (memory == MAP_FAILED)
+    {
+        qWarning("IQHistory::allocate: cannot map %llu bytes", bytes);
+        return false;
+    }
+
+#ifdef MADV_HUGEPAGE
+    madvise(memory, bytes, MADV_HUGEPAGE);
+#endif
+    m_buffer = static_cast<Sample*>(memory);
+    m_mappedBytes = bytes;
+    m_capacity = bytes / sizeof(Sample);
+#else
+    m_buffer = new (std::nothrow) Sample[capacity];
+
+    if (!m_buffer)
+    {
+        qWarning("IQHistory::allocate: cannot allocate %llu samples", capacity);
+        return false;
+    }
+
+    m_capacity = capacity;
+#endif
+
+    qDebug("IQHistory::allocate: %llu samples (%llu MB)", m_capacity, (m_capacity * sizeof(Sample)) / (1024*1024));
+    return true;
+}
+
+void IQHistory::release()
+{
+    if (!m_buffer) {
+        return;
+    }
+
+#ifdef Q_OS_LINUX
+    munmap(m_buffer, m_mappedBytes);
+    m_mappedBytes = 0;
+#else
+    delete[] m_buffer;
+#endif
+    m_buffer = nullptr;
+    m_capacity = 0;
+}
+
+qint64 IQHistory::nowUs()
+{
+    MainCore *mainCore = MainCore::instance();
+    return mainCore->getStartMsecsSinceEpoch()*1000 + mainCore->getElapsedNsecs()/1000;
+}
+
+void IQHistory::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+    (void) positiveOnly;
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_buffer || (m_sampleRate == 0) || (begin >= end)) {
+        return;
+    }
+
+    quint64 count = end - begin;
+    qint64 startUs = m_timestamp.isValid() ? m_timestamp.getTimeNs() / 1000 : nowUs() - (count * 1000000LL) / m_sampleRate;
+    m_timestamp = SampleTimestamp();
+
+    if (!m_newSegment)
+    {
+        const Segment& segment = m_segments.last();
+        qint64 expectedUs = segment.m_startUs + ((m_writeIndex - segment.m_startIndex) * 1000000LL) / segment.m_sampleRate;
+
+        if (std::abs(startUs - expectedUs) > m_maxTimeErrorUs) {
+            m_newSegment = true;
+        }
+    }
+
+    if (m_newSegment)
+    {
+        m_segments.append(Segment{m_writeIndex, startUs, m_sampleRate, m_centerFrequency});
+        m_newSegment = false;
+    }
+
+    // Only the last samples are kept if the block is larger than the ring
+    SampleVector::const_iterator from = count > m_capacity ? end - m_capacity : begin;
+    quint64 index = m_writeIndex + (from - begin);
+    quint64 position = index % m_capacity;
+    quint64 remaining = end - from;
+    quint64 part1 = std::min(remaining, m_capacity - position);
+    std::copy(from, from + part1, m_buffer + position);
+    std::copy(from + part1, end, m_buffer);
+    m_writeIndex += count;
+
+    // Remove segments whose samples have all been overwritten
+    quint64 oldest = oldestIndex();
+
+    while ((m_segments.size() > 1) && (m_segments[1].m_startIndex <= oldest)) {
+        m_segments.removeFirst();
+    }
+}
+
+void IQHistory::pushMessage(Message *msg)
+{
+    if (DSPSignalNotification::match(*msg))
+    {
+        DSPSignalNotification *notif = (DSPSignalNotification*) msg;
+        QMutexLocker mutexLocker(&m_mutex);
+        m_sampleRate = notif->getSampleRate();
+        m_centerFrequency = notif->getCenterFrequency();
+        m_newSegment = true;
+    }
+    else if (MsgCapture::match(*msg))
+    {
+        MsgCapture *cmd = (MsgCapture*) msg;
+        QString fileName = cmd->getFileName();
+        QString errorMessage;
+
+        if (!capture(cmd->getStartTime(), cmd->getEndTime(), fileName, errorMessage)) {
+            qWarning("IQHistory::pushMessage: MsgCapture: %s", qPrintable(errorMessage));
+        }
+    }
+
+    delete msg;
+}
+
+// Called with m_mutex locked
+qint64 IQHistory::indexToUs(quint64 index) const
+{
+    int i = m_segments.size() - 1;
+
+    while ((i > 0) && (m_segments[i].m_startIndex > index)) {
+        i--;
+    }
+
+    const Segment& segment = m_segments[i];
+    return segment.m_startUs + ((qint64) (index - segment.m_startIndex) * 1000000LL) / segment.m_sampleRate;
+}
+
+// Called with m_mutex locked
+quint64 IQHistory::usToIndex(qint64 us) const
+{
+    int i = m_segments.size() - 1;
+
+    while ((i > 0) && (m_segments[i].m_startUs > us)) {
+        i--;
+    }
+
+    const Segment& segment = m_segments[i];
+
+    if (us <= segment.m_startUs) {
+        return segment.m_startIndex;
+    }
+
+    quint64 index = segment.m_startIndex + ((us - segment.m_startUs) * segment.m_sampleRate) / 1000000LL;
+    quint64 nextIndex = i < m_segments.size() - 1 ? m_segments[i+1].m_startIndex : m_writeIndex;
+
+    return std::min(index, nextIndex);
+}
+
+bool IQHistory::getSpan(qint64& startTime, qint64& endTime)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_segments.isEmpty() || (m_writeIndex == 0)) {
+        return false;
+    }
+
+    startTime = indexToUs(oldestIndex()) / 1000;
+    endTime = indexToUs(m_writeIndex) / 1000;
+    return true;
+}
+
+bool IQHistory::capture(qint64 startTime, qint64 endTime, QString& fileName, QString& errorMessage)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    deleteFinishedWriters();
+
+    if (!m_buffer || m_segments.isEmpty() || (m_writeIndex == 0))
+    {
+        errorMessage = "No samples buffered";
+        return false;
+    }
+
+    quint64 startIndex = std::max(usToIndex(startTime*1000), oldestIndex());
+    quint64 endIndex = std::min(usToIndex(endTime*1000), m_writeIndex);
+
+    if (endIndex <= startIndex)
+    {
+        errorMessage = QString("Requested window is not buffered. Buffered from %1 to %2")
+            .arg(QDateTime::fromMSecsSinceEpoch(indexToUs(oldestIndex())/1000, Qt::UTC).toString(Qt::ISODateWithMs))
+            .arg(QDateTime::fromMSecsSinceEpoch(indexToUs(m_writeIndex)/1000, Qt::UTC).toString(Qt::ISODateWithMs));
+        return false;
+    }
+
+    QList<Writer::Part> parts;
+
+    for (int i = 0; i < m_segments.size(); i++)
+    {
+        quint64 segmentEnd = i < m_segments.size() - 1 ? m_segments[i+1].m_startIndex : m_writeIndex;
+        quint64 partStart = std::max(m_segments[i].m_startIndex, startIndex);
+        quint64 partEnd = std::min(segmentEnd, endIndex);
+
+        if (partEnd > partStart) {
+            parts.append(Writer::Part{partStart, partEnd, indexToUs(partStart), m_segments[i].m_sampleRate, m_segments[i].m_centerFrequency});
+        }
+    }
+
+    if (fileName.isEmpty())
+    {
+        fileName = QString("hist%1.%2").arg(m_deviceUID)
+            .arg(QDateTime::fromMSecsSinceEpoch(parts.first().m_startUs/1000, Qt::UTC).toString("yyyy-MM-ddTHH_mm_ss_zzz"));
+    }
+
+    qDebug("IQHistory::capture: %s: %llu samples in %d parts", qPrintable(fileName), endIndex - startIndex, parts.size());
+    Writer *writer = new Writer(this, fileName, parts);
+    m_writers.append(writer);
+    writer->start(QThread::LowPriority);
+
+    return true;
+}
+
+// Copies in slices so that feed() is never held up for more than the copy of one slice
+bool IQHistory::read(quint64 index, quint64 count, Sample *samples)
+{
+    while (count > 0)
+    {
+        quint64 slice = count > m_readSliceSize ? m_readSliceSize : count;
+        QMutexLocker mutexLocker(&m_mutex);
+
+        if (m_abort || (index < oldestIndex()) || (index + slice > m_writeIndex)) {
+            return false;
+        }
+
+        quint64 position = index % m_capacity;
+        quint64 part1 = std::min(slice, m_capacity - position);
+        std::copy(m_buffer + position, m_buffer + position + part1, samples);
+        std::copy(m_buffer, m_buffer + (slice - part1), samples + part1);
+
+        index += slice;
+        samples += slice;
+        count -= slice;
+    }
+
+    return true;
+}
+
+int IQHistory::getNbActiveCaptures()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    deleteFinishedWriters();
+    return m_writers.size();
+}
+
+// Called with m_mutex locked
+void IQHistory::deleteFinishedWriters()
+{
+    for (int i = m_writers.size() - 1; i >= 0; i--)
+    {
+        if (m_writers[i]->isFinished()) {
+            delete m_writers.takeAt(i);
+        }
+    }
+}
@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_IQHISTORY_H
+#define INCLUDE_IQHISTORY_H
+
+#include <QObject>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include "dsp/basebandsamplesink.h"
+#include "util/message.h"
+#include "export.h"
+
+// Ring buffer of the baseband samples of a device set with their time stamps.
+// It is fed by the device source engine like any baseband sink and keeps the last samples that fit
+// in a memory budget. A past time window can then be written to a SigMF file by a background thread
+// while acquisition continues. The window is written oldest first in chunks copied out of the ring
+// so that no copy of the whole window is made. If the writer falls behind and part of the window
+// gets overwritten the file is truncated.
+// Samples are timed by segments: a segment starts when sample rate or center frequency change or
+// when the time implied by the sample count drifts from the wall clock (samples lost or device clock
+// drift) and each segment is a SigMF capture. Time is the device sample timestamp when available
+// else the time samples reach the engine.
+class SDRBASE_API IQHistory : public QObject, public BasebandSampleSink
+{
+    Q_OBJECT
+
+public:
+    // Write a past window to a SigMF file. Can be pushed to the history from any thread.
+    class SDRBASE_API MsgCapture : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        qint64 getStartTime() const { return m_startTime; }
+        qint64 getEndTime() const { return m_endTime; }
+        const QString& getFileName() const { return m_fileName; }
+
+        static MsgCapture* create(qint64 startTime, qint64 endTime, const QString& fileName) {
+            return new MsgCapture(startTime, endTime, fileName);
+        }
+
+    private:
+        qint64 m_startTime;     //!< ms since epoch
+        qint64 m_endTime;       //!< ms since epoch
+        QString m_fileName;     //!< Without .sigmf-data/.sigmf-meta extension. Empty for a generated name.
+
+        MsgCapture(qint64 startTime, qint64 endTime, const QString& fileName) :
+            Message(),
+            m_startTime(startTime),
+            m_endTime(endTime),
+            m_fileName(fileName)
+        { }
+    };
+
+    IQHistory(const QString& hardwareId, unsigned int deviceUID);
+    virtual ~IQHistory();
+
+    bool setMemoryBudget(quint64 bytes); //!< Allocates the ring and discards buffered samples. Returns false if allocation failed.
+    quint64 getMemoryBudget() const { return m_capacity * sizeof(Sample); }
+    bool getSpan(qint64& startTime, qint64& endTime); //!< Times in ms since epoch of the oldest and newest buffered samples. False if empty.
+    // Starts writing samples between the given times in ms since epoch. File name is updated if generated.
+    bool capture(qint64 startTime, qint64 endTime, QString& fileName, QString& errorMessage);
+    int getNbActiveCaptures();
+
+    virtual void start() {}
+    virtual void stop() {}
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
+    virtual void pushMessage(Message *msg);
+    virtual void setTimestamp(const SampleTimestamp& timestamp) { m_timestamp = timestamp; }
+    virtual QString getSinkName() { return objectName(); }
+
+    static const quint64 m_defaultMemoryBudget = 256ULL*1024*1024;
+    static const qint64 m_maxTimeErrorUs = 100000; //!< Drift between sample count and wall clock that starts a new segment
+    static const quint64 m_readSliceSize = 1<<14;  //!< Samples copied out of the ring per lock by writers
+
+private:
+    struct Segment
+    {
+        quint64 m_startIndex;       //!< Index of first sample in samples fed since start
+        qint64 m_startUs;           //!< Time of first sample in µs since epoch
+        quint32 m_sampleRate;
+        quint64 m_centerFrequency;
+    };
+
+    class Writer;
+
+    QString m_hardwareId;
+    unsigned int m_deviceUID;
+    Sample *m_buffer;
+    quint64 m_capacity;             //!< Ring size in samples
+    quint64 m_mappedBytes;          //!< Non zero if the ring is memory mapped
+    quint64 m_writeIndex;           //!< Number of samples fed since start
+    QList<Segment> m_segments;      //!< Segments covering buffered samples, oldest first
+    quint32 m_sampleRate;
+    quint64 m_centerFrequency;
+    bool m_newSegment;
+    SampleTimestamp m_timestamp;    //!< Timestamp of next block fed
+    QList<Writer*> m_writers;
+    bool m_abort;                   //!< Tells writers to stop
+    QMutex m_mutex;
+
+    bool allocate(quint64 capacity);
+    void release();
+    quint64 oldestIndex() const { return m_writeIndex > m_capacity ? m_writeIndex - m_capacity : 0; }
+    qint64 indexToUs(quint64 index) const;
+    quint64 usToIndex(qint64 us) const;
+    bool read(quint64 index, quint64 count, Sample *samples); //!< False if samples were overwritten or capture aborted. Locks per slice.
+    void deleteFinishedWriters();
+    static qint64 nowUs();
+};
+
+#endif // INCLUDE_IQHISTORY_H
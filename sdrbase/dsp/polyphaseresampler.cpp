@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include <QDebug>
+
+#include "dsp/interpolator.h"
+#include "polyphaseresampler.h"
+
+PolyphaseResampler::PolyphaseResampler() :
+    m_phaseSteps(1),
+    m_nTaps(0),
+    m_nTapsPadded(0)
+{
+}
+
+PolyphaseResampler::~PolyphaseResampler()
+{
+}
+
+void PolyphaseResampler::create(int phaseSteps, double sampleRate, double cutoff, double nbTapsPerPhase)
+{
+    std::vector<Real> taps;
+
+    Interpolator::createPolyphaseLowPass(
+        taps,
+        phaseSteps, // number of polyphases
+        1.0, // gain
+        phaseSteps * sampleRate, // sampling frequency
+        cutoff, // hz beginning of transition band
+        nbTapsPerPhase);
+
+    m_phaseSteps = phaseSteps;
+    m_nTaps = taps.size() / phaseSteps;
+    m_nTapsPadded = ((m_nTaps + m_vectorSize - 1) / m_vectorSize) * m_vectorSize;
+    m_taps.assign(2 * m_nTapsPadded * phaseSteps, 0.0f);
+
+    for (int phase = 0; phase < phaseSteps; phase++)
+    {
+        // Reorder into polyphase and normalize as Interpolator does
+        Real sum = 0;
+
+        for (int i = 0; i < m_nTaps; i++) {
+            sum += taps[i * phaseSteps + phase];
+        }
+
+        // Interpolator tap i applies to the i-th newest sample so reverse the order
+        float *phaseTaps = &m_taps[2 * (phase * m_nTapsPadded + m_nTapsPadded - m_nTaps)];
+
+        for (int i = 0; i < m_nTaps; i++)
+        {
+            float tap = taps[(m_nTaps - 1 - i) * phaseSteps + phase] / sum;
+            phaseTaps[2*i] = tap;
+            phaseTaps[2*i + 1] = tap;
+        }
+    }
+
+    reset();
+    qDebug("PolyphaseResampler::create: phaseSteps: %d nTaps: %d padded: %d", m_phaseSteps, m_nTaps, m_nTapsPadded);
+}
+
+void PolyphaseResampler::reset()
+{
+    m_history.assign(m_nTapsPadded, Complex{0.0f, 0.0f});
+}
+
+unsigned int PolyphaseResampler::resample(Real distance, Real *distanceRemain, const Complex *in, unsigned int nbIn, std::vector<Complex>& out)
+{
+    if ((m_nTapsPadded == 0) || (distance <= 0.0f)) {
+        return 0;
+    }
+
+    // History is the last m_nTapsPadded input samples followed by the new block. The filter
+    // window ending at input sample i starts at m_history[i + 1].
+    unsigned int historySize = m_nTapsPadded;
+    m_history.resize(historySize + nbIn);
+    std::copy(in, in + nbIn, m_history.begin() + historySize);
+
+    unsigned int nbOut = 0;
+    Real remain = *distanceRemain;
+
+    if (distance >= 1.0f)
+    {
+        // Same sequence as Interpolator::decimate(): the new sample enters the filter
+        // then at most one output is produced
+        for (unsigned int i = 0; i < nbIn; i++)
+        {
+            remain -= 1.0f;
+
+            if (remain < 1.0f)
+            {
+                interpolate(&m_history[i + 1], remain, out);
+                nbOut++;
+                remain += distance;
+            }
+        }
+    }
+    else
+    {
+        // Same sequence as Interpolator::interpolate(): outputs are produced from the filter
+        // before the new sample enters it and until the new sample is consumed
+        for (unsigned int i = 0; i < nbIn; i++)
+        {
+            while (remain < 1.0f)
+            {
+                interpolate(&m_history[i], remain, out);
+                nbOut++;
+                remain += distance;
+            }
+
+            remain -= 1.0f;
+        }
+    }
+
+    *distanceRemain = remain;
+    std::copy(m_history.end() - historySize, m_history.end(), m_history.begin());
+    m_history.resize(historySize);
+
+    return nbOut;
+}
+
+void PolyphaseResampler::interpolate(const Complex *samples, Real remain, std::vector<Complex>& out) const
+{
+    int phase = (int) floor(remain * (Real) m_phaseSteps);
+    phase = phase < 0 ? 0 : phase >= m_phaseSteps ? m_phaseSteps - 1 : phase;
+    Complex result;
+    dotProduct(samples, &m_taps[2 * phase * m_nTapsPadded], &result);
+    out.push_back(result);
+}
+
+void PolyphaseResampler::dotProduct(const Complex *samples, const float *taps, Complex *result) const
+{
+    const float *src = (const float*) samples;
+#if defined(__AVX__)
+    __m256 sum = _mm256_setzero_ps();
+
+    for (int i = 0; i < m_nTapsPadded; i += 4, src += 8, taps += 8)
+    {
+#if defined(__FMA__)
+        sum = _mm256_fmadd_ps(_mm256_loadu_ps(src), _mm256_loadu_ps(taps), sum);
+#else
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(src), _mm256_loadu_ps(taps)));
+#endif
+    }
+
+    // Add upper to lower lane then upper half to lower half: I and Q remain in first two floats
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    float r[4];
+    _mm_storeu_ps(r, sum4);
+    *result = Complex(r[0], r[1]);
+#elif defined(USE_SSE2)
+    __m128 sum = _mm_setzero_ps();
+
+    for (int i = 0; i < m_nTapsPadded; i += 2, src += 4, taps += 4) {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src), _mm_loadu_ps(taps)));
+    }
+
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    float r[4];
+    _mm_storeu_ps(r, sum);
+    *result = Complex(r[0], r[1]);
+#else
+    float rAcc = 0.0f;
+    float iAcc = 0.0f;
+
+    for (int i = 0; i < m_nTapsPadded; i++)
+    {
+        rAcc += taps[2*i] * src[2*i];
+        iAcc += taps[2*i] * src[2*i + 1];
+    }
+
+    *result = Complex(rAcc, iAcc);
+#endif
+}
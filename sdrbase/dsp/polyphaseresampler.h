@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_POLYPHASERESAMPLER_H
+#define INCLUDE_POLYPHASERESAMPLER_H
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+// Block version of Interpolator decimate() and interpolate() for arbitrary ratio resampling.
+// Same polyphase low pass filter but the phase filters are stored in order of the samples in a
+// linear history buffer so each output is a single contiguous dot product (AVX, SSE2 or scalar)
+// and no ring buffer wrap has to be handled. Input samples are given a block at a time.
+// Output is the same as Interpolator decimate() or interpolate() called sample by sample.
+class SDRBASE_API PolyphaseResampler
+{
+public:
+    PolyphaseResampler();
+    ~PolyphaseResampler();
+
+    //!< Same parameters as Interpolator::create
+    void create(int phaseSteps, double sampleRate, double cutoff, double nbTapsPerPhase = 4.5);
+    void reset(); //!< Clear history
+
+    /**
+     * Resample a block of input samples. Output samples are appended to out.
+     * distance is the input to output sample rate ratio and distanceRemain the running
+     * fractional position, as with Interpolator where the caller adds distance after each output.
+     * Like for Interpolator::decimate() distanceRemain should be initialized to distance.
+     * Works for both decimation (distance >= 1) and interpolation (distance < 1).
+     * Returns the number of output samples produced.
+     */
+    unsigned int resample(Real distance, Real *distanceRemain, const Complex *in, unsigned int nbIn, std::vector<Complex>& out);
+
+private:
+    std::vector<float> m_taps;   //!< Phase filters each of m_nTapsPadded taps duplicated for I and Q, oldest sample first
+    std::vector<Complex> m_history; //!< Last m_nTapsPadded input samples followed by the current block
+    int m_phaseSteps;
+    int m_nTaps;                 //!< Taps per phase
+    int m_nTapsPadded;           //!< Taps per phase rounded up to vector size with leading zero taps
+
+    static const int m_vectorSize = 4; //!< Complex samples processed per vector step (AVX)
+
+    void interpolate(const Complex *samples, Real remain, std::vector<Complex>& out) const; //!< Output at fractional position remain of filter window
+    void dotProduct(const Complex *samples, const float *taps, Complex *result) const;
+};
+
+#endif // INCLUDE_POLYPHASERESAMPLER_H
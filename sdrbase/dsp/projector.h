@@ -53,9 +53,12 @@ public:
 
     Real run(const Sample& s);
     Real run(const std::complex<float>& s);
+    void run(const std::complex<float> *s, unsigned int nbSamples, Real *out); //!< Project a block of samples (cache is not used)
+    void resync(const std::complex<float>& s); //!< Set state (previous phase) as if run stopped at this sample
 
 private:
     static Real normalizeAngle(Real angle);
+    Real project(const std::complex<float>& s);
     ProjectionType m_projectionType;
     Real m_prevArg;
     Real *m_cache;
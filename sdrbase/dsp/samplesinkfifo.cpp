@@ -21,23 +21,38 @@
 
 //#define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
+std::atomic<bool> SampleSinkFifo::m_backpressure(false);
+std::atomic<qint64> SampleSinkFifo::m_totalFill(0);
+std::atomic<qint64> SampleSinkFifo::m_backpressureDropped(0);
+
 void SampleSinkFifo::create(unsigned int s)
 {
+	m_totalFill -= m_fill;
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
 
 	m_data.resize(s);
 	m_size = m_data.size();
+	resetTimestamps();
+}
+
+void SampleSinkFifo::resetTimestamps()
+{
+	m_writeCount = 0;
+	m_readCount = 0;
+	m_timestampMarks.clear();
 }
 
 void SampleSinkFifo::reset()
 {
 	QMutexLocker mutexLocker(&m_mutex);
 	m_suppressed = -1;
+	m_totalFill -= m_fill;
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
+	resetTimestamps();
 }
 
 SampleSinkFifo::SampleSinkFifo(QObject* parent) :
@@ -46,7 +61,11 @@ SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 	m_total(0),
 	m_writtenSignalCount(0),
 	m_writtenSignalRateDivider(1),
-	m_mutex(QMutex::Recursive)
+	m_mutex(QMutex::Recursive),
+	m_writeCount(0),
+	m_readCount(0),
+	m_lastWriteNs(0),
+	m_writersWaiting(0)
 {
 	m_suppressed = -1;
 	m_size = 0;
@@ -61,9 +80,14 @@ SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 	m_total(0),
 	m_writtenSignalCount(0),
 	m_writtenSignalRateDivider(1),
-	m_mutex(QMutex::Recursive)
+	m_mutex(QMutex::Recursive),
+	m_writeCount(0),
+	m_readCount(0),
+	m_lastWriteNs(0),
+	m_writersWaiting(0)
 {
 	m_suppressed = -1;
+	m_fill = 0;
 	create(size);
 }
 
@@ -73,7 +97,11 @@ SampleSinkFifo::SampleSinkFifo(const SampleSinkFifo& other) :
 	m_total(0),
 	m_writtenSignalCount(0),
 	m_writtenSignalRateDivider(1),
-	m_mutex(QMutex::Recursive)
+	m_mutex(QMutex::Recursive),
+	m_writeCount(0),
+	m_readCount(0),
+	m_lastWriteNs(0),
+	m_writersWaiting(0)
 {
   	m_suppressed = -1;
 	m_size = m_data.size();
@@ -85,9 +113,22 @@ SampleSinkFifo::SampleSinkFifo(const SampleSinkFifo& other) :
 SampleSinkFifo::~SampleSinkFifo()
 {
 	QMutexLocker mutexLocker(&m_mutex);
+	m_totalFill -= m_fill;
+	m_fill = 0;
 	m_size = 0;
 }
 
+void SampleSinkFifo::setBackpressure(bool backpressure)
+{
+	qDebug("SampleSinkFifo::setBackpressure: %s", backpressure ? "on" : "off");
+
+	if (backpressure) {
+		m_backpressureDropped.store(0);
+	}
+
+	m_backpressure.store(backpressure);
+}
+
 bool SampleSinkFifo::setSize(int size)
 {
 	QMutexLocker mutexLocker(&m_mutex);
@@ -102,6 +143,11 @@ void SampleSinkFifo::setWrittenSignalRateDivider(unsigned int divider)
 }
 
 unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count)
+{
+	return write(data, count, SampleTimestamp());
+}
+
+unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count, const SampleTimestamp& timestamp)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
@@ -114,11 +160,17 @@ unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count)
 	unsigned int len;
 	const Sample* begin = (const Sample*)data;
 	count /= sizeof(Sample);
+	markTimestamp(timestamp);
 
-	total = std::min(count, m_size - m_fill);
+	bool backpressure = getBackpressure();
+	total = std::min(count, backpressure ? waitForSpace(mutexLocker, count) : m_size - m_fill);
 
     if (total < count)
     {
+		if (backpressure) {
+			m_backpressureDropped += count - total;
+		}
+
 		if (m_suppressed < 0)
         {
 			m_suppressed = 0;
@@ -157,6 +209,13 @@ unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count)
 		remaining -= len;
 	}
 
+	m_writeCount += total;
+	m_totalFill += total;
+
+	if (total > 0) {
+		m_lastWriteNs = MainCore::instance()->getStartMsecsSinceEpoch()*1000000LL + MainCore::instance()->getElapsedNsecs();
+	}
+
 	if (m_fill > 0) {
 		emit dataReady();
     }
@@ -174,6 +233,11 @@ unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count)
 }
 
 unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+	return write(begin, end, SampleTimestamp());
+}
+
+unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end, const SampleTimestamp& timestamp)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
@@ -181,15 +245,22 @@ unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVec
 		return 0;
 	}
 
+	markTimestamp(timestamp);
+
 	unsigned int count = end - begin;
 	unsigned int total;
 	unsigned int remaining;
 	unsigned int len;
 
-	total = std::min(count, m_size - m_fill);
+	bool backpressure = getBackpressure();
+	total = std::min(count, backpressure ? waitForSpace(mutexLocker, count) : m_size - m_fill);
 
     if (total < count)
     {
+		if (backpressure) {
+			m_backpressureDropped += count - total;
+		}
+
 		if (m_suppressed < 0)
         {
 			m_suppressed = 0;
@@ -228,6 +299,13 @@ unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVec
 		remaining -= len;
 	}
 
+	m_writeCount += total;
+	m_totalFill += total;
+
+	if (total > 0) {
+		m_lastWriteNs = MainCore::instance()->getStartMsecsSinceEpoch()*1000000LL + MainCore::instance()->getElapsedNsecs();
+	}
+
 	if (m_fill > 0) {
 		emit dataReady();
     }
@@ -279,6 +357,8 @@ unsigned int SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::it
 		remaining -= len;
 	}
 
+	consumed(total);
+
 	return total;
 }
 
@@ -354,10 +434,136 @@ unsigned int SampleSinkFifo::readCommit(unsigned int count)
 
     m_head = (m_head + count) % m_size;
 	m_fill -= count;
+	consumed(count);
 
 	return count;
 }
 
+// Called with m_mutex locked
+void SampleSinkFifo::markTimestamp(const SampleTimestamp& timestamp)
+{
+	if (m_timestampMarks.isEmpty())
+	{
+		if (timestamp.isValid()) {
+			m_timestampMarks.append(TimestampMark{m_writeCount, timestamp});
+		}
+
+		return;
+	}
+
+	const TimestampMark& last = m_timestampMarks.last();
+	bool contiguous;
+
+	if (timestamp.isValid()) {
+		contiguous = last.m_timestamp.sameAnchor(timestamp)
+			&& (last.m_timestamp.m_index + (m_writeCount - last.m_writeCount) == timestamp.m_index);
+	} else {
+		contiguous = !last.m_timestamp.isValid();
+	}
+
+	if (contiguous) {
+		return;
+	}
+
+	if (last.m_writeCount == m_writeCount) { // nothing written since (e.g. FIFO full) so that marks do not pile up
+		m_timestampMarks.last().m_timestamp = timestamp;
+	} else {
+		m_timestampMarks.append(TimestampMark{m_writeCount, timestamp});
+	}
+}
+
+// Called with m_mutex locked
+void SampleSinkFifo::consumed(unsigned int count)
+{
+	m_readCount += count;
+	m_totalFill -= count;
+
+	if ((m_writersWaiting > 0) && (count > 0))
+	{
+		QMutexLocker spaceLocker(&m_spaceMutex);
+		m_spaceAvailable.wakeAll();
+	}
+
+	while ((m_timestampMarks.size() > 1) && (m_timestampMarks[1].m_writeCount <= m_readCount)) {
+		m_timestampMarks.removeFirst();
+	}
+}
+
+SampleTimestamp SampleSinkFifo::getReadTimestamp(unsigned int& count)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (m_timestampMarks.isEmpty()) {
+		return SampleTimestamp();
+	}
+
+	if (m_timestampMarks.first().m_writeCount > m_readCount) // samples written without timestamp before the first mark
+	{
+		count = std::min(count, (unsigned int) (m_timestampMarks.first().m_writeCount - m_readCount));
+		return SampleTimestamp();
+	}
+
+	if (m_timestampMarks.size() > 1) {
+		count = std::min(count, (unsigned int) (m_timestampMarks[1].m_writeCount - m_readCount));
+	}
+
+	const TimestampMark& mark = m_timestampMarks.first();
+
+	if (!mark.m_timestamp.isValid()) {
+		return SampleTimestamp();
+	}
+
+	return mark.m_timestamp.advanced(m_readCount - mark.m_writeCount);
+}
+
+qint64 SampleSinkFifo::getHeadTimeNs(unsigned int sampleRate)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if ((m_lastWriteNs == 0) || (sampleRate == 0)) {
+		return 0;
+	}
+
+	return m_lastWriteNs - SampleTimestamp::samplesToNs(m_fill, sampleRate);
+}
+
+// Called with m_mutex locked by mutexLocker. Waits until count samples (at most the FIFO size) fit in the FIFO
+// and returns the free space. m_mutex is released while waiting so that the reader can proceed. The reader is
+// signaled again at each wait in case it returned before the FIFO was empty (e.g. to process messages).
+// Gives up if backpressure is turned off or if the reader does not read anything for m_maxStallMs.
+unsigned int SampleSinkFifo::waitForSpace(QMutexLocker& mutexLocker, unsigned int count)
+{
+	count = std::min(count, m_size);
+	quint64 readCount = m_readCount;
+	QElapsedTimer stallTimer;
+	stallTimer.start();
+
+	while (getBackpressure() && (m_size - m_fill < count))
+	{
+		if (m_readCount != readCount)
+		{
+			readCount = m_readCount;
+			stallTimer.restart();
+		}
+		else if (stallTimer.elapsed() > m_maxStallMs)
+		{
+			qWarning("SampleSinkFifo::waitForSpace: (%s) reader stalled - stop waiting", qPrintable(m_label));
+			break;
+		}
+
+		emit dataReady();
+		m_writersWaiting++;
+		m_spaceMutex.lock(); // before m_mutex is released so that a read cannot wake before we wait
+		mutexLocker.unlock();
+		m_spaceAvailable.wait(&m_spaceMutex, 100);
+		m_spaceMutex.unlock();
+		mutexLocker.relock();
+		m_writersWaiting--;
+	}
+
+	return m_size - m_fill;
+}
+
 unsigned int SampleSinkFifo::getSizePolicy(unsigned int sampleRate)
 {
     return (sampleRate/100)*64; // .64s
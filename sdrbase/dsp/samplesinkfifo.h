@@ -21,8 +21,12 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QElapsedTimer>
+#include <QList>
+#include <atomic>
 #include "dsp/dsptypes.h"
+#include "dsp/sampletimestamp.h"
 #include "export.h"
 
 class SDRBASE_API SampleSinkFifo : public QObject {
@@ -43,7 +47,33 @@ private:
 	unsigned int m_tail;
 	QString m_label;
 
+	// Timestamp of the sample at a given write count. A mark is added only when the written
+	// samples are not contiguous with the previous mark (gap, overflow, new anchor).
+	struct TimestampMark
+	{
+		quint64 m_writeCount;
+		SampleTimestamp m_timestamp;
+	};
+
+	quint64 m_writeCount;              //!< Samples written since reset
+	quint64 m_readCount;               //!< Samples read since reset
+	QList<TimestampMark> m_timestampMarks;
+	qint64 m_lastWriteNs;              //!< Wall clock time in ns since epoch of the last write
+
+	// Backpressure: writers wait for the reader instead of dropping samples
+	QMutex m_spaceMutex;               //!< Not recursive as required by QWaitCondition
+	QWaitCondition m_spaceAvailable;
+	int m_writersWaiting;              //!< Writers waiting for space. Protected by m_mutex
+	static std::atomic<bool> m_backpressure;
+	static std::atomic<qint64> m_totalFill; //!< Samples in all FIFOs
+	static std::atomic<qint64> m_backpressureDropped; //!< Samples dropped by all FIFOs with backpressure on (stalled reader)
+	static const qint64 m_maxStallMs = 5000; //!< Writer stops waiting if the reader does not read for this long
+
 	void create(unsigned int s);
+	void resetTimestamps();
+	void markTimestamp(const SampleTimestamp& timestamp);
+	void consumed(unsigned int count);
+	unsigned int waitForSpace(QMutexLocker& mutexLocker, unsigned int count);
 
 public:
 	SampleSinkFifo(QObject* parent = nullptr);
@@ -58,7 +88,9 @@ public:
 	inline unsigned int fill() { QMutexLocker mutexLocker(&m_mutex); unsigned int fill = m_fill; return fill; }
 
 	unsigned int write(const quint8* data, unsigned int count);
+	unsigned int write(const quint8* data, unsigned int count, const SampleTimestamp& timestamp); //!< Count in bytes. Timestamp of the first sample.
 	unsigned int write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+	unsigned int write(SampleVector::const_iterator begin, SampleVector::const_iterator end, const SampleTimestamp& timestamp);
 
 	unsigned int read(SampleVector::iterator begin, SampleVector::iterator end);
 
@@ -66,8 +98,18 @@ public:
 		SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
 		SampleVector::iterator* part2Begin, SampleVector::iterator* part2End);
 	unsigned int readCommit(unsigned int count);
+	SampleTimestamp getReadTimestamp(unsigned int& count); //!< Timestamp of the next sample to be read (invalid if written without). Count is limited to the samples that follow it contiguously.
+	qint64 getHeadTimeNs(unsigned int sampleRate); //!< Wall clock time of the next sample to be read estimated from the time of the last write and the fill
+	qint64 getLastWriteNs() { QMutexLocker mutexLocker(&m_mutex); return m_lastWriteNs; } //!< 0 if nothing was written yet
 	void setLabel(const QString& label) { m_label = label; }
     static unsigned int getSizePolicy(unsigned int sampleRate);
+	// Process wide backpressure mode used for offline processing. Writers block while the FIFO is full
+	// instead of dropping samples so that sources able to run faster than real time (file inputs) are paced
+	// by the slowest consumer of the DSP chain.
+	static void setBackpressure(bool backpressure);
+	static bool getBackpressure() { return m_backpressure.load(std::memory_order_relaxed); }
+	static qint64 getTotalFill() { return m_totalFill.load(); } //!< Samples written but not yet read in all FIFOs
+	static qint64 getBackpressureDropped() { return m_backpressureDropped.load(); } //!< Samples dropped in all FIFOs since backpressure was turned on
 
 signals:
 	void dataReady();
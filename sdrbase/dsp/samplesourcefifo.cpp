@@ -15,24 +15,64 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <QThread>
+
 #include "samplesourcefifo.h"
 
 const unsigned int SampleSourceFifo::m_rwDivisor = 2;
 const unsigned int SampleSourceFifo::m_guardDivisor = 10;
 
 SampleSourceFifo::SampleSourceFifo(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_size(0),
+    m_lowGuard(0),
+    m_highGuard(0),
+    m_midPoint(0),
+    m_readHead(0),
+    m_writeHead(0),
+    m_readCount(0),
+    m_busy(0),
+    m_stopped(false)
 {}
 
 SampleSourceFifo::SampleSourceFifo(unsigned int size, QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_readHead(0),
+    m_writeHead(0),
+    m_readCount(0),
+    m_busy(0),
+    m_stopped(false)
 {
     resize(size);
 }
 
+// Sequentially consistent so that a side either sees m_stopped or is seen in m_busy
+bool SampleSourceFifo::enter()
+{
+    m_busy.fetch_add(1);
+
+    if (m_stopped.load())
+    {
+        leave();
+        return false;
+    }
+
+    return true;
+}
+
+void SampleSourceFifo::stopSides()
+{
+    m_stopped.store(true);
+
+    while (m_busy.load() != 0) {
+        QThread::yieldCurrentThread();
+    }
+}
+
 void SampleSourceFifo::resize(unsigned int size)
 {
     QMutexLocker mutexLocker(&m_mutex);
+    stopSides();
     m_size = size;
     m_lowGuard = m_size / m_guardDivisor;
     m_highGuard = m_size - (m_size/m_guardDivisor);
@@ -41,14 +81,17 @@ void SampleSourceFifo::resize(unsigned int size)
     m_readHead = 0;
     m_writeHead = m_midPoint;
     m_data.resize(size);
+    m_stopped.store(false);
 }
 
 void SampleSourceFifo::reset()
 {
     QMutexLocker mutexLocker(&m_mutex);
+    stopSides();
 	m_readCount = 0;
     m_readHead = 0;
     m_writeHead = m_midPoint;
+    m_stopped.store(false);
 }
 
 SampleSourceFifo::~SampleSourceFifo()
@@ -60,28 +103,43 @@ void SampleSourceFifo::read(
     unsigned int& ipart2Begin, unsigned int& ipart2End  // second part offsets
 )
 {
-    QMutexLocker mutexLocker(&m_mutex);
-    unsigned int spaceLeft = m_size - m_readHead;
-    m_readCount = m_readCount + amount < m_size ? m_readCount + amount : m_size; // cannot exceed FIFO size
+    if (!enter())
+    {
+        ipart1Begin = ipart1End = ipart2Begin = ipart2End = 0;
+        return;
+    }
+
+    unsigned int readHead = m_readHead.load(std::memory_order_relaxed);
+    unsigned int spaceLeft = m_size - readHead;
 
     if (amount <= spaceLeft)
     {
-        ipart1Begin = m_readHead;
-        ipart1End = m_readHead + amount;
+        ipart1Begin = readHead;
+        ipart1End = readHead + amount;
         ipart2Begin = m_size;
         ipart2End = m_size;
-        m_readHead += amount;
+        readHead += amount;
     }
     else
     {
         unsigned int remaining = (amount < m_size ? amount : m_size) - spaceLeft;
-        ipart1Begin = m_readHead;
+        ipart1Begin = readHead;
         ipart1End = m_size;
         ipart2Begin = 0;
         ipart2End = remaining;
-        m_readHead = remaining;
+        readHead = remaining;
     }
 
+    m_readHead.store(readHead, std::memory_order_release);
+    unsigned int readCount = m_readCount.load(std::memory_order_relaxed);
+
+    while (!m_readCount.compare_exchange_weak(
+        readCount,
+        readCount + amount < m_size ? readCount + amount : m_size, // cannot exceed FIFO size
+        std::memory_order_acq_rel,
+        std::memory_order_relaxed)) {}
+
+    leave();
     emit dataRead();
 }
 
@@ -91,41 +149,57 @@ void SampleSourceFifo::write(
     unsigned int& ipart2Begin, unsigned int& ipart2End  // second part offsets
 )
 {
-    QMutexLocker mutexLocker(&m_mutex);
-    unsigned int rwDelta = m_writeHead >= m_readHead ? m_writeHead - m_readHead : m_size - (m_readHead - m_writeHead);
+    if (!enter())
+    {
+        ipart1Begin = ipart1End = ipart2Begin = ipart2End = 0;
+        return;
+    }
+
+    unsigned int readHead = m_readHead.load(std::memory_order_acquire);
+    unsigned int writeHead = m_writeHead.load(std::memory_order_relaxed);
+    unsigned int rwDelta = writeHead >= readHead ? writeHead - readHead : m_size - (readHead - writeHead);
 
     if (rwDelta < m_lowGuard)
     {
         qWarning("SampleSourceFifo::write: underrun (write too slow) using %d old samples", m_midPoint - m_lowGuard);
-        m_writeHead = m_readHead + m_midPoint < m_size ? m_readHead + m_midPoint : m_readHead + m_midPoint - m_size;
+        writeHead = readHead + m_midPoint < m_size ? readHead + m_midPoint : readHead + m_midPoint - m_size;
     }
     else if (rwDelta > m_highGuard)
     {
         qWarning("SampleSourceFifo::write: overrrun (read too slow) dropping %d samples", m_highGuard - m_midPoint);
-        m_writeHead = m_readHead + m_midPoint < m_size ? m_readHead + m_midPoint : m_readHead + m_midPoint - m_size;
+        writeHead = readHead + m_midPoint < m_size ? readHead + m_midPoint : readHead + m_midPoint - m_size;
     }
 
-    unsigned int spaceLeft = m_size - m_writeHead;
+    unsigned int spaceLeft = m_size - writeHead;
 
     if (amount <= spaceLeft)
     {
-        ipart1Begin = m_writeHead;
-        ipart1End = m_writeHead + amount;
+        ipart1Begin = writeHead;
+        ipart1End = writeHead + amount;
         ipart2Begin = m_size;
         ipart2End = m_size;
-        m_writeHead += amount;
+        writeHead += amount;
     }
     else
     {
         unsigned int remaining = (amount < m_size ? amount : m_size) - spaceLeft;
-        ipart1Begin = m_writeHead;
+        ipart1Begin = writeHead;
         ipart1End = m_size;
         ipart2Begin = 0;
         ipart2End = remaining;
-        m_writeHead = remaining;
+        writeHead = remaining;
     }
 
-    m_readCount = amount < m_readCount ? m_readCount - amount : 0; // cannot be less than 0
+    m_writeHead.store(writeHead, std::memory_order_release);
+    unsigned int readCount = m_readCount.load(std::memory_order_relaxed);
+
+    while (!m_readCount.compare_exchange_weak(
+        readCount,
+        amount < readCount ? readCount - amount : 0, // cannot be less than 0
+        std::memory_order_acq_rel,
+        std::memory_order_relaxed)) {}
+
+    leave();
 }
 
 unsigned int SampleSourceFifo::getSizePolicy(unsigned int sampleRate)
@@ -20,9 +20,20 @@
 
 #include <QObject>
 #include <QMutex>
+#include <atomic>
 #include "dsp/dsptypes.h"
 #include "export.h"
 
+/**
+ * Single producer single consumer FIFO. The writer (baseband or DSP engine thread) and the reader
+ * (DSP engine or device thread) never block: each side only moves its own head and they exchange
+ * positions through atomics with acquire/release ordering. Samples are read and written in place
+ * in the returned index ranges which stay valid until the next call of the same side.
+ * Resize and reset stop both sides first: they wait until neither side is handing out a range and
+ * meanwhile read and write hand out empty ranges. The mutex only serializes resize and reset.
+ * The owner resizes with its own side stopped (e.g. under the baseband mutex or with the device
+ * thread stopped) so that no range of the other buffer is still in use.
+ */
 class SDRBASE_API SampleSourceFifo : public QObject {
 	Q_OBJECT
 public:
@@ -45,17 +56,18 @@ public:
     );
     unsigned int remainder()
     {
-        QMutexLocker mutexLocker(&m_mutex);
-        return m_readCount;
+        return m_readCount.load(std::memory_order_acquire);
     }
     /** returns ratio of off center over buffer size with sign: negative read lags and positive read leads */
     float getRWBalance() const
     {
         int delta;
-        if (m_writeHead > m_readHead) {
-            delta = (m_size/m_rwDivisor) - (m_writeHead - m_readHead);
+        unsigned int readHead = m_readHead.load(std::memory_order_relaxed);
+        unsigned int writeHead = m_writeHead.load(std::memory_order_relaxed);
+        if (writeHead > readHead) {
+            delta = (m_size/m_rwDivisor) - (writeHead - readHead);
         } else {
-            delta = (m_readHead - m_writeHead) - (m_size/m_rwDivisor);
+            delta = (readHead - writeHead) - (m_size/m_rwDivisor);
         }
         return delta / (float) m_size;
     }
@@ -74,10 +86,16 @@ private:
     unsigned int m_lowGuard;
     unsigned int m_highGuard;
     unsigned int m_midPoint;
-    unsigned int m_readHead;
-    unsigned int m_writeHead;
-    unsigned int m_readCount;
-    QMutex m_mutex;
+    std::atomic<unsigned int> m_readHead;  //!< Modified by reader only
+    std::atomic<unsigned int> m_writeHead; //!< Modified by writer only
+    std::atomic<unsigned int> m_readCount; //!< Incremented by reader and decremented by writer
+    std::atomic<int> m_busy;               //!< Sides handing out a range
+    std::atomic<bool> m_stopped;           //!< Resize or reset in progress
+    QMutex m_mutex;                        //!< Serializes resize and reset
+
+    bool enter();                          //!< False if stopped
+    void leave() { m_busy.fetch_sub(1, std::memory_order_release); }
+    void stopSides();
 };
 
 #endif // SDRBASE_DSP_SAMPLESOURCEFIFO_H_
\ No newline at end of file
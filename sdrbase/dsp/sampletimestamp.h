@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SAMPLETIMESTAMP_H
+#define INCLUDE_SAMPLETIMESTAMP_H
+
+#include <QtGlobal>
+#include <QDateTime>
+
+// Time of a sample on the device clock with a wall clock anchor.
+// The index counts device samples since acquisition start. The anchor is a sample of the same stream
+// whose wall clock time is known so the time of any sample is derived from the sample count
+// and the device sample rate without reading the system clock.
+// Time differences between samples with the same anchor are exact on the device clock.
+struct SampleTimestamp
+{
+    quint64 m_index;            //!< Index of sample in device samples since acquisition start
+    quint64 m_anchorIndex;      //!< Index of the anchor sample
+    qint64 m_anchorNs;          //!< Wall clock time of the anchor sample in ns since epoch
+    quint32 m_sampleRate;       //!< Device sample rate. Zero if timestamp is invalid
+
+    SampleTimestamp() :
+        m_index(0),
+        m_anchorIndex(0),
+        m_anchorNs(0),
+        m_sampleRate(0)
+    {}
+
+    SampleTimestamp(quint64 index, quint64 anchorIndex, qint64 anchorNs, quint32 sampleRate) :
+        m_index(index),
+        m_anchorIndex(anchorIndex),
+        m_anchorNs(anchorNs),
+        m_sampleRate(sampleRate)
+    {}
+
+    bool isValid() const { return m_sampleRate != 0; }
+
+    bool sameAnchor(const SampleTimestamp& other) const {
+        return (m_anchorIndex == other.m_anchorIndex) && (m_anchorNs == other.m_anchorNs) && (m_sampleRate == other.m_sampleRate);
+    }
+
+    // Timestamp of the device sample nbSamples after (or before if negative) this one
+    SampleTimestamp advanced(qint64 nbSamples) const {
+        return SampleTimestamp(m_index + nbSamples, m_anchorIndex, m_anchorNs, m_sampleRate);
+    }
+
+    // Device clock time since anchor in ns
+    qint64 getSinceAnchorNs() const {
+        return samplesToNs((qint64) (m_index - m_anchorIndex), m_sampleRate);
+    }
+
+    // Device clock time since acquisition start in ns, valid if the sample rate was not changed.
+    // Unlike wall clock time it is not affected by re-anchoring so it suits time of arrival measurements.
+    qint64 getDeviceTimeNs() const {
+        return samplesToNs((qint64) m_index, m_sampleRate);
+    }
+
+    // Wall clock time in ns since epoch
+    qint64 getTimeNs() const {
+        return m_anchorNs + getSinceAnchorNs();
+    }
+
+    // Wall clock time in ns since epoch of a sample of a stream derived from the device stream
+    // (e.g. channel samples) given the number of samples of that stream since this one and its rate
+    qint64 getTimeNs(double nbSamples, double sampleRate) const {
+        return getTimeNs() + (qint64) ((nbSamples * 1e9) / sampleRate);
+    }
+
+    QDateTime getDateTime() const {
+        return QDateTime::fromMSecsSinceEpoch(getTimeNs() / 1000000);
+    }
+
+    QDateTime getDateTime(double nbSamples, double sampleRate) const {
+        return QDateTime::fromMSecsSinceEpoch(getTimeNs(nbSamples, sampleRate) / 1000000);
+    }
+
+    // Split in whole seconds so that it does not overflow
+    static qint64 samplesToNs(qint64 nbSamples, quint32 sampleRate)
+    {
+        qint64 secs = nbSamples / sampleRate;
+        qint64 remainder = nbSamples % sampleRate;
+        return secs * 1000000000LL + (remainder * 1000000000LL) / sampleRate;
+    }
+};
+
+#endif // INCLUDE_SAMPLETIMESTAMP_H
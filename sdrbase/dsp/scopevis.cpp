@@ -19,6 +19,7 @@
 #include <QtGlobal>
 #include <QDebug>
 #include <QMutexLocker>
+#include <QElapsedTimer>
 
 #include "scopevis.h"
 #include "spectrumvis.h"
@@ -66,22 +67,21 @@ ScopeVis::ScopeVis() :
     m_mutex(QMutex::Recursive),
     m_triggerOneShot(false),
     m_triggerWaitForReset(false),
-    m_currentTraceMemoryIndex(0)
+    m_currentTraceMemoryIndex(0),
+    m_processingThread(false),
+    m_processingStop(false)
 {
     setObjectName("ScopeVis");
     m_traceDiscreteMemory.resize(GLScopeSettings::m_traceChunkDefaultSize); // arbitrary
     m_convertBuffers.resize(GLScopeSettings::m_traceChunkDefaultSize);
 
-    for (int i = 0; i < (int) Projector::nbProjectionTypes; i++) {
-        m_projectorCache[i] = 0.0;
-    }
-
     connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
 }
 
 ScopeVis::~ScopeVis()
 {
     disconnect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
+    setProcessingThread(false);
 
     for (std::vector<TriggerCondition*>::iterator it = m_triggerConditions.begin(); it != m_triggerConditions.end(); ++ it) {
         delete *it;
@@ -136,13 +136,27 @@ void ScopeVis::setPreTriggerDelay(uint32_t preTriggerDelay, bool emitSignal)
 
 void ScopeVis::setNbStreams(uint32_t nbStreams)
 {
-    QMutexLocker configLocker(&m_mutex);
+    // The processing thread is stopped outside of the configuration lock as it may be waiting for it.
+    // It is restarted with an input FIFO reallocated for the new number of streams.
+    bool restartProcessingThread = m_processingThread.load() && (m_nbStreams != nbStreams);
+
+    if (restartProcessingThread) {
+        setProcessingThread(false);
+    }
 
-    if (m_nbStreams != nbStreams)
     {
-        m_traceDiscreteMemory.setNbStreams(nbStreams);
-        m_convertBuffers.setNbStreams(nbStreams);
-        m_nbStreams = nbStreams;
+        QMutexLocker configLocker(&m_mutex);
+
+        if (m_nbStreams != nbStreams)
+        {
+            m_traceDiscreteMemory.setNbStreams(nbStreams);
+            m_convertBuffers.setNbStreams(nbStreams);
+            m_nbStreams = nbStreams;
+        }
+    }
+
+    if (restartProcessingThread) {
+        setProcessingThread(true);
     }
 }
 
@@ -453,14 +467,32 @@ void ScopeVis::feed(const std::vector<ComplexVector::const_iterator>& vbegin, in
         return;
     }
 
+    {
+        QMutexLocker feedLocker(&m_feedMutex); // the input FIFO is not re-allocated while being written
+
+        if (m_processingThread.load(std::memory_order_acquire) && (vbegin.size() == m_inputFifo.getNbStreams()))
+        {
+            if (m_inputFifo.write(vbegin, nbSamples)) { // samples are dropped and counted if processing thread cannot keep up
+                m_processingSemaphore.release();
+            }
+
+            return;
+        }
+    }
+
     if (!m_mutex.tryLock(0)) { // prevent conflicts with configuration process
         return;
     }
 
+    processFeed(vbegin, nbSamples);
+    m_mutex.unlock();
+}
+
+void ScopeVis::processFeed(const std::vector<ComplexVector::const_iterator>& vbegin, int nbSamples)
+{
     if (m_triggerWaitForReset)
     {
         m_triggerLocation = 0;
-        m_mutex.unlock();
         return;
     }
 
@@ -504,15 +536,87 @@ void ScopeVis::feed(const std::vector<ComplexVector::const_iterator>& vbegin, in
             m_triggerLocation = m_triggerLocation < 0 ? 0 : m_triggerLocation; // trim negative values
             m_triggerLocation = m_triggerLocation > remainder ? remainder : m_triggerLocation; // trim past begin values
 
-            for (auto begin : nvbegin) {
+            for (auto& begin : nvbegin) {
                 begin += m_traceSize;
             }
 
             remainder -= m_traceSize;
         }
     }
+}
 
-    m_mutex.unlock();
+
+void ScopeVis::setProcessingThread(bool processingThread)
+{
+    if (processingThread == m_processingThread.load()) {
+        return;
+    }
+
+    qDebug("ScopeVis::setProcessingThread: %s", processingThread ? "on" : "off");
+
+    if (processingThread)
+    {
+        QMutexLocker feedLocker(&m_feedMutex);
+        m_inputFifo.allocate(m_nbStreams, m_inputFifoSize); // also discards samples left by a previous run
+
+        m_processingStop = false;
+        m_processingWorker = std::thread(&ScopeVis::processingLoop, this);
+        m_processingThread.store(true, std::memory_order_release);
+    }
+    else
+    {
+        {
+            QMutexLocker feedLocker(&m_feedMutex); // returns once any feed writing to the input FIFO is done
+            m_processingThread.store(false, std::memory_order_release);
+        }
+
+        m_processingStop = true;
+        m_processingSemaphore.release();
+
+        if (m_processingWorker.joinable()) {
+            m_processingWorker.join();
+        }
+    }
+}
+
+void ScopeVis::processingLoop()
+{
+    std::vector<ComplexVector::const_iterator> vbegin;
+    QElapsedTimer reportTimer;
+    reportTimer.start();
+
+    while (!m_processingStop.load())
+    {
+        if (reportTimer.hasExpired(m_inputFifoReportMs))
+        {
+            unsigned int dropped = m_inputFifo.m_dropped.exchange(0, std::memory_order_relaxed);
+
+            if (dropped > 0) {
+                qWarning("ScopeVis::processingLoop: overflow - dropped %u samples", dropped);
+            }
+
+            reportTimer.restart();
+        }
+
+        if (!m_processingSemaphore.tryAcquire(1, 100)) {
+            continue;
+        }
+
+        unsigned int nbSamples;
+
+        while (!m_processingStop.load() && ((nbSamples = m_inputFifo.readBegin(vbegin)) > 0))
+        {
+            // here we can wait for configuration to complete as the DSP thread is not held
+            m_mutex.lock();
+
+            if (m_currentTraceMemoryIndex == 0) {
+                processFeed(vbegin, nbSamples);
+            }
+
+            m_mutex.unlock();
+            m_inputFifo.readCommit(nbSamples);
+        }
+    }
 }
 
 void ScopeVis::processMemoryTrace()
@@ -538,9 +642,8 @@ void ScopeVis::processMemoryTrace()
     }
 }
 
-void ScopeVis::processTrace(const std::vector<ComplexVector::const_iterator>& vcbegin, int length, int& triggerPointToEnd)
+void ScopeVis::processTrace(const std::vector<ComplexVector::const_iterator>& vbegin, int length, int& triggerPointToEnd)
 {
-    std::vector<ComplexVector::const_iterator> vbegin(vcbegin);
     int firstRemainder = length;
 
     // memory storage
@@ -575,23 +678,19 @@ void ScopeVis::processTrace(const std::vector<ComplexVector::const_iterator>& vc
             {
                 if (triggerCondition->m_triggerDelayCount > 0) // skip samples during delay period
                 {
-                    for (auto begin : vbegin) {
-                        begin += triggerCondition->m_triggerDelayCount;
-                    }
-                    processed += triggerCondition->m_triggerDelayCount;
-                    firstRemainder -= triggerCondition->m_triggerDelayCount;
-                    triggerCondition->m_triggerDelayCount = 0;
+                    int skipped = std::min((int) triggerCondition->m_triggerDelayCount, firstRemainder);
+                    processed += skipped;
+                    firstRemainder -= skipped;
+                    triggerCondition->m_triggerDelayCount -= skipped;
                     continue;
                 }
                 else // process trigger
                 {
                     if (nextTrigger()) // move to next trigger and keep going
                     {
+                        triggerCondition = m_triggerConditions[m_currentTriggerIndex];
                         m_triggerComparator.reset();
                         m_triggerState = TriggerUntriggered;
-                        for (auto begin : vbegin) {
-                            ++begin;
-                        }
                         ++processed;
                         --firstRemainder;
                         continue;
@@ -608,45 +707,46 @@ void ScopeVis::processTrace(const std::vector<ComplexVector::const_iterator>& vc
                 }
             }
 
+            // search the rest of the block for the current trigger condition
             uint32_t triggerStreamIndex = triggerCondition->m_triggerData.m_streamIndex;
-            const Complex& s = *vbegin[triggerStreamIndex];
+            int triggerIndex = m_triggerComparator.triggeredBlock(vbegin[triggerStreamIndex] + processed, firstRemainder, *triggerCondition);
 
-            if (m_triggerComparator.triggered(s, *triggerCondition)) // matched the current trigger
+            if (triggerIndex < 0) // not found in this block
             {
-                if (triggerCondition->m_triggerData.m_triggerDelay > 0)
-                {
-                    triggerCondition->m_triggerDelayCount = triggerCondition->m_triggerData.m_triggerDelay; // initialize delayed samples counter
-                    m_triggerState = TriggerDelay;
-                    for (auto begin : vbegin) {
-                        ++begin;
-                    }
-                    ++processed;
-                    --firstRemainder;
-                    continue;
-                }
-
-                if (nextTrigger()) // move to next trigger and keep going
-                {
-                    m_triggerComparator.reset();
-                    m_triggerState = TriggerUntriggered;
-                }
-                else // this was the last trigger then start trace
-                {
-                    m_traceStart = true; // start of trace processing
-                    m_nbSamples = m_traceSize + m_maxTraceDelay;
-                    m_triggerComparator.reset();
-                    m_triggerState = TriggerTriggered;
-                    triggerPointToEnd = firstRemainder;
-                    break;
-                }
+                processed += firstRemainder;
+                firstRemainder = 0;
+                break;
             }
 
-            for (auto begin : vbegin) {
-                ++begin;
+            processed += triggerIndex; // matched the current trigger at this sample
+            firstRemainder -= triggerIndex;
+
+            if (triggerCondition->m_triggerData.m_triggerDelay > 0)
+            {
+                triggerCondition->m_triggerDelayCount = triggerCondition->m_triggerData.m_triggerDelay; // initialize delayed samples counter
+                m_triggerState = TriggerDelay;
+                ++processed;
+                --firstRemainder;
+                continue;
             }
 
-            ++processed;
-            --firstRemainder;
+            if (nextTrigger()) // move to next trigger and keep going
+            {
+                triggerCondition = m_triggerConditions[m_currentTriggerIndex];
+                m_triggerComparator.reset();
+                m_triggerState = TriggerUntriggered;
+                ++processed;
+                --firstRemainder;
+            }
+            else // this was the last trigger then start trace
+            {
+                m_traceStart = true; // start of trace processing
+                m_nbSamples = m_traceSize + m_maxTraceDelay;
+                m_triggerComparator.reset();
+                m_triggerState = TriggerTriggered;
+                triggerPointToEnd = firstRemainder;
+                break;
+            }
         } // look for trigger
     } // untriggered or delayed
 
@@ -758,82 +858,67 @@ bool ScopeVis::nextTrigger()
     }
 }
 
-int ScopeVis::processTraces(const std::vector<ComplexVector::const_iterator>& vcbegin, int ilength, bool traceBack)
+int ScopeVis::processTraces(const std::vector<ComplexVector::const_iterator>& vbegin, int ilength, bool traceBack)
 {
-    std::vector<ComplexVector::const_iterator> vbegin(vcbegin);
     uint32_t shift = (m_timeOfsProMill / 1000.0) * m_traceSize;
     uint32_t length = m_traceSize / m_timeBase;
+    int nbSamples = m_nbSamples < ilength ? m_nbSamples : ilength; // number of samples processed in this call
     int remainder = ilength;
 
     if (m_spectrumVis) {
-        m_spectrumVis->feed(vcbegin[0], vcbegin[0] + ilength, false);
+        m_spectrumVis->feed(vbegin[0], vbegin[0] + ilength, false);
     }
 
-    while ((remainder > 0) && (m_nbSamples > 0))
+    if (nbSamples > 0)
     {
+        // traces are processed one after the other over the whole block
+        if (m_projections.size() < m_traces.size() * nbSamples) {
+            m_projections.resize(m_traces.size() * nbSamples);
+        }
+
+        m_projectionKeys.clear();
         std::vector<TraceControl*>::iterator itCtl = m_traces.m_tracesControl.begin();
         std::vector<GLScopeSettings::TraceData>::iterator itData = m_traces.m_tracesData.begin();
         std::vector<float *>::iterator itTrace = m_traces.m_traces[m_traces.currentBufferIndex()].begin();
 
-        for (unsigned int ti = 0; itCtl != m_traces.m_tracesControl.end(); ++itCtl, ++itData, ++itTrace, ti++)
+        for (; itCtl != m_traces.m_tracesControl.end(); ++itCtl, ++itData, ++itTrace)
         {
-            if (traceBack && ((remainder) > itData->m_traceDelay)) { // before start of trace
+            uint32_t& traceCount = (*itCtl)->m_traceCount[m_traces.currentBufferIndex()]; // reference for code clarity
+
+            if (traceCount >= m_traceSize) {
+                continue;
+            }
+
+            int start = traceBack ? std::max(0, ilength - itData->m_traceDelay) : 0; // skip before start of trace
+            int end = std::min(nbSamples, start + (int) (m_traceSize - traceCount));
+
+            if (start >= end) {
                 continue;
             }
 
             Projector::ProjectionType projectionType = itData->m_projectionType;
+            const Real *projected = projectBlock(*itCtl, itData->m_streamIndex, projectionType, vbegin[itData->m_streamIndex], nbSamples);
+            float *trace = *itTrace;
 
-            if ((*itCtl)->m_traceCount[m_traces.currentBufferIndex()] < m_traceSize)
+            if ((projectionType == Projector::ProjectionMagSq) || (projectionType == Projector::ProjectionMagDB))
             {
-                uint32_t& traceCount = (*itCtl)->m_traceCount[m_traces.currentBufferIndex()]; // reference for code clarity
-                float v;
-                uint32_t streamIndex = itData->m_streamIndex;
+                bool dB = projectionType == Projector::ProjectionMagDB;
 
-                if (projectionType == Projector::ProjectionMagLin)
+                for (int i = start; i < end; i++, traceCount++)
                 {
-                    v = ((*itCtl)->m_projector.run(*vbegin[streamIndex]) - itData->m_ofs)*itData->m_amp - 1.0f;
-                }
-                else if (projectionType == Projector::ProjectionMagSq)
-                {
-                    Real magsq = (*itCtl)->m_projector.run(*vbegin[streamIndex]);
-                    v = (magsq - itData->m_ofs)*itData->m_amp - 1.0f;
+                    Real magsq = projected[i];
+                    float v;
 
-                    if ((traceCount >= shift) && (traceCount < shift+length)) // power display overlay values construction
+                    if (dB)
                     {
-                        if (traceCount == shift)
-                        {
-                            (*itCtl)->m_maxPow = 0.0f;
-                            (*itCtl)->m_sumPow = 0.0f;
-                            (*itCtl)->m_nbPow = 1;
-                        }
-
-                        if (magsq > 0.0f)
-                        {
-                            if (magsq > (*itCtl)->m_maxPow)
-                            {
-                                (*itCtl)->m_maxPow = magsq;
-                            }
-
-                            (*itCtl)->m_sumPow += magsq;
-                            (*itCtl)->m_nbPow++;
-                        }
+                        float pdB = log10f(magsq) * 10.0f;
+                        float p = pdB - (100.0f * itData->m_ofs);
+                        v = ((p/50.0f) + 2.0f)*itData->m_amp - 1.0f;
                     }
-
-                    if ((m_nbSamples == 1) && ((*itCtl)->m_nbPow > 0)) // on last sample create power display overlay
+                    else
                     {
-                        double avgPow = (*itCtl)->m_sumPow / (*itCtl)->m_nbPow;
-                        itData->m_textOverlay = QString("%1  %2").arg((*itCtl)->m_maxPow, 0, 'e', 2).arg(avgPow, 0, 'e', 2);
-                        (*itCtl)->m_nbPow = 0;
+                        v = (magsq - itData->m_ofs)*itData->m_amp - 1.0f;
                     }
-                }
-                else if (projectionType == Projector::ProjectionMagDB)
-                {
-                    Real re = vbegin[streamIndex]->real();
-                    Real im = vbegin[streamIndex]->imag();
-                    double magsq = re*re + im*im;
-                    float pdB = log10f(magsq) * 10.0f;
-                    float p = pdB - (100.0f * itData->m_ofs);
-                    v = ((p/50.0f) + 2.0f)*itData->m_amp - 1.0f;
 
                     if ((traceCount >= shift) && (traceCount < shift+length)) // power display overlay values construction
                     {
@@ -856,39 +941,46 @@ int ScopeVis::processTraces(const std::vector<ComplexVector::const_iterator>& vc
                         }
                     }
 
-                    if ((m_nbSamples == 1) && ((*itCtl)->m_nbPow > 0)) // on last sample create power display overlay
+                    if ((m_nbSamples - i == 1) && ((*itCtl)->m_nbPow > 0)) // on last sample create power display overlay
                     {
-                        double avgPow = log10f((*itCtl)->m_sumPow / (*itCtl)->m_nbPow)*10.0;
-                        double peakPow = log10f((*itCtl)->m_maxPow)*10.0;
-                        double peakToAvgPow = peakPow - avgPow;
-                        itData->m_textOverlay = QString("%1  %2  %3").arg(peakPow, 0, 'f', 1).arg(avgPow, 0, 'f', 1).arg(peakToAvgPow, 4, 'f', 1, ' ');
+                        if (dB)
+                        {
+                            double avgPow = log10f((*itCtl)->m_sumPow / (*itCtl)->m_nbPow)*10.0;
+                            double peakPow = log10f((*itCtl)->m_maxPow)*10.0;
+                            double peakToAvgPow = peakPow - avgPow;
+                            itData->m_textOverlay = QString("%1  %2  %3").arg(peakPow, 0, 'f', 1).arg(avgPow, 0, 'f', 1).arg(peakToAvgPow, 4, 'f', 1, ' ');
+                        }
+                        else
+                        {
+                            double avgPow = (*itCtl)->m_sumPow / (*itCtl)->m_nbPow;
+                            itData->m_textOverlay = QString("%1  %2").arg((*itCtl)->m_maxPow, 0, 'e', 2).arg(avgPow, 0, 'e', 2);
+                        }
+
                         (*itCtl)->m_nbPow = 0;
                     }
-                }
-                else
-                {
-                    v = ((*itCtl)->m_projector.run(*vbegin[streamIndex]) - itData->m_ofs) * itData->m_amp;
-                }
 
-                if(v > 1.0f) {
-                    v = 1.0f;
-                } else if (v < -1.0f) {
-                    v = -1.0f;
+                    trace[2*traceCount] = traceCount - shift; // display x
+                    trace[2*traceCount + 1] = v > 1.0f ? 1.0f : v < -1.0f ? -1.0f : v; // display y
                 }
+            }
+            else
+            {
+                float ofs = itData->m_ofs;
+                float amp = itData->m_amp;
+                float bias = projectionType == Projector::ProjectionMagLin ? -1.0f : 0.0f;
 
-                (*itTrace)[2*traceCount]
-                           = traceCount - shift;   // display x
-                (*itTrace)[2*traceCount + 1] = v;  // display y
-                traceCount++;
-            } // process one sample
+                for (int i = start; i < end; i++, traceCount++)
+                {
+                    float v = (projected[i] - ofs) * amp + bias;
+                    trace[2*traceCount] = traceCount - shift; // display x
+                    trace[2*traceCount + 1] = v > 1.0f ? 1.0f : v < -1.0f ? -1.0f : v; // display y
+                }
+            }
         } // loop on traces
 
-        for (unsigned int i = 0; i < vbegin.size(); i++) {
-            ++vbegin[i];
-        }
-        remainder--;
-        m_nbSamples--;
-    } // loop on samples
+        remainder -= nbSamples;
+        m_nbSamples -= nbSamples;
+    }
 
     float traceTime = ((float) m_traceSize) / m_sampleRate;
 
@@ -931,6 +1023,47 @@ int ScopeVis::processTraces(const std::vector<ComplexVector::const_iterator>& vc
     }
 }
 
+const Real *ScopeVis::projectBlock(
+    TraceControl *traceControl,
+    uint32_t streamIndex,
+    Projector::ProjectionType projectionType,
+    ComplexVector::const_iterator begin,
+    int nbSamples
+)
+{
+    if (projectionType == Projector::ProjectionMagDB) { // dB conversion is done with display scaling
+        projectionType = Projector::ProjectionMagSq;
+    }
+
+    // traces with the same projection on the same stream share the same projected block
+    // except phase derivative that depends on the previous sample seen by the trace own projector
+    if (projectionType != Projector::ProjectionDPhase)
+    {
+        for (unsigned int i = 0; i < m_projectionKeys.size(); i++)
+        {
+            if ((m_projectionKeys[i].first == streamIndex) && (m_projectionKeys[i].second == projectionType)) {
+                return &m_projections[i*nbSamples];
+            }
+        }
+    }
+
+    Real *projected = &m_projections[m_projectionKeys.size()*nbSamples];
+    m_projectionKeys.push_back(std::pair<uint32_t, Projector::ProjectionType>(streamIndex, projectionType));
+
+    if (traceControl->m_projector.getProjectionType() == projectionType)
+    {
+        traceControl->m_projector.run(&(*begin), nbSamples, projected);
+    }
+    else
+    {
+        for (int i = 0; i < nbSamples; i++, ++begin) {
+            projected[i] = std::norm(*begin);
+        }
+    }
+
+    return projected;
+}
+
 void ScopeVis::handleInputMessages()
 {
 	Message* message;
@@ -1132,13 +1265,9 @@ void ScopeVis::applySettings(const GLScopeSettings& settings, bool force)
 void ScopeVis::updateMaxTraceDelay()
 {
     int maxTraceDelay = 0;
-    bool allocateCache = false;
-    uint32_t projectorCounts[(int) Projector::nbProjectionTypes];
-    memset(projectorCounts, 0, ((int) Projector::nbProjectionTypes)*sizeof(uint32_t));
     std::vector<GLScopeSettings::TraceData>::iterator itData = m_traces.m_tracesData.begin();
-    std::vector<TraceControl*>::iterator itCtrl = m_traces.m_tracesControl.begin();
 
-    for (; itData != m_traces.m_tracesData.end(); ++itData, ++itCtrl)
+    for (; itData != m_traces.m_tracesData.end(); ++itData)
     {
         if (itData->m_traceDelay > maxTraceDelay)
         {
@@ -1148,32 +1277,6 @@ void ScopeVis::updateMaxTraceDelay()
         if (itData->m_projectionType < 0) {
             itData->m_projectionType = Projector::ProjectionReal;
         }
-
-        if (m_nbStreams <= 1) // Works only for single stream mode. Fixes #872
-        {
-            if (projectorCounts[(int) itData->m_projectionType] > 0)
-            {
-                allocateCache = true;
-                (*itCtrl)->m_projector.setCacheMaster(false);
-            }
-            else
-            {
-                (*itCtrl)->m_projector.setCacheMaster(true);
-            }
-        }
-
-        projectorCounts[(int) itData->m_projectionType]++;
-    }
-
-    itCtrl = m_traces.m_tracesControl.begin();
-
-    for (; itCtrl != m_traces.m_tracesControl.end(); ++itCtrl)
-    {
-        if (allocateCache) {
-            (*itCtrl)->m_projector.setCache(m_projectorCache);
-        } else {
-            (*itCtrl)->m_projector.setCache(nullptr);
-        }
     }
 
     m_maxTraceDelay = maxTraceDelay;
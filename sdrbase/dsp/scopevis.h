@@ -22,10 +22,13 @@
 #include <QDebug>
 #include <QColor>
 #include <QByteArray>
+#include <QSemaphore>
 
 #include <algorithm>
 #include <utility>
 #include <cmath>
+#include <atomic>
+#include <thread>
 
 #include <stdint.h>
 #include <vector>
@@ -361,6 +364,8 @@ public:
     void setMemoryIndex(uint32_t memoryIndex);
     void setTraceChunkSize(uint32_t chunkSize) { m_traceChunkSize = chunkSize; }
     uint32_t getTraceChunkSize() const { return m_traceChunkSize; }
+    void setProcessingThread(bool processingThread); //!< Run trigger and trace processing in its own thread fed by a lock-free FIFO
+    bool getProcessingThread() const { return m_processingThread.load(); }
 
     QByteArray serializeMemory() const
     {
@@ -1120,6 +1125,86 @@ private:
         float *m_x1;
     };
 
+    /**
+     * Single producer single consumer lock-free FIFO used to pass samples from the DSP thread
+     * to the processing thread. One buffer per stream all sharing the same read and write heads.
+     * Samples that do not fit are dropped and counted.
+     */
+    struct InputFifo
+    {
+        std::vector<ComplexVector> m_buffers;
+        unsigned int m_size;
+        std::atomic<unsigned int> m_readHead;
+        std::atomic<unsigned int> m_writeHead;
+        std::atomic<unsigned int> m_dropped; //!< Samples dropped since last report
+
+        InputFifo() :
+            m_size(0),
+            m_readHead(0),
+            m_writeHead(0),
+            m_dropped(0)
+        {}
+
+        void allocate(unsigned int nbStreams, unsigned int size)
+        {
+            m_buffers.resize(nbStreams);
+
+            for (auto& buffer : m_buffers) {
+                buffer.resize(size);
+            }
+
+            m_size = size;
+            m_readHead = 0;
+            m_writeHead = 0;
+            m_dropped = 0;
+        }
+
+        unsigned int getNbStreams() const { return m_buffers.size(); }
+
+        bool write(const std::vector<ComplexVector::const_iterator>& vbegin, unsigned int nbSamples)
+        {
+            unsigned int readHead = m_readHead.load(std::memory_order_acquire);
+            unsigned int writeHead = m_writeHead.load(std::memory_order_relaxed);
+            unsigned int space = (readHead > writeHead ? readHead - writeHead : m_size - writeHead + readHead) - 1;
+
+            if (nbSamples > space)
+            {
+                m_dropped.fetch_add(nbSamples, std::memory_order_relaxed);
+                return false;
+            }
+
+            unsigned int part1 = std::min(nbSamples, m_size - writeHead);
+
+            for (unsigned int s = 0; s < m_buffers.size(); s++)
+            {
+                std::copy(vbegin[s], vbegin[s] + part1, m_buffers[s].begin() + writeHead);
+                std::copy(vbegin[s] + part1, vbegin[s] + nbSamples, m_buffers[s].begin());
+            }
+
+            m_writeHead.store((writeHead + nbSamples) % m_size, std::memory_order_release);
+            return true;
+        }
+
+        unsigned int readBegin(std::vector<ComplexVector::const_iterator>& vbegin) //!< Get the contiguous readable part
+        {
+            unsigned int writeHead = m_writeHead.load(std::memory_order_acquire);
+            unsigned int readHead = m_readHead.load(std::memory_order_relaxed);
+            vbegin.clear();
+
+            for (const auto& buffer : m_buffers) {
+                vbegin.push_back(buffer.begin() + readHead);
+            }
+
+            return writeHead >= readHead ? writeHead - readHead : m_size - readHead;
+        }
+
+        void readCommit(unsigned int nbSamples)
+        {
+            unsigned int readHead = m_readHead.load(std::memory_order_relaxed);
+            m_readHead.store((readHead + nbSamples) % m_size, std::memory_order_release);
+        }
+    };
+
     class TriggerComparator
     {
     public:
@@ -1135,17 +1220,114 @@ private:
                 computeLevels();
             }
 
-            bool condition, trigger;
+            return edge(triggerCondition.m_projector.run(s) > getLevel(triggerCondition), triggerCondition);
+        }
+
+        /**
+         * Look for trigger in a block of samples. The block is projected at once and the
+         * level comparison is done on the whole block before edges are searched.
+         * Returns the index of the triggering sample in the block or -1 if not triggered.
+         */
+        int triggeredBlock(ComplexVector::const_iterator begin, int nbSamples, TriggerCondition& triggerCondition)
+        {
+            if (triggerCondition.m_triggerData.m_triggerLevel != m_level)
+            {
+                m_level = triggerCondition.m_triggerData.m_triggerLevel;
+                computeLevels();
+            }
+
+            if (nbSamples <= 0) {
+                return -1;
+            }
+
+            if ((int) m_projected.size() < nbSamples)
+            {
+                m_projected.resize(nbSamples);
+                m_conditions.resize(nbSamples);
+            }
+
+            triggerCondition.m_projector.run(&(*begin), nbSamples, m_projected.data());
+            const Real level = getLevel(triggerCondition);
+            const Real *projected = m_projected.data();
+            uint8_t *conditions = m_conditions.data();
+
+            for (int i = 0; i < nbSamples; i++) {
+                conditions[i] = projected[i] > level ? 1 : 0;
+            }
+
+            int i = 0;
+
+            if (triggerCondition.m_triggerData.m_triggerHoldoff == 0) // no holdoff: jump from level change to level change
+            {
+                if (m_reset) {
+                    edge(conditions[i++] != 0, triggerCondition);
+                }
+
+                while (i < nbSamples)
+                {
+                    uint8_t changed = triggerCondition.m_prevCondition ? 0 : 1;
+                    uint8_t *it = std::find(conditions + i, conditions + nbSamples, changed);
 
-            if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagDB) {
-                condition = triggerCondition.m_projector.run(s) > m_levelPowerDB;
-            } else if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagLin) {
-                condition = triggerCondition.m_projector.run(s) > m_levelPowerLin;
-            } else if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagSq) {
-                condition = triggerCondition.m_projector.run(s) > m_levelPowerLin;
+                    if (it == conditions + nbSamples) {
+                        break;
+                    }
+
+                    i = it - conditions;
+
+                    if (edge(changed != 0, triggerCondition))
+                    {
+                        triggerCondition.m_projector.resync(*(begin + i));
+                        return i;
+                    }
+
+                    i++;
+                }
+            }
+            else
+            {
+                for (; i < nbSamples; i++)
+                {
+                    if (edge(conditions[i] != 0, triggerCondition))
+                    {
+                        triggerCondition.m_projector.resync(*(begin + i));
+                        return i;
+                    }
+                }
+            }
+
+            return -1;
+        }
+
+        void reset() {
+            m_reset = true;
+        }
+
+    private:
+        void computeLevels()
+        {
+            m_levelPowerLin = m_level + 1.0f;
+            m_levelPowerDB = (100.0f * (m_level - 1.0f));
+        }
+
+        Real getLevel(const TriggerCondition& triggerCondition) const
+        {
+            Projector::ProjectionType projectionType = triggerCondition.m_projector.getProjectionType();
+
+            if (projectionType == Projector::ProjectionMagDB) {
+                return m_levelPowerDB;
+            } else if ((projectionType == Projector::ProjectionMagLin) || (projectionType == Projector::ProjectionMagSq)) {
+                return m_levelPowerLin;
             } else {
-                condition = triggerCondition.m_projector.run(s) > m_level;
+                return m_level;
             }
+        }
+
+        /**
+         * Apply holdoff to the level condition and detect the edge with the previous condition
+         */
+        bool edge(bool condition, TriggerCondition& triggerCondition)
+        {
+            bool trigger;
 
             if (condition)
             {
@@ -1185,33 +1367,16 @@ private:
                 trigger = triggerCondition.m_prevCondition && !condition;
             }
 
-//            if (trigger) {
-//                qDebug("ScopeVis::triggered: %s/%s %f/%f",
-//                        triggerCondition.m_prevCondition ? "T" : "F",
-//                        condition ? "T" : "F",
-//                        triggerCondition.m_projector->run(s),
-//                        triggerCondition.m_triggerData.m_triggerLevel);
-//            }
-
             triggerCondition.m_prevCondition = condition;
             return trigger;
         }
 
-        void reset() {
-            m_reset = true;
-        }
-
-    private:
-        void computeLevels()
-        {
-            m_levelPowerLin = m_level + 1.0f;
-            m_levelPowerDB = (100.0f * (m_level - 1.0f));
-        }
-
         Real m_level;
         Real m_levelPowerDB;
         Real m_levelPowerLin;
         bool m_reset;
+        std::vector<Real> m_projected;     //!< Projected samples of the current block
+        std::vector<uint8_t> m_conditions; //!< Level conditions of the current block
     };
 
     GLScopeInterface* m_glScope;
@@ -1243,10 +1408,19 @@ private:
     int m_maxTraceDelay;                           //!< Maximum trace delay
     TriggerComparator m_triggerComparator;         //!< Compares sample level to trigger level
     QMutex m_mutex;
-    Real m_projectorCache[(int) Projector::nbProjectionTypes];
     bool m_triggerOneShot;                         //!< True when one shot mode is active
     bool m_triggerWaitForReset;                    //!< In one shot mode suspended until reset by UI
     uint32_t m_currentTraceMemoryIndex;            //!< The current index of trace in memory (0: current)
+    std::vector<Real> m_projections;               //!< Projected blocks shared by traces
+    std::vector<std::pair<uint32_t, Projector::ProjectionType>> m_projectionKeys; //!< Stream index and projection of each projected block
+    std::atomic<bool> m_processingThread;          //!< True if processing is done in its own thread
+    std::atomic<bool> m_processingStop;            //!< Processing thread stop request
+    std::thread m_processingWorker;                //!< Processing thread
+    QSemaphore m_processingSemaphore;              //!< Signals new samples to processing thread
+    InputFifo m_inputFifo;                         //!< Samples from DSP thread to processing thread
+    QMutex m_feedMutex;                            //!< Serializes input FIFO writes with processing thread switching
+    static const unsigned int m_inputFifoSize = 1<<18; //!< Size of input FIFO in number of samples per stream
+    static const int m_inputFifoReportMs = 1000;   //!< Minimum time between two reports of dropped samples
 
 
     void applySettings(const GLScopeSettings& settings, bool force = false);
@@ -1268,6 +1442,29 @@ private:
      */
     bool nextTrigger(); //!< Returns true if not final
 
+    /**
+     * Process incoming samples. Configuration lock is held by the caller.
+     */
+    void processFeed(const std::vector<ComplexVector::const_iterator>& vbegin, int nbSamples);
+
+    /**
+     * Processing thread main loop consuming the input FIFO
+     */
+    void processingLoop();
+
+    /**
+     * Project a block of samples for a trace. The block is computed once for all traces with
+     * the same stateless projection on the same stream. Stateful projections (phase derivative)
+     * are always run by the trace own projector. Returns pointer to the projected samples.
+     */
+    const Real *projectBlock(
+        TraceControl *traceControl,
+        uint32_t streamIndex,
+        Projector::ProjectionType projectionType,
+        ComplexVector::const_iterator begin,
+        int nbSamples
+    );
+
     /**
      * Process a sample trace which length is at most the trace length (m_traceSize)
      */
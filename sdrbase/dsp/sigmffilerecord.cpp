@@ -57,6 +57,7 @@ SigMFFileRecord::SigMFFileRecord(const QString& fileName, const QString& hardwar
     m_fileName(fileName),
     m_sampleRate(0),
     m_centerFrequency(0),
+    m_msShift(0),
     m_recordOn(false),
     m_recordStart(true),
     m_sampleStart(0),
@@ -104,7 +104,7 @@ void SpectrumVis::feedTriggered(const SampleVector::const_iterator& triggerPoint
 
 void SpectrumVis::feed(const Complex *begin, unsigned int length)
 {
-	if (!m_glSpectrum && !m_wsSpectrum.socketOpened()) {
+	if (!m_glSpectrum && !m_wsSpectrum.socketOpened() && !m_waterfall.isEnabled()) {
 		return;
 	}
 
@@ -158,6 +158,11 @@ void SpectrumVis::feed(const Complex *begin, unsigned int length)
                 m_settings.m_usb
             );
         }
+
+        // waterfall tiles for headless viewers
+        if (m_waterfall.isEnabled()) {
+            feedWaterfall();
+        }
     }
     else if (m_settings.m_averagingMode == SpectrumSettings::AvgModeMoving)
     {
@@ -200,6 +205,11 @@ void SpectrumVis::feed(const Complex *begin, unsigned int length)
             );
         }
 
+        // waterfall tiles for headless viewers
+        if (m_waterfall.isEnabled()) {
+            feedWaterfall();
+        }
+
         m_movingAverage.nextAverage();
     }
     else if (m_settings.m_averagingMode == SpectrumSettings::AvgModeFixed)
@@ -251,6 +261,11 @@ void SpectrumVis::feed(const Complex *begin, unsigned int length)
                     m_settings.m_usb
                 );
             }
+
+            // waterfall tiles for headless viewers
+            if (m_waterfall.isEnabled()) {
+                feedWaterfall();
+            }
         }
     }
     else if (m_settings.m_averagingMode == SpectrumSettings::AvgModeMax)
@@ -302,6 +317,11 @@ void SpectrumVis::feed(const Complex *begin, unsigned int length)
                     m_settings.m_usb
                 );
             }
+
+            // waterfall tiles for headless viewers
+            if (m_waterfall.isEnabled()) {
+                feedWaterfall();
+            }
         }
     }
 
@@ -315,7 +335,7 @@ void SpectrumVis::feed(const ComplexVector::const_iterator& cbegin, const Comple
     }
 
 	// if no visualisation is set, send the samples to /dev/null
-	if (!m_glSpectrum && !m_wsSpectrum.socketOpened()) {
+	if (!m_glSpectrum && !m_wsSpectrum.socketOpened() && !m_waterfall.isEnabled()) {
 		return;
 	}
 
@@ -365,7 +385,7 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
     }
 
 	// if no visualisation is set, send the samples to /dev/null
-	if (!m_glSpectrum && !m_wsSpectrum.socketOpened()) {
+	if (!m_glSpectrum && !m_wsSpectrum.socketOpened() && !m_waterfall.isEnabled()) {
 		return;
 	}
 
@@ -413,6 +433,21 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 	m_mutex.unlock();
 }
 
+void SpectrumVis::feedWaterfall()
+{
+    m_waterfall.newSpectrum(
+        m_powerSpectrum,
+        m_settings.m_fftSize,
+        m_centerFrequency,
+        m_sampleRate,
+        m_settings.m_linear,
+        m_settings.m_ssb,
+        m_settings.m_usb,
+        m_settings.m_refLevel,
+        m_settings.m_powerRange
+    );
+}
+
 void SpectrumVis::processFFT(bool positiveOnly)
 {
     int fftMin = (m_frequencyZoomFactor == 1.0f) ?
@@ -492,6 +527,11 @@ void SpectrumVis::processFFT(bool positiveOnly)
                 m_settings.m_usb
             );
         }
+
+        // waterfall tiles for headless viewers
+        if (m_waterfall.isEnabled()) {
+            feedWaterfall();
+        }
     }
     else if (m_settings.m_averagingMode == SpectrumSettings::AvgModeMoving)
     {
@@ -557,6 +597,11 @@ void SpectrumVis::processFFT(bool positiveOnly)
             );
         }
 
+        // waterfall tiles for headless viewers
+        if (m_waterfall.isEnabled()) {
+            feedWaterfall();
+        }
+
         m_movingAverage.nextAverage();
     }
     else if (m_settings.m_averagingMode == SpectrumSettings::AvgModeFixed)
@@ -640,6 +685,11 @@ void SpectrumVis::processFFT(bool positiveOnly)
                     m_settings.m_usb
                 );
             }
+
+            // waterfall tiles for headless viewers
+            if (m_waterfall.isEnabled()) {
+                feedWaterfall();
+            }
         }
     }
     else if (m_settings.m_averagingMode == SpectrumSettings::AvgModeMax)
@@ -723,6 +773,11 @@ void SpectrumVis::processFFT(bool positiveOnly)
                     m_settings.m_usb
                 );
             }
+
+            // waterfall tiles for headless viewers
+            if (m_waterfall.isEnabled()) {
+                feedWaterfall();
+            }
         }
     }
 }
@@ -1054,6 +1109,45 @@ int SpectrumVis::webapiSpectrumServerDelete(SWGSDRangel::SWGSuccessResponse& res
     return 200;
 }
 
+int SpectrumVis::webapiSpectrumWaterfallGet(const SpectrumWaterfall::TileRequest& request, QByteArray& png, QString& errorMessage)
+{
+    if (!m_waterfall.isEnabled())
+    {
+        errorMessage = "Waterfall is not started";
+        return 400;
+    }
+
+    SpectrumWaterfall::TileRequest tileRequest = request;
+
+    if (tileRequest.m_colorMap.isEmpty()) {
+        tileRequest.m_colorMap = m_settings.m_colorMap;
+    }
+
+    if (!m_waterfall.renderPNG(tileRequest, png))
+    {
+        errorMessage = "No waterfall data in the requested range";
+        return 404;
+    }
+
+    return 200;
+}
+
+int SpectrumVis::webapiSpectrumWaterfallPost(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage)
+{
+    (void) errorMessage;
+    m_waterfall.setEnabled(true);
+    response.setMessage(new QString("Waterfall started"));
+    return 200;
+}
+
+int SpectrumVis::webapiSpectrumWaterfallDelete(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage)
+{
+    (void) errorMessage;
+    m_waterfall.setEnabled(false);
+    response.setMessage(new QString("Waterfall stopped"));
+    return 200;
+}
+
 void SpectrumVis::webapiFormatSpectrumSettings(SWGSDRangel::SWGGLSpectrum& response, const SpectrumSettings& settings)
 {
     settings.formatTo(&response);
@@ -25,6 +25,7 @@
 #include "dsp/fftengine.h"
 #include "dsp/fftwindow.h"
 #include "dsp/spectrumsettings.h"
+#include "dsp/spectrumwaterfall.h"
 #include "export.h"
 #include "util/message.h"
 #include "util/messagequeue.h"
@@ -172,6 +173,9 @@ public:
     int webapiSpectrumServerGet(SWGSDRangel::SWGSpectrumServer& response, QString& errorMessage) const;
     int webapiSpectrumServerPost(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
     int webapiSpectrumServerDelete(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
+    int webapiSpectrumWaterfallGet(const SpectrumWaterfall::TileRequest& request, QByteArray& png, QString& errorMessage);
+    int webapiSpectrumWaterfallPost(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
+    int webapiSpectrumWaterfallDelete(SWGSDRangel::SWGSuccessResponse& response, QString& errorMessage);
 
 private:
     class MsgConfigureScalingFactor : public Message
@@ -231,6 +235,7 @@ private:
 	Real m_scalef;
 	GLSpectrumInterface* m_glSpectrum;
     WSSpectrum m_wsSpectrum;
+    SpectrumWaterfall m_waterfall;
 	MovingAverage2D<double> m_movingAverage;
 	FixedAverage2D<double> m_fixedAverage;
 	Max2D<double> m_max;
@@ -249,6 +254,7 @@ private:
 	QMutex m_mutex;
 
     void processFFT(bool positiveOnly);
+    void feedWaterfall();
     void setRunning(bool running) { m_running = running; }
     void applySettings(const SpectrumSettings& settings, bool force = false);
   	bool handleMessage(const Message& message);
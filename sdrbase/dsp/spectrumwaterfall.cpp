@@ -0,0 +1,392 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QDebug>
+
+#include "util/colormap.h"
+
+#include "spectrumwaterfall.h"
+
+SpectrumWaterfall::SpectrumWaterfall() :
+    m_enabled(false),
+    m_depth(1024),
+    m_rowPeriodMs(100),
+    m_writeIndex(0),
+    m_count(0),
+    m_seq(0),
+    m_pendingValid(false),
+    m_tileCacheSeq(0)
+{
+    resizeRing(m_depth);
+}
+
+SpectrumWaterfall::~SpectrumWaterfall()
+{}
+
+void SpectrumWaterfall::setEnabled(bool enabled)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (enabled == m_enabled) {
+        return;
+    }
+
+    qDebug("SpectrumWaterfall::setEnabled: %s", enabled ? "true" : "false");
+
+    if (!enabled)
+    {
+        // Free memory when not in use
+        resizeRing(0);
+        resizeRing(m_depth);
+        m_pendingValid = false;
+        m_lineCacheKey.clear();
+        m_tileCacheKey.clear();
+        m_tileCachePNG.clear();
+    }
+
+    m_enabled = enabled;
+}
+
+void SpectrumWaterfall::setDepth(int depth)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if ((depth > 0) && (depth != m_depth))
+    {
+        m_depth = depth;
+        resizeRing(depth);
+    }
+}
+
+void SpectrumWaterfall::setRowPeriod(int rowPeriodMs)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_rowPeriodMs = rowPeriodMs < 0 ? 0 : rowPeriodMs;
+}
+
+int SpectrumWaterfall::getNbRows()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_count;
+}
+
+void SpectrumWaterfall::resizeRing(int depth)
+{
+    m_rows.clear();
+    m_rows.shrink_to_fit();
+    m_rows.resize(depth);
+    m_lineCache.clear();
+    m_lineCache.shrink_to_fit();
+    m_lineCache.resize(depth);
+    m_lineCacheSeq.assign(depth, 0);
+    m_writeIndex = 0;
+    m_count = 0;
+}
+
+void SpectrumWaterfall::newSpectrum(
+    const std::vector<Real>& spectrum,
+    int fftSize,
+    qint64 centerFrequency,
+    int sampleRate,
+    bool linear,
+    bool ssb,
+    bool usb,
+    Real refLevel,
+    Real powerRange)
+{
+    if (!m_enabled || (fftSize <= 0) || (sampleRate <= 0)) {
+        return;
+    }
+
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 startFrequency;
+    double binWidth;
+
+    if (ssb)
+    {
+        startFrequency = centerFrequency;
+        binWidth = (usb ? 1.0 : -1.0) * (sampleRate / 2.0) / fftSize;
+    }
+    else
+    {
+        startFrequency = centerFrequency - sampleRate / 2;
+        binWidth = (double) sampleRate / fftSize;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_enabled) { // disabled while unlocked
+        return;
+    }
+
+    if (m_pendingValid
+     && (((int) m_pending.m_bins.size() != fftSize)
+      || (m_pending.m_startFrequency != startFrequency)
+      || (m_pending.m_binWidth != binWidth)))
+    {
+        flushPending();
+    }
+
+    if (!m_pendingValid)
+    {
+        m_pending.m_time = now;
+        m_pending.m_startFrequency = startFrequency;
+        m_pending.m_binWidth = binWidth;
+        m_pending.m_bins.assign(fftSize, 0);
+        m_pendingValid = true;
+    }
+
+    // Quantize to 8 bits over the display power range and peak hold
+    float minLevel = refLevel - powerRange;
+    float scale = powerRange > 0 ? 255.0f / powerRange : 0.0f;
+    quint8 *bins = m_pending.m_bins.data();
+
+    for (int i = 0; i < fftSize; i++)
+    {
+        float v = linear ? (spectrum[i] > 0 ? 10.0f * log10f(spectrum[i]) : minLevel) : spectrum[i];
+        float q = (v - minLevel) * scale;
+        quint8 b = q <= 0.0f ? 0 : q >= 255.0f ? 255 : (quint8) q;
+
+        if (b > bins[i]) {
+            bins[i] = b;
+        }
+    }
+
+    if (now - m_pending.m_time >= m_rowPeriodMs) {
+        flushPending();
+    }
+}
+
+void SpectrumWaterfall::flushPending()
+{
+    if (!m_pendingValid || m_rows.empty()) {
+        return;
+    }
+
+    Row& row = m_rows[m_writeIndex];
+    row.m_time = m_pending.m_time;
+    row.m_startFrequency = m_pending.m_startFrequency;
+    row.m_binWidth = m_pending.m_binWidth;
+    row.m_seq = ++m_seq;
+    row.m_bins.swap(m_pending.m_bins); // the old bins of the slot will be reassigned on next spectrum
+
+    m_writeIndex = (m_writeIndex + 1) % m_depth;
+    m_count = std::min(m_count + 1, m_depth);
+    m_pendingValid = false;
+}
+
+const QVector<QRgb>& SpectrumWaterfall::getColorMapLUT(const QString& colorMap)
+{
+    QHash<QString, QVector<QRgb>>::const_iterator it = m_colorMapLUTs.constFind(colorMap);
+
+    if (it != m_colorMapLUTs.constEnd()) {
+        return it.value();
+    }
+
+    const float *map = ColorMap::getColorMap(colorMap);
+
+    if (!map) {
+        map = ColorMap::getColorMap("Angel");
+    }
+
+    QVector<QRgb> lut(256);
+
+    for (int i = 0; i < 256; i++)
+    {
+        lut[i] = qRgb(
+            (int) (map[3*i] * 255.0f),
+            (int) (map[3*i+1] * 255.0f),
+            (int) (map[3*i+2] * 255.0f)
+        );
+    }
+
+    return m_colorMapLUTs.insert(colorMap, lut).value();
+}
+
+const std::vector<QRgb>& SpectrumWaterfall::renderLine(
+    int slot,
+    qint64 startFrequency,
+    qint64 endFrequency,
+    int width,
+    const QVector<QRgb>& lut)
+{
+    const Row& row = m_rows[slot];
+    std::vector<QRgb>& line = m_lineCache[slot];
+
+    if ((m_lineCacheSeq[slot] == row.m_seq) && ((int) line.size() == width)) {
+        return line;
+    }
+
+    line.resize(width);
+    int nbBins = row.m_bins.size();
+    double pixelWidth = (double) (endFrequency - startFrequency) / width;
+
+    for (int x = 0; x < width; x++)
+    {
+        // Range of bins covered by this pixel - take the peak when there are several
+        double b0 = (startFrequency + x*pixelWidth - row.m_startFrequency) / row.m_binWidth;
+        double b1 = (startFrequency + (x+1)*pixelWidth - row.m_startFrequency) / row.m_binWidth;
+
+        if (b0 > b1) {
+            std::swap(b0, b1);
+        }
+
+        int i0 = (int) std::floor(b0);
+        int i1 = std::max(i0, (int) std::ceil(b1) - 1);
+
+        if ((i1 < 0) || (i0 >= nbBins))
+        {
+            line[x] = qRgb(0, 0, 0);
+            continue;
+        }
+
+        i0 = std::max(i0, 0);
+        i1 = std::min(i1, nbBins - 1);
+        quint8 peak = *std::max_element(row.m_bins.begin() + i0, row.m_bins.begin() + i1 + 1);
+        line[x] = lut[peak];
+    }
+
+    m_lineCacheSeq[slot] = row.m_seq;
+
+    return line;
+}
+
+QString SpectrumWaterfall::getTileKey(const TileRequest& request)
+{
+    return QString("%1:%2:%3:%4:%5:%6:%7")
+        .arg(request.m_startTime)
+        .arg(request.m_endTime)
+        .arg(request.m_startFrequency)
+        .arg(request.m_endFrequency)
+        .arg(request.m_width)
+        .arg(request.m_height)
+        .arg(request.m_colorMap);
+}
+
+bool SpectrumWaterfall::renderTile(const TileRequest& request, QImage& image)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_enabled || (m_count == 0)) {
+        return false;
+    }
+
+    // Select rows in time range, newest first
+    std::vector<int> slots;
+    slots.reserve(m_count);
+
+    for (int i = 0; i < m_count; i++)
+    {
+        int slot = (m_writeIndex - 1 - i + m_depth) % m_depth;
+        const Row& row = m_rows[slot];
+
+        if ((request.m_endTime != 0) && (row.m_time > request.m_endTime)) {
+            continue;
+        }
+        if ((request.m_startTime != 0) && (row.m_time < request.m_startTime)) {
+            break;
+        }
+
+        slots.push_back(slot);
+    }
+
+    if (slots.empty()) {
+        return false;
+    }
+
+    qint64 startFrequency = request.m_startFrequency;
+    qint64 endFrequency = request.m_endFrequency;
+
+    if (startFrequency == endFrequency)
+    {
+        const Row& newest = m_rows[slots[0]];
+        qint64 f0 = newest.m_startFrequency;
+        qint64 f1 = newest.m_startFrequency + (qint64) (newest.m_binWidth * newest.m_bins.size());
+        startFrequency = std::min(f0, f1);
+        endFrequency = std::max(f0, f1);
+    }
+
+    int width = std::max(1, std::min(request.m_width, m_maxWidth));
+    int height = request.m_height > 0 ? std::min(request.m_height, m_maxHeight) : std::min((int) slots.size(), m_maxHeight);
+    const QVector<QRgb>& lut = getColorMapLUT(request.m_colorMap);
+
+    // Invalidate line cache when horizontal geometry or colours change
+    QString lineCacheKey = QString("%1:%2:%3:%4").arg(startFrequency).arg(endFrequency).arg(width).arg(request.m_colorMap);
+
+    if (lineCacheKey != m_lineCacheKey)
+    {
+        std::fill(m_lineCacheSeq.begin(), m_lineCacheSeq.end(), 0);
+        m_lineCacheKey = lineCacheKey;
+    }
+
+    image = QImage(width, height, QImage::Format_RGB32);
+
+    for (int y = 0; y < height; y++)
+    {
+        int slot = slots[((qint64) y * slots.size()) / height];
+        const std::vector<QRgb>& line = renderLine(slot, startFrequency, endFrequency, width, lut);
+        std::copy(line.begin(), line.end(), reinterpret_cast<QRgb*>(image.scanLine(y)));
+    }
+
+    return true;
+}
+
+bool SpectrumWaterfall::renderPNG(const TileRequest& request, QByteArray& png)
+{
+    QString tileKey = getTileKey(request);
+    quint64 seq;
+
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        seq = m_seq;
+
+        if ((tileKey == m_tileCacheKey) && (seq == m_tileCacheSeq) && !m_tileCachePNG.isEmpty())
+        {
+            png = m_tileCachePNG;
+            return true;
+        }
+    }
+
+    QImage image;
+
+    if (!renderTile(request, image)) {
+        return false;
+    }
+
+    // Encoding is done without holding the lock so spectrum lines keep flowing
+    png.clear();
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+
+    if (!image.save(&buffer, "PNG"))
+    {
+        qWarning("SpectrumWaterfall::renderPNG: failed to encode PNG");
+        return false;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    m_tileCacheKey = tileKey;
+    m_tileCacheSeq = seq;
+    m_tileCachePNG = png;
+
+    return true;
+}
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SPECTRUMWATERFALL_H
+#define INCLUDE_SPECTRUMWATERFALL_H
+
+#include <atomic>
+#include <vector>
+
+#include <QMutex>
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+#include <QHash>
+#include <QVector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+// CPU rendered waterfall for headless instances where there is no GLSpectrum.
+// Spectrum lines from SpectrumVis are quantized to 8 bits and kept in a ring of rows.
+// Tiles are rendered on request for a time and frequency range. Colour mapped lines are
+// cached so only new rows are rendered and the last encoded PNG is served again to all
+// viewers asking for the same tile until a new row arrives.
+class SDRBASE_API SpectrumWaterfall
+{
+public:
+    struct TileRequest
+    {
+        qint64 m_startTime;      //!< Oldest row in ms since epoch - 0 for oldest available
+        qint64 m_endTime;        //!< Newest row in ms since epoch - 0 for newest available
+        qint64 m_startFrequency; //!< Frequency at left edge in Hz - same as end for span of newest row
+        qint64 m_endFrequency;   //!< Frequency at right edge in Hz
+        int m_width;             //!< Width in pixels
+        int m_height;            //!< Height in pixels - 0 for one line per row
+        QString m_colorMap;      //!< Name of ColorMap
+
+        TileRequest() :
+            m_startTime(0),
+            m_endTime(0),
+            m_startFrequency(0),
+            m_endFrequency(0),
+            m_width(1024),
+            m_height(0),
+            m_colorMap("Angel")
+        {}
+    };
+
+    SpectrumWaterfall();
+    ~SpectrumWaterfall();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+    void setDepth(int depth);         //!< Number of rows kept
+    void setRowPeriod(int rowPeriodMs); //!< Spectrum lines within a period are peak held into the same row
+    int getDepth() const { return m_depth; }
+    int getRowPeriod() const { return m_rowPeriodMs; }
+    int getNbRows();
+
+    void newSpectrum(
+        const std::vector<Real>& spectrum,
+        int fftSize,
+        qint64 centerFrequency,
+        int sampleRate,
+        bool linear,
+        bool ssb,
+        bool usb,
+        Real refLevel,
+        Real powerRange
+    );
+    bool renderTile(const TileRequest& request, QImage& image);
+    bool renderPNG(const TileRequest& request, QByteArray& png);
+
+    static const int m_maxWidth = 8192;
+    static const int m_maxHeight = 8192;
+
+private:
+    struct Row
+    {
+        qint64 m_time;           //!< ms since epoch
+        qint64 m_startFrequency; //!< Frequency of first bin
+        double m_binWidth;       //!< Frequency increment between bins (negative for LSB)
+        quint64 m_seq;           //!< Sequence number of row - 0 if slot is empty
+        std::vector<quint8> m_bins;
+
+        Row() :
+            m_time(0),
+            m_startFrequency(0),
+            m_binWidth(1.0),
+            m_seq(0)
+        {}
+    };
+
+    std::atomic<bool> m_enabled; //!< Set from GUI thread, checked without lock on DSP thread
+    int m_depth;
+    int m_rowPeriodMs;
+    std::vector<Row> m_rows; //!< Ring of rows
+    int m_writeIndex;        //!< Next slot to write
+    int m_count;             //!< Number of valid rows
+    quint64 m_seq;           //!< Sequence number of last row written
+    Row m_pending;           //!< Row being peak held
+    bool m_pendingValid;
+
+    // Colour mapped lines of each slot for the last tile key
+    QString m_lineCacheKey;
+    std::vector<std::vector<QRgb>> m_lineCache;
+    std::vector<quint64> m_lineCacheSeq;
+    QHash<QString, QVector<QRgb>> m_colorMapLUTs;
+
+    // Last encoded tile
+    QString m_tileCacheKey;
+    quint64 m_tileCacheSeq;
+    QByteArray m_tileCachePNG;
+
+    QMutex m_mutex;
+
+    void flushPending();
+    void resizeRing(int depth);
+    const QVector<QRgb>& getColorMapLUT(const QString& colorMap);
+    const std::vector<QRgb>& renderLine(
+        int slot,
+        qint64 startFrequency,
+        qint64 endFrequency,
+        int width,
+        const QVector<QRgb>& lut
+    );
+    static QString getTileKey(const TileRequest& request);
+};
+
+#endif // INCLUDE_SPECTRUMWATERFALL_H
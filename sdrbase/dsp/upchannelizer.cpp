@@ -35,7 +35,9 @@ UpChannelizer::UpChannelizer(ChannelSampleSource* sampleSource) :
     m_channelSampleRate(0),
     m_channelFrequencyOffset(0),
     m_log2Interp(0),
-    m_filterChainHash(0)
+    m_filterChainHash(0),
+    m_stagesPending(false),
+    m_residueIndex(0)
 {
 }
 
@@ -54,35 +56,51 @@ void UpChannelizer::pullOne(Sample& sample)
 
     unsigned int log2Interp = m_filterStages.size();
 
-    if (log2Interp == 0) // optimization when no downsampling is done anyway
+    if (m_residueIndex < m_residue.size()) // samples interpolated in excess by a previous block pull come first
+    {
+        sample = m_residue[m_residueIndex++];
+    }
+    else if (log2Interp == 0) // optimization when no downsampling is done anyway
     {
         m_sampleSource->pullOne(sample);
     }
     else
     {
-        FilterStages::iterator stage = m_filterStages.begin();
-        std::vector<Sample>::iterator stageSample = m_stageSamples.begin();
+        if (!m_stagesPending) { // inputs consumed by a block pull
+            primeStages();
+        }
 
-        for (; stage != m_filterStages.end(); ++stage, ++stageSample)
-        {
-            if(stage == m_filterStages.end() - 1)
-            {
-                if ((*stage)->work(&m_sampleIn, &(*stageSample)))
-                {
-                    m_sampleSource->pullOne(m_sampleIn); // get new input sample
-                }
-            }
-            else
-            {
-                if (!(*stage)->work(&(*(stageSample+1)), &(*stageSample)))
-                {
-                    break;
-                }
-            }
+        stageOutput(0, sample);
+    }
+}
+
+// Stage i interpolates m_stageSamples[i+1] (m_sampleIn for the last stage) which is pulled ahead as soon as consumed
+void UpChannelizer::stageOutput(unsigned int stageIndex, Sample& sample)
+{
+    if (stageIndex == m_filterStages.size() - 1)
+    {
+        if (m_filterStages[stageIndex]->work(&m_sampleIn, &sample)) {
+            m_sampleSource->pullOne(m_sampleIn); // get new input sample
         }
+    }
+    else
+    {
+        if (m_filterStages[stageIndex]->work(&m_stageSamples[stageIndex+1], &sample)) {
+            stageOutput(stageIndex + 1, m_stageSamples[stageIndex+1]);
+        }
+    }
+}
 
-        sample = *m_stageSamples.begin();
+// Pull ahead the input of every stage from the last one (source side) to the first one
+void UpChannelizer::primeStages()
+{
+    m_sampleSource->pullOne(m_sampleIn);
+
+    for (int i = m_filterStages.size() - 1; i > 0; i--) {
+        stageOutput(i, m_stageSamples[i]);
     }
+
+    m_stagesPending = true;
 }
 
 void UpChannelizer::pull(SampleVector::iterator begin, unsigned int nbSamples)
@@ -101,20 +119,82 @@ void UpChannelizer::pull(SampleVector::iterator begin, unsigned int nbSamples)
     }
     else
     {
-        std::for_each(
-            begin,
-            begin + nbSamples,
-            [this](Sample& s) {
-                pullOne(s);
+        pullBlock(begin, nbSamples);
+    }
+}
+
+void UpChannelizer::pullBlock(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    // Serve what is left over from previous block
+    unsigned int nbResidue = m_residue.size() - m_residueIndex;
+    unsigned int nbFromResidue = std::min(nbResidue, nbSamples);
+    std::copy(m_residue.begin() + m_residueIndex, m_residue.begin() + m_residueIndex + nbFromResidue, begin);
+    m_residueIndex += nbFromResidue;
+    begin += nbFromResidue;
+    nbSamples -= nbFromResidue;
+
+    unsigned int log2Interp = m_filterStages.size();
+
+    while (nbSamples > 0)
+    {
+        // Pull the whole source block at once then run each stage over the whole block
+        unsigned int nbIn = (nbSamples + (1<<log2Interp) - 1) >> log2Interp;
+        SampleVector& inBuffer = m_stageBuffers[log2Interp];
+
+        if (inBuffer.size() < nbIn) {
+            inBuffer.resize(nbIn);
+        }
+
+        // Inputs pulled ahead by pullOne come first at each stage so that none is skipped or repeated
+        bool pending = m_stagesPending;
+        m_stagesPending = false;
+
+        if (pending)
+        {
+            inBuffer[0] = m_sampleIn;
+
+            if (nbIn > 1) {
+                m_sampleSource->pull(inBuffer.begin() + 1, nbIn - 1);
             }
-        );
+        }
+        else
+        {
+            m_sampleSource->pull(inBuffer.begin(), nbIn);
+        }
+        unsigned int nb = nbIn;
+
+        for (int i = log2Interp - 1; i >= 0; i--)
+        {
+            SampleVector& outBuffer = m_stageBuffers[i];
+            unsigned int offset = (pending && (i > 0)) ? 1 : 0; // pending input of the next stage
+
+            if (outBuffer.size() < 2*nb + offset) {
+                outBuffer.resize(2*nb + offset);
+            }
+
+            if (offset) {
+                outBuffer[0] = m_stageSamples[i];
+            }
+
+            nb = offset + m_filterStages[i]->workBlock(m_stageBuffers[i+1].data(), nb, outBuffer.data() + offset);
+        }
+
+        SampleVector& outBuffer = m_stageBuffers[0];
+        unsigned int nbOut = std::min(nb, nbSamples);
+        std::copy(outBuffer.begin(), outBuffer.begin() + nbOut, begin);
+        begin += nbOut;
+        nbSamples -= nbOut;
+        m_residue.assign(outBuffer.begin() + nbOut, outBuffer.begin() + nb);
+        m_residueIndex = 0;
     }
 }
 
 void UpChannelizer::prefetch(unsigned int nbSamples)
 {
     unsigned int log2Interp = m_filterStages.size();
-    m_sampleSource->prefetch(nbSamples/(1<<log2Interp)); // 2^n less samples will be produced by the source
+    unsigned int nbResidue = m_residue.size() - m_residueIndex;
+    unsigned int nbNeeded = nbSamples > nbResidue ? nbSamples - nbResidue : 0;
+    m_sampleSource->prefetch((nbNeeded + (1<<log2Interp) - 1) >> log2Interp); // 2^n less samples will be produced by the source
 }
 
 void UpChannelizer::setChannelization(int requestedSampleRate, qint64 requestedCenterFrequency)
@@ -156,6 +236,7 @@ void UpChannelizer::applyChannelization()
         m_requestedCenterFrequency - m_requestedInputSampleRate / 2, m_requestedCenterFrequency + m_requestedInputSampleRate / 2);
 
     m_channelSampleRate = m_basebandSampleRate / (1 << m_filterStages.size());
+    m_stageBuffers.resize(m_filterStages.size() + 1);
 
     qDebug() << "UpChannelizer::applyConfiguration: done: "
             << " out:" << m_basebandSampleRate
@@ -182,6 +263,7 @@ void UpChannelizer::applyInterpolation()
 
     m_channelFrequencyOffset = m_basebandSampleRate * setFilterChain(stageIndexes);
     m_channelSampleRate = m_basebandSampleRate / (1 << m_filterStages.size());
+    m_stageBuffers.resize(m_filterStages.size() + 1);
     m_requestedInputSampleRate = m_channelSampleRate;
 
 	qDebug() << "UpChannelizer::applyInterpolation:"
@@ -353,6 +435,10 @@ void UpChannelizer::freeFilterChain()
         delete *it;
     m_filterStages.clear();
     m_stageSamples.clear();
+    m_residue.clear();
+    m_residueIndex = 0;
+    m_stageBuffers.clear();
+    m_stagesPending = false;
 }
 
 
@@ -73,6 +73,21 @@ protected:
         bool work(Sample* sampleIn, Sample *sampleOut) {
             return (m_filter->*m_workFunction)(sampleIn, sampleOut);
         }
+
+        //!< Run the per-sample interpolator over a block of nbIn samples. Output must hold 2*nbIn samples. Returns the number of output samples.
+        unsigned int workBlock(Sample* sampleIn, unsigned int nbIn, Sample *sampleOut)
+        {
+            Sample *out = sampleOut;
+
+            for (unsigned int i = 0; i < nbIn; out++)
+            {
+                if ((m_filter->*m_workFunction)(&sampleIn[i], out)) {
+                    i++;
+                }
+            }
+
+            return out - sampleOut;
+        }
     };
 
     typedef std::vector<FilterStage*> FilterStages;
@@ -89,6 +104,10 @@ protected:
     unsigned int m_filterChainHash;
     SampleVector m_sampleBuffer;
     Sample m_sampleIn;
+    bool m_stagesPending;                     //!< pullOne has pulled ahead the input of every stage (m_sampleIn and m_stageSamples[1..])
+    std::vector<SampleVector> m_stageBuffers; //!< Block mode: one buffer per stage output plus the source input
+    SampleVector m_residue;                   //!< Block mode: samples interpolated in excess at previous pull
+    unsigned int m_residueIndex;
 
     void applyChannelization();
     void applyInterpolation();
@@ -96,6 +115,9 @@ protected:
     Real createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
     double setFilterChain(const std::vector<unsigned int>& stageIndexes); //!< returns offset in ratio of sample rate
     void freeFilterChain();
+    void pullBlock(SampleVector::iterator begin, unsigned int nbSamples);
+    void primeStages();
+    void stageOutput(unsigned int stageIndex, Sample& sample);
 };
 
 
@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QThread>
+#include <QDebug>
+
+#include "vocoderpool.h"
+
+class VocoderPool::Stream
+{
+public:
+    QString m_name;
+    int m_maxQueuedJobs;
+    QQueue<QueuedJob> m_jobs;
+    bool m_running;     //!< A job of this stream is running
+    bool m_closing;
+    Stats m_stats;
+    quint64 m_reportedOverruns; //!< Overruns already logged
+    qint64 m_reportTimeNs;      //!< Time overruns were last logged or -1 if never
+
+    Stream(const QString& name, int maxQueuedJobs) :
+        m_name(name),
+        m_maxQueuedJobs(maxQueuedJobs),
+        m_running(false),
+        m_closing(false),
+        m_reportedOverruns(0),
+        m_reportTimeNs(-1)
+    {}
+};
+
+class VocoderPool::Worker : public QThread
+{
+public:
+    Worker(VocoderPool *pool) :
+        m_pool(pool)
+    {}
+
+protected:
+    void run() override { m_pool->work(); }
+
+private:
+    VocoderPool *m_pool;
+};
+
+VocoderPool::VocoderPool() :
+    m_stop(false)
+{
+    // Leave cores for the device and channel DSP threads
+    m_nbThreads = QThread::idealThreadCount() / 4;
+    m_nbThreads = m_nbThreads < 1 ? 1 : m_nbThreads > 4 ? 4 : m_nbThreads;
+    m_clock.start();
+}
+
+VocoderPool::~VocoderPool()
+{
+    stop();
+    qDeleteAll(m_streams);
+}
+
+void VocoderPool::setNbThreads(int nbThreads)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_nbThreads = nbThreads < 1 ? 1 : nbThreads > m_maxThreads ? m_maxThreads : nbThreads;
+}
+
+void VocoderPool::start()
+{
+    qDebug("VocoderPool::start: %d threads", m_nbThreads);
+    m_stop = false;
+
+    for (int i = 0; i < m_nbThreads; i++)
+    {
+        Worker *worker = new Worker(this);
+        worker->start();
+        m_workers.append(worker);
+    }
+}
+
+void VocoderPool::stop()
+{
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        m_stop = true;
+        m_jobAvailable.wakeAll();
+    }
+
+    for (auto worker : m_workers)
+    {
+        worker->wait();
+        delete worker;
+    }
+
+    m_workers.clear();
+}
+
+VocoderPool::Stream *VocoderPool::openStream(const QString& name, int maxQueuedJobs)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_workers.isEmpty()) {
+        start();
+    }
+
+    Stream *stream = new Stream(name, maxQueuedJobs < 1 ? 1 : maxQueuedJobs);
+    m_streams.append(stream);
+    qDebug("VocoderPool::openStream: %s (%d streams)", qPrintable(name), m_streams.size());
+
+    return stream;
+}
+
+void VocoderPool::closeStream(Stream *stream)
+{
+    if (!stream) {
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+
+    stream->m_closing = true;
+    stream->m_jobs.clear();
+    m_ready.removeAll(stream);
+
+    while (stream->m_running) {
+        m_jobDone.wait(&m_mutex);
+    }
+
+    const Stats& stats = stream->m_stats;
+    qDebug("VocoderPool::closeStream: %s: %llu jobs %llu overruns queue avg %.3f max %.3f ms run avg %.3f ms",
+        qPrintable(stream->m_name),
+        stats.m_nbJobs,
+        stats.m_nbOverruns,
+        stats.getAverageQueueMs(),
+        stats.getMaxQueueMs(),
+        stats.getAverageRunMs());
+
+    m_streams.removeAll(stream);
+    delete stream;
+}
+
+bool VocoderPool::push(Stream *stream, const Job& job, bool droppable)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (stream->m_closing) {
+        return false;
+    }
+
+    if (droppable && (stream->m_jobs.size() >= stream->m_maxQueuedJobs))
+    {
+        stream->m_stats.m_nbOverruns++;
+        m_stats.m_nbOverruns++;
+        qint64 nowNs = m_clock.nsecsElapsed();
+
+        if ((stream->m_reportTimeNs < 0) || (nowNs - stream->m_reportTimeNs >= m_overrunReportPeriodNs))
+        {
+            qWarning("VocoderPool::push: %s: overrun: %llu jobs dropped (%llu in total)",
+                qPrintable(stream->m_name),
+                stream->m_stats.m_nbOverruns - stream->m_reportedOverruns,
+                stream->m_stats.m_nbOverruns);
+            stream->m_reportedOverruns = stream->m_stats.m_nbOverruns;
+            stream->m_reportTimeNs = nowNs;
+        }
+
+        return false;
+    }
+
+    stream->m_jobs.enqueue(QueuedJob{job, m_clock.nsecsElapsed()});
+
+    // A stream with a running job is requeued by the worker when the job completes
+    if (!stream->m_running && (stream->m_jobs.size() == 1))
+    {
+        m_ready.enqueue(stream);
+        m_jobAvailable.wakeOne();
+    }
+
+    return true;
+}
+
+void VocoderPool::work()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while (true)
+    {
+        while (!m_stop && m_ready.isEmpty()) {
+            m_jobAvailable.wait(&m_mutex);
+        }
+
+        if (m_stop) {
+            break;
+        }
+
+        Stream *stream = m_ready.dequeue();
+        QueuedJob queuedJob = stream->m_jobs.dequeue();
+        stream->m_running = true;
+        qint64 startNs = m_clock.nsecsElapsed();
+        qint64 queueNs = startNs - queuedJob.m_pushTimeNs;
+
+        mutexLocker.unlock();
+        queuedJob.m_job();
+        mutexLocker.relock();
+
+        qint64 runNs = m_clock.nsecsElapsed() - startNs;
+
+        for (Stats *stats : {&stream->m_stats, &m_stats})
+        {
+            stats->m_nbJobs++;
+            stats->m_sumQueueNs += queueNs;
+            stats->m_maxQueueNs = std::max(stats->m_maxQueueNs, queueNs);
+            stats->m_sumRunNs += runNs;
+        }
+
+        stream->m_running = false;
+
+        if (!stream->m_jobs.isEmpty()) {
+            m_ready.enqueue(stream); // Back of the queue so that other streams are served
+        }
+
+        m_jobDone.wakeAll();
+    }
+}
+
+void VocoderPool::getStats(Stream *stream, Stats& stats)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    stats = stream->m_stats;
+}
+
+void VocoderPool::getStats(Stats& stats)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    stats = m_stats;
+}
+
+int VocoderPool::getNbStreams()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_streams.size();
+}
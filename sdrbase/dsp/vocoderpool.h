@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_VOCODERPOOL_H
+#define INCLUDE_VOCODERPOOL_H
+
+#include <functional>
+
+#include <QList>
+#include <QQueue>
+#include <QString>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+#include "export.h"
+
+// Worker threads shared by all digital voice channels to run vocoder decoding off the channel DSP threads.
+// Each channel opens a stream and pushes jobs (typically decode a voice frame and write audio to its AudioFifo).
+// Jobs of a stream run one at a time in push order. Streams are served round robin one job at a time.
+// The queue of each stream is bounded: a job pushed to a full stream is dropped and counted as an overrun.
+// Overruns are logged at most once per m_overrunReportPeriodNs for each stream.
+class SDRBASE_API VocoderPool
+{
+public:
+    typedef std::function<void()> Job;
+
+    struct Stats
+    {
+        quint64 m_nbJobs;        //!< Jobs run
+        quint64 m_nbOverruns;    //!< Jobs dropped because the queue was full
+        qint64 m_sumQueueNs;     //!< Total time jobs waited in queue
+        qint64 m_maxQueueNs;     //!< Longest time a job waited in queue
+        qint64 m_sumRunNs;       //!< Total time spent running jobs
+
+        Stats() :
+            m_nbJobs(0),
+            m_nbOverruns(0),
+            m_sumQueueNs(0),
+            m_maxQueueNs(0),
+            m_sumRunNs(0)
+        {}
+
+        double getAverageQueueMs() const { return m_nbJobs == 0 ? 0.0 : (m_sumQueueNs / (double) m_nbJobs) / 1e6; }
+        double getMaxQueueMs() const { return m_maxQueueNs / 1e6; }
+        double getAverageRunMs() const { return m_nbJobs == 0 ? 0.0 : (m_sumRunNs / (double) m_nbJobs) / 1e6; }
+    };
+
+    class Stream;
+
+    VocoderPool();
+    ~VocoderPool();
+
+    void setNbThreads(int nbThreads); //!< Takes effect when the pool starts i.e. when the first stream is opened
+    int getNbThreads() const { return m_nbThreads; }
+
+    Stream *openStream(const QString& name, int maxQueuedJobs = m_defaultMaxQueuedJobs);
+    void closeStream(Stream *stream); //!< Pending jobs are discarded. Waits for a running job to complete.
+    bool push(Stream *stream, const Job& job, bool droppable = true); //!< Returns false if the job was dropped. Non droppable jobs (settings) ignore the bound.
+    void getStats(Stream *stream, Stats& stats);
+    void getStats(Stats& stats); //!< For all streams since the pool started
+    int getNbStreams();
+
+    static const int m_defaultMaxQueuedJobs = 64;
+    static const int m_maxThreads = 16;
+    static const qint64 m_overrunReportPeriodNs = 10000000000LL;
+
+private:
+    struct QueuedJob
+    {
+        Job m_job;
+        qint64 m_pushTimeNs;
+    };
+
+    class Worker;
+
+    int m_nbThreads;
+    QList<Worker*> m_workers;
+    QList<Stream*> m_streams;
+    QQueue<Stream*> m_ready;   //!< Streams with pending jobs and no running job
+    bool m_stop;
+    Stats m_stats;
+    QElapsedTimer m_clock;
+    QMutex m_mutex;
+    QWaitCondition m_jobAvailable;
+    QWaitCondition m_jobDone;
+
+    void start();
+    void stop();
+    void work();
+};
+
+#endif // INCLUDE_VOCODERPOOL_H
@@ -29,6 +29,9 @@
 
 #include "maincore.h"
 
+#include "SWGChannelSettings.h"
+#include "SWGFeatureSettings.h"
+
 MESSAGE_CLASS_DEFINITION(MainCore::MsgDVSerial, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgDeleteInstance, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgLoadPreset, Message)
@@ -50,6 +53,8 @@ MESSAGE_CLASS_DEFINITION(MainCore::MsgDeleteChannel, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgApplySettings, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgAddFeature, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgDeleteFeature, Message)
+MESSAGE_CLASS_DEFINITION(MainCore::MsgApplyChannelsBatch, Message)
+MESSAGE_CLASS_DEFINITION(MainCore::MsgApplyFeaturesBatch, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgChannelReport, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgChannelSettings, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgChannelDemodReport, Message)
@@ -59,6 +64,7 @@ MESSAGE_CLASS_DEFINITION(MainCore::MsgMoveMainSpectrumUIToWorkspace, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgMoveFeatureUIToWorkspace, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgMoveChannelUIToWorkspace, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgMapItem, Message)
+MESSAGE_CLASS_DEFINITION(MainCore::MsgMapItems, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgPacket, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgTargetAzimuthElevation, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgStarTrackerTarget, Message)
@@ -158,6 +164,88 @@ Feature *MainCore::getFeature(unsigned int featureSetIndex, int featureIndex)
     }
 }
 
+int MainCore::applyChannelSettings(unsigned int deviceSetIndex, int channelIndex, const BatchOperation& operation)
+{
+    if (!operation.m_channelSettings || operation.m_settingsKeys.isEmpty()) {
+        return 200;
+    }
+
+    ChannelAPI *channelAPI = getChannel(deviceSetIndex, channelIndex);
+
+    if (!channelAPI)
+    {
+        qWarning("MainCore::applyChannelSettings: there is no channel at %u:%d", deviceSetIndex, channelIndex);
+        return 404;
+    }
+
+    QString channelType;
+    channelAPI->getIdentifier(channelType);
+
+    if (channelType != *operation.m_channelSettings->getChannelType())
+    {
+        qWarning("MainCore::applyChannelSettings: channel at %u:%d is %s not %s",
+            deviceSetIndex, channelIndex, qPrintable(channelType), qPrintable(*operation.m_channelSettings->getChannelType()));
+        return 404;
+    }
+
+    QString errorMessage;
+    int status = channelAPI->webapiSettingsPutPatch(false, operation.m_settingsKeys, *operation.m_channelSettings, errorMessage);
+
+    if (status/100 != 2) {
+        qWarning("MainCore::applyChannelSettings: %u:%d: %s", deviceSetIndex, channelIndex, qPrintable(errorMessage));
+    }
+
+    return status;
+}
+
+int MainCore::applyFeatureSettings(unsigned int featureSetIndex, int featureIndex, const BatchOperation& operation)
+{
+    if (!operation.m_featureSettings || operation.m_settingsKeys.isEmpty()) {
+        return 200;
+    }
+
+    Feature *feature = getFeature(featureSetIndex, featureIndex);
+
+    if (!feature)
+    {
+        qWarning("MainCore::applyFeatureSettings: there is no feature at %u:%d", featureSetIndex, featureIndex);
+        return 404;
+    }
+
+    QString featureType;
+    feature->getIdentifier(featureType);
+
+    if (featureType != *operation.m_featureSettings->getFeatureType())
+    {
+        qWarning("MainCore::applyFeatureSettings: feature at %u:%d is %s not %s",
+            featureSetIndex, featureIndex, qPrintable(featureType), qPrintable(*operation.m_featureSettings->getFeatureType()));
+        return 404;
+    }
+
+    QString errorMessage;
+    int status = feature->webapiSettingsPutPatch(false, operation.m_settingsKeys, *operation.m_featureSettings, errorMessage);
+
+    if (status/100 != 2) {
+        qWarning("MainCore::applyFeatureSettings: %u:%d: %s", featureSetIndex, featureIndex, qPrintable(errorMessage));
+    }
+
+    return status;
+}
+
+MainCore::MsgApplyChannelsBatch::~MsgApplyChannelsBatch()
+{
+    for (const auto& operation : m_operations) {
+        delete operation.m_channelSettings;
+    }
+}
+
+MainCore::MsgApplyFeaturesBatch::~MsgApplyFeaturesBatch()
+{
+    for (const auto& operation : m_operations) {
+        delete operation.m_featureSettings;
+    }
+}
+
 void MainCore::appendFeatureSet()
 {
     int newIndex = m_featureSets.size();
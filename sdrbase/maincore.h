@@ -25,10 +25,16 @@
 #include <QElapsedTimer>
 #include <QDateTime>
 #include <QObject>
+#include <QStringList>
+#include <QSharedPointer>
+#include <QSemaphore>
 
 #include "export.h"
 #include "settings/mainsettings.h"
 #include "util/message.h"
+#include "util/mapitemdata.h"
+#include "util/ephemeris.h"
+#include "util/logwriter.h"
 #include "pipes/messagepipes.h"
 #include "pipes/datapipes.h"
 #include "channel/channelapi.h"
@@ -47,6 +53,7 @@ namespace SWGSDRangel
 {
     class SWGChannelReport;
     class SWGChannelSettings;
+    class SWGFeatureSettings;
     class SWGMapItem;
     class SWGTargetAzimuthElevation;
     class SWGStarTrackerTarget;
@@ -490,6 +497,95 @@ public:
         { }
     };
 
+    // One operation of a batch on channels or features. Settings are owned by the batch message.
+    struct BatchOperation
+    {
+        enum Type {
+            Add,
+            Update,
+            Delete
+        };
+
+        Type m_type;
+        int m_index;                    //!< Channel or feature to update or delete
+        int m_registrationIndex;        //!< Plugin registration for add
+        int m_direction;                //!< Channel direction for add
+        QStringList m_settingsKeys;
+        SWGSDRangel::SWGChannelSettings *m_channelSettings; //!< Settings to apply to channel or nullptr
+        SWGSDRangel::SWGFeatureSettings *m_featureSettings; //!< Settings to apply to feature or nullptr
+
+        BatchOperation() :
+            m_type(Add),
+            m_index(0),
+            m_registrationIndex(0),
+            m_direction(0),
+            m_channelSettings(nullptr),
+            m_featureSettings(nullptr)
+        {}
+    };
+
+    // Status of each operation of a batch in the order of the operations. Set by the main thread
+    // when the batch is applied and the semaphore is released then.
+    struct BatchResults
+    {
+        QList<int> m_statuses;
+        QSemaphore m_applied;
+    };
+
+    class SDRBASE_API MsgApplyChannelsBatch : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        int getDeviceSetIndex() const { return m_deviceSetIndex; }
+        const QList<BatchOperation>& getOperations() const { return m_operations; }
+        QSharedPointer<BatchResults> getResults() const { return m_results; }
+
+        static MsgApplyChannelsBatch* create(int deviceSetIndex, const QList<BatchOperation>& operations, QSharedPointer<BatchResults> results) {
+            return new MsgApplyChannelsBatch(deviceSetIndex, operations, results);
+        }
+
+        ~MsgApplyChannelsBatch();
+
+    private:
+        int m_deviceSetIndex;
+        QList<BatchOperation> m_operations;
+        QSharedPointer<BatchResults> m_results;
+
+        MsgApplyChannelsBatch(int deviceSetIndex, const QList<BatchOperation>& operations, QSharedPointer<BatchResults> results) :
+            Message(),
+            m_deviceSetIndex(deviceSetIndex),
+            m_operations(operations),
+            m_results(results)
+        { }
+    };
+
+    class SDRBASE_API MsgApplyFeaturesBatch : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        int getFeatureSetIndex() const { return m_featureSetIndex; }
+        const QList<BatchOperation>& getOperations() const { return m_operations; }
+        QSharedPointer<BatchResults> getResults() const { return m_results; }
+
+        static MsgApplyFeaturesBatch* create(int featureSetIndex, const QList<BatchOperation>& operations, QSharedPointer<BatchResults> results) {
+            return new MsgApplyFeaturesBatch(featureSetIndex, operations, results);
+        }
+
+        ~MsgApplyFeaturesBatch();
+
+    private:
+        int m_featureSetIndex;
+        QList<BatchOperation> m_operations;
+        QSharedPointer<BatchResults> m_results;
+
+        MsgApplyFeaturesBatch(int featureSetIndex, const QList<BatchOperation>& operations, QSharedPointer<BatchResults> results) :
+            Message(),
+            m_featureSetIndex(featureSetIndex),
+            m_operations(operations),
+            m_results(results)
+        { }
+    };
+
     class SDRBASE_API MsgChannelReport : public Message {
         MESSAGE_CLASS_DECLARATION
 
@@ -707,6 +803,31 @@ public:
         { }
     };
 
+    // Message to Map feature with a batch of items to display on the map
+    // The batch is implicitly shared so the same message content can be pushed to several pipes without copy
+    class SDRBASE_API MsgMapItems : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        const QObject *getPipeSource() const { return m_pipeSource; }
+        const QVector<MapItemData>& getMapItems() const { return m_mapItems; }
+
+        static MsgMapItems* create(const QObject *pipeSource, const QVector<MapItemData>& mapItems)
+        {
+            return new MsgMapItems(pipeSource, mapItems);
+        }
+
+    private:
+        const QObject *m_pipeSource;
+        QVector<MapItemData> m_mapItems;
+
+        MsgMapItems(const QObject *pipeSource, const QVector<MapItemData>& mapItems) :
+            Message(),
+            m_pipeSource(pipeSource),
+            m_mapItems(mapItems)
+        { }
+    };
+
     // Message to pass received packets between channels and features
     class SDRBASE_API MsgPacket : public Message {
         MESSAGE_CLASS_DECLARATION
@@ -853,6 +974,8 @@ public:
     DeviceAPI *getDevice(unsigned int deviceSetIndex);
     ChannelAPI *getChannel(unsigned int deviceSetIndex, int channelIndex);
     Feature *getFeature(unsigned int featureSetIndex, int featureIndex);
+    int applyChannelSettings(unsigned int deviceSetIndex, int channelIndex, const BatchOperation& operation); //!< Settings of a batch operation
+    int applyFeatureSettings(unsigned int featureSetIndex, int featureIndex, const BatchOperation& operation); //!< Settings of a batch operation
     bool existsChannel(const ChannelAPI *channel) const { return m_channelsMap.contains(const_cast<ChannelAPI*>(channel)); }
     bool existsFeature(const Feature *feature) const { return m_featuresMap.contains(const_cast<Feature*>(feature)); }
     // slave mode
@@ -875,6 +998,9 @@ public:
     // pipes
     MessagePipes& getMessagePipes() { return m_messagePipes; }
     DataPipes& getDataPipes() { return m_dataPipes; }
+    // shared services
+    Ephemeris& getEphemeris() { return m_ephemeris; }
+    LogWriterService& getLogWriterService() { return m_logWriterService; }
 
     friend class MainServer;
     friend class MainWindow;
@@ -911,6 +1037,8 @@ private:
     PluginManager* m_pluginManager;
     MessagePipes m_messagePipes;
     DataPipes m_dataPipes;
+    Ephemeris m_ephemeris;
+    LogWriterService m_logWriterService;
 
     void debugMaps();
 };
@@ -31,19 +31,50 @@ MainParser::MainParser() :
         "Web API server port.",
         "port",
         "8091"),
+    m_reportsPortOption("reports-port",
+        "Web socket reports server port (0 for none).",
+        "port",
+        "0"),
     m_fftwfWisdomOption(QStringList() << "w" << "fftwf-wisdom",
         "FFTW Wisdom file.",
         "file",
         ""),
     m_scratchOption("scratch", "Start from scratch (no current config)."),
-    m_soapyOption("soapy", "Activate Soapy SDR support.")
+    m_soapyOption("soapy", "Activate Soapy SDR support."),
+    m_lazyPluginsOption("lazy-plugins", "Load channel and feature plugins on first use (uses cached plugin manifest)."),
+    m_parallelEnumerationOption("parallel-enum", "Enumerate devices of each hardware type in parallel (some vendor libraries may not support it)."),
+    m_batchOption("batch",
+        "Server only: play the recording of this Rx preset (.prex file or saved preset name) as fast as possible then exit.",
+        "preset",
+        ""),
+    m_batchInputOption("batch-input",
+        "Server only: recording to play in batch mode instead of the file of the preset.",
+        "file",
+        ""),
+    m_decoderLogMaxSizeOption("decoder-log-max-size",
+        "Rotate decoder log files larger than this size in MB (0 for no size rotation).",
+        "size",
+        "0"),
+    m_decoderLogPeriodOption("decoder-log-period",
+        "Rotate decoder log files every period in minutes (0 for no time rotation).",
+        "minutes",
+        "0"),
+    m_decoderLogCompressOption("decoder-log-compress", "Compress rotated decoder log files with gzip.")
 {
 
     m_serverAddress = "";   // Bind to any address
     m_serverPort = 8091;
+    m_reportsPort = 0;
     m_scratch = false;
     m_soapy = false;
+    m_lazyPlugins = false;
+    m_parallelEnumeration = false;
     m_fftwfWindowFileName = "";
+    m_batchPreset = "";
+    m_batchInput = "";
+    m_decoderLogMaxSize = 0;
+    m_decoderLogPeriod = 0;
+    m_decoderLogCompress = false;
 
     m_parser.setApplicationDescription("Software Defined Radio application");
     m_parser.addHelpOption();
@@ -51,9 +82,17 @@ MainParser::MainParser() :
 
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
+    m_parser.addOption(m_reportsPortOption);
     m_parser.addOption(m_fftwfWisdomOption);
     m_parser.addOption(m_scratchOption);
     m_parser.addOption(m_soapyOption);
+    m_parser.addOption(m_lazyPluginsOption);
+    m_parser.addOption(m_parallelEnumerationOption);
+    m_parser.addOption(m_batchOption);
+    m_parser.addOption(m_batchInputOption);
+    m_parser.addOption(m_decoderLogMaxSizeOption);
+    m_parser.addOption(m_decoderLogPeriodOption);
+    m_parser.addOption(m_decoderLogCompressOption);
 }
 
 MainParser::~MainParser()
@@ -96,6 +135,17 @@ void MainParser::parse(const QCoreApplication& app)
         qWarning() << "MainParser::parse: server port invalid. Defaulting to " << m_serverPort;
     }
 
+    // Web socket reports server port
+
+    QString reportsPortStr = m_parser.value(m_reportsPortOption);
+    int reportsPort = reportsPortStr.toInt(&ok);
+
+    if (ok && ((reportsPort == 0) || ((reportsPort > 1023) && (reportsPort < 65536)))) {
+        m_reportsPort = reportsPort;
+    } else {
+        qWarning() << "MainParser::parse: reports port invalid. Defaulting to " << m_reportsPort;
+    }
+
     // FFTWF wisdom file
     m_fftwfWindowFileName = m_parser.value(m_fftwfWisdomOption);
 
@@ -104,4 +154,32 @@ void MainParser::parse(const QCoreApplication& app)
 
     // Soapy SDR support
     m_soapy = m_parser.isSet(m_soapyOption);
+
+    // Plugins loading
+    m_lazyPlugins = m_parser.isSet(m_lazyPluginsOption);
+    m_parallelEnumeration = m_parser.isSet(m_parallelEnumerationOption);
+
+    // Batch mode
+    m_batchPreset = m_parser.value(m_batchOption);
+    m_batchInput = m_parser.value(m_batchInputOption);
+
+    // Decoder logs rotation
+
+    int decoderLogMaxSize = m_parser.value(m_decoderLogMaxSizeOption).toInt(&ok);
+
+    if (ok && (decoderLogMaxSize >= 0)) {
+        m_decoderLogMaxSize = decoderLogMaxSize * 1024LL * 1024LL;
+    } else {
+        qWarning() << "MainParser::parse: decoder log max size invalid. Defaulting to no size rotation";
+    }
+
+    int decoderLogPeriod = m_parser.value(m_decoderLogPeriodOption).toInt(&ok);
+
+    if (ok && (decoderLogPeriod >= 0)) {
+        m_decoderLogPeriod = decoderLogPeriod * 60;
+    } else {
+        qWarning() << "MainParser::parse: decoder log period invalid. Defaulting to no time rotation";
+    }
+
+    m_decoderLogCompress = m_parser.isSet(m_decoderLogCompressOption);
 }
@@ -34,23 +34,48 @@ public:
 
     const QString& getServerAddress() const { return m_serverAddress; }
     uint16_t getServerPort() const { return m_serverPort; }
+    uint16_t getReportsPort() const { return m_reportsPort; }
     bool getScratch() const { return m_scratch; }
     bool getSoapy() const { return m_soapy; }
+    bool getLazyPlugins() const { return m_lazyPlugins; }
+    bool getParallelEnumeration() const { return m_parallelEnumeration; }
     const QString& getFFTWFWisdomFileName() const { return m_fftwfWindowFileName; }
+    const QString& getBatchPreset() const { return m_batchPreset; }
+    const QString& getBatchInput() const { return m_batchInput; }
+    bool getBatch() const { return !m_batchPreset.isEmpty(); }
+    qint64 getDecoderLogMaxSize() const { return m_decoderLogMaxSize; }
+    int getDecoderLogPeriod() const { return m_decoderLogPeriod; }
+    bool getDecoderLogCompress() const { return m_decoderLogCompress; }
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
+    uint16_t m_reportsPort;
     QString  m_fftwfWindowFileName;
     bool m_scratch;
     bool m_soapy;
+    bool m_lazyPlugins;
+    bool m_parallelEnumeration;
+    QString  m_batchPreset;
+    QString  m_batchInput;
+    qint64 m_decoderLogMaxSize;  //!< Bytes
+    int m_decoderLogPeriod;      //!< Seconds
+    bool m_decoderLogCompress;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
+    QCommandLineOption m_reportsPortOption;
     QCommandLineOption m_fftwfWisdomOption;
     QCommandLineOption m_scratchOption;
     QCommandLineOption m_soapyOption;
+    QCommandLineOption m_lazyPluginsOption;
+    QCommandLineOption m_parallelEnumerationOption;
+    QCommandLineOption m_batchOption;
+    QCommandLineOption m_batchInputOption;
+    QCommandLineOption m_decoderLogMaxSizeOption;
+    QCommandLineOption m_decoderLogPeriodOption;
+    QCommandLineOption m_decoderLogCompressOption;
 };
 
 
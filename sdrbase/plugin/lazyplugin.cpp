@@ -0,0 +1,309 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCoreApplication>
+#include <QPluginLoader>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+#include "plugin/pluginapi.h"
+#include "plugin/pluginmanager.h"
+#include "plugin/lazyplugin.h"
+
+LazyPlugin::LazyPlugin(PluginManager *pluginManager, const QString& filePath, const PluginManifest::Entry& entry) :
+    m_pluginManager(pluginManager),
+    m_filePath(filePath),
+    m_entry(entry),
+    m_pluginDescriptor{
+        entry.m_hardwareId,
+        entry.m_displayedName,
+        entry.m_version,
+        entry.m_copyright,
+        entry.m_website,
+        entry.m_licenseIsGPL,
+        entry.m_sourceCodeURL
+    },
+    m_plugin(nullptr)
+{}
+
+LazyPlugin::~LazyPlugin()
+{}
+
+void LazyPlugin::initPlugin(PluginAPI* pluginAPI)
+{
+    for (const auto& registration : m_entry.m_rxChannels) {
+        pluginAPI->registerRxChannel(registration.m_idURI, registration.m_id, this);
+    }
+    for (const auto& registration : m_entry.m_txChannels) {
+        pluginAPI->registerTxChannel(registration.m_idURI, registration.m_id, this);
+    }
+    for (const auto& registration : m_entry.m_mimoChannels) {
+        pluginAPI->registerMIMOChannel(registration.m_idURI, registration.m_id, this);
+    }
+    for (const auto& registration : m_entry.m_features) {
+        pluginAPI->registerFeature(registration.m_idURI, registration.m_id, this);
+    }
+}
+
+PluginInterface *LazyPlugin::getPlugin() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_plugin) {
+        return m_plugin;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QPluginLoader pluginLoader(m_filePath);
+
+    if (!pluginLoader.load())
+    {
+        qWarning("LazyPlugin::getPlugin: %s", qPrintable(pluginLoader.errorString()));
+        return nullptr;
+    }
+
+    QObject *object = pluginLoader.instance();
+    PluginInterface *plugin = qobject_cast<PluginInterface*>(object);
+
+    if (plugin == nullptr)
+    {
+        qWarning("LazyPlugin::getPlugin: Unable to get main instance of plugin: %s", qPrintable(m_filePath));
+        return nullptr;
+    }
+
+    // The plugin object must live in the main thread as if it had been loaded at startup
+    if (object->thread() != QCoreApplication::instance()->thread()) {
+        object->moveToThread(QCoreApplication::instance()->thread());
+    }
+
+    m_pluginManager->initLazyPlugin(plugin);
+    m_plugin = plugin;
+    qInfo("LazyPlugin::getPlugin: loaded plugin %s in %lld ms", qPrintable(m_filePath), timer.elapsed());
+
+    return m_plugin;
+}
+
+void LazyPlugin::createRxChannel(DeviceAPI *deviceAPI, BasebandSampleSink **bs, ChannelAPI **cs) const
+{
+    if (PluginInterface *plugin = getPlugin()) {
+        plugin->createRxChannel(deviceAPI, bs, cs);
+    }
+}
+
+ChannelGUI* LazyPlugin::createRxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel) const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createRxChannelGUI(deviceUISet, rxChannel) : nullptr;
+}
+
+void LazyPlugin::createTxChannel(DeviceAPI *deviceAPI, BasebandSampleSource **bs, ChannelAPI **cs) const
+{
+    if (PluginInterface *plugin = getPlugin()) {
+        plugin->createTxChannel(deviceAPI, bs, cs);
+    }
+}
+
+ChannelGUI* LazyPlugin::createTxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSource *txChannel) const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createTxChannelGUI(deviceUISet, txChannel) : nullptr;
+}
+
+void LazyPlugin::createMIMOChannel(DeviceAPI *deviceAPI, MIMOChannel **bs, ChannelAPI **cs) const
+{
+    if (PluginInterface *plugin = getPlugin()) {
+        plugin->createMIMOChannel(deviceAPI, bs, cs);
+    }
+}
+
+ChannelGUI* LazyPlugin::createMIMOChannelGUI(DeviceUISet *deviceUISet, MIMOChannel *mimoChannel) const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createMIMOChannelGUI(deviceUISet, mimoChannel) : nullptr;
+}
+
+ChannelWebAPIAdapter* LazyPlugin::createChannelWebAPIAdapter() const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createChannelWebAPIAdapter() : nullptr;
+}
+
+FeatureWebAPIAdapter* LazyPlugin::createFeatureWebAPIAdapter() const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createFeatureWebAPIAdapter() : nullptr;
+}
+
+void LazyPlugin::enumOriginDevices(QStringList& listedHwIds, OriginDevices& originDevices)
+{
+    if (PluginInterface *plugin = getPlugin()) {
+        plugin->enumOriginDevices(listedHwIds, originDevices);
+    }
+}
+
+PluginInterface::SamplingDevice::SamplingDeviceType LazyPlugin::getSamplingDeviceType() const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->getSamplingDeviceType() : PluginInterface::getSamplingDeviceType();
+}
+
+QString LazyPlugin::getDeviceTypeId() const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->getDeviceTypeId() : PluginInterface::getDeviceTypeId();
+}
+
+PluginInterface::SamplingDevices LazyPlugin::enumSampleSources(const OriginDevices& originDevices)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->enumSampleSources(originDevices) : SamplingDevices();
+}
+
+DeviceGUI* LazyPlugin::createSampleSourcePluginInstanceGUI(const QString& sourceId, QWidget **widget, DeviceUISet *deviceUISet)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleSourcePluginInstanceGUI(sourceId, widget, deviceUISet) : nullptr;
+}
+
+DeviceSampleSource* LazyPlugin::createSampleSourcePluginInstance(const QString& sourceId, DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleSourcePluginInstance(sourceId, deviceAPI) : nullptr;
+}
+
+void LazyPlugin::deleteSampleSourcePluginInstanceInput(DeviceSampleSource *source)
+{
+    if (PluginInterface *plugin = getPlugin()) {
+        plugin->deleteSampleSourcePluginInstanceInput(source);
+    } else {
+        PluginInterface::deleteSampleSourcePluginInstanceInput(source);
+    }
+}
+
+int LazyPlugin::getDefaultRxNbItems() const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->getDefaultRxNbItems() : PluginInterface::getDefaultRxNbItems();
+}
+
+PluginInterface::SamplingDevices LazyPlugin::enumSampleSinks(const OriginDevices& originDevices)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->enumSampleSinks(originDevices) : SamplingDevices();
+}
+
+DeviceGUI* LazyPlugin::createSampleSinkPluginInstanceGUI(const QString& sinkId, QWidget **widget, DeviceUISet *deviceUISet)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleSinkPluginInstanceGUI(sinkId, widget, deviceUISet) : nullptr;
+}
+
+DeviceSampleSink* LazyPlugin::createSampleSinkPluginInstance(const QString& sinkId, DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleSinkPluginInstance(sinkId, deviceAPI) : nullptr;
+}
+
+void LazyPlugin::deleteSampleSinkPluginInstanceOutput(DeviceSampleSink *sink)
+{
+    if (PluginInterface *plugin = getPlugin()) {
+        plugin->deleteSampleSinkPluginInstanceOutput(sink);
+    } else {
+        PluginInterface::deleteSampleSinkPluginInstanceOutput(sink);
+    }
+}
+
+int LazyPlugin::getDefaultTxNbItems() const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->getDefaultTxNbItems() : PluginInterface::getDefaultTxNbItems();
+}
+
+PluginInterface::SamplingDevices LazyPlugin::enumSampleMIMO(const OriginDevices& originDevices)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->enumSampleMIMO(originDevices) : SamplingDevices();
+}
+
+DeviceGUI* LazyPlugin::createSampleMIMOPluginInstanceGUI(const QString& mimoId, QWidget **widget, DeviceUISet *deviceUISet)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleMIMOPluginInstanceGUI(mimoId, widget, deviceUISet) : nullptr;
+}
+
+DeviceSampleMIMO* LazyPlugin::createSampleMIMOPluginInstance(const QString& mimoId, DeviceAPI *deviceAPI)
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createSampleMIMOPluginInstance(mimoId, deviceAPI) : nullptr;
+}
+
+void LazyPlugin::deleteSampleMIMOPluginInstanceMIMO(DeviceSampleMIMO *mimo)
+{
+    if (PluginInterface *plugin = getPlugin()) {
+        plugin->deleteSampleMIMOPluginInstanceMIMO(mimo);
+    } else {
+        PluginInterface::deleteSampleMIMOPluginInstanceMIMO(mimo);
+    }
+}
+
+int LazyPlugin::getDefaultMIMONbItems() const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->getDefaultMIMONbItems() : PluginInterface::getDefaultMIMONbItems();
+}
+
+bool LazyPlugin::createTopLevelGUI()
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createTopLevelGUI() : true;
+}
+
+QByteArray LazyPlugin::serializeGlobalSettings() const
+{
+    // Global settings of a plugin that was never loaded cannot have changed
+    return m_plugin ? m_plugin->serializeGlobalSettings() : QByteArray();
+}
+
+bool LazyPlugin::deserializeGlobalSettings(const QByteArray& data)
+{
+    if (data.isEmpty() && !m_plugin) {
+        return true;
+    }
+
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->deserializeGlobalSettings(data) : false;
+}
+
+DeviceWebAPIAdapter* LazyPlugin::createDeviceWebAPIAdapter() const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createDeviceWebAPIAdapter() : nullptr;
+}
+
+FeatureGUI* LazyPlugin::createFeatureGUI(FeatureUISet *featureUISet, Feature *feature) const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createFeatureGUI(featureUISet, feature) : nullptr;
+}
+
+Feature* LazyPlugin::createFeature(WebAPIAdapterInterface *webAPIAdapterInterface) const
+{
+    PluginInterface *plugin = getPlugin();
+    return plugin ? plugin->createFeature(webAPIAdapterInterface) : nullptr;
+}
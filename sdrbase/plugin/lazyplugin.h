@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_LAZYPLUGIN_H
+#define INCLUDE_LAZYPLUGIN_H
+
+#include <QMutex>
+
+#include "plugin/plugininterface.h"
+#include "plugin/pluginmanifest.h"
+#include "export.h"
+
+class PluginManager;
+
+/**
+ * Stands in for a channel or feature plugin described in the plugin manifest.
+ * The descriptor and registrations are served from the manifest and the plugin
+ * library is only loaded when one of the other methods is called for the first time.
+ */
+class SDRBASE_API LazyPlugin : public PluginInterface
+{
+public:
+    LazyPlugin(PluginManager *pluginManager, const QString& filePath, const PluginManifest::Entry& entry);
+    virtual ~LazyPlugin();
+
+    bool isLoaded() const { return m_plugin != nullptr; }
+    const QString& getFilePath() const { return m_filePath; }
+
+    virtual const PluginDescriptor& getPluginDescriptor() const { return m_pluginDescriptor; }
+    virtual void initPlugin(PluginAPI* pluginAPI);
+
+    virtual void createRxChannel(DeviceAPI *deviceAPI, BasebandSampleSink **bs, ChannelAPI **cs) const;
+    virtual ChannelGUI* createRxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel) const;
+    virtual void createTxChannel(DeviceAPI *deviceAPI, BasebandSampleSource **bs, ChannelAPI **cs) const;
+    virtual ChannelGUI* createTxChannelGUI(DeviceUISet *deviceUISet, BasebandSampleSource *txChannel) const;
+    virtual void createMIMOChannel(DeviceAPI *deviceAPI, MIMOChannel **bs, ChannelAPI **cs) const;
+    virtual ChannelGUI* createMIMOChannelGUI(DeviceUISet *deviceUISet, MIMOChannel *mimoChannel) const;
+    virtual ChannelWebAPIAdapter* createChannelWebAPIAdapter() const;
+    virtual FeatureWebAPIAdapter* createFeatureWebAPIAdapter() const;
+
+    virtual void enumOriginDevices(QStringList& listedHwIds, OriginDevices& originDevices);
+    virtual SamplingDevice::SamplingDeviceType getSamplingDeviceType() const;
+    virtual QString getDeviceTypeId() const;
+
+    virtual SamplingDevices enumSampleSources(const OriginDevices& originDevices);
+    virtual DeviceGUI* createSampleSourcePluginInstanceGUI(const QString& sourceId, QWidget **widget, DeviceUISet *deviceUISet);
+    virtual DeviceSampleSource* createSampleSourcePluginInstance(const QString& sourceId, DeviceAPI *deviceAPI);
+    virtual void deleteSampleSourcePluginInstanceInput(DeviceSampleSource *source);
+    virtual int getDefaultRxNbItems() const;
+
+    virtual SamplingDevices enumSampleSinks(const OriginDevices& originDevices);
+    virtual DeviceGUI* createSampleSinkPluginInstanceGUI(const QString& sinkId, QWidget **widget, DeviceUISet *deviceUISet);
+    virtual DeviceSampleSink* createSampleSinkPluginInstance(const QString& sinkId, DeviceAPI *deviceAPI);
+    virtual void deleteSampleSinkPluginInstanceOutput(DeviceSampleSink *sink);
+    virtual int getDefaultTxNbItems() const;
+
+    virtual SamplingDevices enumSampleMIMO(const OriginDevices& originDevices);
+    virtual DeviceGUI* createSampleMIMOPluginInstanceGUI(const QString& mimoId, QWidget **widget, DeviceUISet *deviceUISet);
+    virtual DeviceSampleMIMO* createSampleMIMOPluginInstance(const QString& mimoId, DeviceAPI *deviceAPI);
+    virtual void deleteSampleMIMOPluginInstanceMIMO(DeviceSampleMIMO *mimo);
+    virtual int getDefaultMIMONbItems() const;
+
+    virtual bool createTopLevelGUI();
+    virtual QByteArray serializeGlobalSettings() const;
+    virtual bool deserializeGlobalSettings(const QByteArray& data);
+
+    virtual DeviceWebAPIAdapter* createDeviceWebAPIAdapter() const;
+
+    virtual FeatureGUI* createFeatureGUI(FeatureUISet *featureUISet, Feature *feature) const;
+    virtual Feature* createFeature(WebAPIAdapterInterface *webAPIAdapterInterface) const;
+
+private:
+    PluginManager *m_pluginManager;
+    QString m_filePath;
+    PluginManifest::Entry m_entry;
+    PluginDescriptor m_pluginDescriptor;
+    mutable PluginInterface *m_plugin;
+    mutable QMutex m_mutex;
+
+    PluginInterface *getPlugin() const; //!< Load the library on first call
+};
+
+#endif // INCLUDE_LAZYPLUGIN_H
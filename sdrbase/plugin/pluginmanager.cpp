@@ -17,6 +17,8 @@
 
 #include <QCoreApplication>
 #include <QPluginLoader>
+#include <QElapsedTimer>
+#include <QMutexLocker>
 #include <QDebug>
 
 #include <cstdio>
@@ -28,6 +30,7 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 
+#include "plugin/lazyplugin.h"
 #include "plugin/pluginmanager.h"
 
 #ifndef LIB
@@ -54,13 +57,17 @@ const QString PluginManager::m_testMIMODeviceTypeID = "sdrangel.samplemimo.testm
 PluginManager::PluginManager(QObject* parent) :
 	QObject(parent),
     m_pluginAPI(this),
-    m_enableSoapy(false)
+    m_enableSoapy(false),
+    m_lazyLoading(false),
+    m_parallelEnumeration(false),
+    m_ignoreRegistrations(false)
 {
 }
 
 PluginManager::~PluginManager()
 {
   //  freeAll();
+    qDeleteAll(m_lazyPlugins);
 }
 
 void PluginManager::loadPlugins(const QString& pluginsSubDir)
@@ -71,6 +78,15 @@ void PluginManager::loadPlugins(const QString& pluginsSubDir)
 
 void PluginManager::loadPluginsPart(const QString& pluginsSubDir)
 {
+    QElapsedTimer timer;
+    timer.start();
+
+    if (m_lazyLoading)
+    {
+        m_manifest.setFileName(PluginManifest::getDefaultFileName(pluginsSubDir));
+        m_manifest.load();
+    }
+
     QString applicationDirPath = QCoreApplication::instance()->applicationDirPath();
     QStringList PluginsPath;
 
@@ -110,10 +126,15 @@ void PluginManager::loadPluginsPart(const QString& pluginsSubDir)
         qCritical("No plugins found. Exit immediately.");
         exit(EXIT_FAILURE);
     }
+
+    qInfo("PluginManager::loadPluginsPart: %s: %d plugins (%d deferred) in %lld ms",
+        qPrintable(pluginsSubDir), m_plugins.size(), m_lazyPlugins.size(), timer.elapsed());
 }
 
 void PluginManager::loadPluginsFinal()
 {
+    QElapsedTimer timer;
+    timer.start();
     std::sort(m_plugins.begin(), m_plugins.end());
 
     for (Plugins::const_iterator it = m_plugins.begin(); it != m_plugins.end(); ++it)
@@ -121,9 +142,22 @@ void PluginManager::loadPluginsFinal()
         it->pluginInterface->initPlugin(&m_pluginAPI);
     }
 
+    qInfo("PluginManager::loadPluginsFinal: plugins initialized in %lld ms", timer.restart());
+
+    if (m_lazyLoading) {
+        updateManifest();
+    }
+
+    if (m_parallelEnumeration)
+    {
+        DeviceEnumerator::instance()->enumerateOriginDevices(this);
+        qInfo("PluginManager::loadPluginsFinal: origin devices enumerated in parallel in %lld ms", timer.restart());
+    }
+
     DeviceEnumerator::instance()->enumerateRxDevices(this);
     DeviceEnumerator::instance()->enumerateTxDevices(this);
     DeviceEnumerator::instance()->enumerateMIMODevices(this);
+    qInfo("PluginManager::loadPluginsFinal: sampling devices enumerated in %lld ms", timer.elapsed());
 }
 
 void PluginManager::loadPluginsNonDiscoverable(const DeviceUserArgs& deviceUserArgs)
@@ -133,6 +167,10 @@ void PluginManager::loadPluginsNonDiscoverable(const DeviceUserArgs& deviceUserA
 
 void PluginManager::registerRxChannel(const QString& channelIdURI, const QString& channelId, PluginInterface* plugin)
 {
+    if (m_ignoreRegistrations) { // plugin already registered from manifest
+        return;
+    }
+
     qDebug() << "PluginManager::registerRxChannel "
             << plugin->getPluginDescriptor().displayedName.toStdString().c_str()
             << " with channel name " << channelIdURI;
@@ -142,6 +180,10 @@ void PluginManager::registerRxChannel(const QString& channelIdURI, const QString
 
 void PluginManager::registerTxChannel(const QString& channelIdURI, const QString& channelId, PluginInterface* plugin)
 {
+    if (m_ignoreRegistrations) { // plugin already registered from manifest
+        return;
+    }
+
     qDebug() << "PluginManager::registerTxChannel "
             << plugin->getPluginDescriptor().displayedName.toStdString().c_str()
             << " with channel name " << channelIdURI;
@@ -151,6 +193,10 @@ void PluginManager::registerTxChannel(const QString& channelIdURI, const QString
 
 void PluginManager::registerMIMOChannel(const QString& channelIdURI, const QString& channelId, PluginInterface* plugin)
 {
+    if (m_ignoreRegistrations) { // plugin already registered from manifest
+        return;
+    }
+
     qDebug() << "PluginManager::registerMIMOChannel "
             << plugin->getPluginDescriptor().displayedName.toStdString().c_str()
             << " with channel name " << channelIdURI;
@@ -160,6 +206,10 @@ void PluginManager::registerMIMOChannel(const QString& channelIdURI, const QStri
 
 void PluginManager::registerSampleSource(const QString& sourceName, PluginInterface* plugin)
 {
+    if (m_ignoreRegistrations) { // plugin already registered from manifest
+        return;
+    }
+
 	qDebug() << "PluginManager::registerSampleSource "
 			<< plugin->getPluginDescriptor().displayedName.toStdString().c_str()
 			<< " with source name " << sourceName.toStdString().c_str()
@@ -174,6 +224,10 @@ void PluginManager::registerSampleSource(const QString& sourceName, PluginInterf
 
 void PluginManager::registerSampleSink(const QString& sinkName, PluginInterface* plugin)
 {
+    if (m_ignoreRegistrations) { // plugin already registered from manifest
+        return;
+    }
+
 	qDebug() << "PluginManager::registerSampleSink "
 			<< plugin->getPluginDescriptor().displayedName.toStdString().c_str()
 			<< " with sink name " << sinkName.toStdString().c_str()
@@ -188,6 +242,10 @@ void PluginManager::registerSampleSink(const QString& sinkName, PluginInterface*
 
 void PluginManager::registerSampleMIMO(const QString& mimoName, PluginInterface* plugin)
 {
+    if (m_ignoreRegistrations) { // plugin already registered from manifest
+        return;
+    }
+
 	qDebug() << "PluginManager::registerSampleMIMO "
 			<< plugin->getPluginDescriptor().displayedName.toStdString().c_str()
 			<< " with MIMO name " << mimoName.toStdString().c_str()
@@ -202,6 +260,10 @@ void PluginManager::registerSampleMIMO(const QString& mimoName, PluginInterface*
 
 void PluginManager::registerFeature(const QString& featureIdURI, const QString& featureId, PluginInterface* plugin)
 {
+    if (m_ignoreRegistrations) { // plugin already registered from manifest
+        return;
+    }
+
     qDebug() << "PluginManager::registerFeature "
             << plugin->getPluginDescriptor().displayedName.toStdString().c_str()
             << " with channel name " << featureIdURI;
@@ -209,6 +271,14 @@ void PluginManager::registerFeature(const QString& featureIdURI, const QString&
 	m_featureRegistrations.append(PluginAPI::FeatureRegistration(featureIdURI, featureId, plugin));
 }
 
+void PluginManager::initLazyPlugin(PluginInterface *plugin)
+{
+    QMutexLocker mutexLocker(&m_lazyPluginMutex);
+    m_ignoreRegistrations = true;
+    plugin->initPlugin(&m_pluginAPI);
+    m_ignoreRegistrations = false;
+}
+
 void PluginManager::loadPluginsDir(const QDir& dir)
 {
     QDir pluginsDir(dir);
@@ -224,6 +294,21 @@ void PluginManager::loadPluginsDir(const QDir& dir)
             }
 
             qDebug("PluginManager::loadPluginsDir: fileName: %s", qPrintable(fileName));
+            QFileInfo fileInfo(pluginsDir.absoluteFilePath(fileName));
+
+            if (m_lazyLoading)
+            {
+                const PluginManifest::Entry *entry = m_manifest.getValidEntry(fileInfo);
+
+                if (entry && !entry->isDevicePlugin())
+                {
+                    LazyPlugin *lazyPlugin = new LazyPlugin(this, fileInfo.absoluteFilePath(), *entry);
+                    m_lazyPlugins.append(lazyPlugin);
+                    m_plugins.append(Plugin(fileName, lazyPlugin));
+                    qDebug("PluginManager::loadPluginsDir: deferred plugin %s", qPrintable(fileName));
+                    continue;
+                }
+            }
 
             QPluginLoader* pluginLoader = new QPluginLoader(pluginsDir.absoluteFilePath(fileName));
             if (!pluginLoader->load())
@@ -245,10 +330,82 @@ void PluginManager::loadPluginsDir(const QDir& dir)
 
             qInfo("PluginManager::loadPluginsDir: loaded plugin %s", qPrintable(fileName));
             m_plugins.append(Plugin(fileName, instance));
+            m_loadedFileInfos.insert(instance, fileInfo);
        }
     }
 }
 
+void PluginManager::updateManifest()
+{
+    for (QMap<PluginInterface*, QFileInfo>::const_iterator it = m_loadedFileInfos.begin(); it != m_loadedFileInfos.end(); ++it)
+    {
+        PluginInterface *plugin = it.key();
+        const PluginDescriptor& descriptor = plugin->getPluginDescriptor();
+        PluginManifest::Entry entry;
+        entry.m_filePath = it.value().absoluteFilePath();
+        entry.m_fileSize = it.value().size();
+        entry.m_lastModified = it.value().lastModified();
+        entry.m_hardwareId = descriptor.hardwareId;
+        entry.m_displayedName = descriptor.displayedName;
+        entry.m_version = descriptor.version;
+        entry.m_copyright = descriptor.copyright;
+        entry.m_website = descriptor.website;
+        entry.m_licenseIsGPL = descriptor.licenseIsGPL;
+        entry.m_sourceCodeURL = descriptor.sourceCodeURL;
+
+        for (const auto& registration : m_rxChannelRegistrations)
+        {
+            if (registration.m_plugin == plugin) {
+                entry.m_rxChannels.append(PluginManifest::Registration(registration.m_channelIdURI, registration.m_channelId));
+            }
+        }
+        for (const auto& registration : m_txChannelRegistrations)
+        {
+            if (registration.m_plugin == plugin) {
+                entry.m_txChannels.append(PluginManifest::Registration(registration.m_channelIdURI, registration.m_channelId));
+            }
+        }
+        for (const auto& registration : m_mimoChannelRegistrations)
+        {
+            if (registration.m_plugin == plugin) {
+                entry.m_mimoChannels.append(PluginManifest::Registration(registration.m_channelIdURI, registration.m_channelId));
+            }
+        }
+        for (const auto& registration : m_featureRegistrations)
+        {
+            if (registration.m_plugin == plugin) {
+                entry.m_features.append(PluginManifest::Registration(registration.m_featureIdURI, registration.m_featureId));
+            }
+        }
+        for (const auto& registration : m_sampleSourceRegistrations)
+        {
+            if (registration.m_plugin == plugin) {
+                entry.m_sampleSources.append(registration.m_deviceId);
+            }
+        }
+        for (const auto& registration : m_sampleSinkRegistrations)
+        {
+            if (registration.m_plugin == plugin) {
+                entry.m_sampleSinks.append(registration.m_deviceId);
+            }
+        }
+        for (const auto& registration : m_sampleMIMORegistrations)
+        {
+            if (registration.m_plugin == plugin) {
+                entry.m_sampleMIMOs.append(registration.m_deviceId);
+            }
+        }
+
+        m_manifest.setEntry(entry);
+    }
+
+    m_loadedFileInfos.clear();
+
+    if (m_manifest.save()) {
+        qDebug("PluginManager::updateManifest: %d entries saved to %s", m_manifest.getNbEntries(), qPrintable(m_manifest.getFileName()));
+    }
+}
+
 void PluginManager::listTxChannels(QList<QString>& list)
 {
     list.clear();
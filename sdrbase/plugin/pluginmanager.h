@@ -19,13 +19,18 @@
 #define INCLUDE_PLUGINMANAGER_H
 
 #include <stdint.h>
+#include <atomic>
 #include <QObject>
 #include <QDir>
+#include <QFileInfo>
+#include <QMap>
 #include <QList>
 #include <QString>
+#include <QMutex>
 
 #include "plugin/plugininterface.h"
 #include "plugin/pluginapi.h"
+#include "plugin/pluginmanifest.h"
 #include "export.h"
 
 class QComboBox;
@@ -35,6 +40,7 @@ class MessageQueue;
 class DeviceAPI;
 struct DeviceUserArgs;
 class WebAPIAdapterInterface;
+class LazyPlugin;
 
 class SDRBASE_API PluginManager : public QObject {
 	Q_OBJECT
@@ -58,6 +64,8 @@ public:
 
 	PluginAPI *getPluginAPI() { return &m_pluginAPI; }
     void setEnableSoapy(bool enableSoapy) { m_enableSoapy = enableSoapy; }
+    void setLazyLoading(bool lazyLoading) { m_lazyLoading = lazyLoading; }
+    void setParallelEnumeration(bool parallelEnumeration) { m_parallelEnumeration = parallelEnumeration; }
 	void loadPlugins(const QString& pluginsSubDir);
 	void loadPluginsPart(const QString& pluginsSubDir);
 	void loadPluginsFinal();
@@ -72,6 +80,7 @@ public:
 	void registerSampleSink(const QString& sinkName, PluginInterface* plugin);
     void registerSampleMIMO(const QString& mimoName, PluginInterface* plugin);
 	void registerFeature(const QString& featureIdURI, const QString& featureId, PluginInterface* plugin);
+    void initLazyPlugin(PluginInterface *plugin); //!< Called by LazyPlugin when the actual plugin is loaded
 
 	PluginAPI::SamplingDeviceRegistrations& getSourceDeviceRegistrations() { return m_sampleSourceRegistrations; }
 	PluginAPI::SamplingDeviceRegistrations& getSinkDeviceRegistrations() { return m_sampleSinkRegistrations; }
@@ -126,6 +135,13 @@ private:
 	PluginAPI m_pluginAPI;
 	Plugins m_plugins;
     bool m_enableSoapy;
+    bool m_lazyLoading;               //!< Do not load channel and feature plugins found in manifest until they are used
+    bool m_parallelEnumeration;       //!< Enumerate origin devices of each hardware type in parallel (opt-in)
+    PluginManifest m_manifest;
+    QList<LazyPlugin*> m_lazyPlugins;
+    QMap<PluginInterface*, QFileInfo> m_loadedFileInfos; //!< Libraries loaded at startup for manifest update
+    std::atomic<bool> m_ignoreRegistrations; //!< Set while a lazy plugin is initialized possibly from another thread
+    QMutex m_lazyPluginMutex;
 
 	PluginAPI::ChannelRegistrations m_rxChannelRegistrations;           //!< Channel plugins register here
 	PluginAPI::ChannelRegistrations m_txChannelRegistrations;           //!< Channel plugins register here
@@ -158,6 +174,7 @@ private:
     static const QString m_testMIMODeviceTypeID;     //!< Test MIMO plugin ID
 
 	void loadPluginsDir(const QDir& dir);
+    void updateManifest();
 };
 
 static inline bool operator<(const PluginManager::Plugin& a, const PluginManager::Plugin& b)
@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCoreApplication>
+#include <QStandardPaths>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDebug>
+
+#include "plugin/pluginmanifest.h"
+
+static QJsonArray registrationsToJson(const PluginManifest::Registrations& registrations)
+{
+    QJsonArray array;
+
+    for (const auto& registration : registrations)
+    {
+        QJsonObject object;
+        object.insert("uri", registration.m_idURI);
+        object.insert("id", registration.m_id);
+        array.append(object);
+    }
+
+    return array;
+}
+
+static PluginManifest::Registrations registrationsFromJson(const QJsonArray& array)
+{
+    PluginManifest::Registrations registrations;
+
+    for (const auto& value : array)
+    {
+        QJsonObject object = value.toObject();
+        registrations.append(PluginManifest::Registration(object.value("uri").toString(), object.value("id").toString()));
+    }
+
+    return registrations;
+}
+
+static QJsonArray stringListToJson(const QStringList& list)
+{
+    QJsonArray array;
+
+    for (const auto& s : list) {
+        array.append(s);
+    }
+
+    return array;
+}
+
+static QStringList stringListFromJson(const QJsonArray& array)
+{
+    QStringList list;
+
+    for (const auto& value : array) {
+        list.append(value.toString());
+    }
+
+    return list;
+}
+
+PluginManifest::PluginManifest() :
+    m_applicationVersion(QCoreApplication::applicationVersion())
+{}
+
+PluginManifest::~PluginManifest()
+{}
+
+QString PluginManifest::getDefaultFileName(const QString& pluginsSubDir)
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return QString("%1/%2-manifest.json").arg(dir).arg(pluginsSubDir);
+}
+
+bool PluginManifest::load()
+{
+    m_entries.clear();
+    QFile file(m_fileName);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug("PluginManifest::load: no manifest in %s", qPrintable(m_fileName));
+        return false;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+
+    if (doc.isNull() || !doc.isObject())
+    {
+        qWarning("PluginManifest::load: %s: %s", qPrintable(m_fileName), qPrintable(error.errorString()));
+        return false;
+    }
+
+    QJsonObject root = doc.object();
+
+    if (root.value("applicationVersion").toString() != m_applicationVersion)
+    {
+        qInfo("PluginManifest::load: manifest was made by version %s - ignored",
+            qPrintable(root.value("applicationVersion").toString()));
+        return false;
+    }
+
+    QJsonArray plugins = root.value("plugins").toArray();
+
+    for (const auto& value : plugins)
+    {
+        QJsonObject object = value.toObject();
+        Entry entry;
+        entry.m_filePath = object.value("filePath").toString();
+        entry.m_fileSize = object.value("fileSize").toVariant().toLongLong();
+        entry.m_lastModified = QDateTime::fromMSecsSinceEpoch(object.value("lastModified").toVariant().toLongLong());
+        entry.m_hardwareId = object.value("hardwareId").toString();
+        entry.m_displayedName = object.value("displayedName").toString();
+        entry.m_version = object.value("version").toString();
+        entry.m_copyright = object.value("copyright").toString();
+        entry.m_website = object.value("website").toString();
+        entry.m_licenseIsGPL = object.value("licenseIsGPL").toBool();
+        entry.m_sourceCodeURL = object.value("sourceCodeURL").toString();
+        entry.m_rxChannels = registrationsFromJson(object.value("rxChannels").toArray());
+        entry.m_txChannels = registrationsFromJson(object.value("txChannels").toArray());
+        entry.m_mimoChannels = registrationsFromJson(object.value("mimoChannels").toArray());
+        entry.m_features = registrationsFromJson(object.value("features").toArray());
+        entry.m_sampleSources = stringListFromJson(object.value("sampleSources").toArray());
+        entry.m_sampleSinks = stringListFromJson(object.value("sampleSinks").toArray());
+        entry.m_sampleMIMOs = stringListFromJson(object.value("sampleMIMOs").toArray());
+        m_entries.insert(getKey(entry.m_filePath, entry.m_fileSize, entry.m_lastModified), entry);
+    }
+
+    qDebug("PluginManifest::load: %d entries from %s", m_entries.size(), qPrintable(m_fileName));
+    return true;
+}
+
+bool PluginManifest::save() const
+{
+    QJsonArray plugins;
+
+    for (const auto& entry : m_entries)
+    {
+        QJsonObject object;
+        object.insert("filePath", entry.m_filePath);
+        object.insert("fileSize", entry.m_fileSize);
+        object.insert("lastModified", entry.m_lastModified.toMSecsSinceEpoch());
+        object.insert("hardwareId", entry.m_hardwareId);
+        object.insert("displayedName", entry.m_displayedName);
+        object.insert("version", entry.m_version);
+        object.insert("copyright", entry.m_copyright);
+        object.insert("website", entry.m_website);
+        object.insert("licenseIsGPL", entry.m_licenseIsGPL);
+        object.insert("sourceCodeURL", entry.m_sourceCodeURL);
+        object.insert("rxChannels", registrationsToJson(entry.m_rxChannels));
+        object.insert("txChannels", registrationsToJson(entry.m_txChannels));
+        object.insert("mimoChannels", registrationsToJson(entry.m_mimoChannels));
+        object.insert("features", registrationsToJson(entry.m_features));
+        object.insert("sampleSources", stringListToJson(entry.m_sampleSources));
+        object.insert("sampleSinks", stringListToJson(entry.m_sampleSinks));
+        object.insert("sampleMIMOs", stringListToJson(entry.m_sampleMIMOs));
+        plugins.append(object);
+    }
+
+    QJsonObject root;
+    root.insert("applicationVersion", m_applicationVersion);
+    root.insert("plugins", plugins);
+
+    QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+    QFile file(m_fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning("PluginManifest::save: cannot write %s", qPrintable(m_fileName));
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+QString PluginManifest::getKey(const QString& filePath, qint64 fileSize, const QDateTime& lastModified)
+{
+    return QString("%1|%2|%3").arg(filePath, QString::number(fileSize), QString::number(lastModified.toMSecsSinceEpoch()));
+}
+
+const PluginManifest::Entry *PluginManifest::getValidEntry(const QFileInfo& fileInfo) const
+{
+    auto it = m_entries.find(getKey(fileInfo.absoluteFilePath(), fileInfo.size(), fileInfo.lastModified()));
+
+    if (it == m_entries.end()) {
+        return nullptr;
+    }
+
+    return &(*it);
+}
+
+void PluginManifest::setEntry(const Entry& entry)
+{
+    removeEntry(entry.m_filePath);
+    m_entries.insert(getKey(entry.m_filePath, entry.m_fileSize, entry.m_lastModified), entry);
+}
+
+void PluginManifest::removeEntry(const QString& filePath)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (it->m_filePath == filePath) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_PLUGINMANIFEST_H
+#define INCLUDE_PLUGINMANIFEST_H
+
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+
+#include "export.h"
+
+class QFileInfo;
+
+/**
+ * Cache of what each plugin library registers when it is initialized. This allows
+ * channel and feature plugins to be registered without loading their library
+ * (see LazyPlugin). Entries are keyed by library path, size and modification time
+ * so that a rebuilt or moved library is not served stale registrations. The whole
+ * manifest is invalidated when the application version changes.
+ */
+class SDRBASE_API PluginManifest
+{
+public:
+    struct Registration
+    {
+        QString m_idURI; //!< Channel or feature type ID in URI form or device ID
+        QString m_id;    //!< Channel or feature type ID in short form or empty for devices
+
+        Registration() = default;
+        Registration(const QString& idURI, const QString& id) :
+            m_idURI(idURI),
+            m_id(id)
+        {}
+    };
+
+    typedef QList<Registration> Registrations;
+
+    struct Entry
+    {
+        QString m_filePath;         //!< Absolute path of the library
+        qint64 m_fileSize;
+        QDateTime m_lastModified;
+        // descriptor
+        QString m_hardwareId;
+        QString m_displayedName;
+        QString m_version;
+        QString m_copyright;
+        QString m_website;
+        bool m_licenseIsGPL;
+        QString m_sourceCodeURL;
+        // registrations
+        Registrations m_rxChannels;
+        Registrations m_txChannels;
+        Registrations m_mimoChannels;
+        Registrations m_features;
+        QStringList m_sampleSources;
+        QStringList m_sampleSinks;
+        QStringList m_sampleMIMOs;
+
+        Entry() :
+            m_fileSize(0),
+            m_licenseIsGPL(true)
+        {}
+
+        //!< Device plugins must be loaded at startup as they take part in device enumeration
+        bool isDevicePlugin() const {
+            return (m_sampleSources.size() + m_sampleSinks.size() + m_sampleMIMOs.size()) != 0;
+        }
+    };
+
+    PluginManifest();
+    ~PluginManifest();
+
+    void setFileName(const QString& fileName) { m_fileName = fileName; }
+    const QString& getFileName() const { return m_fileName; }
+    bool load();
+    bool save() const;
+    void clear() { m_entries.clear(); }
+
+    //!< Returns the cached entry for the library if it is still valid else nullptr
+    const Entry *getValidEntry(const QFileInfo& fileInfo) const;
+    void setEntry(const Entry& entry); //!< Replaces any entry of the same library
+    void removeEntry(const QString& filePath);
+    int getNbEntries() const { return m_entries.size(); }
+
+    static QString getDefaultFileName(const QString& pluginsSubDir);
+    static QString getKey(const QString& filePath, qint64 fileSize, const QDateTime& lastModified);
+
+private:
+    QString m_fileName;
+    QString m_applicationVersion;
+    QMap<QString, Entry> m_entries; //!< Keyed by getKey()
+};
+
+#endif // INCLUDE_PLUGINMANIFEST_H
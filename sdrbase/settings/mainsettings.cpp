@@ -1,5 +1,8 @@
 #include <QSettings>
 #include <QStringList>
+#include <QSet>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
 #include <QDebug>
 
 #include <algorithm>
@@ -59,6 +62,9 @@ void MainSettings::load()
 	}
 
 	QStringList groups = s.childGroups();
+    QElapsedTimer timer;
+    timer.start();
+    int nbLazyPresets = 0;
 
 	for (int i = 0; i < groups.size(); ++i)
 	{
@@ -67,9 +73,23 @@ void MainSettings::load()
 			s.beginGroup(groups[i]);
 			Preset* preset = new Preset;
 
-			if (preset->deserialize(qUncompress(QByteArray::fromBase64(s.value("data").toByteArray()))))
+            if (s.contains("group")) // indexed: defer deserialization until the preset is used
+            {
+                preset->setIndex(
+                    s.value("group").toString(),
+                    s.value("description").toString(),
+                    s.value("centerFrequency").toULongLong(),
+                    (Preset::PresetType) s.value("type").toInt()
+                );
+                preset->setPendingData(s.value("data").toByteArray());
+                m_presets.append(preset);
+                m_storedPresets.insert(preset, StoredBlob{groups[i], QByteArray()});
+                nbLazyPresets++;
+            }
+			else if (preset->deserialize(qUncompress(QByteArray::fromBase64(s.value("data").toByteArray()))))
 			{
 				m_presets.append(preset);
+                m_storedPresets.insert(preset, StoredBlob{groups[i], QByteArray()}); // rewrite with index
 			}
 			else
 			{
@@ -82,10 +102,12 @@ void MainSettings::load()
         {
             s.beginGroup(groups[i]);
             Command* command = new Command;
+            QByteArray data = qUncompress(QByteArray::fromBase64(s.value("data").toByteArray()));
 
-            if (command->deserialize(qUncompress(QByteArray::fromBase64(s.value("data").toByteArray()))))
+            if (command->deserialize(data))
             {
                 m_commands.append(command);
+                m_storedCommands.insert(command, StoredBlob{groups[i], QCryptographicHash::hash(data, QCryptographicHash::Md5)});
             }
             else
             {
@@ -98,10 +120,12 @@ void MainSettings::load()
         {
             s.beginGroup(groups[i]);
             FeatureSetPreset* featureSetPreset = new FeatureSetPreset;
+            QByteArray data = qUncompress(QByteArray::fromBase64(s.value("data").toByteArray()));
 
-            if (featureSetPreset->deserialize(qUncompress(QByteArray::fromBase64(s.value("data").toByteArray()))))
+            if (featureSetPreset->deserialize(data))
             {
                 m_featureSetPresets.append(featureSetPreset);
+                m_storedFeatureSetPresets.insert(featureSetPreset, StoredBlob{groups[i], QCryptographicHash::hash(data, QCryptographicHash::Md5)});
             }
             else
             {
@@ -114,10 +138,12 @@ void MainSettings::load()
         {
             s.beginGroup(groups[i]);
             Configuration* configuration = new Configuration;
+            QByteArray data = qUncompress(QByteArray::fromBase64(s.value("data").toByteArray()));
 
-            if (configuration->deserialize(qUncompress(QByteArray::fromBase64(s.value("data").toByteArray()))))
+            if (configuration->deserialize(data))
             {
                 m_configurations.append(configuration);
+                m_storedConfigurations.insert(configuration, StoredBlob{groups[i], QCryptographicHash::hash(data, QCryptographicHash::Md5)});
             }
             else
             {
@@ -128,62 +154,164 @@ void MainSettings::load()
         }
 	}
 
+    qInfo("MainSettings::load: %d presets (%d deferred) %d commands %d feature set presets %d configurations in %lld ms",
+        m_presets.size(), nbLazyPresets, m_commands.size(), m_featureSetPresets.size(), m_configurations.size(), timer.elapsed());
+
     m_hardwareDeviceUserArgs.deserialize(qUncompress(QByteArray::fromBase64(s.value("hwDeviceUserArgs").toByteArray())));
 }
 
-void MainSettings::save() const
+// Lazily loaded presets that were not accessed cannot have changed
+static bool isItemLoaded(const Preset *preset) { return preset->isLoaded(); }
+template <class T> static bool isItemLoaded(const T*) { return true; }
+
+static QByteArray getItemLoadedDigest(const Preset *preset) { return preset->getLoadedDigest(); }
+template <class T> static QByteArray getItemLoadedDigest(const T*) { return QByteArray(); }
+
+// Stored blob of a preset that failed to deserialize. It is saved back untouched so that user data is not lost.
+static QByteArray getItemFailedData(const Preset *preset) { return preset->getFailedData(); }
+template <class T> static QByteArray getItemFailedData(const T*) { return QByteArray(); }
+
+// Presets index is stored next to the blob so that presets can be listed without deserializing them
+static void writeItemIndex(QSettings& s, const Preset *preset)
 {
-	QSettings s;
+    s.setValue("group", preset->getGroup());
+    s.setValue("description", preset->getDescription());
+    s.setValue("centerFrequency", preset->getCenterFrequency());
+    s.setValue("type", (int) preset->getPresetType());
+}
+template <class T> static void writeItemIndex(QSettings&, const T*) {}
 
-	s.setValue("preferences", qCompress(m_preferences.serialize()).toBase64());
-    s.setValue("current-configuration", qCompress(m_workingConfiguration.serialize()).toBase64());
+template <class T>
+static void writeEncodedItem(QSettings& s, const QString& group, const T *item, const QByteArray& base64Data)
+{
+    s.beginGroup(group);
+    s.setValue("data", base64Data);
+    writeItemIndex(s, item);
+    s.endGroup();
+}
 
-	if (m_audioDeviceManager) {
-	    s.setValue("audio", qCompress(m_audioDeviceManager->serialize()).toBase64());
-	}
+template <class T>
+static void writeItem(QSettings& s, const QString& group, const T *item, const QByteArray& data)
+{
+    writeEncodedItem(s, group, item, qCompress(data).toBase64());
+}
 
-	QStringList groups = s.childGroups();
+template <class T>
+static int saveBlobs(QSettings& s, const QString& prefix, const QList<T*>& items, MainSettings::StoredBlobs& storedBlobs)
+{
+    QSet<QString> existingGroups;
+    QSet<QString> usedGroups;
+    MainSettings::StoredBlobs updatedBlobs;
+    QList<const T*> newItems;
+    int nbWritten = 0;
 
-	for(int i = 0; i < groups.size(); ++i)
-	{
-		if ((groups[i].startsWith("preset")) || (groups[i].startsWith("command")))
-		{
-			s.remove(groups[i]);
-		}
-	}
+    for (const auto& group : s.childGroups())
+    {
+        if (group.startsWith(prefix + "-")) {
+            existingGroups.insert(group);
+        }
+    }
 
-	for (int i = 0; i < m_presets.count(); ++i)
-	{
-		QString group = QString("preset-%1").arg(i + 1);
-		s.beginGroup(group);
-		s.setValue("data", qCompress(m_presets[i]->serialize()).toBase64());
-		s.endGroup();
-	}
+    // Items already in storage keep their group and are written only if they changed
+    for (const auto item : items)
+    {
+        auto it = storedBlobs.find(item);
+
+        if ((it == storedBlobs.end()) || !existingGroups.contains(it->m_group) || usedGroups.contains(it->m_group))
+        {
+            newItems.append(item);
+            continue;
+        }
 
-    for (int i = 0; i < m_commands.count(); ++i)
+        MainSettings::StoredBlob storedBlob = *it;
+        usedGroups.insert(storedBlob.m_group);
+        QByteArray failedData = getItemFailedData(item);
+
+        if (!failedData.isEmpty())
+        {
+            // Index may have been changed (e.g. renamed)
+            writeEncodedItem(s, storedBlob.m_group, item, failedData);
+            nbWritten++;
+        }
+        else if (isItemLoaded(item))
+        {
+            QByteArray data = item->serialize();
+            QByteArray digest = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+
+            if (storedBlob.m_digest.isEmpty()) {
+                storedBlob.m_digest = getItemLoadedDigest(item);
+            }
+
+            if (digest != storedBlob.m_digest)
+            {
+                writeItem(s, storedBlob.m_group, item, data);
+                storedBlob.m_digest = digest;
+                nbWritten++;
+            }
+        }
+
+        updatedBlobs.insert(item, storedBlob);
+    }
+
+    int groupIndex = 1;
+
+    for (const auto item : newItems)
     {
-        QString group = QString("command-%1").arg(i + 1);
-        s.beginGroup(group);
-        s.setValue("data", qCompress(m_commands[i]->serialize()).toBase64());
-        s.endGroup();
+        QString group;
+
+        do {
+            group = QString("%1-%2").arg(prefix).arg(groupIndex++);
+        } while (usedGroups.contains(group));
+
+        QByteArray failedData = getItemFailedData(item);
+
+        if (!failedData.isEmpty())
+        {
+            writeEncodedItem(s, group, item, failedData);
+            updatedBlobs.insert(item, MainSettings::StoredBlob{group, QByteArray()});
+        }
+        else
+        {
+            QByteArray data = item->serialize();
+            writeItem(s, group, item, data);
+            updatedBlobs.insert(item, MainSettings::StoredBlob{group, QCryptographicHash::hash(data, QCryptographicHash::Md5)});
+        }
+
+        usedGroups.insert(group);
+        nbWritten++;
     }
 
-	for (int i = 0; i < m_featureSetPresets.count(); ++i)
-	{
-		QString group = QString("featureset-%1").arg(i + 1);
-		s.beginGroup(group);
-		s.setValue("data", qCompress(m_featureSetPresets[i]->serialize()).toBase64());
-		s.endGroup();
-	}
+    for (const auto& group : existingGroups)
+    {
+        if (!usedGroups.contains(group)) {
+            s.remove(group);
+        }
+    }
 
-	for (int i = 0; i < m_configurations.count(); ++i)
-	{
-		QString group = QString("configuration-%1").arg(i + 1);
-		s.beginGroup(group);
-		s.setValue("data", qCompress(m_configurations[i]->serialize()).toBase64());
-		s.endGroup();
+    storedBlobs = updatedBlobs;
+    return nbWritten;
+}
+
+void MainSettings::save() const
+{
+	QSettings s;
+
+	s.setValue("preferences", qCompress(m_preferences.serialize()).toBase64());
+    s.setValue("current-configuration", qCompress(m_workingConfiguration.serialize()).toBase64());
+
+	if (m_audioDeviceManager) {
+	    s.setValue("audio", qCompress(m_audioDeviceManager->serialize()).toBase64());
 	}
 
+    QElapsedTimer timer;
+    timer.start();
+    int nbWritten = 0;
+    nbWritten += saveBlobs(s, "preset", m_presets, m_storedPresets);
+    nbWritten += saveBlobs(s, "command", m_commands, m_storedCommands);
+    nbWritten += saveBlobs(s, "featureset", m_featureSetPresets, m_storedFeatureSetPresets);
+    nbWritten += saveBlobs(s, "configuration", m_configurations, m_storedConfigurations);
+    qDebug("MainSettings::save: %d items written in %lld ms", nbWritten, timer.elapsed());
+
     s.setValue("hwDeviceUserArgs", qCompress(m_hardwareDeviceUserArgs.serialize()).toBase64());
 }
 
@@ -223,6 +351,7 @@ void MainSettings::addPreset(Preset *preset)
 void MainSettings::deletePreset(const Preset* preset)
 {
 	m_presets.removeAll((Preset*)preset);
+    m_storedPresets.remove(preset);
 	delete (Preset*)preset;
 }
 
@@ -299,6 +428,7 @@ void MainSettings::clearPresets()
     }
 
     m_presets.clear();
+    m_storedPresets.clear();
 }
 
 // Commands
@@ -311,6 +441,7 @@ void MainSettings::addCommand(Command *command)
 void MainSettings::deleteCommand(const Command* command)
 {
     m_commands.removeAll((Command*)command);
+    m_storedCommands.remove(command);
     delete (Command*)command;
 }
 
@@ -370,6 +501,7 @@ void MainSettings::clearCommands()
     }
 
     m_commands.clear();
+    m_storedCommands.clear();
 }
 
 // FeatureSet presets
@@ -391,6 +523,7 @@ void MainSettings::addFeatureSetPreset(FeatureSetPreset *preset)
 void MainSettings::deleteFeatureSetPreset(const FeatureSetPreset* preset)
 {
 	m_featureSetPresets.removeAll((FeatureSetPreset*) preset);
+    m_storedFeatureSetPresets.remove(preset);
 	delete (FeatureSetPreset*) preset;
 }
 
@@ -450,6 +583,7 @@ void MainSettings::clearFeatureSetPresets()
     }
 
     m_featureSetPresets.clear();
+    m_storedFeatureSetPresets.clear();
 }
 
 // Configurations
@@ -471,6 +605,7 @@ void MainSettings::addConfiguration(Configuration *configuration)
 void MainSettings::deleteConfiguration(const Configuration *configuration)
 {
 	m_configurations.removeAll((Configuration*) configuration);
+    m_storedConfigurations.remove(configuration);
 	delete (Configuration*) configuration;
 }
 
@@ -540,4 +675,5 @@ void MainSettings::clearConfigurations()
     }
 
     m_configurations.clear();
+    m_storedConfigurations.clear();
 }
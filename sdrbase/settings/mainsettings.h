@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QString>
+#include <QHash>
 #include "device/deviceuserargs.h"
 #include "preferences.h"
 #include "preset.h"
@@ -208,6 +209,21 @@ protected:
     typedef QList<Configuration*> Configurations;
     Configurations m_configurations;
 	DeviceUserArgs m_hardwareDeviceUserArgs;
+
+public:
+    struct StoredBlob //!< Where and what an item was last saved as
+    {
+        QString m_group;      //!< Settings group of the item
+        QByteArray m_digest;  //!< Digest of the serialized item or empty if it has to be written
+    };
+    typedef QHash<const void*, StoredBlob> StoredBlobs;
+
+protected:
+    // Items are saved only when they changed since they were last loaded or saved
+    mutable StoredBlobs m_storedPresets;
+    mutable StoredBlobs m_storedCommands;
+    mutable StoredBlobs m_storedFeatureSetPresets;
+    mutable StoredBlobs m_storedConfigurations;
 };
 
 #endif // INCLUDE_SETTINGS_H
@@ -20,6 +20,7 @@
 #include "util/simpleserializer.h"
 #include "settings/preset.h"
 
+#include <QCryptographicHash>
 #include <QDebug>
 
 Preset::Preset()
@@ -37,7 +38,10 @@ Preset::Preset(const Preset& other) :
 	m_channelConfigs(other.m_channelConfigs),
 	m_deviceConfigs(other.m_deviceConfigs),
 	m_showSpectrum(other.m_showSpectrum),
-	m_layout(other.m_layout)
+	m_layout(other.m_layout),
+	m_pendingData(other.m_pendingData),
+	m_loadedDigest(other.m_loadedDigest),
+	m_failedData(other.m_failedData)
 {}
 
 void Preset::resetToDefaults()
@@ -52,10 +56,74 @@ void Preset::resetToDefaults()
 	m_dcOffsetCorrection = false;
 	m_iqImbalanceCorrection = false;
 	m_showSpectrum = true;
+	m_pendingData.clear();
+	m_loadedDigest.clear();
+}
+
+void Preset::setIndex(const QString& group, const QString& description, quint64 centerFrequency, PresetType presetType)
+{
+    m_group = group;
+    m_description = description;
+    m_centerFrequency = centerFrequency;
+    m_presetType = presetType;
+}
+
+void Preset::materialize() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_pendingData.isEmpty()) {
+        return;
+    }
+
+    // Deserializing does not change the logical value of the preset
+    Preset *preset = const_cast<Preset*>(this);
+    QByteArray data = qUncompress(QByteArray::fromBase64(m_pendingData));
+    SimpleDeserializer d(data);
+
+    if (!d.isValid() || (d.getVersion() != 1))
+    {
+        // Contents stay at their defaults and the stored blob is kept to be saved back as is
+        qWarning("Preset::materialize: cannot deserialize preset %s in group %s: stored data kept unchanged",
+            qPrintable(m_description), qPrintable(m_group));
+        preset->m_failedData = m_pendingData;
+        preset->m_pendingData.clear();
+        return;
+    }
+
+    preset->deserialize(data);
+    preset->m_loadedDigest = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+}
+
+void Preset::modify()
+{
+    materialize();
+    QMutexLocker mutexLocker(&m_mutex);
+    m_failedData.clear();
+}
+
+bool Preset::isLoaded() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_pendingData.isEmpty();
+}
+
+QByteArray Preset::getLoadedDigest() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_loadedDigest;
+}
+
+QByteArray Preset::getFailedData() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_failedData;
 }
 
 QByteArray Preset::serialize() const
 {
+    materialize();
+
 //	qDebug("Preset::serialize: m_group: %s mode: %s m_description: %s m_centerFrequency: %llu",
 //			qPrintable(m_group),
 //			m_sourcePreset ? "Rx" : "Tx",
@@ -118,6 +186,9 @@ QByteArray Preset::serialize() const
 bool Preset::deserialize(const QByteArray& data)
 {
 	SimpleDeserializer d(data);
+	m_pendingData.clear();
+	m_loadedDigest.clear();
+	m_failedData.clear();
 
 	if (!d.isValid())
 	{
@@ -222,6 +293,7 @@ void Preset::addOrUpdateDeviceConfig(const QString& sourceId,
 		int sourceSequence,
 		const QByteArray& config)
 {
+    modify();
 	DeviceConfigs::iterator it = m_deviceConfigs.begin();
 
 	for (; it != m_deviceConfigs.end(); ++it)
@@ -260,6 +332,7 @@ const QByteArray* Preset::findDeviceConfig(
         const QString& deviceSerial,
         int deviceSequence) const
 {
+    materialize();
     DeviceConfigs::const_iterator it = m_deviceConfigs.begin();
 
     for (; it != m_deviceConfigs.end(); ++it)
@@ -277,6 +350,8 @@ const QByteArray* Preset::findBestDeviceConfig(
 		const QString& deviceSerial,
 		int deviceSequence) const
 {
+    materialize();
+
 	// Special case for SoapySDR based on serial (driver name)
 	if (deviceId == "sdrangel.samplesource.soapysdrinput") {
 		return findBestDeviceConfigSoapy(deviceId, deviceSerial);
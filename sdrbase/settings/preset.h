@@ -21,6 +21,7 @@
 
 #include <QString>
 #include <QList>
+#include <QMutex>
 #include <QMetaType>
 
 #include "export.h"
@@ -81,60 +82,68 @@ public:
 
 	void resetToDefaults();
 
-	void setSourcePreset() { m_presetType = PresetSource; }
+	void setSourcePreset() { modify(); m_presetType = PresetSource; }
 	bool isSourcePreset() const { return m_presetType == PresetSource; }
-	void setSinkPreset() { m_presetType = PresetSink; }
+	void setSinkPreset() { modify(); m_presetType = PresetSink; }
 	bool isSinkPreset() const { return m_presetType == PresetSink; }
-	void setMIMOPreset() { m_presetType = PresetMIMO; }
+	void setMIMOPreset() { modify(); m_presetType = PresetMIMO; }
 	bool isMIMOPreset() const { return m_presetType == PresetMIMO; }
     PresetType getPresetType() const { return m_presetType; }
-    void setPresetType(PresetType presetType) { m_presetType = presetType; }
+    void setPresetType(PresetType presetType) { modify(); m_presetType = presetType; }
     static QString getPresetTypeChar(PresetType presetType);
 
 	QByteArray serialize() const;
 	bool deserialize(const QByteArray& data);
 
-	void setGroup(const QString& group) { m_group = group; }
+    // Lazy loading: only the index (group, description, center frequency and type) is set
+    // and the rest is deserialized from the stored blob when it is first accessed
+    void setIndex(const QString& group, const QString& description, quint64 centerFrequency, PresetType presetType);
+    void setPendingData(const QByteArray& base64Data) { m_pendingData = base64Data; }
+    bool isLoaded() const;
+    QByteArray getLoadedDigest() const; //!< Digest of data when loaded from storage
+    QByteArray getFailedData() const;   //!< Stored blob that could not be deserialized, empty if none
+
+	void setGroup(const QString& group) { materialize(); m_group = group; }
 	const QString& getGroup() const { return m_group; }
-	void setDescription(const QString& description) { m_description = description; }
+	void setDescription(const QString& description) { materialize(); m_description = description; }
 	const QString& getDescription() const { return m_description; }
-	void setCenterFrequency(const quint64 centerFrequency) { m_centerFrequency = centerFrequency; }
+	void setCenterFrequency(const quint64 centerFrequency) { materialize(); m_centerFrequency = centerFrequency; }
 	quint64 getCenterFrequency() const { return m_centerFrequency; }
 
-	void setSpectrumConfig(const QByteArray& data) { m_spectrumConfig = data; }
-	const QByteArray& getSpectrumConfig() const { return m_spectrumConfig; }
-    void setSpectrumGeometry(const QByteArray& data) { m_spectrumGeometry = data; }
-	const QByteArray& getSpectrumGeometry() const { return m_spectrumGeometry; }
-    void setSpectrumWorkspaceIndex(int workspaceIndex) { m_spectrumWorkspaceIndex = workspaceIndex; }
-	int getSpectrumWorkspaceIndex() const { return m_spectrumWorkspaceIndex; }
-    void setSelectedDevice(const SelectedDevice& selectedDevice) { m_selectedDevice = selectedDevice; }
-    SelectedDevice getSelectedDevice() const { return m_selectedDevice; }
-    void setDeviceGeometry(const QByteArray& data) { m_deviceGeometry = data; }
-	const QByteArray& getDeviceGeometry() const { return m_deviceGeometry; }
-    void setDeviceWorkspaceIndex(int workspaceIndex) { m_deviceWorkspaceIndex = workspaceIndex; }
-	int getDeviceWorkspaceIndex() const { return m_deviceWorkspaceIndex; }
-
-	bool hasDCOffsetCorrection() const { return m_dcOffsetCorrection; }
-    void setDCOffsetCorrection(bool dcOffsetCorrection) { m_dcOffsetCorrection = dcOffsetCorrection; }
-	bool hasIQImbalanceCorrection() const { return m_iqImbalanceCorrection; }
-    void setIQImbalanceCorrection(bool iqImbalanceCorrection) { m_iqImbalanceCorrection = iqImbalanceCorrection; }
-
-	void setShowSpectrum(bool show) { m_showSpectrum = show; }
-	bool getShowSpectrum() const { return m_showSpectrum; }
-	void setLayout(const QByteArray& data) { m_layout = data; }
-	const QByteArray& getLayout() const { return m_layout; }
-
-	void clearChannels() { m_channelConfigs.clear(); }
-	void addChannel(const QString& channel, const QByteArray& config) { m_channelConfigs.append(ChannelConfig(channel, config)); }
-	int getChannelCount() const { return m_channelConfigs.count(); }
-	const ChannelConfig& getChannelConfig(int index) const { return m_channelConfigs.at(index); }
-
-    void clearDevices() { m_deviceConfigs.clear(); }
+	void setSpectrumConfig(const QByteArray& data) { modify(); m_spectrumConfig = data; }
+	const QByteArray& getSpectrumConfig() const { materialize(); return m_spectrumConfig; }
+    void setSpectrumGeometry(const QByteArray& data) { modify(); m_spectrumGeometry = data; }
+	const QByteArray& getSpectrumGeometry() const { materialize(); return m_spectrumGeometry; }
+    void setSpectrumWorkspaceIndex(int workspaceIndex) { modify(); m_spectrumWorkspaceIndex = workspaceIndex; }
+	int getSpectrumWorkspaceIndex() const { materialize(); return m_spectrumWorkspaceIndex; }
+    void setSelectedDevice(const SelectedDevice& selectedDevice) { modify(); m_selectedDevice = selectedDevice; }
+    SelectedDevice getSelectedDevice() const { materialize(); return m_selectedDevice; }
+    void setDeviceGeometry(const QByteArray& data) { modify(); m_deviceGeometry = data; }
+	const QByteArray& getDeviceGeometry() const { materialize(); return m_deviceGeometry; }
+    void setDeviceWorkspaceIndex(int workspaceIndex) { modify(); m_deviceWorkspaceIndex = workspaceIndex; }
+	int getDeviceWorkspaceIndex() const { materialize(); return m_deviceWorkspaceIndex; }
+
+	bool hasDCOffsetCorrection() const { materialize(); return m_dcOffsetCorrection; }
+    void setDCOffsetCorrection(bool dcOffsetCorrection) { modify(); m_dcOffsetCorrection = dcOffsetCorrection; }
+	bool hasIQImbalanceCorrection() const { materialize(); return m_iqImbalanceCorrection; }
+    void setIQImbalanceCorrection(bool iqImbalanceCorrection) { modify(); m_iqImbalanceCorrection = iqImbalanceCorrection; }
+
+	void setShowSpectrum(bool show) { modify(); m_showSpectrum = show; }
+	bool getShowSpectrum() const { materialize(); return m_showSpectrum; }
+	void setLayout(const QByteArray& data) { modify(); m_layout = data; }
+	const QByteArray& getLayout() const { materialize(); return m_layout; }
+
+	void clearChannels() { modify(); m_channelConfigs.clear(); }
+	void addChannel(const QString& channel, const QByteArray& config) { modify(); m_channelConfigs.append(ChannelConfig(channel, config)); }
+	int getChannelCount() const { materialize(); return m_channelConfigs.count(); }
+	const ChannelConfig& getChannelConfig(int index) const { materialize(); return m_channelConfigs.at(index); }
+
+    void clearDevices() { modify(); m_deviceConfigs.clear(); }
 	void setDeviceConfig(const QString& deviceId, const QString& deviceSerial, int deviceSequence, const QByteArray& config) {
 		addOrUpdateDeviceConfig(deviceId, deviceSerial, deviceSequence, config);
 	}
-    int getDeviceCount() const { return m_deviceConfigs.count(); }
-    const DeviceConfig& getDeviceConfig(int index) const { return m_deviceConfigs.at(index); }
+    int getDeviceCount() const { materialize(); return m_deviceConfigs.count(); }
+    const DeviceConfig& getDeviceConfig(int index) const { materialize(); return m_deviceConfigs.at(index); }
 
 	void addOrUpdateDeviceConfig(const QString& deviceId,
 			const QString& deviceSerial,
@@ -197,7 +206,15 @@ protected:
 	bool m_showSpectrum;
 	QByteArray m_layout;
 
+    // lazy loading
+    QByteArray m_pendingData; //!< Stored blob (compressed and base64 encoded) not yet deserialized
+    QByteArray m_loadedDigest;
+    QByteArray m_failedData;  //!< Stored blob kept as is when it cannot be deserialized so that saving does not overwrite it
+    mutable QMutex m_mutex;   //!< Presets can be materialized from GUI and Web API threads
+
 private:
+    void materialize() const;
+    void modify();            //!< Materializes before a change of contents. A changed preset replaces a stored blob that failed to load.
 	const QByteArray* findBestDeviceConfigSoapy(const QString& deviceId, const QString& deviceSerial) const;
 };
 
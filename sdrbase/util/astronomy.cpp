@@ -114,16 +114,9 @@ double Astronomy::jd_now(void)
                       utc_time->tm_hour, utc_time->tm_min, utc_time->tm_sec);
 }
 
-// Precess a RA/DEC between two given Epochs
-RADec Astronomy::precess(RADec rd_in, double jd_from, double jd_to)
+// Rotation matrix ([row][col]) to precess rectangular equatorial coordinates between two given Epochs
+void Astronomy::precessionMatrix(double jd_from, double jd_to, double rot[3][3])
 {
-    RADec rd_out;
-    double x, y, z;
-    double xp, yp, zp;
-    double ra_rad, dec_rad;
-    double rot[3][3];      // [row][col]
-    double ra_deg;
-
     double days_per_century = 36524.219878;
     double t0 = (jd_from - jd_b1950())/days_per_century; // Tropical centuries since B1950.0
     double t = (jd_to - jd_from)/days_per_century;     // Tropical centuries from starting epoch to ending epoch
@@ -138,6 +131,19 @@ RADec Astronomy::precess(RADec rd_in, double jd_from, double jd_to)
     rot[0][2] = -rot[2][0];
     rot[1][2] = rot[2][1];
     rot[2][2] = 1.0 - ((4721.0 - 4.0*t0)*t*t)*.00000001;
+}
+
+// Precess a RA/DEC between two given Epochs
+RADec Astronomy::precess(RADec rd_in, double jd_from, double jd_to)
+{
+    RADec rd_out;
+    double x, y, z;
+    double xp, yp, zp;
+    double ra_rad, dec_rad;
+    double rot[3][3];      // [row][col]
+    double ra_deg;
+
+    precessionMatrix(jd_from, jd_to, rot);
 
     // Hours to degrees
     ra_deg = rd_in.ra*(360.0/24.0);
@@ -172,8 +178,12 @@ RADec Astronomy::precess(RADec rd_in, double jd_from, double jd_to)
 // Calculate local mean sidereal time (LMST) in degrees
 double Astronomy::localSiderealTime(QDateTime dateTime, double longitude)
 {
-    double jd = julianDate(dateTime);
+    return localSiderealTime(julianDate(dateTime), longitude);
+}
 
+// Calculate local mean sidereal time (LMST) in degrees from Julian date
+double Astronomy::localSiderealTime(double jd, double longitude)
+{
     double d = (jd - jd_j2000()); // Days since J2000 epoch (including fraction)
     double f = fmod(jd, 1.0); // Fractional part is decimal days
     double ut = (f+0.5)*24.0; // Universal time in decimal hours
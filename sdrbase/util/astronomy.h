@@ -45,11 +45,13 @@ public:
     static double jd_b1950(void);
     static double jd_now(void);
 
+    static void precessionMatrix(double jd_from, double jd_to, double rot[3][3]);
     static RADec precess(RADec rd_in, double jd_from, double jd_to);
     static AzAlt raDecToAzAlt(RADec rd, double latitude, double longitude, QDateTime dt, bool j2000=true);
     static RADec azAltToRaDec(AzAlt aa, double latitude, double longitude, QDateTime dt);
 
     static double localSiderealTime(QDateTime dateTime, double longitude);
+    static double localSiderealTime(double jd, double longitude);
 
     static void sunPosition(AzAlt& aa, RADec& rd, double latitude, double longitude, QDateTime dt);
     static double moonDays(QDateTime dt);
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <QDebug>
+
+#include "util/units.h"
+#include "ephemeris.h"
+
+Ephemeris::Ephemeris() :
+    m_nbQueries(0),
+    m_nbBlocksComputed(0)
+{
+}
+
+double Ephemeris::julianDate(qint64 msecs)
+{
+    return msecs / (24.0*60.0*60.0*1000.0) + 2440587.5; // Unix epoch is JD 2440587.5
+}
+
+Ephemeris::Frame::Frame(double latitude, double longitude, double jd, bool j2000) :
+    m_precess(j2000)
+{
+    double latRad = Units::degreesToRadians(latitude);
+    double lstRad = Units::degreesToRadians(Astronomy::localSiderealTime(jd, longitude));
+    m_sinLat = sin(latRad);
+    m_cosLat = cos(latRad);
+    m_sinLst = sin(lstRad);
+    m_cosLst = cos(lstRad);
+
+    if (j2000) {
+        Astronomy::precessionMatrix(Astronomy::jd_j2000(), jd, m_rot);
+    }
+}
+
+// Same result as Astronomy::raDecToAzAlt, but the hour angle and precession are applied
+// to the rectangular coordinates so that only the target direction needs trigonometry
+AzAlt Ephemeris::Frame::toAzAlt(RADec rd) const
+{
+    AzAlt aa;
+    double raRad = Units::degreesToRadians(rd.ra * (360.0/24.0));
+    double decRad = Units::degreesToRadians(rd.dec);
+    double cosDec = cos(decRad);
+    double x = cos(raRad) * cosDec;
+    double y = sin(raRad) * cosDec;
+    double z = sin(decRad);
+
+    if (m_precess)
+    {
+        double xp = m_rot[0][0]*x + m_rot[0][1]*y + m_rot[0][2]*z;
+        double yp = m_rot[1][0]*x + m_rot[1][1]*y + m_rot[1][2]*z;
+        double zp = m_rot[2][0]*x + m_rot[2][1]*y + m_rot[2][2]*z;
+        x = xp;
+        y = yp;
+        z = zp;
+    }
+
+    // cos(dec)cos(ha) and cos(dec)sin(ha) for hour angle ha = lst - ra
+    double hc = x * m_cosLst + y * m_sinLst;
+    double hs = x * m_sinLst - y * m_cosLst;
+    double sinAlt = z * m_sinLat + hc * m_cosLat;
+    sinAlt = sinAlt > 1.0 ? 1.0 : sinAlt < -1.0 ? -1.0 : sinAlt;
+    double az = Units::radiansToDegrees(atan2(-hs, z * m_cosLat - hc * m_sinLat));
+
+    aa.alt = Units::radiansToDegrees(asin(sinAlt));
+    aa.az = az < 0.0 ? az + 360.0 : az;
+    return aa;
+}
+
+AzAlt Ephemeris::raDecToAzAlt(RADec rd, double latitude, double longitude, const QDateTime& dateTime, bool j2000)
+{
+    Frame frame(latitude, longitude, julianDate(dateTime.toMSecsSinceEpoch()), j2000);
+    return frame.toAzAlt(rd);
+}
+
+void Ephemeris::raDecToAzAlt(const RADec *rd, int count, double latitude, double longitude, const QDateTime& dateTime, AzAlt *aa, bool j2000)
+{
+    Frame frame(latitude, longitude, julianDate(dateTime.toMSecsSinceEpoch()), j2000);
+
+    for (int i = 0; i < count; i++) {
+        aa[i] = frame.toAzAlt(rd[i]);
+    }
+}
+
+void Ephemeris::galacticToAzAlt(const double *l, const double *b, int count, double latitude, double longitude, const QDateTime& dateTime, AzAlt *aa)
+{
+    Frame frame(latitude, longitude, julianDate(dateTime.toMSecsSinceEpoch()), true);
+
+    for (int i = 0; i < count; i++)
+    {
+        RADec rd;
+        Astronomy::galacticToEquatorial(l[i], b[i], rd.ra, rd.dec);
+        aa[i] = frame.toAzAlt(rd);
+    }
+}
+
+void Ephemeris::position(Body body, double latitude, double longitude, const QDateTime& dateTime, AzAlt& aa, RADec& rd)
+{
+    positions(body, latitude, longitude, dateTime, 0, 1, &aa, &rd);
+}
+
+void Ephemeris::positions(Body body, double latitude, double longitude, const QDateTime& start, int stepSecs, int count, AzAlt *aa, RADec *rd)
+{
+    qint64 startMsecs = start.toMSecsSinceEpoch();
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (int i = 0; i < count; i++)
+    {
+        qint64 msecs = startMsecs + i * (qint64) stepSecs * 1000;
+        rd[i] = interpolate(body, latitude, longitude, msecs);
+        // Interpolated RA/Dec is already for the date
+        Frame frame(latitude, longitude, julianDate(msecs), false);
+        aa[i] = frame.toAzAlt(rd[i]);
+    }
+
+    m_nbQueries += count;
+}
+
+// Called with m_mutex locked
+RADec Ephemeris::interpolate(Body body, double latitude, double longitude, qint64 msecs)
+{
+    double t = msecs / (m_gridStepSecs * 1000.0);
+    qint64 step = (qint64) std::floor(t);
+    double f = t - step;
+    qint64 block = step >= 0 ? step / m_blockSize : (step - m_blockSize + 1) / m_blockSize;
+    int index = step - block * m_blockSize;
+
+    BlockKey key;
+    key.m_body = (int) body;
+    // Sun RA/Dec is geocentric so all observers share the same grid
+    key.m_latitude = body == Sun ? 0 : (qint32) std::round(latitude * 1e4);
+    key.m_longitude = body == Sun ? 0 : (qint32) std::round(longitude * 1e4);
+    key.m_block = block;
+
+    const QVector<RADec>& points = getBlock(key, latitude, longitude);
+    RADec rd0 = points[index];
+    RADec rd1 = points[index + 1];
+
+    // RA wraps around at 24h
+    if (rd1.ra - rd0.ra > 12.0) {
+        rd1.ra -= 24.0;
+    } else if (rd0.ra - rd1.ra > 12.0) {
+        rd1.ra += 24.0;
+    }
+
+    RADec rd;
+    rd.ra = Astronomy::modulo(rd0.ra + f * (rd1.ra - rd0.ra), 24.0);
+    rd.dec = rd0.dec + f * (rd1.dec - rd0.dec);
+    return rd;
+}
+
+// Called with m_mutex locked
+const QVector<RADec>& Ephemeris::getBlock(const BlockKey& key, double latitude, double longitude)
+{
+    QHash<BlockKey, QVector<RADec>>::const_iterator it = m_blocks.constFind(key);
+
+    if (it != m_blocks.constEnd()) {
+        return *it;
+    }
+
+    if (m_blocks.size() >= m_maxBlocks)
+    {
+        qDebug("Ephemeris::getBlock: clear cache of %d blocks", m_blocks.size());
+        m_blocks.clear();
+    }
+
+    QVector<RADec> points(m_blockSize + 1);
+    qint64 startStep = key.m_block * m_blockSize;
+
+    for (int i = 0; i <= m_blockSize; i++)
+    {
+        QDateTime dateTime = QDateTime::fromMSecsSinceEpoch((startStep + i) * m_gridStepSecs * 1000LL, Qt::UTC);
+        AzAlt aa;
+
+        if (key.m_body == Sun) {
+            Astronomy::sunPosition(aa, points[i], latitude, longitude, dateTime);
+        } else {
+            Astronomy::moonPosition(aa, points[i], latitude, longitude, dateTime);
+        }
+    }
+
+    m_nbBlocksComputed++;
+    return *m_blocks.insert(key, points);
+}
+
+void Ephemeris::clear()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_blocks.clear();
+}
+
+void Ephemeris::getStats(quint64& nbQueries, quint64& nbBlocksComputed)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    nbQueries = m_nbQueries;
+    nbBlocksComputed = m_nbBlocksComputed;
+}
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_UTIL_EPHEMERIS_H
+#define INCLUDE_UTIL_EPHEMERIS_H
+
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+#include <QDateTime>
+
+#include "export.h"
+#include "astronomy.h"
+
+// Shared and thread safe cache of Sun and Moon positions, held by MainCore.
+// RA/Dec of a body is computed with Astronomy on a time grid, a block of grid points at a time,
+// and queries interpolate between the two nearest grid points. Az/Alt is then derived from the
+// interpolated RA/Dec which is cheap compared to the full Sun or Moon model.
+// Moon RA/Dec is topocentric so the Moon grid is per observer location.
+// Positions at several times of a body share the lock and the cached blocks.
+// The RA/Dec to Az/Alt conversions compute Julian date, sidereal time and precession once per call
+// so batch calls (e.g. line of sight sweeps) only pay for the per point trigonometry.
+class SDRBASE_API Ephemeris
+{
+public:
+    enum Body {
+        Sun,
+        Moon
+    };
+
+    Ephemeris();
+
+    // Apparent (Jnow) RA/Dec and Az/Alt without refraction like Astronomy::sunPosition and Astronomy::moonPosition
+    void position(Body body, double latitude, double longitude, const QDateTime& dateTime, AzAlt& aa, RADec& rd);
+    // Positions at count times from start every stepSecs seconds
+    void positions(Body body, double latitude, double longitude, const QDateTime& start, int stepSecs, int count, AzAlt *aa, RADec *rd);
+
+    // Same as Astronomy::raDecToAzAlt
+    static AzAlt raDecToAzAlt(RADec rd, double latitude, double longitude, const QDateTime& dateTime, bool j2000 = true);
+    static void raDecToAzAlt(const RADec *rd, int count, double latitude, double longitude, const QDateTime& dateTime, AzAlt *aa, bool j2000 = true);
+    // J2000 galactic coordinates in degrees to Az/Alt
+    static void galacticToAzAlt(const double *l, const double *b, int count, double latitude, double longitude, const QDateTime& dateTime, AzAlt *aa);
+
+    void clear();
+    void getStats(quint64& nbQueries, quint64& nbBlocksComputed);
+
+    static const int m_gridStepSecs = 600;     //!< Linear interpolation error is well below 0.01 degree for the Moon
+    static const int m_blockSize = 36;         //!< Grid points computed at once (6 hours)
+    static const int m_maxBlocks = 1024;       //!< Cache is cleared beyond this
+
+private:
+    struct BlockKey
+    {
+        int m_body;
+        qint32 m_latitude;      //!< 1e-4 degrees
+        qint32 m_longitude;     //!< 1e-4 degrees
+        qint64 m_block;         //!< Block start time in grid steps since epoch over block size
+
+        bool operator==(const BlockKey& other) const {
+            return (m_body == other.m_body) && (m_latitude == other.m_latitude)
+                && (m_longitude == other.m_longitude) && (m_block == other.m_block);
+        }
+
+        friend uint qHash(const BlockKey& key, uint seed = 0) {
+            return ::qHash(key.m_block, seed) ^ ::qHash(key.m_latitude, seed) ^ ::qHash(key.m_longitude * 31 + key.m_body, seed);
+        }
+    };
+
+    // Observer and time dependent terms of the RA/Dec to Az/Alt conversion
+    struct Frame
+    {
+        double m_sinLat;
+        double m_cosLat;
+        double m_sinLst;
+        double m_cosLst;
+        bool m_precess;
+        double m_rot[3][3];     //!< J2000 to date precession
+
+        Frame(double latitude, double longitude, double jd, bool j2000);
+        AzAlt toAzAlt(RADec rd) const;
+    };
+
+    QHash<BlockKey, QVector<RADec>> m_blocks; //!< m_blockSize + 1 points so that the last interval interpolates within the block
+    quint64 m_nbQueries;
+    quint64 m_nbBlocksComputed;
+    QMutex m_mutex;
+
+    RADec interpolate(Body body, double latitude, double longitude, qint64 msecs);
+    const QVector<RADec>& getBlock(const BlockKey& key, double latitude, double longitude);
+    static double julianDate(qint64 msecs);
+};
+
+#endif // INCLUDE_UTIL_EPHEMERIS_H
@@ -17,11 +17,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include <QtGlobal>
 #include <QRegExp>
 #include <QDebug>
 #include <QResource>
+#include <QIODevice>
+#include <QtEndian>
 
 #include "fits.h"
 
@@ -169,3 +172,90 @@ float FITS::scaledWrappedValue(int x, int y) const
     float v = value(mod(x, m_width), mod(y, m_height));
     return v * m_uintScale;
 }
+
+FITSWriter::FITSWriter(QIODevice *device) :
+    m_device(device),
+    m_width(0),
+    m_dataBytes(0)
+{
+}
+
+void FITSWriter::addKeyword(const QString& keyword, const QString& value, bool isString)
+{
+    if (isString) {
+        m_keywords.append(QPair<QString, QString>(keyword, QString("'%1'").arg(value.left(68).leftJustified(8))));
+    } else {
+        m_keywords.append(QPair<QString, QString>(keyword, value));
+    }
+}
+
+void FITSWriter::addKeyword(const QString& keyword, double value)
+{
+    addKeyword(keyword, QString::number(value, 'G', 15));
+}
+
+// 80 character header card. Fixed format: values right justified in columns 11-30
+QByteArray FITSWriter::card(const QString& keyword, const QString& value)
+{
+    QString c = keyword.left(8).leftJustified(8) + "= ";
+
+    if (value.startsWith("'")) {
+        c += value;
+    } else {
+        c += value.rightJustified(20);
+    }
+
+    return c.left(80).leftJustified(80).toLatin1();
+}
+
+bool FITSWriter::writeHeader(int width, int height)
+{
+    QByteArray header;
+
+    m_width = width;
+    m_dataBytes = 0;
+    header.append(card("SIMPLE", "T"));
+    header.append(card("BITPIX", "-32"));
+    header.append(card("NAXIS", "2"));
+    header.append(card("NAXIS1", QString::number(width)));
+    header.append(card("NAXIS2", QString::number(height)));
+
+    for (const auto& keyword : m_keywords) {
+        header.append(card(keyword.first, keyword.second));
+    }
+
+    header.append(QString("END").leftJustified(80).toLatin1());
+
+    int padding = (m_blockSize - header.size() % m_blockSize) % m_blockSize;
+    header.append(QByteArray(padding, ' '));
+
+    return m_device->write(header) == header.size();
+}
+
+bool FITSWriter::writeRow(const float *row)
+{
+    // FITS is big-endian
+    QByteArray bytes(m_width * 4, 0);
+    char *p = bytes.data();
+
+    for (int i = 0; i < m_width; i++)
+    {
+        quint32 v;
+        std::memcpy(&v, &row[i], 4);
+        qToBigEndian<quint32>(v, p + 4*i);
+    }
+
+    m_dataBytes += bytes.size();
+    return m_device->write(bytes) == bytes.size();
+}
+
+bool FITSWriter::finish()
+{
+    int padding = (m_blockSize - m_dataBytes % m_blockSize) % m_blockSize;
+
+    if (padding > 0) {
+        return m_device->write(QByteArray(padding, 0)) == padding;
+    }
+
+    return true;
+}
@@ -20,6 +20,10 @@
 
 #include <QString>
 #include <QByteArray>
+#include <QList>
+#include <QPair>
+
+class QIODevice;
 
 #include "export.h"
 
@@ -63,4 +67,27 @@ protected:
     int mod(int a, int b) const;
 };
 
+// Writes a 2D single precision floating point image to a FITS file one row at a time,
+// so large images don't need to be held in memory.
+class SDRBASE_API FITSWriter {
+public:
+    FITSWriter(QIODevice *device);
+
+    //! Add a keyword to the header. Strings are quoted. Must be called before writeHeader()
+    void addKeyword(const QString& keyword, const QString& value, bool isString = false);
+    void addKeyword(const QString& keyword, double value);
+    bool writeHeader(int width, int height);
+    bool writeRow(const float *row);    //!< width values
+    bool finish();                      //!< Pad data to a whole number of blocks
+
+private:
+    QIODevice *m_device;
+    int m_width;
+    qint64 m_dataBytes;
+    QList<QPair<QString, QString>> m_keywords;
+
+    static const int m_blockSize = 2880;
+    static QByteArray card(const QString& keyword, const QString& value);
+};
+
 #endif // INCLUDE_UTIL_FITS_H
@@ -0,0 +1,397 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "maincore.h"
+#include "logwriter.h"
+
+LogWriterService::File::~File()
+{
+    delete m_file;
+}
+
+LogWriterService::LogWriterService() :
+    m_maxSize(0),
+    m_periodSecs(0),
+    m_compress(false),
+    m_stop(false),
+    m_pending(false)
+{
+}
+
+LogWriterService::~LogWriterService()
+{
+    if (isRunning())
+    {
+        m_mutex.lock();
+        m_stop = true;
+        m_wakeUp.wakeAll();
+        m_mutex.unlock();
+        wait();
+    }
+}
+
+bool LogWriterService::isCompressionAvailable()
+{
+#ifdef USE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LogWriterService::setRotation(qint64 maxSize, int periodSecs, bool compress)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (compress && !isCompressionAvailable())
+    {
+        qWarning("LogWriterService::setRotation: built without zlib: rotated files are not compressed");
+        compress = false;
+    }
+
+    qDebug("LogWriterService::setRotation: maxSize: %lld periodSecs: %d compress: %s",
+        maxSize, periodSecs, compress ? "true" : "false");
+    m_maxSize = maxSize;
+    m_periodSecs = periodSecs;
+    m_compress = compress;
+}
+
+void LogWriterService::registerFile(const QSharedPointer<File>& file)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_files.append(file);
+
+    if (!isRunning())
+    {
+        m_stop = false;
+        start(QThread::LowPriority);
+    }
+}
+
+void LogWriterService::wakeUp()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_pending = true;
+    m_wakeUp.wakeAll();
+}
+
+void LogWriterService::run()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    bool stop = false;
+
+    while (!stop)
+    {
+        if (!m_stop && !m_pending) {
+            m_wakeUp.wait(&m_mutex, m_flushPeriodMs);
+        }
+
+        // Queued records are written once more after stop is requested
+        stop = m_stop;
+        m_pending = false;
+        QList<QSharedPointer<File>> files = m_files;
+        qint64 maxSize = m_maxSize;
+        int periodSecs = m_periodSecs;
+        bool compress = m_compress;
+        mutexLocker.unlock();
+
+        QList<QSharedPointer<File>> closedFiles;
+
+        for (const auto& file : files)
+        {
+            QList<Record> records;
+            file->m_mutex.lock();
+            records.swap(file->m_records);
+            bool closed = file->m_closed;
+            int dropped = file->m_dropped;
+            file->m_dropped = 0;
+            file->m_mutex.unlock();
+
+            if (dropped > 0) {
+                qWarning() << "LogWriterService::run: dropped" << dropped << "records of" << file->m_file->fileName();
+            }
+
+            if (!records.isEmpty()) {
+                writeRecords(file.data(), records, maxSize, periodSecs, compress);
+            }
+
+            if (closed)
+            {
+                file->m_file->close();
+                closedFiles.append(file);
+            }
+        }
+
+        mutexLocker.relock();
+
+        for (const auto& file : closedFiles) {
+            m_files.removeOne(file);
+        }
+    }
+}
+
+// Called in the background thread
+void LogWriterService::writeRecords(File *file, const QList<Record>& records, qint64 maxSize, int periodSecs, bool compress)
+{
+    if ((periodSecs > 0) && (QDateTime::currentDateTime() >= file->m_startDateTime.addSecs(periodSecs))) {
+        rotate(file, compress);
+    }
+
+    QByteArray bytes;
+
+    for (const auto& record : records)
+    {
+        QStringList fields;
+        fields.reserve(record.m_fields.size() + 2);
+        fields.append(record.m_dateTime.date().toString());
+        fields.append(record.m_dateTime.time().toString());
+        fields.append(record.m_fields);
+        bytes.append(toCSV(fields).toUtf8());
+        bytes.append('\n');
+
+        if ((maxSize > 0) && (file->m_size + bytes.size() >= maxSize))
+        {
+            writeBytes(file, bytes);
+            bytes.clear();
+            rotate(file, compress);
+        }
+    }
+
+    if (!bytes.isEmpty()) {
+        writeBytes(file, bytes);
+    }
+
+    file->m_file->flush();
+}
+
+void LogWriterService::writeBytes(File *file, const QByteArray& bytes)
+{
+    if (!file->m_file->isOpen()) {
+        return;
+    }
+
+    if (file->m_file->write(bytes) != bytes.size()) {
+        qWarning() << "LogWriterService::writeBytes: error writing to" << file->m_file->fileName() << ":" << file->m_file->errorString();
+    }
+
+    file->m_size += bytes.size();
+}
+
+void LogWriterService::writeHeader(File *file)
+{
+    if (file->m_size == 0) {
+        writeBytes(file, (file->m_header + "\n").toUtf8());
+    }
+}
+
+// Called in the background thread. The current file is renamed with the rotation time and a new one is started.
+void LogWriterService::rotate(File *file, bool compress)
+{
+    QString fileName = file->m_file->fileName();
+    QFileInfo fileInfo(fileName);
+    QString suffix = fileInfo.suffix().isEmpty() ? "" : "." + fileInfo.suffix();
+    QString base = fileInfo.path() + "/" + fileInfo.completeBaseName() + "_" + QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
+    QString rotatedFileName = base + suffix;
+
+    for (int i = 1; QFile::exists(rotatedFileName) || QFile::exists(rotatedFileName + ".gz"); i++) {
+        rotatedFileName = QString("%1_%2%3").arg(base).arg(i).arg(suffix);
+    }
+
+    file->m_file->close();
+
+    if (QFile::rename(fileName, rotatedFileName))
+    {
+        qDebug() << "LogWriterService::rotate:" << fileName << "to" << rotatedFileName;
+
+        if (compress) {
+            compressFile(rotatedFileName);
+        }
+    }
+    else
+    {
+        qWarning() << "LogWriterService::rotate: cannot rename" << fileName << "to" << rotatedFileName;
+    }
+
+    if (file->m_file->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        file->m_size = file->m_file->size();
+    } else {
+        qWarning() << "LogWriterService::rotate: cannot open" << fileName << ":" << file->m_file->errorString();
+    }
+
+    file->m_startDateTime = QDateTime::currentDateTime();
+    writeHeader(file);
+}
+
+// Replaces the file by its gzip compressed version with .gz appended to its name
+bool LogWriterService::compressFile(const QString& fileName)
+{
+#ifdef USE_ZLIB
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "LogWriterService::compressFile: cannot open" << fileName;
+        return false;
+    }
+
+    QString gzFileName = fileName + ".gz";
+    gzFile gz = gzopen(QFile::encodeName(gzFileName).constData(), "wb");
+
+    if (!gz)
+    {
+        qWarning() << "LogWriterService::compressFile: cannot open" << gzFileName;
+        return false;
+    }
+
+    bool ok = true;
+    QByteArray buffer;
+
+    while (ok && !(buffer = file.read(1<<16)).isEmpty()) {
+        ok = gzwrite(gz, buffer.constData(), buffer.size()) == buffer.size();
+    }
+
+    ok = (gzclose(gz) == Z_OK) && ok;
+    file.close();
+
+    if (ok)
+    {
+        QFile::remove(fileName);
+    }
+    else
+    {
+        qWarning() << "LogWriterService::compressFile: error compressing" << fileName;
+        QFile::remove(gzFileName);
+    }
+
+    return ok;
+#else
+    (void) fileName;
+    return false;
+#endif
+}
+
+// Fields with a delimiter, quote or line break are quoted
+QString LogWriterService::toCSV(const QStringList& fields)
+{
+    QString line;
+
+    for (int i = 0; i < fields.size(); i++)
+    {
+        const QString& field = fields[i];
+
+        if (i > 0) {
+            line.append(',');
+        }
+
+        if (field.contains(',') || field.contains('"') || field.contains('\n') || field.contains('\r'))
+        {
+            QString quoted = field;
+            quoted.replace("\"", "\"\"");
+            line.append('"').append(quoted).append('"');
+        }
+        else
+        {
+            line.append(field);
+        }
+    }
+
+    return line;
+}
+
+LogWriter::LogWriter() :
+    m_service(nullptr)
+{
+}
+
+LogWriter::~LogWriter()
+{
+    close();
+}
+
+bool LogWriter::open(const QString& fileName, const QStringList& header)
+{
+    close();
+
+    QSharedPointer<LogWriterService::File> file(new LogWriterService::File());
+    file->m_file = new QFile(fileName);
+
+    if (!file->m_file->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        return false;
+    }
+
+    file->m_header = LogWriterService::toCSV(header);
+    file->m_size = file->m_file->size();
+    file->m_startDateTime = QDateTime::currentDateTime();
+    LogWriterService::writeHeader(file.data());
+    file->m_file->flush();
+
+    // From now on the file is only used by the background thread
+    m_service = &MainCore::instance()->getLogWriterService();
+    m_service->registerFile(file);
+    m_file = file;
+
+    return true;
+}
+
+void LogWriter::close()
+{
+    if (m_file)
+    {
+        m_file->m_mutex.lock();
+        m_file->m_closed = true;
+        m_file->m_mutex.unlock();
+        m_file.reset();
+        m_service->wakeUp();
+    }
+}
+
+void LogWriter::write(const QDateTime& dateTime, const QStringList& fields)
+{
+    if (!m_file) {
+        return;
+    }
+
+    int nbQueued;
+
+    {
+        QMutexLocker mutexLocker(&m_file->m_mutex);
+
+        if (m_file->m_records.size() >= LogWriterService::m_maxQueued)
+        {
+            m_file->m_dropped++;
+            return;
+        }
+
+        LogWriterService::Record record;
+        record.m_dateTime = dateTime;
+        record.m_fields = fields;
+        m_file->m_records.append(record);
+        nbQueued = m_file->m_records.size();
+    }
+
+    if (nbQueued == LogWriterService::m_batchSize) {
+        m_service->wakeUp();
+    }
+}
@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_UTIL_LOGWRITER_H
+#define INCLUDE_UTIL_LOGWRITER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QDateTime>
+
+#include "export.h"
+
+class QFile;
+
+// Background writer of decoder output logs (CSV files), held by MainCore and shared by all channels.
+// Decoders push records to a LogWriter which only queues them. A single thread formats the queued
+// records and appends them to their files in batches, every m_flushPeriodMs or as soon as a queue
+// holds m_batchSize records, so that decoders never wait on the disk.
+// A file can be rotated when it gets larger than a size or older than a period: it is renamed with
+// the rotation time appended to its base name, optionally gzip compressed, and a new file is started
+// with the same header. Rotation and compression take place in the background thread.
+class SDRBASE_API LogWriterService : public QThread
+{
+public:
+    LogWriterService();
+    ~LogWriterService();
+
+    // Zero size or period for no rotation on that criterion. Compression needs zlib at build time.
+    void setRotation(qint64 maxSize, int periodSecs, bool compress);
+    static bool isCompressionAvailable();
+
+    static const int m_flushPeriodMs = 1000;
+    static const int m_batchSize = 1000;        //!< Queued records of a file that trigger a write before the period
+    static const int m_maxQueued = 1000000;     //!< Records of a file beyond this are dropped
+
+protected:
+    void run() override;
+
+private:
+    struct Record
+    {
+        QDateTime m_dateTime;
+        QStringList m_fields;
+    };
+
+    struct File
+    {
+        QFile *m_file;              //!< Only used by the background thread once registered
+        QString m_header;           //!< CSV header line
+        qint64 m_size;
+        QDateTime m_startDateTime;  //!< Time the current file was started for time rotation
+        QMutex m_mutex;             //!< Protects the members below
+        QList<Record> m_records;
+        int m_dropped;
+        bool m_closed;
+
+        File() : m_file(nullptr), m_size(0), m_dropped(0), m_closed(false) {}
+        ~File();
+    };
+
+    QList<QSharedPointer<File>> m_files;
+    qint64 m_maxSize;
+    int m_periodSecs;
+    bool m_compress;
+    bool m_stop;
+    bool m_pending;                 //!< A queue reached the batch size
+    QMutex m_mutex;                 //!< Protects files list, rotation settings and flags
+    QWaitCondition m_wakeUp;
+
+    void registerFile(const QSharedPointer<File>& file);
+    void wakeUp();
+    void writeRecords(File *file, const QList<Record>& records, qint64 maxSize, int periodSecs, bool compress);
+    static void writeBytes(File *file, const QByteArray& bytes);
+    static void writeHeader(File *file); //!< If the file is empty
+    static void rotate(File *file, bool compress);
+    static bool compressFile(const QString& fileName);
+    static QString toCSV(const QStringList& fields);
+
+    friend class LogWriter;
+};
+
+// Decoder side of a log file. Records are written asynchronously by the LogWriterService of MainCore.
+// Use from a single thread.
+class SDRBASE_API LogWriter
+{
+public:
+    LogWriter();
+    ~LogWriter();   //!< Closes the file. Records already queued are still written.
+
+    // Opens for append and writes the header if the file is new. Closes any previously opened file.
+    bool open(const QString& fileName, const QStringList& header);
+    void close();
+    bool isOpen() const { return !m_file.isNull(); }
+    // Writes a line with date and time columns followed by the fields, quoted if needed
+    void write(const QDateTime& dateTime, const QStringList& fields);
+
+private:
+    QSharedPointer<LogWriterService::File> m_file;
+    LogWriterService *m_service;
+};
+
+#endif // INCLUDE_UTIL_LOGWRITER_H
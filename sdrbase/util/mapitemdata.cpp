@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QSet>
+#include <QMutex>
+
+#include "SWGMapItem.h"
+#include "SWGMapCoordinate.h"
+#include "SWGMapAnimation.h"
+
+#include "mapitemdata.h"
+
+MapItemData::MapItemData() :
+    m_imageRotation(0),
+    m_latitude(0.0f),
+    m_longitude(0.0f),
+    m_altitude(0.0f),
+    m_fixedPosition(false),
+    m_hasTrack(false),
+    m_hasPredictedTrack(false),
+    m_orientation(0),
+    m_heading(0.0f),
+    m_pitch(0.0f),
+    m_roll(0.0f),
+    m_labelAltitudeOffset(0.0f),
+    m_modelAltitudeOffset(0.0f),
+    m_altitudeReference(0),
+    m_type(0),
+    m_imageTileWest(0.0f),
+    m_imageTileSouth(0.0f),
+    m_imageTileEast(0.0f),
+    m_imageTileNorth(0.0f)
+{
+}
+
+QString MapItemData::intern(const QString& string)
+{
+    static QMutex mutex;
+    static QSet<QString> strings;
+
+    if (string.isEmpty()) {
+        return QString("");
+    }
+
+    if (string.size() > m_maxInternedLength) { // Not a name (e.g. image data) so unlikely to be seen again
+        return string;
+    }
+
+    QMutexLocker mutexLocker(&mutex);
+    QSet<QString>::const_iterator it = strings.constFind(string);
+
+    if (it != strings.constEnd()) {
+        return *it;
+    }
+
+    if (strings.size() >= m_maxInterned) { // Names built from data could grow the set indefinitely
+        strings.clear();
+    }
+
+    strings.insert(string);
+    return string;
+}
+
+static QString stringOrEmpty(const QString *string)
+{
+    return string ? *string : QString("");
+}
+
+static void fromSWGTrack(QList<SWGSDRangel::SWGMapCoordinate *> *swgTrack, bool& hasTrack, QVector<MapItemData::Coordinate>& track)
+{
+    hasTrack = swgTrack != nullptr;
+    track.clear();
+
+    if (hasTrack)
+    {
+        track.reserve(swgTrack->size());
+
+        for (auto p : *swgTrack)
+        {
+            track.append(MapItemData::Coordinate(
+                p->getLatitude(),
+                p->getLongitude(),
+                p->getAltitude(),
+                p->getDateTime() ? QDateTime::fromString(*p->getDateTime(), Qt::ISODate) : QDateTime()
+            ));
+        }
+    }
+}
+
+static QList<SWGSDRangel::SWGMapCoordinate *> *toSWGTrack(const QVector<MapItemData::Coordinate>& track)
+{
+    QList<SWGSDRangel::SWGMapCoordinate *> *swgTrack = new QList<SWGSDRangel::SWGMapCoordinate *>();
+
+    for (const auto& c : track)
+    {
+        SWGSDRangel::SWGMapCoordinate *p = new SWGSDRangel::SWGMapCoordinate();
+        p->setLatitude(c.m_latitude);
+        p->setLongitude(c.m_longitude);
+        p->setAltitude(c.m_altitude);
+        p->setDateTime(new QString(c.m_dateTime.toString(Qt::ISODateWithMs)));
+        swgTrack->append(p);
+    }
+
+    return swgTrack;
+}
+
+void MapItemData::fromSWGMapItem(SWGSDRangel::SWGMapItem *swgMapItem)
+{
+    m_name = stringOrEmpty(swgMapItem->getName());
+    m_type = swgMapItem->getType(); // before image as image tiles are not interned
+    setImage(stringOrEmpty(swgMapItem->getImage()));
+    m_imageRotation = swgMapItem->getImageRotation();
+    m_text = stringOrEmpty(swgMapItem->getText());
+    m_latitude = swgMapItem->getLatitude();
+    m_longitude = swgMapItem->getLongitude();
+    m_altitude = swgMapItem->getAltitude();
+    m_fixedPosition = swgMapItem->getFixedPosition() != 0;
+    m_positionDateTime = swgMapItem->getPositionDateTime() ?
+        QDateTime::fromString(*swgMapItem->getPositionDateTime(), Qt::ISODateWithMs) : QDateTime();
+    fromSWGTrack(swgMapItem->getTrack(), m_hasTrack, m_track);
+    fromSWGTrack(swgMapItem->getPredictedTrack(), m_hasPredictedTrack, m_predictedTrack);
+    setModel(stringOrEmpty(swgMapItem->getModel()));
+    m_orientation = swgMapItem->getOrientation();
+    m_heading = swgMapItem->getHeading();
+    m_pitch = swgMapItem->getPitch();
+    m_roll = swgMapItem->getRoll();
+    m_orientationDateTime = swgMapItem->getOrientationDateTime() ?
+        QDateTime::fromString(*swgMapItem->getOrientationDateTime(), Qt::ISODateWithMs) : QDateTime();
+    m_label = stringOrEmpty(swgMapItem->getLabel());
+    m_labelAltitudeOffset = swgMapItem->getLabelAltitudeOffset();
+    m_modelAltitudeOffset = swgMapItem->getModelAltitudeOffset();
+    m_altitudeReference = swgMapItem->getAltitudeReference();
+    m_animations.clear();
+
+    if (swgMapItem->getAnimations())
+    {
+        for (auto swgAnimation : *swgMapItem->getAnimations())
+        {
+            Animation animation;
+            animation.m_name = stringOrEmpty(swgAnimation->getName());
+            animation.m_startDateTime = stringOrEmpty(swgAnimation->getStartDateTime());
+            animation.m_reverse = swgAnimation->getReverse() != 0;
+            animation.m_loop = swgAnimation->getLoop() != 0;
+            animation.m_stop = swgAnimation->getStop() != 0;
+            animation.m_startOffset = swgAnimation->getStartOffset();
+            animation.m_duration = swgAnimation->getDuration();
+            animation.m_multiplier = swgAnimation->getMultiplier();
+            m_animations.append(animation);
+        }
+    }
+
+    m_imageTileWest = swgMapItem->getImageTileWest();
+    m_imageTileSouth = swgMapItem->getImageTileSouth();
+    m_imageTileEast = swgMapItem->getImageTileEast();
+    m_imageTileNorth = swgMapItem->getImageTileNorth();
+}
+
+void MapItemData::toSWGMapItem(SWGSDRangel::SWGMapItem *swgMapItem) const
+{
+    swgMapItem->setName(new QString(m_name));
+    swgMapItem->setImage(new QString(m_image));
+    swgMapItem->setImageRotation(m_imageRotation);
+    swgMapItem->setText(new QString(m_text));
+    swgMapItem->setLatitude(m_latitude);
+    swgMapItem->setLongitude(m_longitude);
+    swgMapItem->setAltitude(m_altitude);
+    swgMapItem->setFixedPosition(m_fixedPosition ? 1 : 0);
+
+    if (m_positionDateTime.isValid()) {
+        swgMapItem->setPositionDateTime(new QString(m_positionDateTime.toString(Qt::ISODateWithMs)));
+    }
+    if (m_hasTrack) {
+        swgMapItem->setTrack(toSWGTrack(m_track));
+    }
+    if (m_hasPredictedTrack) {
+        swgMapItem->setPredictedTrack(toSWGTrack(m_predictedTrack));
+    }
+
+    swgMapItem->setModel(new QString(m_model));
+    swgMapItem->setOrientation(m_orientation);
+    swgMapItem->setHeading(m_heading);
+    swgMapItem->setPitch(m_pitch);
+    swgMapItem->setRoll(m_roll);
+
+    if (m_orientationDateTime.isValid()) {
+        swgMapItem->setOrientationDateTime(new QString(m_orientationDateTime.toString(Qt::ISODateWithMs)));
+    }
+
+    swgMapItem->setLabel(new QString(m_label));
+    swgMapItem->setLabelAltitudeOffset(m_labelAltitudeOffset);
+    swgMapItem->setModelAltitudeOffset(m_modelAltitudeOffset);
+    swgMapItem->setAltitudeReference(m_altitudeReference);
+
+    if (!m_animations.isEmpty())
+    {
+        QList<SWGSDRangel::SWGMapAnimation *> *swgAnimations = new QList<SWGSDRangel::SWGMapAnimation *>();
+
+        for (const auto& animation : m_animations)
+        {
+            SWGSDRangel::SWGMapAnimation *swgAnimation = new SWGSDRangel::SWGMapAnimation();
+            swgAnimation->setName(new QString(animation.m_name));
+            swgAnimation->setStartDateTime(new QString(animation.m_startDateTime));
+            swgAnimation->setReverse(animation.m_reverse ? 1 : 0);
+            swgAnimation->setLoop(animation.m_loop ? 1 : 0);
+            swgAnimation->setStop(animation.m_stop ? 1 : 0);
+            swgAnimation->setStartOffset(animation.m_startOffset);
+            swgAnimation->setDuration(animation.m_duration);
+            swgAnimation->setMultiplier(animation.m_multiplier);
+            swgAnimations->append(swgAnimation);
+        }
+
+        swgMapItem->setAnimations(swgAnimations);
+    }
+
+    swgMapItem->setType(m_type);
+    swgMapItem->setImageTileWest(m_imageTileWest);
+    swgMapItem->setImageTileSouth(m_imageTileSouth);
+    swgMapItem->setImageTileEast(m_imageTileEast);
+    swgMapItem->setImageTileNorth(m_imageTileNorth);
+}
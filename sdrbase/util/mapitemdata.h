@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_UTIL_MAPITEMDATA_H
+#define INCLUDE_UTIL_MAPITEMDATA_H
+
+#include <QString>
+#include <QVector>
+#include <QDateTime>
+
+#include "export.h"
+
+namespace SWGSDRangel
+{
+    class SWGMapItem;
+}
+
+// Item to draw on the Map feature. Value type equivalent of SWGSDRangel::SWGMapItem for producers
+// sending many updates: fields are held by value, track points are contiguous and image and model
+// names are interned so that all items with the same icon or model share the same string data.
+// Items are sent to the Map in batches with MainCore::MsgMapItems.
+struct SDRBASE_API MapItemData
+{
+    struct Coordinate
+    {
+        float m_latitude;
+        float m_longitude;
+        float m_altitude;
+        QDateTime m_dateTime;
+
+        Coordinate() :
+            m_latitude(0.0f),
+            m_longitude(0.0f),
+            m_altitude(0.0f)
+        {}
+
+        Coordinate(float latitude, float longitude, float altitude, const QDateTime& dateTime) :
+            m_latitude(latitude),
+            m_longitude(longitude),
+            m_altitude(altitude),
+            m_dateTime(dateTime)
+        {}
+    };
+
+    struct Animation
+    {
+        QString m_name;
+        QString m_startDateTime;
+        bool m_reverse;
+        bool m_loop;
+        bool m_stop;
+        float m_startOffset;
+        float m_duration;
+        float m_multiplier;
+
+        Animation() :
+            m_reverse(false),
+            m_loop(false),
+            m_stop(false),
+            m_startOffset(0.0f),
+            m_duration(0.0f),
+            m_multiplier(1.0f)
+        {}
+    };
+
+    QString m_name;
+    QString m_image;                //!< Image on 2D map. Empty to remove the item from the map. Interned by setImage except image tile data.
+    int m_imageRotation;
+    QString m_text;
+    float m_latitude;
+    float m_longitude;
+    float m_altitude;               //!< Metres
+    bool m_fixedPosition;
+    QDateTime m_positionDateTime;
+    bool m_hasTrack;                //!< When false the Map builds the track from successive positions
+    QVector<Coordinate> m_track;
+    bool m_hasPredictedTrack;
+    QVector<Coordinate> m_predictedTrack;
+    QString m_model;                //!< 3D model. Interned by setModel.
+    int m_orientation;              //!< 0 - Along direction of motion, 1 - Use heading, pitch and roll
+    float m_heading;
+    float m_pitch;
+    float m_roll;
+    QDateTime m_orientationDateTime;
+    QString m_label;
+    float m_labelAltitudeOffset;
+    float m_modelAltitudeOffset;
+    int m_altitudeReference;        //!< 0 - NONE (Absolule), 1 - CLAMP_TO_GROUND, 2 - RELATIVE_TO_GROUND, 3 - CLIP_TO_GROUND
+    QVector<Animation> m_animations;
+    int m_type;                     //!< 0 - Map Item, 1 - Image Tile
+    float m_imageTileWest;
+    float m_imageTileSouth;
+    float m_imageTileEast;
+    float m_imageTileNorth;
+
+    MapItemData();
+    void setImage(const QString& image) { m_image = m_type == 1 ? image : intern(image); } //!< Set m_type first
+    void setModel(const QString& model) { m_model = intern(model); }
+
+    // Adapters for the Web API form
+    void fromSWGMapItem(SWGSDRangel::SWGMapItem *swgMapItem);
+    void toSWGMapItem(SWGSDRangel::SWGMapItem *swgMapItem) const;
+
+    static QString intern(const QString& string); //!< Returns a copy sharing the data of an identical string seen before
+    static const int m_maxInterned = 4096;
+    static const int m_maxInternedLength = 256; //!< Longer strings are not names and are not interned
+};
+
+#endif // INCLUDE_UTIL_MAPITEMDATA_H
@@ -68,6 +68,12 @@
 #include "SWGDeviceActions.h"
 #include "SWGWorkspaceInfo.h"
 #include "SWGChannelsDetail.h"
+#include "SWGChannelsBatch.h"
+#include "SWGChannelsBatchOperation.h"
+#include "SWGFeaturesBatch.h"
+#include "SWGFeaturesBatchOperation.h"
+#include "SWGBatchResults.h"
+#include "SWGBatchResult.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
@@ -1837,6 +1843,134 @@ int WebAPIAdapter::devicesetSpectrumServerDelete(
     }
 }
 
+int WebAPIAdapter::devicesetSpectrumWaterfallGet(
+        int deviceSetIndex,
+        const SpectrumWaterfall::TileRequest& request,
+        QByteArray& png,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore->m_deviceSets.size()))
+    {
+        const DeviceSet *deviceSet = m_mainCore->m_deviceSets[deviceSetIndex];
+        error.init();
+
+        return deviceSet->webapiSpectrumWaterfallGet(request, png, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapter::devicesetSpectrumWaterfallPost(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore->m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore->m_deviceSets[deviceSetIndex];
+        deviceSet->webapiSpectrumWaterfallPost(response, *error.getMessage());
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapter::devicesetSpectrumWaterfallDelete(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore->m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore->m_deviceSets[deviceSetIndex];
+        deviceSet->webapiSpectrumWaterfallDelete(response, *error.getMessage());
+
+        return 200;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapter::devicesetIQHistoryPost(
+        int deviceSetIndex,
+        quint64 memoryBytes,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore->m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore->m_deviceSets[deviceSetIndex];
+        return deviceSet->webapiIQHistoryPost(memoryBytes, response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapter::devicesetIQHistoryDelete(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore->m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore->m_deviceSets[deviceSetIndex];
+        return deviceSet->webapiIQHistoryDelete(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapter::devicesetIQHistoryCapturePost(
+        int deviceSetIndex,
+        qint64 startTime,
+        qint64 endTime,
+        const QString& fileName,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore->m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore->m_deviceSets[deviceSetIndex];
+        return deviceSet->webapiIQHistoryCapturePost(startTime, endTime, fileName, response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
 int WebAPIAdapter::devicesetSpectrumWorkspaceGet(
         int deviceSetIndex,
         SWGSDRangel::SWGWorkspaceInfo& response,
@@ -2656,6 +2790,182 @@ int WebAPIAdapter::devicesetChannelPost(
     }
 }
 
+// Waits for the main thread to apply the operations of a batch that were submitted and sets their results.
+// Returns the overall status: 200 if all operations succeeded, 207 if only some did, 400 if none did
+// and 202 if the batch is still not applied after the timeout in which case results stay as submitted.
+static int waitForBatchResults(
+        const QSharedPointer<MainCore::BatchResults>& results,
+        const QList<SWGSDRangel::SWGBatchResult*>& submittedResults,
+        SWGSDRangel::SWGBatchResults& response)
+{
+    const int timeoutMs = 10000;
+
+    if (!results->m_applied.tryAcquire(1, timeoutMs))
+    {
+        qWarning("WebAPIAdapter: batch not applied after %d ms", timeoutMs);
+        return 202;
+    }
+
+    for (int i = 0; i < submittedResults.size(); i++)
+    {
+        int status = i < results->m_statuses.size() ? results->m_statuses[i] : 500;
+        submittedResults[i]->setStatus(status);
+        *submittedResults[i]->getMessage() = status/100 == 2 ? QString("Applied") : QString("Failed");
+    }
+
+    int nbSucceeded = 0;
+    int nbFailed = 0;
+
+    for (const auto result : *response.getResults())
+    {
+        if (result->getStatus()/100 == 2) {
+            nbSucceeded++;
+        } else {
+            nbFailed++;
+        }
+    }
+
+    if (nbFailed == 0) {
+        return 200;
+    } else if (nbSucceeded == 0) {
+        return 400;
+    } else {
+        return 207;
+    }
+}
+
+int WebAPIAdapter::devicesetChannelsBatchPost(
+        int deviceSetIndex,
+        SWGSDRangel::SWGChannelsBatch& query,
+        const QList<QStringList>& channelSettingsKeys,
+        SWGSDRangel::SWGBatchResults& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_mainCore->m_deviceSets.size()))
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+
+    const DeviceSet *deviceSet = m_mainCore->m_deviceSets[deviceSetIndex];
+    QList<SWGSDRangel::SWGChannelsBatchOperation*> *swgOperations = query.getOperations();
+    int nbOperations = swgOperations ? swgOperations->size() : 0;
+    int nbChannels = deviceSet->getNumberOfChannels(); // follows the operations as they will be applied
+    QList<MainCore::BatchOperation> operations;
+    QList<SWGSDRangel::SWGBatchResult*> submittedResults;
+    response.init();
+
+    for (int i = 0; i < nbOperations; i++)
+    {
+        SWGSDRangel::SWGChannelsBatchOperation *swgOperation = swgOperations->at(i);
+        SWGSDRangel::SWGChannelSettings *channelSettings = swgOperation->getSettings();
+        QString operationType = swgOperation->getOperation() ? *swgOperation->getOperation() : QString();
+        SWGSDRangel::SWGBatchResult *result = new SWGSDRangel::SWGBatchResult();
+        result->init();
+        *result->getOperation() = operationType;
+        response.getResults()->append(result);
+        MainCore::BatchOperation operation;
+        QString errorMessage;
+        int status = 202;
+
+        if (operationType == "delete")
+        {
+            operation.m_type = MainCore::BatchOperation::Delete;
+            operation.m_index = swgOperation->getChannelIndex();
+
+            if ((operation.m_index < 0) || (operation.m_index >= nbChannels))
+            {
+                status = 404;
+                errorMessage = QString("There is no channel with index %1").arg(operation.m_index);
+            }
+            else
+            {
+                nbChannels--;
+            }
+        }
+        else if (operationType == "add")
+        {
+            operation.m_type = MainCore::BatchOperation::Add;
+            operation.m_index = nbChannels;
+
+            if (!channelSettings || !channelSettings->getChannelType())
+            {
+                status = 400;
+                errorMessage = QString("Channel type is missing");
+            }
+            else
+            {
+                operation.m_direction = channelSettings->getDirection();
+                status = getChannelRegistrationIndex(deviceSet, operation.m_direction, *channelSettings->getChannelType(),
+                    operation.m_registrationIndex, errorMessage);
+
+                if (status/100 == 2)
+                {
+                    status = 202;
+                    nbChannels++;
+                }
+            }
+        }
+        else if (operationType == "update")
+        {
+            operation.m_type = MainCore::BatchOperation::Update;
+            operation.m_index = swgOperation->getChannelIndex();
+
+            if ((operation.m_index < 0) || (operation.m_index >= nbChannels))
+            {
+                status = 404;
+                errorMessage = QString("There is no channel with index %1").arg(operation.m_index);
+            }
+            else if (!channelSettings || (i >= channelSettingsKeys.size()) || channelSettingsKeys[i].isEmpty())
+            {
+                status = 400;
+                errorMessage = QString("Channel settings are missing or invalid");
+            }
+        }
+        else
+        {
+            status = 400;
+            errorMessage = QString("Unknown operation \"%1\"").arg(operationType);
+        }
+
+        result->setIndex(operation.m_index);
+        result->setStatus(status);
+
+        if (status == 202)
+        {
+            if (channelSettings && (i < channelSettingsKeys.size()))
+            {
+                // Settings are moved to the message
+                operation.m_settingsKeys = channelSettingsKeys[i];
+                operation.m_channelSettings = channelSettings;
+                swgOperation->setSettings(nullptr);
+            }
+
+            operations.append(operation);
+            submittedResults.append(result);
+            *result->getMessage() = QString("Submitted");
+        }
+        else
+        {
+            *result->getMessage() = errorMessage;
+        }
+    }
+
+    if (operations.size() == 0)
+    {
+        error.init();
+        *error.getMessage() = QString("No operation was accepted");
+        return 400;
+    }
+
+    QSharedPointer<MainCore::BatchResults> results(new MainCore::BatchResults());
+    MainCore::MsgApplyChannelsBatch *msg = MainCore::MsgApplyChannelsBatch::create(deviceSetIndex, operations, results);
+    m_mainCore->m_mainMessageQueue->push(msg);
+
+    return waitForBatchResults(results, submittedResults, response);
+}
+
 int WebAPIAdapter::devicesetChannelDelete(
             int deviceSetIndex,
             int channelIndex,
@@ -3348,6 +3658,150 @@ int WebAPIAdapter::featuresetFeaturePost(
     }
 }
 
+int WebAPIAdapter::featuresetFeaturesBatchPost(
+        int featureSetIndex,
+        SWGSDRangel::SWGFeaturesBatch& query,
+        const QList<QStringList>& featureSettingsKeys,
+        SWGSDRangel::SWGBatchResults& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((featureSetIndex < 0) || (featureSetIndex >= (int) m_mainCore->m_featureSets.size()))
+    {
+        error.init();
+        *error.getMessage() = QString("There is no feature set with index %1").arg(featureSetIndex);
+        return 404;
+    }
+
+    const FeatureSet *featureSet = m_mainCore->m_featureSets[featureSetIndex];
+    PluginAPI::FeatureRegistrations *featureRegistrations = m_mainCore->m_pluginManager->getFeatureRegistrations();
+    QList<SWGSDRangel::SWGFeaturesBatchOperation*> *swgOperations = query.getOperations();
+    int nbOperations = swgOperations ? swgOperations->size() : 0;
+    int nbFeatures = featureSet->getNumberOfFeatures(); // follows the operations as they will be applied
+    QList<MainCore::BatchOperation> operations;
+    QList<SWGSDRangel::SWGBatchResult*> submittedResults;
+    response.init();
+
+    for (int i = 0; i < nbOperations; i++)
+    {
+        SWGSDRangel::SWGFeaturesBatchOperation *swgOperation = swgOperations->at(i);
+        SWGSDRangel::SWGFeatureSettings *featureSettings = swgOperation->getSettings();
+        QString operationType = swgOperation->getOperation() ? *swgOperation->getOperation() : QString();
+        SWGSDRangel::SWGBatchResult *result = new SWGSDRangel::SWGBatchResult();
+        result->init();
+        *result->getOperation() = operationType;
+        response.getResults()->append(result);
+        MainCore::BatchOperation operation;
+        QString errorMessage;
+        int status = 202;
+
+        if (operationType == "delete")
+        {
+            operation.m_type = MainCore::BatchOperation::Delete;
+            operation.m_index = swgOperation->getFeatureIndex();
+
+            if ((operation.m_index < 0) || (operation.m_index >= nbFeatures))
+            {
+                status = 404;
+                errorMessage = QString("There is no feature with index %1").arg(operation.m_index);
+            }
+            else
+            {
+                nbFeatures--;
+            }
+        }
+        else if (operationType == "add")
+        {
+            operation.m_type = MainCore::BatchOperation::Add;
+            operation.m_index = nbFeatures;
+
+            if (!featureSettings || !featureSettings->getFeatureType())
+            {
+                status = 400;
+                errorMessage = QString("Feature type is missing");
+            }
+            else
+            {
+                int nbRegistrations = featureRegistrations->size();
+                int index = 0;
+
+                for (; index < nbRegistrations; index++)
+                {
+                    if (featureRegistrations->at(index).m_featureId == *featureSettings->getFeatureType()) {
+                        break;
+                    }
+                }
+
+                if (index < nbRegistrations)
+                {
+                    operation.m_registrationIndex = index;
+                    nbFeatures++;
+                }
+                else
+                {
+                    status = 404;
+                    errorMessage = QString("There is no feature with id %1").arg(*featureSettings->getFeatureType());
+                }
+            }
+        }
+        else if (operationType == "update")
+        {
+            operation.m_type = MainCore::BatchOperation::Update;
+            operation.m_index = swgOperation->getFeatureIndex();
+
+            if ((operation.m_index < 0) || (operation.m_index >= nbFeatures))
+            {
+                status = 404;
+                errorMessage = QString("There is no feature with index %1").arg(operation.m_index);
+            }
+            else if (!featureSettings || (i >= featureSettingsKeys.size()) || featureSettingsKeys[i].isEmpty())
+            {
+                status = 400;
+                errorMessage = QString("Feature settings are missing or invalid");
+            }
+        }
+        else
+        {
+            status = 400;
+            errorMessage = QString("Unknown operation \"%1\"").arg(operationType);
+        }
+
+        result->setIndex(operation.m_index);
+        result->setStatus(status);
+
+        if (status == 202)
+        {
+            if (featureSettings && (i < featureSettingsKeys.size()))
+            {
+                // Settings are moved to the message
+                operation.m_settingsKeys = featureSettingsKeys[i];
+                operation.m_featureSettings = featureSettings;
+                swgOperation->setSettings(nullptr);
+            }
+
+            operations.append(operation);
+            submittedResults.append(result);
+            *result->getMessage() = QString("Submitted");
+        }
+        else
+        {
+            *result->getMessage() = errorMessage;
+        }
+    }
+
+    if (operations.size() == 0)
+    {
+        error.init();
+        *error.getMessage() = QString("No operation was accepted");
+        return 400;
+    }
+
+    QSharedPointer<MainCore::BatchResults> results(new MainCore::BatchResults());
+    MainCore::MsgApplyFeaturesBatch *msg = MainCore::MsgApplyFeaturesBatch::create(featureSetIndex, operations, results);
+    m_mainCore->m_mainMessageQueue->push(msg);
+
+    return waitForBatchResults(results, submittedResults, response);
+}
+
 int WebAPIAdapter::featuresetFeatureDelete(
             int featureSetIndex,
             int featureIndex,
@@ -3794,6 +4248,64 @@ int WebAPIAdapter::featuresetFeatureWorkspacePut(
     }
 }
 
+int WebAPIAdapter::getChannelRegistrationIndex(
+    const DeviceSet *deviceSet,
+    int direction,
+    const QString& channelType,
+    int& registrationIndex,
+    QString& errorMessage)
+{
+    PluginAPI::ChannelRegistrations *channelRegistrations;
+
+    if (direction == 0) // Single Rx
+    {
+        if (!deviceSet->m_deviceSourceEngine && !deviceSet->m_deviceMIMOEngine)
+        {
+            errorMessage = QString("Device set at %1 is not a receive capable device set").arg(deviceSet->getIndex());
+            return 400;
+        }
+
+        channelRegistrations = m_mainCore->m_pluginManager->getRxChannelRegistrations();
+    }
+    else if (direction == 1) // Single Tx
+    {
+        if (!deviceSet->m_deviceSinkEngine && !deviceSet->m_deviceMIMOEngine)
+        {
+            errorMessage = QString("Device set at %1 is not a transmit capable device set").arg(deviceSet->getIndex());
+            return 400;
+        }
+
+        channelRegistrations = m_mainCore->m_pluginManager->getTxChannelRegistrations();
+    }
+    else if (direction == 2) // MIMO
+    {
+        if (!deviceSet->m_deviceMIMOEngine)
+        {
+            errorMessage = QString("Device set at %1 is not a MIMO capable device set").arg(deviceSet->getIndex());
+            return 400;
+        }
+
+        channelRegistrations = m_mainCore->m_pluginManager->getMIMOChannelRegistrations();
+    }
+    else
+    {
+        errorMessage = QString("Unknown channel direction %1").arg(direction);
+        return 400;
+    }
+
+    int nbRegistrations = channelRegistrations->size();
+
+    for (registrationIndex = 0; registrationIndex < nbRegistrations; registrationIndex++)
+    {
+        if (channelRegistrations->at(registrationIndex).m_channelId == channelType) {
+            return 200;
+        }
+    }
+
+    errorMessage = QString("There is no channel with id %1").arg(channelType);
+    return 404;
+}
+
 void WebAPIAdapter::getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList)
 {
     deviceSetList->init();
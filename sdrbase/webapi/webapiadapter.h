@@ -259,6 +259,41 @@ public:
             SWGSDRangel::SWGSuccessResponse& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int devicesetSpectrumWaterfallGet(
+            int deviceSetIndex,
+            const SpectrumWaterfall::TileRequest& request,
+            QByteArray& png,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumWaterfallPost(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumWaterfallDelete(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetIQHistoryPost(
+            int deviceSetIndex,
+            quint64 memoryBytes,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetIQHistoryDelete(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetIQHistoryCapturePost(
+            int deviceSetIndex,
+            qint64 startTime,
+            qint64 endTime,
+            const QString& fileName,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int devicesetSpectrumWorkspaceGet(
             int deviceSetIndex,
             SWGSDRangel::SWGWorkspaceInfo& response,
@@ -361,6 +396,13 @@ public:
             SWGSDRangel::SWGSuccessResponse& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int devicesetChannelsBatchPost(
+            int deviceSetIndex,
+            SWGSDRangel::SWGChannelsBatch& query,
+            const QList<QStringList>& channelSettingsKeys,
+            SWGSDRangel::SWGBatchResults& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int devicesetChannelSettingsGet(
             int deviceSetIndex,
             int channelIndex,
@@ -419,6 +461,13 @@ public:
             SWGSDRangel::SWGSuccessResponse& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int featuresetFeaturesBatchPost(
+            int featureSetIndex,
+            SWGSDRangel::SWGFeaturesBatch& query,
+            const QList<QStringList>& featureSettingsKeys,
+            SWGSDRangel::SWGBatchResults& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int featuresetFeatureRunGet(
             int featureSetIndex,
             int featureIndex,
@@ -498,6 +547,7 @@ private:
     void getDeviceSet(SWGSDRangel::SWGDeviceSet *swgDeviceSet, const DeviceSet* deviceSet, int deviceSetIndex);
     void getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channelsDetail, const DeviceSet* deviceSet);
     void getFeatureSet(SWGSDRangel::SWGFeatureSet *swgFeatureSet, const FeatureSet* featureSet);
+    int getChannelRegistrationIndex(const DeviceSet *deviceSet, int direction, const QString& channelType, int& registrationIndex, QString& errorMessage);
     static QtMsgType getMsgTypeFromString(const QString& msgTypeString);
     static void getMsgTypeString(const QtMsgType& msgType, QString& level);
 };
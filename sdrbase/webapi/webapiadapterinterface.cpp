@@ -47,11 +47,15 @@ QString WebAPIAdapterInterface::instanceWorkspaceURL = "/sdrangel/workspace";
 QString WebAPIAdapterInterface::featuresetURL("/sdrangel/featureset");
 QString WebAPIAdapterInterface::featuresetFeatureURL("/sdrangel/featureset/feature");
 QString WebAPIAdapterInterface::featuresetPresetURL("/sdrangel/featureset/preset");
+QString WebAPIAdapterInterface::featuresetFeaturesBatchURL("/sdrangel/featureset/features/batch");
 
 std::regex WebAPIAdapterInterface::devicesetURLRe("^/sdrangel/deviceset/([0-9]{1,2})$");
 std::regex WebAPIAdapterInterface::devicesetSpectrumSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/settings$");
 std::regex WebAPIAdapterInterface::devicesetSpectrumServerURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/server$");
+std::regex WebAPIAdapterInterface::devicesetSpectrumWaterfallURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/waterfall$");
 std::regex WebAPIAdapterInterface::devicesetSpectrumWorkspaceURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/workspace$");
+std::regex WebAPIAdapterInterface::devicesetIQHistoryURLRe("^/sdrangel/deviceset/([0-9]{1,2})/iqhistory$");
+std::regex WebAPIAdapterInterface::devicesetIQHistoryCaptureURLRe("^/sdrangel/deviceset/([0-9]{1,2})/iqhistory/capture$");
 std::regex WebAPIAdapterInterface::devicesetDeviceURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device$");
 std::regex WebAPIAdapterInterface::devicesetDeviceSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/settings$");
 std::regex WebAPIAdapterInterface::devicesetDeviceRunURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/run$");
@@ -60,6 +64,7 @@ std::regex WebAPIAdapterInterface::devicesetDeviceReportURLRe("^/sdrangel/device
 std::regex WebAPIAdapterInterface::devicesetDeviceActionsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/actions$");
 std::regex WebAPIAdapterInterface::devicesetDeviceWorkspaceURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/workspace$");
 std::regex WebAPIAdapterInterface::devicesetChannelsReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channels/report$");
+std::regex WebAPIAdapterInterface::devicesetChannelsBatchURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channels/batch$");
 std::regex WebAPIAdapterInterface::devicesetChannelURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel$");
 std::regex WebAPIAdapterInterface::devicesetChannelIndexURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})$");
 std::regex WebAPIAdapterInterface::devicesetChannelSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/settings$");
@@ -27,6 +27,7 @@
 #include "SWGErrorResponse.h"
 
 #include "export.h"
+#include "dsp/spectrumwaterfall.h"
 
 namespace SWGSDRangel
 {
@@ -66,6 +67,9 @@ namespace SWGSDRangel
     class SWGDeviceActions;
     class SWGWorkspaceInfo;
     class SWGChannelsDetail;
+    class SWGChannelsBatch;
+    class SWGFeaturesBatch;
+    class SWGBatchResults;
     class SWGChannelSettings;
     class SWGChannelReport;
     class SWGChannelActions;
@@ -977,6 +981,113 @@ public:
         return 501;
     }
 
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/waterfall (GET)
+     * returns the Http status code (default 501: not implemented)
+     * on success the response is a PNG image
+     */
+    virtual int devicesetSpectrumWaterfallGet(
+            int deviceSetIndex,
+            const SpectrumWaterfall::TileRequest& request,
+            QByteArray& png,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) request;
+        (void) png;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/waterfall (POST)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumWaterfallPost(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/waterfall (DELETE)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumWaterfallDelete(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/iqhistory (POST)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetIQHistoryPost(
+            int deviceSetIndex,
+            quint64 memoryBytes,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) memoryBytes;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/iqhistory (DELETE)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetIQHistoryDelete(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/iqhistory/capture (POST)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetIQHistoryCapturePost(
+            int deviceSetIndex,
+            qint64 startTime,
+            qint64 endTime,
+            const QString& fileName,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) startTime;
+        (void) endTime;
+        (void) fileName;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     /**
      * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/workspace (GET)
      * returns the Http status code (default 501: not implemented)
@@ -1183,6 +1294,27 @@ public:
         return 501;
     }
 
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/channels/batch (POST)
+     * channelSettingsKeys has the settings keys of each operation in the query
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetChannelsBatchPost(
+            int deviceSetIndex,
+            SWGSDRangel::SWGChannelsBatch& query,
+            const QList<QStringList>& channelSettingsKeys,
+            SWGSDRangel::SWGBatchResults& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) query;
+        (void) channelSettingsKeys;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     /**
      * Handler of /sdrangel/deviceset/{devicesetIndex}/channels/report (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
      * returns the Http status code (default 501: not implemented)
@@ -1426,6 +1558,27 @@ public:
     	return 501;
     }
 
+    /**
+     * Handler of /sdrangel/featureset/features/batch (POST)
+     * featureSettingsKeys has the settings keys of each operation in the query
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int featuresetFeaturesBatchPost(
+            int featureSetIndex,
+            SWGSDRangel::SWGFeaturesBatch& query,
+            const QList<QStringList>& featureSettingsKeys,
+            SWGSDRangel::SWGBatchResults& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) featureSetIndex;
+        (void) query;
+        (void) featureSettingsKeys;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     /**
      * Handler of /sdrangel/featureset/{featuresetIndex}/feature (POST)
      * returns the Http status code (default 501: not implemented)
@@ -1710,10 +1863,14 @@ public:
     static QString featuresetURL;
     static QString featuresetFeatureURL;
     static QString featuresetPresetURL;
+    static QString featuresetFeaturesBatchURL;
     static std::regex devicesetURLRe;
     static std::regex devicesetSpectrumSettingsURLRe;
     static std::regex devicesetSpectrumServerURLRe;
+    static std::regex devicesetSpectrumWaterfallURLRe;
     static std::regex devicesetSpectrumWorkspaceURLRe;
+    static std::regex devicesetIQHistoryURLRe;
+    static std::regex devicesetIQHistoryCaptureURLRe;
     static std::regex devicesetDeviceURLRe;
     static std::regex devicesetDeviceSettingsURLRe;
     static std::regex devicesetDeviceRunURLRe;
@@ -1728,6 +1885,7 @@ public:
     static std::regex devicesetChannelActionsURLRe;
     static std::regex devicesetChannelWorkspaceURLRe;
     static std::regex devicesetChannelsReportURLRe;
+    static std::regex devicesetChannelsBatchURLRe;
     static std::regex featuresetFeatureIndexURLRe;
     static std::regex featuresetFeatureRunURLRe;
     static std::regex featuresetFeatureSettingsURLRe;
@@ -18,12 +18,14 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QDirIterator>
+#include <QDateTime>
 #include <QJsonDocument>
 #include <QJsonArray>
 
 #include <boost/lexical_cast.hpp>
 
 #include "httpdocrootsettings.h"
+#include "dsp/iqhistory.h"
 #include "webapirequestmapper.h"
 #include "webapiutils.h"
 #include "SWGInstanceSummaryResponse.h"
@@ -53,6 +55,8 @@
 #include "SWGWorkspaceInfo.h"
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
+#include "SWGChannelsBatch.h"
+#include "SWGChannelsBatchOperation.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
 #include "SWGSuccessResponse.h"
@@ -60,6 +64,9 @@
 #include "SWGFeaturePresets.h"
 #include "SWGFeaturePresetIdentifier.h"
 #include "SWGFeatureSettings.h"
+#include "SWGFeaturesBatch.h"
+#include "SWGFeaturesBatchOperation.h"
+#include "SWGBatchResults.h"
 #include "SWGFeatureReport.h"
 #include "SWGFeatureActions.h"
 #include "SWGGLSpectrum.h"
@@ -169,6 +176,8 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
             featuresetFeatureService(request, response);
         } else if (path == WebAPIAdapterInterface::featuresetPresetURL) {
             featuresetPresetService(request, response);
+        } else if (path == WebAPIAdapterInterface::featuresetFeaturesBatchURL) {
+            featuresetFeaturesBatchService(request, response);
         }
         else
         {
@@ -183,8 +192,14 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
                 devicesetSpectrumSettingsService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumServerURLRe)) {
                 devicesetSpectrumServerService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumWaterfallURLRe)) {
+                devicesetSpectrumWaterfallService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumWorkspaceURLRe)) {
                 devicesetSpectrumWorkspaceService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetIQHistoryURLRe)) {
+                devicesetIQHistoryService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetIQHistoryCaptureURLRe)) {
+                devicesetIQHistoryCaptureService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceSettingsURLRe)) {
                 devicesetDeviceSettingsService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceRunURLRe)) {
@@ -199,6 +214,8 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
                 devicesetDeviceWorkspaceService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsReportURLRe)) {
                 devicesetChannelsReportService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsBatchURLRe)) {
+                devicesetChannelsBatchService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelURLRe)) {
                 devicesetChannelService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelIndexURLRe)) {
@@ -1903,6 +1920,228 @@ void WebAPIRequestMapper::devicesetSpectrumServerService(const std::string& inde
     }
 }
 
+void WebAPIRequestMapper::devicesetSpectrumWaterfallService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            SpectrumWaterfall::TileRequest tileRequest;
+            tileRequest.m_colorMap.clear(); // use spectrum colour map by default
+
+            QByteArray startTimeStr = request.getParameter("startTime");
+            QByteArray endTimeStr = request.getParameter("endTime");
+            QByteArray startFrequencyStr = request.getParameter("startFrequency");
+            QByteArray endFrequencyStr = request.getParameter("endFrequency");
+            QByteArray widthStr = request.getParameter("width");
+            QByteArray heightStr = request.getParameter("height");
+            QByteArray colorMapStr = request.getParameter("colorMap");
+
+            if (startTimeStr.length() != 0) {
+                tileRequest.m_startTime = startTimeStr.toLongLong();
+            }
+            if (endTimeStr.length() != 0) {
+                tileRequest.m_endTime = endTimeStr.toLongLong();
+            }
+            if (startFrequencyStr.length() != 0) {
+                tileRequest.m_startFrequency = startFrequencyStr.toLongLong();
+            }
+            if (endFrequencyStr.length() != 0) {
+                tileRequest.m_endFrequency = endFrequencyStr.toLongLong();
+            }
+            if (widthStr.length() != 0) {
+                tileRequest.m_width = widthStr.toInt();
+            }
+            if (heightStr.length() != 0) {
+                tileRequest.m_height = heightStr.toInt();
+            }
+            if (colorMapStr.length() != 0) {
+                tileRequest.m_colorMap = QString(colorMapStr);
+            }
+
+            QByteArray png;
+            int status = m_adapter->devicesetSpectrumWaterfallGet(deviceSetIndex, tileRequest, png, errorResponse);
+
+            response.setStatus(status);
+
+            if (status/100 == 2)
+            {
+                response.setHeader("Content-Type", "image/png");
+                response.write(png);
+            }
+            else
+            {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "POST")
+        {
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetSpectrumWaterfallPost(deviceSetIndex, normalResponse, errorResponse);
+
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "DELETE")
+        {
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetSpectrumWaterfallDelete(deviceSetIndex, normalResponse, errorResponse);
+
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetIQHistoryService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "POST")
+        {
+            quint64 memoryBytes = IQHistory::m_defaultMemoryBudget;
+            QByteArray memoryStr = request.getParameter("memory"); // MB
+
+            if (memoryStr.length() != 0) {
+                memoryBytes = memoryStr.toULongLong() * 1024 * 1024;
+            }
+
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetIQHistoryPost(deviceSetIndex, memoryBytes, normalResponse, errorResponse);
+
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "DELETE")
+        {
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetIQHistoryDelete(deviceSetIndex, normalResponse, errorResponse);
+
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetIQHistoryCaptureService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "POST")
+        {
+            // Window is either startTime to endTime in ms since epoch or duration seconds before endTime (default now)
+            qint64 endTime = QDateTime::currentMSecsSinceEpoch();
+            QByteArray startTimeStr = request.getParameter("startTime");
+            QByteArray endTimeStr = request.getParameter("endTime");
+            QByteArray durationStr = request.getParameter("duration");
+            QString fileName(request.getParameter("fileName"));
+
+            if (endTimeStr.length() != 0) {
+                endTime = endTimeStr.toLongLong();
+            }
+
+            qint64 startTime = endTime - 10000;
+
+            if (startTimeStr.length() != 0) {
+                startTime = startTimeStr.toLongLong();
+            } else if (durationStr.length() != 0) {
+                startTime = endTime - (qint64) (durationStr.toDouble() * 1000.0);
+            }
+
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetIQHistoryCapturePost(deviceSetIndex, startTime, endTime, fileName, normalResponse, errorResponse);
+
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::devicesetSpectrumWorkspaceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -2483,6 +2722,74 @@ void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& inde
     }
 }
 
+void WebAPIRequestMapper::devicesetChannelsBatchService(
+        const std::string& deviceSetIndexStr,
+        qtwebapp::HttpRequest& request,
+        qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
+
+        if (request.getMethod() == "POST")
+        {
+            QString jsonStr = request.getBody();
+            QJsonObject jsonObject;
+
+            if (parseJsonBody(jsonStr, jsonObject, response))
+            {
+                SWGSDRangel::SWGChannelsBatch query;
+                SWGSDRangel::SWGBatchResults normalResponse;
+                QList<QStringList> channelSettingsKeys;
+
+                if (parseChannelsBatch(jsonObject, query, channelSettingsKeys))
+                {
+                    int status = m_adapter->devicesetChannelsBatchPost(deviceSetIndex, query, channelSettingsKeys, normalResponse, errorResponse);
+                    response.setStatus(status);
+
+                    if ((status/100 == 2) || normalResponse.isSet()) {
+                        response.write(normalResponse.asJson().toUtf8());
+                    } else {
+                        response.write(errorResponse.asJson().toUtf8());
+                    }
+                }
+                else
+                {
+                    response.setStatus(400,"Invalid JSON request");
+                    errorResponse.init();
+                    *errorResponse.getMessage() = "Invalid JSON request";
+                    response.write(errorResponse.asJson().toUtf8());
+                }
+            }
+            else
+            {
+                response.setStatus(400,"Invalid JSON format");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Invalid JSON format";
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::devicesetChannelService(
         const std::string& deviceSetIndexStr,
         qtwebapp::HttpRequest& request,
@@ -2931,6 +3238,61 @@ void WebAPIRequestMapper::featuresetService(qtwebapp::HttpRequest& request, qtwe
     }
 }
 
+void WebAPIRequestMapper::featuresetFeaturesBatchService(
+        qtwebapp::HttpRequest& request,
+        qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "POST")
+    {
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
+
+        if (parseJsonBody(jsonStr, jsonObject, response))
+        {
+            SWGSDRangel::SWGFeaturesBatch query;
+            SWGSDRangel::SWGBatchResults normalResponse;
+            QList<QStringList> featureSettingsKeys;
+
+            if (parseFeaturesBatch(jsonObject, query, featureSettingsKeys))
+            {
+                int status = m_adapter->featuresetFeaturesBatchPost(0, query, featureSettingsKeys, normalResponse, errorResponse);
+                response.setStatus(status);
+
+                if ((status/100 == 2) || normalResponse.isSet()) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
+                    response.write(errorResponse.asJson().toUtf8());
+                }
+            }
+            else
+            {
+                response.setStatus(400,"Invalid JSON request");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Invalid JSON request";
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(400,"Invalid JSON format");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid JSON format";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::featuresetFeatureService(
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
@@ -3844,6 +4206,106 @@ bool WebAPIRequestMapper::validateFeatureSettings(
     }
 }
 
+// Settings that cannot be validated are left out of the operation. The adapter reports
+// an error for updates without settings. Adds only need channel type and direction.
+bool WebAPIRequestMapper::parseChannelsBatch(
+        QJsonObject& jsonObject,
+        SWGSDRangel::SWGChannelsBatch& channelsBatch,
+        QList<QStringList>& channelSettingsKeys)
+{
+    if (!jsonObject.contains("operations") || !jsonObject["operations"].isArray()) {
+        return false;
+    }
+
+    QJsonArray operationsJson = jsonObject["operations"].toArray();
+    QList<SWGSDRangel::SWGChannelsBatchOperation*> *operations = new QList<SWGSDRangel::SWGChannelsBatchOperation*>();
+    channelsBatch.setOperations(operations);
+
+    for (const auto& operationValue : operationsJson)
+    {
+        if (!operationValue.isObject()) {
+            return false;
+        }
+
+        QJsonObject operationJson = operationValue.toObject();
+        SWGSDRangel::SWGChannelsBatchOperation *operation = new SWGSDRangel::SWGChannelsBatchOperation();
+        operations->append(operation);
+        channelSettingsKeys.append(QStringList());
+        operation->setOperation(new QString(operationJson["operation"].toString()));
+
+        if (operationJson.contains("channelIndex")) {
+            operation->setChannelIndex(operationJson["channelIndex"].toInt());
+        }
+
+        if (operationJson.contains("settings") && operationJson["settings"].isObject())
+        {
+            QJsonObject settingsJson = operationJson["settings"].toObject();
+            SWGSDRangel::SWGChannelSettings *channelSettings = new SWGSDRangel::SWGChannelSettings();
+
+            if (validateChannelSettings(*channelSettings, settingsJson, channelSettingsKeys.back())
+            || ((*operation->getOperation() == "add") && channelSettings->getChannelType()))
+            {
+                operation->setSettings(channelSettings);
+            }
+            else
+            {
+                delete channelSettings;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool WebAPIRequestMapper::parseFeaturesBatch(
+        QJsonObject& jsonObject,
+        SWGSDRangel::SWGFeaturesBatch& featuresBatch,
+        QList<QStringList>& featureSettingsKeys)
+{
+    if (!jsonObject.contains("operations") || !jsonObject["operations"].isArray()) {
+        return false;
+    }
+
+    QJsonArray operationsJson = jsonObject["operations"].toArray();
+    QList<SWGSDRangel::SWGFeaturesBatchOperation*> *operations = new QList<SWGSDRangel::SWGFeaturesBatchOperation*>();
+    featuresBatch.setOperations(operations);
+
+    for (const auto& operationValue : operationsJson)
+    {
+        if (!operationValue.isObject()) {
+            return false;
+        }
+
+        QJsonObject operationJson = operationValue.toObject();
+        SWGSDRangel::SWGFeaturesBatchOperation *operation = new SWGSDRangel::SWGFeaturesBatchOperation();
+        operations->append(operation);
+        featureSettingsKeys.append(QStringList());
+        operation->setOperation(new QString(operationJson["operation"].toString()));
+
+        if (operationJson.contains("featureIndex")) {
+            operation->setFeatureIndex(operationJson["featureIndex"].toInt());
+        }
+
+        if (operationJson.contains("settings") && operationJson["settings"].isObject())
+        {
+            QJsonObject settingsJson = operationJson["settings"].toObject();
+            SWGSDRangel::SWGFeatureSettings *featureSettings = new SWGSDRangel::SWGFeatureSettings();
+
+            if (validateFeatureSettings(*featureSettings, settingsJson, featureSettingsKeys.back())
+            || ((*operation->getOperation() == "add") && featureSettings->getFeatureType()))
+            {
+                operation->setSettings(featureSettings);
+            }
+            else
+            {
+                delete featureSettings;
+            }
+        }
+    }
+
+    return true;
+}
+
 bool WebAPIRequestMapper::validateFeatureActions(
     SWGSDRangel::SWGFeatureActions& featureActions,
     QJsonObject& jsonObject,
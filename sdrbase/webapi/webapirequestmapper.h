@@ -50,6 +50,11 @@ public:
     void service(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void setAdapter(WebAPIAdapterInterface *adapter) { m_adapter = adapter; }
 
+    // Also used by the web socket reports server
+    static void resetDeviceReport(SWGSDRangel::SWGDeviceReport& deviceReport);
+    static void resetChannelReport(SWGSDRangel::SWGChannelReport& channelReport);
+    static void resetFeatureReport(SWGSDRangel::SWGFeatureReport& featureReport);
+
 private:
     WebAPIAdapterInterface *m_adapter;
     qtwebapp::StaticFileController *m_staticFileController;
@@ -83,7 +88,10 @@ private:
     void devicesetService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetSpectrumSettingsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetSpectrumServerService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetSpectrumWaterfallService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetSpectrumWorkspaceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetIQHistoryService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetIQHistoryCaptureService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetDeviceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetDeviceSettingsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetDeviceRunService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
@@ -92,6 +100,7 @@ private:
     void devicesetDeviceActionsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetDeviceWorkspaceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetChannelsReportService(const std::string& deviceSetIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelsBatchService(const std::string& deviceSetIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetChannelService(const std::string& deviceSetIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetChannelIndexService(const std::string& deviceSetIndexStr, const std::string& channelIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void devicesetChannelSettingsService(const std::string& deviceSetIndexStr, const std::string& channelIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
@@ -101,6 +110,7 @@ private:
 
     void featuresetService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void featuresetFeatureService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void featuresetFeaturesBatchService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void featuresetPresetService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void featuresetFeatureIndexService(const std::string& featureIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void featuresetFeatureRunService(const std::string& featureIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
@@ -120,6 +130,8 @@ private:
     bool validateChannelActions(SWGSDRangel::SWGChannelActions& channelActions, QJsonObject& jsonObject, QStringList& channelActionsKeys);
     bool validateFeaturePresetIdentifer(SWGSDRangel::SWGFeaturePresetIdentifier& presetIdentifier);
     bool validateFeatureSettings(SWGSDRangel::SWGFeatureSettings& featureSettings, QJsonObject& jsonObject, QStringList& featureSettingsKeys);
+    bool parseChannelsBatch(QJsonObject& jsonObject, SWGSDRangel::SWGChannelsBatch& channelsBatch, QList<QStringList>& channelSettingsKeys);
+    bool parseFeaturesBatch(QJsonObject& jsonObject, SWGSDRangel::SWGFeaturesBatch& featuresBatch, QList<QStringList>& featureSettingsKeys);
     bool validateFeatureActions(SWGSDRangel::SWGFeatureActions& featureActions, QJsonObject& jsonObject, QStringList& featureActionsKeys);
     bool validateAudioInputDevice(SWGSDRangel::SWGAudioInputDevice& audioInputDevice, QJsonObject& jsonObject, QStringList& audioInputDeviceKeys);
     bool validateAudioOutputDevice(SWGSDRangel::SWGAudioOutputDevice& audioOutputDevice, QJsonObject& jsonObject, QStringList& audioOutputDeviceKeys);
@@ -208,15 +220,12 @@ private:
 
     void resetSpectrumSettings(SWGSDRangel::SWGGLSpectrum& spectrumSettings);
     void resetDeviceSettings(SWGSDRangel::SWGDeviceSettings& deviceSettings);
-    void resetDeviceReport(SWGSDRangel::SWGDeviceReport& deviceReport);
     void resetDeviceActions(SWGSDRangel::SWGDeviceActions& deviceActions);
     void resetChannelSettings(SWGSDRangel::SWGChannelSettings& deviceSettings);
-    void resetChannelReport(SWGSDRangel::SWGChannelReport& channelReport);
     void resetChannelActions(SWGSDRangel::SWGChannelActions& channelActions);
     void resetAudioInputDevice(SWGSDRangel::SWGAudioInputDevice& audioInputDevice);
     void resetAudioOutputDevice(SWGSDRangel::SWGAudioOutputDevice& audioOutputDevice);
     void resetFeatureSettings(SWGSDRangel::SWGFeatureSettings& deviceSettings);
-    void resetFeatureReport(SWGSDRangel::SWGFeatureReport& featureReport);
     void resetFeatureActions(SWGSDRangel::SWGFeatureActions& featureActions);
 
     static const QMap<QString, QString> m_channelURIToSettingsKey;
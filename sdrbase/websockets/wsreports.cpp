@@ -0,0 +1,487 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <regex>
+
+#include <QtWebSockets>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QDebug>
+
+#include "SWGDeviceReport.h"
+#include "SWGChannelsDetail.h"
+#include "SWGChannelReport.h"
+#include "SWGFeatureReport.h"
+#include "SWGErrorResponse.h"
+
+#include "webapi/webapiadapterinterface.h"
+#include "webapi/webapirequestmapper.h"
+#include "wsreports.h"
+
+WSReports::WSReports(WebAPIAdapterInterface *adapter, QObject *parent) :
+    QObject(parent),
+    m_adapter(adapter),
+    m_listeningAddress(QHostAddress::LocalHost),
+    m_port(8092),
+    m_webSocketServer(nullptr)
+{
+    connect(&m_timer, &QTimer::timeout, this, &WSReports::tick);
+}
+
+WSReports::~WSReports()
+{
+    m_timer.stop();
+    closeSocket();
+}
+
+void WSReports::openSocket()
+{
+    m_webSocketServer = new QWebSocketServer(
+        QStringLiteral("Reports Server"),
+        QWebSocketServer::NonSecureMode,
+        this);
+
+    if (m_webSocketServer->listen(m_listeningAddress, m_port))
+    {
+        qDebug() << "WSReports::openSocket: reports server listening at " << m_listeningAddress.toString() << " on port " << m_port;
+        connect(m_webSocketServer, &QWebSocketServer::newConnection, this, &WSReports::onNewConnection);
+    }
+    else
+    {
+        qInfo("WSReports::openSocket: cannot start reports server at %s on port %u", qPrintable(m_listeningAddress.toString()), m_port);
+    }
+}
+
+void WSReports::closeSocket()
+{
+    m_timer.stop();
+    qDeleteAll(m_subscriptions);
+    m_subscriptions.clear();
+
+    for (QWebSocket *pClient : qAsConst(m_clients))
+    {
+        pClient->disconnect(this);
+        pClient->close();
+        pClient->deleteLater();
+    }
+
+    m_clients.clear();
+
+    if (m_webSocketServer)
+    {
+        qDebug() << "WSReports::closeSocket: stopping reports server listening at " << m_listeningAddress.toString() << " on port " << m_port;
+        delete m_webSocketServer;
+        m_webSocketServer = nullptr;
+    }
+}
+
+bool WSReports::socketOpened() const
+{
+    return m_webSocketServer && m_webSocketServer->isListening();
+}
+
+void WSReports::setListeningAddress(const QString& address)
+{
+    if (address == "127.0.0.1") {
+        m_listeningAddress.setAddress(QHostAddress::LocalHost);
+    } else if ((address == "0.0.0.0") || address.isEmpty()) {
+        m_listeningAddress.setAddress(QHostAddress::Any);
+    } else {
+        m_listeningAddress.setAddress(address);
+    }
+}
+
+QHostAddress WSReports::getListeningAddress() const
+{
+    if (m_webSocketServer) {
+        return m_webSocketServer->serverAddress();
+    } else {
+        return QHostAddress::Null;
+    }
+}
+
+uint16_t WSReports::getListeningPort() const
+{
+    if (m_webSocketServer) {
+        return m_webSocketServer->serverPort();
+    } else {
+        return 0;
+    }
+}
+
+QString WSReports::getWebSocketIdentifier(QWebSocket *peer)
+{
+    return QStringLiteral("%1:%2").arg(peer->peerAddress().toString(), QString::number(peer->peerPort()));
+}
+
+QString WSReports::getSubscriptionKey(const QString& topic, int periodMs, const QStringList& fields)
+{
+    return QString("%1|%2|%3").arg(topic).arg(periodMs).arg(fields.join(","));
+}
+
+bool WSReports::parseTopic(const QString& topic, TopicType& type, int& setIndex, int& index)
+{
+    std::string topicStr = topic.toStdString();
+    std::smatch match;
+    index = 0;
+
+    if (std::regex_match(topicStr, match, WebAPIAdapterInterface::devicesetDeviceReportURLRe))
+    {
+        type = TopicDeviceReport;
+        setIndex = std::stoi(match[1]);
+    }
+    else if (std::regex_match(topicStr, match, WebAPIAdapterInterface::devicesetChannelsReportURLRe))
+    {
+        type = TopicChannelsReport;
+        setIndex = std::stoi(match[1]);
+    }
+    else if (std::regex_match(topicStr, match, WebAPIAdapterInterface::devicesetChannelReportURLRe))
+    {
+        type = TopicChannelReport;
+        setIndex = std::stoi(match[1]);
+        index = std::stoi(match[2]);
+    }
+    else if (std::regex_match(topicStr, match, WebAPIAdapterInterface::featuresetFeatureReportURLRe))
+    {
+        type = TopicFeatureReport;
+        setIndex = 0;
+        index = std::stoi(match[1]);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void WSReports::onNewConnection()
+{
+    auto pSocket = m_webSocketServer->nextPendingConnection();
+    qDebug() << "WSReports::onNewConnection: " << getWebSocketIdentifier(pSocket) << " connected";
+    pSocket->setParent(this);
+
+    connect(pSocket, &QWebSocket::textMessageReceived, this, &WSReports::processClientMessage);
+    connect(pSocket, &QWebSocket::disconnected, this, &WSReports::socketDisconnected);
+
+    m_clients << pSocket;
+}
+
+void WSReports::socketDisconnected()
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (pClient)
+    {
+        qDebug() << "WSReports::socketDisconnected: " << getWebSocketIdentifier(pClient) << " disconnected";
+        removeClient(pClient);
+        m_clients.removeAll(pClient);
+        pClient->deleteLater();
+    }
+}
+
+void WSReports::processClientMessage(const QString &message)
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (!pClient) {
+        return;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &error);
+
+    if (doc.isNull() || !doc.isObject())
+    {
+        sendError(pClient, QString("Invalid JSON: %1").arg(error.errorString()));
+        return;
+    }
+
+    QJsonObject request = doc.object();
+
+    if (request.contains("subscribe")) {
+        subscribe(pClient, request);
+    } else if (request.contains("unsubscribe")) {
+        unsubscribe(pClient, request.value("unsubscribe").toString());
+    } else {
+        sendError(pClient, "Expecting subscribe or unsubscribe");
+    }
+}
+
+void WSReports::subscribe(QWebSocket *client, const QJsonObject& request)
+{
+    QString topic = request.value("subscribe").toString();
+    TopicType type;
+    int setIndex, index;
+
+    if (!parseTopic(topic, type, setIndex, index))
+    {
+        sendError(client, QString("Invalid topic: %1").arg(topic));
+        return;
+    }
+
+    int periodMs = request.value("period").toInt(1000);
+    periodMs = periodMs < m_minPeriodMs ? m_minPeriodMs : periodMs;
+    QStringList fields;
+
+    for (const auto& field : request.value("fields").toArray()) {
+        fields.append(field.toString());
+    }
+
+    fields.sort();
+    fields.removeDuplicates();
+
+    // A client has only one subscription per topic
+    unsubscribe(client, topic);
+
+    QString key = getSubscriptionKey(topic, periodMs, fields);
+    Subscription *subscription = m_subscriptions.value(key, nullptr);
+
+    if (!subscription)
+    {
+        subscription = new Subscription();
+        subscription->m_topic = topic;
+        subscription->m_type = type;
+        subscription->m_setIndex = setIndex;
+        subscription->m_index = index;
+        subscription->m_periodMs = periodMs;
+        subscription->m_fields = fields;
+        subscription->m_nextTime = QDateTime::currentMSecsSinceEpoch();
+        m_subscriptions.insert(key, subscription);
+    }
+
+    subscription->m_clients.append(client);
+    qDebug("WSReports::subscribe: %s: %s every %d ms (%d subscriptions)",
+        qPrintable(getWebSocketIdentifier(client)), qPrintable(topic), periodMs, m_subscriptions.size());
+
+    if (!m_timer.isActive()) {
+        m_timer.start(m_tickMs);
+    }
+}
+
+void WSReports::unsubscribe(QWebSocket *client, const QString& topic)
+{
+    QMap<QString, Subscription*>::iterator it = m_subscriptions.begin();
+
+    while (it != m_subscriptions.end())
+    {
+        Subscription *subscription = it.value();
+
+        if (subscription->m_topic == topic) {
+            subscription->m_clients.removeAll(client);
+        }
+
+        if (subscription->m_clients.isEmpty())
+        {
+            delete subscription;
+            it = m_subscriptions.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (m_subscriptions.isEmpty()) {
+        m_timer.stop();
+    }
+}
+
+void WSReports::removeClient(QWebSocket *client)
+{
+    QMap<QString, Subscription*>::iterator it = m_subscriptions.begin();
+
+    while (it != m_subscriptions.end())
+    {
+        Subscription *subscription = it.value();
+        subscription->m_clients.removeAll(client);
+
+        if (subscription->m_clients.isEmpty())
+        {
+            delete subscription;
+            it = m_subscriptions.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (m_subscriptions.isEmpty()) {
+        m_timer.stop();
+    }
+}
+
+void WSReports::sendError(QWebSocket *client, const QString& message)
+{
+    qDebug("WSReports::sendError: %s: %s", qPrintable(getWebSocketIdentifier(client)), qPrintable(message));
+    QJsonObject error;
+    error.insert("error", message);
+    client->sendTextMessage(QJsonDocument(error).toJson(QJsonDocument::Compact));
+}
+
+int WSReports::getReport(const Subscription& subscription, QJsonObject& report, QString& errorMessage)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    QJsonObject *jsonObj = nullptr;
+    int status;
+
+    switch (subscription.m_type)
+    {
+    case TopicDeviceReport:
+    {
+        SWGSDRangel::SWGDeviceReport response;
+        WebAPIRequestMapper::resetDeviceReport(response);
+        status = m_adapter->devicesetDeviceReportGet(subscription.m_setIndex, response, errorResponse);
+
+        if (status/100 == 2) {
+            jsonObj = response.asJsonObject();
+        }
+        break;
+    }
+    case TopicChannelsReport:
+    {
+        SWGSDRangel::SWGChannelsDetail response;
+        status = m_adapter->devicesetChannelsReportGet(subscription.m_setIndex, response, errorResponse);
+
+        if (status/100 == 2) {
+            jsonObj = response.asJsonObject();
+        }
+        break;
+    }
+    case TopicChannelReport:
+    {
+        SWGSDRangel::SWGChannelReport response;
+        WebAPIRequestMapper::resetChannelReport(response);
+        status = m_adapter->devicesetChannelReportGet(subscription.m_setIndex, subscription.m_index, response, errorResponse);
+
+        if (status/100 == 2) {
+            jsonObj = response.asJsonObject();
+        }
+        break;
+    }
+    case TopicFeatureReport:
+    default:
+    {
+        SWGSDRangel::SWGFeatureReport response;
+        WebAPIRequestMapper::resetFeatureReport(response);
+        status = m_adapter->featuresetFeatureReportGet(subscription.m_index, response, errorResponse);
+
+        if (status/100 == 2) {
+            jsonObj = response.asJsonObject();
+        }
+        break;
+    }
+    }
+
+    if (jsonObj)
+    {
+        report = *jsonObj;
+        delete jsonObj;
+    }
+    else
+    {
+        errorMessage = errorResponse.getMessage() ? *errorResponse.getMessage() : QString("Error %1").arg(status);
+    }
+
+    return status;
+}
+
+// Keep only requested fields of the plugin specific report (e.g. "AMDemodReport") leaving the
+// identification fields (channelType, direction...) untouched
+void WSReports::applyFields(QJsonObject& report, const QStringList& fields)
+{
+    if (fields.isEmpty()) {
+        return;
+    }
+
+    for (QJsonObject::iterator it = report.begin(); it != report.end(); ++it)
+    {
+        if (!it.value().isObject()) {
+            continue;
+        }
+
+        QJsonObject pluginReport = it.value().toObject();
+        QJsonObject masked;
+
+        for (const auto& field : fields)
+        {
+            if (pluginReport.contains(field)) {
+                masked.insert(field, pluginReport.value(field));
+            }
+        }
+
+        it.value() = masked;
+    }
+}
+
+void WSReports::tick()
+{
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    // Reports fetched during this tick by topic so subscriptions with different
+    // periods or fields hitting the same tick query the channel only once
+    QHash<QString, QJsonObject> reports;
+    QHash<QString, QString> errors;
+
+    for (auto subscription : m_subscriptions)
+    {
+        if (now < subscription->m_nextTime) {
+            continue;
+        }
+
+        subscription->m_nextTime += subscription->m_periodMs;
+
+        if (subscription->m_nextTime <= now) { // fell behind - do not burst
+            subscription->m_nextTime = now + subscription->m_periodMs;
+        }
+
+        if (!reports.contains(subscription->m_topic) && !errors.contains(subscription->m_topic))
+        {
+            QJsonObject report;
+            QString errorMessage;
+
+            if (getReport(*subscription, report, errorMessage)/100 == 2) {
+                reports.insert(subscription->m_topic, report);
+            } else {
+                errors.insert(subscription->m_topic, errorMessage);
+            }
+        }
+
+        QJsonObject message;
+        message.insert("topic", subscription->m_topic);
+        message.insert("timestamp", now);
+
+        if (reports.contains(subscription->m_topic))
+        {
+            QJsonObject report = reports.value(subscription->m_topic);
+            applyFields(report, subscription->m_fields);
+            message.insert("report", report);
+        }
+        else
+        {
+            message.insert("error", errors.value(subscription->m_topic));
+        }
+
+        // Serialized once for all clients of the subscription
+        QString payload = QString::fromUtf8(QJsonDocument(message).toJson(QJsonDocument::Compact));
+
+        for (QWebSocket *pClient : qAsConst(subscription->m_clients)) {
+            pClient->sendTextMessage(payload);
+        }
+    }
+}
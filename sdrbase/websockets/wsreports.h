@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBSOCKETS_WSREPORTS_H_
+#define SDRBASE_WEBSOCKETS_WSREPORTS_H_
+
+#include <QObject>
+#include <QList>
+#include <QMap>
+#include <QHash>
+#include <QTimer>
+#include <QStringList>
+#include <QJsonObject>
+#include <QHostAddress>
+
+#include "export.h"
+
+class QWebSocketServer;
+class QWebSocket;
+class WebAPIAdapterInterface;
+
+// Pushes device, channel and feature reports to web socket clients so they do not have to poll
+// the REST API. Clients subscribe to a report path of the REST API (the topic) with a period
+// and an optional list of fields. Each report is fetched and serialized once per period
+// whatever the number of subscribers:
+//
+// {"subscribe": "/sdrangel/deviceset/0/channel/1/report", "period": 1000, "fields": ["channelPowerDB"]}
+// {"unsubscribe": "/sdrangel/deviceset/0/channel/1/report"}
+//
+// Pushed messages are: {"topic": "...", "timestamp": <ms since epoch>, "report": {...}}
+// or with "error" in place of "report" if the report cannot be obtained.
+class SDRBASE_API WSReports : public QObject
+{
+    Q_OBJECT
+public:
+    explicit WSReports(WebAPIAdapterInterface *adapter, QObject *parent = nullptr);
+    ~WSReports() override;
+
+    void openSocket();
+    void closeSocket();
+    bool socketOpened() const;
+    void setListeningAddress(const QString& address);
+    void setPort(quint16 port) { m_port = port; }
+    QHostAddress getListeningAddress() const;
+    uint16_t getListeningPort() const;
+
+    static const int m_minPeriodMs = 100;  //!< Fastest rate a client may request
+    static const int m_tickMs = 50;        //!< Scheduling granularity
+
+private:
+    enum TopicType {
+        TopicDeviceReport,
+        TopicChannelsReport,
+        TopicChannelReport,
+        TopicFeatureReport
+    };
+
+    // Clients with same topic, period and fields share the same serialized message
+    struct Subscription
+    {
+        QString m_topic;
+        TopicType m_type;
+        int m_setIndex;
+        int m_index;
+        int m_periodMs;
+        QStringList m_fields;       //!< Empty for all fields
+        QList<QWebSocket*> m_clients;
+        qint64 m_nextTime;          //!< Next push in ms since epoch
+    };
+
+    WebAPIAdapterInterface *m_adapter;
+    QHostAddress m_listeningAddress;
+    quint16 m_port;
+    QWebSocketServer* m_webSocketServer;
+    QList<QWebSocket*> m_clients;
+    QMap<QString, Subscription*> m_subscriptions; //!< By topic, period and fields
+    QTimer m_timer;
+
+    static QString getWebSocketIdentifier(QWebSocket *peer);
+    static QString getSubscriptionKey(const QString& topic, int periodMs, const QStringList& fields);
+    static bool parseTopic(const QString& topic, TopicType& type, int& setIndex, int& index);
+    static void applyFields(QJsonObject& report, const QStringList& fields);
+    void subscribe(QWebSocket *client, const QJsonObject& request);
+    void unsubscribe(QWebSocket *client, const QString& topic);
+    void removeClient(QWebSocket *client);
+    int getReport(const Subscription& subscription, QJsonObject& report, QString& errorMessage);
+    void sendError(QWebSocket *client, const QString& message);
+
+private slots:
+    void onNewConnection();
+    void processClientMessage(const QString &message);
+    void socketDisconnected();
+    void tick();
+};
+
+#endif // SDRBASE_WEBSOCKETS_WSREPORTS_H_
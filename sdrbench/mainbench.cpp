@@ -62,6 +62,12 @@ void MainBench::run()
         testDecimateFF();
     } else if (m_parser.getTestType() == ParserBench::TestGolay2312) {
         testGolay2312();
+    } else if (m_parser.getTestType() == ParserBench::TestUpChannelizer) {
+        testUpChannelizer();
+    } else if (m_parser.getTestType() == ParserBench::TestDownChannelizer) {
+        testDownChannelizer();
+    } else if (m_parser.getTestType() == ParserBench::TestResampler) {
+        testResampler();
     } else {
         qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
     }
@@ -54,6 +54,9 @@ private:
     void testDecimateFI();
     void testDecimateFF();
     void testGolay2312();
+    void testUpChannelizer();
+    void testDownChannelizer();
+    void testResampler();
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
@@ -24,7 +24,7 @@
 
 ParserBench::ParserBench() :
     m_testOption(QStringList() << "t" << "test",
-        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe, golay2312",
+        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe, golay2312, upchannelizer, downchannelizer, resampler",
         "test",
         "decimateii"),
     m_nbSamplesOption(QStringList() << "n" << "nb-samples",
@@ -38,12 +38,17 @@ ParserBench::ParserBench() :
     m_log2FactorOption(QStringList() << "l" << "log2-factor",
         "Log2 factor for rate conversion.",
         "log2",
-        "2")
+        "2"),
+    m_nbChannelsOption(QStringList() << "c" << "channels",
+        "Number of channels.",
+        "channels",
+        "4")
 {
     m_testStr = "decimateii";
     m_nbSamples = 1048576;
     m_repetition = 1;
     m_log2Factor = 4;
+    m_nbChannels = 4;
 
     m_parser.setApplicationDescription("Software Defined Radio application benchmarks");
     m_parser.addHelpOption();
@@ -53,6 +58,7 @@ ParserBench::ParserBench() :
     m_parser.addOption(m_nbSamplesOption);
     m_parser.addOption(m_repetitionOption);
     m_parser.addOption(m_log2FactorOption);
+    m_parser.addOption(m_nbChannelsOption);
 }
 
 ParserBench::~ParserBench()
@@ -111,6 +117,17 @@ void ParserBench::parse(const QCoreApplication& app)
     } else {
         qWarning() << "ParserBench::parse: repetilog2 factortion invalid. Defaulting to " << m_log2Factor;
     }
+
+    // number of channels
+
+    QString nbChannelsStr = m_parser.value(m_nbChannelsOption);
+    int nbChannels = nbChannelsStr.toInt(&ok);
+
+    if (ok && (nbChannels > 0) && (nbChannels <= 256)) {
+        m_nbChannels = nbChannels;
+    } else {
+        qWarning() << "ParserBench::parse: number of channels invalid. Defaulting to " << m_nbChannels;
+    }
 }
 
 ParserBench::TestType ParserBench::getTestType() const
@@ -127,6 +144,12 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsSupII;
     } else if (m_testStr == "golay2312") {
         return TestGolay2312;
+    } else if (m_testStr == "upchannelizer") {
+        return TestUpChannelizer;
+    } else if (m_testStr == "downchannelizer") {
+        return TestDownChannelizer;
+    } else if (m_testStr == "resampler") {
+        return TestResampler;
     } else {
         return TestDecimatorsII;
     }
@@ -35,7 +35,10 @@ public:
         TestDecimatorsFF,
         TestDecimatorsInfII,
         TestDecimatorsSupII,
-        TestGolay2312
+        TestGolay2312,
+        TestUpChannelizer,
+        TestDownChannelizer,
+        TestResampler
     } TestType;
 
     ParserBench();
@@ -48,18 +51,21 @@ public:
     uint32_t getNbSamples() const { return m_nbSamples; }
     uint32_t getRepetition() const { return m_repetition; }
     uint32_t getLog2Factor() const { return m_log2Factor; }
+    uint32_t getNbChannels() const { return m_nbChannels; }
 
 private:
     QString  m_testStr;
     uint32_t m_nbSamples;
     uint32_t m_repetition;
     uint32_t m_log2Factor;
+    uint32_t m_nbChannels;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_testOption;
     QCommandLineOption m_nbSamplesOption;
     QCommandLineOption m_repetitionOption;
     QCommandLineOption m_log2FactorOption;
+    QCommandLineOption m_nbChannelsOption;
 };
 
 
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <vector>
+
+#include "mainbench.h"
+#include "dsp/downchannelizer.h"
+#include "dsp/channelsamplesink.h"
+
+// Keeps the channel samples so that outputs of both paths can be compared
+class BenchCaptureSink : public ChannelSampleSink
+{
+public:
+    BenchCaptureSink() : m_capture(false) {}
+    virtual ~BenchCaptureSink() {}
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+    {
+        if (m_capture) {
+            m_samples.insert(m_samples.end(), begin, end);
+        }
+    }
+
+    bool m_capture;
+    SampleVector m_samples;
+};
+
+static bool sameSamples(const SampleVector& a, const SampleVector& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < a.size(); i++)
+    {
+        if ((a[i].m_real != b[i].m_real) || (a[i].m_imag != b[i].m_imag)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void MainBench::testDownChannelizer()
+{
+    const unsigned int log2Decim = m_parser.getLog2Factor();
+    const unsigned int blockSize = 4096;
+    const int basebandSampleRate = 4000000;
+    unsigned int nbBlocks = m_parser.getNbSamples() / blockSize;
+
+    qDebug() << "MainBench::testDownChannelizer:"
+        << " log2Decim: " << log2Decim
+        << " blockSize: " << blockSize;
+
+    SampleVector input(nbBlocks * blockSize);
+
+    for (auto& s : input)
+    {
+        s.setReal(m_uniform_distribution_s16(m_generator) << (SDR_RX_SAMP_SZ - 16));
+        s.setImag(m_uniform_distribution_s16(m_generator) << (SDR_RX_SAMP_SZ - 16));
+    }
+
+    unsigned int nbChains = 1;
+
+    for (unsigned int i = 0; i < log2Decim; i++) {
+        nbChains *= 3; // each stage is lower, center or upper half
+    }
+
+    bool bitExact = true;
+
+    // Check both paths give the same output for every filter chain
+    for (unsigned int hash = 0; hash < nbChains; hash++)
+    {
+        BenchCaptureSink sinkOne, sinkBlock;
+        sinkOne.m_capture = true;
+        sinkBlock.m_capture = true;
+        DownChannelizer channelizerOne(&sinkOne);
+        DownChannelizer channelizerBlock(&sinkBlock);
+        channelizerOne.setBlockProcessing(false);
+        channelizerOne.setBasebandSampleRate(basebandSampleRate, true);
+        channelizerOne.setDecimation(log2Decim, hash);
+        channelizerBlock.setBasebandSampleRate(basebandSampleRate, true);
+        channelizerBlock.setDecimation(log2Decim, hash);
+
+        for (unsigned int b = 0; b < nbBlocks; b++)
+        {
+            // Odd split so that stages have a sample pending across calls
+            SampleVector::const_iterator begin = input.begin() + b * blockSize;
+            channelizerOne.feed(begin, begin + blockSize - 3);
+            channelizerOne.feed(begin + blockSize - 3, begin + blockSize);
+            channelizerBlock.feed(begin, begin + blockSize);
+        }
+
+        if (!sameSamples(sinkOne.m_samples, sinkBlock.m_samples))
+        {
+            qWarning("MainBench::testDownChannelizer: filter chain %u: block path differs from sample by sample path", hash);
+            bitExact = false;
+        }
+    }
+
+    qInfo("MainBench::testDownChannelizer: block path %s", bitExact ? "is bit exact" : "is NOT bit exact");
+
+    // Timing on a mixed chain
+    BenchCaptureSink sink;
+    DownChannelizer channelizer(&sink);
+    channelizer.setBasebandSampleRate(basebandSampleRate, true);
+    channelizer.setDecimation(log2Decim, nbChains / 3);
+    QElapsedTimer timer;
+    qint64 nsecsOne = 0;
+    qint64 nsecsBlock = 0;
+
+    channelizer.setBlockProcessing(false);
+
+    for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+    {
+        timer.start();
+
+        for (unsigned int b = 0; b < nbBlocks; b++) {
+            channelizer.feed(input.begin() + b * blockSize, input.begin() + (b+1) * blockSize);
+        }
+
+        nsecsOne += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testDownChannelizer: sample by sample", nsecsOne);
+    channelizer.setBlockProcessing(true);
+
+    for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+    {
+        timer.start();
+
+        for (unsigned int b = 0; b < nbBlocks; b++) {
+            channelizer.feed(input.begin() + b * blockSize, input.begin() + (b+1) * blockSize);
+        }
+
+        nsecsBlock += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testDownChannelizer: block", nsecsBlock);
+}
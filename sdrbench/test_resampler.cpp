@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "mainbench.h"
+#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
+
+void MainBench::testResampler()
+{
+    const unsigned int blockSize = 4096;
+    const int channelSampleRate = 250000;
+    const Real distances[] = {2.6f, 1.37f, 0.73f}; // typical input to output rate ratios
+    unsigned int nbBlocks = m_parser.getNbSamples() / blockSize;
+    std::vector<Complex> input(nbBlocks * blockSize);
+
+    for (auto& c : input) {
+        c = Complex(m_uniform_distribution_f(m_generator), m_uniform_distribution_f(m_generator));
+    }
+
+    for (Real distance : distances)
+    {
+        Interpolator interpolator;
+        PolyphaseResampler resampler;
+        interpolator.create(16, channelSampleRate, channelSampleRate / (2.2 * distance));
+        resampler.create(16, channelSampleRate, channelSampleRate / (2.2 * distance));
+        std::vector<Complex> outInterpolator;
+        std::vector<Complex> outResampler;
+        outInterpolator.reserve(input.size() / distance + 2);
+        outResampler.reserve(input.size() / distance + 2);
+        QElapsedTimer timer;
+        qint64 nsecsInterpolator = 0;
+        qint64 nsecsResampler = 0;
+
+        for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+        {
+            Real distanceRemain = distance;
+            outInterpolator.clear();
+            timer.start();
+
+            for (const auto& c : input)
+            {
+                Complex ci;
+
+                if (distance < 1.0f)
+                {
+                    while (!interpolator.interpolate(&distanceRemain, c, &ci))
+                    {
+                        outInterpolator.push_back(ci);
+                        distanceRemain += distance;
+                    }
+                }
+                else if (interpolator.decimate(&distanceRemain, c, &ci))
+                {
+                    outInterpolator.push_back(ci);
+                    distanceRemain += distance;
+                }
+            }
+
+            nsecsInterpolator += timer.nsecsElapsed();
+        }
+
+        for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+        {
+            Real distanceRemain = distance;
+            outResampler.clear();
+            resampler.reset();
+            timer.start();
+
+            for (unsigned int b = 0; b < nbBlocks; b++) {
+                resampler.resample(distance, &distanceRemain, &input[b * blockSize], blockSize, outResampler);
+            }
+
+            nsecsResampler += timer.nsecsElapsed();
+        }
+
+        // Both give the same outputs from the first one
+        unsigned int nbCompare = std::min(outInterpolator.size(), outResampler.size());
+        double maxError = 0.0;
+
+        for (unsigned int i = 0; i < nbCompare; i++) {
+            maxError = std::max(maxError, (double) std::abs(outInterpolator[i] - outResampler[i]));
+        }
+
+        printResults(QString("MainBench::testResampler: distance %1: Interpolator").arg(distance), nsecsInterpolator);
+        printResults(QString("MainBench::testResampler: distance %1: PolyphaseResampler").arg(distance), nsecsResampler);
+        qInfo("MainBench::testResampler: distance %f: %u vs %u outputs max error: %g",
+            distance, (unsigned int) outInterpolator.size(), (unsigned int) outResampler.size(), maxError);
+    }
+}
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2022 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <vector>
+#include <algorithm>
+
+#include "mainbench.h"
+#include "dsp/upchannelizer.h"
+#include "dsp/channelsamplesource.h"
+#include "dsp/nco.h"
+
+// Simple modulator producing a tone at a given frequency of its channel sample rate
+class BenchToneSource : public ChannelSampleSource
+{
+public:
+    BenchToneSource(Real freq, Real sampleRate) {
+        m_nco.setFreq(freq, sampleRate);
+    }
+    virtual ~BenchToneSource() {}
+
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples)
+    {
+        std::for_each(begin, begin + nbSamples, [this](Sample& s) {
+            pullOne(s);
+        });
+    }
+    virtual void pullOne(Sample& sample)
+    {
+        Complex c = m_nco.nextIQ();
+        sample.setReal(c.real() * (SDR_TX_SCALEF/2));
+        sample.setImag(c.imag() * (SDR_TX_SCALEF/2));
+    }
+    virtual void prefetch(unsigned int nbSamples) { (void) nbSamples; }
+
+private:
+    NCO m_nco;
+};
+
+void MainBench::testUpChannelizer()
+{
+    const unsigned int nbChannels = m_parser.getNbChannels();
+    const unsigned int log2Interp = m_parser.getLog2Factor();
+    const unsigned int blockSize = 4096;
+    const int basebandSampleRate = 4000000;
+    const int channelSampleRate = basebandSampleRate / (1<<log2Interp);
+
+    qDebug() << "MainBench::testUpChannelizer:"
+        << " nbChannels: " << nbChannels
+        << " log2Interp: " << log2Interp
+        << " blockSize: " << blockSize;
+
+    std::vector<BenchToneSource*> sources;
+    std::vector<UpChannelizer*> channelizers;
+
+    for (unsigned int i = 0; i < nbChannels; i++)
+    {
+        sources.push_back(new BenchToneSource(channelSampleRate / (4.0 + i), channelSampleRate));
+        channelizers.push_back(new UpChannelizer(sources.back()));
+        channelizers.back()->setBasebandSampleRate(basebandSampleRate, true);
+        channelizers.back()->setInterpolation(log2Interp, i % 3);
+    }
+
+    SampleVector output(blockSize);
+    SampleVector channelBuffer(blockSize);
+    std::vector<float> sumBuffer(2*blockSize);
+    unsigned int nbBlocks = m_parser.getNbSamples() / blockSize;
+    QElapsedTimer timer;
+    qint64 nsecsOne = 0;
+    qint64 nsecsBlock = 0;
+
+    // Former sample by sample path
+    for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+    {
+        timer.start();
+
+        for (unsigned int b = 0; b < nbBlocks; b++)
+        {
+            for (unsigned int c = 0; c < nbChannels; c++)
+            {
+                for (unsigned int i = 0; i < blockSize; i++) {
+                    channelizers[c]->pullOne(channelBuffer[i]);
+                }
+            }
+        }
+
+        nsecsOne += timer.nsecsElapsed();
+    }
+
+    printResults(QString("MainBench::testUpChannelizer: %1 channels sample by sample").arg(nbChannels), nsecsOne);
+
+    // Block path with floating point summation as in DSPDeviceSinkEngine
+    for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+    {
+        timer.start();
+
+        for (unsigned int b = 0; b < nbBlocks; b++)
+        {
+            std::fill(sumBuffer.begin(), sumBuffer.end(), 0.0f);
+
+            for (unsigned int c = 0; c < nbChannels; c++)
+            {
+                channelizers[c]->prefetch(blockSize);
+                channelizers[c]->pull(channelBuffer.begin(), blockSize);
+                const Sample *s = channelBuffer.data();
+                float *acc = sumBuffer.data();
+
+                for (unsigned int i = 0; i < blockSize; i++)
+                {
+                    acc[2*i]   += s[i].m_real;
+                    acc[2*i+1] += s[i].m_imag;
+                }
+            }
+
+            const float scale = 1.0f / nbChannels;
+
+            for (unsigned int i = 0; i < blockSize; i++)
+            {
+                output[i].m_real = (FixReal) (sumBuffer[2*i] * scale);
+                output[i].m_imag = (FixReal) (sumBuffer[2*i+1] * scale);
+            }
+        }
+
+        nsecsBlock += timer.nsecsElapsed();
+    }
+
+    printResults(QString("MainBench::testUpChannelizer: %1 channels block and sum").arg(nbChannels), nsecsBlock);
+    double realTimeFactor = (nbBlocks * blockSize * (double) m_parser.getRepetition() / basebandSampleRate) / (nsecsBlock / 1e9);
+    qInfo("MainBench::testUpChannelizer: %u channels at %d S/s output: %.1f x real time", nbChannels, basebandSampleRate, realTimeFactor);
+
+    for (unsigned int i = 0; i < nbChannels; i++)
+    {
+        delete channelizers[i];
+        delete sources[i];
+    }
+}
@@ -83,6 +83,7 @@
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
 #include "webapi/webapiadapter.h"
+#include "websockets/wsreports.h"
 #include "commands/command.h"
 
 #include "mainwindow.h"
@@ -169,6 +170,7 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
     }
 
     m_dspEngine->preAllocateFFTs();
+    m_mainCore->getLogWriterService().setRotation(parser.getDecoderLogMaxSize(), parser.getDecoderLogPeriod(), parser.getDecoderLogCompress());
 
     splash->showStatusMessage("load settings...", Qt::white);
     qDebug() << "MainWindow::MainWindow: load settings...";
@@ -181,6 +183,8 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
     m_pluginManager = new PluginManager(this);
     m_mainCore->m_pluginManager = m_pluginManager;
     m_pluginManager->setEnableSoapy(parser.getSoapy());
+    m_pluginManager->setLazyLoading(parser.getLazyPlugins());
+    m_pluginManager->setParallelEnumeration(parser.getParallelEnumeration());
     m_pluginManager->loadPlugins(QString("plugins"));
     m_pluginManager->loadPluginsNonDiscoverable(m_mainCore->m_settings.getDeviceUserArgs());
 
@@ -224,6 +228,18 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 	m_apiServer = new WebAPIServer(m_apiHost, m_apiPort, m_requestMapper);
 	m_apiServer->start();
 
+    if (parser.getReportsPort() != 0)
+    {
+        m_wsReports = new WSReports(m_apiAdapter, this);
+        m_wsReports->setListeningAddress(m_apiHost);
+        m_wsReports->setPort(parser.getReportsPort());
+        m_wsReports->openSocket();
+    }
+    else
+    {
+        m_wsReports = nullptr;
+    }
+
 	m_commandKeyReceiver = new CommandKeyReceiver();
 	m_commandKeyReceiver->setRelease(true);
 	this->installEventFilter(m_commandKeyReceiver);
@@ -244,6 +260,7 @@ MainWindow::~MainWindow()
 {
 	qDebug() << "MainWindow::~MainWindow";
 
+    delete m_wsReports;
     m_mainCore->m_settings.save();
     m_apiServer->stop();
     delete m_apiServer;
@@ -1124,6 +1141,37 @@ void MainWindow::removeAllFeatureSets()
     }
 }
 
+void MainWindow::addChannel(int deviceSetIndex, int channelRegistrationIndex, int direction)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceUISet = m_deviceUIs[deviceSetIndex];
+        int deviceWorkspaceIndex = deviceUISet->m_deviceGUI->getWorkspaceIndex();
+        deviceWorkspaceIndex = deviceWorkspaceIndex < m_workspaces.size() ? deviceWorkspaceIndex : 0;
+        int channelPluginIndex;
+
+        if (deviceUISet->m_deviceMIMOEngine)
+        {
+            int nbMIMOChannels = deviceUISet->getNumberOfAvailableMIMOChannels();
+            int nbRxChannels = deviceUISet->getNumberOfAvailableRxChannels();
+
+            if (direction == 2) {
+                channelPluginIndex = channelRegistrationIndex;
+            } else if (direction == 0) {
+                channelPluginIndex = nbMIMOChannels + channelRegistrationIndex;
+            } else {
+                channelPluginIndex = nbMIMOChannels + nbRxChannels + channelRegistrationIndex;
+            }
+        }
+        else
+        {
+            channelPluginIndex = channelRegistrationIndex;
+        }
+
+        channelAddClicked(m_workspaces[deviceWorkspaceIndex], deviceSetIndex, channelPluginIndex);
+    }
+}
+
 void MainWindow::deleteChannel(int deviceSetIndex, int channelIndex)
 {
     if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_deviceUIs.size()))
@@ -1133,6 +1181,107 @@ void MainWindow::deleteChannel(int deviceSetIndex, int channelIndex)
     }
 }
 
+// All operations are done in this single pass so new channels are configured right away
+QList<int> MainWindow::applyChannelsBatch(int deviceSetIndex, const QList<MainCore::BatchOperation>& operations)
+{
+    QList<int> statuses;
+
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_deviceUIs.size()))
+    {
+        for (int i = 0; i < operations.size(); i++) {
+            statuses.append(404);
+        }
+
+        return statuses;
+    }
+
+    DeviceSet *deviceSet = m_mainCore->m_deviceSets[deviceSetIndex];
+    qDebug("MainWindow::applyChannelsBatch: %d operations on device set %d", operations.size(), deviceSetIndex);
+
+    for (const auto& operation : operations)
+    {
+        if (operation.m_type == MainCore::BatchOperation::Delete)
+        {
+            if ((operation.m_index >= 0) && (operation.m_index < deviceSet->getNumberOfChannels()))
+            {
+                deleteChannel(deviceSetIndex, operation.m_index);
+                statuses.append(200);
+            }
+            else
+            {
+                statuses.append(404);
+            }
+        }
+        else if (operation.m_type == MainCore::BatchOperation::Add)
+        {
+            int nbChannels = deviceSet->getNumberOfChannels();
+            addChannel(deviceSetIndex, operation.m_registrationIndex, operation.m_direction);
+
+            if (deviceSet->getNumberOfChannels() > nbChannels) {
+                statuses.append(m_mainCore->applyChannelSettings(deviceSetIndex, nbChannels, operation));
+            } else {
+                statuses.append(500);
+            }
+        }
+        else
+        {
+            statuses.append(m_mainCore->applyChannelSettings(deviceSetIndex, operation.m_index, operation));
+        }
+    }
+
+    return statuses;
+}
+
+QList<int> MainWindow::applyFeaturesBatch(int featureSetIndex, const QList<MainCore::BatchOperation>& operations)
+{
+    QList<int> statuses;
+
+    if ((featureSetIndex < 0) || (featureSetIndex >= (int) m_featureUIs.size()) || (m_workspaces.size() == 0))
+    {
+        for (int i = 0; i < operations.size(); i++) {
+            statuses.append(404);
+        }
+
+        return statuses;
+    }
+
+    FeatureSet *featureSet = m_mainCore->m_featureSets[featureSetIndex];
+    qDebug("MainWindow::applyFeaturesBatch: %d operations on feature set %d", operations.size(), featureSetIndex);
+
+    for (const auto& operation : operations)
+    {
+        if (operation.m_type == MainCore::BatchOperation::Delete)
+        {
+            if ((operation.m_index >= 0) && (operation.m_index < featureSet->getNumberOfFeatures()))
+            {
+                deleteFeature(featureSetIndex, operation.m_index);
+                statuses.append(200);
+            }
+            else
+            {
+                statuses.append(404);
+            }
+        }
+        else if (operation.m_type == MainCore::BatchOperation::Add)
+        {
+            int nbFeatures = featureSet->getNumberOfFeatures();
+            featureAddClicked(m_workspaces[0], operation.m_registrationIndex); // in the unique feature set
+
+            if (featureSet->getNumberOfFeatures() > nbFeatures) {
+                statuses.append(m_mainCore->applyFeatureSettings(featureSetIndex, nbFeatures, operation));
+            } else {
+                statuses.append(500);
+            }
+        }
+        else
+        {
+            statuses.append(m_mainCore->applyFeatureSettings(featureSetIndex, operation.m_index, operation));
+        }
+    }
+
+    return statuses;
+}
+
 void MainWindow::loadSettings()
 {
 	qDebug() << "MainWindow::loadSettings";
@@ -1704,37 +1853,7 @@ bool MainWindow::handleMessage(const Message& cmd)
     else if (MainCore::MsgAddChannel::match(cmd))
     {
         MainCore::MsgAddChannel& notif = (MainCore::MsgAddChannel&) cmd;
-        int deviceSetIndex = notif.getDeviceSetIndex();
-
-        if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_deviceUIs.size()))
-        {
-            DeviceUISet *deviceUISet = m_deviceUIs[deviceSetIndex];
-            int deviceWorkspaceIndex = deviceUISet->m_deviceGUI->getWorkspaceIndex();
-            deviceWorkspaceIndex = deviceWorkspaceIndex < m_workspaces.size() ? deviceWorkspaceIndex : 0;
-            int channelRegistrationIndex;
-
-            if (deviceUISet->m_deviceMIMOEngine)
-            {
-                int nbMIMOChannels = deviceUISet->getNumberOfAvailableMIMOChannels();
-                int nbRxChannels = deviceUISet->getNumberOfAvailableRxChannels();
-                int direction = notif.getDirection();
-
-                if (direction == 2) {
-                    channelRegistrationIndex = notif.getChannelRegistrationIndex();
-                } else if (direction == 0) {
-                    channelRegistrationIndex = nbMIMOChannels + notif.getChannelRegistrationIndex();
-                } else {
-                    channelRegistrationIndex = nbMIMOChannels + nbRxChannels + notif.getChannelRegistrationIndex();
-                }
-            }
-            else
-            {
-                channelRegistrationIndex = notif.getChannelRegistrationIndex();
-            }
-
-            channelAddClicked(m_workspaces[deviceWorkspaceIndex], deviceSetIndex, channelRegistrationIndex);
-        }
-
+        addChannel(notif.getDeviceSetIndex(), notif.getChannelRegistrationIndex(), notif.getDirection());
         return true;
     }
     else if (MainCore::MsgDeleteChannel::match(cmd))
@@ -1759,6 +1878,22 @@ bool MainWindow::handleMessage(const Message& cmd)
         deleteFeature(0, notif.getFeatureIndex());
         return true;
     }
+    else if (MainCore::MsgApplyChannelsBatch::match(cmd))
+    {
+        MainCore::MsgApplyChannelsBatch& notif = (MainCore::MsgApplyChannelsBatch&) cmd;
+        QSharedPointer<MainCore::BatchResults> results = notif.getResults();
+        results->m_statuses = applyChannelsBatch(notif.getDeviceSetIndex(), notif.getOperations());
+        results->m_applied.release();
+        return true;
+    }
+    else if (MainCore::MsgApplyFeaturesBatch::match(cmd))
+    {
+        MainCore::MsgApplyFeaturesBatch& notif = (MainCore::MsgApplyFeaturesBatch&) cmd;
+        QSharedPointer<MainCore::BatchResults> results = notif.getResults();
+        results->m_statuses = applyFeaturesBatch(notif.getFeatureSetIndex(), notif.getOperations());
+        results->m_applied.release();
+        return true;
+    }
     else if (MainCore::MsgMoveDeviceUIToWorkspace::match(cmd))
     {
         MainCore::MsgMoveDeviceUIToWorkspace& notif = (MainCore::MsgMoveDeviceUIToWorkspace&) cmd;
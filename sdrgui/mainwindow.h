@@ -52,6 +52,7 @@ class PluginInterface;
 class QWidget;
 class WebAPIRequestMapper;
 class WebAPIServer;
+class WSReports;
 class WebAPIAdapter;
 class Preset;
 class Command;
@@ -121,6 +122,7 @@ private:
 	WebAPIRequestMapper *m_requestMapper;
 	WebAPIServer *m_apiServer;
 	WebAPIAdapter *m_apiAdapter;
+	WSReports *m_wsReports;
 	QString m_apiHost;
 	int m_apiPort;
 	QAction *m_spectrumToggleViewAction;
@@ -146,7 +148,10 @@ private:
     void addFeatureSet();
     void removeFeatureSet(unsigned int featureSetIndex);
     void removeAllFeatureSets();
+    void addChannel(int deviceSetIndex, int channelRegistrationIndex, int direction);
     void deleteChannel(int deviceSetIndex, int channelIndex);
+    QList<int> applyChannelsBatch(int deviceSetIndex, const QList<MainCore::BatchOperation>& operations);
+    QList<int> applyFeaturesBatch(int featureSetIndex, const QList<MainCore::BatchOperation>& operations);
     void channelDuplicateToDeviceSet(ChannelGUI *sourceChannelGUI, int dsIndexDestination);
     void sampleDeviceChange(int deviceType, int deviceSetIndex, int newDeviceIndex, Workspace *workspace);
     void sampleSourceChange(int deviceSetIndex, int newDeviceIndex, Workspace *workspace);
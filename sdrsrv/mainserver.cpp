@@ -20,11 +20,21 @@
 #include <QDebug>
 #include <QSysInfo>
 #include <QResource>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QCoreApplication>
+
+#include "SWGDeviceSettings.h"
+#include "SWGFileInputSettings.h"
+#include "SWGSigMFFileInputSettings.h"
 
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
+#include "dsp/devicesamplesource.h"
+#include "dsp/samplesinkfifo.h"
 #include "dsp/spectrumvis.h"
 #include "device/deviceapi.h"
 #include "device/deviceset.h"
@@ -34,6 +44,7 @@
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
 #include "webapi/webapiadapter.h"
+#include "websockets/wsreports.h"
 
 #include "mainparser.h"
 #include "mainserver.h"
@@ -43,7 +54,13 @@ MainServer *MainServer::m_instance = 0;
 MainServer::MainServer(qtwebapp::LoggerWithFile *logger, const MainParser& parser, QObject *parent) :
     QObject(parent),
     m_mainCore(MainCore::instance()),
-    m_dspEngine(DSPEngine::instance())
+    m_dspEngine(DSPEngine::instance()),
+    m_batch(parser.getBatch()),
+    m_batchPreset(parser.getBatchPreset()),
+    m_batchInput(parser.getBatchInput()),
+    m_batchStartNs(0),
+    m_batchSampleIndex(0),
+    m_batchDuration(0.0)
 {
     qDebug() << "MainServer::MainServer: start";
 
@@ -55,10 +72,13 @@ MainServer::MainServer(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 
     qDebug() << "MainServer::MainServer: create FFT factory...";
     m_dspEngine->createFFTFactory(parser.getFFTWFWisdomFileName());
+    m_mainCore->getLogWriterService().setRotation(parser.getDecoderLogMaxSize(), parser.getDecoderLogPeriod(), parser.getDecoderLogCompress());
 
     qDebug() << "MainServer::MainServer: load plugins...";
     m_mainCore->m_pluginManager = new PluginManager(this);
     m_mainCore->m_pluginManager->setEnableSoapy(parser.getSoapy());
+    m_mainCore->m_pluginManager->setLazyLoading(parser.getLazyPlugins());
+    m_mainCore->m_pluginManager->setParallelEnumeration(parser.getParallelEnumeration());
     m_mainCore->m_pluginManager->loadPlugins(QString("pluginssrv"));
     addFeatureSet(); // Create the uniuefeature set
 
@@ -74,8 +94,29 @@ MainServer::MainServer(qtwebapp::LoggerWithFile *logger, const MainParser& parse
     m_apiAdapter = new WebAPIAdapter();
     m_requestMapper = new WebAPIRequestMapper(this);
     m_requestMapper->setAdapter(m_apiAdapter);
-    m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
-    m_apiServer->start();
+
+    if (m_batch) // no API server so that batch runs do not compete for the port
+    {
+        m_apiServer = nullptr;
+        QTimer::singleShot(0, this, SLOT(startBatch()));
+    }
+    else
+    {
+        m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
+        m_apiServer->start();
+    }
+
+    if (!m_batch && (parser.getReportsPort() != 0))
+    {
+        m_wsReports = new WSReports(m_apiAdapter, this);
+        m_wsReports->setListeningAddress(parser.getServerAddress());
+        m_wsReports->setPort(parser.getReportsPort());
+        m_wsReports->openSocket();
+    }
+    else
+    {
+        m_wsReports = nullptr;
+    }
 
     m_dspEngine->setMIMOSupport(true);
 
@@ -84,12 +125,20 @@ MainServer::MainServer(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 
 MainServer::~MainServer()
 {
+    delete m_wsReports; // stop pushing reports before objects go away
+
     while (m_mainCore->m_deviceSets.size() > 0) {
         removeLastDevice();
     }
 
-	m_apiServer->stop();
-	m_mainCore->m_settings.save();
+    if (m_apiServer) {
+        m_apiServer->stop();
+    }
+
+    if (!m_batch) { // batch runs do not change the saved settings
+        m_mainCore->m_settings.save();
+    }
+
     delete m_apiServer;
     delete m_requestMapper;
     delete m_apiAdapter;
@@ -224,6 +273,22 @@ bool MainServer::handleMessage(const Message& cmd)
         deleteFeature(0, notif.getFeatureIndex());
         return true;
     }
+    else if (MainCore::MsgApplyChannelsBatch::match(cmd))
+    {
+        MainCore::MsgApplyChannelsBatch& notif = (MainCore::MsgApplyChannelsBatch&) cmd;
+        QSharedPointer<MainCore::BatchResults> results = notif.getResults();
+        results->m_statuses = applyChannelsBatch(notif.getDeviceSetIndex(), notif.getOperations());
+        results->m_applied.release();
+        return true;
+    }
+    else if (MainCore::MsgApplyFeaturesBatch::match(cmd))
+    {
+        MainCore::MsgApplyFeaturesBatch& notif = (MainCore::MsgApplyFeaturesBatch&) cmd;
+        QSharedPointer<MainCore::BatchResults> results = notif.getResults();
+        results->m_statuses = applyFeaturesBatch(notif.getFeatureSetIndex(), notif.getOperations());
+        results->m_applied.release();
+        return true;
+    }
     else if (MainCore::MsgApplySettings::match(cmd))
     {
         applySettings();
@@ -700,6 +765,57 @@ void MainServer::deleteChannel(int deviceSetIndex, int channelIndex)
     }
 }
 
+// All operations are done in this single pass so new channels are configured right away
+QList<int> MainServer::applyChannelsBatch(int deviceSetIndex, const QList<MainCore::BatchOperation>& operations)
+{
+    QList<int> statuses;
+
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_mainCore->m_deviceSets.size()))
+    {
+        for (int i = 0; i < operations.size(); i++) {
+            statuses.append(404);
+        }
+
+        return statuses;
+    }
+
+    DeviceSet *deviceSet = m_mainCore->m_deviceSets[deviceSetIndex];
+    qDebug("MainServer::applyChannelsBatch: %d operations on device set %d", operations.size(), deviceSetIndex);
+
+    for (const auto& operation : operations)
+    {
+        if (operation.m_type == MainCore::BatchOperation::Delete)
+        {
+            if ((operation.m_index >= 0) && (operation.m_index < deviceSet->getNumberOfChannels()))
+            {
+                deleteChannel(deviceSetIndex, operation.m_index);
+                statuses.append(200);
+            }
+            else
+            {
+                statuses.append(404);
+            }
+        }
+        else if (operation.m_type == MainCore::BatchOperation::Add)
+        {
+            int nbChannels = deviceSet->getNumberOfChannels();
+            addChannel(deviceSetIndex, operation.m_registrationIndex);
+
+            if (deviceSet->getNumberOfChannels() > nbChannels) {
+                statuses.append(m_mainCore->applyChannelSettings(deviceSetIndex, nbChannels, operation));
+            } else {
+                statuses.append(500);
+            }
+        }
+        else
+        {
+            statuses.append(m_mainCore->applyChannelSettings(deviceSetIndex, operation.m_index, operation));
+        }
+    }
+
+    return statuses;
+}
+
 void MainServer::addFeatureSet()
 {
     m_mainCore->appendFeatureSet();
@@ -733,6 +849,56 @@ void MainServer::deleteFeature(int featureSetIndex, int featureIndex)
     }
 }
 
+QList<int> MainServer::applyFeaturesBatch(int featureSetIndex, const QList<MainCore::BatchOperation>& operations)
+{
+    QList<int> statuses;
+
+    if ((featureSetIndex < 0) || (featureSetIndex >= (int) m_mainCore->m_featureSets.size()))
+    {
+        for (int i = 0; i < operations.size(); i++) {
+            statuses.append(404);
+        }
+
+        return statuses;
+    }
+
+    FeatureSet *featureSet = m_mainCore->m_featureSets[featureSetIndex];
+    qDebug("MainServer::applyFeaturesBatch: %d operations on feature set %d", operations.size(), featureSetIndex);
+
+    for (const auto& operation : operations)
+    {
+        if (operation.m_type == MainCore::BatchOperation::Delete)
+        {
+            if ((operation.m_index >= 0) && (operation.m_index < featureSet->getNumberOfFeatures()))
+            {
+                deleteFeature(featureSetIndex, operation.m_index);
+                statuses.append(200);
+            }
+            else
+            {
+                statuses.append(404);
+            }
+        }
+        else if (operation.m_type == MainCore::BatchOperation::Add)
+        {
+            int nbFeatures = featureSet->getNumberOfFeatures();
+            addFeature(featureSetIndex, operation.m_registrationIndex);
+
+            if (featureSet->getNumberOfFeatures() > nbFeatures) {
+                statuses.append(m_mainCore->applyFeatureSettings(featureSetIndex, nbFeatures, operation));
+            } else {
+                statuses.append(500);
+            }
+        }
+        else
+        {
+            statuses.append(m_mainCore->applyFeatureSettings(featureSetIndex, operation.m_index, operation));
+        }
+    }
+
+    return statuses;
+}
+
 void MainServer::loadPresetSettings(const Preset* preset, int tabIndex)
 {
 	qDebug("MainServer::loadPresetSettings: preset [%s | %s]",
@@ -813,3 +979,201 @@ void MainServer::saveFeatureSetPresetSettings(FeatureSetPreset* preset, int feat
     preset->clearFeatures();
     featureSet->saveFeatureSetSettings(preset);
 }
+
+const Preset *MainServer::loadBatchPreset(Preset& filePreset)
+{
+    if (QFileInfo::exists(m_batchPreset)) // exported preset file
+    {
+        QFile file(m_batchPreset);
+
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return nullptr;
+        }
+
+        QByteArray base64Str;
+        QTextStream instream(&file);
+        instream >> base64Str;
+        file.close();
+
+        return filePreset.deserialize(QByteArray::fromBase64(base64Str)) ? &filePreset : nullptr;
+    }
+
+    for (int i = 0; i < m_mainCore->m_settings.getPresetCount(); i++)
+    {
+        const Preset *preset = m_mainCore->m_settings.getPreset(i);
+
+        if (preset->isSourcePreset() && (preset->getDescription() == m_batchPreset)) {
+            return preset;
+        }
+    }
+
+    return nullptr;
+}
+
+void MainServer::startBatch()
+{
+    Preset filePreset;
+    const Preset *preset = loadBatchPreset(filePreset);
+
+    if (!preset || !preset->isSourcePreset())
+    {
+        batchError(QString("cannot load Rx preset %1").arg(m_batchPreset));
+        return;
+    }
+
+    qInfo("MainServer::startBatch: preset [%s | %s]", qPrintable(preset->getGroup()), qPrintable(preset->getDescription()));
+    Preset::SelectedDevice selectedDevice = preset->getSelectedDevice();
+    int deviceIndex = DeviceEnumerator::instance()->getBestRxSamplingDeviceIndex(
+        selectedDevice.m_deviceId,
+        selectedDevice.m_deviceSerial,
+        selectedDevice.m_deviceSequence,
+        selectedDevice.m_deviceItemIndex
+    );
+
+    if (deviceIndex < 0)
+    {
+        batchError(QString("device %1 of preset is not available").arg(selectedDevice.m_deviceId));
+        return;
+    }
+
+    // Channels and file input block on full FIFOs so nothing is dropped however fast the file is read.
+    // In this mode file inputs also time their samples from the recording start and the device engine
+    // anchors sample timestamps to it, so decoders time their outputs as when the recording was made.
+    SampleSinkFifo::setBackpressure(true);
+
+    addSourceDevice();
+    int deviceSetIndex = m_mainCore->m_deviceSets.size() - 1;
+    changeSampleSource(deviceSetIndex, deviceIndex);
+    DeviceAPI *deviceAPI = m_mainCore->m_deviceSets[deviceSetIndex]->m_deviceAPI;
+    QString hardwareId = deviceAPI->getHardwareId();
+
+    if ((hardwareId != "FileInput") && (hardwareId != "SigMFFileInput"))
+    {
+        batchError(QString("preset device is %1 but batch mode needs FileInput or SigMFFileInput").arg(hardwareId));
+        return;
+    }
+
+    loadPresetSettings(preset, deviceSetIndex);
+
+    // Play once, optionally another recording than the one of the preset
+    SWGSDRangel::SWGDeviceSettings deviceSettings;
+    QStringList deviceSettingsKeys;
+
+    if (hardwareId == "FileInput")
+    {
+        deviceSettings.setFileInputSettings(new SWGSDRangel::SWGFileInputSettings());
+        deviceSettings.getFileInputSettings()->setLoop(0);
+        deviceSettingsKeys.append("loop");
+
+        if (!m_batchInput.isEmpty()) {
+            deviceSettings.getFileInputSettings()->setFileName(new QString(m_batchInput));
+        }
+    }
+    else
+    {
+        deviceSettings.setSigMfFileInputSettings(new SWGSDRangel::SWGSigMFFileInputSettings());
+        deviceSettings.getSigMfFileInputSettings()->setTrackLoop(0);
+        deviceSettings.getSigMfFileInputSettings()->setFullLoop(0);
+        deviceSettingsKeys.append("trackLoop");
+        deviceSettingsKeys.append("fullLoop");
+
+        if (!m_batchInput.isEmpty()) {
+            deviceSettings.getSigMfFileInputSettings()->setFileName(new QString(m_batchInput));
+        }
+    }
+
+    if (!m_batchInput.isEmpty()) {
+        deviceSettingsKeys.append("fileName");
+    }
+
+    QString errorMessage;
+    int status = deviceAPI->getSampleSource()->webapiSettingsPutPatch(false, deviceSettingsKeys, deviceSettings, errorMessage);
+
+    if (status / 100 != 2)
+    {
+        batchError(QString("cannot set file input: %1").arg(errorMessage));
+        return;
+    }
+
+    QCoreApplication::processEvents(); // let settings messages be handled before starting
+
+    if (!deviceAPI->startDeviceEngine())
+    {
+        batchError(QString("cannot start device: %1").arg(deviceAPI->errorMessage()));
+        return;
+    }
+
+    m_batchStartNs = m_mainCore->getStartMsecsSinceEpoch()*1000000LL + m_mainCore->getElapsedNsecs();
+    m_batchSampleIndex = 0;
+    m_batchDuration = 0.0;
+    connect(&m_batchTimer, SIGNAL(timeout()), this, SLOT(checkBatch()));
+    m_batchTimer.start(m_batchCheckMs);
+}
+
+void MainServer::checkBatch()
+{
+    DeviceSet *deviceSet = m_mainCore->m_deviceSets.back();
+    DSPDeviceSourceEngine *deviceSourceEngine = deviceSet->m_deviceSourceEngine;
+    DeviceSampleSource *source = deviceSet->m_deviceAPI->getSampleSource();
+
+    if (deviceSourceEngine->state() == DSPDeviceSourceEngine::StError)
+    {
+        batchError(QString("device engine error: %1").arg(deviceSourceEngine->errorMessage()));
+        return;
+    }
+
+    // Sample rate may change along a SigMF recording so processed time is accumulated
+    quint64 sampleIndex = deviceSourceEngine->getSampleIndex();
+    int sampleRate = source->getSampleRate();
+
+    if ((sampleRate > 0) && (sampleIndex > m_batchSampleIndex)) {
+        m_batchDuration += (sampleIndex - m_batchSampleIndex) / (double) sampleRate;
+    }
+
+    m_batchSampleIndex = sampleIndex;
+
+    // The recording is over when the file input has not written anything for a while
+    // and all samples have been read out of the FIFOs down to the channels
+    qint64 lastWriteNs = source->getSampleFifo()->getLastWriteNs();
+    qint64 nowNs = m_mainCore->getStartMsecsSinceEpoch()*1000000LL + m_mainCore->getElapsedNsecs();
+    qint64 idleNs = nowNs - lastWriteNs;
+
+    if ((lastWriteNs == 0) || (idleNs < m_batchIdleMs*1000000LL)) {
+        return;
+    }
+
+    if (SampleSinkFifo::getTotalFill() > 0)
+    {
+        if (idleNs < 10*m_batchIdleMs*1000000LL) {
+            return;
+        }
+
+        qWarning("MainServer::checkBatch: %lld samples left in FIFOs", SampleSinkFifo::getTotalFill());
+    }
+
+    m_batchTimer.stop();
+    double elapsed = (lastWriteNs - m_batchStartNs) / 1e9;
+    qInfo("MainServer::checkBatch: processed %.1f s of recording in %.1f s: %.1f times faster than real time",
+        m_batchDuration, elapsed, elapsed > 0.0 ? m_batchDuration / elapsed : 0.0);
+
+    // Samples are only dropped if a reader stalled. The outputs are then incomplete.
+    qint64 dropped = SampleSinkFifo::getBackpressureDropped();
+    SampleSinkFifo::setBackpressure(false);
+    deviceSet->m_deviceAPI->stopDeviceEngine();
+
+    if (dropped > 0)
+    {
+        batchError(QString("%1 samples were dropped: outputs are incomplete").arg(dropped));
+        return;
+    }
+
+    emit finished();
+}
+
+void MainServer::batchError(const QString& message)
+{
+    qCritical("MainServer::batchError: %s", qPrintable(message));
+    m_batchTimer.stop();
+    SampleSinkFifo::setBackpressure(false);
+    QCoreApplication::exit(1);
+}
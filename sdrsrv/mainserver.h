@@ -40,6 +40,7 @@ class FeatureSet;
 class WebAPIRequestMapper;
 class WebAPIServer;
 class WebAPIAdapter;
+class WSReports;
 
 namespace qtwebapp {
     class LoggerWithFile;
@@ -70,6 +71,8 @@ public:
     void removeFeatureSet(unsigned int featureSetIndex);
     void addFeature(int featureSetIndex, int selectedFeatureIndex);
     void deleteFeature(int featureSetIndex, int featureIndex);
+    QList<int> applyChannelsBatch(int deviceSetIndex, const QList<MainCore::BatchOperation>& operations);
+    QList<int> applyFeaturesBatch(int featureSetIndex, const QList<MainCore::BatchOperation>& operations);
 
     friend class WebAPIAdapter;
 
@@ -86,6 +89,18 @@ private:
     WebAPIRequestMapper *m_requestMapper;
     WebAPIServer *m_apiServer;
     WebAPIAdapter *m_apiAdapter;
+    WSReports *m_wsReports;
+
+    // Batch mode: plays a recording through a preset then exits
+    bool m_batch;
+    QString m_batchPreset;          //!< .prex file or saved Rx preset name
+    QString m_batchInput;           //!< Recording file overriding the preset one. Empty for none
+    QTimer m_batchTimer;
+    qint64 m_batchStartNs;          //!< Acquisition start in ns since epoch
+    quint64 m_batchSampleIndex;     //!< Device samples processed at previous check
+    double m_batchDuration;         //!< Recording time processed in seconds
+    static const int m_batchCheckMs = 200;
+    static const int m_batchIdleMs = 2000;  //!< Recording is over when nothing was read from the file for this long
 
 	void loadSettings();
     void applySettings();
@@ -95,9 +110,13 @@ private:
 	void saveFeatureSetPresetSettings(FeatureSetPreset* preset, int featureSetIndex);
 
     bool handleMessage(const Message& cmd);
+    const Preset *loadBatchPreset(Preset& filePreset);
+    void batchError(const QString& message);
 
 private slots:
     void handleMessages();
+    void startBatch();
+    void checkBatch();
 };
 
 
@@ -0,0 +1,465 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 7.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGADSBDemodAircraftState.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGADSBDemodAircraftState::SWGADSBDemodAircraftState(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGADSBDemodAircraftState::SWGADSBDemodAircraftState() {
+    icao = nullptr;
+    m_icao_isSet = false;
+    callsign = nullptr;
+    m_callsign_isSet = false;
+    emitter_category = nullptr;
+    m_emitter_category_isSet = false;
+    latitude = 0.0f;
+    m_latitude_isSet = false;
+    longitude = 0.0f;
+    m_longitude_isSet = false;
+    position_date_time = nullptr;
+    m_position_date_time_isSet = false;
+    altitude = 0;
+    m_altitude_isSet = false;
+    on_surface = 0;
+    m_on_surface_isSet = false;
+    speed = 0.0f;
+    m_speed_isSet = false;
+    speed_type = 0;
+    m_speed_type_isSet = false;
+    heading = 0.0f;
+    m_heading_isSet = false;
+    vertical_rate = 0;
+    m_vertical_rate_isSet = false;
+    squawk = 0;
+    m_squawk_isSet = false;
+    emergency_status = nullptr;
+    m_emergency_status_isSet = false;
+    frame_count = 0;
+    m_frame_count_isSet = false;
+    last_seen_date_time = nullptr;
+    m_last_seen_date_time_isSet = false;
+}
+
+SWGADSBDemodAircraftState::~SWGADSBDemodAircraftState() {
+    this->cleanup();
+}
+
+void
+SWGADSBDemodAircraftState::init() {
+    icao = new QString("");
+    m_icao_isSet = false;
+    callsign = new QString("");
+    m_callsign_isSet = false;
+    emitter_category = new QString("");
+    m_emitter_category_isSet = false;
+    latitude = 0.0f;
+    m_latitude_isSet = false;
+    longitude = 0.0f;
+    m_longitude_isSet = false;
+    position_date_time = new QString("");
+    m_position_date_time_isSet = false;
+    altitude = 0;
+    m_altitude_isSet = false;
+    on_surface = 0;
+    m_on_surface_isSet = false;
+    speed = 0.0f;
+    m_speed_isSet = false;
+    speed_type = 0;
+    m_speed_type_isSet = false;
+    heading = 0.0f;
+    m_heading_isSet = false;
+    vertical_rate = 0;
+    m_vertical_rate_isSet = false;
+    squawk = 0;
+    m_squawk_isSet = false;
+    emergency_status = new QString("");
+    m_emergency_status_isSet = false;
+    frame_count = 0;
+    m_frame_count_isSet = false;
+    last_seen_date_time = new QString("");
+    m_last_seen_date_time_isSet = false;
+}
+
+void
+SWGADSBDemodAircraftState::cleanup() {
+    if(icao != nullptr) { 
+        delete icao;
+    }
+    if(callsign != nullptr) { 
+        delete callsign;
+    }
+    if(emitter_category != nullptr) { 
+        delete emitter_category;
+    }
+
+
+    if(position_date_time != nullptr) { 
+        delete position_date_time;
+    }
+
+
+
+
+
+
+
+    if(emergency_status != nullptr) { 
+        delete emergency_status;
+    }
+
+    if(last_seen_date_time != nullptr) { 
+        delete last_seen_date_time;
+    }
+}
+
+SWGADSBDemodAircraftState*
+SWGADSBDemodAircraftState::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGADSBDemodAircraftState::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&icao, pJson["icao"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&callsign, pJson["callsign"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&emitter_category, pJson["emitterCategory"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&latitude, pJson["latitude"], "float", "");
+    
+    ::SWGSDRangel::setValue(&longitude, pJson["longitude"], "float", "");
+    
+    ::SWGSDRangel::setValue(&position_date_time, pJson["positionDateTime"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&altitude, pJson["altitude"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&on_surface, pJson["onSurface"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&speed, pJson["speed"], "float", "");
+    
+    ::SWGSDRangel::setValue(&speed_type, pJson["speedType"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&heading, pJson["heading"], "float", "");
+    
+    ::SWGSDRangel::setValue(&vertical_rate, pJson["verticalRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&squawk, pJson["squawk"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&emergency_status, pJson["emergencyStatus"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&frame_count, pJson["frameCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&last_seen_date_time, pJson["lastSeenDateTime"], "QString", "QString");
+    
+}
+
+QString
+SWGADSBDemodAircraftState::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGADSBDemodAircraftState::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(icao != nullptr && *icao != QString("")){
+        toJsonValue(QString("icao"), icao, obj, QString("QString"));
+    }
+    if(callsign != nullptr && *callsign != QString("")){
+        toJsonValue(QString("callsign"), callsign, obj, QString("QString"));
+    }
+    if(emitter_category != nullptr && *emitter_category != QString("")){
+        toJsonValue(QString("emitterCategory"), emitter_category, obj, QString("QString"));
+    }
+    if(m_latitude_isSet){
+        obj->insert("latitude", QJsonValue(latitude));
+    }
+    if(m_longitude_isSet){
+        obj->insert("longitude", QJsonValue(longitude));
+    }
+    if(position_date_time != nullptr && *position_date_time != QString("")){
+        toJsonValue(QString("positionDateTime"), position_date_time, obj, QString("QString"));
+    }
+    if(m_altitude_isSet){
+        obj->insert("altitude", QJsonValue(altitude));
+    }
+    if(m_on_surface_isSet){
+        obj->insert("onSurface", QJsonValue(on_surface));
+    }
+    if(m_speed_isSet){
+        obj->insert("speed", QJsonValue(speed));
+    }
+    if(m_speed_type_isSet){
+        obj->insert("speedType", QJsonValue(speed_type));
+    }
+    if(m_heading_isSet){
+        obj->insert("heading", QJsonValue(heading));
+    }
+    if(m_vertical_rate_isSet){
+        obj->insert("verticalRate", QJsonValue(vertical_rate));
+    }
+    if(m_squawk_isSet){
+        obj->insert("squawk", QJsonValue(squawk));
+    }
+    if(emergency_status != nullptr && *emergency_status != QString("")){
+        toJsonValue(QString("emergencyStatus"), emergency_status, obj, QString("QString"));
+    }
+    if(m_frame_count_isSet){
+        obj->insert("frameCount", QJsonValue(frame_count));
+    }
+    if(last_seen_date_time != nullptr && *last_seen_date_time != QString("")){
+        toJsonValue(QString("lastSeenDateTime"), last_seen_date_time, obj, QString("QString"));
+    }
+
+    return obj;
+}
+
+QString*
+SWGADSBDemodAircraftState::getIcao() {
+    return icao;
+}
+void
+SWGADSBDemodAircraftState::setIcao(QString* icao) {
+    this->icao = icao;
+    this->m_icao_isSet = true;
+}
+
+QString*
+SWGADSBDemodAircraftState::getCallsign() {
+    return callsign;
+}
+void
+SWGADSBDemodAircraftState::setCallsign(QString* callsign) {
+    this->callsign = callsign;
+    this->m_callsign_isSet = true;
+}
+
+QString*
+SWGADSBDemodAircraftState::getEmitterCategory() {
+    return emitter_category;
+}
+void
+SWGADSBDemodAircraftState::setEmitterCategory(QString* emitter_category) {
+    this->emitter_category = emitter_category;
+    this->m_emitter_category_isSet = true;
+}
+
+float
+SWGADSBDemodAircraftState::getLatitude() {
+    return latitude;
+}
+void
+SWGADSBDemodAircraftState::setLatitude(float latitude) {
+    this->latitude = latitude;
+    this->m_latitude_isSet = true;
+}
+
+float
+SWGADSBDemodAircraftState::getLongitude() {
+    return longitude;
+}
+void
+SWGADSBDemodAircraftState::setLongitude(float longitude) {
+    this->longitude = longitude;
+    this->m_longitude_isSet = true;
+}
+
+QString*
+SWGADSBDemodAircraftState::getPositionDateTime() {
+    return position_date_time;
+}
+void
+SWGADSBDemodAircraftState::setPositionDateTime(QString* position_date_time) {
+    this->position_date_time = position_date_time;
+    this->m_position_date_time_isSet = true;
+}
+
+qint32
+SWGADSBDemodAircraftState::getAltitude() {
+    return altitude;
+}
+void
+SWGADSBDemodAircraftState::setAltitude(qint32 altitude) {
+    this->altitude = altitude;
+    this->m_altitude_isSet = true;
+}
+
+qint32
+SWGADSBDemodAircraftState::getOnSurface() {
+    return on_surface;
+}
+void
+SWGADSBDemodAircraftState::setOnSurface(qint32 on_surface) {
+    this->on_surface = on_surface;
+    this->m_on_surface_isSet = true;
+}
+
+float
+SWGADSBDemodAircraftState::getSpeed() {
+    return speed;
+}
+void
+SWGADSBDemodAircraftState::setSpeed(float speed) {
+    this->speed = speed;
+    this->m_speed_isSet = true;
+}
+
+qint32
+SWGADSBDemodAircraftState::getSpeedType() {
+    return speed_type;
+}
+void
+SWGADSBDemodAircraftState::setSpeedType(qint32 speed_type) {
+    this->speed_type = speed_type;
+    this->m_speed_type_isSet = true;
+}
+
+float
+SWGADSBDemodAircraftState::getHeading() {
+    return heading;
+}
+void
+SWGADSBDemodAircraftState::setHeading(float heading) {
+    this->heading = heading;
+    this->m_heading_isSet = true;
+}
+
+qint32
+SWGADSBDemodAircraftState::getVerticalRate() {
+    return vertical_rate;
+}
+void
+SWGADSBDemodAircraftState::setVerticalRate(qint32 vertical_rate) {
+    this->vertical_rate = vertical_rate;
+    this->m_vertical_rate_isSet = true;
+}
+
+qint32
+SWGADSBDemodAircraftState::getSquawk() {
+    return squawk;
+}
+void
+SWGADSBDemodAircraftState::setSquawk(qint32 squawk) {
+    this->squawk = squawk;
+    this->m_squawk_isSet = true;
+}
+
+QString*
+SWGADSBDemodAircraftState::getEmergencyStatus() {
+    return emergency_status;
+}
+void
+SWGADSBDemodAircraftState::setEmergencyStatus(QString* emergency_status) {
+    this->emergency_status = emergency_status;
+    this->m_emergency_status_isSet = true;
+}
+
+qint32
+SWGADSBDemodAircraftState::getFrameCount() {
+    return frame_count;
+}
+void
+SWGADSBDemodAircraftState::setFrameCount(qint32 frame_count) {
+    this->frame_count = frame_count;
+    this->m_frame_count_isSet = true;
+}
+
+QString*
+SWGADSBDemodAircraftState::getLastSeenDateTime() {
+    return last_seen_date_time;
+}
+void
+SWGADSBDemodAircraftState::setLastSeenDateTime(QString* last_seen_date_time) {
+    this->last_seen_date_time = last_seen_date_time;
+    this->m_last_seen_date_time_isSet = true;
+}
+
+
+bool
+SWGADSBDemodAircraftState::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(icao && *icao != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(callsign && *callsign != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(emitter_category && *emitter_category != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_latitude_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_longitude_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(position_date_time && *position_date_time != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_altitude_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_on_surface_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_speed_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_speed_type_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_heading_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_vertical_rate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_squawk_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(emergency_status && *emergency_status != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_frame_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(last_seen_date_time && *last_seen_date_time != QString("")){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
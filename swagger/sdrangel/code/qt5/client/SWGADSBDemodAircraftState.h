@@ -0,0 +1,149 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 7.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGADSBDemodAircraftState.h
+ *
+ * Decoded state of an aircraft
+ */
+
+#ifndef SWGADSBDemodAircraftState_H_
+#define SWGADSBDemodAircraftState_H_
+
+#include <QJsonObject>
+
+
+#include <QString>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGADSBDemodAircraftState: public SWGObject {
+public:
+    SWGADSBDemodAircraftState();
+    SWGADSBDemodAircraftState(QString* json);
+    virtual ~SWGADSBDemodAircraftState();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGADSBDemodAircraftState* fromJson(QString &jsonString) override;
+
+    QString* getIcao();
+    void setIcao(QString* icao);
+
+    QString* getCallsign();
+    void setCallsign(QString* callsign);
+
+    QString* getEmitterCategory();
+    void setEmitterCategory(QString* emitter_category);
+
+    float getLatitude();
+    void setLatitude(float latitude);
+
+    float getLongitude();
+    void setLongitude(float longitude);
+
+    QString* getPositionDateTime();
+    void setPositionDateTime(QString* position_date_time);
+
+    qint32 getAltitude();
+    void setAltitude(qint32 altitude);
+
+    qint32 getOnSurface();
+    void setOnSurface(qint32 on_surface);
+
+    float getSpeed();
+    void setSpeed(float speed);
+
+    qint32 getSpeedType();
+    void setSpeedType(qint32 speed_type);
+
+    float getHeading();
+    void setHeading(float heading);
+
+    qint32 getVerticalRate();
+    void setVerticalRate(qint32 vertical_rate);
+
+    qint32 getSquawk();
+    void setSquawk(qint32 squawk);
+
+    QString* getEmergencyStatus();
+    void setEmergencyStatus(QString* emergency_status);
+
+    qint32 getFrameCount();
+    void setFrameCount(qint32 frame_count);
+
+    QString* getLastSeenDateTime();
+    void setLastSeenDateTime(QString* last_seen_date_time);
+
+
+    virtual bool isSet() override;
+
+private:
+    QString* icao;
+    bool m_icao_isSet;
+
+    QString* callsign;
+    bool m_callsign_isSet;
+
+    QString* emitter_category;
+    bool m_emitter_category_isSet;
+
+    float latitude;
+    bool m_latitude_isSet;
+
+    float longitude;
+    bool m_longitude_isSet;
+
+    QString* position_date_time;
+    bool m_position_date_time_isSet;
+
+    qint32 altitude;
+    bool m_altitude_isSet;
+
+    qint32 on_surface;
+    bool m_on_surface_isSet;
+
+    float speed;
+    bool m_speed_isSet;
+
+    qint32 speed_type;
+    bool m_speed_type_isSet;
+
+    float heading;
+    bool m_heading_isSet;
+
+    qint32 vertical_rate;
+    bool m_vertical_rate_isSet;
+
+    qint32 squawk;
+    bool m_squawk_isSet;
+
+    QString* emergency_status;
+    bool m_emergency_status_isSet;
+
+    qint32 frame_count;
+    bool m_frame_count_isSet;
+
+    QString* last_seen_date_time;
+    bool m_last_seen_date_time_isSet;
+
+};
+
+}
+
+#endif /* SWGADSBDemodAircraftState_H_ */
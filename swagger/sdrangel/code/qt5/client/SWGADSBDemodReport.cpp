@@ -40,6 +40,8 @@ SWGADSBDemodReport::SWGADSBDemodReport() {
     m_target_elevation_isSet = false;
     target_range = 0.0f;
     m_target_range_isSet = false;
+    aircraft = nullptr;
+    m_aircraft_isSet = false;
 }
 
 SWGADSBDemodReport::~SWGADSBDemodReport() {
@@ -60,6 +62,8 @@ SWGADSBDemodReport::init() {
     m_target_elevation_isSet = false;
     target_range = 0.0f;
     m_target_range_isSet = false;
+    aircraft = new QList<SWGADSBDemodAircraftState*>();
+    m_aircraft_isSet = false;
 }
 
 void
@@ -72,6 +76,13 @@ SWGADSBDemodReport::cleanup() {
 
 
 
+    if(aircraft != nullptr) { 
+        auto arr = aircraft;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete aircraft;
+    }
 }
 
 SWGADSBDemodReport*
@@ -97,6 +108,8 @@ SWGADSBDemodReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&target_range, pJson["targetRange"], "float", "");
     
+    
+    ::SWGSDRangel::setValue(&aircraft, pJson["aircraft"], "QList", "SWGADSBDemodAircraftState");
 }
 
 QString
@@ -131,6 +144,9 @@ SWGADSBDemodReport::asJsonObject() {
     if(m_target_range_isSet){
         obj->insert("targetRange", QJsonValue(target_range));
     }
+    if(aircraft && aircraft->size() > 0){
+        toJsonArray((QList<void*>*)aircraft, obj, "aircraft", "SWGADSBDemodAircraftState");
+    }
 
     return obj;
 }
@@ -195,6 +211,16 @@ SWGADSBDemodReport::setTargetRange(float target_range) {
     this->m_target_range_isSet = true;
 }
 
+QList<SWGADSBDemodAircraftState*>*
+SWGADSBDemodReport::getAircraft() {
+    return aircraft;
+}
+void
+SWGADSBDemodReport::setAircraft(QList<SWGADSBDemodAircraftState*>* aircraft) {
+    this->aircraft = aircraft;
+    this->m_aircraft_isSet = true;
+}
+
 
 bool
 SWGADSBDemodReport::isSet(){
@@ -218,6 +244,9 @@ SWGADSBDemodReport::isSet(){
         if(m_target_range_isSet){
             isObjectUpdated = true; break;
         }
+        if(aircraft && (aircraft->size() > 0)){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -22,6 +22,8 @@
 #include <QJsonObject>
 
 
+#include "SWGADSBDemodAircraftState.h"
+#include <QList>
 #include <QString>
 
 #include "SWGObject.h"
@@ -60,6 +62,9 @@ public:
     float getTargetRange();
     void setTargetRange(float target_range);
 
+    QList<SWGADSBDemodAircraftState*>* getAircraft();
+    void setAircraft(QList<SWGADSBDemodAircraftState*>* aircraft);
+
 
     virtual bool isSet() override;
 
@@ -82,6 +87,9 @@ private:
     float target_range;
     bool m_target_range_isSet;
 
+    QList<SWGADSBDemodAircraftState*>* aircraft;
+    bool m_aircraft_isSet;
+
 };
 
 }
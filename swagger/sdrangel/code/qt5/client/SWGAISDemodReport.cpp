@@ -32,6 +32,8 @@ SWGAISDemodReport::SWGAISDemodReport() {
     m_channel_power_db_isSet = false;
     channel_sample_rate = 0;
     m_channel_sample_rate_isSet = false;
+    sub_channels = nullptr;
+    m_sub_channels_isSet = false;
 }
 
 SWGAISDemodReport::~SWGAISDemodReport() {
@@ -44,12 +46,21 @@ SWGAISDemodReport::init() {
     m_channel_power_db_isSet = false;
     channel_sample_rate = 0;
     m_channel_sample_rate_isSet = false;
+    sub_channels = new QList<SWGAISDemodSubChannelReport*>();
+    m_sub_channels_isSet = false;
 }
 
 void
 SWGAISDemodReport::cleanup() {
 
 
+    if(sub_channels != nullptr) { 
+        auto arr = sub_channels;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete sub_channels;
+    }
 }
 
 SWGAISDemodReport*
@@ -67,6 +78,8 @@ SWGAISDemodReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&channel_sample_rate, pJson["channelSampleRate"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&sub_channels, pJson["subChannels"], "QList", "SWGAISDemodSubChannelReport");
+    
 }
 
 QString
@@ -89,6 +102,9 @@ SWGAISDemodReport::asJsonObject() {
     if(m_channel_sample_rate_isSet){
         obj->insert("channelSampleRate", QJsonValue(channel_sample_rate));
     }
+    if(sub_channels && sub_channels->size() > 0){
+        toJsonArray((QList<void*>*)sub_channels, obj, "subChannels", "SWGAISDemodSubChannelReport");
+    }
 
     return obj;
 }
@@ -113,6 +129,16 @@ SWGAISDemodReport::setChannelSampleRate(qint32 channel_sample_rate) {
     this->m_channel_sample_rate_isSet = true;
 }
 
+QList<SWGAISDemodSubChannelReport*>*
+SWGAISDemodReport::getSubChannels() {
+    return sub_channels;
+}
+void
+SWGAISDemodReport::setSubChannels(QList<SWGAISDemodSubChannelReport*>* sub_channels) {
+    this->sub_channels = sub_channels;
+    this->m_sub_channels_isSet = true;
+}
+
 
 bool
 SWGAISDemodReport::isSet(){
@@ -124,6 +150,9 @@ SWGAISDemodReport::isSet(){
         if(m_channel_sample_rate_isSet){
             isObjectUpdated = true; break;
         }
+        if(sub_channels && (sub_channels->size() > 0)){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -22,6 +22,8 @@
 #include <QJsonObject>
 
 
+#include "SWGAISDemodSubChannelReport.h"
+#include <QList>
 
 #include "SWGObject.h"
 #include "export.h"
@@ -47,6 +49,9 @@ public:
     qint32 getChannelSampleRate();
     void setChannelSampleRate(qint32 channel_sample_rate);
 
+    QList<SWGAISDemodSubChannelReport*>* getSubChannels();
+    void setSubChannels(QList<SWGAISDemodSubChannelReport*>* sub_channels);
+
 
     virtual bool isSet() override;
 
@@ -57,6 +62,9 @@ private:
     qint32 channel_sample_rate;
     bool m_channel_sample_rate_isSet;
 
+    QList<SWGAISDemodSubChannelReport*>* sub_channels;
+    bool m_sub_channels_isSet;
+
 };
 
 }
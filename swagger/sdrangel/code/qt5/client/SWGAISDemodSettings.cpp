@@ -38,6 +38,8 @@ SWGAISDemodSettings::SWGAISDemodSettings() {
     m_fm_deviation_isSet = false;
     correlation_threshold = 0.0f;
     m_correlation_threshold_isSet = false;
+    sub_channels = nullptr;
+    m_sub_channels_isSet = false;
     udp_enabled = 0;
     m_udp_enabled_isSet = false;
     udp_address = nullptr;
@@ -90,6 +92,8 @@ SWGAISDemodSettings::init() {
     m_fm_deviation_isSet = false;
     correlation_threshold = 0.0f;
     m_correlation_threshold_isSet = false;
+    sub_channels = new QList<SWGAISDemodSubChannel*>();
+    m_sub_channels_isSet = false;
     udp_enabled = 0;
     m_udp_enabled_isSet = false;
     udp_address = new QString("");
@@ -133,6 +137,13 @@ SWGAISDemodSettings::cleanup() {
 
 
 
+    if(sub_channels != nullptr) { 
+        auto arr = sub_channels;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete sub_channels;
+    }
 
     if(udp_address != nullptr) { 
         delete udp_address;
@@ -187,6 +198,8 @@ SWGAISDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&correlation_threshold, pJson["correlationThreshold"], "float", "");
     
+    ::SWGSDRangel::setValue(&sub_channels, pJson["subChannels"], "QList", "SWGAISDemodSubChannel");
+    
     ::SWGSDRangel::setValue(&udp_enabled, pJson["udpEnabled"], "qint32", "");
     
     ::SWGSDRangel::setValue(&udp_address, pJson["udpAddress"], "QString", "QString");
@@ -252,6 +265,9 @@ SWGAISDemodSettings::asJsonObject() {
     if(m_correlation_threshold_isSet){
         obj->insert("correlationThreshold", QJsonValue(correlation_threshold));
     }
+    if(sub_channels && sub_channels->size() > 0){
+        toJsonArray((QList<void*>*)sub_channels, obj, "subChannels", "SWGAISDemodSubChannel");
+    }
     if(m_udp_enabled_isSet){
         obj->insert("udpEnabled", QJsonValue(udp_enabled));
     }
@@ -357,6 +373,16 @@ SWGAISDemodSettings::setCorrelationThreshold(float correlation_threshold) {
     this->m_correlation_threshold_isSet = true;
 }
 
+QList<SWGAISDemodSubChannel*>*
+SWGAISDemodSettings::getSubChannels() {
+    return sub_channels;
+}
+void
+SWGAISDemodSettings::setSubChannels(QList<SWGAISDemodSubChannel*>* sub_channels) {
+    this->sub_channels = sub_channels;
+    this->m_sub_channels_isSet = true;
+}
+
 qint32
 SWGAISDemodSettings::getUdpEnabled() {
     return udp_enabled;
@@ -547,6 +573,9 @@ SWGAISDemodSettings::isSet(){
         if(m_correlation_threshold_isSet){
             isObjectUpdated = true; break;
         }
+        if(sub_channels && (sub_channels->size() > 0)){
+            isObjectUpdated = true; break;
+        }
         if(m_udp_enabled_isSet){
             isObjectUpdated = true; break;
         }
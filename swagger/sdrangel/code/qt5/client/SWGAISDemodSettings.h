@@ -22,9 +22,11 @@
 #include <QJsonObject>
 
 
+#include "SWGAISDemodSubChannel.h"
 #include "SWGChannelMarker.h"
 #include "SWGGLScope.h"
 #include "SWGRollupState.h"
+#include <QList>
 #include <QString>
 
 #include "SWGObject.h"
@@ -60,6 +62,9 @@ public:
     float getCorrelationThreshold();
     void setCorrelationThreshold(float correlation_threshold);
 
+    QList<SWGAISDemodSubChannel*>* getSubChannels();
+    void setSubChannels(QList<SWGAISDemodSubChannel*>* sub_channels);
+
     qint32 getUdpEnabled();
     void setUdpEnabled(qint32 udp_enabled);
 
@@ -130,6 +135,9 @@ private:
     float correlation_threshold;
     bool m_correlation_threshold_isSet;
 
+    QList<SWGAISDemodSubChannel*>* sub_channels;
+    bool m_sub_channels_isSet;
+
     qint32 udp_enabled;
     bool m_udp_enabled_isSet;
 
@@ -0,0 +1,221 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 7.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGAISDemodSubChannelReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGAISDemodSubChannelReport::SWGAISDemodSubChannelReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGAISDemodSubChannelReport::SWGAISDemodSubChannelReport() {
+    offset = 0;
+    m_offset_isSet = false;
+    out_of_band = 0;
+    m_out_of_band_isSet = false;
+    preambles = 0;
+    m_preambles_isSet = false;
+    crc_errors = 0;
+    m_crc_errors_isSet = false;
+    messages = 0;
+    m_messages_isSet = false;
+    duplicates = 0;
+    m_duplicates_isSet = false;
+}
+
+SWGAISDemodSubChannelReport::~SWGAISDemodSubChannelReport() {
+    this->cleanup();
+}
+
+void
+SWGAISDemodSubChannelReport::init() {
+    offset = 0;
+    m_offset_isSet = false;
+    out_of_band = 0;
+    m_out_of_band_isSet = false;
+    preambles = 0;
+    m_preambles_isSet = false;
+    crc_errors = 0;
+    m_crc_errors_isSet = false;
+    messages = 0;
+    m_messages_isSet = false;
+    duplicates = 0;
+    m_duplicates_isSet = false;
+}
+
+void
+SWGAISDemodSubChannelReport::cleanup() {
+
+
+
+
+
+}
+
+SWGAISDemodSubChannelReport*
+SWGAISDemodSubChannelReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGAISDemodSubChannelReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&offset, pJson["offset"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&out_of_band, pJson["outOfBand"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&preambles, pJson["preambles"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&crc_errors, pJson["crcErrors"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&messages, pJson["messages"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&duplicates, pJson["duplicates"], "qint32", "");
+}
+
+QString
+SWGAISDemodSubChannelReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGAISDemodSubChannelReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_offset_isSet){
+        obj->insert("offset", QJsonValue(offset));
+    }
+    if(m_out_of_band_isSet){
+        obj->insert("outOfBand", QJsonValue(out_of_band));
+    }
+    if(m_preambles_isSet){
+        obj->insert("preambles", QJsonValue(preambles));
+    }
+    if(m_crc_errors_isSet){
+        obj->insert("crcErrors", QJsonValue(crc_errors));
+    }
+    if(m_messages_isSet){
+        obj->insert("messages", QJsonValue(messages));
+    }
+    if(m_duplicates_isSet){
+        obj->insert("duplicates", QJsonValue(duplicates));
+    }
+
+    return obj;
+}
+
+qint32
+SWGAISDemodSubChannelReport::getOffset() {
+    return offset;
+}
+void
+SWGAISDemodSubChannelReport::setOffset(qint32 offset) {
+    this->offset = offset;
+    this->m_offset_isSet = true;
+}
+
+qint32
+SWGAISDemodSubChannelReport::getOutOfBand() {
+    return out_of_band;
+}
+void
+SWGAISDemodSubChannelReport::setOutOfBand(qint32 out_of_band) {
+    this->out_of_band = out_of_band;
+    this->m_out_of_band_isSet = true;
+}
+
+qint32
+SWGAISDemodSubChannelReport::getPreambles() {
+    return preambles;
+}
+void
+SWGAISDemodSubChannelReport::setPreambles(qint32 preambles) {
+    this->preambles = preambles;
+    this->m_preambles_isSet = true;
+}
+
+qint32
+SWGAISDemodSubChannelReport::getCrcErrors() {
+    return crc_errors;
+}
+void
+SWGAISDemodSubChannelReport::setCrcErrors(qint32 crc_errors) {
+    this->crc_errors = crc_errors;
+    this->m_crc_errors_isSet = true;
+}
+
+qint32
+SWGAISDemodSubChannelReport::getMessages() {
+    return messages;
+}
+void
+SWGAISDemodSubChannelReport::setMessages(qint32 messages) {
+    this->messages = messages;
+    this->m_messages_isSet = true;
+}
+
+qint32
+SWGAISDemodSubChannelReport::getDuplicates() {
+    return duplicates;
+}
+void
+SWGAISDemodSubChannelReport::setDuplicates(qint32 duplicates) {
+    this->duplicates = duplicates;
+    this->m_duplicates_isSet = true;
+}
+
+
+bool
+SWGAISDemodSubChannelReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_offset_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_out_of_band_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_preambles_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_crc_errors_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_messages_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_duplicates_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
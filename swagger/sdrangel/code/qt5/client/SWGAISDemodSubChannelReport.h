@@ -0,0 +1,88 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 7.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGAISDemodSubChannelReport.h
+ *
+ * AIS sub-channel decode statistics
+ */
+
+#ifndef SWGAISDemodSubChannelReport_H_
+#define SWGAISDemodSubChannelReport_H_
+
+#include <QJsonObject>
+
+
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGAISDemodSubChannelReport: public SWGObject {
+public:
+    SWGAISDemodSubChannelReport();
+    SWGAISDemodSubChannelReport(QString* json);
+    virtual ~SWGAISDemodSubChannelReport();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGAISDemodSubChannelReport* fromJson(QString &jsonString) override;
+
+    qint32 getOffset();
+    void setOffset(qint32 offset);
+
+    qint32 getOutOfBand();
+    void setOutOfBand(qint32 out_of_band);
+
+    qint32 getPreambles();
+    void setPreambles(qint32 preambles);
+
+    qint32 getCrcErrors();
+    void setCrcErrors(qint32 crc_errors);
+
+    qint32 getMessages();
+    void setMessages(qint32 messages);
+
+    qint32 getDuplicates();
+    void setDuplicates(qint32 duplicates);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 offset;
+    bool m_offset_isSet;
+
+    qint32 out_of_band;
+    bool m_out_of_band_isSet;
+
+    qint32 preambles;
+    bool m_preambles_isSet;
+
+    qint32 crc_errors;
+    bool m_crc_errors_isSet;
+
+    qint32 messages;
+    bool m_messages_isSet;
+
+    qint32 duplicates;
+    bool m_duplicates_isSet;
+
+};
+
+}
+
+#endif /* SWGAISDemodSubChannelReport_H_ */
@@ -0,0 +1,181 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 7.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGBatchResult.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGBatchResult::SWGBatchResult(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGBatchResult::SWGBatchResult() {
+    operation = nullptr;
+    m_operation_isSet = false;
+    index = 0;
+    m_index_isSet = false;
+    status = 0;
+    m_status_isSet = false;
+    message = nullptr;
+    m_message_isSet = false;
+}
+
+SWGBatchResult::~SWGBatchResult() {
+    this->cleanup();
+}
+
+void
+SWGBatchResult::init() {
+    operation = new QString("");
+    m_operation_isSet = false;
+    index = 0;
+    m_index_isSet = false;
+    status = 0;
+    m_status_isSet = false;
+    message = new QString("");
+    m_message_isSet = false;
+}
+
+void
+SWGBatchResult::cleanup() {
+    if(operation != nullptr) { 
+        delete operation;
+    }
+
+
+    if(message != nullptr) { 
+        delete message;
+    }
+}
+
+SWGBatchResult*
+SWGBatchResult::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGBatchResult::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&operation, pJson["operation"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&index, pJson["index"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&status, pJson["status"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&message, pJson["message"], "QString", "QString");
+    
+}
+
+QString
+SWGBatchResult::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGBatchResult::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(operation != nullptr && *operation != QString("")){
+        toJsonValue(QString("operation"), operation, obj, QString("QString"));
+    }
+    if(m_index_isSet){
+        obj->insert("index", QJsonValue(index));
+    }
+    if(m_status_isSet){
+        obj->insert("status", QJsonValue(status));
+    }
+    if(message != nullptr && *message != QString("")){
+        toJsonValue(QString("message"), message, obj, QString("QString"));
+    }
+
+    return obj;
+}
+
+QString*
+SWGBatchResult::getOperation() {
+    return operation;
+}
+void
+SWGBatchResult::setOperation(QString* operation) {
+    this->operation = operation;
+    this->m_operation_isSet = true;
+}
+
+qint32
+SWGBatchResult::getIndex() {
+    return index;
+}
+void
+SWGBatchResult::setIndex(qint32 index) {
+    this->index = index;
+    this->m_index_isSet = true;
+}
+
+qint32
+SWGBatchResult::getStatus() {
+    return status;
+}
+void
+SWGBatchResult::setStatus(qint32 status) {
+    this->status = status;
+    this->m_status_isSet = true;
+}
+
+QString*
+SWGBatchResult::getMessage() {
+    return message;
+}
+void
+SWGBatchResult::setMessage(QString* message) {
+    this->message = message;
+    this->m_message_isSet = true;
+}
+
+
+bool
+SWGBatchResult::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(operation && *operation != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_index_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_status_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(message && *message != QString("")){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
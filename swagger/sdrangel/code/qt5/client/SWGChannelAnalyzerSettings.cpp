@@ -62,6 +62,8 @@ SWGChannelAnalyzerSettings::SWGChannelAnalyzerSettings() {
     m_pll_loop_gain_isSet = false;
     input_type = 0;
     m_input_type_isSet = false;
+    scope_thread = 0;
+    m_scope_thread_isSet = false;
     rgb_color = 0;
     m_rgb_color_isSet = false;
     title = nullptr;
@@ -128,6 +130,8 @@ SWGChannelAnalyzerSettings::init() {
     m_pll_loop_gain_isSet = false;
     input_type = 0;
     m_input_type_isSet = false;
+    scope_thread = 0;
+    m_scope_thread_isSet = false;
     rgb_color = 0;
     m_rgb_color_isSet = false;
     title = new QString("");
@@ -244,6 +248,8 @@ SWGChannelAnalyzerSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&input_type, pJson["inputType"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&scope_thread, pJson["scopeThread"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&rgb_color, pJson["rgbColor"], "qint32", "");
     
     ::SWGSDRangel::setValue(&title, pJson["title"], "QString", "QString");
@@ -335,6 +341,9 @@ SWGChannelAnalyzerSettings::asJsonObject() {
     if(m_input_type_isSet){
         obj->insert("inputType", QJsonValue(input_type));
     }
+    if(m_scope_thread_isSet){
+        obj->insert("scopeThread", QJsonValue(scope_thread));
+    }
     if(m_rgb_color_isSet){
         obj->insert("rgbColor", QJsonValue(rgb_color));
     }
@@ -545,6 +554,16 @@ SWGChannelAnalyzerSettings::setInputType(qint32 input_type) {
     this->m_input_type_isSet = true;
 }
 
+qint32
+SWGChannelAnalyzerSettings::getScopeThread() {
+    return scope_thread;
+}
+void
+SWGChannelAnalyzerSettings::setScopeThread(qint32 scope_thread) {
+    this->scope_thread = scope_thread;
+    this->m_scope_thread_isSet = true;
+}
+
 qint32
 SWGChannelAnalyzerSettings::getRgbColor() {
     return rgb_color;
@@ -721,6 +740,9 @@ SWGChannelAnalyzerSettings::isSet(){
         if(m_input_type_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_scope_thread_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_rgb_color_isSet){
             isObjectUpdated = true; break;
         }
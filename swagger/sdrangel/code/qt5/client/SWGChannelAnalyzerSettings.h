@@ -97,6 +97,9 @@ public:
     qint32 getInputType();
     void setInputType(qint32 input_type);
 
+    qint32 getScopeThread();
+    void setScopeThread(qint32 scope_thread);
+
     qint32 getRgbColor();
     void setRgbColor(qint32 rgb_color);
 
@@ -188,6 +191,9 @@ private:
     qint32 input_type;
     bool m_input_type_isSet;
 
+    qint32 scope_thread;
+    bool m_scope_thread_isSet;
+
     qint32 rgb_color;
     bool m_rgb_color_isSet;
 
@@ -0,0 +1,158 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 7.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGChannelsBatchOperation.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGChannelsBatchOperation::SWGChannelsBatchOperation(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGChannelsBatchOperation::SWGChannelsBatchOperation() {
+    operation = nullptr;
+    m_operation_isSet = false;
+    channel_index = 0;
+    m_channel_index_isSet = false;
+    settings = nullptr;
+    m_settings_isSet = false;
+}
+
+SWGChannelsBatchOperation::~SWGChannelsBatchOperation() {
+    this->cleanup();
+}
+
+void
+SWGChannelsBatchOperation::init() {
+    operation = new QString("");
+    m_operation_isSet = false;
+    channel_index = 0;
+    m_channel_index_isSet = false;
+    settings = new SWGChannelSettings();
+    m_settings_isSet = false;
+}
+
+void
+SWGChannelsBatchOperation::cleanup() {
+    if(operation != nullptr) { 
+        delete operation;
+    }
+
+    if(settings != nullptr) { 
+        delete settings;
+    }
+}
+
+SWGChannelsBatchOperation*
+SWGChannelsBatchOperation::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGChannelsBatchOperation::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&operation, pJson["operation"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&channel_index, pJson["channelIndex"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&settings, pJson["settings"], "SWGChannelSettings", "SWGChannelSettings");
+    
+}
+
+QString
+SWGChannelsBatchOperation::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGChannelsBatchOperation::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(operation != nullptr && *operation != QString("")){
+        toJsonValue(QString("operation"), operation, obj, QString("QString"));
+    }
+    if(m_channel_index_isSet){
+        obj->insert("channelIndex", QJsonValue(channel_index));
+    }
+    if((settings != nullptr) && (settings->isSet())){
+        toJsonValue(QString("settings"), settings, obj, QString("SWGChannelSettings"));
+    }
+
+    return obj;
+}
+
+QString*
+SWGChannelsBatchOperation::getOperation() {
+    return operation;
+}
+void
+SWGChannelsBatchOperation::setOperation(QString* operation) {
+    this->operation = operation;
+    this->m_operation_isSet = true;
+}
+
+qint32
+SWGChannelsBatchOperation::getChannelIndex() {
+    return channel_index;
+}
+void
+SWGChannelsBatchOperation::setChannelIndex(qint32 channel_index) {
+    this->channel_index = channel_index;
+    this->m_channel_index_isSet = true;
+}
+
+SWGChannelSettings*
+SWGChannelsBatchOperation::getSettings() {
+    return settings;
+}
+void
+SWGChannelsBatchOperation::setSettings(SWGChannelSettings* settings) {
+    this->settings = settings;
+    this->m_settings_isSet = true;
+}
+
+
+bool
+SWGChannelsBatchOperation::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(operation && *operation != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_channel_index_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(settings && settings->isSet()){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
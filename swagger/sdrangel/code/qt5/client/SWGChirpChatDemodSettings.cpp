@@ -48,6 +48,8 @@ SWGChirpChatDemodSettings::SWGChirpChatDemodSettings() {
     m_nb_symbols_max_isSet = false;
     auto_nb_symbols_max = 0;
     m_auto_nb_symbols_max_isSet = false;
+    multi_sf = 0;
+    m_multi_sf_isSet = false;
     preamble_chirps = 0;
     m_preamble_chirps_isSet = false;
     nb_parity_bits = 0;
@@ -116,6 +118,8 @@ SWGChirpChatDemodSettings::init() {
     m_nb_symbols_max_isSet = false;
     auto_nb_symbols_max = 0;
     m_auto_nb_symbols_max_isSet = false;
+    multi_sf = 0;
+    m_multi_sf_isSet = false;
     preamble_chirps = 0;
     m_preamble_chirps_isSet = false;
     nb_parity_bits = 0;
@@ -235,6 +239,8 @@ SWGChirpChatDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&auto_nb_symbols_max, pJson["autoNbSymbolsMax"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&multi_sf, pJson["multiSF"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&preamble_chirps, pJson["preambleChirps"], "qint32", "");
     
     ::SWGSDRangel::setValue(&nb_parity_bits, pJson["nbParityBits"], "qint32", "");
@@ -321,6 +327,9 @@ SWGChirpChatDemodSettings::asJsonObject() {
     if(m_auto_nb_symbols_max_isSet){
         obj->insert("autoNbSymbolsMax", QJsonValue(auto_nb_symbols_max));
     }
+    if(m_multi_sf_isSet){
+        obj->insert("multiSF", QJsonValue(multi_sf));
+    }
     if(m_preamble_chirps_isSet){
         obj->insert("preambleChirps", QJsonValue(preamble_chirps));
     }
@@ -485,6 +494,16 @@ SWGChirpChatDemodSettings::setAutoNbSymbolsMax(qint32 auto_nb_symbols_max) {
     this->m_auto_nb_symbols_max_isSet = true;
 }
 
+qint32
+SWGChirpChatDemodSettings::getMultiSf() {
+    return multi_sf;
+}
+void
+SWGChirpChatDemodSettings::setMultiSf(qint32 multi_sf) {
+    this->multi_sf = multi_sf;
+    this->m_multi_sf_isSet = true;
+}
+
 qint32
 SWGChirpChatDemodSettings::getPreambleChirps() {
     return preamble_chirps;
@@ -720,6 +739,9 @@ SWGChirpChatDemodSettings::isSet(){
         if(m_auto_nb_symbols_max_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_multi_sf_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_preamble_chirps_isSet){
             isObjectUpdated = true; break;
         }
@@ -75,6 +75,9 @@ public:
     qint32 getAutoNbSymbolsMax();
     void setAutoNbSymbolsMax(qint32 auto_nb_symbols_max);
 
+    qint32 getMultiSf();
+    void setMultiSf(qint32 multi_sf);
+
     qint32 getPreambleChirps();
     void setPreambleChirps(qint32 preamble_chirps);
 
@@ -169,6 +172,9 @@ private:
     qint32 auto_nb_symbols_max;
     bool m_auto_nb_symbols_max_isSet;
 
+    qint32 multi_sf;
+    bool m_multi_sf_isSet;
+
     qint32 preamble_chirps;
     bool m_preamble_chirps_isSet;
 
@@ -50,6 +50,10 @@ SWGDATVDemodSettings::SWGDATVDemodSettings() {
     m_soft_ldpc_max_trials_isSet = false;
     max_bitflips = 0;
     m_max_bitflips_isSet = false;
+    scheduler_threads = 0;
+    m_scheduler_threads_isSet = false;
+    fec_implementation = 0;
+    m_fec_implementation_isSet = false;
     audio_mute = 0;
     m_audio_mute_isSet = false;
     audio_device_name = nullptr;
@@ -130,6 +134,10 @@ SWGDATVDemodSettings::init() {
     m_soft_ldpc_max_trials_isSet = false;
     max_bitflips = 0;
     m_max_bitflips_isSet = false;
+    scheduler_threads = 0;
+    m_scheduler_threads_isSet = false;
+    fec_implementation = 0;
+    m_fec_implementation_isSet = false;
     audio_mute = 0;
     m_audio_mute_isSet = false;
     audio_device_name = new QString("");
@@ -269,6 +277,10 @@ SWGDATVDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&max_bitflips, pJson["maxBitflips"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&scheduler_threads, pJson["schedulerThreads"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&fec_implementation, pJson["fecImplementation"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&audio_mute, pJson["audioMute"], "qint32", "");
     
     ::SWGSDRangel::setValue(&audio_device_name, pJson["audioDeviceName"], "QString", "QString");
@@ -368,6 +380,12 @@ SWGDATVDemodSettings::asJsonObject() {
     if(m_max_bitflips_isSet){
         obj->insert("maxBitflips", QJsonValue(max_bitflips));
     }
+    if(m_scheduler_threads_isSet){
+        obj->insert("schedulerThreads", QJsonValue(scheduler_threads));
+    }
+    if(m_fec_implementation_isSet){
+        obj->insert("fecImplementation", QJsonValue(fec_implementation));
+    }
     if(m_audio_mute_isSet){
         obj->insert("audioMute", QJsonValue(audio_mute));
     }
@@ -557,6 +575,26 @@ SWGDATVDemodSettings::setMaxBitflips(qint32 max_bitflips) {
     this->m_max_bitflips_isSet = true;
 }
 
+qint32
+SWGDATVDemodSettings::getSchedulerThreads() {
+    return scheduler_threads;
+}
+void
+SWGDATVDemodSettings::setSchedulerThreads(qint32 scheduler_threads) {
+    this->scheduler_threads = scheduler_threads;
+    this->m_scheduler_threads_isSet = true;
+}
+
+qint32
+SWGDATVDemodSettings::getFecImplementation() {
+    return fec_implementation;
+}
+void
+SWGDATVDemodSettings::setFecImplementation(qint32 fec_implementation) {
+    this->fec_implementation = fec_implementation;
+    this->m_fec_implementation_isSet = true;
+}
+
 qint32
 SWGDATVDemodSettings::getAudioMute() {
     return audio_mute;
@@ -845,6 +883,12 @@ SWGDATVDemodSettings::isSet(){
         if(m_max_bitflips_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_scheduler_threads_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_fec_implementation_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_audio_mute_isSet){
             isObjectUpdated = true; break;
         }
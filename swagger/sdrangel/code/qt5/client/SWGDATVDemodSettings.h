@@ -77,6 +77,12 @@ public:
     qint32 getMaxBitflips();
     void setMaxBitflips(qint32 max_bitflips);
 
+    qint32 getSchedulerThreads();
+    void setSchedulerThreads(qint32 scheduler_threads);
+
+    qint32 getFecImplementation();
+    void setFecImplementation(qint32 fec_implementation);
+
     qint32 getAudioMute();
     void setAudioMute(qint32 audio_mute);
 
@@ -189,6 +195,12 @@ private:
     qint32 max_bitflips;
     bool m_max_bitflips_isSet;
 
+    qint32 scheduler_threads;
+    bool m_scheduler_threads_isSet;
+
+    qint32 fec_implementation;
+    bool m_fec_implementation_isSet;
+
     qint32 audio_mute;
     bool m_audio_mute_isSet;
 
@@ -36,6 +36,10 @@ SWGDSDDemodReport::SWGDSDDemodReport() {
     m_channel_sample_rate_isSet = false;
     squelch = 0;
     m_squelch_isSet = false;
+    vocoder_overruns = 0;
+    m_vocoder_overruns_isSet = false;
+    vocoder_queue_ms = 0.0f;
+    m_vocoder_queue_ms_isSet = false;
     pll_locked = 0;
     m_pll_locked_isSet = false;
     slot1_on = 0;
@@ -70,6 +74,10 @@ SWGDSDDemodReport::init() {
     m_channel_sample_rate_isSet = false;
     squelch = 0;
     m_squelch_isSet = false;
+    vocoder_overruns = 0;
+    m_vocoder_overruns_isSet = false;
+    vocoder_queue_ms = 0.0f;
+    m_vocoder_queue_ms_isSet = false;
     pll_locked = 0;
     m_pll_locked_isSet = false;
     slot1_on = 0;
@@ -130,6 +138,10 @@ SWGDSDDemodReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&squelch, pJson["squelch"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&vocoder_overruns, pJson["vocoderOverruns"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&vocoder_queue_ms, pJson["vocoderQueueMs"], "float", "");
+    
     ::SWGSDRangel::setValue(&pll_locked, pJson["pllLocked"], "qint32", "");
     
     ::SWGSDRangel::setValue(&slot1_on, pJson["slot1On"], "qint32", "");
@@ -176,6 +188,12 @@ SWGDSDDemodReport::asJsonObject() {
     if(m_squelch_isSet){
         obj->insert("squelch", QJsonValue(squelch));
     }
+    if(m_vocoder_overruns_isSet){
+        obj->insert("vocoderOverruns", QJsonValue(vocoder_overruns));
+    }
+    if(m_vocoder_queue_ms_isSet){
+        obj->insert("vocoderQueueMs", QJsonValue(vocoder_queue_ms));
+    }
     if(m_pll_locked_isSet){
         obj->insert("pllLocked", QJsonValue(pll_locked));
     }
@@ -247,6 +265,26 @@ SWGDSDDemodReport::setSquelch(qint32 squelch) {
     this->m_squelch_isSet = true;
 }
 
+qint32
+SWGDSDDemodReport::getVocoderOverruns() {
+    return vocoder_overruns;
+}
+void
+SWGDSDDemodReport::setVocoderOverruns(qint32 vocoder_overruns) {
+    this->vocoder_overruns = vocoder_overruns;
+    this->m_vocoder_overruns_isSet = true;
+}
+
+float
+SWGDSDDemodReport::getVocoderQueueMs() {
+    return vocoder_queue_ms;
+}
+void
+SWGDSDDemodReport::setVocoderQueueMs(float vocoder_queue_ms) {
+    this->vocoder_queue_ms = vocoder_queue_ms;
+    this->m_vocoder_queue_ms_isSet = true;
+}
+
 qint32
 SWGDSDDemodReport::getPllLocked() {
     return pll_locked;
@@ -354,6 +392,12 @@ SWGDSDDemodReport::isSet(){
         if(m_squelch_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_vocoder_overruns_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_vocoder_queue_ms_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_pll_locked_isSet){
             isObjectUpdated = true; break;
         }
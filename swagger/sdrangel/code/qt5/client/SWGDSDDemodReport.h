@@ -54,6 +54,12 @@ public:
     qint32 getSquelch();
     void setSquelch(qint32 squelch);
 
+    qint32 getVocoderOverruns();
+    void setVocoderOverruns(qint32 vocoder_overruns);
+
+    float getVocoderQueueMs();
+    void setVocoderQueueMs(float vocoder_queue_ms);
+
     qint32 getPllLocked();
     void setPllLocked(qint32 pll_locked);
 
@@ -97,6 +103,12 @@ private:
     qint32 squelch;
     bool m_squelch_isSet;
 
+    qint32 vocoder_overruns;
+    bool m_vocoder_overruns_isSet;
+
+    float vocoder_queue_ms;
+    bool m_vocoder_queue_ms_isSet;
+
     qint32 pll_locked;
     bool m_pll_locked_isSet;
 
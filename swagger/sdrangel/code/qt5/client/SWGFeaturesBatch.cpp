@@ -0,0 +1,114 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 7.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGFeaturesBatch.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFeaturesBatch::SWGFeaturesBatch(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFeaturesBatch::SWGFeaturesBatch() {
+    operations = nullptr;
+    m_operations_isSet = false;
+}
+
+SWGFeaturesBatch::~SWGFeaturesBatch() {
+    this->cleanup();
+}
+
+void
+SWGFeaturesBatch::init() {
+    operations = new QList<SWGFeaturesBatchOperation*>();
+    m_operations_isSet = false;
+}
+
+void
+SWGFeaturesBatch::cleanup() {
+    if(operations != nullptr) { 
+        auto arr = operations;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete operations;
+    }
+}
+
+SWGFeaturesBatch*
+SWGFeaturesBatch::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFeaturesBatch::fromJsonObject(QJsonObject &pJson) {
+    
+    ::SWGSDRangel::setValue(&operations, pJson["operations"], "QList", "SWGFeaturesBatchOperation");
+}
+
+QString
+SWGFeaturesBatch::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFeaturesBatch::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(operations && operations->size() > 0){
+        toJsonArray((QList<void*>*)operations, obj, "operations", "SWGFeaturesBatchOperation");
+    }
+
+    return obj;
+}
+
+QList<SWGFeaturesBatchOperation*>*
+SWGFeaturesBatch::getOperations() {
+    return operations;
+}
+void
+SWGFeaturesBatch::setOperations(QList<SWGFeaturesBatchOperation*>* operations) {
+    this->operations = operations;
+    this->m_operations_isSet = true;
+}
+
+
+bool
+SWGFeaturesBatch::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(operations && (operations->size() > 0)){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
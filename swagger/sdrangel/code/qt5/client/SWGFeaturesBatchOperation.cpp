@@ -0,0 +1,158 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 7.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGFeaturesBatchOperation.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFeaturesBatchOperation::SWGFeaturesBatchOperation(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFeaturesBatchOperation::SWGFeaturesBatchOperation() {
+    operation = nullptr;
+    m_operation_isSet = false;
+    feature_index = 0;
+    m_feature_index_isSet = false;
+    settings = nullptr;
+    m_settings_isSet = false;
+}
+
+SWGFeaturesBatchOperation::~SWGFeaturesBatchOperation() {
+    this->cleanup();
+}
+
+void
+SWGFeaturesBatchOperation::init() {
+    operation = new QString("");
+    m_operation_isSet = false;
+    feature_index = 0;
+    m_feature_index_isSet = false;
+    settings = new SWGFeatureSettings();
+    m_settings_isSet = false;
+}
+
+void
+SWGFeaturesBatchOperation::cleanup() {
+    if(operation != nullptr) { 
+        delete operation;
+    }
+
+    if(settings != nullptr) { 
+        delete settings;
+    }
+}
+
+SWGFeaturesBatchOperation*
+SWGFeaturesBatchOperation::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFeaturesBatchOperation::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&operation, pJson["operation"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&feature_index, pJson["featureIndex"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&settings, pJson["settings"], "SWGFeatureSettings", "SWGFeatureSettings");
+    
+}
+
+QString
+SWGFeaturesBatchOperation::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFeaturesBatchOperation::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(operation != nullptr && *operation != QString("")){
+        toJsonValue(QString("operation"), operation, obj, QString("QString"));
+    }
+    if(m_feature_index_isSet){
+        obj->insert("featureIndex", QJsonValue(feature_index));
+    }
+    if((settings != nullptr) && (settings->isSet())){
+        toJsonValue(QString("settings"), settings, obj, QString("SWGFeatureSettings"));
+    }
+
+    return obj;
+}
+
+QString*
+SWGFeaturesBatchOperation::getOperation() {
+    return operation;
+}
+void
+SWGFeaturesBatchOperation::setOperation(QString* operation) {
+    this->operation = operation;
+    this->m_operation_isSet = true;
+}
+
+qint32
+SWGFeaturesBatchOperation::getFeatureIndex() {
+    return feature_index;
+}
+void
+SWGFeaturesBatchOperation::setFeatureIndex(qint32 feature_index) {
+    this->feature_index = feature_index;
+    this->m_feature_index_isSet = true;
+}
+
+SWGFeatureSettings*
+SWGFeaturesBatchOperation::getSettings() {
+    return settings;
+}
+void
+SWGFeaturesBatchOperation::setSettings(SWGFeatureSettings* settings) {
+    this->settings = settings;
+    this->m_settings_isSet = true;
+}
+
+
+bool
+SWGFeaturesBatchOperation::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(operation && *operation != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_feature_index_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(settings && settings->isSet()){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
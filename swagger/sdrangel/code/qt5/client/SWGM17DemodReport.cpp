@@ -36,6 +36,10 @@ SWGM17DemodReport::SWGM17DemodReport() {
     m_channel_sample_rate_isSet = false;
     squelch = 0;
     m_squelch_isSet = false;
+    vocoder_overruns = 0;
+    m_vocoder_overruns_isSet = false;
+    vocoder_queue_ms = 0.0f;
+    m_vocoder_queue_ms_isSet = false;
 }
 
 SWGM17DemodReport::~SWGM17DemodReport() {
@@ -52,6 +56,10 @@ SWGM17DemodReport::init() {
     m_channel_sample_rate_isSet = false;
     squelch = 0;
     m_squelch_isSet = false;
+    vocoder_overruns = 0;
+    m_vocoder_overruns_isSet = false;
+    vocoder_queue_ms = 0.0f;
+    m_vocoder_queue_ms_isSet = false;
 }
 
 void
@@ -81,6 +89,10 @@ SWGM17DemodReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&squelch, pJson["squelch"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&vocoder_overruns, pJson["vocoderOverruns"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&vocoder_queue_ms, pJson["vocoderQueueMs"], "float", "");
+    
 }
 
 QString
@@ -109,6 +121,12 @@ SWGM17DemodReport::asJsonObject() {
     if(m_squelch_isSet){
         obj->insert("squelch", QJsonValue(squelch));
     }
+    if(m_vocoder_overruns_isSet){
+        obj->insert("vocoderOverruns", QJsonValue(vocoder_overruns));
+    }
+    if(m_vocoder_queue_ms_isSet){
+        obj->insert("vocoderQueueMs", QJsonValue(vocoder_queue_ms));
+    }
 
     return obj;
 }
@@ -153,6 +171,26 @@ SWGM17DemodReport::setSquelch(qint32 squelch) {
     this->m_squelch_isSet = true;
 }
 
+qint32
+SWGM17DemodReport::getVocoderOverruns() {
+    return vocoder_overruns;
+}
+void
+SWGM17DemodReport::setVocoderOverruns(qint32 vocoder_overruns) {
+    this->vocoder_overruns = vocoder_overruns;
+    this->m_vocoder_overruns_isSet = true;
+}
+
+float
+SWGM17DemodReport::getVocoderQueueMs() {
+    return vocoder_queue_ms;
+}
+void
+SWGM17DemodReport::setVocoderQueueMs(float vocoder_queue_ms) {
+    this->vocoder_queue_ms = vocoder_queue_ms;
+    this->m_vocoder_queue_ms_isSet = true;
+}
+
 
 bool
 SWGM17DemodReport::isSet(){
@@ -170,6 +208,12 @@ SWGM17DemodReport::isSet(){
         if(m_squelch_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_vocoder_overruns_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_vocoder_queue_ms_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -53,6 +53,12 @@ public:
     qint32 getSquelch();
     void setSquelch(qint32 squelch);
 
+    qint32 getVocoderOverruns();
+    void setVocoderOverruns(qint32 vocoder_overruns);
+
+    float getVocoderQueueMs();
+    void setVocoderQueueMs(float vocoder_queue_ms);
+
 
     virtual bool isSet() override;
 
@@ -69,6 +75,12 @@ private:
     qint32 squelch;
     bool m_squelch_isSet;
 
+    qint32 vocoder_overruns;
+    bool m_vocoder_overruns_isSet;
+
+    float vocoder_queue_ms;
+    bool m_vocoder_queue_ms_isSet;
+
 };
 
 }
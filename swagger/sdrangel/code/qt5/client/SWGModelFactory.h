@@ -14,6 +14,7 @@
 #define ModelFactory_H_
 
 
+#include "SWGADSBDemodAircraftState.h"
 #include "SWGADSBDemodReport.h"
 #include "SWGADSBDemodSettings.h"
 #include "SWGAFCActions.h"
@@ -21,6 +22,8 @@
 #include "SWGAFCSettings.h"
 #include "SWGAISDemodReport.h"
 #include "SWGAISDemodSettings.h"
+#include "SWGAISDemodSubChannel.h"
+#include "SWGAISDemodSubChannelReport.h"
 #include "SWGAISModActions.h"
 #include "SWGAISModReport.h"
 #include "SWGAISModSettings.h"
@@ -59,6 +62,8 @@
 #include "SWGBFMDemodSettings.h"
 #include "SWGBandwidth.h"
 #include "SWGBase64Blob.h"
+#include "SWGBatchResult.h"
+#include "SWGBatchResults.h"
 #include "SWGBeamSteeringCWModSettings.h"
 #include "SWGBladeRF1InputSettings.h"
 #include "SWGBladeRF1OutputSettings.h"
@@ -78,6 +83,8 @@
 #include "SWGChannelMarker.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelSettings.h"
+#include "SWGChannelsBatch.h"
+#include "SWGChannelsBatchOperation.h"
 #include "SWGChannelsDetail.h"
 #include "SWGChirpChatDemodReport.h"
 #include "SWGChirpChatDemodSettings.h"
@@ -125,6 +132,8 @@
 #include "SWGFeatureSet.h"
 #include "SWGFeatureSetPreset.h"
 #include "SWGFeatureSettings.h"
+#include "SWGFeaturesBatch.h"
+#include "SWGFeaturesBatchOperation.h"
 #include "SWGFileInputReport.h"
 #include "SWGFileInputSettings.h"
 #include "SWGFileOutputSettings.h"
@@ -342,6 +351,11 @@
 namespace SWGSDRangel {
 
   inline void* create(QString type) {
+    if(QString("SWGADSBDemodAircraftState").compare(type) == 0) {
+      SWGADSBDemodAircraftState *obj = new SWGADSBDemodAircraftState();
+      obj->init();
+      return obj;
+    }
     if(QString("SWGADSBDemodReport").compare(type) == 0) {
       SWGADSBDemodReport *obj = new SWGADSBDemodReport();
       obj->init();
@@ -377,6 +391,16 @@ namespace SWGSDRangel {
       obj->init();
       return obj;
     }
+    if(QString("SWGAISDemodSubChannel").compare(type) == 0) {
+      SWGAISDemodSubChannel *obj = new SWGAISDemodSubChannel();
+      obj->init();
+      return obj;
+    }
+    if(QString("SWGAISDemodSubChannelReport").compare(type) == 0) {
+      SWGAISDemodSubChannelReport *obj = new SWGAISDemodSubChannelReport();
+      obj->init();
+      return obj;
+    }
     if(QString("SWGAISModActions").compare(type) == 0) {
       SWGAISModActions *obj = new SWGAISModActions();
       obj->init();
@@ -567,6 +591,16 @@ namespace SWGSDRangel {
       obj->init();
       return obj;
     }
+    if(QString("SWGBatchResult").compare(type) == 0) {
+      SWGBatchResult *obj = new SWGBatchResult();
+      obj->init();
+      return obj;
+    }
+    if(QString("SWGBatchResults").compare(type) == 0) {
+      SWGBatchResults *obj = new SWGBatchResults();
+      obj->init();
+      return obj;
+    }
     if(QString("SWGBeamSteeringCWModSettings").compare(type) == 0) {
       SWGBeamSteeringCWModSettings *obj = new SWGBeamSteeringCWModSettings();
       obj->init();
@@ -662,6 +696,16 @@ namespace SWGSDRangel {
       obj->init();
       return obj;
     }
+    if(QString("SWGChannelsBatch").compare(type) == 0) {
+      SWGChannelsBatch *obj = new SWGChannelsBatch();
+      obj->init();
+      return obj;
+    }
+    if(QString("SWGChannelsBatchOperation").compare(type) == 0) {
+      SWGChannelsBatchOperation *obj = new SWGChannelsBatchOperation();
+      obj->init();
+      return obj;
+    }
     if(QString("SWGChannelsDetail").compare(type) == 0) {
       SWGChannelsDetail *obj = new SWGChannelsDetail();
       obj->init();
@@ -897,6 +941,16 @@ namespace SWGSDRangel {
       obj->init();
       return obj;
     }
+    if(QString("SWGFeaturesBatch").compare(type) == 0) {
+      SWGFeaturesBatch *obj = new SWGFeaturesBatch();
+      obj->init();
+      return obj;
+    }
+    if(QString("SWGFeaturesBatchOperation").compare(type) == 0) {
+      SWGFeaturesBatchOperation *obj = new SWGFeaturesBatchOperation();
+      obj->init();
+      return obj;
+    }
     if(QString("SWGFileInputReport").compare(type) == 0) {
       SWGFileInputReport *obj = new SWGFileInputReport();
       obj->init();
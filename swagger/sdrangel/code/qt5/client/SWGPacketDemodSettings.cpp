@@ -36,6 +36,8 @@ SWGPacketDemodSettings::SWGPacketDemodSettings() {
     m_rf_bandwidth_isSet = false;
     fm_deviation = 0.0f;
     m_fm_deviation_isSet = false;
+    multi_slicer = 0;
+    m_multi_slicer_isSet = false;
     udp_enabled = 0;
     m_udp_enabled_isSet = false;
     udp_address = nullptr;
@@ -82,6 +84,8 @@ SWGPacketDemodSettings::init() {
     m_rf_bandwidth_isSet = false;
     fm_deviation = 0.0f;
     m_fm_deviation_isSet = false;
+    multi_slicer = 0;
+    m_multi_slicer_isSet = false;
     udp_enabled = 0;
     m_udp_enabled_isSet = false;
     udp_address = new QString("");
@@ -168,6 +172,8 @@ SWGPacketDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&fm_deviation, pJson["fmDeviation"], "float", "");
     
+    ::SWGSDRangel::setValue(&multi_slicer, pJson["multiSlicer"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&udp_enabled, pJson["udpEnabled"], "qint32", "");
     
     ::SWGSDRangel::setValue(&udp_address, pJson["udpAddress"], "QString", "QString");
@@ -226,6 +232,9 @@ SWGPacketDemodSettings::asJsonObject() {
     if(m_fm_deviation_isSet){
         obj->insert("fmDeviation", QJsonValue(fm_deviation));
     }
+    if(m_multi_slicer_isSet){
+        obj->insert("multiSlicer", QJsonValue(multi_slicer));
+    }
     if(m_udp_enabled_isSet){
         obj->insert("udpEnabled", QJsonValue(udp_enabled));
     }
@@ -315,6 +324,16 @@ SWGPacketDemodSettings::setFmDeviation(float fm_deviation) {
     this->m_fm_deviation_isSet = true;
 }
 
+qint32
+SWGPacketDemodSettings::getMultiSlicer() {
+    return multi_slicer;
+}
+void
+SWGPacketDemodSettings::setMultiSlicer(qint32 multi_slicer) {
+    this->multi_slicer = multi_slicer;
+    this->m_multi_slicer_isSet = true;
+}
+
 qint32
 SWGPacketDemodSettings::getUdpEnabled() {
     return udp_enabled;
@@ -482,6 +501,9 @@ SWGPacketDemodSettings::isSet(){
         if(m_fm_deviation_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_multi_slicer_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_udp_enabled_isSet){
             isObjectUpdated = true; break;
         }
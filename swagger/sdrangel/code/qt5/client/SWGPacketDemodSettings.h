@@ -56,6 +56,9 @@ public:
     float getFmDeviation();
     void setFmDeviation(float fm_deviation);
 
+    qint32 getMultiSlicer();
+    void setMultiSlicer(qint32 multi_slicer);
+
     qint32 getUdpEnabled();
     void setUdpEnabled(qint32 udp_enabled);
 
@@ -117,6 +120,9 @@ private:
     float fm_deviation;
     bool m_fm_deviation_isSet;
 
+    qint32 multi_slicer;
+    bool m_multi_slicer_isSet;
+
     qint32 udp_enabled;
     bool m_udp_enabled_isSet;
 